@@ -0,0 +1,884 @@
+/*****************************************************************************
+ * bench.c:
+ *****************************************************************************
+ * Copyright (C) 2015 L-SMASH project
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ * ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ *****************************************************************************/
+
+/* This file is available under an ISC license. */
+
+#include "cli.h"
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdarg.h>
+#include <inttypes.h>
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+/* The benchmarks measure the internal hot paths as well as the public API. */
+#include "common/internal.h"
+#include "importer/importer.h"
+
+#define eprintf( ... ) fprintf( stderr, __VA_ARGS__ )
+
+#define BENCH_DEFAULT_STREAM_SIZE  (32 * 1024 * 1024)
+#define BENCH_DEFAULT_NUM_SAMPLES  500000
+#define BENCH_DEFAULT_ITERATIONS   3
+#define BENCH_SAMPLE_SIZE          16
+#define BENCH_SAMPLE_DELTA         1024
+#define BENCH_WRITE_BLOCK_SIZE     (64 * 1024)
+
+enum
+{
+    BENCH_FILE_RANDOM,      /* random bytes */
+    BENCH_FILE_ANNEXB,      /* NAL units with start codes */
+    BENCH_FILE_ADTS,        /* ADTS AAC frames with random payloads */
+    BENCH_FILE_MUXED,       /* MP4 muxed from BENCH_FILE_ADTS */
+    BENCH_FILE_SYNTHETIC,   /* MP4 with tiny samples */
+    BENCH_FILE_OUTPUT,      /* output of the benchmarks writing a movie */
+    BENCH_FILE_COUNT
+};
+
+static const char *bench_file_name[BENCH_FILE_COUNT] =
+    {
+        "lsmash-bench-random.bin",
+        "lsmash-bench-annexb.264",
+        "lsmash-bench-adts.aac",
+        "lsmash-bench-muxed.mp4",
+        "lsmash-bench-synthetic.mp4",
+        "lsmash-bench-output.mp4"
+    };
+
+typedef struct
+{
+    uint64_t          stream_size;      /* size of each generated elementary stream in bytes */
+    uint32_t          num_samples;      /* number of samples in the synthetic movie */
+    int               iterations;
+    const char       *tmpdir;
+    const char       *filter;
+    char             *path[BENCH_FILE_COUNT];
+    int               ready[BENCH_FILE_COUNT];
+    lsmash_summary_t *summary;          /* summary of BENCH_FILE_ADTS */
+} bench_t;
+
+typedef struct
+{
+    double   seconds;
+    uint64_t bytes;
+    uint64_t samples;
+} bench_result_t;
+
+typedef struct
+{
+    lsmash_root_t           *root;
+    lsmash_file_parameters_t param;
+    uint32_t                 track_ID;
+    uint32_t                 sample_entry;
+} bench_output_t;
+
+typedef struct
+{
+    lsmash_root_t           *root;
+    lsmash_file_parameters_t param;
+    uint32_t                 track_ID;
+} bench_input_t;
+
+/* Keep the results of the reading benchmarks alive. */
+static volatile uint64_t bench_sink;
+
+static int error_message( const char *message, ... )
+{
+    eprintf( "[Error] " );
+    va_list args;
+    va_start( args, message );
+    vfprintf( stderr, message, args );
+    va_end( args );
+    return -1;
+}
+
+#define ERROR_MSG( ... ) error_message( __VA_ARGS__ )
+
+static void display_version( void )
+{
+    eprintf( "\n"
+             "L-SMASH benchmark suite rev%s  %s\n"
+             "Built on %s %s\n"
+             "Copyright (C) 2015 L-SMASH project\n",
+             LSMASH_REV, LSMASH_GIT_HASH, __DATE__, __TIME__ );
+}
+
+static void display_help( void )
+{
+    display_version();
+    eprintf( "\n"
+             "Usage: lsmash-bench [options]\n"
+             "Options:\n"
+             "    --help                    Display help.\n"
+             "    --version                 Display version information.\n"
+             "    --list                    List the benchmarks.\n"
+             "    --filter <string>         Run only the benchmarks in the comma separated list.\n"
+             "    --size <integer>          Set the size of each generated stream in MiB.\n"
+             "                              If this option is not used, it defaults to 32.\n"
+             "    --samples <integer>       Set the number of samples in the synthetic movie.\n"
+             "                              If this option is not used, it defaults to 500000.\n"
+             "    --iterations <integer>    Set how many times each benchmark runs.\n"
+             "                              The fastest run is reported.\n"
+             "                              If this option is not used, it defaults to 3.\n"
+             "    --tmpdir <string>         Set the directory for the generated files.\n"
+             "                              If this option is not used, it defaults to the current one.\n"
+             "The results are written into stdout as JSON.\n"
+             "Throughputs are in 10^6 bytes per second, and peak RSS is of the whole process.\n" );
+}
+
+static uint64_t get_peak_rss_kb( void )
+{
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS counters;
+    if( !GetProcessMemoryInfo( GetCurrentProcess(), &counters, sizeof(counters) ) )
+        return 0;
+    return counters.PeakWorkingSetSize / 1024;
+#else
+    struct rusage usage;
+    if( getrusage( RUSAGE_SELF, &usage ) )
+        return 0;
+#ifdef __APPLE__
+    return usage.ru_maxrss / 1024;  /* in bytes */
+#else
+    return usage.ru_maxrss;
+#endif
+#endif
+}
+
+static uint64_t get_file_size( const char *path )
+{
+    FILE *fp = lsmash_fopen( path, "rb" );
+    if( !fp )
+        return 0;
+    uint64_t size = lsmash_fseek( fp, 0, SEEK_END ) ? 0 : lsmash_ftell( fp );
+    fclose( fp );
+    return size;
+}
+
+/* xorshift32: the generated inputs are identical on every run. */
+static uint32_t bench_random( uint32_t *state )
+{
+    uint32_t x = *state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    return *state = x;
+}
+
+static int generate_stream( bench_t *bench, int file_id )
+{
+    FILE *fp = lsmash_fopen( bench->path[file_id], "wb" );
+    if( !fp )
+        return ERROR_MSG( "failed to create %s.\n", bench->path[file_id] );
+    uint8_t *block = lsmash_malloc( BENCH_WRITE_BLOCK_SIZE );
+    if( !block )
+    {
+        fclose( fp );
+        return ERROR_MSG( "failed to allocate a block.\n" );
+    }
+    uint32_t state   = 0x4C534D48;
+    uint64_t written = 0;
+    while( written < bench->stream_size )
+    {
+        uint32_t size = 0;
+        if( file_id == BENCH_FILE_RANDOM )
+            for( ; size < BENCH_WRITE_BLOCK_SIZE; size++ )
+                block[size] = bench_random( &state );
+        else if( file_id == BENCH_FILE_ANNEXB )
+        {
+            /* A start code followed by the payload without any zero byte, which needs no emulation prevention. */
+            uint32_t payload_size = 256 + bench_random( &state ) % 4096;
+            block[size++] = 0x00;
+            block[size++] = 0x00;
+            block[size++] = 0x00;
+            block[size++] = 0x01;
+            for( uint32_t i = 0; i < payload_size; i++ )
+                block[size++] = 1 + bench_random( &state ) % 255;
+        }
+        else
+        {
+            /* ADTS header of AAC-LC at 48kHz in stereo without CRC. */
+            uint32_t frame_length = 7 + 256 + bench_random( &state ) % 512;
+            block[size++] = 0xFF;
+            block[size++] = 0xF1;
+            block[size++] = (1 << 6) | (3 << 2);
+            block[size++] = (2 << 6) | ((frame_length >> 11) & 0x03);
+            block[size++] = (frame_length >> 3) & 0xFF;
+            block[size++] = ((frame_length & 0x07) << 5) | 0x1F;
+            block[size++] = 0xFC;
+            while( size < frame_length )
+                block[size++] = bench_random( &state );
+        }
+        if( fwrite( block, 1, size, fp ) != size )
+        {
+            lsmash_free( block );
+            fclose( fp );
+            return ERROR_MSG( "failed to write %s.\n", bench->path[file_id] );
+        }
+        written += size;
+    }
+    lsmash_free( block );
+    fclose( fp );
+    return 0;
+}
+
+static lsmash_bs_t *open_bench_bytestream( const char *path )
+{
+    FILE *fp = lsmash_fopen( path, "rb" );
+    if( !fp )
+        return NULL;
+    lsmash_bs_t *bs = lsmash_bs_create();
+    if( !bs )
+    {
+        fclose( fp );
+        return NULL;
+    }
+    bs->stream     = fp;
+    bs->read       = lsmash_fread_wrapper;
+    bs->seek       = lsmash_fseek_wrapper;
+    bs->unseekable = 0;
+    return bs;
+}
+
+static void close_bench_bytestream( lsmash_bs_t *bs )
+{
+    if( !bs )
+        return;
+    fclose( (FILE *)bs->stream );
+    lsmash_bs_cleanup( bs );
+}
+
+static int open_bench_output( bench_output_t *output, const char *path, lsmash_summary_t *summary )
+{
+    static lsmash_brand_type brands[2] = { ISOM_BRAND_TYPE_MP42, ISOM_BRAND_TYPE_ISOM };
+    uint32_t timescale = ((lsmash_audio_summary_t *)summary)->frequency;
+    memset( output, 0, sizeof(bench_output_t) );
+    output->root = lsmash_create_root();
+    if( !output->root )
+        return ERROR_MSG( "failed to create a ROOT.\n" );
+    if( lsmash_open_file( path, 0, &output->param ) < 0 )
+        return ERROR_MSG( "failed to open %s.\n", path );
+    output->param.major_brand = ISOM_BRAND_TYPE_MP42;
+    output->param.brands      = brands;
+    output->param.brand_count = 2;
+    if( !lsmash_set_file( output->root, &output->param ) )
+        return ERROR_MSG( "failed to add an output file into a ROOT.\n" );
+    lsmash_movie_parameters_t movie_param;
+    lsmash_initialize_movie_parameters( &movie_param );
+    movie_param.timescale = timescale;
+    if( lsmash_set_movie_parameters( output->root, &movie_param ) )
+        return ERROR_MSG( "failed to set movie parameters.\n" );
+    output->track_ID = lsmash_create_track( output->root, ISOM_MEDIA_HANDLER_TYPE_AUDIO_TRACK );
+    if( !output->track_ID )
+        return ERROR_MSG( "failed to create a track.\n" );
+    lsmash_track_parameters_t track_param;
+    lsmash_initialize_track_parameters( &track_param );
+    track_param.mode     = ISOM_TRACK_ENABLED | ISOM_TRACK_IN_MOVIE | ISOM_TRACK_IN_PREVIEW;
+    track_param.track_ID = output->track_ID;
+    if( lsmash_set_track_parameters( output->root, output->track_ID, &track_param ) )
+        return ERROR_MSG( "failed to set track parameters.\n" );
+    lsmash_media_parameters_t media_param;
+    lsmash_initialize_media_parameters( &media_param );
+    media_param.timescale = timescale;
+    if( lsmash_set_media_parameters( output->root, output->track_ID, &media_param ) )
+        return ERROR_MSG( "failed to set media parameters.\n" );
+    output->sample_entry = lsmash_add_sample_entry( output->root, output->track_ID, summary );
+    if( !output->sample_entry )
+        return ERROR_MSG( "failed to add a sample description entry.\n" );
+    return 0;
+}
+
+static int finish_bench_output( bench_output_t *output, uint32_t last_sample_delta, int moov_to_front )
+{
+    if( lsmash_flush_pooled_samples( output->root, output->track_ID, last_sample_delta ) )
+        return ERROR_MSG( "failed to flush samples.\n" );
+    lsmash_adhoc_remux_t adhoc_remux = { .func = NULL, .buffer_size = 4 * 1024 * 1024, .param = NULL };
+    if( lsmash_finish_movie( output->root, moov_to_front ? &adhoc_remux : NULL ) )
+        return ERROR_MSG( "failed to finish a movie.\n" );
+    return 0;
+}
+
+static void cleanup_bench_output( bench_output_t *output )
+{
+    lsmash_close_file( &output->param );
+    lsmash_destroy_root( output->root );
+    output->root = NULL;
+}
+
+static int open_bench_input( bench_input_t *input, const char *path )
+{
+    memset( input, 0, sizeof(bench_input_t) );
+    input->root = lsmash_create_root();
+    if( !input->root )
+        return ERROR_MSG( "failed to create a ROOT.\n" );
+    if( lsmash_open_file( path, 1, &input->param ) < 0 )
+        return ERROR_MSG( "failed to open %s.\n", path );
+    lsmash_file_t *fh = lsmash_set_file( input->root, &input->param );
+    if( !fh )
+        return ERROR_MSG( "failed to add an input file into a ROOT.\n" );
+    if( lsmash_read_file( fh, &input->param ) < 0 )
+        return ERROR_MSG( "failed to read %s.\n", path );
+    input->track_ID = lsmash_get_track_ID( input->root, 1 );
+    if( !input->track_ID )
+        return ERROR_MSG( "failed to get a track.\n" );
+    return 0;
+}
+
+static void cleanup_bench_input( bench_input_t *input )
+{
+    lsmash_close_file( &input->param );
+    lsmash_destroy_root( input->root );
+    input->root = NULL;
+}
+
+/* Append tiny samples so that the cost of the sample tables dominates. */
+static int append_synthetic_samples( bench_t *bench, bench_output_t *output )
+{
+    for( uint32_t i = 0; i < bench->num_samples; i++ )
+    {
+        lsmash_sample_t *sample = lsmash_create_sample( BENCH_SAMPLE_SIZE );
+        if( !sample )
+            return ERROR_MSG( "failed to allocate a sample.\n" );
+        memset( sample->data, 0, BENCH_SAMPLE_SIZE );
+        sample->dts           = (uint64_t)i * BENCH_SAMPLE_DELTA;
+        sample->cts           = sample->dts;
+        sample->index         = output->sample_entry;
+        sample->prop.ra_flags = ISOM_SAMPLE_RANDOM_ACCESS_FLAG_SYNC;
+        if( lsmash_append_sample( output->root, output->track_ID, sample ) )
+        {
+            lsmash_delete_sample( sample );
+            return ERROR_MSG( "failed to append a sample.\n" );
+        }
+    }
+    return 0;
+}
+
+static int mux_adts( bench_t *bench, const char *path, bench_result_t *result )
+{
+    importer_t *importer = lsmash_importer_open( bench->path[BENCH_FILE_ADTS], "auto" );
+    if( !importer )
+        return ERROR_MSG( "failed to open %s.\n", bench->path[BENCH_FILE_ADTS] );
+    int               ret     = -1;
+    lsmash_summary_t *summary = lsmash_duplicate_summary( importer, 1 );
+    bench_output_t    output  = { 0 };
+    if( !summary )
+    {
+        ERROR_MSG( "failed to get a summary.\n" );
+        goto cleanup;
+    }
+    if( open_bench_output( &output, path, summary ) < 0 )
+        goto cleanup;
+    while( 1 )
+    {
+        lsmash_sample_t *sample;
+        /* lsmash_importer_get_access_unit() returns 1 if there're any changes in stream's properties, and 2 at EOF. */
+        int err = lsmash_importer_get_access_unit( importer, 1, &sample );
+        if( err == 2 || (err == 0 && !sample) )
+        {
+            lsmash_delete_sample( sample );
+            break;
+        }
+        if( err < 0 || err == 1 )
+        {
+            lsmash_delete_sample( sample );
+            ERROR_MSG( "failed to get an access unit.\n" );
+            goto cleanup;
+        }
+        result->bytes   += sample->length;
+        result->samples += 1;
+        sample->index = output.sample_entry;
+        if( lsmash_append_sample( output.root, output.track_ID, sample ) )
+        {
+            lsmash_delete_sample( sample );
+            ERROR_MSG( "failed to append a sample.\n" );
+            goto cleanup;
+        }
+    }
+    ret = finish_bench_output( &output, lsmash_importer_get_last_delta( importer, 1 ), 1 );
+cleanup:
+    cleanup_bench_output( &output );
+    lsmash_cleanup_summary( summary );
+    lsmash_importer_close( importer );
+    return ret;
+}
+
+static int prepare_bench_file( bench_t *bench, int file_id )
+{
+    if( bench->ready[file_id] )
+        return 0;
+    int ret;
+    bench_result_t dummy = { 0 };
+    switch( file_id )
+    {
+        case BENCH_FILE_RANDOM :
+        case BENCH_FILE_ANNEXB :
+        case BENCH_FILE_ADTS :
+            ret = generate_stream( bench, file_id );
+            break;
+        case BENCH_FILE_MUXED :
+            ret = prepare_bench_file( bench, BENCH_FILE_ADTS );
+            if( ret == 0 )
+                ret = mux_adts( bench, bench->path[BENCH_FILE_MUXED], &dummy );
+            break;
+        case BENCH_FILE_SYNTHETIC :
+        {
+            bench_output_t output;
+            ret = open_bench_output( &output, bench->path[BENCH_FILE_SYNTHETIC], bench->summary );
+            if( ret == 0 )
+                ret = append_synthetic_samples( bench, &output );
+            if( ret == 0 )
+                ret = finish_bench_output( &output, BENCH_SAMPLE_DELTA, 0 );
+            cleanup_bench_output( &output );
+            break;
+        }
+        default :
+            return ERROR_MSG( "unknown file.\n" );
+    }
+    if( ret < 0 )
+        return ERROR_MSG( "failed to prepare %s.\n", bench->path[file_id] );
+    bench->ready[file_id] = 1;
+    return 0;
+}
+
+/* The summary of the generated ADTS is used for the synthetic movies. */
+static int prepare_bench_summary( bench_t *bench )
+{
+    if( bench->summary )
+        return 0;
+    if( prepare_bench_file( bench, BENCH_FILE_ADTS ) < 0 )
+        return -1;
+    importer_t *importer = lsmash_importer_open( bench->path[BENCH_FILE_ADTS], "auto" );
+    if( !importer )
+        return ERROR_MSG( "failed to open %s.\n", bench->path[BENCH_FILE_ADTS] );
+    bench->summary = lsmash_duplicate_summary( importer, 1 );
+    lsmash_importer_close( importer );
+    return bench->summary ? 0 : ERROR_MSG( "failed to get a summary.\n" );
+}
+
+static int bench_bs_read( bench_t *bench, bench_result_t *result )
+{
+    if( prepare_bench_file( bench, BENCH_FILE_RANDOM ) < 0 )
+        return -1;
+    lsmash_bs_t *bs = open_bench_bytestream( bench->path[BENCH_FILE_RANDOM] );
+    if( !bs )
+        return ERROR_MSG( "failed to open %s.\n", bench->path[BENCH_FILE_RANDOM] );
+    uint64_t count = bench->stream_size / 4;
+    uint32_t sum   = 0;
+    double   start = lsmash_get_elapsed_seconds();
+    for( uint64_t i = 0; i < count; i++ )
+        sum += lsmash_bs_get_be32( bs );
+    result->seconds = lsmash_get_elapsed_seconds() - start;
+    result->bytes   = count * 4;
+    bench_sink = sum;
+    int ret = bs->error ? ERROR_MSG( "failed to read a stream.\n" ) : 0;
+    close_bench_bytestream( bs );
+    return ret;
+}
+
+static int bench_bits_read( bench_t *bench, bench_result_t *result )
+{
+    if( prepare_bench_file( bench, BENCH_FILE_RANDOM ) < 0 )
+        return -1;
+    uint64_t size = bench->stream_size < UINT32_MAX ? bench->stream_size : UINT32_MAX;
+    uint8_t *data = lsmash_malloc( size );
+    if( !data )
+        return ERROR_MSG( "failed to allocate a buffer.\n" );
+    FILE *fp = lsmash_fopen( bench->path[BENCH_FILE_RANDOM], "rb" );
+    if( !fp || fread( data, 1, size, fp ) != size )
+    {
+        if( fp )
+            fclose( fp );
+        lsmash_free( data );
+        return ERROR_MSG( "failed to read %s.\n", bench->path[BENCH_FILE_RANDOM] );
+    }
+    fclose( fp );
+    lsmash_bits_t *bits = lsmash_bits_adhoc_create();
+    if( !bits || lsmash_bits_import_data( bits, data, size ) < 0 )
+    {
+        lsmash_bits_adhoc_cleanup( bits );
+        lsmash_free( data );
+        return ERROR_MSG( "failed to set up a bit reader.\n" );
+    }
+    lsmash_free( data );
+    /* Read the fields of 1 to 32 bits in turn. */
+    uint64_t total_bits = size * 8;
+    uint64_t read_bits  = 0;
+    uint64_t sum        = 0;
+    uint32_t width      = 1;
+    double   start      = lsmash_get_elapsed_seconds();
+    while( read_bits + width <= total_bits )
+    {
+        sum       += lsmash_bits_get( bits, width );
+        read_bits += width;
+        width      = width == 32 ? 1 : width + 1;
+    }
+    result->seconds = lsmash_get_elapsed_seconds() - start;
+    result->bytes   = read_bits / 8;
+    bench_sink = sum;
+    lsmash_bits_adhoc_cleanup( bits );
+    return 0;
+}
+
+static int bench_start_code_scan( bench_t *bench, bench_result_t *result )
+{
+    if( prepare_bench_file( bench, BENCH_FILE_ANNEXB ) < 0 )
+        return -1;
+    lsmash_bs_t *bs = open_bench_bytestream( bench->path[BENCH_FILE_ANNEXB] );
+    if( !bs )
+        return ERROR_MSG( "failed to open %s.\n", bench->path[BENCH_FILE_ANNEXB] );
+    uint64_t count = 0;
+    double   start = lsmash_get_elapsed_seconds();
+    while( 1 )
+    {
+        uint64_t offset = lsmash_bs_find_start_code_prefix( bs, 0 );
+        if( offset == lsmash_bs_get_remaining_buffer_size( bs ) )
+            break;  /* no more start code */
+        lsmash_bs_skip_bytes_64( bs, offset + 3 );
+        ++count;
+    }
+    result->seconds = lsmash_get_elapsed_seconds() - start;
+    result->bytes   = bench->stream_size;
+    result->samples = count;
+    int ret = bs->error ? ERROR_MSG( "failed to read a stream.\n" ) : 0;
+    close_bench_bytestream( bs );
+    return ret;
+}
+
+static int bench_sample_append( bench_t *bench, bench_result_t *result )
+{
+    if( prepare_bench_summary( bench ) < 0 )
+        return -1;
+    bench_output_t output;
+    int ret = open_bench_output( &output, bench->path[BENCH_FILE_OUTPUT], bench->summary );
+    if( ret == 0 )
+    {
+        double start = lsmash_get_elapsed_seconds();
+        ret = append_synthetic_samples( bench, &output );
+        if( ret == 0 && lsmash_flush_pooled_samples( output.root, output.track_ID, BENCH_SAMPLE_DELTA ) )
+            ret = ERROR_MSG( "failed to flush samples.\n" );
+        result->seconds = lsmash_get_elapsed_seconds() - start;
+        result->bytes   = (uint64_t)bench->num_samples * BENCH_SAMPLE_SIZE;
+        result->samples = bench->num_samples;
+    }
+    if( ret == 0 )
+        ret = finish_bench_output( &output, BENCH_SAMPLE_DELTA, 0 );
+    cleanup_bench_output( &output );
+    return ret;
+}
+
+static int bench_finish_moov_to_front( bench_t *bench, bench_result_t *result )
+{
+    if( prepare_bench_summary( bench ) < 0 )
+        return -1;
+    bench_output_t output;
+    int ret = open_bench_output( &output, bench->path[BENCH_FILE_OUTPUT], bench->summary );
+    if( ret == 0 )
+        ret = append_synthetic_samples( bench, &output );
+    if( ret == 0 )
+    {
+        double start = lsmash_get_elapsed_seconds();
+        ret = finish_bench_output( &output, BENCH_SAMPLE_DELTA, 1 );
+        result->seconds = lsmash_get_elapsed_seconds() - start;
+        result->samples = bench->num_samples;
+    }
+    cleanup_bench_output( &output );
+    result->bytes = get_file_size( bench->path[BENCH_FILE_OUTPUT] );
+    return ret;
+}
+
+static int bench_timeline_construct( bench_t *bench, bench_result_t *result )
+{
+    if( prepare_bench_summary( bench ) < 0
+     || prepare_bench_file( bench, BENCH_FILE_SYNTHETIC ) < 0 )
+        return -1;
+    bench_input_t input;
+    int ret = open_bench_input( &input, bench->path[BENCH_FILE_SYNTHETIC] );
+    if( ret == 0 )
+    {
+        double start = lsmash_get_elapsed_seconds();
+        if( lsmash_construct_timeline( input.root, input.track_ID ) )
+            ret = ERROR_MSG( "failed to construct a timeline.\n" );
+        result->seconds = lsmash_get_elapsed_seconds() - start;
+        result->samples = lsmash_get_sample_count_in_media_timeline( input.root, input.track_ID );
+    }
+    cleanup_bench_input( &input );
+    return ret;
+}
+
+static int bench_mux( bench_t *bench, bench_result_t *result )
+{
+    if( prepare_bench_file( bench, BENCH_FILE_ADTS ) < 0 )
+        return -1;
+    double start = lsmash_get_elapsed_seconds();
+    int    ret   = mux_adts( bench, bench->path[BENCH_FILE_OUTPUT], result );
+    result->seconds = lsmash_get_elapsed_seconds() - start;
+    return ret;
+}
+
+static int bench_demux( bench_t *bench, bench_result_t *result )
+{
+    if( prepare_bench_file( bench, BENCH_FILE_MUXED ) < 0 )
+        return -1;
+    double        start = lsmash_get_elapsed_seconds();
+    bench_input_t input;
+    int ret = open_bench_input( &input, bench->path[BENCH_FILE_MUXED] );
+    if( ret == 0 && lsmash_construct_timeline( input.root, input.track_ID ) )
+        ret = ERROR_MSG( "failed to construct a timeline.\n" );
+    if( ret == 0 )
+    {
+        uint32_t sample_count = lsmash_get_sample_count_in_media_timeline( input.root, input.track_ID );
+        for( uint32_t i = 1; i <= sample_count; i++ )
+        {
+            lsmash_sample_t *sample = lsmash_get_sample_from_media_timeline( input.root, input.track_ID, i );
+            if( !sample )
+            {
+                ret = ERROR_MSG( "failed to get a sample.\n" );
+                break;
+            }
+            result->bytes   += sample->length;
+            result->samples += 1;
+            bench_sink = sample->data[0];
+            lsmash_delete_sample( sample );
+        }
+    }
+    cleanup_bench_input( &input );
+    result->seconds = lsmash_get_elapsed_seconds() - start;
+    return ret;
+}
+
+static int bench_remux( bench_t *bench, bench_result_t *result )
+{
+    if( prepare_bench_file( bench, BENCH_FILE_MUXED ) < 0 )
+        return -1;
+    double            start   = lsmash_get_elapsed_seconds();
+    bench_input_t     input;
+    bench_output_t    output  = { 0 };
+    lsmash_summary_t *summary = NULL;
+    uint32_t          last_sample_delta;
+    int ret = open_bench_input( &input, bench->path[BENCH_FILE_MUXED] );
+    if( ret == 0
+     && (lsmash_construct_timeline( input.root, input.track_ID )
+      || lsmash_get_last_sample_delta_from_media_timeline( input.root, input.track_ID, &last_sample_delta )) )
+        ret = ERROR_MSG( "failed to construct a timeline.\n" );
+    if( ret == 0 && !(summary = lsmash_get_summary( input.root, input.track_ID, 1 )) )
+        ret = ERROR_MSG( "failed to get a summary.\n" );
+    if( ret == 0 )
+        ret = open_bench_output( &output, bench->path[BENCH_FILE_OUTPUT], summary );
+    if( ret == 0 )
+    {
+        uint32_t sample_count = lsmash_get_sample_count_in_media_timeline( input.root, input.track_ID );
+        for( uint32_t i = 1; i <= sample_count; i++ )
+        {
+            lsmash_sample_t *sample = lsmash_get_sample_from_media_timeline( input.root, input.track_ID, i );
+            if( !sample )
+            {
+                ret = ERROR_MSG( "failed to get a sample.\n" );
+                break;
+            }
+            result->bytes   += sample->length;
+            result->samples += 1;
+            sample->index = output.sample_entry;
+            if( lsmash_append_sample( output.root, output.track_ID, sample ) )
+            {
+                lsmash_delete_sample( sample );
+                ret = ERROR_MSG( "failed to append a sample.\n" );
+                break;
+            }
+        }
+    }
+    if( ret == 0 )
+        ret = finish_bench_output( &output, last_sample_delta, 1 );
+    cleanup_bench_output( &output );
+    lsmash_cleanup_summary( summary );
+    cleanup_bench_input( &input );
+    result->seconds = lsmash_get_elapsed_seconds() - start;
+    return ret;
+}
+
+static const struct
+{
+    const char *name;
+    const char *description;
+    int (*func)( bench_t *, bench_result_t * );
+} bench_cases[] =
+    {
+        { "bs_read",               "big-endian 32-bit reads through the bytestream reader", bench_bs_read              },
+        { "bits_read",             "1 to 32-bit reads through the bit reader",              bench_bits_read            },
+        { "start_code_scan",       "start code search over NAL units",                      bench_start_code_scan      },
+        { "sample_append",         "appending tiny samples to a sample table",              bench_sample_append        },
+        { "finish_moov_to_front",  "finishing a movie with the movie header moved to front", bench_finish_moov_to_front },
+        { "timeline_construct",    "constructing the media timeline of tiny samples",       bench_timeline_construct   },
+        { "mux",                   "muxing ADTS into MP4",                                   bench_mux                  },
+        { "demux",                 "reading every sample of MP4",                            bench_demux                },
+        { "remux",                 "remuxing MP4 sample by sample",                          bench_remux                },
+        { NULL,                    NULL,                                                     NULL                       }
+    };
+
+static int is_selected( bench_t *bench, const char *name )
+{
+    if( !bench->filter )
+        return 1;
+    size_t      length = strlen( name );
+    const char *p      = bench->filter;
+    while( (p = strstr( p, name )) )
+    {
+        if( (p == bench->filter || p[-1] == ',') && (p[length] == ',' || p[length] == '\0') )
+            return 1;
+        p += length;
+    }
+    return 0;
+}
+
+static void print_result( const char *name, int ret, bench_result_t *best, int first )
+{
+    printf( "%s\n    {\"name\":\"%s\",\"status\":\"%s\"", first ? "" : ",", name, ret < 0 ? "failed" : "ok" );
+    if( ret == 0 )
+    {
+        double seconds = best->seconds > 0 ? best->seconds : 1e-9;
+        printf( ",\"seconds\":%.6f", best->seconds );
+        if( best->bytes )
+            printf( ",\"bytes\":%"PRIu64",\"mb_per_sec\":%.3f", best->bytes, best->bytes / seconds * 1e-6 );
+        if( best->samples )
+            printf( ",\"samples\":%"PRIu64",\"samples_per_sec\":%.1f", best->samples, best->samples / seconds );
+    }
+    printf( ",\"peak_rss_kb\":%"PRIu64"}", get_peak_rss_kb() );
+    fflush( stdout );
+}
+
+static int parse_cli_option( int argc, char *argv[], bench_t *bench )
+{
+    for( int i = 1; i < argc; i++ )
+    {
+        if( !strcasecmp( argv[i], "--help" ) )
+        {
+            display_help();
+            exit( 0 );
+        }
+        else if( !strcasecmp( argv[i], "--version" ) )
+        {
+            display_version();
+            exit( 0 );
+        }
+        else if( !strcasecmp( argv[i], "--list" ) )
+        {
+            for( int j = 0; bench_cases[j].name; j++ )
+                printf( "%-22s %s\n", bench_cases[j].name, bench_cases[j].description );
+            exit( 0 );
+        }
+        else if( i + 1 == argc )
+            return ERROR_MSG( "%s requires an argument or is unknown.\n", argv[i] );
+        else if( !strcasecmp( argv[i], "--filter" ) )
+            bench->filter = argv[++i];
+        else if( !strcasecmp( argv[i], "--size" ) )
+        {
+            int size = atoi( argv[++i] );
+            if( size <= 0 )
+                return ERROR_MSG( "--size requires a positive integer.\n" );
+            bench->stream_size = (uint64_t)size * 1024 * 1024;
+        }
+        else if( !strcasecmp( argv[i], "--samples" ) )
+        {
+            int num_samples = atoi( argv[++i] );
+            if( num_samples <= 0 )
+                return ERROR_MSG( "--samples requires a positive integer.\n" );
+            bench->num_samples = num_samples;
+        }
+        else if( !strcasecmp( argv[i], "--iterations" ) )
+        {
+            bench->iterations = atoi( argv[++i] );
+            if( bench->iterations <= 0 )
+                return ERROR_MSG( "--iterations requires a positive integer.\n" );
+        }
+        else if( !strcasecmp( argv[i], "--tmpdir" ) )
+            bench->tmpdir = argv[++i];
+        else
+            return ERROR_MSG( "unkown option found: %s\n", argv[i] );
+    }
+    for( int i = 0; i < BENCH_FILE_COUNT; i++ )
+    {
+        size_t length = strlen( bench->tmpdir ) + strlen( bench_file_name[i] ) + 2;
+        bench->path[i] = lsmash_malloc( length );
+        if( !bench->path[i] )
+            return ERROR_MSG( "failed to allocate a path.\n" );
+        sprintf( bench->path[i], "%s/%s", bench->tmpdir, bench_file_name[i] );
+    }
+    return 0;
+}
+
+static void cleanup_bench( bench_t *bench )
+{
+    for( int i = 0; i < BENCH_FILE_COUNT; i++ )
+        if( bench->path[i] )
+        {
+            remove( bench->path[i] );
+            lsmash_free( bench->path[i] );
+        }
+    lsmash_cleanup_summary( bench->summary );
+}
+
+int main( int argc, char *argv[] )
+{
+    lsmash_get_mainargs( &argc, &argv );
+    bench_t bench =
+    {
+        .stream_size = BENCH_DEFAULT_STREAM_SIZE,
+        .num_samples = BENCH_DEFAULT_NUM_SAMPLES,
+        .iterations  = BENCH_DEFAULT_ITERATIONS,
+        .tmpdir      = ".",
+        .filter      = NULL,
+        .summary     = NULL
+    };
+    if( parse_cli_option( argc, argv, &bench ) < 0 )
+    {
+        cleanup_bench( &bench );
+        return -1;
+    }
+    printf( "{\"version\":\"rev%s %s\",\"stream_size\":%"PRIu64",\"num_samples\":%"PRIu32",\"iterations\":%d,\"benchmarks\":[",
+            LSMASH_REV, LSMASH_GIT_HASH, bench.stream_size, bench.num_samples, bench.iterations );
+    int num_failed = 0;
+    int first      = 1;
+    for( int i = 0; bench_cases[i].name; i++ )
+    {
+        if( !is_selected( &bench, bench_cases[i].name ) )
+            continue;
+        eprintf( "Running %s...\n", bench_cases[i].name );
+        bench_result_t best = { 0 };
+        int ret = 0;
+        for( int j = 0; j < bench.iterations && ret == 0; j++ )
+        {
+            bench_result_t result = { 0 };
+            ret = bench_cases[i].func( &bench, &result );
+            if( ret == 0 && (j == 0 || result.seconds < best.seconds) )
+                best = result;
+        }
+        if( ret < 0 )
+            ++num_failed;
+        print_result( bench_cases[i].name, ret, &best, first );
+        first = 0;
+    }
+    printf( "\n]}\n" );
+    cleanup_bench( &bench );
+    return num_failed ? -1 : 0;
+}
@@ -52,7 +52,45 @@ static void display_help( void )
              "    --version      Display version information\n"
              "    --box          Dump box structure\n"
              "    --chapter      Extract chapter list\n"
-             "    --timestamp    Dump media timestamps\n" );
+             "    --timestamp    Dump media timestamps\n"
+             "  box options:\n"
+             "    --depth <integer>\n"
+             "                   Dump boxes nested up to the given depth\n"
+             "                   1 means top-level boxes only.\n"
+             "    --type <4CC>   Dump boxes of the given type only\n"
+             "                   This option can be specified more than once.\n"
+             "    --entries <integer>\n"
+             "                   Dump up to the given number of entries per table\n"
+             "    --format <string>\n"
+             "                   Specify the output format [\"text\"]\n"
+             "                     - text : human readable text\n"
+             "                     - json : a JSON tree of boxes\n"
+             "                     - ndjson : a JSON object per box and line\n"
+             "  timestamp options:\n"
+             "    --format <string>\n"
+             "                   Specify the output format [\"text\"]\n"
+             "                     - text : human readable text\n"
+             "                     - csv : lines of track_ID,DTS,CTS\n"
+             "                     - binary : for each track, track_ID, media timescale and\n"
+             "                                the number of samples as 32-bit little-endian,\n"
+             "                                followed by DTS and CTS of each sample\n"
+             "                                as 64-bit little-endian\n"
+             "    --track <integer>\n"
+             "                   Dump timestamps of the track with the given track_ID only\n"
+             "    --threads <integer>\n"
+             "                   Dump the tracks on the given number of threads [1]\n"
+             "                   The output is still in the order of the tracks.\n" );
+}
+
+#define MAX_NUM_OF_BOX_TYPES 64
+
+static lsmash_compact_box_type_t boxdumper_parse_fourcc( const char *str )
+{
+    /* Pad with spaces, e.g. 'url '. */
+    char fourcc[4] = { ' ', ' ', ' ', ' ' };
+    for( int i = 0; i < 4 && str[i]; i++ )
+        fourcc[i] = str[i];
+    return LSMASH_4CC( fourcc[0], fourcc[1], fourcc[2], fourcc[3] );
 }
 
 static int boxdumper_error
@@ -69,7 +107,218 @@ static int boxdumper_error
 }
 
 #define BOXDUMPER_ERR( message ) boxdumper_error( root, &file_param, message )
-#define DO_NOTHING
+
+typedef enum
+{
+    TIMESTAMP_FORMAT_TEXT   = 0,
+    TIMESTAMP_FORMAT_CSV    = 1,
+    TIMESTAMP_FORMAT_BINARY = 2,
+} timestamp_format;
+
+/* the number of samples exported from the timeline at a time */
+#define TIMESTAMP_CHUNK_SIZE 4096
+/* the maximum length of a formatted sample: "DTS = " + 20 digits + ", CTS = " + 20 digits + '\n' */
+#define TIMESTAMP_LINE_SIZE  64
+
+/* Format a decimal number without the format parsing of the printf family. */
+static char *boxdumper_put_uint( char *p, uint64_t value )
+{
+    char digits[20];
+    int  n = 20;
+    do
+    {
+        digits[--n] = '0' + value % 10;
+        value /= 10;
+    } while( value );
+    memcpy( p, &digits[n], 20 - n );
+    return p + 20 - n;
+}
+
+static char *boxdumper_put_string( char *p, const char *str )
+{
+    size_t length = strlen( str );
+    memcpy( p, str, length );
+    return p + length;
+}
+
+static char *boxdumper_put_le32( char *p, uint32_t value )
+{
+    for( int i = 0; i < 4; i++ )
+        *p++ = (char)(value >> (8 * i));
+    return p;
+}
+
+static char *boxdumper_put_le64( char *p, uint64_t value )
+{
+    for( int i = 0; i < 8; i++ )
+        *p++ = (char)(value >> (8 * i));
+    return p;
+}
+
+static int boxdumper_dump_timestamps( lsmash_root_t *root, uint32_t track_ID, uint32_t timescale, timestamp_format format, char *buffer, uint64_t *dts, uint64_t *cts, FILE *out )
+{
+    if( lsmash_construct_timeline( root, track_ID ) )
+        return -1;
+    uint32_t timeline_shift;
+    if( lsmash_get_composition_to_decode_shift_from_media_timeline( root, track_ID, &timeline_shift ) )
+        return -1;
+    uint32_t sample_count = lsmash_get_sample_count_in_media_timeline( root, track_ID );
+    char *p = buffer;
+    if( format == TIMESTAMP_FORMAT_TEXT )
+    {
+        p = boxdumper_put_string( p, "track_ID: " );
+        p = boxdumper_put_uint( p, track_ID );
+        p = boxdumper_put_string( p, "\nMedia timescale: " );
+        p = boxdumper_put_uint( p, timescale );
+        *p++ = '\n';
+    }
+    else if( format == TIMESTAMP_FORMAT_BINARY )
+    {
+        p = boxdumper_put_le32( p, track_ID );
+        p = boxdumper_put_le32( p, timescale );
+        p = boxdumper_put_le32( p, sample_count );
+    }
+    for( uint32_t first = 1; first <= sample_count; )
+    {
+        uint32_t count = sample_count - first + 1;
+        if( count > TIMESTAMP_CHUNK_SIZE )
+            count = TIMESTAMP_CHUNK_SIZE;
+        if( lsmash_export_media_timestamps( root, track_ID, first, count, dts, cts ) )
+            return -1;
+        for( uint32_t i = 0; i < count; i++ )
+        {
+            uint64_t composition = cts[i] + timeline_shift;
+            if( format == TIMESTAMP_FORMAT_TEXT )
+            {
+                p = boxdumper_put_string( p, "DTS = " );
+                p = boxdumper_put_uint( p, dts[i] );
+                p = boxdumper_put_string( p, ", CTS = " );
+                p = boxdumper_put_uint( p, composition );
+                *p++ = '\n';
+            }
+            else if( format == TIMESTAMP_FORMAT_CSV )
+            {
+                p = boxdumper_put_uint( p, track_ID );
+                *p++ = ',';
+                p = boxdumper_put_uint( p, dts[i] );
+                *p++ = ',';
+                p = boxdumper_put_uint( p, composition );
+                *p++ = '\n';
+            }
+            else
+            {
+                p = boxdumper_put_le64( p, dts[i] );
+                p = boxdumper_put_le64( p, composition );
+            }
+        }
+        if( fwrite( buffer, 1, p - buffer, out ) != (size_t)(p - buffer) )
+            return -1;
+        p = buffer;
+        first += count;
+    }
+    if( format == TIMESTAMP_FORMAT_TEXT )
+        *p++ = '\n';
+    if( p != buffer && fwrite( buffer, 1, p - buffer, out ) != (size_t)(p - buffer) )
+        return -1;
+    /* The timeline is no longer needed. */
+    lsmash_destruct_timeline( root, track_ID );
+    return 0;
+}
+
+/* Each worker thread reads the file into its own ROOT since a ROOT must not be shared between threads.
+ * The first worker uses the ROOT opened by main() which is idle while the tracks are dumped. */
+typedef struct
+{
+    lsmash_root_t           *root;
+    lsmash_file_parameters_t file_param;
+    int                      own_root;
+    char                    *buffer;
+    uint64_t                *dts;
+    uint64_t                *cts;
+} timestamp_worker_t;
+
+typedef struct
+{
+    const char         *filename;
+    timestamp_format    format;
+    uint32_t           *track_ID;   /* the tracks to be dumped in order */
+    uint32_t           *timescale;
+    FILE              **output;     /* per track, a temporary file if the tracks are dumped concurrently */
+    timestamp_worker_t *worker;
+    int                 err;
+} timestamp_export_t;
+
+static int boxdumper_open_worker( timestamp_worker_t *worker, const char *filename )
+{
+    worker->root = lsmash_create_root();
+    if( !worker->root )
+        return -1;
+    worker->own_root = 1;
+    if( lsmash_open_file( filename, 1, &worker->file_param ) < 0 )
+        return -1;
+    lsmash_file_t *file = lsmash_set_file( worker->root, &worker->file_param );
+    if( !file || lsmash_read_file( file, &worker->file_param ) < 0 )
+        return -1;
+    return 0;
+}
+
+static void boxdumper_close_worker( timestamp_worker_t *worker )
+{
+    if( worker->own_root )
+    {
+        lsmash_close_file( &worker->file_param );
+        lsmash_destroy_root( worker->root );
+    }
+    lsmash_free( worker->buffer );
+    lsmash_free( worker->dts );
+    lsmash_free( worker->cts );
+}
+
+static int boxdumper_export_track( void *arg, uint32_t index, int worker_index )
+{
+    timestamp_export_t *ex     = (timestamp_export_t *)arg;
+    timestamp_worker_t *worker = &ex->worker[worker_index];
+    if( !worker->root && boxdumper_open_worker( worker, ex->filename ) < 0 )
+        return -1;
+    if( !worker->buffer )
+    {
+        worker->buffer = lsmash_malloc( TIMESTAMP_CHUNK_SIZE * TIMESTAMP_LINE_SIZE );
+        worker->dts    = lsmash_malloc( TIMESTAMP_CHUNK_SIZE * sizeof(uint64_t) );
+        worker->cts    = lsmash_malloc( TIMESTAMP_CHUNK_SIZE * sizeof(uint64_t) );
+        if( !worker->buffer || !worker->dts || !worker->cts )
+            return -1;
+    }
+    FILE *out = stdout;
+    if( ex->output && !(out = ex->output[index] = tmpfile()) )
+        return -1;
+    return boxdumper_dump_timestamps( worker->root, ex->track_ID[index], ex->timescale[index], ex->format,
+                                      worker->buffer, worker->dts, worker->cts, out );
+}
+
+/* Copy the timestamps of a track dumped into a temporary file into stdout. */
+static void boxdumper_write_track( void *arg, uint32_t index, int ret )
+{
+    timestamp_export_t *ex = (timestamp_export_t *)arg;
+    if( ret < 0 )
+        ex->err = -1;
+    FILE *in = ex->output ? ex->output[index] : NULL;
+    if( !in )
+        return;
+    if( !ex->err )
+    {
+        char   buffer[65536];
+        size_t size;
+        rewind( in );
+        while( (size = fread( buffer, 1, sizeof(buffer), in )) > 0 )
+            if( fwrite( buffer, 1, size, stdout ) != size )
+            {
+                ex->err = -1;
+                break;
+            }
+    }
+    fclose( in );
+    ex->output[index] = NULL;
+}
 
 int main( int argc, char *argv[] )
 {
@@ -91,26 +340,120 @@ int main( int argc, char *argv[] )
     int dump_box = 1;
     int chapter = 0;
     char *filename;
+    lsmash_compact_box_type_t box_types[MAX_NUM_OF_BOX_TYPES];
+    lsmash_print_parameters_t print_param = { 0 };
+    timestamp_format ts_format = TIMESTAMP_FORMAT_TEXT;
+    uint32_t ts_track_ID = 0;
+    int ts_threads = 1;
+    print_param.types = box_types;
     lsmash_get_mainargs( &argc, &argv );
     if( argc > 2 )
     {
-        if( !strcasecmp( argv[1], "--box" ) )
-            DO_NOTHING;
-        else if( !strcasecmp( argv[1], "--chapter" ) )
+        int i = 1;
+        if( !strcasecmp( argv[i], "--box" ) )
+            ++i;
+        else if( !strcasecmp( argv[i], "--chapter" ) )
+        {
             chapter = 1;
-        else if( !strcasecmp( argv[1], "--timestamp" ) )
+            ++i;
+        }
+        else if( !strcasecmp( argv[i], "--timestamp" ) )
+        {
             dump_box = 0;
-        else
+            ++i;
+        }
+        for( ; i < argc - 1; i++ )
+        {
+            if( dump_box && !chapter && i + 1 < argc - 1 )
+            {
+                if( !strcasecmp( argv[i], "--depth" ) )
+                {
+                    print_param.max_depth = atoi( argv[++i] );
+                    if( print_param.max_depth < 0 )
+                        print_param.max_depth = 0;
+                    continue;
+                }
+                else if( !strcasecmp( argv[i], "--type" ) )
+                {
+                    if( print_param.type_count < MAX_NUM_OF_BOX_TYPES )
+                        box_types[ print_param.type_count++ ] = boxdumper_parse_fourcc( argv[++i] );
+                    else
+                        ++i;
+                    continue;
+                }
+                else if( !strcasecmp( argv[i], "--entries" ) )
+                {
+                    int max_entries = atoi( argv[++i] );
+                    print_param.max_entries = max_entries > 0 ? max_entries : 0;
+                    continue;
+                }
+                else if( !strcasecmp( argv[i], "--format" ) )
+                {
+                    ++i;
+                    if( !strcasecmp( argv[i], "text" ) )
+                        print_param.format = LSMASH_PRINT_FORMAT_TEXT;
+                    else if( !strcasecmp( argv[i], "json" ) )
+                        print_param.format = LSMASH_PRINT_FORMAT_JSON;
+                    else if( !strcasecmp( argv[i], "ndjson" ) )
+                        print_param.format = LSMASH_PRINT_FORMAT_NDJSON;
+                    else
+                    {
+                        display_help();
+                        return -1;
+                    }
+                    continue;
+                }
+            }
+            else if( !dump_box && i + 1 < argc - 1 )
+            {
+                if( !strcasecmp( argv[i], "--format" ) )
+                {
+                    ++i;
+                    if( !strcasecmp( argv[i], "text" ) )
+                        ts_format = TIMESTAMP_FORMAT_TEXT;
+                    else if( !strcasecmp( argv[i], "csv" ) )
+                        ts_format = TIMESTAMP_FORMAT_CSV;
+                    else if( !strcasecmp( argv[i], "binary" ) )
+                        ts_format = TIMESTAMP_FORMAT_BINARY;
+                    else
+                    {
+                        display_help();
+                        return -1;
+                    }
+                    continue;
+                }
+                else if( !strcasecmp( argv[i], "--track" ) )
+                {
+                    ts_track_ID = strtoul( argv[++i], NULL, 10 );
+                    continue;
+                }
+                else if( !strcasecmp( argv[i], "--threads" ) )
+                {
+                    ts_threads = atoi( argv[++i] );
+                    if( ts_threads < 1 || ts_threads > LSMASH_TASK_MAX_THREADS )
+                    {
+                        display_help();
+                        return -1;
+                    }
+                    continue;
+                }
+            }
+            display_help();
+            return -1;
+        }
+        if( i != argc - 1 )
         {
             display_help();
             return -1;
         }
-        filename = argv[2];
+        filename = argv[i];
     }
     else
     {
         filename = argv[1];
     }
+    if( !print_param.type_count )
+        print_param.types = NULL;
     /* Open the input file. */
     lsmash_root_t *root = lsmash_create_root();
     if( !root )
@@ -126,55 +469,83 @@ int main( int argc, char *argv[] )
     lsmash_file_t *file = lsmash_set_file( root, &file_param );
     if( !file )
         return BOXDUMPER_ERR( "Failed to add a file into a ROOT.\n" );
+    /* Box structure is dumped while reading the file. */
+    if( dump_box && !chapter && lsmash_print_movie_while_reading( file, "-", &print_param ) < 0 )
+        return BOXDUMPER_ERR( "Failed to set up dumping box structure.\n" );
     if( lsmash_read_file( file, &file_param ) < 0 )
-        return BOXDUMPER_ERR( "Failed to read a file\n" );
+        return BOXDUMPER_ERR( dump_box && !chapter ? "Failed to dump box structure.\n" : "Failed to read a file\n" );
     /* Dump the input file. */
     if( chapter )
     {
         if( lsmash_print_chapter_list( root ) )
             return BOXDUMPER_ERR( "Failed to extract chapter.\n" );
     }
-    else if( dump_box )
-    {
-        if( lsmash_print_movie( root, "-" ) )
-            return BOXDUMPER_ERR( "Failed to dump box structure.\n" );
-    }
-    else
+    else if( !dump_box )
     {
         lsmash_movie_parameters_t movie_param;
         lsmash_initialize_movie_parameters( &movie_param );
         lsmash_get_movie_parameters( root, &movie_param );
         uint32_t num_tracks = movie_param.number_of_tracks;
+        timestamp_export_t ex = { .filename = filename, .format = ts_format };
+        ex.track_ID  = lsmash_malloc_zero( (num_tracks + 1) * sizeof(uint32_t) );
+        ex.timescale = lsmash_malloc_zero( (num_tracks + 1) * sizeof(uint32_t) );
+        ex.worker    = lsmash_malloc_zero( ts_threads * sizeof(timestamp_worker_t) );
+        if( ts_threads > 1 )
+            ex.output = lsmash_malloc_zero( (num_tracks + 1) * sizeof(FILE *) );
+        if( !ex.track_ID || !ex.timescale || !ex.worker || (ts_threads > 1 && !ex.output) )
+        {
+            lsmash_free( ex.track_ID );
+            lsmash_free( ex.timescale );
+            lsmash_free( ex.worker );
+            lsmash_free( ex.output );
+            return BOXDUMPER_ERR( "Failed to allocate memory.\n" );
+        }
+        /* Pick up the tracks to be dumped. */
+        uint32_t num_exports = 0;
+        const char *message = NULL;
         for( uint32_t track_number = 1; track_number <= num_tracks; track_number++ )
         {
             uint32_t track_ID = lsmash_get_track_ID( root, track_number );
             if( !track_ID )
-                return BOXDUMPER_ERR( "Failed to get track_ID.\n" );
+            {
+                message = "Failed to get track_ID.\n";
+                break;
+            }
+            if( ts_track_ID && track_ID != ts_track_ID )
+                continue;
             lsmash_media_parameters_t media_param;
             lsmash_initialize_media_parameters( &media_param );
             if( lsmash_get_media_parameters( root, track_ID, &media_param ) )
-                return BOXDUMPER_ERR( "Failed to get media parameters.\n" );
-            if( lsmash_construct_timeline( root, track_ID ) )
-                return BOXDUMPER_ERR( "Failed to construct timeline.\n" );
-            uint32_t timeline_shift;
-            if( lsmash_get_composition_to_decode_shift_from_media_timeline( root, track_ID, &timeline_shift ) )
-                return BOXDUMPER_ERR( "Failed to get timestamps.\n" );
-            lsmash_media_ts_list_t ts_list;
-            if( lsmash_get_media_timestamps( root, track_ID, &ts_list ) )
-                return BOXDUMPER_ERR( "Failed to get timestamps.\n" );
-            fprintf( stdout, "track_ID: %"PRIu32"\n", track_ID );
-            fprintf( stdout, "Media timescale: %"PRIu32"\n", media_param.timescale );
-            lsmash_media_ts_t *ts_array = ts_list.timestamp;
-            if( !ts_array )
             {
-                fprintf( stdout, "\n" );
-                continue;
+                message = "Failed to get media parameters.\n";
+                break;
             }
-            for( uint32_t i = 0; i < ts_list.sample_count; i++ )
-                fprintf( stdout, "DTS = %"PRIu64", CTS = %"PRIu64"\n", ts_array[i].dts, ts_array[i].cts + timeline_shift );
-            lsmash_free( ts_array );
-            fprintf( stdout, "\n" );
+            ex.track_ID [num_exports] = track_ID;
+            ex.timescale[num_exports] = media_param.timescale;
+            ++num_exports;
+        }
+#ifdef _WIN32
+        if( ts_format == TIMESTAMP_FORMAT_BINARY )
+            _setmode( _fileno( stdout ), _O_BINARY );
+#endif
+        if( !message )
+        {
+            if( ts_format == TIMESTAMP_FORMAT_CSV )
+                fprintf( stdout, "track_ID,DTS,CTS\n" );
+            /* Each track is dumped by a task on the thread pool, and written out in the order of the tracks. */
+            ex.worker[0].root = root;
+            if( lsmash_run_tasks( num_exports, ts_threads, boxdumper_export_track, boxdumper_write_track, &ex ) < 0 || ex.err )
+                message = "Failed to dump timestamps.\n";
         }
+        for( int i = 0; i < ts_threads; i++ )
+            boxdumper_close_worker( &ex.worker[i] );
+        lsmash_free( ex.track_ID );
+        lsmash_free( ex.timescale );
+        lsmash_free( ex.worker );
+        lsmash_free( ex.output );
+        if( message )
+            return BOXDUMPER_ERR( message );
+        fflush( stdout );
     }
     lsmash_destroy_root( root );
     return 0;
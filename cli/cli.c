@@ -25,12 +25,23 @@
 #include <stdlib.h>
 #include <string.h>
 #include <stdarg.h>
+#include <ctype.h>
+#include <inttypes.h>
 #ifdef _WIN32
 #define WIN32_LEAN_AND_MEAN
+#if !defined( _WIN32_WINNT ) || _WIN32_WINNT < 0x0600
+#undef  _WIN32_WINNT
+#define _WIN32_WINNT 0x0600     /* for condition variables */
+#endif
 #include <windows.h>
 #include <shellapi.h>
+#else
+#include <time.h>
+#include <pthread.h>
 #endif
 
+#include "cli.h"
+
 #ifdef _WIN32
 void lsmash_get_mainargs( int *argc, char ***argv )
 {
@@ -57,3 +68,506 @@ int lsmash_write_lsmash_indicator( lsmash_root_t *root )
     }
     return lsmash_write_top_level_box( free_box );
 }
+
+double lsmash_get_elapsed_seconds( void )
+{
+#ifdef _WIN32
+    LARGE_INTEGER frequency;
+    LARGE_INTEGER counter;
+    QueryPerformanceFrequency( &frequency );
+    QueryPerformanceCounter( &counter );
+    return (double)counter.QuadPart / frequency.QuadPart;
+#else
+    struct timespec ts;
+    clock_gettime( CLOCK_MONOTONIC, &ts );
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+#endif
+}
+
+/* Split a line into arguments in place.
+ * Arguments are separated by white spaces, and an argument enclosed in double quotes may contain them. */
+static int split_job_line( char *line, char **argv, int max_args )
+{
+    int   argc = 1;     /* argv[0] is the program name. */
+    char *p    = line;
+    while( 1 )
+    {
+        while( isspace( (unsigned char)*p ) )
+            ++p;
+        if( *p == '\0' )
+            break;
+        if( argc == max_args )
+            return -1;
+        char *end;
+        if( *p == '"' )
+        {
+            argv[argc++] = ++p;
+            end = strchr( p, '"' );
+            if( !end )
+                return -1;
+        }
+        else
+        {
+            argv[argc++] = p;
+            for( end = p; *end && !isspace( (unsigned char)*end ); end++ );
+        }
+        if( *end == '\0' )
+            break;
+        *end = '\0';
+        p = end + 1;
+    }
+    return argc;
+}
+
+typedef struct
+{
+    int ret;
+    int done;
+} task_t;
+
+typedef struct
+{
+    lsmash_task_func_t func;
+    void              *arg;
+    task_t            *task;
+    uint32_t           num_tasks;
+    uint32_t           next;    /* the index of the task taken next by a worker */
+#ifdef _WIN32
+    CRITICAL_SECTION   mutex;
+    CONDITION_VARIABLE cond;
+#else
+    pthread_mutex_t    mutex;
+    pthread_cond_t     cond;
+#endif
+} task_pool_t;
+
+typedef struct
+{
+    task_pool_t *pool;
+    int          index;
+} task_worker_t;
+
+#ifdef _WIN32
+#define task_pool_lock( pool )   EnterCriticalSection( &(pool)->mutex )
+#define task_pool_unlock( pool ) LeaveCriticalSection( &(pool)->mutex )
+#define task_pool_wait( pool )   SleepConditionVariableCS( &(pool)->cond, &(pool)->mutex, INFINITE )
+#define task_pool_signal( pool ) WakeAllConditionVariable( &(pool)->cond )
+#else
+#define task_pool_lock( pool )   pthread_mutex_lock( &(pool)->mutex )
+#define task_pool_unlock( pool ) pthread_mutex_unlock( &(pool)->mutex )
+#define task_pool_wait( pool )   pthread_cond_wait( &(pool)->cond, &(pool)->mutex )
+#define task_pool_signal( pool ) pthread_cond_broadcast( &(pool)->cond )
+#endif
+
+#ifdef _WIN32
+static DWORD WINAPI task_worker( LPVOID arg )
+#else
+static void *task_worker( void *arg )
+#endif
+{
+    task_worker_t *worker = (task_worker_t *)arg;
+    task_pool_t   *pool   = worker->pool;
+    task_pool_lock( pool );
+    while( pool->next < pool->num_tasks )
+    {
+        uint32_t index = pool->next++;
+        task_pool_unlock( pool );
+        int ret = pool->func( pool->arg, index, worker->index );
+        task_pool_lock( pool );
+        pool->task[index].ret  = ret;
+        pool->task[index].done = 1;
+        task_pool_signal( pool );
+    }
+    task_pool_unlock( pool );
+    return 0;
+}
+
+int lsmash_run_tasks( uint32_t num_tasks, int num_threads, lsmash_task_func_t func, lsmash_task_done_func_t done, void *arg )
+{
+    if( num_tasks == 0 )
+        return 0;
+    task_pool_t pool = { .func = func, .arg = arg, .num_tasks = num_tasks };
+    pool.task = lsmash_malloc_zero( num_tasks * sizeof(task_t) );
+    if( !pool.task )
+        return -1;
+    if( num_threads > LSMASH_TASK_MAX_THREADS )
+        num_threads = LSMASH_TASK_MAX_THREADS;
+    /* With a single thread, the tasks are run one by one in this thread. */
+    int           num_workers = 0;
+    task_worker_t worker[LSMASH_TASK_MAX_THREADS];
+#ifdef _WIN32
+    HANDLE        thread[LSMASH_TASK_MAX_THREADS];
+#else
+    pthread_t     thread[LSMASH_TASK_MAX_THREADS];
+#endif
+    if( num_threads > 1 )
+    {
+#ifdef _WIN32
+        InitializeCriticalSection( &pool.mutex );
+        InitializeConditionVariable( &pool.cond );
+#else
+        pthread_mutex_init( &pool.mutex, NULL );
+        pthread_cond_init( &pool.cond, NULL );
+#endif
+        for( int i = 0; i < num_threads && (uint32_t)i < num_tasks; i++ )
+        {
+            worker[num_workers] = (task_worker_t){ &pool, num_workers };
+#ifdef _WIN32
+            if( (thread[num_workers] = CreateThread( NULL, 0, task_worker, &worker[num_workers], 0, NULL )) != NULL )
+#else
+            if( pthread_create( &thread[num_workers], NULL, task_worker, &worker[num_workers] ) == 0 )
+#endif
+                ++num_workers;
+        }
+    }
+    for( uint32_t i = 0; i < num_tasks; i++ )
+    {
+        int ret;
+        if( num_workers )
+        {
+            task_pool_lock( &pool );
+            while( !pool.task[i].done )
+                task_pool_wait( &pool );
+            ret = pool.task[i].ret;
+            task_pool_unlock( &pool );
+        }
+        else
+            ret = func( arg, i, 0 );
+        if( done )
+            done( arg, i, ret );
+    }
+    if( num_threads > 1 )
+    {
+#ifdef _WIN32
+        WaitForMultipleObjects( num_workers, thread, TRUE, INFINITE );
+        for( int i = 0; i < num_workers; i++ )
+            CloseHandle( thread[i] );
+        DeleteCriticalSection( &pool.mutex );
+#else
+        for( int i = 0; i < num_workers; i++ )
+            pthread_join( thread[i], NULL );
+        pthread_cond_destroy( &pool.cond );
+        pthread_mutex_destroy( &pool.mutex );
+#endif
+    }
+    lsmash_free( pool.task );
+    return 0;
+}
+
+typedef struct
+{
+    uint32_t job_number;
+    uint32_t line_number;
+    char    *line;      /* holds the arguments */
+    int      argc;      /* negative if the line could not be parsed */
+    char   **argv;
+    double   elapsed;
+} job_t;
+
+typedef struct
+{
+    lsmash_job_func_t func;
+    job_t            *job;
+    uint32_t          num_jobs;
+    int               num_failed;
+} job_list_t;
+
+static int run_job( void *arg, uint32_t index, int worker )
+{
+    job_list_t *list  = (job_list_t *)arg;
+    job_t      *job   = &list->job[index];
+    double      start = lsmash_get_elapsed_seconds();
+    int         ret   = job->argc < 0 ? -1 : list->func( job->argc, job->argv );
+    job->elapsed = lsmash_get_elapsed_seconds() - start;
+    return ret;
+}
+
+static void report_job( void *arg, uint32_t index, int ret )
+{
+    job_list_t *list = (job_list_t *)arg;
+    job_t      *job  = &list->job[index];
+    if( ret != 0 )
+        ++ list->num_failed;
+    printf( "{\"job\":%"PRIu32",\"line\":%"PRIu32",\"status\":\"%s\",\"code\":%d,\"elapsed\":%.6f}\n",
+            job->job_number, job->line_number, ret == 0 ? "ok" : "failed", ret, job->elapsed );
+    fflush( stdout );
+}
+
+/* Read all jobs from the job list.
+ * A line which cannot be read is kept as a failed job so that it is reported and counted like the others.
+ * Return 0, or -1 on a fatal error. */
+static int read_jobs( FILE *fp, char *program, job_list_t *list )
+{
+    char *line = lsmash_malloc( LSMASH_JOB_LINE_SIZE );
+    if( !line )
+        return -1;
+    char    *argv[LSMASH_JOB_MAX_ARGS + 1];
+    uint32_t line_number = 0;
+    uint32_t alloc_jobs  = 0;
+    while( fgets( line, LSMASH_JOB_LINE_SIZE, fp ) )
+    {
+        ++line_number;
+        size_t length   = strlen( line );
+        int    too_long = (length == LSMASH_JOB_LINE_SIZE - 1 && line[length - 1] != '\n');
+        if( too_long )
+        {
+            fprintf( stderr, "[Error] line %"PRIu32" of the job list is too long.\n", line_number );
+            /* Skip the rest of the line. */
+            int c;
+            while( (c = fgetc( fp )) != EOF && c != '\n' );
+        }
+        char *p = line;
+        while( isspace( (unsigned char)*p ) )
+            ++p;
+        if( !too_long && (*p == '\0' || *p == '#') )
+            continue;   /* blank line or comment */
+        if( list->num_jobs == alloc_jobs )
+        {
+            uint32_t n   = alloc_jobs ? alloc_jobs * 2 : 16;
+            job_t   *tmp = lsmash_realloc( list->job, n * sizeof(job_t) );
+            if( !tmp )
+                goto fail;
+            list->job  = tmp;
+            alloc_jobs = n;
+        }
+        job_t *job = &list->job[ list->num_jobs ];
+        memset( job, 0, sizeof(job_t) );
+        job->job_number  = list->num_jobs + 1;
+        job->line_number = line_number;
+        job->line        = lsmash_memdup( p, strlen( p ) + 1 );
+        if( !job->line )
+            goto fail;
+        ++ list->num_jobs;
+        if( too_long )
+        {
+            job->argc = -1;
+            continue;
+        }
+        argv[0] = program;
+        job->argc = split_job_line( job->line, argv, LSMASH_JOB_MAX_ARGS );
+        if( job->argc < 0 )
+        {
+            fprintf( stderr, "[Error] failed to parse line %"PRIu32" of the job list.\n", line_number );
+            continue;
+        }
+        argv[job->argc] = NULL;
+        job->argv = lsmash_memdup( argv, (job->argc + 1) * sizeof(char *) );
+        if( !job->argv )
+            goto fail;
+    }
+    lsmash_free( line );
+    return 0;
+fail:
+    fprintf( stderr, "[Error] failed to allocate a job.\n" );
+    lsmash_free( line );
+    return -1;
+}
+
+int lsmash_run_jobs( int argc, char **argv, lsmash_job_func_t job )
+{
+    int num_threads = 1;
+    if( argc == 5 && !strcasecmp( argv[3], "--threads" ) )
+        num_threads = atoi( argv[4] );
+    else if( argc != 3 )
+    {
+        fprintf( stderr, "[Error] usage: %s --jobs <file> [--threads <integer>]\n", argv[0] );
+        return -1;
+    }
+    if( num_threads < 1 || num_threads > LSMASH_JOB_MAX_THREADS )
+    {
+        fprintf( stderr, "[Error] the number of threads must be from 1 to %d.\n", LSMASH_JOB_MAX_THREADS );
+        return -1;
+    }
+    FILE *fp = lsmash_fopen( argv[2], "rb" );
+    if( !fp )
+    {
+        fprintf( stderr, "[Error] failed to open the job list %s.\n", argv[2] );
+        return -1;
+    }
+    double     batch_start = lsmash_get_elapsed_seconds();
+    job_list_t list        = { .func = job };
+    int        err         = read_jobs( fp, argv[0], &list );
+    fclose( fp );
+    /* Run the jobs on the worker threads, and write the results in the order of the jobs. */
+    if( err == 0 )
+        err = lsmash_run_tasks( list.num_jobs, num_threads, run_job, report_job, &list );
+    if( err == 0 )
+        printf( "{\"jobs\":%"PRIu32",\"failed\":%d,\"elapsed\":%.6f}\n",
+                list.num_jobs, list.num_failed, lsmash_get_elapsed_seconds() - batch_start );
+    for( uint32_t i = 0; i < list.num_jobs; i++ )
+    {
+        lsmash_free( list.job[i].line );
+        lsmash_free( list.job[i].argv );
+    }
+    lsmash_free( list.job );
+    return err || list.num_failed ? -1 : 0;
+}
+
+#define LSMASH_TRACE_MAX_DEPTH 16
+#define LSMASH_TRACE_WINDOW    0.1      /* in seconds */
+
+/* a node of the call tree of phases aggregated in a window */
+typedef struct trace_node_tag
+{
+    struct trace_node_tag *child[LSMASH_TRACE_PHASE_NUM];
+    double   busy;      /* the sum of the durations of the spans */
+    uint64_t count;     /* the number of the spans */
+    uint64_t bytes;
+    uint64_t samples;
+} trace_node_t;
+
+struct lsmash_trace_tag
+{
+    FILE         *fp;
+    double        origin;
+    double        window_start;
+    uint64_t      num_events;
+    int           disabled;
+    int           depth;
+    trace_node_t  tree;
+    trace_node_t *stack[LSMASH_TRACE_MAX_DEPTH + 1];    /* stack[0] is always the root of the tree. */
+    double        begin_time[LSMASH_TRACE_MAX_DEPTH];
+};
+
+static const char *trace_phase_name( lsmash_trace_phase phase )
+{
+    static const char *name[LSMASH_TRACE_PHASE_NUM] =
+        {
+            "importer analysis",
+            "read file",
+            "append sample",
+            "sample pooling",
+            "interleave",
+            "chunk write",
+            "fragment flush",
+            "finish movie",
+            "rearrange"
+        };
+    return phase < LSMASH_TRACE_PHASE_NUM ? name[phase] : "unknown";
+}
+
+/* Write the nested spans of a node one after another from 'ts', and then reset them for the next window. */
+static void trace_write_children( lsmash_trace_t *trace, trace_node_t *node, double ts )
+{
+    for( int phase = 0; phase < LSMASH_TRACE_PHASE_NUM; phase++ )
+    {
+        trace_node_t *child = node->child[phase];
+        if( !child || child->count == 0 )
+            continue;
+        fprintf( trace->fp, "%s{\"name\":\"%s\",\"cat\":\"lsmash\",\"ph\":\"X\",\"pid\":1,\"tid\":1,"
+                            "\"ts\":%.3f,\"dur\":%.3f,"
+                            "\"args\":{\"count\":%"PRIu64",\"bytes\":%"PRIu64",\"samples\":%"PRIu64"}}",
+                 trace->num_events ? ",\n" : "", trace_phase_name( (lsmash_trace_phase)phase ),
+                 (ts - trace->origin) * 1e6, child->busy * 1e6,
+                 child->count, child->bytes, child->samples );
+        ++ trace->num_events;
+        trace_write_children( trace, child, ts );
+        ts += child->busy;
+        child->busy    = 0;
+        child->count   = 0;
+        child->bytes   = 0;
+        child->samples = 0;
+    }
+}
+
+static void trace_free_children( trace_node_t *node )
+{
+    for( int phase = 0; phase < LSMASH_TRACE_PHASE_NUM; phase++ )
+        if( node->child[phase] )
+        {
+            trace_free_children( node->child[phase] );
+            lsmash_free( node->child[phase] );
+        }
+}
+
+static void trace_begin( void *opaque, lsmash_trace_phase phase )
+{
+    lsmash_trace_t *trace = (lsmash_trace_t *)opaque;
+    int depth = trace->depth++;
+    if( depth >= LSMASH_TRACE_MAX_DEPTH )
+        return;
+    trace_node_t *parent = trace->stack[depth];
+    trace_node_t *node   = NULL;
+    if( parent && phase < LSMASH_TRACE_PHASE_NUM )
+    {
+        if( !parent->child[phase] )
+            parent->child[phase] = lsmash_malloc_zero( sizeof(trace_node_t) );
+        node = parent->child[phase];
+    }
+    trace->stack[depth + 1]  = node;  /* NULL means this span is not traced. */
+    trace->begin_time[depth] = lsmash_get_elapsed_seconds();
+    if( depth == 0 && trace->window_start < 0 )
+        trace->window_start = trace->begin_time[0];
+}
+
+static void trace_end( void *opaque, lsmash_trace_phase phase, uint64_t bytes, uint64_t samples )
+{
+    lsmash_trace_t *trace = (lsmash_trace_t *)opaque;
+    if( trace->depth == 0 )
+        return;
+    int depth = --trace->depth;
+    if( depth >= LSMASH_TRACE_MAX_DEPTH )
+        return;
+    double now = lsmash_get_elapsed_seconds();
+    trace_node_t *node = trace->stack[depth + 1];
+    if( node )
+    {
+        node->busy    += now - trace->begin_time[depth];
+        node->count   += 1;
+        node->bytes   += bytes;
+        node->samples += samples;
+    }
+    if( depth == 0 && now - trace->window_start >= LSMASH_TRACE_WINDOW )
+    {
+        trace_write_children( trace, &trace->tree, trace->window_start );
+        trace->window_start = -1;
+    }
+}
+
+lsmash_trace_t *lsmash_open_trace( const char *filename )
+{
+    lsmash_trace_t *trace = lsmash_malloc_zero( sizeof(lsmash_trace_t) );
+    if( !trace )
+        return NULL;
+    trace->fp = lsmash_fopen( filename, "wb" );
+    if( !trace->fp )
+    {
+        lsmash_free( trace );
+        return NULL;
+    }
+    trace->origin       = lsmash_get_elapsed_seconds();
+    trace->window_start = -1;
+    trace->stack[0]     = &trace->tree;
+    fprintf( trace->fp, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n" );
+    return trace;
+}
+
+int lsmash_attach_trace( lsmash_trace_t *trace, lsmash_root_t *root )
+{
+    if( !trace )
+        return 0;
+    lsmash_trace_callbacks_t callbacks = { trace_begin, trace_end, trace };
+    int err = lsmash_set_trace_callbacks( root, &callbacks );
+    if( err == LSMASH_ERR_PATCH_WELCOME )
+    {
+        /* Not fatal. The trace file is left without events. */
+        if( !trace->disabled )
+            fprintf( stderr, "[Warning] tracing is disabled in this build of L-SMASH.\n" );
+        trace->disabled = 1;
+        return 0;
+    }
+    return err;
+}
+
+int lsmash_close_trace( lsmash_trace_t *trace )
+{
+    if( !trace )
+        return 0;
+    if( trace->window_start >= 0 )
+        trace_write_children( trace, &trace->tree, trace->window_start );
+    trace_free_children( &trace->tree );
+    fprintf( trace->fp, "\n]}\n" );
+    int ret = fclose( trace->fp ) == 0 ? 0 : -1;
+    lsmash_free( trace );
+    return ret;
+}
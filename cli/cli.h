@@ -41,4 +41,50 @@
 
 int lsmash_write_lsmash_indicator( lsmash_root_t *root );
 
+/* Return the seconds elapsed from an arbitrary point in the past on a monotonic clock. */
+double lsmash_get_elapsed_seconds( void );
+
+/* Thread pool
+ * lsmash_run_tasks() runs the tasks indexed from 0 to num_tasks - 1 on up to num_threads threads.
+ * A task function gets the index of the worker thread running it, from 0 to num_threads - 1, so that
+ * it can use per-worker resources such as a ROOT.  With a single thread, the tasks are run on the calling thread.
+ * 'done', if not NULL, is called with the return value of each task on the calling thread in the order of the tasks,
+ * so the results can be written out in order while the following tasks are still running.
+ * Return 0, or -1 if the pool could not be set up. */
+#define LSMASH_TASK_MAX_THREADS 256
+
+typedef int  (*lsmash_task_func_t)( void *arg, uint32_t index, int worker );
+typedef void (*lsmash_task_done_func_t)( void *arg, uint32_t index, int ret );
+
+int lsmash_run_tasks( uint32_t num_tasks, int num_threads, lsmash_task_func_t func, lsmash_task_done_func_t done, void *arg );
+
+/* Batch job mode
+ * Each line of a job list holds the options of a job as they are given on the command line.
+ * Blank lines and lines starting with '#' are ignored.
+ * Jobs are run one by one in a process, or on a pool of threads if '--threads N' follows the job list,
+ * and the status and the elapsed time of each job are written into stdout as a line of JSON in the order of the jobs.
+ * The job function must not touch any process-global state since jobs may run concurrently.
+ * lsmash_run_jobs() takes the command line beginning with '<program> --jobs <file>'. */
+#define LSMASH_JOB_LINE_SIZE   16384
+#define LSMASH_JOB_MAX_ARGS    1024
+#define LSMASH_JOB_MAX_THREADS LSMASH_TASK_MAX_THREADS
+
+typedef int (*lsmash_job_func_t)( int argc, char *argv[] );
+
+int lsmash_run_jobs( int argc, char **argv, lsmash_job_func_t job );
+
+/* Tracing
+ * The phases of the processing on ROOTs are written into a file in the Chrome trace event format,
+ * which can be loaded by chrome://tracing or Perfetto.
+ * The spans in every 100ms or so are aggregated by the nesting of the phases, and written as events
+ * laid out one after another from the start of the window, so that the events show where the time goes
+ * with a bounded number of them rather than the exact time of each span.
+ * The arguments of an event hold the number of the aggregated spans and the amount of processed bytes and samples.
+ * If no trace is given, lsmash_attach_trace() and lsmash_close_trace() do nothing. */
+typedef struct lsmash_trace_tag lsmash_trace_t;
+
+lsmash_trace_t *lsmash_open_trace( const char *filename );
+int lsmash_attach_trace( lsmash_trace_t *trace, lsmash_root_t *root );
+int lsmash_close_trace( lsmash_trace_t *trace );
+
 #endif
@@ -0,0 +1,333 @@
+/*****************************************************************************
+ * demuxer.c:
+ *****************************************************************************
+ * Copyright (C) 2015 L-SMASH project
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ * ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ *****************************************************************************/
+
+/* This file is available under an ISC license. */
+
+#include "cli.h"
+
+#include <stdio.h>
+#include <stdarg.h>
+#include <string.h>
+#include <stdlib.h>
+#include <inttypes.h>
+
+#include "exporter/exporter.h"
+
+#define MAX_NUM_OF_OUTPUTS 32
+
+typedef struct
+{
+    char    *name;
+    char    *format;
+    uint32_t track_ID;          /* 0 means the track in the same order as the output */
+} output_option_t;
+
+typedef struct
+{
+    int             help;
+    int             version;
+    char           *input;
+    char           *trace_file;
+    output_option_t output[MAX_NUM_OF_OUTPUTS];
+    uint32_t        num_of_outputs;
+} option_t;
+
+typedef struct
+{
+    option_t                 opt;
+    lsmash_root_t           *root;
+    lsmash_file_parameters_t file_param;
+    exporter_t              *exporter;
+    lsmash_summary_t        *summary;
+    lsmash_trace_t          *trace;
+} demuxer_t;
+
+static void cleanup_demuxer( demuxer_t *demuxer )
+{
+    if( !demuxer )
+        return;
+    lsmash_exporter_close( demuxer->exporter );
+    lsmash_cleanup_summary( demuxer->summary );
+    lsmash_close_file( &demuxer->file_param );
+    lsmash_destroy_root( demuxer->root );
+    lsmash_close_trace( demuxer->trace );
+    demuxer->exporter = NULL;
+    demuxer->summary  = NULL;
+    demuxer->root     = NULL;
+    demuxer->trace    = NULL;
+}
+
+#define eprintf( ... ) fprintf( stderr, __VA_ARGS__ )
+#define REFRESH_CONSOLE eprintf( "                                                                               \r" )
+
+static int demuxer_error( demuxer_t *demuxer, const char *message, ... )
+{
+    cleanup_demuxer( demuxer );
+    REFRESH_CONSOLE;
+    eprintf( "Error: " );
+    va_list args;
+    va_start( args, message );
+    vfprintf( stderr, message, args );
+    va_end( args );
+    return -1;
+}
+
+static int error_message( const char *message, ... )
+{
+    REFRESH_CONSOLE;
+    eprintf( "Error: " );
+    va_list args;
+    va_start( args, message );
+    vfprintf( stderr, message, args );
+    va_end( args );
+    return -1;
+}
+
+#define ERROR_MSG( ... ) error_message( __VA_ARGS__ )
+
+static void display_version( void )
+{
+    eprintf( "\n"
+             "L-SMASH isom/mov demultiplexer rev%s  %s\n"
+             "Built on %s %s\n"
+             "Copyright (C) 2015 L-SMASH project\n",
+             LSMASH_REV, LSMASH_GIT_HASH, __DATE__, __TIME__ );
+}
+
+static void display_help( void )
+{
+    display_version();
+    eprintf( "\n"
+             "Usage: demuxer [global options] -i input -o output [track options] [-o output [track options] ...]\n"
+             "       demuxer --jobs <string> [--threads <integer>]\n"
+             "  The samples of a track are written out as an elementary stream.\n"
+             "  Unless --track is specified, the N-th output takes the N-th track of the input.\n"
+             "  \"-\" as an output means the standard output.\n"
+             "Global options:\n"
+             "    --help                    Display help\n"
+             "    --version                 Display version information\n"
+             "    --jobs <string>           Run the jobs listed in the file\n"
+             "                              Each line holds the options of a job\n"
+             "                              With --threads, the jobs run concurrently\n"
+             "                              A line of NDJSON per job with its status, exit code\n"
+             "                              and elapsed time, and a summary line of the batch\n"
+             "                              are written into stdout in the order of the jobs\n"
+             "    --threads <integer>       Run up to the given number of jobs at the same time [1]\n"
+             "    --trace <string>          Write the timing of the processing phases into the file\n"
+             "                              in the Chrome trace event format\n"
+             "Track options:\n"
+             "    --track <integer>         Specify the track_ID of the track to be exported\n"
+             "    --format <string>         Specify the format of the output [auto]\n"
+             "                                - auto\n"
+             "                                - H.264 (Annex B byte stream)\n"
+             "                                - HEVC (Annex B byte stream)\n"
+             "                                - adts\n"
+             "                                - AC-3\n"
+             "                                - Enhanced AC-3\n"
+             "                                - DTS Coherent Acoustics\n"
+             "                                - WAVE (LPCM only)\n" );
+}
+
+static int parse_options( int argc, char *argv[], option_t *opt )
+{
+    if( argc < 2 )
+        return -1;
+    else if( !strcasecmp( argv[1], "-h" ) || !strcasecmp( argv[1], "--help" ) )
+    {
+        opt->help = 1;
+        return 0;
+    }
+    else if( !strcasecmp( argv[1], "-v" ) || !strcasecmp( argv[1], "--version" ) )
+    {
+        opt->version = 1;
+        return 0;
+    }
+    output_option_t *output = NULL;
+    for( int i = 1; i < argc; i++ )
+    {
+#define CHECK_NEXT_ARG if( ++i == argc ) return ERROR_MSG( "%s requires argument.\n", argv[i - 1] );
+        if( !strcasecmp( argv[i], "-i" ) || !strcasecmp( argv[i], "--input" ) )
+        {
+            CHECK_NEXT_ARG;
+            if( opt->input )
+                return ERROR_MSG( "you specified an input twice.\n" );
+            opt->input = argv[i];
+        }
+        else if( !strcasecmp( argv[i], "-o" ) || !strcasecmp( argv[i], "--output" ) )
+        {
+            CHECK_NEXT_ARG;
+            if( opt->num_of_outputs >= MAX_NUM_OF_OUTPUTS )
+                return ERROR_MSG( "exceed the maximum number of outputs.\n" );
+            output = &opt->output[ opt->num_of_outputs++ ];
+            output->name = argv[i];
+        }
+        else if( !strcasecmp( argv[i], "--track" ) )
+        {
+            CHECK_NEXT_ARG;
+            if( !output )
+                return ERROR_MSG( "--track is a track option and shall follow an output.\n" );
+            char *end;
+            unsigned long track_ID = strtoul( argv[i], &end, 10 );
+            if( *end || track_ID == 0 || track_ID > UINT32_MAX )
+                return ERROR_MSG( "invalid track_ID: %s.\n", argv[i] );
+            output->track_ID = track_ID;
+        }
+        else if( !strcasecmp( argv[i], "--format" ) )
+        {
+            CHECK_NEXT_ARG;
+            if( !output )
+                return ERROR_MSG( "--format is a track option and shall follow an output.\n" );
+            output->format = argv[i];
+        }
+        else if( !strcasecmp( argv[i], "--trace" ) )
+        {
+            CHECK_NEXT_ARG;
+            opt->trace_file = argv[i];
+        }
+        else
+            return ERROR_MSG( "you specified invalid option: %s.\n", argv[i] );
+#undef CHECK_NEXT_ARG
+    }
+    if( !opt->input )
+        return ERROR_MSG( "input file name is not specified.\n" );
+    if( opt->num_of_outputs == 0 )
+        return ERROR_MSG( "output file name is not specified.\n" );
+    return 0;
+}
+
+static int open_input( demuxer_t *demuxer )
+{
+    char *name = demuxer->opt.input;
+    if( !strcmp( name, "-" ) )
+        return ERROR_MSG( "Standard input not supported.\n" );
+    demuxer->root = lsmash_create_root();
+    if( !demuxer->root )
+        return ERROR_MSG( "failed to create a ROOT for an input file.\n" );
+    if( demuxer->trace && lsmash_attach_trace( demuxer->trace, demuxer->root ) < 0 )
+        return ERROR_MSG( "failed to attach the trace to input file.\n" );
+    if( lsmash_open_file( name, 1, &demuxer->file_param ) < 0 )
+        return ERROR_MSG( "failed to open an input file.\n" );
+    lsmash_file_t *fh = lsmash_set_file( demuxer->root, &demuxer->file_param );
+    if( !fh )
+        return ERROR_MSG( "failed to add an input file into a ROOT.\n" );
+    if( lsmash_read_file( fh, &demuxer->file_param ) < 0 )
+        return ERROR_MSG( "failed to read an input file\n" );
+    return 0;
+}
+
+static int export_track( demuxer_t *demuxer, output_option_t *output, uint32_t output_number )
+{
+    lsmash_root_t *root     = demuxer->root;
+    uint32_t       track_ID = output->track_ID;
+    if( track_ID == 0 )
+    {
+        lsmash_movie_parameters_t movie_param;
+        lsmash_initialize_movie_parameters( &movie_param );
+        if( lsmash_get_movie_parameters( root, &movie_param ) )
+            return ERROR_MSG( "failed to get movie parameters.\n" );
+        if( output_number > movie_param.number_of_tracks )
+            return ERROR_MSG( "the input has no track for %s.\n", output->name );
+        track_ID = lsmash_get_track_ID( root, output_number );
+    }
+    if( lsmash_construct_timeline( root, track_ID ) )
+        return ERROR_MSG( "failed to construct the timeline of track %"PRIu32".\n", track_ID );
+    uint32_t sample_count = lsmash_get_sample_count_in_media_timeline( root, track_ID );
+    demuxer->exporter = lsmash_exporter_open( output->name, output->format );
+    if( !demuxer->exporter )
+        return ERROR_MSG( "failed to open %s.\n", output->name );
+    uint32_t description_index = 0;
+    for( uint32_t sample_number = 1; sample_number <= sample_count; sample_number++ )
+    {
+        lsmash_sample_t *sample = lsmash_get_sample_from_media_timeline( root, track_ID, sample_number );
+        if( !sample )
+            return ERROR_MSG( "failed to get sample %"PRIu32" of track %"PRIu32".\n", sample_number, track_ID );
+        if( sample->index != description_index )
+        {
+            /* The first sample or the sample description changed. */
+            lsmash_cleanup_summary( demuxer->summary );
+            demuxer->summary = lsmash_get_summary( root, track_ID, sample->index );
+            if( !demuxer->summary
+             || lsmash_exporter_set_summary( demuxer->exporter, demuxer->summary ) < 0 )
+            {
+                lsmash_delete_sample( sample );
+                return ERROR_MSG( "failed to set up the exporter for track %"PRIu32".\n", track_ID );
+            }
+            description_index = sample->index;
+        }
+        int err = lsmash_exporter_write_sample( demuxer->exporter, sample );
+        lsmash_delete_sample( sample );
+        if( err < 0 )
+            return ERROR_MSG( "failed to write sample %"PRIu32" of track %"PRIu32".\n", sample_number, track_ID );
+        /* Print, per 256 samples, the progress. */
+        if( (sample_number & 0xff) == 0 )
+        {
+            REFRESH_CONSOLE;
+            eprintf( "Exporting track %"PRIu32": %"PRIu32"/%"PRIu32" samples\r", track_ID, sample_number, sample_count );
+        }
+    }
+    if( lsmash_exporter_finish( demuxer->exporter ) < 0 )
+        return ERROR_MSG( "failed to finish %s.\n", output->name );
+    REFRESH_CONSOLE;
+    eprintf( "Track %"PRIu32" -> %s [%s]: %"PRIu32" samples\n",
+             track_ID, output->name, lsmash_exporter_get_name( demuxer->exporter ), sample_count );
+    lsmash_exporter_close( demuxer->exporter );
+    lsmash_cleanup_summary( demuxer->summary );
+    lsmash_destruct_timeline( root, track_ID );
+    demuxer->exporter = NULL;
+    demuxer->summary  = NULL;
+    return 0;
+}
+
+static int demux( int argc, char *argv[] )
+{
+    demuxer_t demuxer = { { 0 } };
+    if( parse_options( argc, argv, &demuxer.opt ) )
+    {
+        display_help();
+        return -1;
+    }
+    if( demuxer.opt.help )
+    {
+        display_help();
+        return 0;
+    }
+    else if( demuxer.opt.version )
+    {
+        display_version();
+        return 0;
+    }
+    if( demuxer.opt.trace_file && !(demuxer.trace = lsmash_open_trace( demuxer.opt.trace_file )) )
+        return demuxer_error( &demuxer, "failed to open the trace file.\n" );
+    if( open_input( &demuxer ) )
+        return demuxer_error( &demuxer, "failed to open the input file.\n" );
+    for( uint32_t i = 0; i < demuxer.opt.num_of_outputs; i++ )
+        if( export_track( &demuxer, &demuxer.opt.output[i], i + 1 ) )
+            return demuxer_error( &demuxer, "failed to export a track.\n" );
+    REFRESH_CONSOLE;
+    eprintf( "Demuxing completed!\n" );
+    cleanup_demuxer( &demuxer );
+    return 0;
+}
+
+int main( int argc, char *argv[] )
+{
+    lsmash_get_mainargs( &argc, &argv );
+    if( argc >= 3 && !strcasecmp( argv[1], "--jobs" ) )
+        return lsmash_run_jobs( argc, argv, demux );
+    return demux( argc, argv );
+}
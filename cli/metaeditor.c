@@ -0,0 +1,354 @@
+/*****************************************************************************
+ * metaeditor.c:
+ *****************************************************************************
+ * Copyright (C) 2015 L-SMASH project
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ * ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ *****************************************************************************/
+
+/* This file is available under an ISC license. */
+
+#include "cli.h"
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdarg.h>
+
+#define eprintf( ... ) fprintf( stderr, __VA_ARGS__ )
+
+static const struct
+{
+    const char                 *option;
+    lsmash_itunes_metadata_item item;
+    lsmash_itunes_metadata_type type;
+} itunes_metadata_options[] =
+    {
+        { "--album-name",   ITUNES_METADATA_ITEM_ALBUM_NAME,       ITUNES_METADATA_TYPE_STRING  },
+        { "--artist",       ITUNES_METADATA_ITEM_ARTIST,           ITUNES_METADATA_TYPE_STRING  },
+        { "--comment",      ITUNES_METADATA_ITEM_USER_COMMENT,     ITUNES_METADATA_TYPE_STRING  },
+        { "--release-date", ITUNES_METADATA_ITEM_RELEASE_DATE,     ITUNES_METADATA_TYPE_STRING  },
+        { "--encoder",      ITUNES_METADATA_ITEM_ENCODED_BY,       ITUNES_METADATA_TYPE_STRING  },
+        { "--genre",        ITUNES_METADATA_ITEM_USER_GENRE,       ITUNES_METADATA_TYPE_STRING  },
+        { "--lyrics",       ITUNES_METADATA_ITEM_LYRICS,           ITUNES_METADATA_TYPE_STRING  },
+        { "--title",        ITUNES_METADATA_ITEM_TITLE,            ITUNES_METADATA_TYPE_STRING  },
+        { "--composer",     ITUNES_METADATA_ITEM_COMPOSER,         ITUNES_METADATA_TYPE_STRING  },
+        { "--album-artist", ITUNES_METADATA_ITEM_ALBUM_ARTIST,     ITUNES_METADATA_TYPE_STRING  },
+        { "--copyright",    ITUNES_METADATA_ITEM_COPYRIGHT,        ITUNES_METADATA_TYPE_STRING  },
+        { "--description",  ITUNES_METADATA_ITEM_DESCRIPTION,      ITUNES_METADATA_TYPE_STRING  },
+        { "--grouping",     ITUNES_METADATA_ITEM_GROUPING,         ITUNES_METADATA_TYPE_STRING  },
+        { "--tempo",        ITUNES_METADATA_ITEM_BEATS_PER_MINUTE, ITUNES_METADATA_TYPE_INTEGER },
+        { NULL,             0,                                     ITUNES_METADATA_TYPE_NONE    }
+    };
+
+#define NUM_ITUNES_METADATA_OPTIONS (sizeof(itunes_metadata_options) / sizeof(itunes_metadata_options[0]) - 1)
+
+typedef struct
+{
+    char    *itunes_metadata[NUM_ITUNES_METADATA_OPTIONS];
+    int      set_itunes_metadata;
+    int      delete_itunes_metadata;
+    char    *chap_file;
+    int      add_bom_to_chpl;
+    int      delete_chapter;
+    char    *copyright_notice;
+    uint16_t copyright_language;
+    int      delete_copyright;
+} option_t;
+
+typedef struct
+{
+    lsmash_root_t           *root;
+    lsmash_file_parameters_t param;
+} input_t;
+
+static int error_message( const char* message, ... )
+{
+    eprintf( "Error: " );
+    va_list args;
+    va_start( args, message );
+    vfprintf( stderr, message, args );
+    va_end( args );
+    return -1;
+}
+
+#define ERROR_MSG( ... ) error_message( __VA_ARGS__ )
+
+static void display_version( void )
+{
+    eprintf( "\n"
+             "L-SMASH isom/mov metadata editor rev%s  %s\n"
+             "Built on %s %s\n"
+             "Copyright (C) 2015 L-SMASH project\n",
+             LSMASH_REV, LSMASH_GIT_HASH, __DATE__, __TIME__ );
+}
+
+static void display_help( void )
+{
+    display_version();
+    eprintf( "\n"
+             "Usage: metaeditor [options] input\n"
+             "       metaeditor --jobs <file> [--threads <integer>]\n"
+             "  The movie header of the input file is rewritten in place. Media data is neither copied nor moved.\n"
+             "  options:\n"
+             "    --help                    Display help\n"
+             "    --version                 Display version information\n"
+             "    --jobs <file>             Run the jobs listed in the file\n"
+             "                              Each line holds the options of a job\n"
+             "                              With --threads, the jobs run concurrently\n"
+             "                              A line of NDJSON per job with its status, exit code\n"
+             "                              and elapsed time, and a summary line of the batch\n"
+             "                              are written into stdout in the order of the jobs\n"
+             "    --threads <integer>       Run up to the given number of jobs at the same time [1]\n"
+             "    --chapter <string>        Replace the chapter list with chapters from the file\n"
+             "    --chpl-with-bom           Add UTF-8 BOM to the chapter strings\n"
+             "                              in the chapter list. (experimental)\n"
+             "    --delete-chapter          Delete the chapter list\n"
+             "    --copyright-notice <arg>  Replace copyright notices with one with or without language (latter string)\n"
+             "    --delete-copyright        Delete copyright notices\n"
+             "    --delete-itunes-metadata  Delete all iTunes metadata before setting the given ones\n"
+             "iTunes Metadata: (replace existing ones of the same kind)\n"
+             "    --album-name <string>     Album name\n"
+             "    --artist <string>         Artist\n"
+             "    --comment <string>        User comment\n"
+             "    --release-date <string>   Release date (YYYY-MM-DD)\n"
+             "    --encoder <string>        Person or company that encoded the recording\n"
+             "    --genre <string>          Genre\n"
+             "    --lyrics <string>         Lyrics\n"
+             "    --title <string>          Title or song name\n"
+             "    --composer <string>       Composer\n"
+             "    --album-artist <string>   Artist for the whole album (if different than the individual tracks)\n"
+             "    --copyright <string>      Copyright\n"
+             "    --description <string>    Description\n"
+             "    --grouping <string>       Grouping\n"
+             "    --tempo <integer>         Beats per minute\n" );
+}
+
+static int parse_options( int argc, char *argv[], option_t *opt )
+{
+    int i = 1;
+    for( ; i < argc - 1; i++ )
+    {
+#define CHECK_NEXT_ARG if( ++i == argc - 1 ) return ERROR_MSG( "%s requires argument.\n", argv[i - 1] );
+        if( !strcasecmp( argv[i], "--chapter" ) )
+        {
+            CHECK_NEXT_ARG;
+            opt->chap_file = argv[i];
+        }
+        else if( !strcasecmp( argv[i], "--chpl-with-bom" ) )
+            opt->add_bom_to_chpl = 1;
+        else if( !strcasecmp( argv[i], "--delete-chapter" ) )
+            opt->delete_chapter = 1;
+        else if( !strcasecmp( argv[i], "--copyright-notice" ) )
+        {
+            CHECK_NEXT_ARG;
+            if( opt->copyright_notice )
+                return ERROR_MSG( "you specified --copyright-notice twice.\n" );
+            opt->copyright_notice = argv[i];
+            char *language = opt->copyright_notice;
+            while( *language )
+            {
+                if( *language == '/' )
+                {
+                    *language++ = '\0';
+                    break;
+                }
+                ++language;
+            }
+            opt->copyright_language = *language ? lsmash_pack_iso_language( language ) : ISOM_LANGUAGE_CODE_UNDEFINED;
+        }
+        else if( !strcasecmp( argv[i], "--delete-copyright" ) )
+            opt->delete_copyright = 1;
+        else if( !strcasecmp( argv[i], "--delete-itunes-metadata" ) )
+            opt->delete_itunes_metadata = 1;
+        else
+        {
+            int j = 0;
+            while( itunes_metadata_options[j].option && strcasecmp( argv[i], itunes_metadata_options[j].option ) )
+                ++j;
+            if( !itunes_metadata_options[j].option )
+                return ERROR_MSG( "you specified invalid option: %s.\n", argv[i] );
+            CHECK_NEXT_ARG;
+            if( opt->itunes_metadata[j] )
+                return ERROR_MSG( "you specified %s twice.\n", argv[i - 1] );
+            opt->itunes_metadata[j]     = argv[i];
+            opt->set_itunes_metadata    = 1;
+        }
+#undef CHECK_NEXT_ARG
+    }
+    if( i != argc - 1 )
+        return ERROR_MSG( "input file name is not specified.\n" );
+    if( opt->chap_file && opt->delete_chapter )
+        return ERROR_MSG( "--chapter and --delete-chapter are exclusive.\n" );
+    if( opt->copyright_notice && opt->delete_copyright )
+        return ERROR_MSG( "--copyright-notice and --delete-copyright are exclusive.\n" );
+    return 0;
+}
+
+static int open_input( input_t *input, char *name )
+{
+    if( !strcmp( name, "-" ) )
+        return ERROR_MSG( "Standard input not supported.\n" );
+    input->root = lsmash_create_root();
+    if( !input->root )
+        return ERROR_MSG( "failed to create a ROOT for an input file.\n" );
+    if( lsmash_open_file( name, 2, &input->param ) < 0 )
+        return ERROR_MSG( "failed to open an input file.\n" );
+    lsmash_file_t *fh = lsmash_set_file( input->root, &input->param );
+    if( !fh )
+        return ERROR_MSG( "failed to add an input file into a ROOT.\n" );
+    if( lsmash_read_file( fh, &input->param ) < 0 )
+        return ERROR_MSG( "failed to read an input file\n" );
+    return 0;
+}
+
+static void cleanup_input( input_t *input )
+{
+    lsmash_close_file( &input->param );
+    lsmash_destroy_root( input->root );
+    input->root = NULL;
+}
+
+static int is_overridden_itunes_metadata( option_t *opt, lsmash_itunes_metadata_t *metadata )
+{
+    if( opt->delete_itunes_metadata )
+        return 1;
+    for( int i = 0; itunes_metadata_options[i].option; i++ )
+        if( opt->itunes_metadata[i] && metadata->item == itunes_metadata_options[i].item )
+            return 1;
+    return 0;
+}
+
+static int update_itunes_metadata( lsmash_root_t *root, option_t *opt )
+{
+    if( !opt->set_itunes_metadata && !opt->delete_itunes_metadata )
+        return 0;
+    /* Keep the metadata not overridden by the given ones and set them again after deleting all. */
+    uint32_t num_metadata = lsmash_count_itunes_metadata( root );
+    lsmash_itunes_metadata_t *kept = NULL;
+    uint32_t num_kept = 0;
+    if( num_metadata )
+    {
+        kept = lsmash_malloc_zero( num_metadata * sizeof(lsmash_itunes_metadata_t) );
+        if( !kept )
+            return ERROR_MSG( "failed to alloc iTunes metadata.\n" );
+        for( uint32_t i = 1; i <= num_metadata; i++ )
+        {
+            lsmash_itunes_metadata_t *metadata = &kept[num_kept];
+            if( lsmash_get_itunes_metadata( root, i, metadata ) )
+            {
+                ERROR_MSG( "failed to get an iTunes metadata.\n" );
+                goto fail;
+            }
+            if( is_overridden_itunes_metadata( opt, metadata ) )
+                lsmash_cleanup_itunes_metadata( metadata );
+            else
+                ++num_kept;
+        }
+    }
+    lsmash_delete_itunes_metadata( root );
+    for( uint32_t i = 0; i < num_kept; i++ )
+        if( lsmash_set_itunes_metadata( root, kept[i] ) )
+        {
+            ERROR_MSG( "failed to set an iTunes metadata.\n" );
+            goto fail;
+        }
+    for( int i = 0; itunes_metadata_options[i].option; i++ )
+    {
+        if( !opt->itunes_metadata[i] )
+            continue;
+        lsmash_itunes_metadata_t metadata = { itunes_metadata_options[i].item, ITUNES_METADATA_TYPE_NONE, { .string = NULL }, NULL, NULL };
+        if( itunes_metadata_options[i].type == ITUNES_METADATA_TYPE_INTEGER )
+            metadata.value.integer = atoi( opt->itunes_metadata[i] );
+        else
+            metadata.value.string  = opt->itunes_metadata[i];
+        if( lsmash_set_itunes_metadata( root, metadata ) )
+        {
+            ERROR_MSG( "failed to set an iTunes metadata.\n" );
+            goto fail;
+        }
+    }
+    for( uint32_t i = 0; i < num_kept; i++ )
+        lsmash_cleanup_itunes_metadata( &kept[i] );
+    lsmash_free( kept );
+    return 0;
+fail:
+    for( uint32_t i = 0; i < num_metadata; i++ )
+        lsmash_cleanup_itunes_metadata( &kept[i] );
+    lsmash_free( kept );
+    return -1;
+}
+
+static int edit_metadata( int argc, char *argv[] )
+{
+    if( argc < 2 )
+    {
+        display_help();
+        return -1;
+    }
+    else if( !strcasecmp( argv[1], "-h" ) || !strcasecmp( argv[1], "--help" ) )
+    {
+        display_help();
+        return 0;
+    }
+    else if( !strcasecmp( argv[1], "-v" ) || !strcasecmp( argv[1], "--version" ) )
+    {
+        display_version();
+        return 0;
+    }
+    option_t opt = { { 0 } };
+    if( parse_options( argc, argv, &opt ) )
+    {
+        display_help();
+        return -1;
+    }
+    input_t input = { 0 };
+    if( open_input( &input, argv[argc - 1] ) )
+        goto fail;
+    if( update_itunes_metadata( input.root, &opt ) )
+        goto fail;
+    if( opt.delete_copyright || opt.copyright_notice )
+        lsmash_delete_copyright( input.root, 0 );
+    if( opt.copyright_notice
+     && lsmash_set_copyright( input.root, 0, opt.copyright_language, opt.copyright_notice ) )
+    {
+        ERROR_MSG( "failed to set a copyright notice.\n" );
+        goto fail;
+    }
+    if( opt.delete_chapter || opt.chap_file )
+        lsmash_delete_tyrant_chapter( input.root );
+    if( opt.chap_file
+     && lsmash_set_tyrant_chapter( input.root, opt.chap_file, opt.add_bom_to_chpl ) )
+    {
+        ERROR_MSG( "failed to set a chapter list.\n" );
+        goto fail;
+    }
+    if( lsmash_write_movie_in_place( input.root ) )
+    {
+        ERROR_MSG( "failed to write the movie in place.\n" );
+        goto fail;
+    }
+    cleanup_input( &input );
+    return 0;
+fail:
+    cleanup_input( &input );
+    return -1;
+}
+
+int main( int argc, char *argv[] )
+{
+    lsmash_get_mainargs( &argc, &argv );
+    if( argc >= 3 && !strcasecmp( argv[1], "--jobs" ) )
+        return lsmash_run_jobs( argc, argv, edit_metadata );
+    return edit_metadata( argc, argv );
+}
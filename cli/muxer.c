@@ -77,6 +77,8 @@ typedef struct
     uint16_t copyright_language;
     itunes_metadata_t itunes_metadata;
     uint16_t default_language;
+    uint32_t moov_padding;
+    char    *trace_file;
 } option_t;
 
 typedef struct
@@ -113,6 +115,8 @@ typedef struct
 {
     input_option_t     opt;
     char              *file_name;
+    lsmash_root_t     *root;
+    lsmash_file_parameters_t file_param;
     importer_t        *importer;
     input_track_t      track[MAX_NUM_OF_TRACKS];
     uint32_t           num_of_tracks;
@@ -166,6 +170,7 @@ typedef struct
     output_t output;
     input_t  input[MAX_NUM_OF_INPUTS];
     uint32_t num_of_inputs;
+    lsmash_trace_t *trace;
 } muxer_t;
 
 static void cleanup_muxer( muxer_t *muxer )
@@ -187,10 +192,13 @@ static void cleanup_muxer( muxer_t *muxer )
     for( uint32_t i = 0; i < muxer->num_of_inputs; i++ )
     {
         input_t *input = &muxer->input[i];
-        lsmash_importer_close( input->importer );
+        lsmash_close_file( &input->file_param );
+        lsmash_importer_destroy( input->importer );
+        lsmash_destroy_root( input->root );
         for( uint32_t j = 0; j < input->num_of_tracks; j++ )
             lsmash_cleanup_summary( input->track[j].summary );
     }
+    lsmash_close_trace( muxer->trace );
 }
 
 #define eprintf( ... ) fprintf( stderr, __VA_ARGS__ )
@@ -233,6 +241,15 @@ static void display_help( void )
     display_version();
     eprintf( "\n"
              "Usage: muxer [global_options] -i input1 [-i input2 -i input3 ...] -o output\n"
+             "       muxer --jobs <string> [--threads <integer>]\n"
+             "Batch job mode:\n"
+             "    --jobs <string>           Run the jobs listed in the file\n"
+             "                              Each line holds the options of a job\n"
+             "                              With --threads, the jobs run concurrently\n"
+             "                              A line of NDJSON per job with its status, exit code\n"
+             "                              and elapsed time, and a summary line of the batch\n"
+             "                              are written into stdout in the order of the jobs\n"
+             "    --threads <integer>       Run up to the given number of jobs at the same time [1]\n"
              "Global options:\n"
              "    --help                    Display help\n"
              "    --version                 Display version information\n"
@@ -254,6 +271,10 @@ static void display_help( void )
              "                                  <arg> is <string> or <string>/<string>\n"
              "    --language <string>       Specify the default language for all the output tracks.\n"
              "                              This option is overridden by the track options.\n"
+             "    --moov-padding <integer>  Reserve padding in bytes at the end of the movie header\n"
+             "                              The padding lets metaeditor update the metadata in place\n"
+             "    --trace <string>          Write the timing of the processing phases into the file\n"
+             "                              in the Chrome trace event format\n"
              "Output file formats:\n"
              "    mp4, mov, 3gp, 3g2, m4a, m4v\n"
              "\n"
@@ -440,17 +461,18 @@ static int parse_global_options( int argc, char **argv, muxer_t *muxer )
                 input_movie_opt->num_of_track_delimiters += (*p++ == '?');
             if( input_movie_opt->num_of_track_delimiters > MAX_NUM_OF_TRACKS )
                 return ERROR_MSG( "you specified options to exceed the maximum number of tracks per input files.\n" );
-            input->file_name = strtok( argv[i], "?" );
-            input_movie_opt->whole_track_option = strtok( NULL, "" );
+            char *saveptr;
+            input->file_name = lsmash_strtok_r( argv[i], "?", &saveptr );
+            input_movie_opt->whole_track_option = lsmash_strtok_r( NULL, "", &saveptr );
             if( input_movie_opt->num_of_track_delimiters )
             {
                 input_track_option_t *track_opt = &input->track[0].opt;
-                track_opt->raws = strtok( input_movie_opt->whole_track_option, "?" );
+                track_opt->raws = lsmash_strtok_r( input_movie_opt->whole_track_option, "?", &saveptr );
 #if (MAX_NUM_OF_TRACKS - 1)
                 for( uint32_t j = 1; j < input_movie_opt->num_of_track_delimiters; j++ )
                 {
                     track_opt = &input->track[j].opt;
-                    track_opt->raws = strtok( NULL, "?" );
+                    track_opt->raws = lsmash_strtok_r( NULL, "?", &saveptr );
                 }
 #endif
             }
@@ -488,7 +510,8 @@ static int parse_global_options( int argc, char **argv, muxer_t *muxer )
                     { 0, NULL }
                   };
             char *file_format = NULL;
-            while( (file_format = strtok( file_format ? NULL : argv[i], "," )) != NULL )
+            char *saveptr;
+            while( (file_format = lsmash_strtok_r( file_format ? NULL : argv[i], ",", &saveptr )) != NULL )
             {
                 int j;
                 for( j = 0; file_format_list[j].file_format; j++ )
@@ -581,6 +604,18 @@ static int parse_global_options( int argc, char **argv, muxer_t *muxer )
             CHECK_NEXT_ARG;
             opt->default_language = lsmash_pack_iso_language( argv[i] );
         }
+        else if( !strcasecmp( argv[i], "--moov-padding" ) )
+        {
+            CHECK_NEXT_ARG;
+            opt->moov_padding = atoi( argv[i] );
+            if( opt->moov_padding < 8 )
+                return ERROR_MSG( "--moov-padding requires 8 or more bytes.\n" );
+        }
+        else if( !strcasecmp( argv[i], "--trace" ) )
+        {
+            CHECK_NEXT_ARG;
+            opt->trace_file = argv[i];
+        }
 #undef CHECK_NEXT_ARG
         else
             return ERROR_MSG( "you specified invalid option: %s.\n", argv[i] );
@@ -621,7 +656,8 @@ static int parse_track_options( input_t *input )
         while( (track_option = strtok( NULL, "," )) != NULL )
 #else
         char *track_option = NULL;
-        while( (track_option = strtok( track_option ? NULL : track_opt->raws, "," )) != NULL )
+        char *saveptr;
+        while( (track_option = lsmash_strtok_r( track_option ? NULL : track_opt->raws, ",", &saveptr )) != NULL )
 #endif
         {
             if( strchr( track_option, '=' ) != strrchr( track_option, '=' ) )
@@ -712,10 +748,22 @@ static int open_input_files( muxer_t *muxer )
     for( uint32_t current_input_number = 1; current_input_number <= muxer->num_of_inputs; current_input_number++ )
     {
         input_t *input = &muxer->input[current_input_number - 1];
-        /* Initialize importer framework. */
-        input->importer = lsmash_importer_open( input->file_name, "auto" );
-        if( !input->importer )
+        /* Initialize importer framework.
+         * The input file is opened on a ROOT of our own so that the importer reports its analysis to the trace. */
+        input->root = lsmash_create_root();
+        if( !input->root )
+            return ERROR_MSG( "failed to create a ROOT for input file.\n" );
+        if( muxer->trace && lsmash_attach_trace( muxer->trace, input->root ) < 0 )
+            return ERROR_MSG( "failed to attach the trace to input file.\n" );
+        if( lsmash_open_file( input->file_name, 1, &input->file_param ) < 0 )
             return ERROR_MSG( "failed to open input file.\n" );
+        lsmash_file_t *file = lsmash_set_file( input->root, &input->file_param );
+        input->importer = lsmash_importer_alloc();
+        if( !file
+         || !input->importer
+         || lsmash_importer_set_file( input->importer, file ) < 0
+         || lsmash_importer_find( input->importer, "auto", 1 ) < 0 )
+            return ERROR_MSG( "failed to find the importer for input file.\n" );
         input->num_of_tracks = lsmash_importer_get_track_count( input->importer );
         if( input->num_of_tracks == 0 )
             return ERROR_MSG( "there is no valid track in input file.\n" );
@@ -850,6 +898,8 @@ static int prepare_output( muxer_t *muxer )
     output->root = lsmash_create_root();
     if( !output->root )
         return ERROR_MSG( "failed to create a ROOT.\n" );
+    if( muxer->trace && lsmash_attach_trace( muxer->trace, output->root ) < 0 )
+        return ERROR_MSG( "failed to attach the trace to output file.\n" );
     lsmash_file_parameters_t *file_param = &out_file->param;
     if( lsmash_open_file( out_file->name, 0, file_param ) < 0 )
         return ERROR_MSG( "failed to open an output file.\n" );
@@ -1190,6 +1240,10 @@ static int finish_movie( output_t *output, option_t *opt )
     /* Set chapter list. */
     if( opt->chap_file )
         lsmash_set_tyrant_chapter( output->root, opt->chap_file, opt->add_bom_to_chpl );
+    /* Reserve padding for later in-place editing. */
+    if( opt->moov_padding
+     && lsmash_reserve_movie_padding( output->root, opt->moov_padding ) )
+        return -1;
     /* Close movie. */
     REFRESH_CONSOLE;
     if( opt->optimize_pd )
@@ -1205,10 +1259,9 @@ static int finish_movie( output_t *output, option_t *opt )
     return lsmash_write_lsmash_indicator( output->root );
 }
 
-int main( int argc, char *argv[] )
+static int mux( int argc, char *argv[] )
 {
     muxer_t muxer = { { 0 } };
-    lsmash_get_mainargs( &argc, &argv );
     if( parse_global_options( argc, argv, &muxer ) )
         return MUXER_USAGE_ERR();
     if( muxer.opt.help )
@@ -1223,6 +1276,8 @@ int main( int argc, char *argv[] )
         cleanup_muxer( &muxer );
         return 0;
     }
+    if( muxer.opt.trace_file && !(muxer.trace = lsmash_open_trace( muxer.opt.trace_file )) )
+        return MUXER_ERR( "failed to open the trace file.\n" );
     if( open_input_files( &muxer ) )
         return MUXER_ERR( "failed to open input files.\n" );
     if( prepare_output( &muxer ) )
@@ -1236,3 +1291,11 @@ int main( int argc, char *argv[] )
     cleanup_muxer( &muxer );        /* including lsmash_destroy_root() */
     return 0;
 }
+
+int main( int argc, char *argv[] )
+{
+    lsmash_get_mainargs( &argc, &argv );
+    if( argc >= 3 && !strcasecmp( argv[1], "--jobs" ) )
+        return lsmash_run_jobs( argc, argv, mux );
+    return mux( argc, argv );
+}
@@ -36,6 +36,7 @@ typedef struct
     uint32_t                 *summary_remap;
     uint64_t                  skip_dt_interval;
     uint64_t                  last_sample_dts;
+    struct input_track_tag  **concat_tracks;    /* input tracks joined into this track in order */
     lsmash_track_parameters_t track_param;
     lsmash_media_parameters_t media_param;
 } output_track_t;
@@ -60,9 +61,10 @@ typedef struct
 
 typedef struct
 {
-    lsmash_root_t *root;
-    output_file_t  file;
-    uint32_t       current_seg_number;
+    lsmash_root_t       *root;
+    output_file_t        file;
+    uint32_t             current_seg_number;
+    lsmash_adhoc_remux_t moov_to_front;     /* per output since the library updates the buffer size */
 } output_t;
 
 typedef struct
@@ -85,12 +87,27 @@ typedef struct
 } input_media_t;
 
 typedef struct
+{
+    lsmash_sample_t **samples;      /* ring buffer of samples read ahead */
+    uint32_t          head;
+    uint32_t          count;
+    uint32_t          alloc;
+} sample_queue_t;
+
+typedef struct input_track_tag
 {
     int                       active;
     lsmash_sample_t          *sample;
+    sample_queue_t            queue;
+    uint32_t                  next_read_sample_number;  /* the next sample to be read from the input */
     double                    dts;
     uint64_t                  composition_delay;
     uint64_t                  skip_duration;
+    uint64_t                  clip_start_time;          /* composition time the clip starts at in the output media timeline */
+    uint64_t                  clip_duration;
+    uint32_t                  end_sample_number;        /* the last sample to be muxed; 0 means the end of the media timeline */
+    uint64_t                  timestamp_offset;         /* offset added to the timestamps of this part in concatenation */
+    uint32_t                 *summary_remap;            /* summary mapping of this part in concatenation */
     int                       reach_end_of_media_timeline;
     uint32_t                  track_ID;
     uint32_t                  last_sample_delta;
@@ -124,6 +141,7 @@ typedef struct
 {
     lsmash_root_t *root;
     input_file_t   file;
+    uint64_t       reorder_size;    /* total size of samples held in the queues of the tracks */
 } input_t;
 
 typedef struct
@@ -152,6 +170,13 @@ typedef struct
     uint32_t             frag_base_track;
     uint32_t             subseg_per_seg;
     int                  dash;
+    int                  passthrough;
+    uint32_t             moov_padding;
+    int                  clip;
+    double               clip_start;
+    double               clip_end;
+    int                  concat;
+    lsmash_trace_t      *trace;
 } remuxer_t;
 
 typedef struct
@@ -176,12 +201,16 @@ static void cleanup_input_movie( input_t *input )
         for( uint32_t i = 0; i < in_movie->num_tracks; i++ )
         {
             input_track_t *in_track = &in_movie->track[i];
+            for( uint32_t j = 0; j < in_track->queue.count; j++ )
+                lsmash_delete_sample( in_track->queue.samples[ (in_track->queue.head + j) % in_track->queue.alloc ] );
+            lsmash_free( in_track->queue.samples );
             if( in_track->summaries )
             {
                 for( uint32_t j = 0; j < in_track->num_summaries; j++ )
                     lsmash_cleanup_summary( in_track->summaries[j].summary );
                 lsmash_free( in_track->summaries );
             }
+            lsmash_free( in_track->summary_remap );
             input_media_t *in_media = &in_track->media;
             for( uint32_t j = 0; j < in_media->num_data_refs; j++ )
                 if( input->file.fh != in_media->data_refs[j].fh )
@@ -203,7 +232,10 @@ static void cleanup_output_movie( output_t *output )
     if( out_movie->track )
     {
         for( uint32_t i = 0; i < out_movie->num_tracks; i++ )
+        {
             lsmash_free( out_movie->track[i].summary_remap );
+            lsmash_free( out_movie->track[i].concat_tracks );
+        }
         lsmash_freep( &out_movie->track );
     }
     if( !(output->file.seg_param.mode & LSMASH_FILE_MODE_INITIALIZATION) )
@@ -227,6 +259,8 @@ static void cleanup_remuxer( remuxer_t *remuxer )
     lsmash_free( remuxer->track_option );
     lsmash_free( remuxer->input );
     cleanup_output_movie( remuxer->output );
+    lsmash_close_trace( remuxer->trace );
+    remuxer->trace = NULL;
 }
 
 #define eprintf( ... ) fprintf( stderr, __VA_ARGS__ )
@@ -284,6 +318,15 @@ static void display_help( void )
     display_version();
     eprintf( "\n"
              "Usage: remuxer -i input1 [-i input2 -i input3 ...] -o output\n"
+             "       remuxer --jobs <string> [--threads <integer>]\n"
+             "Batch job mode:\n"
+             "    --jobs <string>           Run the jobs listed in the file.\n"
+             "                              Each line holds the options of a job.\n"
+             "                              With --threads, the jobs run concurrently.\n"
+             "                              A line of NDJSON per job with its status, exit code\n"
+             "                              and elapsed time, and a summary line of the batch\n"
+             "                              are written into stdout in the order of the jobs.\n"
+             "    --threads <integer>       Run up to the given number of jobs at the same time. [1]\n"
              "Global options:\n"
              "    --help                    Display help.\n"
              "    --version                 Display version information.\n"
@@ -302,6 +345,25 @@ static void display_help( void )
              "                              The value is the number of subsegments per segment.\n"
              "                              If zero, Indexed self-initializing Media Segment.\n"
              "                              This option requires --fragment.\n"
+             "    --passthrough             Copy chunks of the input as they are instead of\n"
+             "                              remuxing sample by sample.\n"
+             "                              This option requires a single input without\n"
+             "                              --fragment and seek.\n"
+             "    --clip <start>,<end>      Extract the presentation in the range [start, end) in seconds.\n"
+             "                              Only the samples from the random accessible point\n"
+             "                              before start are read and the edit list trims the rest.\n"
+             "                              This option overrides seek of the track options.\n"
+             "    --concat                  Join the inputs one after another into a single movie.\n"
+             "                              The inputs shall have the same tracks with compatible\n"
+             "                              sample descriptions. Chunks are copied as they are.\n"
+             "                              Only remove of the track options takes effect on\n"
+             "                              the second and later inputs.\n"
+             "                              This option is unavailable with --fragment, --clip and seek.\n"
+             "    --moov-padding <integer>  Reserve padding in bytes at the end of the movie header.\n"
+             "                              The padding lets metaeditor update the metadata in place.\n"
+             "                              This option is ignored with --fragment.\n"
+             "    --trace <string>          Write the timing of the processing phases into the file\n"
+             "                              in the Chrome trace event format.\n"
              "Track options:\n"
              "    remove                    Remove this track\n"
              "    disable                   Disable this track\n"
@@ -407,7 +469,7 @@ static int input_data_reference
     return 0;
 }
 
-static int get_movie( input_t *input, char *input_name )
+static int get_movie( input_t *input, char *input_name, lsmash_trace_t *trace )
 {
     if( !strcmp( input_name, "-" ) )
         return ERROR_MSG( "standard input not supported.\n" );
@@ -415,6 +477,8 @@ static int get_movie( input_t *input, char *input_name )
     input->root = lsmash_create_root();
     if( !input->root )
         return ERROR_MSG( "failed to create a ROOT for an input file.\n" );
+    if( lsmash_attach_trace( trace, input->root ) < 0 )
+        return ERROR_MSG( "failed to attach the trace to an input file.\n" );
     input_file_t *in_file = &input->file;
     if( lsmash_open_file( input_name, 1, &in_file->param ) < 0 )
         return ERROR_MSG( "failed to open an input file.\n" );
@@ -587,13 +651,14 @@ static int parse_track_option( remuxer_t *remuxer )
                 return ERROR_MSG( "track number is not specified in %s\n", current_track_opt->raw_track_option );
             if( strchr( current_track_opt->raw_track_option, ':' ) != strrchr( current_track_opt->raw_track_option, ':' ) )
                 return ERROR_MSG( "multiple colons inside one track option in %s.\n", current_track_opt->raw_track_option );
-            uint32_t track_number = atoi( strtok( current_track_opt->raw_track_option, ":" ) );
+            char *saveptr;
+            uint32_t track_number = atoi( lsmash_strtok_r( current_track_opt->raw_track_option, ":", &saveptr ) );
             if( track_number == 0 )
-                return ERROR_MSG( "%s is an invalid track number.\n", strtok( current_track_opt->raw_track_option, ":" ) );
+                return ERROR_MSG( "%s is an invalid track number.\n", current_track_opt->raw_track_option );
             if( track_number > remuxer->input[i].file.movie.num_tracks )
                 return ERROR_MSG( "%d is an invalid track number.\n", track_number );
             char *track_option;
-            while( (track_option = strtok( NULL, "," )) != NULL )
+            while( (track_option = lsmash_strtok_r( NULL, ",", &saveptr )) != NULL )
             {
                 if( strchr( track_option, '=' ) != strrchr( track_option, '=' ) )
                     return ERROR_MSG( "multiple equal signs inside one track option in %s\n", track_option );
@@ -665,13 +730,14 @@ static int parse_cli_option( int argc, char **argv, remuxer_t *remuxer )
             char *p = argv[i];
             while( *p )
                 input_file_option[input_movie_number].num_track_delimiter += (*p++ == '?');
-            if( get_movie( &input[input_movie_number], strtok( argv[i], "?" ) ) )
+            char *saveptr;
+            if( get_movie( &input[input_movie_number], lsmash_strtok_r( argv[i], "?", &saveptr ), remuxer->trace ) )
                 FAILED_PARSE_CLI_OPTION( "failed to get input movie.\n" );
             uint32_t num_tracks = input[input_movie_number].file.movie.num_tracks;
             track_option[input_movie_number] = lsmash_malloc_zero( num_tracks * sizeof(track_media_option) );
             if( !track_option[input_movie_number] )
                 FAILED_PARSE_CLI_OPTION( "couldn't allocate memory.\n" );
-            input_file_option[input_movie_number].whole_track_option = strtok( NULL, "" );
+            input_file_option[input_movie_number].whole_track_option = lsmash_strtok_r( NULL, "", &saveptr );
             input[input_movie_number].file.movie.movie_ID = input_movie_number + 1;
             ++input_movie_number;
         }
@@ -684,6 +750,8 @@ static int parse_cli_option( int argc, char **argv, remuxer_t *remuxer )
             output->root = lsmash_create_root();
             if( !output->root )
                 FAILED_PARSE_CLI_OPTION( "failed to create a ROOT.\n" );
+            if( lsmash_attach_trace( remuxer->trace, output->root ) < 0 )
+                FAILED_PARSE_CLI_OPTION( "failed to attach the trace to the output file.\n" );
             if( lsmash_open_file( argv[i], 0, &output->file.param ) < 0 )
                 FAILED_PARSE_CLI_OPTION( "failed to open an output file.\n" );
             output->file.name = argv[i];
@@ -725,6 +793,34 @@ static int parse_cli_option( int argc, char **argv, remuxer_t *remuxer )
             remuxer->subseg_per_seg = atoi( argv[i] );
             remuxer->dash           = 1;
         }
+        else if( !strcasecmp( argv[i], "--passthrough" ) )
+            remuxer->passthrough = 1;
+        else if( !strcasecmp( argv[i], "--clip" ) )
+        {
+            if( ++i == argc )
+                FAILED_PARSE_CLI_OPTION( "--clip requires an argument.\n" );
+            if( sscanf( argv[i], "%lf,%lf", &remuxer->clip_start, &remuxer->clip_end ) != 2
+             || remuxer->clip_start < 0
+             || remuxer->clip_start >= remuxer->clip_end )
+                FAILED_PARSE_CLI_OPTION( "%s is an invalid range.\n", argv[i] );
+            remuxer->clip = 1;
+        }
+        else if( !strcasecmp( argv[i], "--concat" ) )
+            remuxer->concat = 1;
+        else if( !strcasecmp( argv[i], "--moov-padding" ) )
+        {
+            if( ++i == argc )
+                FAILED_PARSE_CLI_OPTION( "--moov-padding requires an argument.\n" );
+            remuxer->moov_padding = atoi( argv[i] );
+            if( remuxer->moov_padding < 8 )
+                FAILED_PARSE_CLI_OPTION( "--moov-padding requires 8 or more bytes.\n" );
+        }
+        else if( !strcasecmp( argv[i], "--trace" ) )
+        {
+            /* The trace file has been opened before reading the inputs. */
+            if( ++i == argc )
+                FAILED_PARSE_CLI_OPTION( "--trace requires an argument.\n" );
+        }
         else
             FAILED_PARSE_CLI_OPTION( "unkown option found: %s\n", argv[i] );
     }
@@ -755,9 +851,10 @@ static int parse_cli_option( int argc, char **argv, remuxer_t *remuxer )
                                      input[i].file.movie.num_tracks );
         if( input_file_option[i].num_track_delimiter )
         {
-            track_option[i][0].raw_track_option = strtok( input_file_option[i].whole_track_option, "?" );
+            char *saveptr;
+            track_option[i][0].raw_track_option = lsmash_strtok_r( input_file_option[i].whole_track_option, "?", &saveptr );
             for( int j = 1; j < input_file_option[i].num_track_delimiter ; j++ )
-                track_option[i][j].raw_track_option = strtok( NULL, "?" );
+                track_option[i][j].raw_track_option = lsmash_strtok_r( NULL, "?", &saveptr );
         }
     }
     if( parse_track_option( remuxer ) )
@@ -1096,6 +1193,57 @@ static int set_starting_point( input_t *input, input_track_t *in_track, uint32_t
     return 0;
 }
 
+/* Convert a time in seconds on the presentation timeline of an input track into the composition time
+ * on its media timeline by following the empty edits and the first edit of the explicit timeline map. */
+static uint64_t get_media_time( input_t *input, input_track_t *in_track, double presentation_time )
+{
+    uint32_t movie_timescale = input->file.movie.param.timescale;
+    uint32_t media_timescale = in_track->media.param.timescale;
+    double   media_time      = presentation_time * media_timescale;
+    uint32_t edit_count      = lsmash_count_explicit_timeline_map( input->root, in_track->track_ID );
+    for( uint32_t i = 1; i <= edit_count; i++ )
+    {
+        lsmash_edit_t edit;
+        if( lsmash_get_explicit_timeline_map( input->root, in_track->track_ID, i, &edit ) )
+            break;
+        if( edit.start_time == ISOM_EDIT_MODE_EMPTY )
+            media_time -= movie_timescale ? (double)edit.duration * media_timescale / movie_timescale : 0;
+        else
+        {
+            media_time += edit.start_time;
+            break;
+        }
+    }
+    return media_time > 0 ? (uint64_t)(media_time + 0.5) : 0;
+}
+
+static int set_clip_range( remuxer_t *remuxer, input_t *input, input_track_t *in_track )
+{
+    uint64_t start_time = get_media_time( input, in_track, remuxer->clip_start );
+    uint64_t end_time   = get_media_time( input, in_track, remuxer->clip_end );
+    uint32_t first_sample_number;
+    if( lsmash_get_sample_range_from_media_timeline( input->root, in_track->track_ID, start_time, end_time,
+                                                     &first_sample_number, &in_track->end_sample_number ) )
+        return ERROR_MSG( "failed to get the range of samples to be clipped.\n" );
+    uint64_t first_dts;
+    uint64_t first_cts;
+    uint32_t ctd_shift;
+    if( lsmash_get_dts_from_media_timeline( input->root, in_track->track_ID, first_sample_number, &first_dts )
+     || lsmash_get_cts_from_media_timeline( input->root, in_track->track_ID, first_sample_number, &first_cts )
+     || lsmash_get_composition_to_decode_shift_from_media_timeline( input->root, in_track->track_ID, &ctd_shift )
+     || lsmash_get_sample_delta_from_media_timeline( input->root, in_track->track_ID, in_track->end_sample_number, &in_track->last_sample_delta ) )
+        return ERROR_MSG( "failed to get the timestamps of the samples to be clipped.\n" );
+    /* The output timestamps start from the decoding time of the first sample. */
+    in_track->composition_delay = first_cts - first_dts + ctd_shift;
+    if( start_time + ctd_shift >= first_dts )
+        in_track->clip_start_time = start_time + ctd_shift - first_dts;
+    else
+        in_track->clip_start_time = in_track->composition_delay;
+    in_track->clip_duration         = end_time - start_time;
+    in_track->current_sample_number = first_sample_number;
+    return 0;
+}
+
 static void exclude_invalid_output_track( output_t *output, output_track_t *out_track,
                                           input_movie_t *in_movie, input_track_t *in_track,
                                           const char *message, ... )
@@ -1107,6 +1255,7 @@ static void exclude_invalid_output_track( output_t *output, output_track_t *out_
     vfprintf( stderr, message, args );
     va_end( args );
     lsmash_delete_track( output->root, out_track->track_ID );
+    lsmash_freep( &out_track->summary_remap );
     -- output->file.movie.num_tracks;
     in_track->active = 0;
 }
@@ -1116,8 +1265,10 @@ static int prepare_output( remuxer_t *remuxer )
     input_t        *input     = remuxer->input;
     output_t       *output    = remuxer->output;
     output_movie_t *out_movie = &output->file.movie;
+    /* In concatenation, the output tracks are created only from the first input. */
+    int num_track_sources = remuxer->concat ? 1 : remuxer->num_input;
     /* Count the number of output tracks. */
-    for( int i = 0; i < remuxer->num_input; i++ )
+    for( int i = 0; i < num_track_sources; i++ )
         out_movie->num_tracks += input[i].file.movie.num_tracks;
     for( int i = 0; i < remuxer->num_input; i++ )
     {
@@ -1127,19 +1278,19 @@ static int prepare_output( remuxer_t *remuxer )
             /* Don't remux tracks specified as 'remove' by a user. */
             if( remuxer->track_option[i][j].remove )
                 in_movie->track[j].active = 0;
-            if( !in_movie->track[j].active )
+            if( !in_movie->track[j].active && i < num_track_sources )
                 -- out_movie->num_tracks;
         }
     }
     if( set_movie_parameters( remuxer ) < 0 )
         return ERROR_MSG( "failed to set output movie parameters.\n" );
-    set_itunes_metadata( output, input, remuxer->num_input );
+    set_itunes_metadata( output, input, num_track_sources );
     /* Allocate output tracks. */
-    out_movie->track = lsmash_malloc( out_movie->num_tracks * sizeof(output_track_t) );
+    out_movie->track = lsmash_malloc_zero( out_movie->num_tracks * sizeof(output_track_t) );
     if( !out_movie->track )
         return ERROR_MSG( "failed to alloc output tracks.\n" );
     out_movie->current_track_number = 1;
-    for( int i = 0; i < remuxer->num_input; i++ )
+    for( int i = 0; i < num_track_sources; i++ )
     {
         input_movie_t *in_movie = &input[i].file.movie;
         for( uint32_t j = 0; j < in_movie->num_tracks; j++ )
@@ -1205,7 +1356,16 @@ static int prepare_output( remuxer_t *remuxer )
                 continue;
             }
             out_track->last_sample_delta = in_track->last_sample_delta;
-            if( set_starting_point( input, in_track, current_track_opt->seek, current_track_opt->consider_rap ) < 0 )
+            if( remuxer->clip )
+            {
+                if( set_clip_range( remuxer, &input[i], in_track ) < 0 )
+                {
+                    exclude_invalid_output_track( output, out_track, in_movie, in_track, "failed to set clip range.\n" );
+                    continue;
+                }
+                out_track->last_sample_delta = in_track->last_sample_delta;
+            }
+            else if( set_starting_point( input, in_track, current_track_opt->seek, current_track_opt->consider_rap ) < 0 )
             {
                 exclude_invalid_output_track( output, out_track, in_movie, in_track, "failed to set starting point.\n" );
                 continue;
@@ -1223,6 +1383,74 @@ static int prepare_output( remuxer_t *remuxer )
     return 0;
 }
 
+/* Pair the active tracks of each input with the output tracks in order and
+ * check if the samples of the inputs can be appended to the output tracks as they are. */
+static int prepare_concatenation( remuxer_t *remuxer )
+{
+    input_t        *input     = remuxer->input;
+    output_movie_t *out_movie = &remuxer->output->file.movie;
+    if( remuxer->num_input < 2 )
+        return ERROR_MSG( "concatenation requires two or more inputs.\n" );
+    if( remuxer->frag_base_track )
+        return ERROR_MSG( "concatenation is unavailable for fragmentation.\n" );
+    if( remuxer->clip )
+        return ERROR_MSG( "concatenation is unavailable for clip.\n" );
+    for( int i = 0; i < remuxer->num_input; i++ )
+        for( uint32_t j = 0; j < input[i].file.movie.num_tracks; j++ )
+            if( input[i].file.movie.track[j].active && remuxer->track_option[i][j].seek )
+                return ERROR_MSG( "concatenation is unavailable for seek.\n" );
+    for( uint32_t i = 0; i < out_movie->num_tracks; i++ )
+    {
+        out_movie->track[i].concat_tracks = lsmash_malloc_zero( remuxer->num_input * sizeof(input_track_t *) );
+        if( !out_movie->track[i].concat_tracks )
+            return ERROR_MSG( "failed to allocate concatenation handlers.\n" );
+    }
+    for( int i = 0; i < remuxer->num_input; i++ )
+    {
+        input_movie_t *in_movie          = &input[i].file.movie;
+        uint32_t       num_active_tracks = 0;
+        for( uint32_t j = 0; j < in_movie->num_tracks; j++ )
+        {
+            input_track_t *in_track = &in_movie->track[j];
+            if( !in_track->active )
+                continue;
+            if( num_active_tracks == out_movie->num_tracks )
+                return ERROR_MSG( "input %d has more tracks than the first input.\n", i + 1 );
+            output_track_t *out_track = &out_movie->track[ num_active_tracks ++ ];
+            out_track->concat_tracks[i] = in_track;
+            if( i == 0 )
+                continue;
+            input_track_t *base = out_track->concat_tracks[0];
+            if( in_track->media.param.handler_type != base->media.param.handler_type
+             || in_track->media.param.timescale    != base->media.param.timescale )
+                return ERROR_MSG( "track %"PRIu32" of input %d is incompatible with the first input.\n", in_track->track_ID, i + 1 );
+            /* Map each summary onto the identical one in the output track. */
+            in_track->summary_remap = lsmash_malloc_zero( in_track->num_summaries * sizeof(uint32_t) );
+            if( !in_track->summary_remap )
+                return ERROR_MSG( "failed to create summary mapping for a track.\n" );
+            for( uint32_t k = 0; k < in_track->num_summaries; k++ )
+            {
+                if( !in_track->summaries[k].active )
+                    continue;
+                for( uint32_t l = 0; l < base->num_summaries && in_track->summary_remap[k] == 0; l++ )
+                    if( out_track->summary_remap[l]
+                     && lsmash_compare_summary( in_track->summaries[k].summary, base->summaries[l].summary ) == 0 )
+                        in_track->summary_remap[k] = out_track->summary_remap[l];
+                if( in_track->summary_remap[k] == 0 )
+                    return ERROR_MSG( "track %"PRIu32" of input %d has an incompatible summary.\n", in_track->track_ID, i + 1 );
+            }
+            /* Place the samples right after the ones of the previous input. */
+            input_track_t *prev = out_track->concat_tracks[i - 1];
+            in_track->timestamp_offset = prev->timestamp_offset
+                                       + lsmash_get_media_duration_from_media_timeline( input[i - 1].root, prev->track_ID );
+            out_track->last_sample_delta = in_track->last_sample_delta;
+        }
+        if( num_active_tracks != out_movie->num_tracks )
+            return ERROR_MSG( "input %d has fewer tracks than the first input.\n", i + 1 );
+    }
+    return 0;
+}
+
 static void set_reference_chapter_track( remuxer_t *remuxer )
 {
     if( remuxer->ref_chap_available )
@@ -1271,7 +1499,7 @@ static int moov_to_front_callback( void *param, uint64_t written_movie_size, uin
     return 0;
 }
 
-static lsmash_adhoc_remux_t moov_to_front =
+static const lsmash_adhoc_remux_t moov_to_front =
 {
     .func        = moov_to_front_callback,
     .buffer_size = 4 * 1024 * 1024, /* 4MiB */
@@ -1356,7 +1584,7 @@ static int switch_segment( remuxer_t *remuxer )
         return ERROR_MSG( "failed to add an output segment file into a ROOT.\n" );
     /* Switch to the next segment.
      * After switching, close the previous segment if the previous is not the initialization segment. */
-    if( lsmash_switch_media_segment( output->root, segment, &moov_to_front ) < 0 )
+    if( lsmash_switch_media_segment( output->root, segment, &output->moov_to_front ) < 0 )
         return ERROR_MSG( "failed to switch to the next segment.\n" );
     if( !(out_file->seg_param.mode & LSMASH_FILE_MODE_INITIALIZATION) )
         return lsmash_close_file( &out_file->seg_param );
@@ -1390,7 +1618,8 @@ static void adapt_description_index( output_track_t *out_track, input_track_t *i
     sample->index = sample->index > in_track->num_summaries ? in_track->num_summaries
                   : sample->index == 0 ? 1
                   : sample->index;
-    sample->index = out_track->summary_remap[ sample->index - 1 ];
+    sample->index = in_track->summary_remap ? in_track->summary_remap[ sample->index - 1 ]
+                  : out_track->summary_remap[ sample->index - 1 ];
     if( in_track->current_sample_index == 0 )
         in_track->current_sample_index = sample->index;
 }
@@ -1407,6 +1636,93 @@ static void adjust_timestamp( output_track_t *out_track, lsmash_sample_t *sample
     }
 }
 
+/* the maximum total size of samples read ahead per input */
+#define MAX_REORDER_BUFFER_SIZE (32 * 1024 * 1024)
+
+static int enqueue_sample( sample_queue_t *queue, lsmash_sample_t *sample )
+{
+    if( queue->count == queue->alloc )
+    {
+        uint32_t          alloc   = queue->alloc ? 2 * queue->alloc : 64;
+        lsmash_sample_t **samples = lsmash_malloc( alloc * sizeof(lsmash_sample_t *) );
+        if( !samples )
+            return -1;
+        for( uint32_t i = 0; i < queue->count; i++ )
+            samples[i] = queue->samples[ (queue->head + i) % queue->alloc ];
+        lsmash_free( queue->samples );
+        queue->samples = samples;
+        queue->head    = 0;
+        queue->alloc   = alloc;
+    }
+    queue->samples[ (queue->head + queue->count) % queue->alloc ] = sample;
+    ++ queue->count;
+    return 0;
+}
+
+static lsmash_sample_t *dequeue_sample( sample_queue_t *queue )
+{
+    lsmash_sample_t *sample = queue->samples[ queue->head ];
+    queue->head = (queue->head + 1) % queue->alloc;
+    -- queue->count;
+    return sample;
+}
+
+/* Get the current sample of an input track.
+ * Samples are read from the input in the order of their positions in the file as far as possible
+ * so that reading does not seek back and forth between tracks. Samples of the other tracks read
+ * on the way are held in their queues until requested. If the queues get full, the requested sample
+ * is read directly. */
+static lsmash_sample_t *get_input_sample( input_t *in, input_track_t *in_track )
+{
+    if( in_track->queue.count )
+    {
+        lsmash_sample_t *sample = dequeue_sample( &in_track->queue );
+        in->reorder_size -= sample->length;
+        return sample;
+    }
+    if( in_track->end_sample_number && in_track->current_sample_number > in_track->end_sample_number )
+        return NULL;
+    input_movie_t *in_movie = &in->file.movie;
+    while( in->reorder_size < MAX_REORDER_BUFFER_SIZE )
+    {
+        /* Find the track whose next sample to be read is placed first. */
+        input_track_t *first     = NULL;
+        uint64_t       first_pos = UINT64_MAX;
+        for( uint32_t i = 0; i < in_movie->num_tracks; i++ )
+        {
+            input_track_t *track = &in_movie->track[i];
+            if( !track->active || track->reach_end_of_media_timeline )
+                continue;
+            if( track->queue.count == 0 )
+                /* The held sample, if any, has been read already. */
+                track->next_read_sample_number = track->current_sample_number + !!track->sample;
+            if( track->end_sample_number && track->next_read_sample_number > track->end_sample_number )
+                continue;
+            lsmash_sample_t info;
+            if( lsmash_get_sample_info_from_media_timeline( in->root, track->track_ID, track->next_read_sample_number, &info ) < 0 )
+                continue;
+            if( info.pos < first_pos || (info.pos == first_pos && track == in_track) )
+            {
+                first     = track;
+                first_pos = info.pos;
+            }
+        }
+        if( !first || first == in_track )
+            break;
+        lsmash_sample_t *sample = lsmash_get_sample_from_media_timeline( in->root, first->track_ID, first->next_read_sample_number );
+        if( !sample )
+            break;
+        if( enqueue_sample( &first->queue, sample ) < 0 )
+        {
+            lsmash_delete_sample( sample );
+            break;
+        }
+        in->reorder_size += sample->length;
+        ++ first->next_read_sample_number;
+    }
+    return lsmash_get_sample_from_media_timeline( in->root, in_track->track_ID, in_track->current_sample_number );
+}
+
 static int do_remux( remuxer_t *remuxer )
 {
 #define LSMASH_MAX( a, b ) ((a) > (b) ? (a) : (b))
@@ -1447,7 +1763,7 @@ static int do_remux( remuxer_t *remuxer )
             /* Get a new sample data if the track doesn't hold any one. */
             if( !sample )
             {
-                sample = lsmash_get_sample_from_media_timeline( in->root, in_track->track_ID, in_track->current_sample_number );
+                sample = get_input_sample( in, in_track );
                 if( sample )
                 {
                     output_track_t *out_track = &out_movie->track[ out_movie->current_track_number - 1 ];
@@ -1456,6 +1772,13 @@ static int do_remux( remuxer_t *remuxer )
                     in_track->sample = sample;
                     in_track->dts    = (double)sample->dts / in_track->media.param.timescale;
                 }
+                else if( in_track->end_sample_number && in_track->current_sample_number > in_track->end_sample_number )
+                {
+                    /* Reached the end of the clip. */
+                    in_track->reach_end_of_media_timeline = 1;
+                    if( --num_active_input_tracks == 0 )
+                        break;      /* end of muxing */
+                }
                 else
                 {
                     if( lsmash_check_sample_existence_in_media_timeline( in->root, in_track->track_ID, in_track->current_sample_number ) )
@@ -1589,8 +1912,251 @@ static int do_remux( remuxer_t *remuxer )
 #undef LSMASH_MAX
 }
 
+typedef struct
+{
+    lsmash_sample_t *samples;               /* information of samples in this chunk */
+    uint32_t         sample_count;
+    uint32_t         alloc;
+    uint32_t         first_sample_number;
+    uint64_t         pos;                   /* absolute file offset of this chunk in the input */
+    uint64_t         size;
+} passthrough_chunk_t;
+
+#define PASSTHROUGH_MAX_CHUNK_SIZE (4 * 1024 * 1024)
+
+static int check_passthrough( remuxer_t *remuxer )
+{
+    if( remuxer->num_input != 1 )
+        return WARNING_MSG( "passthrough requires a single input.\n" );
+    if( remuxer->frag_base_track )
+        return WARNING_MSG( "passthrough is unavailable for fragmentation.\n" );
+    input_movie_t *in_movie = &remuxer->input[0].file.movie;
+    for( uint32_t i = 0; i < in_movie->num_tracks; i++ )
+        if( in_movie->track[i].active && remuxer->track_option[0][i].seek )
+            return WARNING_MSG( "passthrough is unavailable for seek.\n" );
+    if( remuxer->clip )
+        return WARNING_MSG( "passthrough is unavailable for clip.\n" );
+    return 0;
+}
+
+/* Gather samples stored contiguously from the current sample in an input track as a chunk. */
+static int gather_passthrough_chunk( input_t *in, input_track_t *in_track, output_track_t *out_track, passthrough_chunk_t *chunk )
+{
+    uint32_t sample_count = lsmash_get_sample_count_in_media_timeline( in->root, in_track->track_ID );
+    chunk->sample_count = 0;
+    chunk->size         = 0;
+    while( in_track->current_sample_number <= sample_count )
+    {
+        lsmash_sample_t info;
+        if( lsmash_get_sample_info_from_media_timeline( in->root, in_track->track_ID, in_track->current_sample_number, &info ) < 0 )
+            return ERROR_MSG( "failed to get a sample.\n" );
+        adapt_description_index( out_track, in_track, &info );
+        if( chunk->sample_count
+         && (info.index  == 0
+          || info.index  != chunk->samples[0].index
+          || info.pos    != chunk->pos + chunk->size
+          || chunk->size +  info.length > PASSTHROUGH_MAX_CHUNK_SIZE) )
+            return 0;
+        ++ in_track->current_sample_number;
+        if( info.index == 0 )
+            continue;   /* The sample description of this sample is unavailable. */
+        if( chunk->sample_count == chunk->alloc )
+        {
+            uint32_t         alloc   = chunk->alloc ? 2 * chunk->alloc : 256;
+            lsmash_sample_t *samples = lsmash_realloc( chunk->samples, alloc * sizeof(lsmash_sample_t) );
+            if( !samples )
+                return ERROR_MSG( "failed to allocate sample information.\n" );
+            chunk->samples = samples;
+            chunk->alloc   = alloc;
+        }
+        adjust_timestamp( out_track, &info );
+        info.dts += in_track->timestamp_offset;
+        info.cts += in_track->timestamp_offset;
+        if( chunk->sample_count == 0 )
+        {
+            chunk->first_sample_number = in_track->current_sample_number - 1;
+            chunk->pos                 = info.pos;
+        }
+        chunk->samples[ chunk->sample_count ++ ] = info;
+        chunk->size += info.length;
+        out_track->current_sample_number += 1;
+    }
+    in_track->reach_end_of_media_timeline = 1;
+    return 0;
+}
+
+/* Copy chunks in the order of their positions in the input so that the interleave of the input is kept.
+ * Sample tables are rebuilt from the sample information, but sample data are never touched one by one.
+ * In concatenation, the inputs are copied one after another in the same way. */
+static int do_passthrough_remux( remuxer_t *remuxer )
+{
+    output_t       *output    = remuxer->output;
+    output_movie_t *out_movie = &output->file.movie;
+    set_reference_chapter_track( remuxer );
+    passthrough_chunk_t *chunks    = lsmash_malloc_zero( out_movie->num_tracks * sizeof(passthrough_chunk_t) );
+    input_track_t      **in_tracks = lsmash_malloc_zero( out_movie->num_tracks * sizeof(input_track_t *) );
+    uint8_t             *data      = NULL;
+    uint64_t             data_size = 0;
+    int                  ret       = 0;
+    if( !chunks || !in_tracks )
+    {
+        ret = ERROR_MSG( "failed to allocate chunk handlers.\n" );
+        goto cleanup;
+    }
+    uint64_t total_media_size = 0;
+    int      num_parts        = remuxer->concat ? remuxer->num_input : 1;
+    for( int part = 0; part < num_parts; part++ )
+    {
+        input_t       *in       = &remuxer->input[part];
+        input_movie_t *in_movie = &in->file.movie;
+        /* Output tracks are created from active input tracks in order. */
+        if( remuxer->concat )
+            for( uint32_t i = 0; i < out_movie->num_tracks; i++ )
+                in_tracks[i] = out_movie->track[i].concat_tracks[part];
+        else
+            for( uint32_t i = 0, j = 0; i < in_movie->num_tracks && j < out_movie->num_tracks; i++ )
+                if( in_movie->track[i].active )
+                    in_tracks[j++] = &in_movie->track[i];
+        while( 1 )
+        {
+            /* Pick the chunk placed first in the input. */
+            passthrough_chunk_t *chunk     = NULL;
+            uint32_t             track_idx = 0;
+            for( uint32_t i = 0; i < out_movie->num_tracks; i++ )
+            {
+                if( chunks[i].sample_count == 0
+                 && !in_tracks[i]->reach_end_of_media_timeline
+                 && (ret = gather_passthrough_chunk( in, in_tracks[i], &out_movie->track[i], &chunks[i] )) < 0 )
+                    goto cleanup;
+                if( chunks[i].sample_count && (!chunk || chunks[i].pos < chunk->pos) )
+                {
+                    chunk     = &chunks[i];
+                    track_idx = i;
+                }
+            }
+            if( !chunk )
+                break;      /* end of this input */
+            if( data_size < chunk->size )
+            {
+                uint8_t *new_data = lsmash_realloc( data, chunk->size );
+                if( !new_data )
+                {
+                    ret = ERROR_MSG( "failed to allocate a chunk buffer.\n" );
+                    goto cleanup;
+                }
+                data      = new_data;
+                data_size = chunk->size;
+            }
+            output_track_t *out_track = &out_movie->track[track_idx];
+            if( lsmash_read_sample_data_from_media_timeline( in->root, in_tracks[track_idx]->track_ID,
+                                                             chunk->first_sample_number, chunk->sample_count, data, chunk->size ) < 0 )
+            {
+                ret = ERROR_MSG( "failed to read a chunk.\n" );
+                goto cleanup;
+            }
+            if( lsmash_append_chunk( output->root, out_track->track_ID, chunk->samples, chunk->sample_count, data ) < 0 )
+            {
+                ret = ERROR_MSG( "failed to append a chunk.\n" );
+                goto cleanup;
+            }
+            out_track->last_sample_dts = chunk->samples[ chunk->sample_count - 1 ].dts;
+            total_media_size += chunk->size;
+            chunk->sample_count = 0;
+            eprintf( "Importing: %"PRIu64" bytes\r", total_media_size );
+        }
+    }
+    for( uint32_t i = 0; i < out_movie->num_tracks; i++ )
+        if( lsmash_flush_pooled_samples( output->root, out_movie->track[i].track_ID, out_movie->track[i].last_sample_delta ) )
+        {
+            ret = ERROR_MSG( "failed to flush samples.\n" );
+            goto cleanup;
+        }
+cleanup:
+    if( chunks )
+        for( uint32_t i = 0; i < out_movie->num_tracks; i++ )
+            lsmash_free( chunks[i].samples );
+    lsmash_free( chunks );
+    lsmash_free( in_tracks );
+    lsmash_free( data );
+    return ret;
+}
+
+/* Join the timeline maps of the inputs.
+ * Each input lasts for its movie duration in the output so that the tracks are kept in sync after each joint. */
+static int construct_concatenated_timeline_maps( remuxer_t *remuxer )
+{
+    output_t       *output          = remuxer->output;
+    output_movie_t *out_movie       = &output->file.movie;
+    uint32_t        movie_timescale = lsmash_get_movie_timescale( output->root );
+    for( uint32_t i = 0; i < out_movie->num_tracks; i++ )
+    {
+        output_track_t *out_track = &out_movie->track[i];
+        if( lsmash_delete_explicit_timeline_map( output->root, out_track->track_ID ) )
+            return ERROR_MSG( "failed to delete explicit timeline maps.\n" );
+        uint32_t media_timescale = lsmash_get_media_timescale( output->root, out_track->track_ID );
+        if( !media_timescale )
+            return ERROR_MSG( "media timescale is broken.\n" );
+        for( int part = 0; part < remuxer->num_input; part++ )
+        {
+            input_t       *in       = &remuxer->input[part];
+            input_track_t *in_track = out_track->concat_tracks[part];
+            if( !in->file.movie.param.timescale )
+                return ERROR_MSG( "movie timescale is broken.\n" );
+            double   timescale_convert_multiplier = (double)movie_timescale / in->file.movie.param.timescale;
+            uint64_t media_duration = lsmash_get_media_duration_from_media_timeline( in->root, in_track->track_ID );
+            uint64_t part_duration  = 0;
+            uint32_t num_edits      = lsmash_count_explicit_timeline_map( in->root, in_track->track_ID );
+            uint32_t edit_number    = 0;
+            do
+            {
+                lsmash_edit_t edit;
+                if( num_edits == 0 )
+                {
+                    /* The whole media is presented implicitly. */
+                    edit.duration   = ISOM_EDIT_DURATION_IMPLICIT;
+                    edit.start_time = 0;
+                    edit.rate       = ISOM_EDIT_MODE_NORMAL;
+                }
+                else if( lsmash_get_explicit_timeline_map( in->root, in_track->track_ID, edit_number + 1, &edit ) )
+                    return ERROR_MSG( "failed to get an explicit timeline map.\n" );
+                else
+                    edit.duration = edit.duration * timescale_convert_multiplier + 0.5;
+                if( edit.start_time != ISOM_EDIT_MODE_EMPTY )
+                {
+                    if( edit.duration == ISOM_EDIT_DURATION_IMPLICIT )
+                    {
+                        /* Present the rest of the media. */
+                        uint64_t rest = media_duration > (uint64_t)edit.start_time ? media_duration - edit.start_time : 0;
+                        edit.duration = rest * ((double)movie_timescale / media_timescale) + 0.5;
+                    }
+                    edit.start_time += in_track->timestamp_offset;
+                }
+                if( edit.duration == 0 )
+                    continue;
+                if( lsmash_create_explicit_timeline_map( output->root, out_track->track_ID, edit ) )
+                    return ERROR_MSG( "failed to create a explicit timeline map.\n" );
+                part_duration += edit.duration;
+            } while( ++edit_number < num_edits );
+            /* Fill the rest of this input with an empty duration. */
+            uint64_t movie_duration = in->file.movie.param.duration * timescale_convert_multiplier + 0.5;
+            if( part + 1 < remuxer->num_input && part_duration < movie_duration )
+            {
+                lsmash_edit_t empty_edit;
+                empty_edit.duration   = movie_duration - part_duration;
+                empty_edit.start_time = ISOM_EDIT_MODE_EMPTY;
+                empty_edit.rate       = ISOM_EDIT_MODE_NORMAL;
+                if( lsmash_create_explicit_timeline_map( output->root, out_track->track_ID, empty_edit ) )
+                    return ERROR_MSG( "failed to create a empty duration.\n" );
+            }
+        }
+    }
+    return 0;
+}
+
 static int construct_timeline_maps( remuxer_t *remuxer )
 {
+    if( remuxer->concat )
+        return construct_concatenated_timeline_maps( remuxer );
     input_t             *input        = remuxer->input;
     output_t            *output       = remuxer->output;
     output_movie_t      *out_movie    = &output->file.movie;
@@ -1603,7 +2169,31 @@ static int construct_timeline_maps( remuxer_t *remuxer )
             if( !in_track->active )
                 continue;
             output_track_t *out_track = &out_movie->track[ out_movie->current_track_number ++ - 1 ];
-            if( track_option[i][j].seek )
+            if( remuxer->clip )
+            {
+                /* Trim the samples before the random accessible point and after the end of the clip. */
+                if( lsmash_delete_explicit_timeline_map( output->root, out_track->track_ID ) )
+                    return ERROR_MSG( "failed to delete explicit timeline maps.\n" );
+                uint32_t movie_timescale = lsmash_get_movie_timescale( output->root );
+                uint32_t media_timescale = lsmash_get_media_timescale( output->root, out_track->track_ID );
+                if( !media_timescale )
+                    return ERROR_MSG( "media timescale is broken.\n" );
+                double timescale_convert_multiplier = (double)movie_timescale / media_timescale;
+                uint64_t media_end = out_track->last_sample_dts + out_track->last_sample_delta + in_track->composition_delay;
+                uint64_t duration  = media_end > in_track->clip_start_time ? media_end - in_track->clip_start_time : 0;
+                if( duration > in_track->clip_duration )
+                    duration = in_track->clip_duration;
+                lsmash_edit_t edit;
+                edit.start_time = in_track->clip_start_time;
+                if( remuxer->frag_base_track == 0 )
+                    edit.duration = duration * timescale_convert_multiplier + 0.5;
+                else
+                    edit.duration = ISOM_EDIT_DURATION_IMPLICIT;
+                edit.rate = ISOM_EDIT_MODE_NORMAL;
+                if( lsmash_create_explicit_timeline_map( output->root, out_track->track_ID, edit ) )
+                    return ERROR_MSG( "failed to create a explicit timeline map.\n" );
+            }
+            else if( track_option[i][j].seek )
             {
                 /* Reconstruct timeline maps. */
                 if( lsmash_delete_explicit_timeline_map( output->root, out_track->track_ID ) )
@@ -1646,14 +2236,18 @@ static int finish_movie( remuxer_t *remuxer )
     /* Set chapter list */
     if( remuxer->chap_file )
         lsmash_set_tyrant_chapter( output->root, remuxer->chap_file, remuxer->add_bom_to_chpl );
+    /* Reserve padding for later in-place editing. */
+    if( remuxer->moov_padding && !remuxer->frag_base_track
+     && lsmash_reserve_movie_padding( output->root, remuxer->moov_padding ) )
+        return -1;
     /* Finish muxing. */
     REFRESH_CONSOLE;
-    if( lsmash_finish_movie( output->root, &moov_to_front ) )
+    if( lsmash_finish_movie( output->root, &output->moov_to_front ) )
         return -1;
     return remuxer->frag_base_track ? 0 : lsmash_write_lsmash_indicator( output->root );
 }
 
-int main( int argc, char *argv[] )
+static int remux( int argc, char *argv[] )
 {
     if ( argc < 2 )
     {
@@ -1676,14 +2270,16 @@ int main( int argc, char *argv[] )
         return -1;
     }
 
-    lsmash_get_mainargs( &argc, &argv );
-    int num_input = 0;
+    int   num_input  = 0;
+    char *trace_file = NULL;
     for( int i = 1 ; i < argc ; i++ )
         if( !strcasecmp( argv[i], "-i" ) || !strcasecmp( argv[i], "--input" ) )
             num_input++;
+        else if( !strcasecmp( argv[i], "--trace" ) && i + 1 < argc )
+            trace_file = argv[i + 1];
     if( !num_input )
         return ERROR_MSG( "no input file specified.\n" );
-    output_t output = { 0 };
+    output_t output = { .moov_to_front = moov_to_front };
     input_t *input = lsmash_malloc_zero( num_input * sizeof(input_t) );
     if( !input )
         return ERROR_MSG( "failed to allocate the input handler.\n" );
@@ -1706,15 +2302,25 @@ int main( int argc, char *argv[] )
         .default_language   = 0,
         .frag_base_track    = 0,
         .subseg_per_seg     = 0,
-        .dash               = 0
+        .dash               = 0,
+        .passthrough        = 0,
+        .moov_padding       = 0,
+        .concat             = 0,
+        .trace              = NULL
     };
+    if( trace_file && !(remuxer.trace = lsmash_open_trace( trace_file )) )
+        return REMUXER_ERR( "failed to open the trace file.\n" );
     if( parse_cli_option( argc, argv, &remuxer ) )
         return REMUXER_ERR( "failed to parse command line options.\n" );
+    if( remuxer.passthrough && !remuxer.concat && check_passthrough( &remuxer ) < 0 )
+        remuxer.passthrough = 0;
     if( prepare_output( &remuxer ) )
         return REMUXER_ERR( "failed to set up preparation for output.\n" );
+    if( remuxer.concat && prepare_concatenation( &remuxer ) )
+        return REMUXER_ERR( "failed to set up concatenation.\n" );
     if( remuxer.frag_base_track && construct_timeline_maps( &remuxer ) )
         return REMUXER_ERR( "failed to construct timeline maps.\n" );
-    if( do_remux( &remuxer ) )
+    if( (remuxer.passthrough || remuxer.concat ? do_passthrough_remux( &remuxer ) : do_remux( &remuxer )) )
         return REMUXER_ERR( "failed to remux movies.\n" );
     if( remuxer.frag_base_track == 0 && construct_timeline_maps( &remuxer ) )
         return REMUXER_ERR( "failed to construct timeline maps.\n" );
@@ -1725,3 +2331,11 @@ int main( int argc, char *argv[] )
     cleanup_remuxer( &remuxer );
     return 0;
 }
+
+int main( int argc, char *argv[] )
+{
+    lsmash_get_mainargs( &argc, &argv );
+    if( argc >= 3 && !strcasecmp( argv[1], "--jobs" ) )
+        return lsmash_run_jobs( argc, argv, remux );
+    return remux( argc, argv );
+}
@@ -0,0 +1,532 @@
+/*****************************************************************************
+ * stress.c:
+ *****************************************************************************
+ * Copyright (C) 2015 L-SMASH project
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ * ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ *****************************************************************************/
+
+/* This file is available under an ISC license. */
+
+#include "cli.h"
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdarg.h>
+#include <inttypes.h>
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <pthread.h>
+#endif
+
+/* The stress test muxes through the internal importer API as the benchmarks do. */
+#include "common/internal.h"
+#include "importer/importer.h"
+
+#define eprintf( ... ) fprintf( stderr, __VA_ARGS__ )
+
+#define STRESS_DEFAULT_NUM_THREADS 8
+#define STRESS_DEFAULT_ITERATIONS  4
+#define STRESS_DEFAULT_STREAM_SIZE (1024 * 1024)
+#define STRESS_MAX_THREADS         256
+#define STRESS_MAX_INPUTS          64
+
+typedef struct
+{
+    int         num_threads;
+    int         iterations;
+    uint64_t    stream_size;
+    const char *tmpdir;
+    const char *input[STRESS_MAX_INPUTS];  /* existing files read and dumped by every thread */
+    int         num_inputs;
+    char       *adts_path;                  /* the generated stream muxed by every thread */
+} stress_t;
+
+typedef struct
+{
+    stress_t *stress;
+    int       index;
+    char     *movie_path;
+    char     *dump_path;
+    uint32_t  num_samples;
+    uint64_t  num_bytes;
+    int       num_failed;
+} stress_thread_t;
+
+static int error_message( stress_thread_t *thread, const char *message, ... )
+{
+    eprintf( "[Error] thread %d: ", thread->index );
+    va_list args;
+    va_start( args, message );
+    vfprintf( stderr, message, args );
+    va_end( args );
+    return -1;
+}
+
+#define ERROR_MSG( ... ) error_message( thread, __VA_ARGS__ )
+
+static void display_version( void )
+{
+    eprintf( "\n"
+             "L-SMASH stress test rev%s  %s\n"
+             "Built on %s %s\n"
+             "Copyright (C) 2015 L-SMASH project\n",
+             LSMASH_REV, LSMASH_GIT_HASH, __DATE__, __TIME__ );
+}
+
+static void display_help( void )
+{
+    display_version();
+    eprintf( "\n"
+             "Usage: lsmash-stress [options]\n"
+             "  Every thread works on its own ROOTs at the same time: it muxes a generated ADTS stream into MP4,\n"
+             "  reads every sample of the result and dumps its box structure, and does the same for each input.\n"
+             "Options:\n"
+             "    --help                    Display help.\n"
+             "    --version                 Display version information.\n"
+             "    --threads <integer>       Set the number of threads.\n"
+             "                              If this option is not used, it defaults to 8.\n"
+             "    --iterations <integer>    Set how many times each thread repeats its work.\n"
+             "                              If this option is not used, it defaults to 4.\n"
+             "    --size <integer>          Set the size of the generated stream in KiB.\n"
+             "                              If this option is not used, it defaults to 1024.\n"
+             "    --input <string>          Add a file read and dumped by every thread.\n"
+             "    --tmpdir <string>         Set the directory for the generated files.\n"
+             "                              If this option is not used, it defaults to the current one.\n"
+             "The result is written into stdout as JSON.\n" );
+}
+
+/* xorshift32: the generated stream is identical on every run. */
+static uint32_t stress_random( uint32_t *state )
+{
+    uint32_t x = *state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    return *state = x;
+}
+
+/* Generate ADTS AAC-LC frames at 48kHz in stereo with random payloads. */
+static int generate_adts( stress_t *stress )
+{
+    FILE *fp = lsmash_fopen( stress->adts_path, "wb" );
+    if( !fp )
+        return -1;
+    uint8_t  frame[7 + 768];
+    uint32_t state   = 0x4C534D48;
+    uint64_t written = 0;
+    while( written < stress->stream_size )
+    {
+        uint32_t frame_length = 7 + 256 + stress_random( &state ) % 512;
+        uint32_t size = 0;
+        frame[size++] = 0xFF;
+        frame[size++] = 0xF1;
+        frame[size++] = (1 << 6) | (3 << 2);
+        frame[size++] = (2 << 6) | ((frame_length >> 11) & 0x03);
+        frame[size++] = (frame_length >> 3) & 0xFF;
+        frame[size++] = ((frame_length & 0x07) << 5) | 0x1F;
+        frame[size++] = 0xFC;
+        while( size < frame_length )
+            frame[size++] = stress_random( &state );
+        if( fwrite( frame, 1, size, fp ) != size )
+        {
+            fclose( fp );
+            return -1;
+        }
+        written += size;
+    }
+    fclose( fp );
+    return 0;
+}
+
+static int open_movie( lsmash_root_t **root, lsmash_file_parameters_t *param, const char *path, int dump )
+{
+    *root = lsmash_create_root();
+    if( !*root )
+        return -1;
+    if( lsmash_open_file( path, 1, param ) < 0 )
+        return -1;
+    if( dump )
+        param->mode |= LSMASH_FILE_MODE_DUMP;
+    lsmash_file_t *fh = lsmash_set_file( *root, param );
+    if( !fh )
+        return -1;
+    return lsmash_read_file( fh, param ) < 0 ? -1 : 0;
+}
+
+static void close_movie( lsmash_root_t *root, lsmash_file_parameters_t *param )
+{
+    lsmash_close_file( param );
+    lsmash_destroy_root( root );
+}
+
+static int stress_mux( stress_thread_t *thread )
+{
+    static lsmash_brand_type brands[2] = { ISOM_BRAND_TYPE_MP42, ISOM_BRAND_TYPE_ISOM };
+    importer_t *importer = lsmash_importer_open( thread->stress->adts_path, "auto" );
+    if( !importer )
+        return ERROR_MSG( "failed to open %s.\n", thread->stress->adts_path );
+    int                      ret     = -1;
+    lsmash_root_t           *root    = NULL;
+    lsmash_file_parameters_t param   = { 0 };
+    lsmash_summary_t        *summary = lsmash_duplicate_summary( importer, 1 );
+    if( !summary )
+    {
+        ERROR_MSG( "failed to get a summary.\n" );
+        goto cleanup;
+    }
+    uint32_t timescale = ((lsmash_audio_summary_t *)summary)->frequency;
+    root = lsmash_create_root();
+    if( !root || lsmash_open_file( thread->movie_path, 0, &param ) < 0 )
+    {
+        ERROR_MSG( "failed to open %s.\n", thread->movie_path );
+        goto cleanup;
+    }
+    param.major_brand = ISOM_BRAND_TYPE_MP42;
+    param.brands      = brands;
+    param.brand_count = 2;
+    lsmash_movie_parameters_t movie_param;
+    lsmash_initialize_movie_parameters( &movie_param );
+    movie_param.timescale = timescale;
+    if( !lsmash_set_file( root, &param )
+     || lsmash_set_movie_parameters( root, &movie_param ) )
+    {
+        ERROR_MSG( "failed to set up a movie.\n" );
+        goto cleanup;
+    }
+    uint32_t track_ID = lsmash_create_track( root, ISOM_MEDIA_HANDLER_TYPE_AUDIO_TRACK );
+    lsmash_track_parameters_t track_param;
+    lsmash_initialize_track_parameters( &track_param );
+    track_param.mode     = ISOM_TRACK_ENABLED | ISOM_TRACK_IN_MOVIE | ISOM_TRACK_IN_PREVIEW;
+    track_param.track_ID = track_ID;
+    lsmash_media_parameters_t media_param;
+    lsmash_initialize_media_parameters( &media_param );
+    media_param.timescale = timescale;
+    uint32_t sample_entry = 0;
+    if( !track_ID
+     || lsmash_set_track_parameters( root, track_ID, &track_param )
+     || lsmash_set_media_parameters( root, track_ID, &media_param )
+     || !(sample_entry = lsmash_add_sample_entry( root, track_ID, summary )) )
+    {
+        ERROR_MSG( "failed to set up a track.\n" );
+        goto cleanup;
+    }
+    thread->num_samples = 0;
+    thread->num_bytes   = 0;
+    while( 1 )
+    {
+        lsmash_sample_t *sample;
+        int err = lsmash_importer_get_access_unit( importer, 1, &sample );
+        if( err == 2 || (err == 0 && !sample) )
+        {
+            lsmash_delete_sample( sample );
+            break;
+        }
+        if( err < 0 || err == 1 )
+        {
+            lsmash_delete_sample( sample );
+            ERROR_MSG( "failed to get an access unit.\n" );
+            goto cleanup;
+        }
+        thread->num_samples += 1;
+        thread->num_bytes   += sample->length;
+        sample->index = sample_entry;
+        if( lsmash_append_sample( root, track_ID, sample ) )
+        {
+            lsmash_delete_sample( sample );
+            ERROR_MSG( "failed to append a sample.\n" );
+            goto cleanup;
+        }
+    }
+    lsmash_adhoc_remux_t moov_to_front = { .func = NULL, .buffer_size = 1024 * 1024, .param = NULL };
+    if( lsmash_flush_pooled_samples( root, track_ID, lsmash_importer_get_last_delta( importer, 1 ) )
+     || lsmash_finish_movie( root, &moov_to_front ) )
+    {
+        ERROR_MSG( "failed to finish a movie.\n" );
+        goto cleanup;
+    }
+    ret = 0;
+cleanup:
+    lsmash_close_file( &param );
+    lsmash_destroy_root( root );
+    lsmash_cleanup_summary( summary );
+    lsmash_importer_close( importer );
+    return ret;
+}
+
+/* Read every sample of every track, and return the total size of them. */
+static int stress_read( stress_thread_t *thread, const char *path, uint32_t *num_samples, uint64_t *num_bytes )
+{
+    lsmash_root_t           *root;
+    lsmash_file_parameters_t param = { 0 };
+    int ret = open_movie( &root, &param, path, 0 );
+    if( ret < 0 )
+        ERROR_MSG( "failed to read %s.\n", path );
+    *num_samples = 0;
+    *num_bytes   = 0;
+    lsmash_movie_parameters_t movie_param;
+    lsmash_initialize_movie_parameters( &movie_param );
+    if( ret == 0 && lsmash_get_movie_parameters( root, &movie_param ) )
+        ret = ERROR_MSG( "failed to get movie parameters of %s.\n", path );
+    for( uint32_t i = 1; ret == 0 && i <= movie_param.number_of_tracks; i++ )
+    {
+        uint32_t track_ID = lsmash_get_track_ID( root, i );
+        if( !track_ID || lsmash_construct_timeline( root, track_ID ) )
+        {
+            ret = ERROR_MSG( "failed to construct a timeline of %s.\n", path );
+            break;
+        }
+        uint32_t sample_count = lsmash_get_sample_count_in_media_timeline( root, track_ID );
+        for( uint32_t j = 1; j <= sample_count; j++ )
+        {
+            lsmash_sample_t *sample = lsmash_get_sample_from_media_timeline( root, track_ID, j );
+            if( !sample )
+            {
+                ret = ERROR_MSG( "failed to get sample %"PRIu32" of %s.\n", j, path );
+                break;
+            }
+            *num_samples += 1;
+            *num_bytes   += sample->length;
+            lsmash_delete_sample( sample );
+        }
+    }
+    close_movie( root, &param );
+    return ret;
+}
+
+static int stress_dump( stress_thread_t *thread, const char *path )
+{
+    lsmash_root_t           *root;
+    lsmash_file_parameters_t param = { 0 };
+    int ret = open_movie( &root, &param, path, 1 );
+    if( ret < 0 )
+        ERROR_MSG( "failed to read %s.\n", path );
+    else if( lsmash_print_movie( root, thread->dump_path ) < 0 )
+        ret = ERROR_MSG( "failed to dump %s.\n", path );
+    close_movie( root, &param );
+    return ret;
+}
+
+static void stress_iteration( stress_thread_t *thread )
+{
+    uint32_t num_samples;
+    uint64_t num_bytes;
+    if( stress_mux( thread ) < 0 )
+        ++ thread->num_failed;
+    else if( stress_read( thread, thread->movie_path, &num_samples, &num_bytes ) < 0 )
+        ++ thread->num_failed;
+    else if( num_samples != thread->num_samples || num_bytes != thread->num_bytes )
+    {
+        ERROR_MSG( "read %"PRIu32" samples in %"PRIu64" bytes while muxed %"PRIu32" samples in %"PRIu64" bytes.\n",
+                   num_samples, num_bytes, thread->num_samples, thread->num_bytes );
+        ++ thread->num_failed;
+    }
+    else if( stress_dump( thread, thread->movie_path ) < 0 )
+        ++ thread->num_failed;
+    for( int i = 0; i < thread->stress->num_inputs; i++ )
+        if( stress_read( thread, thread->stress->input[i], &num_samples, &num_bytes ) < 0
+         || stress_dump( thread, thread->stress->input[i] ) < 0 )
+            ++ thread->num_failed;
+}
+
+#ifdef _WIN32
+static DWORD WINAPI stress_thread_main( LPVOID arg )
+#else
+static void *stress_thread_main( void *arg )
+#endif
+{
+    stress_thread_t *thread = (stress_thread_t *)arg;
+    for( int i = 0; i < thread->stress->iterations; i++ )
+        stress_iteration( thread );
+    return 0;
+}
+
+/* 'name' holds the index of the thread as '%d'. */
+static char *make_path( const char *tmpdir, const char *name, int index )
+{
+    size_t length = strlen( tmpdir ) + strlen( name ) + 16;
+    char  *path   = lsmash_malloc( length );
+    if( path )
+    {
+        int n = snprintf( path, length, "%s/", tmpdir );
+        snprintf( path + n, length - n, name, index );
+    }
+    return path;
+}
+
+static int parse_cli_option( int argc, char *argv[], stress_t *stress )
+{
+    for( int i = 1; i < argc; i++ )
+    {
+        if( !strcasecmp( argv[i], "--help" ) )
+        {
+            display_help();
+            exit( 0 );
+        }
+        else if( !strcasecmp( argv[i], "--version" ) )
+        {
+            display_version();
+            exit( 0 );
+        }
+        else if( i + 1 == argc )
+        {
+            eprintf( "[Error] %s requires an argument or is unknown.\n", argv[i] );
+            return -1;
+        }
+        else if( !strcasecmp( argv[i], "--threads" ) )
+        {
+            stress->num_threads = atoi( argv[++i] );
+            if( stress->num_threads <= 0 || stress->num_threads > STRESS_MAX_THREADS )
+            {
+                eprintf( "[Error] --threads requires an integer from 1 to %d.\n", STRESS_MAX_THREADS );
+                return -1;
+            }
+        }
+        else if( !strcasecmp( argv[i], "--iterations" ) )
+        {
+            stress->iterations = atoi( argv[++i] );
+            if( stress->iterations <= 0 )
+            {
+                eprintf( "[Error] --iterations requires a positive integer.\n" );
+                return -1;
+            }
+        }
+        else if( !strcasecmp( argv[i], "--size" ) )
+        {
+            int size = atoi( argv[++i] );
+            if( size <= 0 )
+            {
+                eprintf( "[Error] --size requires a positive integer.\n" );
+                return -1;
+            }
+            stress->stream_size = (uint64_t)size * 1024;
+        }
+        else if( !strcasecmp( argv[i], "--input" ) )
+        {
+            if( stress->num_inputs == STRESS_MAX_INPUTS )
+            {
+                eprintf( "[Error] exceed the maximum number of inputs.\n" );
+                return -1;
+            }
+            stress->input[ stress->num_inputs++ ] = argv[++i];
+        }
+        else if( !strcasecmp( argv[i], "--tmpdir" ) )
+            stress->tmpdir = argv[++i];
+        else
+        {
+            eprintf( "[Error] unkown option found: %s\n", argv[i] );
+            return -1;
+        }
+    }
+    return 0;
+}
+
+int main( int argc, char *argv[] )
+{
+    lsmash_get_mainargs( &argc, &argv );
+    stress_t stress =
+    {
+        .num_threads = STRESS_DEFAULT_NUM_THREADS,
+        .iterations  = STRESS_DEFAULT_ITERATIONS,
+        .stream_size = STRESS_DEFAULT_STREAM_SIZE,
+        .tmpdir      = ".",
+        .num_inputs  = 0,
+        .adts_path   = NULL
+    };
+    if( parse_cli_option( argc, argv, &stress ) < 0 )
+        return -1;
+    stress_thread_t thread[STRESS_MAX_THREADS] = { { 0 } };
+#ifdef _WIN32
+    HANDLE    handle[STRESS_MAX_THREADS];
+#else
+    pthread_t handle[STRESS_MAX_THREADS];
+#endif
+    int num_started = 0;
+    int num_failed  = 0;
+    stress.adts_path = make_path( stress.tmpdir, "lsmash-stress-adts.aac", 0 );
+    if( !stress.adts_path || generate_adts( &stress ) < 0 )
+    {
+        eprintf( "[Error] failed to generate an ADTS stream.\n" );
+        num_failed = 1;
+        goto cleanup;
+    }
+    for( int i = 0; i < stress.num_threads; i++ )
+    {
+        thread[i].stress     = &stress;
+        thread[i].index      = i;
+        thread[i].movie_path = make_path( stress.tmpdir, "lsmash-stress-movie-%d.mp4", i );
+        thread[i].dump_path  = make_path( stress.tmpdir, "lsmash-stress-dump-%d.txt", i );
+        if( !thread[i].movie_path || !thread[i].dump_path )
+        {
+            eprintf( "[Error] failed to allocate a path.\n" );
+            num_failed = 1;
+            goto cleanup;
+        }
+    }
+    /* Start all threads at once so that the first uses of the lazily built tables may collide. */
+    double start = lsmash_get_elapsed_seconds();
+    for( ; num_started < stress.num_threads; num_started++ )
+    {
+#ifdef _WIN32
+        handle[num_started] = CreateThread( NULL, 0, stress_thread_main, &thread[num_started], 0, NULL );
+        if( !handle[num_started] )
+            break;
+#else
+        if( pthread_create( &handle[num_started], NULL, stress_thread_main, &thread[num_started] ) )
+            break;
+#endif
+    }
+    if( num_started < stress.num_threads )
+    {
+        eprintf( "[Error] failed to start a thread.\n" );
+        num_failed = 1;
+    }
+    for( int i = 0; i < num_started; i++ )
+    {
+#ifdef _WIN32
+        WaitForSingleObject( handle[i], INFINITE );
+        CloseHandle( handle[i] );
+#else
+        pthread_join( handle[i], NULL );
+#endif
+        num_failed += thread[i].num_failed;
+    }
+    /* Every thread muxed the same stream. */
+    for( int i = 1; i < num_started; i++ )
+        if( thread[i].num_samples != thread[0].num_samples || thread[i].num_bytes != thread[0].num_bytes )
+        {
+            eprintf( "[Error] thread %d muxed a different number of samples or bytes from thread 0.\n", i );
+            ++num_failed;
+        }
+    printf( "{\"version\":\"rev%s %s\",\"threads\":%d,\"iterations\":%d,\"inputs\":%d,"
+            "\"samples\":%"PRIu32",\"bytes\":%"PRIu64",\"failed\":%d,\"seconds\":%.6f}\n",
+            LSMASH_REV, LSMASH_GIT_HASH, num_started, stress.iterations, stress.num_inputs,
+            thread[0].num_samples, thread[0].num_bytes, num_failed, lsmash_get_elapsed_seconds() - start );
+cleanup:
+    for( int i = 0; i < stress.num_threads; i++ )
+    {
+        if( thread[i].movie_path )
+            remove( thread[i].movie_path );
+        if( thread[i].dump_path )
+            remove( thread[i].dump_path );
+        lsmash_free( thread[i].movie_path );
+        lsmash_free( thread[i].dump_path );
+    }
+    if( stress.adts_path )
+        remove( stress.adts_path );
+    lsmash_free( stress.adts_path );
+    return num_failed ? -1 : 0;
+}
@@ -106,6 +106,7 @@ typedef struct
     uint32_t skip_duration;
     uint32_t empty_delay;
     int      dts_compression;
+    int      in_place;
 } opt_t;
 
 static void cleanup_root( root_t *h )
@@ -269,7 +270,7 @@ static int get_summaries( root_t *input, track_t *track )
     return 0;
 }
 
-static int get_movie( root_t *input, char *input_name )
+static int get_movie( root_t *input, char *input_name, int in_place )
 {
     if( !strcmp( input_name, "-" ) )
         return ERROR_MSG( "Standard input not supported.\n" );
@@ -277,7 +278,7 @@ static int get_movie( root_t *input, char *input_name )
     if( !input->root )
         return ERROR_MSG( "failed to create a ROOT for an input file.\n" );
     file_t *in_file = &input->file;
-    if( lsmash_open_file( input_name, 1, &in_file->param ) < 0 )
+    if( lsmash_open_file( input_name, in_place ? 2 : 1, &in_file->param ) < 0 )
         return ERROR_MSG( "failed to open an input file.\n" );
     in_file->fh = lsmash_set_file( input->root, &in_file->param );
     if( !in_file->fh )
@@ -350,7 +351,9 @@ static int get_movie( root_t *input, char *input_name )
         track[i].active                = 1;
         track[i].current_sample_number = 1;
     }
-    lsmash_destroy_children( lsmash_file_as_box( in_file->fh ) );
+    /* The boxes are written back into the file in place. */
+    if( !in_place )
+        lsmash_destroy_children( lsmash_file_as_box( in_file->fh ) );
     return 0;
 }
 
@@ -841,6 +844,63 @@ static int edit_media_timeline( root_t *input, timecode_t *timecode, opt_t *opt
     return 0;
 }
 
+static int edit_timeline_map( lsmash_root_t *root, uint32_t track_ID, timecode_t *timecode, opt_t *opt )
+{
+    uint32_t movie_timescale = lsmash_get_movie_timescale( root );
+    uint32_t media_timescale = lsmash_get_media_timescale( root, track_ID );
+    uint64_t empty_delay     = timecode->empty_delay + (uint64_t)(opt->empty_delay * (1e-3 * media_timescale) + 0.5);
+    uint64_t duration        = timecode->duration + empty_delay;
+    if( lsmash_delete_explicit_timeline_map( root, track_ID ) )
+        return ERROR_MSG( "Failed to delete explicit timeline maps.\n" );
+    if( timecode->empty_delay )
+    {
+        lsmash_edit_t empty_edit;
+        empty_edit.duration   = ((double)timecode->empty_delay / media_timescale) * movie_timescale;
+        empty_edit.start_time = ISOM_EDIT_MODE_EMPTY;
+        empty_edit.rate       = ISOM_EDIT_MODE_NORMAL;
+        if( lsmash_create_explicit_timeline_map( root, track_ID, empty_edit ) )
+            return ERROR_MSG( "Failed to create a empty duration.\n" );
+        duration  = ((double)duration / media_timescale) * movie_timescale;
+        duration -= empty_edit.duration;
+    }
+    else
+        duration  = ((double)duration / media_timescale) * movie_timescale;
+    lsmash_edit_t edit;
+    edit.duration   = duration;
+    edit.start_time = timecode->composition_delay + (uint64_t)(opt->skip_duration * (1e-3 * media_timescale) + 0.5);
+    edit.rate       = ISOM_EDIT_MODE_NORMAL;
+    if( lsmash_create_explicit_timeline_map( root, track_ID, edit ) )
+        return ERROR_MSG( "Failed to create a explicit timeline map.\n" );
+    return 0;
+}
+
+/* Apply the edits to the movie of the input file and write it back into the file.
+ * The media data is not touched at all. */
+static int edit_movie_in_place( root_t *input, timecode_t *timecode, opt_t *opt, int edit_map )
+{
+    track_t *track = &input->file.movie.track[ opt->track_number - 1 ];
+    if( !track->active )
+        return ERROR_MSG( "Failed to get the track to edit.\n" );
+    if( edit_media_timeline( input, timecode, opt ) )
+        return ERROR_MSG( "Failed to edit timeline.\n" );
+    if( track->media_param.timescale != lsmash_get_media_timescale( input->root, track->track_ID ) )
+    {
+        /* Change only the media timescale. */
+        lsmash_media_parameters_t media_param = track->media_param;
+        media_param.media_handler_name = NULL;
+        media_param.data_handler_name  = NULL;
+        media_param.roll_grouping      = 0;
+        media_param.rap_grouping       = 0;
+        if( lsmash_set_media_parameters( input->root, track->track_ID, &media_param ) )
+            return ERROR_MSG( "Failed to set the media timescale.\n" );
+    }
+    if( edit_map && edit_timeline_map( input->root, track->track_ID, timecode, opt ) )
+        return ERROR_MSG( "Failed to edit timeline map.\n" );
+    if( lsmash_write_movie_in_place( input->root ) )
+        return ERROR_MSG( "Failed to write the movie in place.\n" );
+    return 0;
+}
+
 static int check_white_brand( lsmash_brand_type brand )
 {
     static const lsmash_brand_type brand_white_list[] =
@@ -898,6 +958,7 @@ static void display_help( void )
     display_version();
     eprintf( "\n"
              "Usage: timelineeditor [options] input output\n"
+             "       timelineeditor [options] --in-place input\n"
              "  options:\n"
              "    --help                       Display help\n"
              "    --version                    Display version information\n"
@@ -908,7 +969,9 @@ static void display_help( void )
              "    --skip            <integer>  Skip start of media presentation in milliseconds\n"
              "    --delay           <integer>  Insert blank clip before actual media presentation in milliseconds\n"
              "    --dts-compression            Eliminate composition delay with DTS hack\n"
-             "                                 Multiply media timescale and timebase automatically\n" );
+             "                                 Multiply media timescale and timebase automatically\n"
+             "    --in-place                   Rewrite only the movie header of the input file\n"
+             "                                 Media data is neither copied nor moved\n" );
 }
 
 int main( int argc, char *argv[] )
@@ -937,11 +1000,15 @@ int main( int argc, char *argv[] )
     root_t     input    = { 0 };
     timecode_t timecode = { 0 };
     movie_io_t io = { &output, &input, &timecode };
-    opt_t opt = { 1, 0, 0, 0, 0, 0 };
+    opt_t opt = { 1, 0, 0, 0, 0, 0, 0 };
     /* Parse options. */
     lsmash_get_mainargs( &argc, &argv );
+    for( int i = 1; i < argc; i++ )
+        if( !strcasecmp( argv[i], "--in-place" ) )
+            opt.in_place = 1;
+    int num_files = opt.in_place ? 1 : 2;
     int argn = 1;
-    while( argn < argc - 2 )
+    while( argn < argc - num_files )
     {
         if( !strcasecmp( argv[argn], "--track" ) )
         {
@@ -990,17 +1057,28 @@ int main( int argc, char *argv[] )
             opt.dts_compression = 1;
             ++argn;
         }
+        else if( !strcasecmp( argv[argn], "--in-place" ) )
+            ++argn;
         else
             return TIMELINEEDITOR_ERR( "Invalid option.\n" );
     }
-    if( argn > argc - 2 )
+    if( argn > argc - num_files )
         return TIMELINEEDITOR_ERR( "Invalid arguments.\n" );
     /* Get input movies. */
-    if( get_movie( &input, argv[argn++] ) )
+    if( get_movie( &input, argv[argn++], opt.in_place ) )
         return TIMELINEEDITOR_ERR( "Failed to get input movie.\n" );
     movie_t *in_movie = &input.file.movie;
     if( opt.track_number && (opt.track_number > in_movie->num_tracks) )
         return TIMELINEEDITOR_ERR( "Invalid track number.\n" );
+    if( opt.in_place )
+    {
+        if( edit_movie_in_place( &input, &timecode, &opt, argc > 3 ) )
+            return TIMELINEEDITOR_ERR( "Failed to edit the movie in place.\n" );
+        cleanup_root( io.input );
+        cleanup_timecode( io.timecode );
+        eprintf( "Timeline editing completed!                                                    \n" );
+        return 0;
+    }
     /* Create output movie. */
     file_t *out_file = &output.file;
     output.root = lsmash_create_root();
@@ -1190,36 +1268,8 @@ int main( int argc, char *argv[] )
         if( lsmash_copy_timeline_map( output.root, out_movie->track[i].track_ID, input.root, in_movie->track[i].track_ID ) )
             return TIMELINEEDITOR_ERR( "Failed to copy a timeline map.\n" );
     /* Edit timeline map. */
-    if( argc > 3 )
-    {
-        track_t *out_track       = &out_movie->track[ opt.track_number - 1 ];
-        uint32_t track_ID        = out_track->track_ID;
-        uint32_t movie_timescale = lsmash_get_movie_timescale( output.root );
-        uint32_t media_timescale = lsmash_get_media_timescale( output.root, track_ID );
-        uint64_t empty_delay     = timecode.empty_delay + (uint64_t)(opt.empty_delay * (1e-3 * media_timescale) + 0.5);
-        uint64_t duration        = timecode.duration + empty_delay;
-        if( lsmash_delete_explicit_timeline_map( output.root, track_ID ) )
-            return TIMELINEEDITOR_ERR( "Failed to delete explicit timeline maps.\n" );
-        if( timecode.empty_delay )
-        {
-            lsmash_edit_t empty_edit;
-            empty_edit.duration   = ((double)timecode.empty_delay / media_timescale) * movie_timescale;
-            empty_edit.start_time = ISOM_EDIT_MODE_EMPTY;
-            empty_edit.rate       = ISOM_EDIT_MODE_NORMAL;
-            if( lsmash_create_explicit_timeline_map( output.root, track_ID, empty_edit ) )
-                return TIMELINEEDITOR_ERR( "Failed to create a empty duration.\n" );
-            duration  = ((double)duration / media_timescale) * movie_timescale;
-            duration -= empty_edit.duration;
-        }
-        else
-            duration  = ((double)duration / media_timescale) * movie_timescale;
-        lsmash_edit_t edit;
-        edit.duration   = duration;
-        edit.start_time = timecode.composition_delay + (uint64_t)(opt.skip_duration * (1e-3 * media_timescale) + 0.5);
-        edit.rate       = ISOM_EDIT_MODE_NORMAL;
-        if( lsmash_create_explicit_timeline_map( output.root, track_ID, edit ) )
-            return TIMELINEEDITOR_ERR( "Failed to create a explicit timeline map.\n" );
-    }
+    if( argc > 3 && edit_timeline_map( output.root, out_movie->track[ opt.track_number - 1 ].track_ID, &timecode, &opt ) )
+        return TIMELINEEDITOR_ERR( "Failed to edit timeline map.\n" );
     /* Finish muxing. */
     lsmash_adhoc_remux_t moov_to_front;
     moov_to_front.func = moov_to_front_callback;
@@ -27,6 +27,7 @@
 #include <inttypes.h>
 
 #include "core/box.h"
+#include "core/print.h"
 
 static const char *bit_stream_mode[] =
     {
@@ -196,10 +197,10 @@ int ac3_construct_specific_parameters( lsmash_codec_specific_t *dst, lsmash_code
         return LSMASH_ERR_INVALID_DATA;
     param->fscod      = (data[0] >> 6) & 0x03;                                  /* XXxx xxxx xxxx xxxx xxxx xxxx */
     param->bsid       = (data[0] >> 1) & 0x1F;                                  /* xxXX XXXx xxxx xxxx xxxx xxxx */
-    param->bsmod      = ((data[0] & 0x01) << 2) | ((data[2] >> 6) & 0x03);      /* xxxx xxxX XXxx xxxx xxxx xxxx */
+    param->bsmod      = ((data[0] & 0x01) << 2) | ((data[1] >> 6) & 0x03);      /* xxxx xxxX XXxx xxxx xxxx xxxx */
     param->acmod      = (data[1] >> 3) & 0x07;                                  /* xxxx xxxx xxXX Xxxx xxxx xxxx */
     param->lfeon      = (data[1] >> 2) & 0x01;                                  /* xxxx xxxx xxxx xXxx xxxx xxxx */
-    param->frmsizecod = ((data[1] & 0x03) << 3) | ((data[3] >> 5) & 0x07);      /* xxxx xxxx xxxx xxXX XXXx xxxx */
+    param->frmsizecod = ((data[1] & 0x03) << 3) | ((data[2] >> 5) & 0x07);      /* xxxx xxxx xxxx xxXX XXXx xxxx */
     param->frmsizecod <<= 1;
     return 0;
 }
@@ -240,6 +241,21 @@ int ac3_print_codec_specific( FILE *fp, lsmash_file_t *file, isom_box_t *box, in
     return 0;
 }
 
+void ac3_json_codec_specific( struct print_stream_tag *stream, lsmash_file_t *file, isom_box_t *box )
+{
+    assert( stream && file && box && (box->manager & LSMASH_BINARY_CODED_BOX) );
+    if( box->size < AC3_SPECIFIC_BOX_LENGTH )
+        return;
+    uint8_t *data = box->binary;
+    isom_skip_box_common( &data );
+    isom_json_field_uint( stream, "fscod", (data[0] >> 6) & 0x03 );
+    isom_json_field_uint( stream, "bsid", (data[0] >> 1) & 0x1F );
+    isom_json_field_uint( stream, "bsmod", ((data[0] & 0x01) << 2) | ((data[1] >> 6) & 0x03) );
+    isom_json_field_uint( stream, "acmod", (data[1] >> 3) & 0x07 );
+    isom_json_field_uint( stream, "lfeon", (data[1] >> 2) & 0x01 );
+    isom_json_field_uint( stream, "bit_rate_code", ((data[1] & 0x03) << 3) | ((data[2] >> 5) & 0x07) );
+}
+
 #undef AC3_SPECIFIC_BOX_LENGTH
 
 /***************************************************************************
@@ -738,4 +754,39 @@ int eac3_print_codec_specific( FILE *fp, lsmash_file_t *file, isom_box_t *box, i
     return 0;
 }
 
+void eac3_json_codec_specific( struct print_stream_tag *stream, lsmash_file_t *file, isom_box_t *box )
+{
+    assert( stream && file && box && (box->manager & LSMASH_BINARY_CODED_BOX) );
+    if( box->size < EAC3_SPECIFIC_BOX_MIN_LENGTH )
+        return;
+    uint8_t *data = box->binary;
+    isom_skip_box_common( &data );
+    isom_json_field_uint( stream, "data_rate", (data[0] << 5) | ((data[1] >> 3) & 0x1F) );
+    uint8_t num_ind_sub = data[1] & 0x07;
+    isom_json_field_uint( stream, "num_ind_sub", num_ind_sub );
+    data += 2;
+    isom_json_key( stream, "independent_substreams" );
+    isom_json_begin( stream, '[' );
+    for( int i = 0; i <= num_ind_sub; i++ )
+    {
+        uint8_t num_dep_sub = (data[2] >> 1) & 0x0F;
+        isom_json_separate( stream );
+        isom_json_begin( stream, '{' );
+        isom_json_field_uint( stream, "fscod", (data[0] >> 6) & 0x03 );
+        isom_json_field_uint( stream, "bsid", (data[0] >> 1) & 0x1F );
+        isom_json_field_uint( stream, "bsmod", ((data[0] & 0x01) << 4) | ((data[1] >> 4) & 0x0F) );
+        isom_json_field_uint( stream, "acmod", (data[1] >> 1) & 0x07 );
+        isom_json_field_uint( stream, "lfeon", data[1] & 0x01 );
+        isom_json_field_uint( stream, "num_dep_sub", num_dep_sub );
+        data += 3;
+        if( num_dep_sub > 0 )
+        {
+            isom_json_field_uint( stream, "chan_loc", ((data[-1] & 0x01) << 8) | data[0] );
+            data += 1;
+        }
+        isom_json_end( stream, '}' );
+    }
+    isom_json_end( stream, ']' );
+}
+
 #undef EAC3_SPECIFIC_BOX_MIN_LENGTH
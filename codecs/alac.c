@@ -27,6 +27,7 @@
 #include <inttypes.h>
 
 #include "core/box.h"
+#include "core/print.h"
 
 #define ALAC_SPECIFIC_BOX_LENGTH 36
 
@@ -107,4 +108,27 @@ int alac_print_codec_specific( FILE *fp, lsmash_file_t *file, isom_box_t *box, i
     return 0;
 }
 
+void alac_json_codec_specific( struct print_stream_tag *stream, lsmash_file_t *file, isom_box_t *box )
+{
+    assert( stream && file && box && (box->manager & LSMASH_BINARY_CODED_BOX) );
+    if( box->size < ALAC_SPECIFIC_BOX_LENGTH )
+        return;
+    uint8_t *data = box->binary;
+    isom_skip_box_common( &data );
+    isom_json_field_uint( stream, "version",           LSMASH_GET_BYTE( &data[0] ) );
+    isom_json_field_uint( stream, "flags",             LSMASH_GET_BE24( &data[1] ) );
+    data += 4;
+    isom_json_field_uint( stream, "frameLength",       LSMASH_GET_BE32( &data[0] ) );
+    isom_json_field_uint( stream, "compatibleVersion", LSMASH_GET_BYTE( &data[4] ) );
+    isom_json_field_uint( stream, "bitDepth",          LSMASH_GET_BYTE( &data[5] ) );
+    isom_json_field_uint( stream, "pb",                LSMASH_GET_BYTE( &data[6] ) );
+    isom_json_field_uint( stream, "mb",                LSMASH_GET_BYTE( &data[7] ) );
+    isom_json_field_uint( stream, "kb",                LSMASH_GET_BYTE( &data[8] ) );
+    isom_json_field_uint( stream, "numChannels",       LSMASH_GET_BYTE( &data[9] ) );
+    isom_json_field_uint( stream, "maxRun",            LSMASH_GET_BE16( &data[10] ) );
+    isom_json_field_uint( stream, "maxFrameBytes",     LSMASH_GET_BE32( &data[12] ) );
+    isom_json_field_uint( stream, "avgBitrate",        LSMASH_GET_BE32( &data[16] ) );
+    isom_json_field_uint( stream, "sampleRate",        LSMASH_GET_BE32( &data[20] ) );
+}
+
 #undef ALAC_SPECIFIC_BOX_LENGTH
@@ -27,6 +27,7 @@
 #include <inttypes.h>
 
 #include "core/box.h"
+#include "core/print.h"
 
 /***************************************************************************
     ETSI TS 102 114 V1.2.1 (2002-12)
@@ -44,6 +45,9 @@
 #define DTS_MAX_STREAM_CONSTRUCTION 21
 #define DTS_SPECIFIC_BOX_MIN_LENGTH 28
 
+#define DTS_LAYOUT_CACHE_CORE               0x01
+#define DTS_LAYOUT_CACHE_EXSS( exss_index ) (0x02 << (exss_index))
+
 typedef enum
 {
     DTS_SYNCWORD_CORE           = 0x7FFE8001,
@@ -220,33 +224,21 @@ lsmash_codec_type_t lsmash_dts_get_codingname( lsmash_dts_specific_parameters_t
     assert( param->StreamConstruction <= DTS_MAX_STREAM_CONSTRUCTION );
     if( param->MultiAssetFlag )
         return ISOM_CODEC_TYPE_DTSH_AUDIO;  /* Multiple asset streams shall use the 'dtsh' coding_name. */
-    static lsmash_codec_type_t codingname_table[DTS_MAX_STREAM_CONSTRUCTION + 1] = { LSMASH_CODEC_TYPE_INITIALIZER };
-    if( lsmash_check_codec_type_identical( codingname_table[0], LSMASH_CODEC_TYPE_UNSPECIFIED ) )
-    {
-        int i = 0;
-        codingname_table[i++] = ISOM_CODEC_TYPE_DTSH_AUDIO; /* Undefined stream types shall be set to 0 and the codingname shall default to 'dtsh'. */
-        codingname_table[i++] = ISOM_CODEC_TYPE_DTSC_AUDIO;
-        codingname_table[i++] = ISOM_CODEC_TYPE_DTSC_AUDIO;
-        codingname_table[i++] = ISOM_CODEC_TYPE_DTSH_AUDIO;
-        codingname_table[i++] = ISOM_CODEC_TYPE_DTSC_AUDIO;
-        codingname_table[i++] = ISOM_CODEC_TYPE_DTSH_AUDIO;
-        codingname_table[i++] = ISOM_CODEC_TYPE_DTSH_AUDIO;
-        codingname_table[i++] = ISOM_CODEC_TYPE_DTSH_AUDIO;
-        codingname_table[i++] = ISOM_CODEC_TYPE_DTSH_AUDIO;
-        codingname_table[i++] = ISOM_CODEC_TYPE_DTSH_AUDIO;
-        codingname_table[i++] = ISOM_CODEC_TYPE_DTSH_AUDIO;
-        codingname_table[i++] = ISOM_CODEC_TYPE_DTSH_AUDIO;
-        codingname_table[i++] = ISOM_CODEC_TYPE_DTSH_AUDIO;
-        codingname_table[i++] = ISOM_CODEC_TYPE_DTSH_AUDIO;
-        codingname_table[i++] = ISOM_CODEC_TYPE_DTSL_AUDIO;
-        codingname_table[i++] = ISOM_CODEC_TYPE_DTSL_AUDIO;
-        codingname_table[i++] = ISOM_CODEC_TYPE_DTSL_AUDIO;
-        codingname_table[i++] = ISOM_CODEC_TYPE_DTSL_AUDIO;
-        codingname_table[i++] = ISOM_CODEC_TYPE_DTSE_AUDIO;
-        codingname_table[i++] = ISOM_CODEC_TYPE_DTSH_AUDIO;
-        codingname_table[i++] = ISOM_CODEC_TYPE_DTSH_AUDIO;
-        codingname_table[i++] = ISOM_CODEC_TYPE_DTSL_AUDIO;
-    }
+#define DTSC LSMASH_ISO_BOX_TYPE_INITIALIZER( LSMASH_4CC( 'd', 't', 's', 'c' ) )
+#define DTSH LSMASH_ISO_BOX_TYPE_INITIALIZER( LSMASH_4CC( 'd', 't', 's', 'h' ) )
+#define DTSL LSMASH_ISO_BOX_TYPE_INITIALIZER( LSMASH_4CC( 'd', 't', 's', 'l' ) )
+#define DTSE LSMASH_ISO_BOX_TYPE_INITIALIZER( LSMASH_4CC( 'd', 't', 's', 'e' ) )
+    static const lsmash_codec_type_t codingname_table[DTS_MAX_STREAM_CONSTRUCTION + 1] =
+        {
+            DTSH,   /* Undefined stream types shall be set to 0 and the codingname shall default to 'dtsh'. */
+            DTSC, DTSC, DTSH, DTSC, DTSH, DTSH, DTSH, DTSH, DTSH, DTSH,
+            DTSH, DTSH, DTSH, DTSL, DTSL, DTSL, DTSL, DTSE, DTSH, DTSH,
+            DTSL
+        };
+#undef DTSC
+#undef DTSH
+#undef DTSL
+#undef DTSE
     return codingname_table[ param->StreamConstruction ];
 }
 
@@ -1092,32 +1084,95 @@ static int dts_parse_exss_core( dts_info_t *info, uint64_t *bits_pos, dts_audio_
     return bits->bs->error ? LSMASH_ERR_NAMELESS : 0;
 }
 
+/* Get the fields deciding the layout of the core frame from its header without consuming the stream.
+ * FSIZE and the flags which may vary frame by frame (DYNF, TIMEF and AUXF) are excluded. */
+static uint64_t dts_get_core_signature( lsmash_bs_t *bs )
+{
+    uint64_t header = lsmash_bs_show_be64( bs, 4 );                 /* FTYPE ... HFLAG and the following 8 bits */
+    int crc_present_flag = (header >> 57) & 0x1;                    /* CPF */
+    uint32_t pcmr_pos = 63 + crc_present_flag * 16;
+    uint64_t pcmr = (lsmash_bs_show_be16( bs, 4 + pcmr_pos / 8 ) >> (13 - pcmr_pos % 8)) & 0x7;
+    header >>= 8;
+    header &= ~((UINT64_C(0x3FFF) << 28)                            /* FSIZE */
+              | (UINT64_C(0x7)    <<  9));                          /* DYNF, TIMEF and AUXF */
+    return (header << 3) | pcmr;
+}
+
 int dts_parse_core_substream( dts_info_t *info )
 {
     lsmash_bits_t *bits = info->bits;
-    uint64_t bits_pos = 0;
-    int err;
-    if( DTS_SYNCWORD_CORE != dts_bits_get( bits, 32, &bits_pos ) )
-    {
-        err = LSMASH_ERR_INVALID_DATA;
-        goto parse_fail;
-    }
     /* By default the core substream data, if present, has the nuBcCoreExtSSIndex = 0 and the nuBcCoreAssetIndex = 0. */
     dts_extension_info_t *exss = &info->exss[0];
-    if( (err = dts_parse_core( info, &bits_pos, &exss->asset[0].core )) < 0 )
-        goto parse_fail;
+    dts_core_info_t      *core = &exss->asset[0].core;
+    uint64_t signature = dts_get_core_signature( bits->bs );
+    if( (info->layout_cached & DTS_LAYOUT_CACHE_CORE) && info->core_signature == signature )
+    {
+        /* The layout is the same as the last frame.
+         * Get only the frame size, and skip scanning the extensions in the core frame. */
+        uint16_t frame_size = ((lsmash_bs_show_be32( bits->bs, 5 ) >> 12) & 0x3FFF) + 1;  /* FSIZE (14) */
+        if( frame_size < DTS_MIN_CORE_SIZE )
+            return LSMASH_ERR_INVALID_DATA;
+        *core = info->core_cache;
+        core->frame_size = frame_size;
+    }
+    else
+    {
+        uint64_t bits_pos = 0;
+        int err;
+        if( DTS_SYNCWORD_CORE != dts_bits_get( bits, 32, &bits_pos ) )
+        {
+            lsmash_bits_get_align( bits );
+            return LSMASH_ERR_INVALID_DATA;
+        }
+        err = dts_parse_core( info, &bits_pos, core );
+        lsmash_bits_get_align( bits );
+        if( err < 0 )
+            return err;
+        info->layout_cached |= DTS_LAYOUT_CACHE_CORE;
+        info->core_signature = signature;
+        info->core_cache     = *core;
+    }
     exss->bBcCorePresent    [0] = 1;
     exss->nuBcCoreExtSSIndex[0] = 0;
     exss->nuBcCoreAssetIndex[0] = 0;
     info->flags |= DTS_CORE_SUBSTREAM_CORE_FLAG;
     info->exss_count      = 0;
-    info->core            = exss->asset[0].core;
-    info->frame_size      = exss->asset[0].core.frame_size;
-    lsmash_bits_get_align( bits );
+    info->core            = *core;
+    info->frame_size      = core->frame_size;
     return 0;
-parse_fail:
-    lsmash_bits_get_align( bits );
-    return err;
+}
+
+static int dts_is_same_exss_layout( dts_extension_info_t *a, dts_extension_info_t *b )
+{
+    if( a->sampling_frequency   != b->sampling_frequency
+     || a->frame_duration       != b->frame_duration
+     || a->nuBits4ExSSFsize     != b->nuBits4ExSSFsize
+     || a->bStaticFieldsPresent != b->bStaticFieldsPresent
+     || a->bMixMetadataEnbl     != b->bMixMetadataEnbl
+     || a->nuNumMixOutConfigs   != b->nuNumMixOutConfigs
+     || a->nuNumAudioPresnt     != b->nuNumAudioPresnt
+     || a->nuNumAssets          != b->nuNumAssets
+     || a->stereo_downmix       != b->stereo_downmix
+     || a->bit_resolution       != b->bit_resolution
+     || memcmp( a->nNumMixOutCh,       b->nNumMixOutCh,       sizeof(a->nNumMixOutCh) )
+     || memcmp( a->nuActiveExSSMask,   b->nuActiveExSSMask,   sizeof(a->nuActiveExSSMask) )
+     || memcmp( a->nuActiveAssetMask,  b->nuActiveAssetMask,  sizeof(a->nuActiveAssetMask) )
+     || memcmp( a->bBcCorePresent,     b->bBcCorePresent,     sizeof(a->bBcCorePresent) )
+     || memcmp( a->nuBcCoreExtSSIndex, b->nuBcCoreExtSSIndex, sizeof(a->nuBcCoreExtSSIndex) )
+     || memcmp( a->nuBcCoreAssetIndex, b->nuBcCoreAssetIndex, sizeof(a->nuBcCoreAssetIndex) ) )
+        return 0;
+    for( int nAst = 0; nAst < 8; nAst++ )
+    {
+        dts_audio_asset_t *asset_a = &a->asset[nAst];
+        dts_audio_asset_t *asset_b = &b->asset[nAst];
+        if( asset_a->channel_layout               != asset_b->channel_layout
+         || asset_a->bOne2OneMapChannels2Speakers != asset_b->bOne2OneMapChannels2Speakers
+         || asset_a->nuRepresentationType         != asset_b->nuRepresentationType
+         || asset_a->nuCodingMode                 != asset_b->nuCodingMode
+         || asset_a->nuCoreExtensionMask          != asset_b->nuCoreExtensionMask )
+            return 0;
+    }
+    return 1;
 }
 
 int dts_parse_extension_substream( dts_info_t *info )
@@ -1193,6 +1248,21 @@ int dts_parse_extension_substream( dts_info_t *info )
             exss->nuBcCoreExtSSIndex[nAuPr] = dts_bits_get( bits, 2, &bits_pos );
             exss->nuBcCoreAssetIndex[nAuPr] = dts_bits_get( bits, 3, &bits_pos );
         }
+    if( (info->layout_cached & DTS_LAYOUT_CACHE_EXSS( nExtSSIndex ))
+     && dts_is_same_exss_layout( exss, &info->exss_cache[nExtSSIndex] ) )
+    {
+        /* The layout is the same as the last frame of this extension substream.
+         * Reuse the information retrieved from the asset data instead of parsing them. */
+        for( int nAst = 0; nAst < 8; nAst++ )
+        {
+            dts_audio_asset_t *asset = &exss->asset[nAst];
+            dts_audio_asset_t *cache = &info->exss_cache[nExtSSIndex].asset[nAst];
+            asset->core = cache->core;
+            asset->xll  = cache->xll;
+            asset->lbr  = cache->lbr;
+        }
+        goto parse_done;
+    }
     dts_bits_get( bits, nuExtSSHeaderSize * 8 - bits_pos, &bits_pos );
     for( uint8_t nAst = 0; nAst < exss->nuNumAssets; nAst++ )
     {
@@ -1268,6 +1338,9 @@ int dts_parse_extension_substream( dts_info_t *info )
         dts_bits_get( bits, asset->size * 8 - (bits_pos - asset_pos), &bits_pos );
     }
     dts_bits_get( bits, info->frame_size * 8 - bits_pos, &bits_pos );
+    info->layout_cached |= DTS_LAYOUT_CACHE_EXSS( nExtSSIndex );
+    info->exss_cache[nExtSSIndex] = *exss;
+parse_done:
     lsmash_bits_get_align( bits );
     if( info->exss_count < DTS_MAX_NUM_EXSS )
         info->exss_count += 1;
@@ -1714,3 +1787,27 @@ int dts_print_codec_specific( FILE *fp, lsmash_file_t *file, isom_box_t *box, in
     lsmash_ifprintf( fp, indent, "Reserved = 0x%02"PRIx8"\n", Reserved );
     return 0;
 }
+
+void dts_json_codec_specific( struct print_stream_tag *stream, lsmash_file_t *file, isom_box_t *box )
+{
+    assert( stream && file && box && (box->manager & LSMASH_BINARY_CODED_BOX) );
+    if( box->size < DTS_SPECIFIC_BOX_MIN_LENGTH )
+        return;
+    uint8_t *data = box->binary;
+    isom_skip_box_common( &data );
+    isom_json_field_uint( stream, "DTSSamplingFrequency", LSMASH_GET_BE32( &data[0] ) );
+    isom_json_field_uint( stream, "maxBitrate", LSMASH_GET_BE32( &data[4] ) );
+    isom_json_field_uint( stream, "avgBitrate", LSMASH_GET_BE32( &data[8] ) );
+    isom_json_field_uint( stream, "pcmSampleDepth", LSMASH_GET_BYTE( &data[12] ) );
+    isom_json_field_uint( stream, "FrameDuration", (data[13] >> 6) & 0x03 );
+    isom_json_field_uint( stream, "StreamConstruction", (data[13] >> 1) & 0x1F );
+    isom_json_field_uint( stream, "CoreLFEPresent", data[13] & 0x01 );
+    isom_json_field_uint( stream, "CoreLayout", (data[14] >> 2) & 0x3F );
+    isom_json_field_uint( stream, "CoreSize", ((data[14] & 0x03) << 12) | (data[15] << 4) | ((data[16] >> 4) & 0x0F) );
+    isom_json_field_uint( stream, "StereoDownmix", (data[16] >> 3) & 0x01 );
+    isom_json_field_uint( stream, "RepresentationType", data[16] & 0x07 );
+    isom_json_field_uint( stream, "ChannelLayout", (data[17] << 8) | data[18] );
+    isom_json_field_uint( stream, "MultiAssetFlag", (data[19] >> 7) & 0x01 );
+    isom_json_field_uint( stream, "LBRDurationMod", (data[19] >> 6) & 0x01 );
+    isom_json_field_uint( stream, "ReservedBoxPresent", (data[19] >> 5) & 0x01 );
+}
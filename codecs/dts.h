@@ -123,6 +123,12 @@ typedef struct
     uint32_t frame_duration;
     uint32_t frame_size;        /* size of substream */
     lsmash_bits_t *bits;
+    /* the layout of the last fully parsed substream frames
+     * If the header of the next frame is unchanged, the layout is reused instead of parsing the whole frame. */
+    uint8_t              layout_cached;     /* bit 0: core substream, bit 1-4: extension substreams */
+    uint64_t             core_signature;
+    dts_core_info_t      core_cache;
+    dts_extension_info_t exss_cache[DTS_MAX_NUM_EXSS];
 } dts_info_t;
 
 void dts_setup_parser( dts_info_t *info );
@@ -27,6 +27,7 @@
 #include <inttypes.h>
 
 #include "core/box.h"
+#include "core/print.h"
 
 /***************************************************************************
     ITU-T Recommendation H.264 (04/13)
@@ -48,6 +49,17 @@ typedef enum
     H264_SLICE_TYPE_SI   = 4
 } h264_slice_type;
 
+void h264_discard_cached_specific_info
+(
+    lsmash_h264_parameter_sets_t *parameter_sets
+)
+{
+    if( !parameter_sets )
+        return;
+    lsmash_freep( &parameter_sets->cached_avcC );
+    parameter_sets->cached_avcC_length = 0;
+}
+
 void lsmash_destroy_h264_parameter_sets
 (
     lsmash_h264_specific_parameters_t *param
@@ -55,6 +67,7 @@ void lsmash_destroy_h264_parameter_sets
 {
     if( !param || !param->parameter_sets )
         return;
+    h264_discard_cached_specific_info( param->parameter_sets );
     lsmash_remove_entries( param->parameter_sets->sps_list,    isom_remove_dcr_ps );
     lsmash_remove_entries( param->parameter_sets->pps_list,    isom_remove_dcr_ps );
     lsmash_remove_entries( param->parameter_sets->spsext_list, isom_remove_dcr_ps );
@@ -188,23 +201,7 @@ uint64_t h264_find_next_start_code
         *start_code_length = long_start_code ? NALU_LONG_START_CODE_LENGTH : NALU_SHORT_START_CODE_LENGTH;
         uint64_t distance = *start_code_length + nuh->length;
         /* Find the start code of the next NALU and get the distance from the start code of the latest NALU. */
-        if( !lsmash_bs_is_end( bs, distance + NALU_SHORT_START_CODE_LENGTH ) )
-        {
-            uint32_t sync_bytes = lsmash_bs_show_be24( bs, distance );
-            while( 0x000001 != sync_bytes )
-            {
-                if( lsmash_bs_is_end( bs, ++distance + NALU_SHORT_START_CODE_LENGTH ) )
-                {
-                    distance = lsmash_bs_get_remaining_buffer_size( bs );
-                    break;
-                }
-                sync_bytes <<= 8;
-                sync_bytes  |= lsmash_bs_show_byte( bs, distance + NALU_SHORT_START_CODE_LENGTH - 1 );
-                sync_bytes  &= 0xFFFFFF;
-            }
-        }
-        else
-            distance = lsmash_bs_get_remaining_buffer_size( bs );
+        distance = lsmash_bs_find_start_code_prefix( bs, distance );
         /* Any NALU has no consecutive zero bytes at the end. */
         while( 0x00 == lsmash_bs_show_byte( bs, distance - 1 ) )
         {
@@ -911,6 +908,11 @@ int h264_parse_pps
     return 0;
 }
 
+/* The SEI messages are decoded on the importer's thread when their NAL unit is met, not on a worker.
+ * The payloads are decoded with the SPS active at that point in decoding order, and a pic_timing or recovery_point
+ * is consumed by h264_update_picture_info() at the next access unit delimitation, which happens in the same call.
+ * So a worker would have to be joined for every access unit, leaving nothing but the walk over the payload headers
+ * to run in parallel, while the payloads not decoded here are already skipped by their size. */
 int h264_parse_sei
 (
     lsmash_bits_t *bits,
@@ -921,66 +923,54 @@ int h264_parse_sei
     uint64_t       ebsp_size
 )
 {
-    int err = nalu_import_rbsp_from_ebsp( bits, rbsp_buffer, ebsp, ebsp_size );
+    uint8_t *rbsp_end = nalu_remove_emulation_prevention( ebsp, ebsp_size, rbsp_buffer );
+    uint64_t rbsp_base = bits->bs->buffer.store;
+    int err = lsmash_bits_import_data( bits, rbsp_buffer, rbsp_end - rbsp_buffer );
     if( err < 0 )
         return err;
-    uint8_t *rbsp_start = rbsp_buffer;
-    uint64_t rbsp_pos = 0;
+    uint8_t *pos = rbsp_buffer;
     do
     {
         /* sei_message() */
-        uint32_t payloadType = 0;
-        for( uint8_t temp = lsmash_bits_get( bits, 8 ); ; temp = lsmash_bits_get( bits, 8 ) )
-        {
-            /* 0xff     : ff_byte
-             * otherwise: last_payload_type_byte */
-            payloadType += temp;
-            ++rbsp_pos;
-            if( temp != 0xff )
-                break;
-        }
-        uint32_t payloadSize = 0;
-        for( uint8_t temp = lsmash_bits_get( bits, 8 ); ; temp = lsmash_bits_get( bits, 8 ) )
+        uint32_t payloadType;
+        uint32_t payloadSize;
+        uint8_t *payload = nalu_get_sei_payload( pos, rbsp_end, &payloadType, &payloadSize );
+        if( !payload )
         {
-            /* 0xff     : ff_byte
-             * otherwise: last_payload_size_byte */
-            payloadSize += temp;
-            ++rbsp_pos;
-            if( temp != 0xff )
-                break;
+            err = LSMASH_ERR_INVALID_DATA;
+            goto fail;
         }
+        pos = payload + payloadSize;
+        /* Only the payloads below are decoded. The others are skipped by their size. */
         if( payloadType == 1 )
         {
             /* pic_timing */
             h264_hrd_t *hrd = sps ? &sps->vui.hrd : NULL;
             if( !hrd )
-                goto skip_sei_message;  /* Any active SPS is not found. */
+                continue;   /* Any active SPS is not found. */
             sei->pic_timing.present = 1;
-            if( hrd->CpbDpbDelaysPresentFlag )
-            {
-                lsmash_bits_get( bits, hrd->cpb_removal_delay_length );     /* cpb_removal_delay */
-                lsmash_bits_get( bits, hrd->dpb_output_delay_length );      /* dpb_output_delay */
-            }
             if( sps->vui.pic_struct_present_flag )
             {
-                sei->pic_timing.pic_struct = lsmash_bits_get( bits, 4 );
-                /* Skip the remaining bits. */
-                uint32_t remaining_bits = payloadSize * 8 - 4;
+                nalu_seek_bits( bits, rbsp_base + (payload - rbsp_buffer) );
                 if( hrd->CpbDpbDelaysPresentFlag )
-                    remaining_bits -= hrd->cpb_removal_delay_length
-                                    + hrd->dpb_output_delay_length;
-                lsmash_bits_get( bits, remaining_bits );
+                {
+                    lsmash_bits_get( bits, hrd->cpb_removal_delay_length );     /* cpb_removal_delay */
+                    lsmash_bits_get( bits, hrd->dpb_output_delay_length );      /* dpb_output_delay */
+                }
+                sei->pic_timing.pic_struct = lsmash_bits_get( bits, 4 );
             }
         }
         else if( payloadType == 3 )
         {
             /* filler_payload
              * 'avc1' and 'avc2' samples are forbidden to contain this. */
-            return LSMASH_ERR_PATCH_WELCOME;
+            err = LSMASH_ERR_PATCH_WELCOME;
+            goto fail;
         }
         else if( payloadType == 6 )
         {
             /* recovery_point */
+            nalu_seek_bits( bits, rbsp_base + (payload - rbsp_buffer) );
             sei->recovery_point.present            = 1;
             sei->recovery_point.random_accessible  = 1;
             sei->recovery_point.recovery_frame_cnt = nalu_get_exp_golomb_ue( bits );
@@ -988,17 +978,12 @@ int h264_parse_sei
             sei->recovery_point.broken_link_flag   = lsmash_bits_get( bits, 1 );
             lsmash_bits_get( bits, 2 );     /* changing_slice_group_idc */
         }
-        else
-        {
-skip_sei_message:
-            lsmash_bits_get( bits, payloadSize * 8 );
-        }
-        lsmash_bits_get_align( bits );
-        rbsp_pos += payloadSize;
-    } while( *(rbsp_start + rbsp_pos) != 0x80 );        /* All SEI messages are byte aligned at their end.
-                                                         * Therefore, 0x80 shall be rbsp_trailing_bits(). */
+    } while( pos < rbsp_end && *pos != 0x80 );  /* All SEI messages are byte aligned at their end.
+                                                 * Therefore, 0x80 shall be rbsp_trailing_bits(). */
+    err = bits->bs->error ? LSMASH_ERR_NAMELESS : 0;
+fail:
     lsmash_bits_empty( bits );
-    return bits->bs->error ? LSMASH_ERR_NAMELESS : 0;
+    return err;
 }
 
 static int h264_parse_slice_header
@@ -1677,6 +1662,16 @@ uint8_t *lsmash_create_h264_specific_info
         return NULL;
     if( param->lengthSizeMinusOne != 0 && param->lengthSizeMinusOne != 1 && param->lengthSizeMinusOne != 3 )
         return NULL;
+    lsmash_h264_parameter_sets_t *parameter_sets = param->parameter_sets;
+    if( parameter_sets->cached_avcC
+     && !memcmp( &parameter_sets->cached_param, param, sizeof(lsmash_h264_specific_parameters_t) ) )
+    {
+        /* Nothing has changed since the last serialization. */
+        uint8_t *data = lsmash_memdup( parameter_sets->cached_avcC, parameter_sets->cached_avcC_length );
+        if( data )
+            *data_length = parameter_sets->cached_avcC_length;
+        return data;
+    }
     static const uint32_t max_ps_count[3] = { 31, 255, 255 };
     lsmash_entry_list_t *ps_list[3] =
         {
@@ -1733,8 +1728,18 @@ uint8_t *lsmash_create_h264_specific_info
     }
     uint8_t *data = lsmash_bs_export_data( bs, data_length );
     lsmash_bs_cleanup( bs );
+    if( !data )
+        return NULL;
     /* Update box size. */
     LSMASH_SET_BE32( data, *data_length );
+    /* Keep the serialized form for the next request. */
+    h264_discard_cached_specific_info( parameter_sets );
+    parameter_sets->cached_avcC = lsmash_memdup( data, *data_length );
+    if( parameter_sets->cached_avcC )
+    {
+        parameter_sets->cached_avcC_length = *data_length;
+        memcpy( &parameter_sets->cached_param, param, sizeof(lsmash_h264_specific_parameters_t) );
+    }
     return data;
 }
 
@@ -1991,6 +1996,7 @@ int lsmash_append_h264_parameter_set
         if( !param->parameter_sets )
             return LSMASH_ERR_MEMORY_ALLOC;
     }
+    h264_discard_cached_specific_info( param->parameter_sets );
     lsmash_entry_list_t *ps_list = h264_get_parameter_set_list( param, ps_type );
     if( !ps_list )
         return LSMASH_ERR_NAMELESS;
@@ -2181,6 +2187,7 @@ int h264_move_pending_avcC_param
     assert( info );
     if( !info->avcC_pending )
         return 0;
+    h264_discard_cached_specific_info( info->avcC_param.parameter_sets );
     /* Mark 'unused' on parameter sets within the decoder configuration record. */
     for( int i = 0; i < H264_PARAMETER_SET_TYPE_NUM; i++ )
     {
@@ -2374,6 +2381,7 @@ int h264_construct_specific_parameters
         if( !param->parameter_sets )
             return LSMASH_ERR_MEMORY_ALLOC;
     }
+    h264_discard_cached_specific_info( param->parameter_sets );
     lsmash_bs_t *bs = lsmash_bs_create();
     if( !bs )
         return LSMASH_ERR_MEMORY_ALLOC;
@@ -2482,6 +2490,49 @@ int h264_print_codec_specific
     return 0;
 }
 
+void h264_json_codec_specific
+(
+    struct print_stream_tag *stream,
+    lsmash_file_t           *file,
+    isom_box_t              *box
+)
+{
+    assert( stream && file && box && (box->manager & LSMASH_BINARY_CODED_BOX) );
+    uint8_t     *data   = box->binary;
+    uint32_t     offset = isom_skip_box_common( &data );
+    lsmash_bs_t *bs     = lsmash_bs_create();
+    if( !bs )
+        return;
+    if( lsmash_bs_import_data( bs, data, box->size - offset ) < 0 )
+    {
+        lsmash_bs_cleanup( bs );
+        return;
+    }
+    isom_json_field_uint( stream, "configurationVersion", lsmash_bs_get_byte( bs ) );
+    uint8_t AVCProfileIndication = lsmash_bs_get_byte( bs );
+    isom_json_field_uint( stream, "AVCProfileIndication", AVCProfileIndication );
+    isom_json_field_uint( stream, "profile_compatibility", lsmash_bs_get_byte( bs ) );
+    isom_json_field_uint( stream, "AVCLevelIndication", lsmash_bs_get_byte( bs ) );
+    isom_json_field_uint( stream, "lengthSizeMinusOne", lsmash_bs_get_byte( bs ) & 0x03 );
+    uint8_t numOfSequenceParameterSets = lsmash_bs_get_byte( bs ) & 0x1f;
+    isom_json_field_uint( stream, "numOfSequenceParameterSets", numOfSequenceParameterSets );
+    for( uint8_t i = 0; i < numOfSequenceParameterSets; i++ )
+        lsmash_bs_skip_bytes( bs, lsmash_bs_get_be16( bs ) );
+    uint8_t numOfPictureParameterSets = lsmash_bs_get_byte( bs );
+    isom_json_field_uint( stream, "numOfPictureParameterSets", numOfPictureParameterSets );
+    for( uint8_t i = 0; i < numOfPictureParameterSets; i++ )
+        lsmash_bs_skip_bytes( bs, lsmash_bs_get_be16( bs ) );
+    if( H264_REQUIRES_AVCC_EXTENSION( AVCProfileIndication )
+     && (lsmash_bs_get_pos( bs ) < (box->size - offset)) )
+    {
+        isom_json_field_uint( stream, "chroma_format", lsmash_bs_get_byte( bs ) & 0x03 );
+        isom_json_field_uint( stream, "bit_depth_luma_minus8", lsmash_bs_get_byte( bs ) & 0x7 );
+        isom_json_field_uint( stream, "bit_depth_chroma_minus8", lsmash_bs_get_byte( bs ) & 0x7 );
+        isom_json_field_uint( stream, "numOfSequenceParameterSetExt", lsmash_bs_get_byte( bs ) );
+    }
+    lsmash_bs_cleanup( bs );
+}
+
 int h264_copy_codec_specific
 (
     lsmash_codec_specific_t *dst,
@@ -2545,3 +2596,16 @@ int h264_print_bitrate
     lsmash_ifprintf( fp, indent, "avgBitrate = %"PRIu32"\n", btrt->avgBitrate );
     return 0;
 }
+
+void h264_json_bitrate
+(
+    struct print_stream_tag *stream,
+    lsmash_file_t           *file,
+    isom_box_t              *box
+)
+{
+    isom_btrt_t *btrt = (isom_btrt_t *)box;
+    isom_json_field_uint( stream, "bufferSizeDB", btrt->bufferSizeDB );
+    isom_json_field_uint( stream, "maxBitrate", btrt->maxBitrate );
+    isom_json_field_uint( stream, "avgBitrate", btrt->avgBitrate );
+}
@@ -56,6 +56,11 @@ struct lsmash_h264_parameter_sets_tag
     lsmash_entry_list_t sps_list   [1];
     lsmash_entry_list_t pps_list   [1];
     lsmash_entry_list_t spsext_list[1];
+    /* AVCConfigurationBox serialized from the lists above and 'cached_param'.
+     * This is discarded whenever the lists are modified. */
+    lsmash_h264_specific_parameters_t cached_param;
+    uint8_t                          *cached_avcC;
+    uint32_t                          cached_avcC_length;
 };
 
 typedef struct
@@ -367,3 +372,8 @@ int h264_move_pending_avcC_param
 (
     h264_info_t *info
 );
+
+void h264_discard_cached_specific_info
+(
+    lsmash_h264_parameter_sets_t *parameter_sets
+);
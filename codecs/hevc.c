@@ -27,6 +27,7 @@
 #include <inttypes.h>
 
 #include "core/box.h"
+#include "core/print.h"
 
 /***************************************************************************
     ITU-T Recommendation H.265 (04/13)
@@ -52,6 +53,17 @@ typedef enum
     HEVC_SLICE_TYPE_I = 2,
 } hevc_slice_type;
 
+void hevc_discard_cached_specific_info
+(
+    lsmash_hevc_parameter_arrays_t *parameter_arrays
+)
+{
+    if( !parameter_arrays )
+        return;
+    lsmash_freep( &parameter_arrays->cached_hvcC );
+    parameter_arrays->cached_hvcC_length = 0;
+}
+
 void lsmash_destroy_hevc_parameter_arrays
 (
     lsmash_hevc_specific_parameters_t *param
@@ -59,6 +71,7 @@ void lsmash_destroy_hevc_parameter_arrays
 {
     if( !param || !param->parameter_arrays )
         return;
+    hevc_discard_cached_specific_info( param->parameter_arrays );
     for( int i = 0; i < HEVC_DCR_NALU_TYPE_NUM; i++ )
         lsmash_remove_entries( param->parameter_arrays->ps_array[i].list, isom_remove_dcr_ps );
     lsmash_free( param->parameter_arrays );
@@ -211,23 +224,7 @@ uint64_t hevc_find_next_start_code
         *start_code_length = long_start_code ? NALU_LONG_START_CODE_LENGTH : NALU_SHORT_START_CODE_LENGTH;
         uint64_t distance = *start_code_length + nuh->length;
         /* Find the start code of the next NALU and get the distance from the start code of the latest NALU. */
-        if( !lsmash_bs_is_end( bs, distance + NALU_SHORT_START_CODE_LENGTH ) )
-        {
-            uint32_t sync_bytes = lsmash_bs_show_be24( bs, distance );
-            while( 0x000001 != sync_bytes )
-            {
-                if( lsmash_bs_is_end( bs, ++distance + NALU_SHORT_START_CODE_LENGTH ) )
-                {
-                    distance = lsmash_bs_get_remaining_buffer_size( bs );
-                    break;
-                }
-                sync_bytes <<= 8;
-                sync_bytes  |= lsmash_bs_show_byte( bs, distance + NALU_SHORT_START_CODE_LENGTH - 1 );
-                sync_bytes  &= 0xFFFFFF;
-            }
-        }
-        else
-            distance = lsmash_bs_get_remaining_buffer_size( bs );
+        distance = lsmash_bs_find_start_code_prefix( bs, distance );
         /* Any NALU has no consecutive zero bytes at the end. */
         while( 0x00 == lsmash_bs_show_byte( bs, distance - 1 ) )
         {
@@ -1210,6 +1207,7 @@ fail:
     return err;
 }
 
+/* Decoded on the importer's thread for the same reason as h264_parse_sei(). */
 int hevc_parse_sei
 (
     lsmash_bits_t      *bits,
@@ -1222,112 +1220,63 @@ int hevc_parse_sei
     uint64_t            ebsp_size
 )
 {
-    int err = nalu_import_rbsp_from_ebsp( bits, rbsp_buffer, ebsp, ebsp_size );
+    uint8_t *rbsp_end = nalu_remove_emulation_prevention( ebsp, ebsp_size, rbsp_buffer );
+    uint64_t rbsp_base = bits->bs->buffer.store;
+    int err = lsmash_bits_import_data( bits, rbsp_buffer, rbsp_end - rbsp_buffer );
     if( err < 0 )
         return err;
-    uint8_t *rbsp_start = rbsp_buffer;
-    uint64_t rbsp_pos = 0;
+    uint8_t *pos = rbsp_buffer;
     do
     {
         /* sei_message() */
-        uint32_t payloadType = 0;
-        for( uint8_t temp = lsmash_bits_get( bits, 8 ); ; temp = lsmash_bits_get( bits, 8 ) )
+        uint32_t payloadType;
+        uint32_t payloadSize;
+        uint8_t *payload = nalu_get_sei_payload( pos, rbsp_end, &payloadType, &payloadSize );
+        if( !payload )
         {
-            /* 0xff     : ff_byte
-             * otherwise: last_payload_type_byte */
-            payloadType += temp;
-            ++rbsp_pos;
-            if( temp != 0xff )
-                break;
-        }
-        uint32_t payloadSize = 0;
-        for( uint8_t temp = lsmash_bits_get( bits, 8 ); ; temp = lsmash_bits_get( bits, 8 ) )
-        {
-            /* 0xff     : ff_byte
-             * otherwise: last_payload_size_byte */
-            payloadSize += temp;
-            ++rbsp_pos;
-            if( temp != 0xff )
-                break;
+            err = LSMASH_ERR_INVALID_DATA;
+            goto fail;
         }
-        if( nuh->nal_unit_type == HEVC_NALU_TYPE_PREFIX_SEI )
+        pos = payload + payloadSize;
+        /* Only the payloads below are decoded. The others are skipped by their size. */
+        if( payloadType == 3 )
         {
-            if( payloadType == 1 )
-            {
-                /* pic_timing */
-                hevc_hrd_t *hrd = sps ? &sps->vui.hrd : vps ? &vps->hrd[0] : NULL;
-                if( !hrd )
-                    goto skip_sei_message;  /* Any active VPS or SPS is not found. */
-                sei->pic_timing.present = 1;
-                if( (sps && sps->vui.frame_field_info_present_flag) || vps->frame_field_info_present_flag )
-                {
-                    sei->pic_timing.pic_struct = lsmash_bits_get( bits, 4 );
-                    lsmash_bits_get( bits, 2 );     /* source_scan_type */
-                    lsmash_bits_get( bits, 1 );     /* duplicate_flag */
-                }
-                if( hrd->CpbDpbDelaysPresentFlag )
-                {
-                    lsmash_bits_get( bits, hrd->au_cpb_removal_delay_length );      /* au_cpb_removal_delay_minus1 */
-                    lsmash_bits_get( bits, hrd->dpb_output_delay_length );          /* pic_dpb_output_delay */
-                    if( hrd->sub_pic_hrd_params_present_flag )
-                    {
-                        lsmash_bits_get( bits, hrd->dpb_output_delay_du_length );   /* pic_dpb_output_du_delay */
-                        if( hrd->sub_pic_cpb_params_in_pic_timing_sei_flag )
-                        {
-                            uint64_t num_decoding_units_minus1 = nalu_get_exp_golomb_ue( bits );
-                            int du_common_cpb_removal_delay_flag = lsmash_bits_get( bits, 1 );
-                            if( du_common_cpb_removal_delay_flag )
-                                /* du_common_cpb_removal_delay_increment_minus1 */
-                                lsmash_bits_get( bits, hrd->du_cpb_removal_delay_increment_length );
-                            for( uint64_t i = 0; i <= num_decoding_units_minus1; i++ )
-                            {
-                                nalu_get_exp_golomb_ue( bits );         /* num_nalus_in_du_minus1 */
-                                if( !du_common_cpb_removal_delay_flag && i < num_decoding_units_minus1 )
-                                    nalu_get_exp_golomb_ue( bits );     /* du_cpb_removal_delay_increment_minus1 */
-                            }
-                        }
-                    }
-                }
-            }
-            else if( payloadType == 3 )
-            {
-                /* filler_payload
-                 * FIXME: remove if array_completeness equal to 1. */
-                return LSMASH_ERR_PATCH_WELCOME;
-            }
-            else if( payloadType == 6 )
-            {
-                /* recovery_point */
-                sei->recovery_point.present          = 1;
-                sei->recovery_point.recovery_poc_cnt = nalu_get_exp_golomb_se( bits );
-                lsmash_bits_get( bits, 1 );     /* exact_match_flag */
-                sei->recovery_point.broken_link_flag = lsmash_bits_get( bits, 1 );
-            }
-            else
-                goto skip_sei_message;
+            /* filler_payload
+             * FIXME: remove if array_completeness equal to 1. */
+            err = LSMASH_ERR_PATCH_WELCOME;
+            goto fail;
         }
-        else if( nuh->nal_unit_type == HEVC_NALU_TYPE_SUFFIX_SEI )
+        if( nuh->nal_unit_type != HEVC_NALU_TYPE_PREFIX_SEI )
+            continue;
+        if( payloadType == 1 )
         {
-            if( payloadType == 3 )
+            /* pic_timing */
+            hevc_hrd_t *hrd = sps ? &sps->vui.hrd : vps ? &vps->hrd[0] : NULL;
+            if( !hrd )
+                continue;   /* Any active VPS or SPS is not found. */
+            sei->pic_timing.present = 1;
+            /* Only pic_struct is used. The following fields are not needed. */
+            if( (sps && sps->vui.frame_field_info_present_flag) || vps->frame_field_info_present_flag )
             {
-                /* filler_payload
-                 * FIXME: remove if array_completeness equal to 1. */
-                return LSMASH_ERR_PATCH_WELCOME;
+                nalu_seek_bits( bits, rbsp_base + (payload - rbsp_buffer) );
+                sei->pic_timing.pic_struct = lsmash_bits_get( bits, 4 );
             }
-            else
-                goto skip_sei_message;
         }
-        else
+        else if( payloadType == 6 )
         {
-skip_sei_message:
-            lsmash_bits_get( bits, payloadSize * 8 );
+            /* recovery_point */
+            nalu_seek_bits( bits, rbsp_base + (payload - rbsp_buffer) );
+            sei->recovery_point.present          = 1;
+            sei->recovery_point.recovery_poc_cnt = nalu_get_exp_golomb_se( bits );
+            lsmash_bits_get( bits, 1 );     /* exact_match_flag */
+            sei->recovery_point.broken_link_flag = lsmash_bits_get( bits, 1 );
         }
-        lsmash_bits_get_align( bits );
-        rbsp_pos += payloadSize;
-    } while( *(rbsp_start + rbsp_pos) != 0x80 );        /* All SEI messages are byte aligned at their end.
-                                                         * Therefore, 0x80 shall be rbsp_trailing_bits(). */
+    } while( pos < rbsp_end && *pos != 0x80 );  /* All SEI messages are byte aligned at their end.
+                                                 * Therefore, 0x80 shall be rbsp_trailing_bits(). */
+    err = bits->bs->error ? LSMASH_ERR_NAMELESS : 0;
+fail:
     lsmash_bits_empty( bits );
-    return bits->bs->error ? LSMASH_ERR_NAMELESS : 0;
+    return err;
 }
 
 int hevc_parse_slice_segment_header
@@ -1844,6 +1793,16 @@ uint8_t *lsmash_create_hevc_specific_info
      && param->lengthSizeMinusOne != 1
      && param->lengthSizeMinusOne != 3 )
         return NULL;
+    lsmash_hevc_parameter_arrays_t *parameter_arrays = param->parameter_arrays;
+    if( parameter_arrays->cached_hvcC
+     && !memcmp( &parameter_arrays->cached_param, param, sizeof(lsmash_hevc_specific_parameters_t) ) )
+    {
+        /* Nothing has changed since the last serialization. */
+        uint8_t *data = lsmash_memdup( parameter_arrays->cached_hvcC, parameter_arrays->cached_hvcC_length );
+        if( data )
+            *data_length = parameter_arrays->cached_hvcC_length;
+        return data;
+    }
     hevc_parameter_array_t *param_arrays[HEVC_DCR_NALU_TYPE_NUM];
     lsmash_entry_list_t    *dcr_ps_list [HEVC_DCR_NALU_TYPE_NUM];
     for( int i = 0; i < HEVC_DCR_NALU_TYPE_NUM; i++ )
@@ -1918,8 +1877,18 @@ uint8_t *lsmash_create_hevc_specific_info
     }
     uint8_t *data = lsmash_bs_export_data( bs, data_length );
     lsmash_bs_cleanup( bs );
+    if( !data )
+        return NULL;
     /* Update box size. */
     LSMASH_SET_BE32( data, *data_length );
+    /* Keep the serialized form for the next request. */
+    hevc_discard_cached_specific_info( parameter_arrays );
+    parameter_arrays->cached_hvcC = lsmash_memdup( data, *data_length );
+    if( parameter_arrays->cached_hvcC )
+    {
+        parameter_arrays->cached_hvcC_length = *data_length;
+        memcpy( &parameter_arrays->cached_param, param, sizeof(lsmash_hevc_specific_parameters_t) );
+    }
     return data;
 }
 
@@ -2297,6 +2266,7 @@ int lsmash_append_hevc_dcr_nalu
     hevc_parameter_array_t *ps_array = hevc_get_parameter_set_array( param, ps_type );
     if( !ps_array )
         return LSMASH_ERR_FUNCTION_PARAM;
+    hevc_discard_cached_specific_info( param->parameter_arrays );
     lsmash_entry_list_t *ps_list = ps_array->list;
     if( ps_type == HEVC_DCR_NALU_TYPE_PREFIX_SEI
      || ps_type == HEVC_DCR_NALU_TYPE_SUFFIX_SEI )
@@ -2644,6 +2614,7 @@ int hevc_move_pending_hvcC_param
     assert( info );
     if( !info->hvcC_pending )
         return 0;
+    hevc_discard_cached_specific_info( info->hvcC_param.parameter_arrays );
     /* Mark 'unused' on parameter sets within the decoder configuration record. */
     for( int i = 0; i < HEVC_DCR_NALU_TYPE_NUM; i++ )
     {
@@ -2688,6 +2659,7 @@ int lsmash_set_hevc_array_completeness
     hevc_parameter_array_t *ps_array = hevc_get_parameter_set_array( param, ps_type );
     if( !ps_array )
         return LSMASH_ERR_FUNCTION_PARAM;
+    hevc_discard_cached_specific_info( param->parameter_arrays );
     ps_array->array_completeness = array_completeness;
     return 0;
 }
@@ -2868,6 +2840,7 @@ int hevc_construct_specific_parameters
         return LSMASH_ERR_INVALID_DATA;
     if( hevc_alloc_parameter_arrays( param ) < 0 )
         return LSMASH_ERR_MEMORY_ALLOC;
+    hevc_discard_cached_specific_info( param->parameter_arrays );
     lsmash_bs_t *bs = lsmash_bs_create();
     if( !bs )
         return LSMASH_ERR_MEMORY_ALLOC;
@@ -3045,6 +3018,73 @@ int hevc_print_codec_specific
     return 0;
 }
 
+void hevc_json_codec_specific
+(
+    struct print_stream_tag *stream,
+    lsmash_file_t           *file,
+    isom_box_t              *box
+)
+{
+    assert( stream && file && box && (box->manager & LSMASH_BINARY_CODED_BOX) );
+    uint8_t     *data   = box->binary;
+    uint32_t     offset = isom_skip_box_common( &data );
+    lsmash_bs_t *bs     = lsmash_bs_create();
+    if( !bs )
+        return;
+    if( lsmash_bs_import_data( bs, data, box->size - offset ) < 0 )
+    {
+        lsmash_bs_cleanup( bs );
+        return;
+    }
+    uint8_t configurationVersion = lsmash_bs_get_byte( bs );
+    isom_json_field_uint( stream, "configurationVersion", configurationVersion );
+    if( configurationVersion != HVCC_CONFIGURATION_VERSION )
+    {
+        lsmash_bs_cleanup( bs );
+        return;
+    }
+    uint8_t temp8 = lsmash_bs_get_byte( bs );
+    isom_json_field_uint( stream, "general_profile_space", (temp8 >> 6) & 0x03 );
+    isom_json_field_uint( stream, "general_tier_flag", (temp8 >> 5) & 0x01 );
+    isom_json_field_uint( stream, "general_profile_idc", temp8 & 0x1F );
+    isom_json_field_uint( stream, "general_profile_compatibility_flags", lsmash_bs_get_be32( bs ) );
+    uint32_t temp32 = lsmash_bs_get_be32( bs );
+    uint16_t temp16 = lsmash_bs_get_be16( bs );
+    isom_json_field_uint( stream, "general_constraint_indicator_flags", ((uint64_t)temp32 << 16) | temp16 );
+    isom_json_field_uint( stream, "general_level_idc", lsmash_bs_get_byte( bs ) );
+    isom_json_field_uint( stream, "min_spatial_segmentation_idc", lsmash_bs_get_be16( bs ) & 0x0FFF );
+    isom_json_field_uint( stream, "parallelismType", lsmash_bs_get_byte( bs ) & 0x03 );
+    isom_json_field_uint( stream, "chromaFormat", lsmash_bs_get_byte( bs ) & 0x03 );
+    isom_json_field_uint( stream, "bitDepthLumaMinus8", lsmash_bs_get_byte( bs ) & 0x07 );
+    isom_json_field_uint( stream, "bitDepthChromaMinus8", lsmash_bs_get_byte( bs ) & 0x07 );
+    isom_json_field_uint( stream, "avgFrameRate", lsmash_bs_get_be16( bs ) );
+    temp8 = lsmash_bs_get_byte( bs );
+    isom_json_field_uint( stream, "constantFrameRate", (temp8 >> 6) & 0x03 );
+    isom_json_field_uint( stream, "numTemporalLayers", (temp8 >> 3) & 0x07 );
+    isom_json_field_uint( stream, "temporalIdNested", (temp8 >> 2) & 0x01 );
+    isom_json_field_uint( stream, "lengthSizeMinusOne", temp8 & 0x03 );
+    uint8_t numOfArrays = lsmash_bs_get_byte( bs );
+    isom_json_field_uint( stream, "numOfArrays", numOfArrays );
+    /* [ array_completeness, NAL_unit_type, numNalus ] */
+    isom_json_key( stream, "arrays" );
+    isom_json_begin( stream, '[' );
+    for( uint8_t i = 0; i < numOfArrays; i++ )
+    {
+        temp8 = lsmash_bs_get_byte( bs );
+        uint16_t numNalus = lsmash_bs_get_be16( bs );
+        isom_json_separate( stream );
+        isom_json_begin( stream, '[' );
+        isom_json_element_uint( stream, (temp8 >> 7) & 0x01 );
+        isom_json_element_uint( stream, temp8 & 0x3F );
+        isom_json_element_uint( stream, numNalus );
+        isom_json_end( stream, ']' );
+        for( uint16_t j = 0; j < numNalus; j++ )
+            lsmash_bs_skip_bytes( bs, lsmash_bs_get_be16( bs ) );
+    }
+    isom_json_end( stream, ']' );
+    lsmash_bs_cleanup( bs );
+}
+
 static inline int hevc_copy_dcr_nalu_array
 (
     lsmash_hevc_specific_parameters_t *dst_data,
@@ -70,6 +70,11 @@ typedef struct
 struct lsmash_hevc_parameter_arrays_tag
 {
     hevc_parameter_array_t ps_array[HEVC_DCR_NALU_TYPE_NUM];
+    /* HEVCConfigurationBox serialized from the arrays above and 'cached_param'.
+     * This is discarded whenever the arrays are modified. */
+    lsmash_hevc_specific_parameters_t cached_param;
+    uint8_t                          *cached_hvcC;
+    uint32_t                          cached_hvcC_length;
 };
 
 typedef struct
@@ -445,3 +450,8 @@ int hevc_move_pending_hvcC_param
 (
     hevc_info_t *info
 );
+
+void hevc_discard_cached_specific_info
+(
+    lsmash_hevc_parameter_arrays_t *parameter_arrays
+);
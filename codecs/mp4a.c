@@ -743,6 +743,61 @@ int mp4a_setup_summary_from_AudioSpecificConfig( lsmash_audio_summary_t *summary
     return 0;
 }
 
+/* Get the parameters of adts_fixed_header() from AudioSpecificConfig.
+ * If the AudioSpecificConfig signals SBR or PS hierarchically, the parameters of the underlying AAC are returned
+ * since ADTS can signal only them. */
+int mp4a_get_adts_fixed_header_parameters
+(
+    uint8_t *dsi_payload,
+    uint32_t dsi_payload_length,
+    uint8_t *profile_ObjectType,
+    uint8_t *sampling_frequency_index,
+    uint8_t *channel_configuration
+)
+{
+    lsmash_bits_t *bits = lsmash_bits_adhoc_create();
+    if( !bits )
+        return LSMASH_ERR_MEMORY_ALLOC;
+    int err = lsmash_bits_import_data( bits, dsi_payload, dsi_payload_length );
+    if( err < 0 )
+        goto fail;
+    uint32_t aot = lsmash_bits_get( bits, 5 );
+    if( aot == 31 )
+        aot = 32 + lsmash_bits_get( bits, 6 );
+    uint8_t samplingFrequencyIndex = lsmash_bits_get( bits, 4 );
+    if( samplingFrequencyIndex == 0xf )
+        lsmash_bits_get( bits, 24 );
+    uint8_t channelConfiguration = lsmash_bits_get( bits, 4 );
+    if( aot == MP4A_AUDIO_OBJECT_TYPE_SBR || aot == MP4A_AUDIO_OBJECT_TYPE_PS )
+    {
+        /* extensionSamplingFrequencyIndex and the underlying audioObjectType */
+        if( lsmash_bits_get( bits, 4 ) == 0xf )
+            lsmash_bits_get( bits, 24 );
+        aot = lsmash_bits_get( bits, 5 );
+        if( aot == 31 )
+            aot = 32 + lsmash_bits_get( bits, 6 );
+    }
+    /* profile_ObjectType is the audio object type minus 1 with 2 bits, and samplingFrequencyIndex 0xf is not allowed. */
+    if( aot < MP4A_AUDIO_OBJECT_TYPE_AAC_MAIN || aot > MP4A_AUDIO_OBJECT_TYPE_AAC_LTP
+     || samplingFrequencyIndex == 0xf )
+    {
+        err = LSMASH_ERR_INVALID_DATA;
+        goto fail;
+    }
+    /* Any program_config_element() is not supported yet. */
+    if( channelConfiguration == 0 )
+    {
+        err = LSMASH_ERR_PATCH_WELCOME;
+        goto fail;
+    }
+    *profile_ObjectType       = aot - 1;
+    *sampling_frequency_index = samplingFrequencyIndex;
+    *channel_configuration    = channelConfiguration;
+fail:
+    lsmash_bits_adhoc_cleanup( bits );
+    return err;
+}
+
 /* This function is very ad-hoc. */
 uint8_t *mp4a_export_AudioSpecificConfig( lsmash_mp4a_AudioObjectType aot,
                                           uint32_t frequency,
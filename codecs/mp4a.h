@@ -124,6 +124,16 @@ extern const uint32_t mp4a_sampling_frequency_table[13][5];
 /* setup for summary */
 int mp4a_setup_summary_from_AudioSpecificConfig( lsmash_audio_summary_t *summary, uint8_t *dsi_payload, uint32_t dsi_payload_length );
 
+/* export for exporter */
+int mp4a_get_adts_fixed_header_parameters
+(
+    uint8_t *dsi_payload,
+    uint32_t dsi_payload_length,
+    uint8_t *profile_ObjectType,
+    uint8_t *sampling_frequency_index,
+    uint8_t *channel_configuration
+);
+
 /* profileLevelIndication relative functions. */
 mp4a_audioProfileLevelIndication mp4a_get_audioProfileLevelIndication( lsmash_audio_summary_t *summary );
 mp4a_audioProfileLevelIndication mp4a_max_audioProfileLevelIndication(
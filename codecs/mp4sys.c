@@ -28,6 +28,7 @@
 #include <inttypes.h>
 
 #include "core/box.h"
+#include "core/print.h"
 
 #include "description.h"
 #include "mp4a.h"
@@ -763,6 +764,17 @@ int mp4sys_update_DecoderConfigDescriptor( mp4sys_ES_Descriptor_t *esd, uint32_t
     return 0;
 }
 
+int mp4sys_fetch_DecoderConfigDescriptor( mp4sys_ES_Descriptor_t *esd, uint32_t *bufferSizeDB, uint32_t *maxBitrate, uint32_t *avgBitrate )
+{
+    if( !esd || !esd->decConfigDescr )
+        return LSMASH_ERR_NAMELESS;
+    mp4sys_DecoderConfigDescriptor_t *dcd = esd->decConfigDescr;
+    *bufferSizeDB = dcd->bufferSizeDB;
+    *maxBitrate   = dcd->maxBitrate;
+    *avgBitrate   = dcd->avgBitrate;
+    return 0;
+}
+
 void mp4sys_print_descriptor( FILE *fp, mp4sys_descriptor_t *descriptor, int indent );
 
 static void mp4sys_print_descriptor_header( FILE *fp, mp4sys_descriptor_head_t *header, int indent )
@@ -1029,6 +1041,151 @@ int mp4sys_print_codec_specific( FILE *fp, lsmash_file_t *file, isom_box_t *box,
     return 0;
 }
 
+static void mp4sys_json_DecoderConfigDescriptor( struct print_stream_tag *stream, mp4sys_descriptor_t *descriptor )
+{
+    mp4sys_DecoderConfigDescriptor_t *dcd = (mp4sys_DecoderConfigDescriptor_t *)descriptor;
+    isom_json_field_uint( stream, "objectTypeIndication", dcd->objectTypeIndication );
+    isom_json_field_uint( stream, "streamType", dcd->streamType );
+    isom_json_field_uint( stream, "upStream", dcd->upStream );
+    isom_json_field_uint( stream, "bufferSizeDB", dcd->bufferSizeDB );
+    isom_json_field_uint( stream, "maxBitrate", dcd->maxBitrate );
+    isom_json_field_uint( stream, "avgBitrate", dcd->avgBitrate );
+}
+
+static void mp4sys_json_SLConfigDescriptor( struct print_stream_tag *stream, mp4sys_descriptor_t *descriptor )
+{
+    mp4sys_SLConfigDescriptor_t *slcd = (mp4sys_SLConfigDescriptor_t *)descriptor;
+    isom_json_field_uint( stream, "predefined", slcd->predefined );
+    if( slcd->predefined == 0 )
+    {
+        isom_json_field_uint( stream, "useAccessUnitStartFlag", slcd->useAccessUnitStartFlag );
+        isom_json_field_uint( stream, "useAccessUnitEndFlag", slcd->useAccessUnitEndFlag );
+        isom_json_field_uint( stream, "useRandomAccessPointFlag", slcd->useRandomAccessPointFlag );
+        isom_json_field_uint( stream, "hasRandomAccessUnitsOnlyFlag", slcd->hasRandomAccessUnitsOnlyFlag );
+        isom_json_field_uint( stream, "usePaddingFlag", slcd->usePaddingFlag );
+        isom_json_field_uint( stream, "useTimeStampsFlag", slcd->useTimeStampsFlag );
+        isom_json_field_uint( stream, "useIdleFlag", slcd->useIdleFlag );
+        isom_json_field_uint( stream, "durationFlag", slcd->durationFlag );
+        isom_json_field_uint( stream, "timeStampResolution", slcd->timeStampResolution );
+        isom_json_field_uint( stream, "OCRResolution", slcd->OCRResolution );
+        isom_json_field_uint( stream, "timeStampLength", slcd->timeStampLength );
+        isom_json_field_uint( stream, "OCRLength", slcd->OCRLength );
+        isom_json_field_uint( stream, "AU_Length", slcd->AU_Length );
+        isom_json_field_uint( stream, "instantBitrateLength", slcd->instantBitrateLength );
+        isom_json_field_uint( stream, "degradationPriorityLength", slcd->degradationPriorityLength );
+        isom_json_field_uint( stream, "AU_seqNumLength", slcd->AU_seqNumLength );
+        isom_json_field_uint( stream, "packetSeqNumLength", slcd->packetSeqNumLength );
+    }
+    if( slcd->durationFlag )
+    {
+        isom_json_field_uint( stream, "timeScale", slcd->timeScale );
+        isom_json_field_uint( stream, "accessUnitDuration", slcd->accessUnitDuration );
+        isom_json_field_uint( stream, "compositionUnitDuration", slcd->compositionUnitDuration );
+    }
+    if( !slcd->useTimeStampsFlag )
+    {
+        isom_json_field_uint( stream, "startDecodingTimeStamp", slcd->startDecodingTimeStamp );
+        isom_json_field_uint( stream, "startCompositionTimeStamp", slcd->startCompositionTimeStamp );
+    }
+}
+
+static void mp4sys_json_ES_Descriptor( struct print_stream_tag *stream, mp4sys_descriptor_t *descriptor )
+{
+    mp4sys_ES_Descriptor_t *esd = (mp4sys_ES_Descriptor_t *)descriptor;
+    isom_json_field_uint( stream, "ES_ID", esd->ES_ID );
+    isom_json_field_uint( stream, "streamDependenceFlag", esd->streamDependenceFlag );
+    isom_json_field_uint( stream, "URL_Flag", esd->URL_Flag );
+    isom_json_field_uint( stream, "OCRstreamFlag", esd->OCRstreamFlag );
+    isom_json_field_uint( stream, "streamPriority", esd->streamPriority );
+    if( esd->streamDependenceFlag )
+        isom_json_field_uint( stream, "dependsOn_ES_ID", esd->dependsOn_ES_ID );
+    if( esd->URL_Flag )
+        isom_json_field_string( stream, "URLstring", esd->URLstring, esd->URLlength );
+    if( esd->OCRstreamFlag )
+        isom_json_field_uint( stream, "OCR_ES_Id", esd->OCR_ES_Id );
+}
+
+static void mp4sys_json_ObjectDescriptor( struct print_stream_tag *stream, mp4sys_descriptor_t *descriptor )
+{
+    mp4sys_ObjectDescriptor_t *od = (mp4sys_ObjectDescriptor_t *)descriptor;
+    int initial = od->header.tag == MP4SYS_DESCRIPTOR_TAG_InitialObjectDescrTag
+               || od->header.tag == MP4SYS_DESCRIPTOR_TAG_MP4_IOD_Tag;
+    isom_json_field_uint( stream, "ObjectDescriptorID", od->ObjectDescriptorID );
+    isom_json_field_uint( stream, "URL_Flag", od->URL_Flag );
+    if( initial )
+        isom_json_field_uint( stream, "includeInlineProfileLevelFlag", od->includeInlineProfileLevelFlag );
+    if( od->URL_Flag )
+        isom_json_field_string( stream, "URLstring", od->URLstring, od->URLlength );
+    else if( initial )
+    {
+        isom_json_field_uint( stream, "ODProfileLevelIndication", od->ODProfileLevelIndication );
+        isom_json_field_uint( stream, "sceneProfileLevelIndication", od->sceneProfileLevelIndication );
+        isom_json_field_uint( stream, "audioProfileLevelIndication", od->audioProfileLevelIndication );
+        isom_json_field_uint( stream, "visualProfileLevelIndication", od->visualProfileLevelIndication );
+        isom_json_field_uint( stream, "graphicsProfileLevelIndication", od->graphicsProfileLevelIndication );
+    }
+}
+
+/* Put a descriptor and its children as an object.  The caller puts the key or the separator before it. */
+void mp4sys_json_descriptor( struct print_stream_tag *stream, mp4sys_descriptor_t *descriptor )
+{
+    isom_json_begin( stream, '{' );
+    isom_json_field_uint( stream, "tag", descriptor->header.tag );
+    isom_json_field_uint( stream, "expandableClassSize", descriptor->header.size );
+    switch( descriptor->header.tag )
+    {
+        case MP4SYS_DESCRIPTOR_TAG_ObjectDescrTag        :
+        case MP4SYS_DESCRIPTOR_TAG_InitialObjectDescrTag :
+        case MP4SYS_DESCRIPTOR_TAG_MP4_OD_Tag            :
+        case MP4SYS_DESCRIPTOR_TAG_MP4_IOD_Tag           :
+            mp4sys_json_ObjectDescriptor( stream, descriptor );
+            break;
+        case MP4SYS_DESCRIPTOR_TAG_ES_DescrTag :
+            mp4sys_json_ES_Descriptor( stream, descriptor );
+            break;
+        case MP4SYS_DESCRIPTOR_TAG_DecoderConfigDescrTag :
+            mp4sys_json_DecoderConfigDescriptor( stream, descriptor );
+            break;
+        case MP4SYS_DESCRIPTOR_TAG_DecSpecificInfoTag :
+        {
+            mp4sys_DecoderSpecificInfo_t *dsi = (mp4sys_DecoderSpecificInfo_t *)descriptor;
+            if( dsi->data )
+                isom_json_field_bytes( stream, "data", dsi->data, dsi->header.size );
+            break;
+        }
+        case MP4SYS_DESCRIPTOR_TAG_SLConfigDescrTag :
+            mp4sys_json_SLConfigDescriptor( stream, descriptor );
+            break;
+        case MP4SYS_DESCRIPTOR_TAG_ES_ID_IncTag :
+            isom_json_field_uint( stream, "Track_ID", ((mp4sys_ES_ID_Inc_t *)descriptor)->Track_ID );
+            break;
+        default :
+            break;
+    }
+    if( descriptor->children.head )
+    {
+        isom_json_key( stream, "children" );
+        isom_json_begin( stream, '[' );
+        for( lsmash_entry_t *entry = descriptor->children.head; entry; entry = entry->next )
+            if( entry->data )
+            {
+                isom_json_separate( stream );
+                mp4sys_json_descriptor( stream, entry->data );
+            }
+        isom_json_end( stream, ']' );
+    }
+    isom_json_end( stream, '}' );
+}
+
+void mp4sys_json_codec_specific( struct print_stream_tag *stream, lsmash_file_t *file, isom_box_t *box )
+{
+    isom_esds_t *esds = (isom_esds_t *)box;
+    if( !esds->ES )
+        return;
+    isom_json_key( stream, "descriptor" );
+    mp4sys_json_descriptor( stream, (mp4sys_descriptor_t *)esds->ES );
+}
+
 mp4sys_descriptor_t *mp4sys_get_descriptor( lsmash_bs_t *bs, void *parent );
 
 static void mp4sys_get_descriptor_header( lsmash_bs_t *bs, mp4sys_descriptor_head_t *header )
@@ -1305,60 +1462,143 @@ mp4sys_descriptor_t *mp4sys_get_descriptor( lsmash_bs_t *bs, void *parent )
     return desc;
 }
 
-static uint8_t *mp4sys_export_DecoderSpecificInfo( mp4sys_ES_Descriptor_t *esd, uint32_t *dsi_payload_length )
+/* Flat view of a serialized ES_Descriptor.
+ * Only the fields needed for lsmash_mp4sys_decoder_parameters_t are decoded, and the payload of
+ * DecoderSpecificInfo references the original bytes instead of being copied into a descriptor tree. */
+typedef struct
 {
-    if( !esd || !esd->decConfigDescr || !esd->decConfigDescr->decSpecificInfo )
+    lsmash_mp4sys_object_type_indication objectTypeIndication;
+    lsmash_mp4sys_stream_type            streamType;
+    uint32_t bufferSizeDB;
+    uint32_t maxBitrate;
+    uint32_t avgBitrate;
+    uint8_t *dsi_payload;
+    uint32_t dsi_payload_length;
+} mp4sys_ES_Descriptor_view_t;
+
+static uint8_t *mp4sys_view_descriptor_header( uint8_t *pos, uint8_t *end, mp4sys_descriptor_head_t *header )
+{
+    if( end - pos < 2 )
         return NULL;
-    mp4sys_DecoderSpecificInfo_t *dsi = (mp4sys_DecoderSpecificInfo_t *)esd->decConfigDescr->decSpecificInfo;
-    uint8_t *dsi_payload = NULL;
-    /* DecoderSpecificInfo can be absent. */
-    if( dsi->header.size )
+    header->tag = *pos++;
+    uint32_t sizeOfInstance = 0;
+    uint8_t  temp;
+    do
     {
-        dsi_payload = lsmash_memdup( dsi->data, dsi->header.size );
-        if( !dsi_payload )
+        if( pos >= end )
             return NULL;
+        temp = *pos++;
+        sizeOfInstance = (sizeOfInstance << 7) | (temp & 0x7F);
+    } while( temp & 0x80 );
+    if( sizeOfInstance > end - pos )
+        return NULL;
+    header->size = sizeOfInstance;
+    return pos;
+}
+
+static int mp4sys_view_ES_Descriptor( uint8_t *data, uint64_t size, mp4sys_ES_Descriptor_view_t *view )
+{
+    memset( view, 0, sizeof(mp4sys_ES_Descriptor_view_t) );
+    mp4sys_descriptor_head_t header;
+    uint8_t *pos = mp4sys_view_descriptor_header( data, data + size, &header );
+    if( !pos || header.tag != MP4SYS_DESCRIPTOR_TAG_ES_DescrTag || header.size < 3 )
+        return LSMASH_ERR_INVALID_DATA;
+    uint8_t *end   = pos + header.size;
+    uint8_t  flags = pos[2];
+    pos += 3;
+    if( flags & 0x80 )
+        pos += 2;   /* dependsOn_ES_ID */
+    if( (flags & 0x40) && pos < end )
+        pos += 1 + *pos;    /* URLlength and URLstring */
+    if( flags & 0x20 )
+        pos += 2;   /* OCR_ES_Id */
+    int has_dcd = 0;
+    while( pos < end )
+    {
+        pos = mp4sys_view_descriptor_header( pos, end, &header );
+        if( !pos )
+            break;
+        uint8_t *next = pos + header.size;
+        if( header.tag == MP4SYS_DESCRIPTOR_TAG_DecoderConfigDescrTag )
+        {
+            if( header.size < 13 )
+                break;
+            view->objectTypeIndication = pos[0];
+            view->streamType           = (pos[1] >> 2) & 0x3F;
+            view->bufferSizeDB         = LSMASH_GET_BE24( &pos[2] );
+            view->maxBitrate           = LSMASH_GET_BE32( &pos[5] );
+            view->avgBitrate           = LSMASH_GET_BE32( &pos[9] );
+            view->dsi_payload          = NULL;
+            view->dsi_payload_length   = 0;
+            for( pos += 13; pos < next; pos += header.size )
+            {
+                pos = mp4sys_view_descriptor_header( pos, next, &header );
+                if( !pos )
+                    break;
+                if( header.tag == MP4SYS_DESCRIPTOR_TAG_DecSpecificInfoTag )
+                {
+                    view->dsi_payload        = header.size ? pos : NULL;
+                    view->dsi_payload_length = header.size;
+                }
+            }
+            has_dcd = 1;
+        }
+        pos = next;
+    }
+    return has_dcd ? 0 : LSMASH_ERR_INVALID_DATA;
+}
+
+static int mp4sys_view_decoder_config( lsmash_codec_specific_t *src, mp4sys_ES_Descriptor_view_t *view )
+{
+    assert( src && src->data.unstructured );
+    if( src->size < ISOM_FULLBOX_COMMON_SIZE + 23 )
+        return LSMASH_ERR_INVALID_DATA;
+    uint8_t *data = src->data.unstructured;
+    uint64_t size = LSMASH_GET_BE32( data );
+    data += ISOM_BASEBOX_COMMON_SIZE;
+    if( size == 1 )
+    {
+        size = LSMASH_GET_BE64( data );
+        data += 8;
     }
-    if( dsi_payload_length )
-        *dsi_payload_length = dsi->header.size;
-    return dsi_payload;
+    if( size != src->size )
+        return LSMASH_ERR_INVALID_DATA;
+    data += 4;  /* Skip version and flags. */
+    return mp4sys_view_ES_Descriptor( data, src->size - (data - src->data.unstructured), view );
 }
 
 /* Sumamry is needed to decide ProfileLevelIndication.
  * Currently, support audio's only. */
 int mp4sys_setup_summary_from_DecoderSpecificInfo( lsmash_audio_summary_t *summary, mp4sys_ES_Descriptor_t *esd )
 {
-    uint32_t dsi_payload_length = UINT32_MAX;       /* arbitrary */
-    uint8_t *dsi_payload = mp4sys_export_DecoderSpecificInfo( esd, &dsi_payload_length );
-    if( !dsi_payload && dsi_payload_length )
+    if( !esd || !esd->decConfigDescr || !esd->decConfigDescr->decSpecificInfo )
+        return LSMASH_ERR_NAMELESS;
+    mp4sys_DecoderConfigDescriptor_t *dcd = esd->decConfigDescr;
+    mp4sys_DecoderSpecificInfo_t     *dsi = dcd->decSpecificInfo;
+    /* DecoderSpecificInfo can be absent. */
+    if( dsi->header.size == 0 )
+        return 0;
+    if( !dsi->data )
         return LSMASH_ERR_NAMELESS;
-    int err = 0;
-    if( dsi_payload_length )
+    lsmash_codec_specific_t *cs = lsmash_create_codec_specific_data( LSMASH_CODEC_SPECIFIC_DATA_TYPE_MP4SYS_DECODER_CONFIG,
+                                                                     LSMASH_CODEC_SPECIFIC_FORMAT_STRUCTURED );
+    if( !cs )
+        return LSMASH_ERR_MEMORY_ALLOC;
+    lsmash_mp4sys_decoder_parameters_t *params = (lsmash_mp4sys_decoder_parameters_t *)cs->data.structured;
+    params->objectTypeIndication = dcd->objectTypeIndication;
+    params->streamType           = dcd->streamType;
+    params->bufferSizeDB         = dcd->bufferSizeDB;
+    params->maxBitrate           = dcd->maxBitrate;
+    params->avgBitrate           = dcd->avgBitrate;
+    int err;
+    if( (err = mp4a_setup_summary_from_AudioSpecificConfig( summary, dsi->data, dsi->header.size )) < 0
+     || (err = lsmash_set_mp4sys_decoder_specific_info( params, dsi->data, dsi->header.size ))      < 0
+     || (err = lsmash_add_entry( &summary->opaque->list, cs ))                                      < 0 )
     {
-        lsmash_codec_specific_t *cs = lsmash_create_codec_specific_data( LSMASH_CODEC_SPECIFIC_DATA_TYPE_MP4SYS_DECODER_CONFIG,
-                                                                         LSMASH_CODEC_SPECIFIC_FORMAT_STRUCTURED );
-        if( !cs )
-        {
-            err = LSMASH_ERR_MEMORY_ALLOC;
-            goto fail;
-        }
-        lsmash_mp4sys_decoder_parameters_t *params = (lsmash_mp4sys_decoder_parameters_t *)cs->data.structured;
-        mp4sys_DecoderConfigDescriptor_t   *dcd    = esd->decConfigDescr;
-        params->objectTypeIndication = dcd->objectTypeIndication;
-        params->streamType           = dcd->streamType;
-        params->bufferSizeDB         = dcd->bufferSizeDB;
-        params->maxBitrate           = dcd->maxBitrate;
-        params->avgBitrate           = dcd->avgBitrate;
-        if( (err = mp4a_setup_summary_from_AudioSpecificConfig( summary, dsi_payload, dsi_payload_length )) < 0
-         || (err = lsmash_set_mp4sys_decoder_specific_info( params, dsi_payload, dsi_payload_length ))      < 0
-         || (err = lsmash_add_entry( &summary->opaque->list, cs ))                                          < 0 )
-        {
-            lsmash_destroy_codec_specific_data( cs );
-            goto fail;
-        }
+        lsmash_destroy_codec_specific_data( cs );
+        return err;
     }
-fail:
-    lsmash_free( dsi_payload );
-    return err;
+    return 0;
 }
 
 /**** following functions are for facilitation purpose ****/
@@ -1419,6 +1659,7 @@ int lsmash_set_mp4sys_decoder_specific_info( lsmash_mp4sys_decoder_parameters_t
     else
     {
         lsmash_freep( &param->dsi->payload );
+        lsmash_freep( &param->dsi->cached_esds );
         param->dsi->payload_length = 0;
     }
     param->dsi->payload = lsmash_memdup( payload, payload_length );
@@ -1433,6 +1674,7 @@ void lsmash_destroy_mp4sys_decoder_specific_info( lsmash_mp4sys_decoder_paramete
     if( !param || !param->dsi )
         return;
     lsmash_free( param->dsi->payload );
+    lsmash_free( param->dsi->cached_esds );
     lsmash_freep( &param->dsi );
 }
 
@@ -1448,6 +1690,16 @@ uint8_t *lsmash_create_mp4sys_decoder_config( lsmash_mp4sys_decoder_parameters_t
 {
     if( !param || !data_length )
         return NULL;
+    lsmash_mp4sys_decoder_specific_info_t *dsi = param->dsi;
+    if( dsi && dsi->cached_esds
+     && !memcmp( &dsi->cached_param, param, sizeof(lsmash_mp4sys_decoder_parameters_t) ) )
+    {
+        /* Nothing has changed since the last serialization. */
+        uint8_t *data = lsmash_memdup( dsi->cached_esds, dsi->cached_esds_length );
+        if( data )
+            *data_length = dsi->cached_esds_length;
+        return data;
+    }
     mp4sys_ES_Descriptor_params_t esd_param = { 0 };
     esd_param.ES_ID                = 0; /* Within sample description, ES_ID is stored as 0. */
     esd_param.objectTypeIndication = param->objectTypeIndication;
@@ -1483,55 +1735,37 @@ uint8_t *lsmash_create_mp4sys_decoder_config( lsmash_mp4sys_decoder_parameters_t
         return NULL;
     /* Update box size. */
     LSMASH_SET_BE32( data, *data_length );
+    /* Keep the serialized form for the next request.
+     * Only parameters carrying DecoderSpecificInfo have somewhere to keep it. */
+    if( dsi )
+    {
+        lsmash_freep( &dsi->cached_esds );
+        dsi->cached_esds = lsmash_memdup( data, *data_length );
+        if( dsi->cached_esds )
+        {
+            dsi->cached_esds_length = *data_length;
+            memcpy( &dsi->cached_param, param, sizeof(lsmash_mp4sys_decoder_parameters_t) );
+        }
+    }
     return data;
 }
 
 int mp4sys_construct_decoder_config( lsmash_codec_specific_t *dst, lsmash_codec_specific_t *src )
 {
     assert( dst && dst->data.structured && src && src->data.unstructured );
-    if( src->size < ISOM_FULLBOX_COMMON_SIZE + 23 )
-        return LSMASH_ERR_INVALID_DATA;
-    lsmash_mp4sys_decoder_parameters_t *param = (lsmash_mp4sys_decoder_parameters_t *)dst->data.structured;
-    uint8_t *data = src->data.unstructured;
-    uint64_t size = LSMASH_GET_BE32( data );
-    data += ISOM_BASEBOX_COMMON_SIZE;
-    if( size == 1 )
-    {
-        size = LSMASH_GET_BE64( data );
-        data += 8;
-    }
-    if( size != src->size )
-        return LSMASH_ERR_INVALID_DATA;
-    data += 4;  /* Skip version and flags. */
-    lsmash_bs_t *bs = lsmash_bs_create();
-    if( !bs )
-        return LSMASH_ERR_MEMORY_ALLOC;
-    int err = lsmash_bs_import_data( bs, data, src->size - (data - src->data.unstructured) );
+    mp4sys_ES_Descriptor_view_t view;
+    int err = mp4sys_view_decoder_config( src, &view );
     if( err < 0 )
-    {
-        lsmash_bs_cleanup( bs );
         return err;
-    }
-    mp4sys_ES_Descriptor_t *esd = (mp4sys_ES_Descriptor_t *)mp4sys_get_descriptor( bs, NULL );
-    lsmash_bs_cleanup( bs );
-    if( !esd || esd->header.tag != MP4SYS_DESCRIPTOR_TAG_ES_DescrTag || !esd->decConfigDescr )
-        return LSMASH_ERR_INVALID_DATA;
-    mp4sys_DecoderConfigDescriptor_t *dcd = esd->decConfigDescr;
-    param->objectTypeIndication = dcd->objectTypeIndication;
-    param->streamType           = dcd->streamType;
-    param->bufferSizeDB         = dcd->bufferSizeDB;
-    param->maxBitrate           = dcd->maxBitrate;
-    param->avgBitrate           = dcd->avgBitrate;
-    mp4sys_DecoderSpecificInfo_t *dsi = dcd->decSpecificInfo;
-    if( dsi
-     && dsi->header.size
-     && dsi->data
-     && (err = lsmash_set_mp4sys_decoder_specific_info( param, dsi->data, dsi->header.size )) < 0 )
-    {
-        mp4sys_remove_descriptor( esd );
+    lsmash_mp4sys_decoder_parameters_t *param = (lsmash_mp4sys_decoder_parameters_t *)dst->data.structured;
+    param->objectTypeIndication = view.objectTypeIndication;
+    param->streamType           = view.streamType;
+    param->bufferSizeDB         = view.bufferSizeDB;
+    param->maxBitrate           = view.maxBitrate;
+    param->avgBitrate           = view.avgBitrate;
+    if( view.dsi_payload
+     && (err = lsmash_set_mp4sys_decoder_specific_info( param, view.dsi_payload, view.dsi_payload_length )) < 0 )
         return err;
-    }
-    mp4sys_remove_descriptor( esd );
     return 0;
 }
 
@@ -1563,11 +1797,11 @@ lsmash_mp4sys_object_type_indication lsmash_mp4sys_get_object_type_indication( l
         objectTypeIndication = ((lsmash_mp4sys_decoder_parameters_t *)orig->data.structured)->objectTypeIndication;
     else
     {
-        lsmash_codec_specific_t *conv = lsmash_convert_codec_specific_format( orig, LSMASH_CODEC_SPECIFIC_FORMAT_STRUCTURED );
-        if( !conv )
+        /* Peek at the serialized descriptor directly instead of converting the whole configuration. */
+        mp4sys_ES_Descriptor_view_t view;
+        if( mp4sys_view_decoder_config( orig, &view ) < 0 )
             return MP4SYS_OBJECT_TYPE_Forbidden;
-        objectTypeIndication = ((lsmash_mp4sys_decoder_parameters_t *)conv->data.structured)->objectTypeIndication;
-        lsmash_destroy_codec_specific_data( conv );
+        objectTypeIndication = view.objectTypeIndication;
     }
     return objectTypeIndication;
 }
@@ -141,6 +141,11 @@ struct lsmash_mp4sys_decoder_specific_info_tag
 {
     uint8_t *payload;
     uint32_t payload_length;
+    /* ES Descriptor Box serialized from the payload above and 'cached_param'.
+     * This is discarded whenever the payload is replaced. */
+    lsmash_mp4sys_decoder_parameters_t cached_param;
+    uint8_t                           *cached_esds;
+    uint32_t                           cached_esds_length;
 };
 
 #ifndef MP4SYS_INTERNAL
@@ -176,6 +181,14 @@ int mp4sys_update_DecoderConfigDescriptor
     uint32_t                avgBitrate
 );
 
+int mp4sys_fetch_DecoderConfigDescriptor
+(
+    mp4sys_ES_Descriptor_t *esd,
+    uint32_t               *bufferSizeDB,
+    uint32_t               *maxBitrate,
+    uint32_t               *avgBitrate
+);
+
 uint32_t mp4sys_update_descriptor_size( mp4sys_descriptor_t *descriptor );
 int mp4sys_write_descriptor( lsmash_bs_t *bs, mp4sys_descriptor_t *descriptor );
 void mp4sys_print_descriptor( FILE *fp, mp4sys_descriptor_t *descriptor, int indent );
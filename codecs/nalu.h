@@ -97,6 +97,46 @@ static inline uint8_t *nalu_remove_emulation_prevention
     return dst;
 }
 
+/* Get payloadType and payloadSize of the sei_message() starting at 'pos'.
+ * Return the address of the payload if the whole payload lies before 'end', or NULL otherwise.
+ * Since every sei_message() is byte aligned, payloads can be skipped by their size without decoding. */
+static inline uint8_t *nalu_get_sei_payload
+(
+    uint8_t  *pos,
+    uint8_t  *end,
+    uint32_t *payloadType,
+    uint32_t *payloadSize
+)
+{
+    uint32_t value[2] = { 0, 0 };
+    for( int i = 0; i < 2; i++ )
+        do
+        {
+            /* 0xff     : ff_byte
+             * otherwise: last_payload_type_byte or last_payload_size_byte */
+            if( pos >= end )
+                return NULL;
+            value[i] += *pos;
+        } while( *pos++ == 0xff );
+    if( value[1] > end - pos )
+        return NULL;
+    *payloadType = value[0];
+    *payloadSize = value[1];
+    return pos;
+}
+
+/* Move the bit reader to the byte at 'offset' of the imported data. */
+static inline void nalu_seek_bits
+(
+    lsmash_bits_t *bits,
+    uint64_t       offset
+)
+{
+    bits->store = 0;
+    bits->cache = 0;
+    bits->bs->buffer.pos = offset;
+}
+
 static inline int nalu_import_rbsp_from_ebsp
 (
     lsmash_bits_t *bits,
@@ -202,7 +242,7 @@ static inline int nalu_get_dcr_ps
 {
     for( uint8_t i = 0; i < entry_count; i++ )
     {
-        isom_dcr_ps_entry_t *data = lsmash_malloc( sizeof(isom_dcr_ps_entry_t) );
+        isom_dcr_ps_entry_t *data = lsmash_malloc_zero( sizeof(isom_dcr_ps_entry_t) );
         if( !data )
             return LSMASH_ERR_MEMORY_ALLOC;
         if( lsmash_add_entry( list, data ) < 0 )
@@ -27,6 +27,7 @@
 #include <inttypes.h>
 
 #include "core/box.h"
+#include "core/print.h"
 
 /***************************************************************************
     SMPTE 421M-2006
@@ -34,6 +35,8 @@
 ***************************************************************************/
 #include "vc1.h"
 
+#define VC1_PICTURE_HEADER_PEEK_SIZE 8  /* enough bytes to get fcm and ptype/fptype even if emulation prevention bytes are there */
+
 struct lsmash_vc1_header_tag
 {
     uint8_t *ebdu;
@@ -145,24 +148,8 @@ uint64_t vc1_find_next_start_code_prefix
      && 0x000001 == lsmash_bs_show_be24( bs, 0 ) )
     {
         *bdu_type = lsmash_bs_show_byte( bs, VC1_START_CODE_PREFIX_LENGTH );
-        length = VC1_START_CODE_LENGTH;
         /* Find the start code of the next EBDU and get the length of the latest EBDU. */
-        int no_more = lsmash_bs_is_end( bs, length + VC1_START_CODE_LENGTH - 1 );
-        if( !no_more )
-        {
-            uint32_t sync_bytes = lsmash_bs_show_be24( bs, length );
-            while( 0x000001 != sync_bytes )
-            {
-                no_more = lsmash_bs_is_end( bs, ++length + VC1_START_CODE_LENGTH - 1 );
-                if( no_more )
-                    break;
-                sync_bytes <<= 8;
-                sync_bytes  |= lsmash_bs_show_byte( bs, length + VC1_START_CODE_PREFIX_LENGTH - 1 );
-                sync_bytes  &= 0xFFFFFF;
-            }
-        }
-        if( no_more )
-            length = lsmash_bs_get_remaining_buffer_size( bs );
+        length = lsmash_bs_find_start_code_prefix( bs, VC1_START_CODE_LENGTH );
         /* Any EBDU has no consecutive zero bytes at the end. */
         while( 0x00 == lsmash_bs_show_byte( bs, length - 1 ) )
         {
@@ -473,7 +460,10 @@ int vc1_parse_advanced_picture( lsmash_bits_t *bits,
                                 vc1_sequence_header_t *sequence, vc1_picture_info_t *picture,
                                 uint8_t *rbdu_buffer, uint8_t *ebdu, uint64_t ebdu_size )
 {
-    int err = vc1_import_rbdu_from_ebdu( bits, rbdu_buffer, ebdu + VC1_START_CODE_LENGTH, ebdu_size );
+    /* Only the first few bits of the picture layer are needed here.
+     * Don't convert the whole EBDU, which is as large as the coded picture. */
+    int err = vc1_import_rbdu_from_ebdu( bits, rbdu_buffer, ebdu + VC1_START_CODE_LENGTH,
+                                         LSMASH_MIN( ebdu_size - VC1_START_CODE_LENGTH, VC1_PICTURE_HEADER_PEEK_SIZE ) );
     if( err < 0 )
         return err;
     if( sequence->interlace )
@@ -492,6 +482,7 @@ int vc1_parse_advanced_picture( lsmash_bits_t *bits,
 void vc1_update_au_property( vc1_access_unit_t *access_unit, vc1_picture_info_t *picture )
 {
     access_unit->random_accessible = picture->random_accessible;
+    access_unit->start_of_sequence = picture->start_of_sequence;
     access_unit->closed_gop        = picture->closed_gop;
     /* I-picture
      *      Be coded using information only from itself. (independent)
@@ -963,3 +954,29 @@ int vc1_print_codec_specific( FILE *fp, lsmash_file_t *file, isom_box_t *box, in
     }
     return 0;
 }
+
+void vc1_json_codec_specific( struct print_stream_tag *stream, lsmash_file_t *file, isom_box_t *box )
+{
+    assert( stream && file && box && (box->manager & LSMASH_BINARY_CODED_BOX) );
+    if( box->size < ISOM_BASEBOX_COMMON_SIZE + 7 )
+        return;
+    uint8_t *data = box->binary;
+    isom_skip_box_common( &data );
+    uint8_t profile = (data[0] >> 4) & 0x0F;
+    if( profile != 12 )
+        return;     /* We don't support profile other than 12 (Advanced profile). */
+    isom_json_field_uint( stream, "profile", profile );
+    /* The level appears twice; the second one is put as "level2" to keep the keys unique. */
+    isom_json_field_uint( stream, "level", (data[0] >> 1) & 0x07 );
+    isom_json_field_uint( stream, "level2", (data[1] >> 5) & 0x07 );
+    isom_json_field_uint( stream, "cbr", (data[1] >> 4) & 0x01 );
+    isom_json_field_uint( stream, "no_interlace", (data[2] >> 5) & 0x01 );
+    isom_json_field_uint( stream, "no_multiple_seq", (data[2] >> 4) & 0x01 );
+    isom_json_field_uint( stream, "no_multiple_entry", (data[2] >> 3) & 0x01 );
+    isom_json_field_uint( stream, "no_slice_code", (data[2] >> 2) & 0x01 );
+    isom_json_field_uint( stream, "no_bframe", (data[2] >> 1) & 0x01 );
+    isom_json_field_uint( stream, "framerate", LSMASH_GET_BE32( &data[3] ) );
+    uint32_t seqhdr_ephdr_size = box->size - (data - box->binary + 7);
+    if( seqhdr_ephdr_size )
+        isom_json_field_bytes( stream, "seqhdr_ephdr", data + 7, seqhdr_ephdr_size );
+}
@@ -72,6 +72,7 @@ typedef struct
 typedef struct
 {
     uint8_t  random_accessible;
+    uint8_t  start_of_sequence;
     uint8_t  closed_gop;
     uint8_t  independent;
     uint8_t  non_bipredictive;
@@ -25,6 +25,7 @@
 #include <inttypes.h>
 
 #include "core/box.h"
+#include "core/print.h"
 
 #define WFEX_BOX_MIN_LENGTH 26
 
@@ -84,3 +85,33 @@ int wma_print_codec_specific( FILE *fp, lsmash_file_t *file, isom_box_t *box, in
     }
     return 0;
 }
+
+void wma_json_codec_specific( struct print_stream_tag *stream, lsmash_file_t *file, isom_box_t *box )
+{
+    assert( stream && file && box && (box->manager & LSMASH_BINARY_CODED_BOX) );
+    if( box->size < WFEX_BOX_MIN_LENGTH )
+        return;
+    uint8_t *data = box->binary;
+    isom_skip_box_common( &data );
+    uint16_t wFormatTag = LSMASH_GET_LE16( &data[0] );
+    uint16_t cbSize     = LSMASH_GET_BYTE( &data[16] );
+    isom_json_field_uint( stream, "wFormatTag",      wFormatTag );
+    isom_json_field_uint( stream, "nChannels",       LSMASH_GET_LE16( &data[ 2] ) );
+    isom_json_field_uint( stream, "nSamplesPerSec",  LSMASH_GET_LE32( &data[ 4] ) );
+    isom_json_field_uint( stream, "nAvgBytesPerSec", LSMASH_GET_LE32( &data[ 8] ) );
+    isom_json_field_uint( stream, "nBlockAlign",     LSMASH_GET_LE16( &data[12] ) );
+    isom_json_field_uint( stream, "wBitsPerSample",  LSMASH_GET_LE16( &data[14] ) );
+    isom_json_field_uint( stream, "cbSize",          cbSize );
+    if( wFormatTag == WAVE_FORMAT_TAG_ID_WMA_V2 && cbSize >= 10 )
+    {
+        isom_json_field_uint( stream, "dwSamplesPerBlock", LSMASH_GET_LE32( &data[18] ) );
+        isom_json_field_uint( stream, "wEncodeOptions",    LSMASH_GET_LE16( &data[22] ) );
+        isom_json_field_uint( stream, "dwSuperBlockAlign", LSMASH_GET_LE32( &data[24] ) );
+    }
+    else if( wFormatTag == WAVE_FORMAT_TAG_ID_WMA_V3 && cbSize >= 18 )
+    {
+        isom_json_field_uint( stream, "wValidBitsPerSample", LSMASH_GET_LE16( &data[18] ) );
+        isom_json_field_uint( stream, "dwChannelMask",       LSMASH_GET_LE32( &data[20] ) );
+        isom_json_field_uint( stream, "wEncodeOptions",      LSMASH_GET_LE16( &data[32] ) );
+    }
+}
@@ -450,6 +450,33 @@ uint64_t lsmash_bs_show_be64( lsmash_bs_t *bs, uint32_t offset )
          | ((uint64_t)lsmash_bs_show_byte( bs, offset + 7 ));
 }
 
+uint64_t lsmash_bs_find_start_code_prefix( lsmash_bs_t *bs, uint64_t offset )
+{
+    while( 1 )
+    {
+        /* The prefix and the following byte at 'offset' shall be on the buffer. */
+        if( lsmash_bs_is_end( bs, offset + 3 ) || bs->error )
+            return lsmash_bs_get_remaining_buffer_size( bs );
+        /* Search the last byte (0x01) of the prefix on the buffer.
+         * Any prefix found here is followed by at least one byte. */
+        uint8_t *data = lsmash_bs_get_buffer_data( bs );
+        uint64_t size = lsmash_bs_get_remaining_buffer_size( bs );
+        uint8_t *pos  = data + offset + 2;
+        uint8_t *end  = data + size - 1;
+        while( pos < end && (pos = memchr( pos, 0x01, end - pos )) != NULL )
+        {
+            if( pos[-1] == 0x00 && pos[-2] == 0x00 )
+                return pos - 2 - data;
+            /* The next prefix can't end within the next two bytes since they are preceded by a non-zero byte. */
+            pos += 3;
+        }
+        /* Not found on the buffer. Read more data from the stream and continue the search
+         * from the position where a prefix might straddle the end of the current buffer. */
+        offset = size - 3;
+        lsmash_bs_show_byte( bs, size );
+    }
+}
+
 uint8_t lsmash_bs_get_byte( lsmash_bs_t *bs )
 {
     if( bs->eob || bs->error )
@@ -129,6 +129,10 @@ uint16_t lsmash_bs_show_be16( lsmash_bs_t *bs, uint32_t offset );
 uint32_t lsmash_bs_show_be24( lsmash_bs_t *bs, uint32_t offset );
 uint32_t lsmash_bs_show_be32( lsmash_bs_t *bs, uint32_t offset );
 uint64_t lsmash_bs_show_be64( lsmash_bs_t *bs, uint32_t offset );
+/* Find the first 3-byte start code prefix (0x000001) followed by at least one byte at or after 'offset'
+ * from the current position on the buffer, and return the offset to it.
+ * Return the size of the remaining data on the buffer if not found until the end of the stream. */
+uint64_t lsmash_bs_find_start_code_prefix( lsmash_bs_t *bs, uint64_t offset );
 uint8_t lsmash_bs_get_byte( lsmash_bs_t *bs );
 void lsmash_bs_skip_bytes( lsmash_bs_t *bs, uint32_t size );
 void lsmash_bs_skip_bytes_64( lsmash_bs_t *bs, uint64_t size );
@@ -161,6 +161,23 @@ lsmash_entry_t *lsmash_get_entry( lsmash_entry_list_t *list, uint32_t entry_numb
     }
     else
         shortcut = 0;
+    if( !shortcut && list->last_accessed_entry )
+    {
+        /* Look for from the last accessed entry if it is the nearest. */
+        uint32_t last     = list->last_accessed_number;
+        uint32_t distance = entry_number > last ? entry_number - last : last - entry_number;
+        if( distance < entry_number && distance <= list->entry_count - entry_number )
+        {
+            entry = list->last_accessed_entry;
+            if( entry_number > last )
+                while( entry && distance-- )
+                    entry = entry->next;
+            else
+                while( entry && distance-- )
+                    entry = entry->prev;
+            shortcut = 1;
+        }
+    }
     if( !shortcut )
     {
         if( entry_number <= (list->entry_count >> 1) )
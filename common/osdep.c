@@ -65,3 +65,22 @@ FILE *lsmash_win32_fopen( const char *name, const char *mode )
 
 #endif
 
+#ifdef _WIN32
+void lsmash_call_once( lsmash_once_t *once, void (*func)( void ) )
+{
+    /* 0: not called yet, 1: being called, 2: done */
+    if( InterlockedCompareExchange( &once->state, 1, 0 ) == 0 )
+    {
+        func();
+        InterlockedExchange( &once->state, 2 );
+        return;
+    }
+    while( InterlockedCompareExchange( &once->state, 2, 2 ) != 2 )
+        Sleep( 0 );
+}
+#else
+void lsmash_call_once( lsmash_once_t *once, void (*func)( void ) )
+{
+    pthread_once( once, func );
+}
+#endif
@@ -52,6 +52,27 @@
 #  define lsmash_fopen fopen
 #endif
 
+/* one-time initialization
+ * lsmash_call_once() calls 'func' only the first time for each 'once' even if threads call it at the same time,
+ * and no caller returns until the call has completed.
+ * Lazily initialized static tables must be set up through it so that independent ROOTs can be used concurrently. */
+#ifdef _WIN32
+   typedef struct { volatile long state; } lsmash_once_t;
+#  define LSMASH_ONCE_INIT { 0 }
+#else
+#  include <pthread.h>
+   typedef pthread_once_t lsmash_once_t;
+#  define LSMASH_ONCE_INIT PTHREAD_ONCE_INIT
+#endif
+void lsmash_call_once( lsmash_once_t *once, void (*func)( void ) );
+
+/* reentrant string tokenizer */
+#ifdef _WIN32
+#  define lsmash_strtok_r strtok_s
+#else
+#  define lsmash_strtok_r strtok_r
+#endif
+
 #ifdef _WIN32
 #  include <wchar.h>
    int lsmash_string_to_wchar( int cp, const char *from, wchar_t **to );
@@ -0,0 +1,2 @@
+#define LSMASH_REV "29"
+#define LSMASH_GIT_HASH "37258e3"
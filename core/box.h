@@ -89,6 +89,22 @@ struct lsmash_box_tag
     ISOM_FULLBOX_COMMON;
 };
 
+/* ID-indexed lookup table of the boxes in a list such as trak_list, trex_list and traf_list
+ * This is an open addressing hash table keyed by the track_ID of each box and rebuilt from the list on demand.
+ * The table is rebuilt when the number of entries in the list has changed or the table has been invalidated,
+ * so removing a box from the list or changing the track_ID of a box in the list requires isom_invalidate_id_index(). */
+typedef struct
+{
+    struct
+    {
+        uint32_t  ID;
+        void     *box;
+    }        *slot;
+    uint32_t  size;             /* the number of slots; always a power of 2 */
+    uint32_t  indexed_count;    /* the number of entries in the list when the table was built */
+    int       dirty;
+} isom_id_index_t;
+
 /* Unknown Box
  * This structure is for boxes we don't know or define yet.
  * This box must be always appended as an extension box. */
@@ -1393,6 +1409,10 @@ typedef struct
 {
     isom_group_assignment_entry_t *assignment;      /* the address corresponding to the entry in Sample to Group Box */
     isom_sgpd_t                   *sgpd;            /* the address to the active Sample Group Description Box */
+    isom_roll_entry_t             *description;     /* the address corresponding to the roll recovery entry in Sample Group Description Box */
+    lsmash_entry_t                *assignment_entry;/* the entry holding 'assignment' in the list of Sample to Group Box */
+    lsmash_entry_t                *pending_entry;   /* the entry holding this group in the list of groups whose roll_distance is not determined yet */
+    uint32_t number;                                /* the order of creation of the group */
     uint32_t first_sample;                          /* the number of the first sample of the group */
     uint32_t recovery_point;                        /* the identifier necessary for the recovery from its starting point to be completed */
     uint64_t rp_cts;                                /* the CTS of the recovery point */
@@ -1406,11 +1426,17 @@ typedef struct
 #define ROLL_DISTANCE_INITIALIZED 1
 #define ROLL_DISTANCE_DETERMINED  2
     uint8_t  described;                             /* the status of the group description */
+    uint8_t  established;                           /* the flag if the group description is set up */
 } isom_roll_group_t;
 
 typedef struct
 {
-    lsmash_entry_list_t *pool;  /* grouping pooled to delimit and describe */
+    lsmash_entry_list_t *pool;          /* grouping pooled to delimit and describe */
+    lsmash_entry_list_t *pending;       /* groups in the pool whose roll_distance is not determined yet, in order of the pool */
+    isom_roll_group_t  **ready;         /* groups which have got delimited and determined since the last flush of the pool */
+    uint32_t             ready_count;
+    uint32_t             ready_alloc;
+    uint32_t             group_count;   /* the number of groups created so far */
 } isom_grouping_t;
 
 typedef struct
@@ -1542,6 +1568,8 @@ typedef struct
     ISOM_BASEBOX_COMMON;
     isom_mehd_t         *mehd;          /* Movie Extends Header Box / omitted when used in live streaming */
     lsmash_entry_list_t  trex_list;     /* Track Extends Box */
+
+        isom_id_index_t  trex_index;
 } isom_mvex_t;
 
 /* Movie Fragment Header Box
@@ -1636,6 +1664,8 @@ typedef struct
     ISOM_BASEBOX_COMMON;
     isom_mfhd_t         *mfhd;          /* Movie Fragment Header Box */
     lsmash_entry_list_t  traf_list;     /* Track Fragment Box List */
+
+        isom_id_index_t  traf_index;
 } isom_moof_t;
 
 /* Track Fragment Random Access Box
@@ -1740,6 +1770,8 @@ typedef struct
     isom_ctab_t         *ctab;          /* ISOM: null / QTFF: Color Table Box */
     isom_meta_t         *meta;          /* Meta Box */
     isom_mvex_t         *mvex;          /* Movie Extends Box */
+
+        isom_id_index_t  trak_index;
 } isom_moov_t;
 
 /** Segments
@@ -1876,6 +1908,7 @@ struct lsmash_file_tag
         lsmash_bs_t             *bs;        /* bytestream manager */
         isom_fragment_manager_t *fragment;  /* movie fragment manager */
         lsmash_entry_list_t     *print;
+        struct print_stream_tag *print_stream;  /* printer of boxes while reading */
         lsmash_entry_list_t     *timeline;
         lsmash_file_t           *initializer;
         struct importer_tag     *importer;
@@ -1916,8 +1949,26 @@ struct lsmash_root_tag
 {
     ISOM_FULLBOX_COMMON;            /* The 'file' field contains the address of the current active file. */
     lsmash_entry_list_t file_list;  /* the list of all files the ROOT contains */
+    lsmash_trace_callbacks_t trace; /* the tracing callbacks */
 };
 
+#ifndef LSMASH_DISABLE_TRACE
+static inline void isom_trace_begin( lsmash_root_t *root, lsmash_trace_phase phase )
+{
+    if( root && root->trace.begin )
+        root->trace.begin( root->trace.opaque, phase );
+}
+
+static inline void isom_trace_end( lsmash_root_t *root, lsmash_trace_phase phase, uint64_t bytes, uint64_t samples )
+{
+    if( root && root->trace.end )
+        root->trace.end( root->trace.opaque, phase, bytes, samples );
+}
+#else
+#define isom_trace_begin( root, phase )                ((void)(root))
+#define isom_trace_end( root, phase, bytes, samples )  ((void)(root), (void)(bytes), (void)(samples))
+#endif
+
 /** **/
 
 /* Box types
@@ -2547,7 +2598,8 @@ int isom_check_large_offset_requirement( isom_moov_t *moov, uint64_t meta_size )
 void isom_add_preceding_box_size( isom_moov_t *moov, uint64_t preceding_size );
 int isom_establish_movie( lsmash_file_t *file );
 int isom_rap_grouping_established( isom_rap_group_t *group, int num_leading_samples_known, isom_sgpd_t *sgpd, int is_fragment );
-int isom_all_recovery_completed( isom_sbgp_t *sbgp, lsmash_entry_list_t *pool );
+int isom_all_recovery_completed( isom_sbgp_t *sbgp, isom_grouping_t *roll );
+void isom_remove_roll_grouping( isom_grouping_t *roll );
 
 lsmash_file_t *isom_add_file( lsmash_root_t *root );
 isom_ftyp_t *isom_add_ftyp( lsmash_file_t *file );
@@ -2659,4 +2711,8 @@ isom_box_t *isom_get_extension_box( lsmash_entry_list_t *extensions, lsmash_box_
 void *isom_get_extension_box_format( lsmash_entry_list_t *extensions, lsmash_box_type_t box_type );
 void isom_remove_box_by_itself( void *opaque_box );
 
+typedef uint32_t (*isom_id_getter_t)( void *box );
+void *isom_lookup_id_index( isom_id_index_t *index, lsmash_entry_list_t *list, uint32_t ID, isom_id_getter_t get_ID );
+#define isom_invalidate_id_index( index ) ((index)->dirty = 1)
+
 #endif
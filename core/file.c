@@ -446,6 +446,13 @@ int lsmash_open_file
         memcpy( mode, "rb", 3 );
         file_mode = LSMASH_FILE_MODE_READ;
     }
+    else if( open_mode == 2 )
+    {
+        if( !strcmp( filename, "-" ) )
+            return LSMASH_ERR_FUNCTION_PARAM;
+        memcpy( mode, "r+b", 4 );
+        file_mode = LSMASH_FILE_MODE_READ;
+    }
     if( file_mode == 0 )
         return LSMASH_ERR_FUNCTION_PARAM;
 #ifdef _WIN32
@@ -587,9 +594,15 @@ int64_t lsmash_read_file
             return (int64_t)LSMASH_ERR_MEMORY_ALLOC;
         file->importer = importer;
         lsmash_importer_set_file( importer, file );
+        isom_trace_begin( file->root, LSMASH_TRACE_PHASE_READ_FILE );
         ret = lsmash_importer_find( importer, "ISOBMFF/QTFF", !file->bs->unseekable );
+        isom_trace_end( file->root, LSMASH_TRACE_PHASE_READ_FILE, 0, 0 );
         if( ret < 0 )
             return ret;
+        /* Printing while reading is done only by the reader of ISOBMFF/QTFF.
+         * Another importer may accept a file without any box, e.g. an empty file. */
+        if( file->print_stream && !(file->flags & LSMASH_FILE_MODE_BOX) )
+            return (int64_t)LSMASH_ERR_INVALID_DATA;
         if( param )
         {
             if( file->ftyp )
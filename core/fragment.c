@@ -45,6 +45,16 @@ static isom_sidx_t *isom_get_sidx( lsmash_file_t *file, uint32_t reference_ID )
 
 static int isom_finish_fragment_movie( lsmash_file_t *file );
 
+static int isom_flush_fragment_movie( lsmash_file_t *file )
+{
+    uint64_t pool_size    = file->fragment ? file->fragment->pool_size    : 0;
+    uint64_t sample_count = file->fragment ? file->fragment->sample_count : 0;
+    isom_trace_begin( file->root, LSMASH_TRACE_PHASE_FRAGMENT_FLUSH );
+    int ret = isom_finish_fragment_movie( file );
+    isom_trace_end( file->root, LSMASH_TRACE_PHASE_FRAGMENT_FLUSH, pool_size, sample_count );
+    return ret;
+}
+
 /* A movie fragment cannot switch a sample description to another.
  * So you must call this function before switching sample descriptions. */
 int lsmash_create_fragment_movie( lsmash_root_t *root )
@@ -57,7 +67,7 @@ int lsmash_create_fragment_movie( lsmash_root_t *root )
      || !file->fragment )
         return LSMASH_ERR_NAMELESS;
     /* Finish and write the current movie fragment before starting a new one. */
-    int ret = isom_finish_fragment_movie( file );
+    int ret = isom_flush_fragment_movie( file );
     if( ret < 0 )
         return ret;
     /* Add a new movie fragment if the current one is not present or not written. */
@@ -328,7 +338,10 @@ static int isom_write_segment_indexes
     /* Rearrange subsequent data. */
     uint64_t write_pos = bs->offset;
     uint64_t total     = file->size + total_sidx_size;
-    if( (ret = isom_rearrange_data( file, remux, buf, read_num, size, read_pos, write_pos, total )) < 0 )
+    isom_trace_begin( file->root, LSMASH_TRACE_PHASE_REARRANGE );
+    ret = isom_rearrange_data( file, remux, buf, read_num, size, read_pos, write_pos, total );
+    isom_trace_end( file->root, LSMASH_TRACE_PHASE_REARRANGE, total - write_pos, 0 );
+    if( ret < 0 )
         goto fail;
     file->size += total_sidx_size;
     lsmash_freep( &buf[0] );
@@ -361,7 +374,7 @@ int isom_finish_final_fragment_movie
 {
     /* Output the final movie fragment. */
     int ret;
-    if( (ret = isom_finish_fragment_movie( file )) < 0 )
+    if( (ret = isom_flush_fragment_movie( file )) < 0 )
         return ret;
     if( file->bs->unseekable )
         return 0;
@@ -555,7 +568,7 @@ static int isom_finish_fragment_initial_movie( lsmash_file_t *file )
             isom_sbgp_t *sbgp = isom_get_roll_recovery_sample_to_group( &stbl->sbgp_list );
             if( !sbgp )
                 return LSMASH_ERR_NAMELESS;
-            if( (ret = isom_all_recovery_completed( sbgp, trak->cache->roll.pool )) < 0 )
+            if( (ret = isom_all_recovery_completed( sbgp, &trak->cache->roll )) < 0 )
                 return ret;
         }
     }
@@ -1002,7 +1015,7 @@ static int isom_finish_fragment_movie
             isom_sbgp_t *sbgp = isom_get_roll_recovery_sample_to_group( &traf->sbgp_list );
             if( !sbgp )
                 return LSMASH_ERR_NAMELESS;
-            if( (ret = isom_all_recovery_completed( sbgp, traf->cache->roll.pool )) < 0 )
+            if( (ret = isom_all_recovery_completed( sbgp, &traf->cache->roll )) < 0 )
                 return ret;
         }
     }
@@ -1297,7 +1310,7 @@ static int isom_output_fragment_cache( isom_traf_t *traf )
                 isom_sbgp_t *sbgp = isom_get_roll_recovery_sample_to_group( &traf->sbgp_list );
                 if( !sbgp )
                     return LSMASH_ERR_NAMELESS;
-                if( (ret = isom_all_recovery_completed( sbgp, cache->roll.pool )) < 0 )
+                if( (ret = isom_all_recovery_completed( sbgp, &cache->roll )) < 0 )
                     return ret;
                 break;
             default :
@@ -1381,7 +1394,7 @@ static int isom_update_fragment_previous_sample_duration( isom_traf_t *traf, iso
     return 0;
 }
 
-static isom_sample_flags_t isom_generate_fragment_sample_flags( lsmash_sample_t *sample )
+isom_sample_flags_t isom_generate_fragment_sample_flags( lsmash_sample_t *sample )
 {
     isom_sample_flags_t flags;
     flags.reserved                    = 0;
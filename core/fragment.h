@@ -52,3 +52,8 @@ int isom_append_fragment_sample
     lsmash_sample_t     *sample,
     isom_sample_entry_t *sample_entry
 );
+
+isom_sample_flags_t isom_generate_fragment_sample_flags
+(
+    lsmash_sample_t *sample
+);
@@ -25,6 +25,7 @@
 
 #include <stdlib.h>
 #include <string.h>
+#include <limits.h>
 #include <inttypes.h>
 
 #include "box.h"
@@ -48,6 +49,21 @@ int isom_check_initializer_present( lsmash_root_t *root )
     return 0;
 }
 
+static uint32_t isom_get_trak_ID( isom_trak_t *trak )
+{
+    return trak->tkhd ? trak->tkhd->track_ID : 0;
+}
+
+static uint32_t isom_get_trex_ID( isom_trex_t *trex )
+{
+    return trex->track_ID;
+}
+
+static uint32_t isom_get_traf_ID( isom_traf_t *traf )
+{
+    return traf->tfhd ? traf->tfhd->track_ID : 0;
+}
+
 isom_trak_t *isom_get_trak( lsmash_file_t *file, uint32_t track_ID )
 {
     if( track_ID == 0
@@ -55,47 +71,22 @@ isom_trak_t *isom_get_trak( lsmash_file_t *file, uint32_t track_ID )
      ||  file != file->initializer
      || !file->moov )
         return NULL;
-    for( lsmash_entry_t *entry = file->moov->trak_list.head; entry; entry = entry->next )
-    {
-        isom_trak_t *trak = (isom_trak_t *)entry->data;
-        if( !trak
-         || !trak->tkhd )
-            return NULL;
-        if( trak->tkhd->track_ID == track_ID )
-            return trak;
-    }
-    return NULL;
+    isom_moov_t *moov = file->moov;
+    return isom_lookup_id_index( &moov->trak_index, &moov->trak_list, track_ID, (isom_id_getter_t)isom_get_trak_ID );
 }
 
 isom_trex_t *isom_get_trex( isom_mvex_t *mvex, uint32_t track_ID )
 {
     if( track_ID == 0 || !mvex )
         return NULL;
-    for( lsmash_entry_t *entry = mvex->trex_list.head; entry; entry = entry->next )
-    {
-        isom_trex_t *trex = (isom_trex_t *)entry->data;
-        if( !trex )
-            return NULL;
-        if( trex->track_ID == track_ID )
-            return trex;
-    }
-    return NULL;
+    return isom_lookup_id_index( &mvex->trex_index, &mvex->trex_list, track_ID, (isom_id_getter_t)isom_get_trex_ID );
 }
 
 isom_traf_t *isom_get_traf( isom_moof_t *moof, uint32_t track_ID )
 {
     if( track_ID == 0 || !moof )
         return NULL;
-    for( lsmash_entry_t *entry = moof->traf_list.head; entry; entry = entry->next )
-    {
-        isom_traf_t *traf = (isom_traf_t *)entry->data;
-        if( !traf
-         || !traf->tfhd )
-            return NULL;
-        if( traf->tfhd->track_ID == track_ID )
-            return traf;
-    }
-    return NULL;
+    return isom_lookup_id_index( &moof->traf_index, &moof->traf_list, track_ID, (isom_id_getter_t)isom_get_traf_ID );
 }
 
 isom_tfra_t *isom_get_tfra( isom_mfra_t *mfra, uint32_t track_ID )
@@ -159,6 +150,120 @@ void isom_remove_dcr_ps( isom_dcr_ps_entry_t *ps )
     lsmash_free( ps );
 }
 
+typedef void (*opaque_func_t)( void );
+
+static struct description_setup_table_tag
+{
+    lsmash_codec_type_t type;
+    opaque_func_t       func;
+} description_setup_table[160] = { { LSMASH_CODEC_TYPE_INITIALIZER, NULL } };
+static lsmash_once_t description_setup_table_once = LSMASH_ONCE_INIT;
+
+static void isom_init_description_setup_table( void )
+{
+    int i = 0;
+#define ADD_DESCRIPTION_SETUP_TABLE_ELEMENT( type, func ) \
+    description_setup_table[i++] = (struct description_setup_table_tag){ type, (opaque_func_t)func }
+    ADD_DESCRIPTION_SETUP_TABLE_ELEMENT( ISOM_CODEC_TYPE_AVC1_VIDEO, isom_setup_visual_description );
+    ADD_DESCRIPTION_SETUP_TABLE_ELEMENT( ISOM_CODEC_TYPE_AVC2_VIDEO, isom_setup_visual_description );
+    ADD_DESCRIPTION_SETUP_TABLE_ELEMENT( ISOM_CODEC_TYPE_AVC3_VIDEO, isom_setup_visual_description );
+    ADD_DESCRIPTION_SETUP_TABLE_ELEMENT( ISOM_CODEC_TYPE_AVC4_VIDEO, isom_setup_visual_description );
+    ADD_DESCRIPTION_SETUP_TABLE_ELEMENT( ISOM_CODEC_TYPE_HVC1_VIDEO, isom_setup_visual_description );
+    ADD_DESCRIPTION_SETUP_TABLE_ELEMENT( ISOM_CODEC_TYPE_HEV1_VIDEO, isom_setup_visual_description );
+#if 0
+    ADD_DESCRIPTION_SETUP_TABLE_ELEMENT( ISOM_CODEC_TYPE_AVCP_VIDEO, isom_setup_visual_description );
+    ADD_DESCRIPTION_SETUP_TABLE_ELEMENT( ISOM_CODEC_TYPE_SVC1_VIDEO, isom_setup_visual_description );
+    ADD_DESCRIPTION_SETUP_TABLE_ELEMENT( ISOM_CODEC_TYPE_MVC1_VIDEO, isom_setup_visual_description );
+    ADD_DESCRIPTION_SETUP_TABLE_ELEMENT( ISOM_CODEC_TYPE_MVC2_VIDEO, isom_setup_visual_description );
+    ADD_DESCRIPTION_SETUP_TABLE_ELEMENT( ISOM_CODEC_TYPE_MP4V_VIDEO, isom_setup_visual_description );
+    ADD_DESCRIPTION_SETUP_TABLE_ELEMENT( ISOM_CODEC_TYPE_DRAC_VIDEO, isom_setup_visual_description );
+    ADD_DESCRIPTION_SETUP_TABLE_ELEMENT( ISOM_CODEC_TYPE_ENCV_VIDEO, isom_setup_visual_description );
+    ADD_DESCRIPTION_SETUP_TABLE_ELEMENT( ISOM_CODEC_TYPE_MJP2_VIDEO, isom_setup_visual_description );
+    ADD_DESCRIPTION_SETUP_TABLE_ELEMENT( ISOM_CODEC_TYPE_S263_VIDEO, isom_setup_visual_description );
+#endif
+    ADD_DESCRIPTION_SETUP_TABLE_ELEMENT( ISOM_CODEC_TYPE_VC_1_VIDEO, isom_setup_visual_description );
+    ADD_DESCRIPTION_SETUP_TABLE_ELEMENT( QT_CODEC_TYPE_2VUY_VIDEO, isom_setup_visual_description );
+    ADD_DESCRIPTION_SETUP_TABLE_ELEMENT( QT_CODEC_TYPE_APCH_VIDEO, isom_setup_visual_description );
+    ADD_DESCRIPTION_SETUP_TABLE_ELEMENT( QT_CODEC_TYPE_APCN_VIDEO, isom_setup_visual_description );
+    ADD_DESCRIPTION_SETUP_TABLE_ELEMENT( QT_CODEC_TYPE_APCS_VIDEO, isom_setup_visual_description );
+    ADD_DESCRIPTION_SETUP_TABLE_ELEMENT( QT_CODEC_TYPE_APCO_VIDEO, isom_setup_visual_description );
+    ADD_DESCRIPTION_SETUP_TABLE_ELEMENT( QT_CODEC_TYPE_AP4H_VIDEO, isom_setup_visual_description );
+    ADD_DESCRIPTION_SETUP_TABLE_ELEMENT( QT_CODEC_TYPE_AP4X_VIDEO, isom_setup_visual_description );
+    ADD_DESCRIPTION_SETUP_TABLE_ELEMENT( QT_CODEC_TYPE_DVC_VIDEO,  isom_setup_visual_description );
+    ADD_DESCRIPTION_SETUP_TABLE_ELEMENT( QT_CODEC_TYPE_DVCP_VIDEO, isom_setup_visual_description );
+    ADD_DESCRIPTION_SETUP_TABLE_ELEMENT( QT_CODEC_TYPE_DVPP_VIDEO, isom_setup_visual_description );
+    ADD_DESCRIPTION_SETUP_TABLE_ELEMENT( QT_CODEC_TYPE_DV5N_VIDEO, isom_setup_visual_description );
+    ADD_DESCRIPTION_SETUP_TABLE_ELEMENT( QT_CODEC_TYPE_DV5P_VIDEO, isom_setup_visual_description );
+    ADD_DESCRIPTION_SETUP_TABLE_ELEMENT( QT_CODEC_TYPE_DVH2_VIDEO, isom_setup_visual_description );
+    ADD_DESCRIPTION_SETUP_TABLE_ELEMENT( QT_CODEC_TYPE_DVH3_VIDEO, isom_setup_visual_description );
+    ADD_DESCRIPTION_SETUP_TABLE_ELEMENT( QT_CODEC_TYPE_DVH5_VIDEO, isom_setup_visual_description );
+    ADD_DESCRIPTION_SETUP_TABLE_ELEMENT( QT_CODEC_TYPE_DVH6_VIDEO, isom_setup_visual_description );
+    ADD_DESCRIPTION_SETUP_TABLE_ELEMENT( QT_CODEC_TYPE_DVHP_VIDEO, isom_setup_visual_description );
+    ADD_DESCRIPTION_SETUP_TABLE_ELEMENT( QT_CODEC_TYPE_DVHQ_VIDEO, isom_setup_visual_description );
+    ADD_DESCRIPTION_SETUP_TABLE_ELEMENT( QT_CODEC_TYPE_ULRA_VIDEO, isom_setup_visual_description );
+    ADD_DESCRIPTION_SETUP_TABLE_ELEMENT( QT_CODEC_TYPE_ULRG_VIDEO, isom_setup_visual_description );
+    ADD_DESCRIPTION_SETUP_TABLE_ELEMENT( QT_CODEC_TYPE_ULY2_VIDEO, isom_setup_visual_description );
+    ADD_DESCRIPTION_SETUP_TABLE_ELEMENT( QT_CODEC_TYPE_ULY0_VIDEO, isom_setup_visual_description );
+    ADD_DESCRIPTION_SETUP_TABLE_ELEMENT( QT_CODEC_TYPE_ULH2_VIDEO, isom_setup_visual_description );
+    ADD_DESCRIPTION_SETUP_TABLE_ELEMENT( QT_CODEC_TYPE_ULH0_VIDEO, isom_setup_visual_description );
+    ADD_DESCRIPTION_SETUP_TABLE_ELEMENT( QT_CODEC_TYPE_UQY2_VIDEO, isom_setup_visual_description );
+    ADD_DESCRIPTION_SETUP_TABLE_ELEMENT( QT_CODEC_TYPE_V210_VIDEO, isom_setup_visual_description );
+    ADD_DESCRIPTION_SETUP_TABLE_ELEMENT( QT_CODEC_TYPE_V216_VIDEO, isom_setup_visual_description );
+    ADD_DESCRIPTION_SETUP_TABLE_ELEMENT( QT_CODEC_TYPE_V308_VIDEO, isom_setup_visual_description );
+    ADD_DESCRIPTION_SETUP_TABLE_ELEMENT( QT_CODEC_TYPE_V408_VIDEO, isom_setup_visual_description );
+    ADD_DESCRIPTION_SETUP_TABLE_ELEMENT( QT_CODEC_TYPE_V410_VIDEO, isom_setup_visual_description );
+    ADD_DESCRIPTION_SETUP_TABLE_ELEMENT( QT_CODEC_TYPE_YUV2_VIDEO, isom_setup_visual_description );
+    ADD_DESCRIPTION_SETUP_TABLE_ELEMENT( ISOM_CODEC_TYPE_MP4A_AUDIO, isom_setup_audio_description );
+    ADD_DESCRIPTION_SETUP_TABLE_ELEMENT( ISOM_CODEC_TYPE_AC_3_AUDIO, isom_setup_audio_description );
+    ADD_DESCRIPTION_SETUP_TABLE_ELEMENT( ISOM_CODEC_TYPE_ALAC_AUDIO, isom_setup_audio_description );
+    ADD_DESCRIPTION_SETUP_TABLE_ELEMENT( ISOM_CODEC_TYPE_EC_3_AUDIO, isom_setup_audio_description );
+    ADD_DESCRIPTION_SETUP_TABLE_ELEMENT( ISOM_CODEC_TYPE_SAMR_AUDIO, isom_setup_audio_description );
+    ADD_DESCRIPTION_SETUP_TABLE_ELEMENT( ISOM_CODEC_TYPE_SAWB_AUDIO, isom_setup_audio_description );
+    ADD_DESCRIPTION_SETUP_TABLE_ELEMENT( ISOM_CODEC_TYPE_DTSC_AUDIO, isom_setup_audio_description );
+    ADD_DESCRIPTION_SETUP_TABLE_ELEMENT( ISOM_CODEC_TYPE_DTSE_AUDIO, isom_setup_audio_description );
+    ADD_DESCRIPTION_SETUP_TABLE_ELEMENT( ISOM_CODEC_TYPE_DTSH_AUDIO, isom_setup_audio_description );
+    ADD_DESCRIPTION_SETUP_TABLE_ELEMENT( ISOM_CODEC_TYPE_DTSL_AUDIO, isom_setup_audio_description );
+#if 0
+    ADD_DESCRIPTION_SETUP_TABLE_ELEMENT( ISOM_CODEC_TYPE_DRA1_AUDIO, isom_setup_audio_description );
+    ADD_DESCRIPTION_SETUP_TABLE_ELEMENT( ISOM_CODEC_TYPE_ENCA_AUDIO, isom_setup_audio_description );
+    ADD_DESCRIPTION_SETUP_TABLE_ELEMENT( ISOM_CODEC_TYPE_G719_AUDIO, isom_setup_audio_description );
+    ADD_DESCRIPTION_SETUP_TABLE_ELEMENT( ISOM_CODEC_TYPE_G726_AUDIO, isom_setup_audio_description );
+    ADD_DESCRIPTION_SETUP_TABLE_ELEMENT( ISOM_CODEC_TYPE_M4AE_AUDIO, isom_setup_audio_description );
+    ADD_DESCRIPTION_SETUP_TABLE_ELEMENT( ISOM_CODEC_TYPE_MLPA_AUDIO, isom_setup_audio_description );
+    ADD_DESCRIPTION_SETUP_TABLE_ELEMENT( ISOM_CODEC_TYPE_RAW_AUDIO,  isom_setup_audio_description );
+    ADD_DESCRIPTION_SETUP_TABLE_ELEMENT( ISOM_CODEC_TYPE_SAWP_AUDIO, isom_setup_audio_description );
+    ADD_DESCRIPTION_SETUP_TABLE_ELEMENT( ISOM_CODEC_TYPE_SEVC_AUDIO, isom_setup_audio_description );
+    ADD_DESCRIPTION_SETUP_TABLE_ELEMENT( ISOM_CODEC_TYPE_SQCP_AUDIO, isom_setup_audio_description );
+    ADD_DESCRIPTION_SETUP_TABLE_ELEMENT( ISOM_CODEC_TYPE_SSMV_AUDIO, isom_setup_audio_description );
+    ADD_DESCRIPTION_SETUP_TABLE_ELEMENT( ISOM_CODEC_TYPE_TWOS_AUDIO, isom_setup_audio_description );
+#endif
+    ADD_DESCRIPTION_SETUP_TABLE_ELEMENT( QT_CODEC_TYPE_MP4A_AUDIO,    isom_setup_audio_description );
+    ADD_DESCRIPTION_SETUP_TABLE_ELEMENT( QT_CODEC_TYPE_MAC3_AUDIO,    isom_setup_audio_description );
+    ADD_DESCRIPTION_SETUP_TABLE_ELEMENT( QT_CODEC_TYPE_MAC6_AUDIO,    isom_setup_audio_description );
+    ADD_DESCRIPTION_SETUP_TABLE_ELEMENT( QT_CODEC_TYPE_AGSM_AUDIO,    isom_setup_audio_description );
+    ADD_DESCRIPTION_SETUP_TABLE_ELEMENT( QT_CODEC_TYPE_ALAW_AUDIO,    isom_setup_audio_description );
+    ADD_DESCRIPTION_SETUP_TABLE_ELEMENT( QT_CODEC_TYPE_ULAW_AUDIO,    isom_setup_audio_description );
+    ADD_DESCRIPTION_SETUP_TABLE_ELEMENT( QT_CODEC_TYPE_FULLMP3_AUDIO, isom_setup_audio_description );
+    ADD_DESCRIPTION_SETUP_TABLE_ELEMENT( QT_CODEC_TYPE_ADPCM2_AUDIO,  isom_setup_audio_description );
+    ADD_DESCRIPTION_SETUP_TABLE_ELEMENT( QT_CODEC_TYPE_ADPCM17_AUDIO, isom_setup_audio_description );
+    ADD_DESCRIPTION_SETUP_TABLE_ELEMENT( QT_CODEC_TYPE_GSM49_AUDIO,   isom_setup_audio_description );
+    ADD_DESCRIPTION_SETUP_TABLE_ELEMENT( QT_CODEC_TYPE_NONE_AUDIO,    isom_setup_audio_description );
+    ADD_DESCRIPTION_SETUP_TABLE_ELEMENT( QT_CODEC_TYPE_LPCM_AUDIO,    isom_setup_audio_description );
+    ADD_DESCRIPTION_SETUP_TABLE_ELEMENT( QT_CODEC_TYPE_SOWT_AUDIO,    isom_setup_audio_description );
+    ADD_DESCRIPTION_SETUP_TABLE_ELEMENT( QT_CODEC_TYPE_TWOS_AUDIO,    isom_setup_audio_description );
+    ADD_DESCRIPTION_SETUP_TABLE_ELEMENT( QT_CODEC_TYPE_FL32_AUDIO,    isom_setup_audio_description );
+    ADD_DESCRIPTION_SETUP_TABLE_ELEMENT( QT_CODEC_TYPE_FL64_AUDIO,    isom_setup_audio_description );
+    ADD_DESCRIPTION_SETUP_TABLE_ELEMENT( QT_CODEC_TYPE_IN24_AUDIO,    isom_setup_audio_description );
+    ADD_DESCRIPTION_SETUP_TABLE_ELEMENT( QT_CODEC_TYPE_IN32_AUDIO,    isom_setup_audio_description );
+    ADD_DESCRIPTION_SETUP_TABLE_ELEMENT( QT_CODEC_TYPE_23NI_AUDIO,    isom_setup_audio_description );
+    ADD_DESCRIPTION_SETUP_TABLE_ELEMENT( QT_CODEC_TYPE_NOT_SPECIFIED, isom_setup_audio_description );
+    ADD_DESCRIPTION_SETUP_TABLE_ELEMENT( ISOM_CODEC_TYPE_TX3G_TEXT, isom_add_tx3g_description );
+    ADD_DESCRIPTION_SETUP_TABLE_ELEMENT( QT_CODEC_TYPE_TEXT_TEXT,   isom_add_qt_text_description );
+#if 0
+    ADD_DESCRIPTION_SETUP_TABLE_ELEMENT( ISOM_CODEC_TYPE_MP4S_SYSTEM, isom_add_mp4s_entry );
+#endif
+}
+
 /* This function returns 0 if failed, sample_entry_number if succeeded. */
 int lsmash_add_sample_entry( lsmash_root_t *root, uint32_t track_ID, void *summary )
 {
@@ -186,116 +291,7 @@ int lsmash_add_sample_entry( lsmash_root_t *root, uint32_t track_ID, void *summa
             ret = isom_setup_audio_description( stsd, sample_type, (lsmash_audio_summary_t *)summary );
         return ret < 0 ? 0 : list->entry_count;
     }
-typedef void (*opaque_func_t)( void );
-    static struct description_setup_table_tag
-    {
-        lsmash_codec_type_t type;
-        opaque_func_t       func;
-    } description_setup_table[160] = { { LSMASH_CODEC_TYPE_INITIALIZER, NULL } };
-    if( !description_setup_table[0].func )
-    {
-        int i = 0;
-#define ADD_DESCRIPTION_SETUP_TABLE_ELEMENT( type, func ) \
-    description_setup_table[i++] = (struct description_setup_table_tag){ type, (opaque_func_t)func }
-        ADD_DESCRIPTION_SETUP_TABLE_ELEMENT( ISOM_CODEC_TYPE_AVC1_VIDEO, isom_setup_visual_description );
-        ADD_DESCRIPTION_SETUP_TABLE_ELEMENT( ISOM_CODEC_TYPE_AVC2_VIDEO, isom_setup_visual_description );
-        ADD_DESCRIPTION_SETUP_TABLE_ELEMENT( ISOM_CODEC_TYPE_AVC3_VIDEO, isom_setup_visual_description );
-        ADD_DESCRIPTION_SETUP_TABLE_ELEMENT( ISOM_CODEC_TYPE_AVC4_VIDEO, isom_setup_visual_description );
-        ADD_DESCRIPTION_SETUP_TABLE_ELEMENT( ISOM_CODEC_TYPE_HVC1_VIDEO, isom_setup_visual_description );
-        ADD_DESCRIPTION_SETUP_TABLE_ELEMENT( ISOM_CODEC_TYPE_HEV1_VIDEO, isom_setup_visual_description );
-#if 0
-        ADD_DESCRIPTION_SETUP_TABLE_ELEMENT( ISOM_CODEC_TYPE_AVCP_VIDEO, isom_setup_visual_description );
-        ADD_DESCRIPTION_SETUP_TABLE_ELEMENT( ISOM_CODEC_TYPE_SVC1_VIDEO, isom_setup_visual_description );
-        ADD_DESCRIPTION_SETUP_TABLE_ELEMENT( ISOM_CODEC_TYPE_MVC1_VIDEO, isom_setup_visual_description );
-        ADD_DESCRIPTION_SETUP_TABLE_ELEMENT( ISOM_CODEC_TYPE_MVC2_VIDEO, isom_setup_visual_description );
-        ADD_DESCRIPTION_SETUP_TABLE_ELEMENT( ISOM_CODEC_TYPE_MP4V_VIDEO, isom_setup_visual_description );
-        ADD_DESCRIPTION_SETUP_TABLE_ELEMENT( ISOM_CODEC_TYPE_DRAC_VIDEO, isom_setup_visual_description );
-        ADD_DESCRIPTION_SETUP_TABLE_ELEMENT( ISOM_CODEC_TYPE_ENCV_VIDEO, isom_setup_visual_description );
-        ADD_DESCRIPTION_SETUP_TABLE_ELEMENT( ISOM_CODEC_TYPE_MJP2_VIDEO, isom_setup_visual_description );
-        ADD_DESCRIPTION_SETUP_TABLE_ELEMENT( ISOM_CODEC_TYPE_S263_VIDEO, isom_setup_visual_description );
-#endif
-        ADD_DESCRIPTION_SETUP_TABLE_ELEMENT( ISOM_CODEC_TYPE_VC_1_VIDEO, isom_setup_visual_description );
-        ADD_DESCRIPTION_SETUP_TABLE_ELEMENT( QT_CODEC_TYPE_2VUY_VIDEO, isom_setup_visual_description );
-        ADD_DESCRIPTION_SETUP_TABLE_ELEMENT( QT_CODEC_TYPE_APCH_VIDEO, isom_setup_visual_description );
-        ADD_DESCRIPTION_SETUP_TABLE_ELEMENT( QT_CODEC_TYPE_APCN_VIDEO, isom_setup_visual_description );
-        ADD_DESCRIPTION_SETUP_TABLE_ELEMENT( QT_CODEC_TYPE_APCS_VIDEO, isom_setup_visual_description );
-        ADD_DESCRIPTION_SETUP_TABLE_ELEMENT( QT_CODEC_TYPE_APCO_VIDEO, isom_setup_visual_description );
-        ADD_DESCRIPTION_SETUP_TABLE_ELEMENT( QT_CODEC_TYPE_AP4H_VIDEO, isom_setup_visual_description );
-        ADD_DESCRIPTION_SETUP_TABLE_ELEMENT( QT_CODEC_TYPE_AP4X_VIDEO, isom_setup_visual_description );
-        ADD_DESCRIPTION_SETUP_TABLE_ELEMENT( QT_CODEC_TYPE_DVC_VIDEO,  isom_setup_visual_description );
-        ADD_DESCRIPTION_SETUP_TABLE_ELEMENT( QT_CODEC_TYPE_DVCP_VIDEO, isom_setup_visual_description );
-        ADD_DESCRIPTION_SETUP_TABLE_ELEMENT( QT_CODEC_TYPE_DVPP_VIDEO, isom_setup_visual_description );
-        ADD_DESCRIPTION_SETUP_TABLE_ELEMENT( QT_CODEC_TYPE_DV5N_VIDEO, isom_setup_visual_description );
-        ADD_DESCRIPTION_SETUP_TABLE_ELEMENT( QT_CODEC_TYPE_DV5P_VIDEO, isom_setup_visual_description );
-        ADD_DESCRIPTION_SETUP_TABLE_ELEMENT( QT_CODEC_TYPE_DVH2_VIDEO, isom_setup_visual_description );
-        ADD_DESCRIPTION_SETUP_TABLE_ELEMENT( QT_CODEC_TYPE_DVH3_VIDEO, isom_setup_visual_description );
-        ADD_DESCRIPTION_SETUP_TABLE_ELEMENT( QT_CODEC_TYPE_DVH5_VIDEO, isom_setup_visual_description );
-        ADD_DESCRIPTION_SETUP_TABLE_ELEMENT( QT_CODEC_TYPE_DVH6_VIDEO, isom_setup_visual_description );
-        ADD_DESCRIPTION_SETUP_TABLE_ELEMENT( QT_CODEC_TYPE_DVHP_VIDEO, isom_setup_visual_description );
-        ADD_DESCRIPTION_SETUP_TABLE_ELEMENT( QT_CODEC_TYPE_DVHQ_VIDEO, isom_setup_visual_description );
-        ADD_DESCRIPTION_SETUP_TABLE_ELEMENT( QT_CODEC_TYPE_ULRA_VIDEO, isom_setup_visual_description );
-        ADD_DESCRIPTION_SETUP_TABLE_ELEMENT( QT_CODEC_TYPE_ULRG_VIDEO, isom_setup_visual_description );
-        ADD_DESCRIPTION_SETUP_TABLE_ELEMENT( QT_CODEC_TYPE_ULY2_VIDEO, isom_setup_visual_description );
-        ADD_DESCRIPTION_SETUP_TABLE_ELEMENT( QT_CODEC_TYPE_ULY0_VIDEO, isom_setup_visual_description );
-        ADD_DESCRIPTION_SETUP_TABLE_ELEMENT( QT_CODEC_TYPE_ULH2_VIDEO, isom_setup_visual_description );
-        ADD_DESCRIPTION_SETUP_TABLE_ELEMENT( QT_CODEC_TYPE_ULH0_VIDEO, isom_setup_visual_description );
-        ADD_DESCRIPTION_SETUP_TABLE_ELEMENT( QT_CODEC_TYPE_UQY2_VIDEO, isom_setup_visual_description );
-        ADD_DESCRIPTION_SETUP_TABLE_ELEMENT( QT_CODEC_TYPE_V210_VIDEO, isom_setup_visual_description );
-        ADD_DESCRIPTION_SETUP_TABLE_ELEMENT( QT_CODEC_TYPE_V216_VIDEO, isom_setup_visual_description );
-        ADD_DESCRIPTION_SETUP_TABLE_ELEMENT( QT_CODEC_TYPE_V308_VIDEO, isom_setup_visual_description );
-        ADD_DESCRIPTION_SETUP_TABLE_ELEMENT( QT_CODEC_TYPE_V408_VIDEO, isom_setup_visual_description );
-        ADD_DESCRIPTION_SETUP_TABLE_ELEMENT( QT_CODEC_TYPE_V410_VIDEO, isom_setup_visual_description );
-        ADD_DESCRIPTION_SETUP_TABLE_ELEMENT( QT_CODEC_TYPE_YUV2_VIDEO, isom_setup_visual_description );
-        ADD_DESCRIPTION_SETUP_TABLE_ELEMENT( ISOM_CODEC_TYPE_MP4A_AUDIO, isom_setup_audio_description );
-        ADD_DESCRIPTION_SETUP_TABLE_ELEMENT( ISOM_CODEC_TYPE_AC_3_AUDIO, isom_setup_audio_description );
-        ADD_DESCRIPTION_SETUP_TABLE_ELEMENT( ISOM_CODEC_TYPE_ALAC_AUDIO, isom_setup_audio_description );
-        ADD_DESCRIPTION_SETUP_TABLE_ELEMENT( ISOM_CODEC_TYPE_EC_3_AUDIO, isom_setup_audio_description );
-        ADD_DESCRIPTION_SETUP_TABLE_ELEMENT( ISOM_CODEC_TYPE_SAMR_AUDIO, isom_setup_audio_description );
-        ADD_DESCRIPTION_SETUP_TABLE_ELEMENT( ISOM_CODEC_TYPE_SAWB_AUDIO, isom_setup_audio_description );
-        ADD_DESCRIPTION_SETUP_TABLE_ELEMENT( ISOM_CODEC_TYPE_DTSC_AUDIO, isom_setup_audio_description );
-        ADD_DESCRIPTION_SETUP_TABLE_ELEMENT( ISOM_CODEC_TYPE_DTSE_AUDIO, isom_setup_audio_description );
-        ADD_DESCRIPTION_SETUP_TABLE_ELEMENT( ISOM_CODEC_TYPE_DTSH_AUDIO, isom_setup_audio_description );
-        ADD_DESCRIPTION_SETUP_TABLE_ELEMENT( ISOM_CODEC_TYPE_DTSL_AUDIO, isom_setup_audio_description );
-#if 0
-        ADD_DESCRIPTION_SETUP_TABLE_ELEMENT( ISOM_CODEC_TYPE_DRA1_AUDIO, isom_setup_audio_description );
-        ADD_DESCRIPTION_SETUP_TABLE_ELEMENT( ISOM_CODEC_TYPE_ENCA_AUDIO, isom_setup_audio_description );
-        ADD_DESCRIPTION_SETUP_TABLE_ELEMENT( ISOM_CODEC_TYPE_G719_AUDIO, isom_setup_audio_description );
-        ADD_DESCRIPTION_SETUP_TABLE_ELEMENT( ISOM_CODEC_TYPE_G726_AUDIO, isom_setup_audio_description );
-        ADD_DESCRIPTION_SETUP_TABLE_ELEMENT( ISOM_CODEC_TYPE_M4AE_AUDIO, isom_setup_audio_description );
-        ADD_DESCRIPTION_SETUP_TABLE_ELEMENT( ISOM_CODEC_TYPE_MLPA_AUDIO, isom_setup_audio_description );
-        ADD_DESCRIPTION_SETUP_TABLE_ELEMENT( ISOM_CODEC_TYPE_RAW_AUDIO,  isom_setup_audio_description );
-        ADD_DESCRIPTION_SETUP_TABLE_ELEMENT( ISOM_CODEC_TYPE_SAWP_AUDIO, isom_setup_audio_description );
-        ADD_DESCRIPTION_SETUP_TABLE_ELEMENT( ISOM_CODEC_TYPE_SEVC_AUDIO, isom_setup_audio_description );
-        ADD_DESCRIPTION_SETUP_TABLE_ELEMENT( ISOM_CODEC_TYPE_SQCP_AUDIO, isom_setup_audio_description );
-        ADD_DESCRIPTION_SETUP_TABLE_ELEMENT( ISOM_CODEC_TYPE_SSMV_AUDIO, isom_setup_audio_description );
-        ADD_DESCRIPTION_SETUP_TABLE_ELEMENT( ISOM_CODEC_TYPE_TWOS_AUDIO, isom_setup_audio_description );
-#endif
-        ADD_DESCRIPTION_SETUP_TABLE_ELEMENT( QT_CODEC_TYPE_MP4A_AUDIO,    isom_setup_audio_description );
-        ADD_DESCRIPTION_SETUP_TABLE_ELEMENT( QT_CODEC_TYPE_MAC3_AUDIO,    isom_setup_audio_description );
-        ADD_DESCRIPTION_SETUP_TABLE_ELEMENT( QT_CODEC_TYPE_MAC6_AUDIO,    isom_setup_audio_description );
-        ADD_DESCRIPTION_SETUP_TABLE_ELEMENT( QT_CODEC_TYPE_AGSM_AUDIO,    isom_setup_audio_description );
-        ADD_DESCRIPTION_SETUP_TABLE_ELEMENT( QT_CODEC_TYPE_ALAW_AUDIO,    isom_setup_audio_description );
-        ADD_DESCRIPTION_SETUP_TABLE_ELEMENT( QT_CODEC_TYPE_ULAW_AUDIO,    isom_setup_audio_description );
-        ADD_DESCRIPTION_SETUP_TABLE_ELEMENT( QT_CODEC_TYPE_FULLMP3_AUDIO, isom_setup_audio_description );
-        ADD_DESCRIPTION_SETUP_TABLE_ELEMENT( QT_CODEC_TYPE_ADPCM2_AUDIO,  isom_setup_audio_description );
-        ADD_DESCRIPTION_SETUP_TABLE_ELEMENT( QT_CODEC_TYPE_ADPCM17_AUDIO, isom_setup_audio_description );
-        ADD_DESCRIPTION_SETUP_TABLE_ELEMENT( QT_CODEC_TYPE_GSM49_AUDIO,   isom_setup_audio_description );
-        ADD_DESCRIPTION_SETUP_TABLE_ELEMENT( QT_CODEC_TYPE_NONE_AUDIO,    isom_setup_audio_description );
-        ADD_DESCRIPTION_SETUP_TABLE_ELEMENT( QT_CODEC_TYPE_LPCM_AUDIO,    isom_setup_audio_description );
-        ADD_DESCRIPTION_SETUP_TABLE_ELEMENT( QT_CODEC_TYPE_SOWT_AUDIO,    isom_setup_audio_description );
-        ADD_DESCRIPTION_SETUP_TABLE_ELEMENT( QT_CODEC_TYPE_TWOS_AUDIO,    isom_setup_audio_description );
-        ADD_DESCRIPTION_SETUP_TABLE_ELEMENT( QT_CODEC_TYPE_FL32_AUDIO,    isom_setup_audio_description );
-        ADD_DESCRIPTION_SETUP_TABLE_ELEMENT( QT_CODEC_TYPE_FL64_AUDIO,    isom_setup_audio_description );
-        ADD_DESCRIPTION_SETUP_TABLE_ELEMENT( QT_CODEC_TYPE_IN24_AUDIO,    isom_setup_audio_description );
-        ADD_DESCRIPTION_SETUP_TABLE_ELEMENT( QT_CODEC_TYPE_IN32_AUDIO,    isom_setup_audio_description );
-        ADD_DESCRIPTION_SETUP_TABLE_ELEMENT( QT_CODEC_TYPE_23NI_AUDIO,    isom_setup_audio_description );
-        ADD_DESCRIPTION_SETUP_TABLE_ELEMENT( QT_CODEC_TYPE_NOT_SPECIFIED, isom_setup_audio_description );
-        ADD_DESCRIPTION_SETUP_TABLE_ELEMENT( ISOM_CODEC_TYPE_TX3G_TEXT, isom_add_tx3g_description );
-        ADD_DESCRIPTION_SETUP_TABLE_ELEMENT( QT_CODEC_TYPE_TEXT_TEXT,   isom_add_qt_text_description );
-#if 0
-        ADD_DESCRIPTION_SETUP_TABLE_ELEMENT( ISOM_CODEC_TYPE_MP4S_SYSTEM, isom_add_mp4s_entry );
-#endif
-    }
+    lsmash_call_once( &description_setup_table_once, isom_init_description_setup_table );
     for( int i = 0; description_setup_table[i].func; i++ )
         if( lsmash_check_codec_type_identical( sample_type, description_setup_table[i].type ) )
         {
@@ -1716,7 +1712,11 @@ int lsmash_set_track_parameters( lsmash_root_t *root, uint32_t track_ID, lsmash_
     uint32_t media_type = trak->mdia->hdlr->componentSubtype;
     isom_tkhd_t *tkhd = trak->tkhd;
     tkhd->flags    = param->mode;
-    tkhd->track_ID = param->track_ID ? param->track_ID : tkhd->track_ID;
+    if( param->track_ID && param->track_ID != tkhd->track_ID )
+    {
+        tkhd->track_ID = param->track_ID;
+        isom_invalidate_id_index( &file->moov->trak_index );
+    }
     tkhd->duration = !trak->edts || !trak->edts->elst ? param->duration : tkhd->duration;
     /* Template fields
      *   alternate_group, layer, volume and matrix
@@ -2697,7 +2697,7 @@ int isom_establish_movie( lsmash_file_t *file )
     return 0;
 }
 
-int lsmash_finish_movie
+static int isom_finish_movie
 (
     lsmash_root_t        *root,
     lsmash_adhoc_remux_t *remux
@@ -2808,7 +2808,10 @@ int lsmash_finish_movie
     if( file->free )
         file->free->pos += mtf_size;
     /* Move Media Data Box. */
-    if( (err = isom_rearrange_data( file, remux, buf, read_num, size, read_pos, write_pos, total )) < 0 )
+    isom_trace_begin( root, LSMASH_TRACE_PHASE_REARRANGE );
+    err = isom_rearrange_data( file, remux, buf, read_num, size, read_pos, write_pos, total );
+    isom_trace_end( root, LSMASH_TRACE_PHASE_REARRANGE, total - write_pos, 0 );
+    if( err < 0 )
         goto fail;
     file->size += mtf_size;
     lsmash_free( buf[0] );
@@ -2818,185 +2821,1667 @@ fail:
     return err;
 }
 
-int lsmash_set_last_sample_delta( lsmash_root_t *root, uint32_t track_ID, uint32_t sample_delta )
+int lsmash_finish_movie
+(
+    lsmash_root_t        *root,
+    lsmash_adhoc_remux_t *remux
+)
 {
-    if( isom_check_initializer_present( root ) < 0 || track_ID == 0 )
-        return LSMASH_ERR_FUNCTION_PARAM;
-    lsmash_file_t *file = root->file;
-    if( file->fragment
-     && file->fragment->movie )
-    {
-        isom_traf_t *traf = isom_get_traf( file->fragment->movie, track_ID );
-        if( !traf
-         || !traf->cache
-         || !traf->tfhd )
-            return LSMASH_ERR_NAMELESS;
-        return isom_set_fragment_last_duration( traf, sample_delta );
-    }
-    if( file != file->initializer )
-        return LSMASH_ERR_INVALID_DATA;
-    isom_trak_t *trak = isom_get_trak( file, track_ID );
-    if( !trak
-     || !trak->cache
-     || !trak->mdia
-     || !trak->mdia->mdhd
-     || !trak->mdia->minf
-     || !trak->mdia->minf->stbl
-     || !trak->mdia->minf->stbl->stsd
-     || !trak->mdia->minf->stbl->stsz
-     || !trak->mdia->minf->stbl->stts
-     || !trak->mdia->minf->stbl->stts->list )
-        return LSMASH_ERR_NAMELESS;
-    isom_stbl_t *stbl = trak->mdia->minf->stbl;
-    isom_stts_t *stts = stbl->stts;
-    uint32_t sample_count = isom_get_sample_count( trak );
-    int err;
-    if( !stts->list->tail )
-    {
-        if( !sample_count )
-            return 0;       /* no samples */
-        if( sample_count > 1 )
-            return LSMASH_ERR_INVALID_DATA; /* irregular sample_count */
-        /* Set the duration of the first sample.
-         * This duration is also the duration of the last sample. */
-        if( (err = isom_add_stts_entry( stbl, sample_delta )) < 0 )
-            return err;
-        return lsmash_update_track_duration( root, track_ID, 0 );
-    }
-    uint32_t i = 0;
-    for( lsmash_entry_t *entry = stts->list->head; entry; entry = entry->next )
-        i += ((isom_stts_entry_t *)entry->data)->sample_count;
-    if( sample_count < i )
-        return LSMASH_ERR_INVALID_DATA;
-    int no_last = (sample_count > i);
-    isom_stts_entry_t *last_stts_data = (isom_stts_entry_t *)stts->list->tail->data;
-    if( !last_stts_data )
-        return LSMASH_ERR_INVALID_DATA;
-    /* Consider QuikcTime fixed compression audio. */
-    isom_audio_entry_t *audio = (isom_audio_entry_t *)lsmash_get_entry_data( &trak->mdia->minf->stbl->stsd->list,
-                                                                              trak->cache->chunk.sample_description_index );
-    if( !audio )
-        return LSMASH_ERR_INVALID_DATA;
-    if( (audio->manager & LSMASH_AUDIO_DESCRIPTION)
-     && (audio->manager & LSMASH_QTFF_BASE)
-     && (audio->version == 1)
-     && (audio->compression_ID != QT_AUDIO_COMPRESSION_ID_VARIABLE_COMPRESSION) )
+    isom_trace_begin( root, LSMASH_TRACE_PHASE_FINISH_MOVIE );
+    int err = isom_finish_movie( root, remux );
+    isom_trace_end( root, LSMASH_TRACE_PHASE_FINISH_MOVIE, 0, 0 );
+    return err;
+}
+
+/* Get the size of the space available for the Movie Box placed at 'pos' and sized 'size'.
+ * The Free Space Boxes just after the Movie Box are also available.
+ * If nothing but Free Space Boxes follows, set 1 to 'at_end' since the space can be extended.
+ * If the space is followed by a box extending to the end of the file, set its position and actual size
+ * to 'open_pos' and 'open_size'. Otherwise, set 0 to them. */
+static int isom_get_movie_space
+(
+    lsmash_bs_t *bs,
+    uint64_t     pos,
+    uint64_t     size,
+    uint64_t    *space,
+    int         *at_end,
+    uint64_t    *open_pos,
+    uint64_t    *open_size
+)
+{
+    *space     = size;
+    *at_end    = 0;
+    *open_pos  = 0;
+    *open_size = 0;
+    pos += size;
+    while( 1 )
     {
-        if( audio->samplesPerPacket == 0 )
-            return LSMASH_ERR_INVALID_DATA;
-        int exclude_last_sample = no_last ? 0 : 1;
-        uint32_t j = audio->samplesPerPacket;
-        for( lsmash_entry_t *entry = stts->list->tail; entry && j > 1; entry = entry->prev )
+        int64_t ret = lsmash_bs_read_seek( bs, pos, SEEK_SET );
+        if( ret < 0 )
+            return ret;
+        if( lsmash_bs_is_end( bs, ISOM_BASEBOX_COMMON_SIZE - 1 ) )
         {
-            isom_stts_entry_t *stts_data = (isom_stts_entry_t *)entry->data;
-            if( !stts_data )
-                return LSMASH_ERR_INVALID_DATA;
-            for( uint32_t k = exclude_last_sample; k < stts_data->sample_count && j > 1; k++ )
+            *at_end = lsmash_bs_is_end( bs, 0 );
+            return 0;
+        }
+        uint64_t box_size = lsmash_bs_get_be32( bs );
+        uint32_t fourcc   = lsmash_bs_get_be32( bs );
+        if( box_size == 1 )
+            box_size = lsmash_bs_get_be64( bs );
+        int open = (box_size == 0);
+        if( open )
+        {
+            /* This box extends to the end of the file. */
+            int64_t end = lsmash_bs_read_seek( bs, 0, SEEK_END );
+            if( end < 0 )
+                return end;
+            box_size = end - pos;
+        }
+        if( fourcc != ISOM_BOX_TYPE_FREE.fourcc
+         && fourcc != ISOM_BOX_TYPE_SKIP.fourcc )
+        {
+            if( open )
             {
-                sample_delta -= stts_data->sample_delta;
-                --j;
+                *open_pos  = pos;
+                *open_size = box_size;
             }
-            exclude_last_sample = 0;
+            return 0;
+        }
+        if( open )
+        {
+            *space += box_size;
+            *at_end = 1;
+            return 0;
         }
+        if( box_size < ISOM_BASEBOX_COMMON_SIZE )
+            return 0;
+        *space += box_size;
+        pos    += box_size;
     }
-    /* Set sample_delta. */
-    if( no_last )
+}
+
+/* Place the boxes added after reading the file by their precedences.
+ * The boxes read from the file are kept in the order in the file. */
+static void isom_reorder_added_boxes( isom_box_t *parent )
+{
+    for( lsmash_entry_t *x = parent->extensions.head; x; x = x->next )
     {
-        /* The duration of the last sample is not set yet. */
-        if( sample_count - i > 1 )
-            return LSMASH_ERR_INVALID_DATA;
-        /* Add a sample_delta. */
-        if( sample_delta == last_stts_data->sample_delta )
-            ++ last_stts_data->sample_count;
-        else if( (err = isom_add_stts_entry( stbl, sample_delta )) < 0 )
-            return err;
+        isom_box_t *box = (isom_box_t *)x->data;
+        if( !box )
+            continue;
+        isom_reorder_added_boxes( box );
+        if( box->pos )
+            continue;   /* read from the file */
+        for( lsmash_entry_t *y = x; y->prev && y->prev->data; y = y->prev )
+        {
+            if( ((isom_box_t *)y->prev->data)->precedence >= box->precedence )
+                break;
+            /* Exchange the entity data of adjacent two entries. */
+            y->data       = y->prev->data;
+            y->prev->data = box;
+        }
     }
-    /* The duration of the last sample is already set. Replace it with a new one. */
-    else if( (err = isom_replace_last_sample_delta( stbl, sample_delta )) < 0 )
-        return err;
-    return lsmash_update_track_duration( root, track_ID, sample_delta );
 }
 
-/*---- timeline manipulator ----*/
+static int isom_write_data_at( lsmash_bs_t *bs, int64_t pos, int whence, uint8_t *data, size_t size )
+{
+    int64_t ret = lsmash_bs_write_seek( bs, pos, whence );
+    if( ret < 0 )
+        return ret;
+    return lsmash_bs_write_data( bs, data, size );
+}
 
-int lsmash_modify_explicit_timeline_map( lsmash_root_t *root, uint32_t track_ID, uint32_t edit_number, lsmash_edit_t edit )
+/* Write the header of a Free Space Box placed at 'pos' and sized 'size'. */
+static int isom_write_free_header( lsmash_bs_t *bs, uint64_t pos, uint64_t size )
 {
-    if( isom_check_initializer_present( root ) < 0
-     || edit.start_time < -1 )
-        return LSMASH_ERR_FUNCTION_PARAM;
-    lsmash_file_t *file = root->file->initializer;
-    isom_trak_t   *trak = isom_get_trak( file, track_ID );
-    if( !trak
-     || !trak->edts
-     || !trak->edts->elst
-     || !trak->edts->elst->list )
-        return LSMASH_ERR_NAMELESS;
-    isom_elst_t       *elst = trak->edts->elst;
-    isom_elst_entry_t *data = (isom_elst_entry_t *)lsmash_get_entry_data( elst->list, edit_number );
-    if( !data )
-        return LSMASH_ERR_NAMELESS;
-    data->segment_duration = edit.duration;
-    data->media_time       = edit.start_time;
-    data->media_rate       = edit.rate;
-    if( elst->pos == 0 || !file->fragment || file->bs->unseekable )
-        return isom_update_tkhd_duration( trak );
-    /* Rewrite the specified entry.
-     * Note: we don't update the version of the Edit List Box. */
-    lsmash_bs_t *bs = file->bs;
-    uint64_t current_pos = bs->offset;
-    uint64_t entry_pos = elst->pos + ISOM_LIST_FULLBOX_COMMON_SIZE + ((uint64_t)edit_number - 1) * (elst->version == 1 ? 20 : 12);
-    lsmash_bs_write_seek( bs, entry_pos, SEEK_SET );
-    if( elst->version )
+    uint8_t header[ISOM_BASEBOX_COMMON_SIZE + 8];
+    size_t  header_size = ISOM_BASEBOX_COMMON_SIZE;
+    LSMASH_SET_BE32( &header[4], ISOM_BOX_TYPE_FREE.fourcc );
+    if( size > UINT32_MAX )
     {
-        lsmash_bs_put_be64( bs, data->segment_duration );
-        lsmash_bs_put_be64( bs, data->media_time );
+        LSMASH_SET_BE32( &header[0], 1 );
+        LSMASH_SET_BE64( &header[8], size );
+        header_size += 8;
     }
     else
-    {
-        lsmash_bs_put_be32( bs, (uint32_t)LSMASH_MIN( data->segment_duration, UINT32_MAX ) );
-        lsmash_bs_put_be32( bs, (uint32_t)data->media_time );
-    }
-    lsmash_bs_put_be32( bs, data->media_rate );
-    int ret = lsmash_bs_flush_buffer( bs );
-    lsmash_bs_write_seek( bs, current_pos, SEEK_SET );
-    return ret;
+        LSMASH_SET_BE32( &header[0], size );
+    return isom_write_data_at( bs, pos, SEEK_SET, header, header_size );
 }
 
-int lsmash_create_explicit_timeline_map( lsmash_root_t *root, uint32_t track_ID, lsmash_edit_t edit )
+/* Write the actual size of the box placed at 'pos' and extending to the end of the file
+ * so that nothing appended to the file is taken as a part of the box.
+ * If the size needs the largesize field, the header is moved into the last 8 bytes of the unused space
+ * placed at 'space_pos', and the rest of the space is turned into a Free Space Box. */
+static int isom_close_open_box( lsmash_bs_t *bs, uint64_t space_pos, uint64_t pos, uint64_t size )
 {
-    if( isom_check_initializer_present( root ) < 0 || edit.start_time < -1 )
-        return LSMASH_ERR_FUNCTION_PARAM;
-    isom_trak_t *trak = isom_get_trak( root->file, track_ID );
-    if( !trak
-     || !trak->tkhd )
-        return LSMASH_ERR_NAMELESS;
-    edit.duration = (edit.duration || root->file->fragment) ? edit.duration
-                  : trak->tkhd->duration ? trak->tkhd->duration
-                  : isom_update_tkhd_duration( trak ) < 0 ? 0
-                  : trak->tkhd->duration;
-    if( (!trak->edts       && !isom_add_edts( trak ))
-     || (!trak->edts->elst && !isom_add_elst( trak->edts )) )
+    uint8_t header[ISOM_BASEBOX_COMMON_SIZE + 8];
+    if( size <= UINT32_MAX )
+    {
+        LSMASH_SET_BE32( &header[0], size );
+        return isom_write_data_at( bs, pos, SEEK_SET, header, 4 );
+    }
+    if( pos < space_pos + 2 * ISOM_BASEBOX_COMMON_SIZE )
         return LSMASH_ERR_NAMELESS;
-    int err = isom_add_elst_entry( trak->edts->elst, edit.duration, edit.start_time, edit.rate );
+    int64_t ret = lsmash_bs_read_seek( bs, pos + 4, SEEK_SET );
+    if( ret < 0 )
+        return ret;
+    uint32_t fourcc = lsmash_bs_get_be32( bs );
+    lsmash_bs_empty( bs );
+    int err = isom_write_free_header( bs, space_pos, pos - 8 - space_pos );
     if( err < 0 )
         return err;
-    return isom_update_tkhd_duration( trak );
+    LSMASH_SET_BE32( &header[0], 1 );
+    LSMASH_SET_BE32( &header[4], fourcc );
+    LSMASH_SET_BE64( &header[8], size + 8 );
+    return isom_write_data_at( bs, pos - 8, SEEK_SET, header, ISOM_BASEBOX_COMMON_SIZE + 8 );
 }
 
-int lsmash_get_explicit_timeline_map( lsmash_root_t *root, uint32_t track_ID, uint32_t edit_number, lsmash_edit_t *edit )
+int lsmash_write_movie_in_place
+(
+    lsmash_root_t *root
+)
 {
-    if( isom_check_initializer_present( root ) < 0 || !edit )
+    if( isom_check_initializer_present( root ) < 0 )
         return LSMASH_ERR_FUNCTION_PARAM;
-    isom_elst_entry_t *data;
-    isom_trak_t *trak = isom_get_trak( root->file->initializer, track_ID );
-    if( !trak )
-        data = isom_timelime_get_explicit_timeline_map( root, track_ID, edit_number );
-    else
-    {
-        if( !trak->edts
-         || !trak->edts->elst )
-        {
-            /* no edits */
+    lsmash_file_t *file = root->file;
+    if( !file->bs
+     ||  file->bs->unseekable
+     || !(file->flags & LSMASH_FILE_MODE_READ)
+     || !file->moov
+     || !file->moov->mvhd )
+        return LSMASH_ERR_FUNCTION_PARAM;
+    isom_moov_t *moov = file->moov;
+    if( moov->mvex )
+    {
+        lsmash_log( NULL, LSMASH_LOG_ERROR, "in-place editing of fragmented movies is not supported.\n" );
+        return LSMASH_ERR_PATCH_WELCOME;
+    }
+    /* Bring the sample tables and the durations up to date with the media timelines. */
+    int err;
+    for( lsmash_entry_t *entry = moov->trak_list.head; entry; entry = entry->next )
+    {
+        isom_trak_t *trak = (isom_trak_t *)entry->data;
+        if( !trak
+         || !trak->tkhd )
+            return LSMASH_ERR_INVALID_DATA;
+        isom_timeline_t *timeline = isom_get_timeline( root, trak->tkhd->track_ID );
+        if( timeline )
+        {
+            uint32_t last_sample_delta;
+            if( (err = isom_timeline_rebuild_timing_boxes( timeline, trak, &last_sample_delta )) < 0
+             || (err = isom_update_mdhd_duration( trak, last_sample_delta ))                    < 0
+             || (err = isom_update_tkhd_duration( trak ))                                       < 0 )
+                return err;
+        }
+    }
+    /* Serialize the Movie Box on memory. The media data doesn't move, so the chunk offsets are kept. */
+    uint64_t old_pos  = moov->pos;
+    uint64_t old_size = moov->size;
+    isom_reorder_added_boxes( (isom_box_t *)moov );
+    isom_complement_box_writers( (isom_box_t *)moov );
+    uint64_t new_size = isom_update_box_size( moov );
+    lsmash_bs_t *mem = lsmash_bs_create();
+    if( !mem )
+        return LSMASH_ERR_MEMORY_ALLOC;
+    if( (err = isom_write_box( mem, (isom_box_t *)moov )) < 0 )
+        goto fail;
+    if( mem->error || lsmash_bs_get_valid_data_size( mem ) != new_size )
+    {
+        err = LSMASH_ERR_NAMELESS;
+        goto fail;
+    }
+    /* Overwrite the Movie Box if the new one fits in the space the old one and the following free spaces take.
+     * The rest of the space is turned into a Free Space Box. Otherwise, append the new one to the end of the file
+     * and turn the old one into a Free Space Box. */
+    lsmash_bs_t *bs = file->bs;
+    uint64_t space;
+    int      at_end;
+    uint64_t open_pos;
+    uint64_t open_size;
+    if( (err = isom_get_movie_space( bs, old_pos, old_size, &space, &at_end, &open_pos, &open_size )) < 0 )
+        goto fail;
+    uint64_t rest = space > new_size ? space - new_size : 0;
+    if( at_end && rest && rest < ISOM_BASEBOX_COMMON_SIZE )
+        rest = ISOM_BASEBOX_COMMON_SIZE;    /* Nothing follows the space, so the file can be extended. */
+    lsmash_bs_empty( bs );
+    if( (space >= new_size || at_end)
+     && (rest == 0 || rest >= ISOM_BASEBOX_COMMON_SIZE) )
+    {
+        if( (err = isom_write_data_at( bs, old_pos, SEEK_SET, lsmash_bs_get_buffer_data_start( mem ), new_size )) < 0 )
+            goto fail;
+        if( rest && (err = isom_write_free_header( bs, old_pos + new_size, rest )) < 0 )
+            goto fail;
+    }
+    else
+    {
+        /* A box extending to the end of the file, typically the last Media Data Box, would take in the new one. */
+        if( open_size && (err = isom_close_open_box( bs, old_pos, open_pos, open_size )) < 0 )
+            goto fail;
+        uint8_t type[4];
+        LSMASH_SET_BE32( type, ISOM_BOX_TYPE_FREE.fourcc );
+        if( (err = isom_write_data_at( bs, 0, SEEK_END, lsmash_bs_get_buffer_data_start( mem ), new_size )) < 0
+         || (err = isom_write_data_at( bs, old_pos + 4, SEEK_SET, type, 4 )) < 0 )
+            goto fail;
+    }
+    lsmash_bs_cleanup( mem );
+    return 0;
+fail:
+    lsmash_bs_cleanup( mem );
+    return err;
+}
+
+int lsmash_reserve_movie_padding( lsmash_root_t *root, uint32_t size )
+{
+    if( isom_check_initializer_present( root ) < 0
+     || size < ISOM_BASEBOX_COMMON_SIZE )
+        return LSMASH_ERR_FUNCTION_PARAM;
+    lsmash_file_t *file = root->file;
+    if( !file->moov
+     || !(file->flags & LSMASH_FILE_MODE_WRITE) )
+        return LSMASH_ERR_FUNCTION_PARAM;
+    uint32_t data_size = size - ISOM_BASEBOX_COMMON_SIZE;
+    uint8_t *data      = NULL;
+    if( data_size )
+    {
+        data = lsmash_malloc_zero( data_size );
+        if( !data )
+            return LSMASH_ERR_MEMORY_ALLOC;
+    }
+    lsmash_box_t *free_box = lsmash_create_box( ISOM_BOX_TYPE_FREE, data, data_size, LSMASH_BOX_PRECEDENCE_L );
+    lsmash_free( data );
+    if( !free_box )
+        return LSMASH_ERR_MEMORY_ALLOC;
+    int err = lsmash_add_box( (lsmash_box_t *)file->moov, free_box );
+    if( err < 0 )
+        lsmash_destroy_box( free_box );
+    return err;
+}
+
+/* a chunk of a virtual clip */
+typedef struct
+{
+    uint64_t pos;           /* the position of the chunk in the source file */
+    uint64_t length;
+    uint64_t offset;        /* the offset of the chunk from the first byte of the media data of the clip */
+    uint32_t sample_count;
+    uint32_t index;         /* sample_description_index */
+    isom_trun_t *trun;      /* the Track Run Box of the samples in a media segment */
+} isom_clip_chunk_t;
+
+/* The tables of a track of a virtual clip.
+ * They are exchanged with the ones of the source track while serializing the Movie Box of the clip. */
+typedef struct
+{
+    isom_trak_t          *trak;
+    uint32_t              first_chunk;      /* the index of the first chunk of this track in the chunks of the clip */
+    uint32_t              chunk_count;
+    int                   added_edts;       /* whether the Edit Box is added only for the clip */
+    uint64_t              track_duration;
+    uint64_t              media_duration;
+    uint32_t              sample_size;
+    uint32_t              sample_count;
+    uint8_t               large_presentation;
+    lsmash_box_type_t     stco_type;
+    int32_t               least_offset;
+    int32_t               greatest_offset;
+    int32_t               composition_start_time;
+    int32_t               composition_end_time;
+    lsmash_entry_list_t  *elst;
+    lsmash_entry_list_t  *stts;
+    lsmash_entry_list_t  *ctts;
+    lsmash_entry_list_t  *stss;
+    lsmash_entry_list_t  *stps;
+    lsmash_entry_list_t  *sdtp;
+    lsmash_entry_list_t  *stsc;
+    lsmash_entry_list_t  *stsz;
+    lsmash_entry_list_t  *stco;
+    lsmash_entry_list_t **sbgp;             /* in the order of the Sample To Group Boxes of the source track */
+    uint32_t              sbgp_count;
+} isom_clip_track_t;
+
+typedef struct
+{
+    isom_moov_t       *moov;
+    uint64_t           movie_duration;
+    isom_clip_track_t *track;
+    uint32_t           track_count;
+    isom_clip_chunk_t *chunk;
+    uint32_t           chunk_count;
+    uint32_t           chunk_alloc;
+} isom_clip_t;
+
+static void isom_clip_cleanup( isom_clip_t *clip )
+{
+    for( uint32_t i = 0; i < clip->track_count; i++ )
+    {
+        isom_clip_track_t *track = &clip->track[i];
+        if( track->added_edts )
+            isom_remove_box_by_itself( track->trak->edts );
+        lsmash_remove_list( track->elst, NULL );
+        lsmash_remove_list( track->stts, NULL );
+        lsmash_remove_list( track->ctts, NULL );
+        lsmash_remove_list( track->stss, NULL );
+        lsmash_remove_list( track->stps, NULL );
+        lsmash_remove_list( track->sdtp, NULL );
+        lsmash_remove_list( track->stsc, NULL );
+        lsmash_remove_list( track->stsz, NULL );
+        lsmash_remove_list( track->stco, NULL );
+        for( uint32_t j = 0; j < track->sbgp_count; j++ )
+            lsmash_remove_list( track->sbgp[j], NULL );
+        lsmash_free( track->sbgp );
+    }
+    lsmash_free( clip->track );
+    lsmash_free( clip->chunk );
+}
+
+#define ISOM_CLIP_SWAP( type, a, b ) \
+    do                               \
+    {                                \
+        type temp = (a);             \
+        (a) = (b);                   \
+        (b) = temp;                  \
+    } while( 0 )
+
+/* Exchange the tables of the clip with the ones of the source movie.
+ * Calling this function again restores the source movie. */
+static void isom_clip_swap_tables( isom_clip_t *clip )
+{
+    ISOM_CLIP_SWAP( uint64_t, clip->moov->mvhd->duration, clip->movie_duration );
+    for( uint32_t i = 0; i < clip->track_count; i++ )
+    {
+        isom_clip_track_t *track = &clip->track[i];
+        isom_trak_t       *trak  = track->trak;
+        isom_stbl_t       *stbl  = trak->mdia->minf->stbl;
+        ISOM_CLIP_SWAP( uint64_t, trak->tkhd->duration,       track->track_duration );
+        ISOM_CLIP_SWAP( uint64_t, trak->mdia->mdhd->duration, track->media_duration );
+        if( track->elst )
+            ISOM_CLIP_SWAP( lsmash_entry_list_t *, trak->edts->elst->list, track->elst );
+        ISOM_CLIP_SWAP( lsmash_entry_list_t *, stbl->stts->list, track->stts );
+        if( track->ctts )
+            ISOM_CLIP_SWAP( lsmash_entry_list_t *, stbl->ctts->list, track->ctts );
+        if( stbl->cslg )
+        {
+            ISOM_CLIP_SWAP( int32_t, stbl->cslg->leastDecodeToDisplayDelta,    track->least_offset );
+            ISOM_CLIP_SWAP( int32_t, stbl->cslg->greatestDecodeToDisplayDelta, track->greatest_offset );
+            ISOM_CLIP_SWAP( int32_t, stbl->cslg->compositionStartTime,         track->composition_start_time );
+            ISOM_CLIP_SWAP( int32_t, stbl->cslg->compositionEndTime,           track->composition_end_time );
+        }
+        if( track->stss )
+            ISOM_CLIP_SWAP( lsmash_entry_list_t *, stbl->stss->list, track->stss );
+        if( track->stps )
+            ISOM_CLIP_SWAP( lsmash_entry_list_t *, stbl->stps->list, track->stps );
+        if( track->sdtp )
+            ISOM_CLIP_SWAP( lsmash_entry_list_t *, stbl->sdtp->list, track->sdtp );
+        ISOM_CLIP_SWAP( lsmash_entry_list_t *, stbl->stsc->list, track->stsc );
+        ISOM_CLIP_SWAP( uint32_t,              stbl->stsz->sample_size,  track->sample_size );
+        ISOM_CLIP_SWAP( uint32_t,              stbl->stsz->sample_count, track->sample_count );
+        ISOM_CLIP_SWAP( lsmash_entry_list_t *, stbl->stsz->list,         track->stsz );
+        ISOM_CLIP_SWAP( lsmash_entry_list_t *, stbl->stco->list,               track->stco );
+        ISOM_CLIP_SWAP( uint8_t,               stbl->stco->large_presentation, track->large_presentation );
+        ISOM_CLIP_SWAP( lsmash_box_type_t,     stbl->stco->type,               track->stco_type );
+        uint32_t j = 0;
+        for( lsmash_entry_t *entry = stbl->sbgp_list.head; entry && j < track->sbgp_count; entry = entry->next )
+        {
+            isom_sbgp_t *sbgp = (isom_sbgp_t *)entry->data;
+            ISOM_CLIP_SWAP( lsmash_entry_list_t *, sbgp->list, track->sbgp[j] );
+            ++j;
+        }
+    }
+}
+
+static int isom_clip_add_entry( lsmash_entry_list_t *list, const void *data, size_t size )
+{
+    void *entry_data = lsmash_memdup( data, size );
+    if( !entry_data )
+        return LSMASH_ERR_MEMORY_ALLOC;
+    if( lsmash_add_entry( list, entry_data ) < 0 )
+    {
+        lsmash_free( entry_data );
+        return LSMASH_ERR_MEMORY_ALLOC;
+    }
+    return 0;
+}
+
+/* Add samples to a run length coded table such as the Decoding Time to Sample Box,
+ * the Composition Time to Sample Box and the Sample To Group Box.
+ * Their entries consist of the number of samples followed by the value applied to them. */
+static int isom_clip_add_run( lsmash_entry_list_t *list, uint32_t sample_count, uint32_t value )
+{
+    isom_stts_entry_t *run = list->tail ? (isom_stts_entry_t *)list->tail->data : NULL;
+    if( run && run->sample_delta == value )
+    {
+        run->sample_count += sample_count;
+        return 0;
+    }
+    isom_stts_entry_t data = { sample_count, value };
+    return isom_clip_add_entry( list, &data, sizeof(isom_stts_entry_t) );
+}
+
+/* Trim a table of sample numbers such as the Sync Sample Box to the samples of the clip. */
+static int isom_clip_trim_sample_numbers( lsmash_entry_list_t *dst, lsmash_entry_list_t *src,
+                                          uint32_t first_sample_number, uint32_t last_sample_number )
+{
+    for( lsmash_entry_t *entry = src->head; entry; entry = entry->next )
+    {
+        isom_stss_entry_t *data = (isom_stss_entry_t *)entry->data;
+        if( !data )
+            return LSMASH_ERR_INVALID_DATA;
+        if( data->sample_number < first_sample_number )
+            continue;
+        if( data->sample_number > last_sample_number )
+            break;
+        isom_stss_entry_t trimmed = { data->sample_number - first_sample_number + 1 };
+        int err = isom_clip_add_entry( dst, &trimmed, sizeof(isom_stss_entry_t) );
+        if( err < 0 )
+            return err;
+    }
+    return 0;
+}
+
+static int isom_clip_add_chunk( isom_clip_t *clip, uint64_t pos, uint32_t index )
+{
+    if( clip->chunk_count == clip->chunk_alloc )
+    {
+        uint32_t alloc = clip->chunk_alloc ? clip->chunk_alloc * 2 : 256;
+        isom_clip_chunk_t *chunk = lsmash_realloc( clip->chunk, alloc * sizeof(isom_clip_chunk_t) );
+        if( !chunk )
+            return LSMASH_ERR_MEMORY_ALLOC;
+        clip->chunk       = chunk;
+        clip->chunk_alloc = alloc;
+    }
+    clip->chunk[ clip->chunk_count ++ ] = (isom_clip_chunk_t){ pos, 0, 0, 0, index, NULL };
+    return 0;
+}
+
+/* Convert a time on the presentation timeline of a track into the composition time on its media timeline
+ * by following the empty edits and the first edit of the explicit timeline map. */
+static uint64_t isom_clip_get_media_time( lsmash_root_t *root, uint32_t track_ID,
+                                          uint32_t movie_timescale, uint32_t media_timescale, uint64_t time )
+{
+    double   media_time = (double)time * media_timescale / movie_timescale;
+    uint32_t edit_count = lsmash_count_explicit_timeline_map( root, track_ID );
+    for( uint32_t i = 1; i <= edit_count; i++ )
+    {
+        lsmash_edit_t edit;
+        if( lsmash_get_explicit_timeline_map( root, track_ID, i, &edit ) < 0 )
+            break;
+        if( edit.start_time == ISOM_EDIT_MODE_EMPTY )
+            media_time -= (double)edit.duration * media_timescale / movie_timescale;
+        else
+        {
+            media_time += edit.start_time;
+            break;
+        }
+    }
+    return media_time > 0 ? (uint64_t)(media_time + 0.5) : 0;
+}
+
+/* Check if the samples of a track can be served from the source file as they are. */
+static int isom_clip_check_track( lsmash_root_t *root, isom_trak_t *trak )
+{
+    if( !trak->tkhd
+     || !trak->mdia
+     || !trak->mdia->mdhd
+     || !trak->mdia->mdhd->timescale
+     || !trak->mdia->minf
+     || !trak->mdia->minf->stbl )
+        return LSMASH_ERR_INVALID_DATA;
+    isom_stbl_t *stbl = trak->mdia->minf->stbl;
+    if( !stbl->stts || !stbl->stts->list
+     || !stbl->stsc || !stbl->stsc->list
+     || !stbl->stsz
+     || !stbl->stco || !stbl->stco->list
+     || (stbl->ctts && !stbl->ctts->list)
+     || (stbl->stss && !stbl->stss->list)
+     || (stbl->stps && !stbl->stps->list)
+     || (stbl->sdtp && !stbl->sdtp->list)
+     || (trak->edts && trak->edts->elst && !trak->edts->elst->list) )
+        return LSMASH_ERR_INVALID_DATA;
+    uint32_t track_ID = trak->tkhd->track_ID;
+    if( trak->mdia->minf->dinf && trak->mdia->minf->dinf->dref )
+        for( lsmash_entry_t *entry = trak->mdia->minf->dinf->dref->list.head; entry; entry = entry->next )
+        {
+            isom_dref_entry_t *data = (isom_dref_entry_t *)entry->data;
+            if( data && !(data->flags & 0x000001) )
+            {
+                lsmash_log( NULL, LSMASH_LOG_ERROR, "the samples of track %"PRIu32" in other files cannot be clipped.\n", track_ID );
+                return LSMASH_ERR_PATCH_WELCOME;
+            }
+        }
+    if( !isom_get_timeline( root, track_ID ) )
+    {
+        lsmash_log( NULL, LSMASH_LOG_ERROR, "the timeline of track %"PRIu32" is not constructed.\n", track_ID );
+        return LSMASH_ERR_FUNCTION_PARAM;
+    }
+    return 0;
+}
+
+/* Prepare the empty tables of a track of the clip. The optional ones are prepared only if the source has them. */
+static int isom_clip_prepare_track( lsmash_root_t *root, isom_clip_t *clip, isom_clip_track_t *track )
+{
+    isom_trak_t *trak = track->trak;
+    int err = isom_clip_check_track( root, trak );
+    if( err < 0 )
+        return err;
+    isom_stbl_t *stbl = trak->mdia->minf->stbl;
+    if( !(track->stts = lsmash_create_entry_list())
+     || !(track->stsc = lsmash_create_entry_list())
+     || !(track->stsz = lsmash_create_entry_list())
+     || !(track->stco = lsmash_create_entry_list())
+     || (stbl->ctts && !(track->ctts = lsmash_create_entry_list()))
+     || (stbl->stss && !(track->stss = lsmash_create_entry_list()))
+     || (stbl->stps && !(track->stps = lsmash_create_entry_list()))
+     || (stbl->sdtp && !(track->sdtp = lsmash_create_entry_list()))
+     || (trak->edts && trak->edts->elst && !(track->elst = lsmash_create_entry_list())) )
+        return LSMASH_ERR_MEMORY_ALLOC;
+    if( stbl->sbgp_list.entry_count )
+    {
+        track->sbgp = lsmash_malloc_zero( stbl->sbgp_list.entry_count * sizeof(lsmash_entry_list_t *) );
+        if( !track->sbgp )
+            return LSMASH_ERR_MEMORY_ALLOC;
+        for( lsmash_entry_t *entry = stbl->sbgp_list.head; entry; entry = entry->next )
+        {
+            isom_sbgp_t *sbgp = (isom_sbgp_t *)entry->data;
+            if( !sbgp || !sbgp->list )
+                return LSMASH_ERR_INVALID_DATA;
+            if( !(track->sbgp[ track->sbgp_count ++ ] = lsmash_create_entry_list()) )
+                return LSMASH_ERR_MEMORY_ALLOC;
+        }
+    }
+    track->sample_size            = stbl->stsz->sample_size;
+    track->stco_type              = stbl->stco->type;
+    track->large_presentation     = stbl->stco->large_presentation;
+    track->first_chunk            = clip->chunk_count;
+    if( stbl->cslg )
+    {
+        track->least_offset           = stbl->cslg->leastDecodeToDisplayDelta;
+        track->greatest_offset        = stbl->cslg->greatestDecodeToDisplayDelta;
+        track->composition_start_time = stbl->cslg->compositionStartTime;
+        track->composition_end_time   = stbl->cslg->compositionEndTime;
+    }
+    return 0;
+}
+
+static int isom_clip_setup_track( lsmash_root_t *root, isom_clip_t *clip, isom_clip_track_t *track,
+                                  uint64_t start_time, uint64_t end_time )
+{
+    int err = isom_clip_prepare_track( root, clip, track );
+    if( err < 0 )
+        return err;
+    isom_trak_t *trak     = track->trak;
+    isom_stbl_t *stbl     = trak->mdia->minf->stbl;
+    uint32_t     track_ID = trak->tkhd->track_ID;
+    /* Get the samples to be clipped. */
+    isom_elst_entry_t edit = { 0, ISOM_EDIT_MODE_EMPTY, ISOM_EDIT_MODE_NORMAL };
+    uint32_t movie_timescale    = clip->moov->mvhd->timescale;
+    uint32_t media_timescale    = trak->mdia->mdhd->timescale;
+    uint64_t media_start_time   = isom_clip_get_media_time( root, track_ID, movie_timescale, media_timescale, start_time );
+    uint64_t media_end_time     = end_time ? isom_clip_get_media_time( root, track_ID, movie_timescale, media_timescale, end_time ) : INT64_MAX;
+    uint32_t first_sample_number;
+    uint32_t last_sample_number;
+    if( media_start_time >= media_end_time
+     || lsmash_get_sample_range_from_media_timeline( root, track_ID, media_start_time, media_end_time,
+                                                     &first_sample_number, &last_sample_number ) < 0 )
+    {
+        /* No sample of this track is presented in the clip. */
+        if( track->elst )
+            return isom_clip_add_entry( track->elst, &edit, sizeof(isom_elst_entry_t) );
+        return 0;
+    }
+    uint32_t ctd_shift;
+    if( (err = lsmash_get_composition_to_decode_shift_from_media_timeline( root, track_ID, &ctd_shift )) < 0 )
+        return err;
+    uint64_t first_dts   = 0;
+    int64_t  min_cts     = INT64_MAX;
+    int64_t  max_cts_end = INT64_MIN;
+    int64_t  min_offset  = INT64_MAX;
+    int64_t  max_offset  = INT64_MIN;
+    isom_clip_chunk_t *chunk = NULL;
+    for( uint32_t sample_number = first_sample_number; sample_number <= last_sample_number; sample_number++ )
+    {
+        lsmash_sample_t info;
+        uint32_t        sample_delta;
+        if( (err = lsmash_get_sample_info_from_media_timeline( root, track_ID, sample_number, &info ))          < 0
+         || (err = lsmash_get_sample_delta_from_media_timeline( root, track_ID, sample_number, &sample_delta )) < 0 )
+            return err;
+        if( sample_number == first_sample_number )
+            first_dts = info.dts;
+        /* The timestamps of the clip start from the decoding time of the first sample. */
+        int64_t cts    = (int64_t)(info.cts - first_dts);
+        int64_t offset = (int64_t)(info.cts - info.dts);
+        min_cts     = LSMASH_MIN( min_cts,     cts );
+        max_cts_end = LSMASH_MAX( max_cts_end, cts + sample_delta );
+        min_offset  = LSMASH_MIN( min_offset,  offset );
+        max_offset  = LSMASH_MAX( max_offset,  offset );
+        if( (err = isom_clip_add_run( track->stts, 1, sample_delta )) < 0
+         || (track->ctts && (err = isom_clip_add_run( track->ctts, 1, (uint32_t)offset )) < 0) )
+            return err;
+        if( track->sample_size == 0 )
+        {
+            isom_stsz_entry_t data = { info.length };
+            if( (err = isom_clip_add_entry( track->stsz, &data, sizeof(isom_stsz_entry_t) )) < 0 )
+                return err;
+        }
+        /* Samples stored contiguously with the same description are put into a chunk. */
+        if( !chunk
+         || chunk->index != info.index
+         || chunk->pos + chunk->length != info.pos )
+        {
+            if( (err = isom_clip_add_chunk( clip, info.pos, info.index )) < 0 )
+                return err;
+            chunk = &clip->chunk[ clip->chunk_count - 1 ];
+            ++ track->chunk_count;
+        }
+        chunk->length += info.length;
+        ++ chunk->sample_count;
+        track->media_duration += sample_delta;
+    }
+    track->sample_count = last_sample_number - first_sample_number + 1;
+    for( uint32_t i = 0; i < track->chunk_count; i++ )
+    {
+        chunk = &clip->chunk[ track->first_chunk + i ];
+        isom_stsc_entry_t *run = track->stsc->tail ? (isom_stsc_entry_t *)track->stsc->tail->data : NULL;
+        if( run
+         && run->samples_per_chunk        == chunk->sample_count
+         && run->sample_description_index == chunk->index )
+            continue;
+        isom_stsc_entry_t data = { i + 1, chunk->sample_count, chunk->index };
+        if( (err = isom_clip_add_entry( track->stsc, &data, sizeof(isom_stsc_entry_t) )) < 0 )
+            return err;
+    }
+    /* Trim the tables indexed by sample number. */
+    if( (track->stss && (err = isom_clip_trim_sample_numbers( track->stss, stbl->stss->list, first_sample_number, last_sample_number )) < 0)
+     || (track->stps && (err = isom_clip_trim_sample_numbers( track->stps, stbl->stps->list, first_sample_number, last_sample_number )) < 0) )
+        return err;
+    if( track->sdtp )
+    {
+        uint32_t sample_number = 1;
+        for( lsmash_entry_t *entry = stbl->sdtp->list->head; entry && sample_number <= last_sample_number; entry = entry->next )
+        {
+            if( !entry->data )
+                return LSMASH_ERR_INVALID_DATA;
+            if( sample_number++ >= first_sample_number
+             && (err = isom_clip_add_entry( track->sdtp, entry->data, sizeof(isom_sdtp_entry_t) )) < 0 )
+                return err;
+        }
+    }
+    uint32_t j = 0;
+    for( lsmash_entry_t *entry = stbl->sbgp_list.head; entry; entry = entry->next )
+    {
+        isom_sbgp_t *sbgp = (isom_sbgp_t *)entry->data;
+        uint32_t sample_number = 1;
+        for( lsmash_entry_t *group_entry = sbgp->list->head; group_entry && sample_number <= last_sample_number; group_entry = group_entry->next )
+        {
+            isom_group_assignment_entry_t *data = (isom_group_assignment_entry_t *)group_entry->data;
+            if( !data )
+                return LSMASH_ERR_INVALID_DATA;
+            /* Count the samples of this run in the clip. */
+            uint64_t run_end = (uint64_t)sample_number + data->sample_count;
+            uint64_t first   = LSMASH_MAX( sample_number, first_sample_number );
+            uint64_t end     = LSMASH_MIN( run_end, (uint64_t)last_sample_number + 1 );
+            if( first < end
+             && (err = isom_clip_add_run( track->sbgp[j], (uint32_t)(end - first), data->group_description_index )) < 0 )
+                return err;
+            sample_number = (uint32_t)LSMASH_MIN( run_end, UINT32_MAX );
+        }
+        ++j;
+    }
+    if( stbl->cslg )
+    {
+        track->least_offset           = (int32_t)min_offset;
+        track->greatest_offset        = (int32_t)max_offset;
+        track->composition_start_time = (int32_t)min_cts;
+        track->composition_end_time   = (int32_t)max_cts_end;
+    }
+    /* Trim the presentation precisely by a single edit. */
+    uint64_t composition_delay = min_cts + ctd_shift;
+    uint64_t clip_start_time   = media_start_time + ctd_shift >= first_dts
+                               ? media_start_time + ctd_shift - first_dts
+                               : composition_delay;
+    uint64_t media_end         = max_cts_end + ctd_shift;
+    uint64_t duration          = media_end > clip_start_time ? media_end - clip_start_time : 0;
+    if( end_time && duration > media_end_time - media_start_time )
+        duration = media_end_time - media_start_time;
+    edit.segment_duration = ((double)duration * movie_timescale / media_timescale) + 0.5;
+    edit.media_time       = clip_start_time;
+    track->track_duration = edit.segment_duration;
+    if( !track->elst )
+    {
+        /* Add an Edit Box only for the clip unless the presentation starts with the first sample. */
+        if( clip_start_time == 0 && end_time == 0 )
+            return 0;
+        if( !isom_add_edts( trak ) )
+            return LSMASH_ERR_NAMELESS;
+        track->added_edts = 1;
+        if( !isom_add_elst( trak->edts )
+         || !(track->elst = lsmash_create_entry_list()) )
+            return LSMASH_ERR_NAMELESS;
+    }
+    return isom_clip_add_entry( track->elst, &edit, sizeof(isom_elst_entry_t) );
+}
+
+static int isom_clip_compare_chunk_positions( const void *a, const void *b )
+{
+    const isom_clip_chunk_t *x = *(isom_clip_chunk_t * const *)a;
+    const isom_clip_chunk_t *y = *(isom_clip_chunk_t * const *)b;
+    return x->pos > y->pos ? 1 : x->pos < y->pos ? -1 : 0;
+}
+
+/* Lay out the chunks in the order of the positions in the source file so that the source is read forward.
+ * The chunks contiguous in the source file are merged into a range. */
+static int isom_clip_layout_chunks( isom_clip_t *clip, lsmash_virtual_clip_t *vclip, uint64_t *data_size )
+{
+    *data_size = 0;
+    if( clip->chunk_count == 0 )
+        return 0;
+    isom_clip_chunk_t **order = lsmash_malloc( clip->chunk_count * sizeof(isom_clip_chunk_t *) );
+    vclip->range = lsmash_malloc( clip->chunk_count * sizeof(lsmash_data_range_t) );
+    if( !order || !vclip->range )
+    {
+        lsmash_free( order );
+        return LSMASH_ERR_MEMORY_ALLOC;
+    }
+    for( uint32_t i = 0; i < clip->chunk_count; i++ )
+        order[i] = &clip->chunk[i];
+    qsort( order, clip->chunk_count, sizeof(isom_clip_chunk_t *), isom_clip_compare_chunk_positions );
+    uint64_t size = 0;
+    for( uint32_t i = 0; i < clip->chunk_count; i++ )
+    {
+        isom_clip_chunk_t *chunk = order[i];
+        chunk->offset = size;
+        size += chunk->length;
+        if( chunk->length == 0 )
+            continue;
+        lsmash_data_range_t *range = vclip->num_ranges ? &vclip->range[ vclip->num_ranges - 1 ] : NULL;
+        if( range && range->offset + range->length == chunk->pos )
+            range->length += chunk->length;
+        else
+            vclip->range[ vclip->num_ranges ++ ] = (lsmash_data_range_t){ chunk->pos, chunk->length };
+    }
+    lsmash_free( order );
+    *data_size = size;
+    return 0;
+}
+
+static int isom_clip_set_chunk_offsets( isom_clip_t *clip, uint64_t base_offset, int large_presentation )
+{
+    for( uint32_t i = 0; i < clip->track_count; i++ )
+    {
+        isom_clip_track_t *track = &clip->track[i];
+        lsmash_remove_entries( track->stco, NULL );
+        track->large_presentation = large_presentation;
+        track->stco_type          = large_presentation ? ISOM_BOX_TYPE_CO64 : ISOM_BOX_TYPE_STCO;
+        for( uint32_t j = 0; j < track->chunk_count; j++ )
+        {
+            uint64_t chunk_offset = base_offset + clip->chunk[ track->first_chunk + j ].offset;
+            int err;
+            if( large_presentation )
+            {
+                isom_co64_entry_t data = { chunk_offset };
+                err = isom_clip_add_entry( track->stco, &data, sizeof(isom_co64_entry_t) );
+            }
+            else
+            {
+                isom_stco_entry_t data = { (uint32_t)chunk_offset };
+                err = isom_clip_add_entry( track->stco, &data, sizeof(isom_stco_entry_t) );
+            }
+            if( err < 0 )
+                return err;
+        }
+    }
+    return 0;
+}
+
+/* the bitrate description in a sample description of the source, which is overwritten for the clip */
+typedef struct
+{
+    isom_box_t *box;        /* Bit Rate Box, ES Descriptor Box or a binary coded box */
+    uint32_t    value[3];   /* bufferSizeDB, maxBitrate and avgBitrate if the box is not binary coded */
+    uint8_t    *binary;
+} isom_clip_bitrate_t;
+
+/* Save the boxes in 'extensions' where isom_update_bitrate_description() may write. */
+static int isom_clip_save_bitrates( lsmash_entry_list_t *saved, lsmash_entry_list_t *extensions )
+{
+    for( lsmash_entry_t *entry = extensions->head; entry; entry = entry->next )
+    {
+        isom_box_t *ext = (isom_box_t *)entry->data;
+        if( !ext )
+            continue;
+        if( !(ext->manager & LSMASH_BINARY_CODED_BOX) && lsmash_check_box_type_identical( ext->type, QT_BOX_TYPE_WAVE ) )
+        {
+            int err = isom_clip_save_bitrates( saved, &ext->extensions );
+            if( err < 0 )
+                return err;
+            continue;
+        }
+        isom_clip_bitrate_t bitrate = { ext, { 0 }, NULL };
+        if( ext->manager & LSMASH_BINARY_CODED_BOX )
+        {
+            if( !ext->binary || !(bitrate.binary = lsmash_memdup( ext->binary, ext->size )) )
+                continue;
+        }
+        else if( lsmash_check_box_type_identical( ext->type, ISOM_BOX_TYPE_BTRT ) )
+        {
+            isom_btrt_t *btrt = (isom_btrt_t *)ext;
+            bitrate.value[0] = btrt->bufferSizeDB;
+            bitrate.value[1] = btrt->maxBitrate;
+            bitrate.value[2] = btrt->avgBitrate;
+        }
+        else if( !lsmash_check_box_type_identical( ext->type, ISOM_BOX_TYPE_ESDS )
+              || mp4sys_fetch_DecoderConfigDescriptor( ((isom_esds_t *)ext)->ES, &bitrate.value[0], &bitrate.value[1], &bitrate.value[2] ) < 0 )
+            continue;
+        isom_clip_bitrate_t *data = lsmash_memdup( &bitrate, sizeof(isom_clip_bitrate_t) );
+        if( !data || lsmash_add_entry( saved, data ) < 0 )
+        {
+            lsmash_free( bitrate.binary );
+            lsmash_free( data );
+            return LSMASH_ERR_MEMORY_ALLOC;
+        }
+    }
+    return 0;
+}
+
+static void isom_clip_restore_bitrate( void *data )
+{
+    isom_clip_bitrate_t *bitrate = (isom_clip_bitrate_t *)data;
+    if( !bitrate )
+        return;
+    isom_box_t *box = bitrate->box;
+    if( bitrate->binary )
+        memcpy( box->binary, bitrate->binary, box->size );
+    else if( lsmash_check_box_type_identical( box->type, ISOM_BOX_TYPE_BTRT ) )
+    {
+        isom_btrt_t *btrt = (isom_btrt_t *)box;
+        btrt->bufferSizeDB = bitrate->value[0];
+        btrt->maxBitrate   = bitrate->value[1];
+        btrt->avgBitrate   = bitrate->value[2];
+    }
+    else
+        mp4sys_update_DecoderConfigDescriptor( ((isom_esds_t *)box)->ES, bitrate->value[0], bitrate->value[1], bitrate->value[2] );
+    lsmash_free( bitrate->binary );
+    lsmash_free( bitrate );
+}
+
+/* Calculate the bitrate descriptions from the samples of the clip as lsmash_finish_movie() does.
+ * The ones of the source are saved into 'saved' so that they can be restored.
+ * The tables of the clip have to be exchanged with the ones of the source in advance. */
+static int isom_clip_update_bitrates( isom_clip_t *clip, lsmash_entry_list_t *saved )
+{
+    for( uint32_t i = 0; i < clip->track_count; i++ )
+    {
+        isom_mdia_t *mdia = clip->track[i].trak->mdia;
+        isom_stbl_t *stbl = mdia->minf->stbl;
+        if( mdia->mdhd->duration == 0 || !stbl->stsd )
+            continue;
+        for( lsmash_entry_t *entry = stbl->stsd->list.head; entry; entry = entry->next )
+        {
+            isom_box_t *sample_entry = (isom_box_t *)entry->data;
+            int err;
+            if( sample_entry && (err = isom_clip_save_bitrates( saved, &sample_entry->extensions )) < 0 )
+                return err;
+        }
+        /* The descriptions of the source are kept if they cannot be updated. */
+        isom_update_bitrate_description( mdia );
+    }
+    return 0;
+}
+
+/* Serialize the File Type Box and the Movie Box with the tables of the clip, and get the size of them.
+ * If bs is NULL, only the size is gotten. */
+static int isom_clip_write_movie( lsmash_file_t *file, isom_clip_t *clip, lsmash_bs_t *bs, uint64_t *size )
+{
+    isom_moov_t *moov          = clip->moov;
+    uint64_t     old_moov_size = moov->size;
+    uint64_t     old_ftyp_size = file->ftyp ? file->ftyp->size : 0;
+    lsmash_entry_list_t saved;
+    lsmash_init_entry_list( &saved );
+    isom_clip_swap_tables( clip );
+    int err = isom_clip_update_bitrates( clip, &saved );
+    *size = (file->ftyp ? isom_update_box_size( file->ftyp ) : 0) + isom_update_box_size( moov );
+    if( bs && file->ftyp && err == 0 )
+        err = isom_write_box( bs, (isom_box_t *)file->ftyp );
+    if( bs && err == 0 )
+        err = isom_write_box( bs, (isom_box_t *)moov );
+    lsmash_remove_entries( &saved, isom_clip_restore_bitrate );
+    isom_clip_swap_tables( clip );
+    /* Bring the sizes of the boxes back to the source, which are referred to by in-place editing. */
+    isom_update_box_size( moov );
+    moov->size = old_moov_size;
+    if( file->ftyp )
+        file->ftyp->size = old_ftyp_size;
+    return err;
+}
+
+/* Serialize the File Type Box, the Movie Box and the header of the Media Data Box of the clip. */
+static int isom_clip_write_header( lsmash_file_t *file, isom_clip_t *clip, uint64_t data_size, lsmash_virtual_clip_t *vclip )
+{
+    isom_moov_t *moov = clip->moov;
+    isom_reorder_added_boxes( (isom_box_t *)moov );
+    isom_complement_box_writers( (isom_box_t *)moov );
+    if( file->ftyp )
+        isom_complement_box_writers( (isom_box_t *)file->ftyp );
+    uint64_t mdat_header_size = data_size + ISOM_BASEBOX_COMMON_SIZE > UINT32_MAX ? ISOM_BASEBOX_COMMON_SIZE + 8 : ISOM_BASEBOX_COMMON_SIZE;
+    /* The size of the Movie Box doesn't depend on the values of the chunk offsets but on their sizes. */
+    int      large_presentation = 0;
+    uint64_t movie_size;
+    int err;
+    while( 1 )
+    {
+        if( (err = isom_clip_set_chunk_offsets( clip, 0, large_presentation )) < 0
+         || (err = isom_clip_write_movie( file, clip, NULL, &movie_size )) < 0 )
+            return err;
+        if( large_presentation || movie_size + mdat_header_size + data_size <= UINT32_MAX )
+            break;
+        large_presentation = 1;
+    }
+    uint64_t header_size = movie_size + mdat_header_size;
+    if( (err = isom_clip_set_chunk_offsets( clip, header_size, large_presentation )) < 0 )
+        return err;
+    lsmash_bs_t *mem = lsmash_bs_create();
+    if( !mem )
+        return LSMASH_ERR_MEMORY_ALLOC;
+    if( (err = isom_clip_write_movie( file, clip, mem, &movie_size )) < 0 )
+        goto fail;
+    if( mdat_header_size > ISOM_BASEBOX_COMMON_SIZE )
+    {
+        lsmash_bs_put_be32( mem, 1 );
+        lsmash_bs_put_be32( mem, ISOM_BOX_TYPE_MDAT.fourcc );
+        lsmash_bs_put_be64( mem, data_size + mdat_header_size );
+    }
+    else
+    {
+        lsmash_bs_put_be32( mem, data_size + mdat_header_size );
+        lsmash_bs_put_be32( mem, ISOM_BOX_TYPE_MDAT.fourcc );
+    }
+    if( mem->error || lsmash_bs_get_valid_data_size( mem ) != header_size )
+    {
+        err = LSMASH_ERR_NAMELESS;
+        goto fail;
+    }
+    uint32_t length;
+    vclip->header = lsmash_bs_export_data( mem, &length );
+    if( !vclip->header )
+    {
+        err = LSMASH_ERR_MEMORY_ALLOC;
+        goto fail;
+    }
+    vclip->header_size = length;
+    vclip->size        = header_size + data_size;
+    lsmash_bs_cleanup( mem );
+    return 0;
+fail:
+    lsmash_bs_cleanup( mem );
+    return err;
+}
+
+static int isom_clip_check_movie( lsmash_file_t *file )
+{
+    if( !(file->flags & LSMASH_FILE_MODE_READ)
+     || !file->moov
+     || !file->moov->mvhd
+     || !file->moov->mvhd->timescale )
+        return LSMASH_ERR_FUNCTION_PARAM;
+    if( file->moov->mvex )
+    {
+        lsmash_log( NULL, LSMASH_LOG_ERROR, "fragmented movies cannot be served virtually.\n" );
+        return LSMASH_ERR_PATCH_WELCOME;
+    }
+    return 0;
+}
+
+int lsmash_create_virtual_clip
+(
+    lsmash_root_t         *root,
+    uint64_t               start_time,
+    uint64_t               end_time,
+    lsmash_virtual_clip_t *vclip
+)
+{
+    if( isom_check_initializer_present( root ) < 0
+     || !vclip
+     || (end_time && start_time >= end_time) )
+        return LSMASH_ERR_FUNCTION_PARAM;
+    memset( vclip, 0, sizeof(lsmash_virtual_clip_t) );
+    lsmash_file_t *file = root->file;
+    int err = isom_clip_check_movie( file );
+    if( err < 0 )
+        return err;
+    isom_clip_t clip = { 0 };
+    clip.moov  = file->moov;
+    clip.track = lsmash_malloc_zero( (file->moov->trak_list.entry_count + 1) * sizeof(isom_clip_track_t) );
+    if( !clip.track )
+        return LSMASH_ERR_MEMORY_ALLOC;
+    for( lsmash_entry_t *entry = file->moov->trak_list.head; entry; entry = entry->next )
+    {
+        isom_clip_track_t *track = &clip.track[ clip.track_count ++ ];
+        track->trak = (isom_trak_t *)entry->data;
+        if( !track->trak )
+        {
+            -- clip.track_count;
+            err = LSMASH_ERR_INVALID_DATA;
+            goto fail;
+        }
+        if( (err = isom_clip_setup_track( root, &clip, track, start_time, end_time )) < 0 )
+            goto fail;
+        clip.movie_duration = LSMASH_MAX( clip.movie_duration, track->track_duration );
+    }
+    uint64_t data_size;
+    if( (err = isom_clip_layout_chunks( &clip, vclip, &data_size )) < 0
+     || (err = isom_clip_write_header( file, &clip, data_size, vclip )) < 0 )
+        goto fail;
+    isom_clip_cleanup( &clip );
+    return 0;
+fail:
+    isom_clip_cleanup( &clip );
+    lsmash_cleanup_virtual_clip( vclip );
+    return err;
+}
+
+void lsmash_cleanup_virtual_clip( lsmash_virtual_clip_t *vclip )
+{
+    if( !vclip )
+        return;
+    lsmash_freep( &vclip->header );
+    lsmash_freep( &vclip->range );
+    vclip->header_size = 0;
+    vclip->num_ranges  = 0;
+    vclip->size        = 0;
+}
+
+int lsmash_create_virtual_initialization_segment
+(
+    lsmash_root_t         *root,
+    lsmash_virtual_clip_t *segment
+)
+{
+    if( isom_check_initializer_present( root ) < 0
+     || !segment )
+        return LSMASH_ERR_FUNCTION_PARAM;
+    memset( segment, 0, sizeof(lsmash_virtual_clip_t) );
+    lsmash_file_t *file = root->file;
+    int err = isom_clip_check_movie( file );
+    if( err < 0 )
+        return err;
+    isom_moov_t *moov = file->moov;
+    isom_clip_t  clip = { 0 };
+    lsmash_bs_t *mem  = NULL;
+    clip.moov  = moov;
+    clip.track = lsmash_malloc_zero( (moov->trak_list.entry_count + 1) * sizeof(isom_clip_track_t) );
+    if( !clip.track )
+        return LSMASH_ERR_MEMORY_ALLOC;
+    /* Every track has no sample and no duration in the initialization segment. */
+    for( lsmash_entry_t *entry = moov->trak_list.head; entry; entry = entry->next )
+    {
+        isom_clip_track_t *track = &clip.track[ clip.track_count ++ ];
+        track->trak = (isom_trak_t *)entry->data;
+        if( !track->trak )
+        {
+            -- clip.track_count;
+            err = LSMASH_ERR_INVALID_DATA;
+            goto fail;
+        }
+        if( (err = isom_clip_prepare_track( root, &clip, track )) < 0 )
+            goto fail;
+        lsmash_remove_list( track->elst, NULL );
+        track->elst = NULL;
+    }
+    /* Add the Movie Extends Box only while serializing. */
+    if( !isom_add_mvex( moov )
+     || !isom_add_mehd( moov->mvex ) )
+    {
+        err = LSMASH_ERR_NAMELESS;
+        goto fail;
+    }
+    moov->mvex->mehd->fragment_duration = moov->mvhd->duration;
+    moov->mvex->mehd->version           = moov->mvhd->duration > UINT32_MAX ? 1 : 0;
+    for( uint32_t i = 0; i < clip.track_count; i++ )
+    {
+        isom_trex_t *trex = isom_add_trex( moov->mvex );
+        if( !trex )
+        {
+            err = LSMASH_ERR_NAMELESS;
+            goto fail;
+        }
+        trex->track_ID                         = clip.track[i].trak->tkhd->track_ID;
+        trex->default_sample_description_index = 1;
+    }
+    isom_reorder_added_boxes( (isom_box_t *)moov );
+    isom_complement_box_writers( (isom_box_t *)moov );
+    if( !(mem = lsmash_bs_create()) )
+    {
+        err = LSMASH_ERR_MEMORY_ALLOC;
+        goto fail;
+    }
+    /* The movie fragments may have the features of the version 6 such as negative composition time offsets. */
+    isom_ftyp_t *ftyp   = file->ftyp;
+    uint32_t    *brands = NULL;
+    if( ftyp )
+    {
+        isom_complement_box_writers( (isom_box_t *)ftyp );
+        int has_iso6 = (ftyp->major_brand == ISOM_BRAND_TYPE_ISO6);
+        for( uint32_t i = 0; i < ftyp->brand_count; i++ )
+            has_iso6 |= (ftyp->compatible_brands[i] == ISOM_BRAND_TYPE_ISO6);
+        if( !has_iso6 )
+        {
+            brands = lsmash_malloc( (ftyp->brand_count + 1) * sizeof(uint32_t) );
+            if( !brands )
+            {
+                err = LSMASH_ERR_MEMORY_ALLOC;
+                goto fail;
+            }
+            if( ftyp->brand_count )
+                memcpy( brands, ftyp->compatible_brands, ftyp->brand_count * sizeof(uint32_t) );
+            brands[ ftyp->brand_count ] = ISOM_BRAND_TYPE_ISO6;
+            ISOM_CLIP_SWAP( uint32_t *, ftyp->compatible_brands, brands );
+            ++ ftyp->brand_count;
+        }
+    }
+    uint64_t size;
+    err = isom_clip_write_movie( file, &clip, mem, &size );
+    if( brands )
+    {
+        ISOM_CLIP_SWAP( uint32_t *, ftyp->compatible_brands, brands );
+        -- ftyp->brand_count;
+        lsmash_free( brands );
+    }
+    if( err < 0 )
+        goto fail;
+    if( mem->error || lsmash_bs_get_valid_data_size( mem ) != size )
+    {
+        err = LSMASH_ERR_NAMELESS;
+        goto fail;
+    }
+    uint32_t length;
+    segment->header = lsmash_bs_export_data( mem, &length );
+    if( !segment->header )
+    {
+        err = LSMASH_ERR_MEMORY_ALLOC;
+        goto fail;
+    }
+    segment->header_size = length;
+    segment->size        = length;
+    lsmash_bs_cleanup( mem );
+    isom_remove_box_by_itself( moov->mvex );
+    isom_clip_cleanup( &clip );
+    return 0;
+fail:
+    lsmash_bs_cleanup( mem );
+    if( moov->mvex )
+        isom_remove_box_by_itself( moov->mvex );
+    isom_clip_cleanup( &clip );
+    lsmash_cleanup_virtual_clip( segment );
+    return err;
+}
+
+/* Get the track to whose random accessible samples the media segments are aligned.
+ * The first video track is preferred since the random accessible samples of the other tracks are usually much denser. */
+static isom_trak_t *isom_segment_get_reference_track( isom_moov_t *moov )
+{
+    isom_trak_t *first = NULL;
+    for( lsmash_entry_t *entry = moov->trak_list.head; entry; entry = entry->next )
+    {
+        isom_trak_t *trak = (isom_trak_t *)entry->data;
+        if( !trak )
+            continue;
+        if( !first )
+            first = trak;
+        if( trak->mdia
+         && trak->mdia->hdlr
+         && trak->mdia->hdlr->componentSubtype == ISOM_MEDIA_HANDLER_TYPE_VIDEO_TRACK )
+            return trak;
+    }
+    return first;
+}
+
+/* Get the range of the decoding times of a media segment on the media timeline of the reference track.
+ * The end of the last media segment is UINT64_MAX.
+ * If segment_number is 0, only the number of the media segments is gotten. */
+static int isom_segment_get_range( lsmash_root_t *root, isom_trak_t *trak, uint64_t segment_duration, uint32_t segment_number,
+                                   uint32_t *segment_count, uint64_t *start_dts, uint64_t *end_dts )
+{
+    uint32_t track_ID     = trak->tkhd->track_ID;
+    uint32_t sample_count = lsmash_get_sample_count_in_media_timeline( root, track_ID );
+    double   duration     = (double)segment_duration * trak->mdia->mdhd->timescale / root->file->moov->mvhd->timescale;
+    uint64_t min_duration = LSMASH_MAX( (uint64_t)(duration + 0.5), 1 );
+    *segment_count = 0;
+    *start_dts     = 0;
+    *end_dts       = UINT64_MAX;
+    isom_timeline_t *timeline = isom_get_timeline( root, track_ID );
+    if( !timeline )
+        return LSMASH_ERR_NAMELESS;
+    if( sample_count == 0 )
+        return 0;
+    /* A media segment starts with a random accessible sample at least the duration after the start of the previous one.
+     * The first sample always starts the first media segment. */
+    uint32_t count = 0;
+    uint64_t start = 0;
+    while( 1 )
+    {
+        if( ++count == segment_number )
+            *start_dts = start;
+        uint32_t sample_number;
+        uint64_t dts;
+        int err = isom_timeline_seek_dts( timeline, start + min_duration, 1, &sample_number, &dts );
+        if( err < 0 )
+            return err;
+        if( sample_number == 0 )
+            break;
+        if( count == segment_number )
+        {
+            *end_dts = dts;
+            break;
+        }
+        start = dts;
+    }
+    *segment_count = count;
+    return 0;
+}
+
+/* Add the samples of a track decoded in the range [start_dts, end_dts) to the Movie Fragment Box.
+ * A Track Fragment Box is added for each sample description, and a Track Run Box for each run of the samples
+ * stored contiguously in the source file. */
+static int isom_segment_add_track( lsmash_root_t *root, isom_clip_t *clip, isom_moof_t *moof, isom_trak_t *trak,
+                                   uint64_t start_dts, uint64_t end_dts )
+{
+    uint32_t track_ID     = trak->tkhd->track_ID;
+    uint32_t sample_count = lsmash_get_sample_count_in_media_timeline( root, track_ID );
+    uint32_t trun_flags   = ISOM_TR_FLAGS_DATA_OFFSET_PRESENT
+                          | ISOM_TR_FLAGS_SAMPLE_DURATION_PRESENT
+                          | ISOM_TR_FLAGS_SAMPLE_SIZE_PRESENT
+                          | ISOM_TR_FLAGS_SAMPLE_FLAGS_PRESENT;
+    if( trak->mdia->minf->stbl->ctts )
+        trun_flags |= ISOM_TR_FLAGS_SAMPLE_COMPOSITION_TIME_OFFSET_PRESENT;
+    isom_timeline_t *timeline = isom_get_timeline( root, track_ID );
+    if( !timeline )
+        return LSMASH_ERR_NAMELESS;
+    /* Skip the samples before the media segment without walking through them. */
+    uint32_t first_sample_number;
+    uint64_t first_dts;
+    int err = isom_timeline_seek_dts( timeline, start_dts, 0, &first_sample_number, &first_dts );
+    if( err < 0 || first_sample_number == 0 )
+        return err;
+    isom_traf_t       *traf  = NULL;
+    isom_clip_chunk_t *chunk = NULL;
+    for( uint32_t sample_number = first_sample_number; sample_number <= sample_count; sample_number++ )
+    {
+        uint64_t dts;
+        if( (err = lsmash_get_dts_from_media_timeline( root, track_ID, sample_number, &dts )) < 0 )
+            return err;
+        if( dts >= end_dts )
+            break;
+        lsmash_sample_t info;
+        uint32_t        sample_delta;
+        if( (err = lsmash_get_sample_info_from_media_timeline( root, track_ID, sample_number, &info ))          < 0
+         || (err = lsmash_get_sample_delta_from_media_timeline( root, track_ID, sample_number, &sample_delta )) < 0 )
+            return err;
+        if( !traf || traf->tfhd->sample_description_index != info.index )
+        {
+            if( !(traf = isom_add_traf( moof ))
+             || !isom_add_tfhd( traf )
+             || !isom_add_tfdt( traf ) )
+                return LSMASH_ERR_NAMELESS;
+            isom_tfhd_t *tfhd = traf->tfhd;
+            tfhd->flags                    = ISOM_TF_FLAGS_DEFAULT_BASE_IS_MOOF;
+            tfhd->track_ID                 = track_ID;
+            tfhd->sample_description_index = info.index;
+            if( info.index != 1 )
+                tfhd->flags |= ISOM_TF_FLAGS_SAMPLE_DESCRIPTION_INDEX_PRESENT;
+            traf->tfdt->baseMediaDecodeTime = info.dts;
+            chunk = NULL;
+        }
+        if( !chunk || chunk->pos + chunk->length != info.pos )
+        {
+            isom_trun_t *trun = isom_add_trun( traf );
+            if( !trun
+             || !(trun->optional = lsmash_create_entry_list()) )
+                return LSMASH_ERR_NAMELESS;
+            trun->flags = trun_flags;
+            if( (err = isom_clip_add_chunk( clip, info.pos, info.index )) < 0 )
+                return err;
+            chunk = &clip->chunk[ clip->chunk_count - 1 ];
+            chunk->trun = trun;
+        }
+        int64_t offset = (int64_t)(info.cts - info.dts);
+        isom_trun_optional_row_t row;
+        row.sample_duration                = sample_delta;
+        row.sample_size                    = info.length;
+        row.sample_flags                   = isom_generate_fragment_sample_flags( &info );
+        row.sample_composition_time_offset = (uint32_t)offset;
+        if( offset < 0 )
+            chunk->trun->version = 1;
+        if( (err = isom_clip_add_entry( chunk->trun->optional, &row, sizeof(isom_trun_optional_row_t) )) < 0 )
+            return err;
+        ++ chunk->trun->sample_count;
+        ++ chunk->sample_count;
+        chunk->length += info.length;
+    }
+    return 0;
+}
+
+uint32_t lsmash_count_virtual_media_segments
+(
+    lsmash_root_t *root,
+    uint64_t       segment_duration
+)
+{
+    if( isom_check_initializer_present( root ) < 0
+     || segment_duration == 0
+     || isom_clip_check_movie( root->file ) < 0 )
+        return 0;
+    isom_trak_t *trak = isom_segment_get_reference_track( root->file->moov );
+    uint32_t segment_count;
+    uint64_t start_dts;
+    uint64_t end_dts;
+    if( !trak
+     || isom_clip_check_track( root, trak ) < 0
+     || isom_segment_get_range( root, trak, segment_duration, 0, &segment_count, &start_dts, &end_dts ) < 0 )
+        return 0;
+    return segment_count;
+}
+
+int lsmash_create_virtual_media_segment
+(
+    lsmash_root_t         *root,
+    uint64_t               segment_duration,
+    uint32_t               segment_number,
+    lsmash_virtual_clip_t *segment
+)
+{
+    if( isom_check_initializer_present( root ) < 0
+     || segment_duration == 0
+     || segment_number == 0
+     || !segment )
+        return LSMASH_ERR_FUNCTION_PARAM;
+    memset( segment, 0, sizeof(lsmash_virtual_clip_t) );
+    lsmash_file_t *file = root->file;
+    int err = isom_clip_check_movie( file );
+    if( err < 0 )
+        return err;
+    for( lsmash_entry_t *entry = file->moov->trak_list.head; entry; entry = entry->next )
+    {
+        if( !entry->data )
+            return LSMASH_ERR_INVALID_DATA;
+        if( (err = isom_clip_check_track( root, (isom_trak_t *)entry->data )) < 0 )
+            return err;
+    }
+    isom_trak_t *ref_trak = isom_segment_get_reference_track( file->moov );
+    if( !ref_trak )
+        return LSMASH_ERR_FUNCTION_PARAM;
+    uint32_t segment_count;
+    uint64_t start_dts;
+    uint64_t end_dts;
+    if( (err = isom_segment_get_range( root, ref_trak, segment_duration, segment_number, &segment_count, &start_dts, &end_dts )) < 0 )
+        return err;
+    if( segment_number > segment_count )
+        return LSMASH_ERR_FUNCTION_PARAM;
+    isom_clip_t  clip = { 0 };
+    lsmash_bs_t *mem  = NULL;
+    isom_moof_t *moof = isom_add_moof( file );
+    if( !moof
+     || !isom_add_mfhd( moof ) )
+    {
+        err = LSMASH_ERR_NAMELESS;
+        goto fail;
+    }
+    moof->mfhd->sequence_number = segment_number;
+    /* The other tracks take the samples decoded in the same span of time as the reference track. */
+    uint32_t ref_timescale = ref_trak->mdia->mdhd->timescale;
+    for( lsmash_entry_t *entry = file->moov->trak_list.head; entry; entry = entry->next )
+    {
+        isom_trak_t *trak      = (isom_trak_t *)entry->data;
+        uint32_t     timescale = trak->mdia->mdhd->timescale;
+        uint64_t     start     = start_dts;
+        uint64_t     end       = end_dts;
+        if( trak != ref_trak )
+        {
+            start = (uint64_t)((double)start_dts * timescale / ref_timescale + 0.5);
+            if( end_dts != UINT64_MAX )
+                end = (uint64_t)((double)end_dts * timescale / ref_timescale + 0.5);
+        }
+        if( (err = isom_segment_add_track( root, &clip, moof, trak, start, end )) < 0 )
+            goto fail;
+    }
+    uint64_t data_size;
+    if( (err = isom_clip_layout_chunks( &clip, segment, &data_size )) < 0 )
+        goto fail;
+    uint64_t mdat_header_size = data_size + ISOM_BASEBOX_COMMON_SIZE > UINT32_MAX ? ISOM_BASEBOX_COMMON_SIZE + 8 : ISOM_BASEBOX_COMMON_SIZE;
+    uint64_t header_size      = isom_update_box_size( moof ) + mdat_header_size;
+    /* The data offsets are relative to the first byte of the Movie Fragment Box. */
+    for( uint32_t i = 0; i < clip.chunk_count; i++ )
+    {
+        uint64_t data_offset = header_size + clip.chunk[i].offset;
+        if( data_offset > INT32_MAX )
+        {
+            lsmash_log( NULL, LSMASH_LOG_ERROR, "the media segment is too large to be referred to by data offsets.\n" );
+            err = LSMASH_ERR_INVALID_DATA;
+            goto fail;
+        }
+        clip.chunk[i].trun->data_offset = (int32_t)data_offset;
+    }
+    if( !(mem = lsmash_bs_create()) )
+    {
+        err = LSMASH_ERR_MEMORY_ALLOC;
+        goto fail;
+    }
+    if( (err = isom_write_box( mem, (isom_box_t *)moof )) < 0 )
+        goto fail;
+    if( mdat_header_size > ISOM_BASEBOX_COMMON_SIZE )
+    {
+        lsmash_bs_put_be32( mem, 1 );
+        lsmash_bs_put_be32( mem, ISOM_BOX_TYPE_MDAT.fourcc );
+        lsmash_bs_put_be64( mem, data_size + mdat_header_size );
+    }
+    else
+    {
+        lsmash_bs_put_be32( mem, data_size + mdat_header_size );
+        lsmash_bs_put_be32( mem, ISOM_BOX_TYPE_MDAT.fourcc );
+    }
+    if( mem->error || lsmash_bs_get_valid_data_size( mem ) != header_size )
+    {
+        err = LSMASH_ERR_NAMELESS;
+        goto fail;
+    }
+    uint32_t length;
+    segment->header = lsmash_bs_export_data( mem, &length );
+    if( !segment->header )
+    {
+        err = LSMASH_ERR_MEMORY_ALLOC;
+        goto fail;
+    }
+    segment->header_size = length;
+    segment->size        = header_size + data_size;
+    lsmash_bs_cleanup( mem );
+    isom_remove_box_by_itself( moof );
+    isom_clip_cleanup( &clip );
+    return 0;
+fail:
+    lsmash_bs_cleanup( mem );
+    isom_remove_box_by_itself( moof );
+    isom_clip_cleanup( &clip );
+    lsmash_cleanup_virtual_clip( segment );
+    return err;
+}
+
+int lsmash_set_last_sample_delta( lsmash_root_t *root, uint32_t track_ID, uint32_t sample_delta )
+{
+    if( isom_check_initializer_present( root ) < 0 || track_ID == 0 )
+        return LSMASH_ERR_FUNCTION_PARAM;
+    lsmash_file_t *file = root->file;
+    if( file->fragment
+     && file->fragment->movie )
+    {
+        isom_traf_t *traf = isom_get_traf( file->fragment->movie, track_ID );
+        if( !traf
+         || !traf->cache
+         || !traf->tfhd )
+            return LSMASH_ERR_NAMELESS;
+        return isom_set_fragment_last_duration( traf, sample_delta );
+    }
+    if( file != file->initializer )
+        return LSMASH_ERR_INVALID_DATA;
+    isom_trak_t *trak = isom_get_trak( file, track_ID );
+    if( !trak
+     || !trak->cache
+     || !trak->mdia
+     || !trak->mdia->mdhd
+     || !trak->mdia->minf
+     || !trak->mdia->minf->stbl
+     || !trak->mdia->minf->stbl->stsd
+     || !trak->mdia->minf->stbl->stsz
+     || !trak->mdia->minf->stbl->stts
+     || !trak->mdia->minf->stbl->stts->list )
+        return LSMASH_ERR_NAMELESS;
+    isom_stbl_t *stbl = trak->mdia->minf->stbl;
+    isom_stts_t *stts = stbl->stts;
+    uint32_t sample_count = isom_get_sample_count( trak );
+    int err;
+    if( !stts->list->tail )
+    {
+        if( !sample_count )
+            return 0;       /* no samples */
+        if( sample_count > 1 )
+            return LSMASH_ERR_INVALID_DATA; /* irregular sample_count */
+        /* Set the duration of the first sample.
+         * This duration is also the duration of the last sample. */
+        if( (err = isom_add_stts_entry( stbl, sample_delta )) < 0 )
+            return err;
+        return lsmash_update_track_duration( root, track_ID, 0 );
+    }
+    uint32_t i = 0;
+    for( lsmash_entry_t *entry = stts->list->head; entry; entry = entry->next )
+        i += ((isom_stts_entry_t *)entry->data)->sample_count;
+    if( sample_count < i )
+        return LSMASH_ERR_INVALID_DATA;
+    int no_last = (sample_count > i);
+    isom_stts_entry_t *last_stts_data = (isom_stts_entry_t *)stts->list->tail->data;
+    if( !last_stts_data )
+        return LSMASH_ERR_INVALID_DATA;
+    /* Consider QuikcTime fixed compression audio. */
+    isom_audio_entry_t *audio = (isom_audio_entry_t *)lsmash_get_entry_data( &trak->mdia->minf->stbl->stsd->list,
+                                                                              trak->cache->chunk.sample_description_index );
+    if( !audio )
+        return LSMASH_ERR_INVALID_DATA;
+    if( (audio->manager & LSMASH_AUDIO_DESCRIPTION)
+     && (audio->manager & LSMASH_QTFF_BASE)
+     && (audio->version == 1)
+     && (audio->compression_ID != QT_AUDIO_COMPRESSION_ID_VARIABLE_COMPRESSION) )
+    {
+        if( audio->samplesPerPacket == 0 )
+            return LSMASH_ERR_INVALID_DATA;
+        int exclude_last_sample = no_last ? 0 : 1;
+        uint32_t j = audio->samplesPerPacket;
+        for( lsmash_entry_t *entry = stts->list->tail; entry && j > 1; entry = entry->prev )
+        {
+            isom_stts_entry_t *stts_data = (isom_stts_entry_t *)entry->data;
+            if( !stts_data )
+                return LSMASH_ERR_INVALID_DATA;
+            for( uint32_t k = exclude_last_sample; k < stts_data->sample_count && j > 1; k++ )
+            {
+                sample_delta -= stts_data->sample_delta;
+                --j;
+            }
+            exclude_last_sample = 0;
+        }
+    }
+    /* Set sample_delta. */
+    if( no_last )
+    {
+        /* The duration of the last sample is not set yet. */
+        if( sample_count - i > 1 )
+            return LSMASH_ERR_INVALID_DATA;
+        /* Add a sample_delta. */
+        if( sample_delta == last_stts_data->sample_delta )
+            ++ last_stts_data->sample_count;
+        else if( (err = isom_add_stts_entry( stbl, sample_delta )) < 0 )
+            return err;
+    }
+    /* The duration of the last sample is already set. Replace it with a new one. */
+    else if( (err = isom_replace_last_sample_delta( stbl, sample_delta )) < 0 )
+        return err;
+    return lsmash_update_track_duration( root, track_ID, sample_delta );
+}
+
+/*---- timeline manipulator ----*/
+
+int lsmash_modify_explicit_timeline_map( lsmash_root_t *root, uint32_t track_ID, uint32_t edit_number, lsmash_edit_t edit )
+{
+    if( isom_check_initializer_present( root ) < 0
+     || edit.start_time < -1 )
+        return LSMASH_ERR_FUNCTION_PARAM;
+    lsmash_file_t *file = root->file->initializer;
+    isom_trak_t   *trak = isom_get_trak( file, track_ID );
+    if( !trak
+     || !trak->edts
+     || !trak->edts->elst
+     || !trak->edts->elst->list )
+        return LSMASH_ERR_NAMELESS;
+    isom_elst_t       *elst = trak->edts->elst;
+    isom_elst_entry_t *data = (isom_elst_entry_t *)lsmash_get_entry_data( elst->list, edit_number );
+    if( !data )
+        return LSMASH_ERR_NAMELESS;
+    data->segment_duration = edit.duration;
+    data->media_time       = edit.start_time;
+    data->media_rate       = edit.rate;
+    if( elst->pos == 0 || !file->fragment || file->bs->unseekable )
+        return isom_update_tkhd_duration( trak );
+    /* Rewrite the specified entry.
+     * Note: we don't update the version of the Edit List Box. */
+    lsmash_bs_t *bs = file->bs;
+    uint64_t current_pos = bs->offset;
+    uint64_t entry_pos = elst->pos + ISOM_LIST_FULLBOX_COMMON_SIZE + ((uint64_t)edit_number - 1) * (elst->version == 1 ? 20 : 12);
+    lsmash_bs_write_seek( bs, entry_pos, SEEK_SET );
+    if( elst->version )
+    {
+        lsmash_bs_put_be64( bs, data->segment_duration );
+        lsmash_bs_put_be64( bs, data->media_time );
+    }
+    else
+    {
+        lsmash_bs_put_be32( bs, (uint32_t)LSMASH_MIN( data->segment_duration, UINT32_MAX ) );
+        lsmash_bs_put_be32( bs, (uint32_t)data->media_time );
+    }
+    lsmash_bs_put_be32( bs, data->media_rate );
+    int ret = lsmash_bs_flush_buffer( bs );
+    lsmash_bs_write_seek( bs, current_pos, SEEK_SET );
+    return ret;
+}
+
+int lsmash_create_explicit_timeline_map( lsmash_root_t *root, uint32_t track_ID, lsmash_edit_t edit )
+{
+    if( isom_check_initializer_present( root ) < 0 || edit.start_time < -1 )
+        return LSMASH_ERR_FUNCTION_PARAM;
+    isom_trak_t *trak = isom_get_trak( root->file, track_ID );
+    if( !trak
+     || !trak->tkhd )
+        return LSMASH_ERR_NAMELESS;
+    edit.duration = (edit.duration || root->file->fragment) ? edit.duration
+                  : trak->tkhd->duration ? trak->tkhd->duration
+                  : isom_update_tkhd_duration( trak ) < 0 ? 0
+                  : trak->tkhd->duration;
+    if( (!trak->edts       && !isom_add_edts( trak ))
+     || (!trak->edts->elst && !isom_add_elst( trak->edts )) )
+        return LSMASH_ERR_NAMELESS;
+    int err = isom_add_elst_entry( trak->edts->elst, edit.duration, edit.start_time, edit.rate );
+    if( err < 0 )
+        return err;
+    return isom_update_tkhd_duration( trak );
+}
+
+int lsmash_get_explicit_timeline_map( lsmash_root_t *root, uint32_t track_ID, uint32_t edit_number, lsmash_edit_t *edit )
+{
+    if( isom_check_initializer_present( root ) < 0 || !edit )
+        return LSMASH_ERR_FUNCTION_PARAM;
+    isom_elst_entry_t *data;
+    isom_trak_t *trak = isom_get_trak( root->file->initializer, track_ID );
+    if( !trak )
+        data = isom_timelime_get_explicit_timeline_map( root, track_ID, edit_number );
+    else
+    {
+        if( !trak->edts
+         || !trak->edts->elst )
+        {
+            /* no edits */
             edit->duration   = 0;
             edit->start_time = 0;
             edit->rate       = 0;
@@ -3543,22 +5028,77 @@ static int isom_roll_grouping_established( isom_roll_group_t *group )
             /* The same description already exists.
              * Set the group_description_index corresponding the same description. */
             group->assignment->group_description_index = group_description_index;
+            group->description = data;
+            group->established = 1;
             return 0;
         }
         ++group_description_index;
     }
     /* Add a new roll recovery description. */
-    if( !isom_add_roll_group_entry( sgpd, group->roll_distance ) )
+    group->description = isom_add_roll_group_entry( sgpd, group->roll_distance );
+    if( !group->description )
         return LSMASH_ERR_MEMORY_ALLOC;
     group->assignment->group_description_index = sgpd->list->entry_count + (group->is_fragment ? 0x10000 : 0);
+    group->established = 1;
+    return 0;
+}
+
+/* Queue a group which has got delimited and determined so that it is described at the next flush of the pool. */
+static int isom_roll_group_ready( isom_grouping_t *roll, isom_roll_group_t *group )
+{
+    if( roll->ready_count == roll->ready_alloc )
+    {
+        uint32_t alloc = roll->ready_alloc ? 2 * roll->ready_alloc : 16;
+        isom_roll_group_t **ready = lsmash_realloc( roll->ready, alloc * sizeof(isom_roll_group_t *) );
+        if( !ready )
+            return LSMASH_ERR_MEMORY_ALLOC;
+        roll->ready       = ready;
+        roll->ready_alloc = alloc;
+    }
+    roll->ready[ roll->ready_count++ ] = group;
     return 0;
 }
 
+static int isom_roll_group_delimited( isom_grouping_t *roll, isom_roll_group_t *group )
+{
+    group->delimited = 1;
+    return group->described == ROLL_DISTANCE_DETERMINED ? isom_roll_group_ready( roll, group ) : 0;
+}
+
+static int isom_roll_group_determined( isom_grouping_t *roll, isom_roll_group_t *group )
+{
+    group->described = ROLL_DISTANCE_DETERMINED;
+    if( group->pending_entry )
+    {
+        /* Don't free the group here since it is still in the pool. */
+        group->pending_entry->data = NULL;
+        lsmash_remove_entry_direct( roll->pending, group->pending_entry, NULL );
+        group->pending_entry = NULL;
+    }
+    return group->delimited ? isom_roll_group_ready( roll, group ) : 0;
+}
+
+static void isom_clear_roll_pending( isom_grouping_t *roll )
+{
+    for( lsmash_entry_t *entry = roll->pending->head; entry; entry = entry->next )
+    {
+        ((isom_roll_group_t *)entry->data)->pending_entry = NULL;
+        entry->data = NULL;
+    }
+    lsmash_remove_entries( roll->pending, NULL );
+}
+
 static int isom_deduplicate_roll_group( isom_sbgp_t *sbgp, lsmash_entry_list_t *pool )
 {
     /* Deduplication */
-    uint32_t current_group_number = sbgp->list->entry_count - pool->entry_count + 1;
-    isom_group_assignment_entry_t *prev_assignment = (isom_group_assignment_entry_t *)lsmash_get_entry_data( sbgp->list, current_group_number - 1 );
+    if( !pool->head )
+        return 0;
+    isom_roll_group_t *head = (isom_roll_group_t *)pool->head->data;
+    if( !head
+     || !head->assignment_entry )
+        return LSMASH_ERR_INVALID_DATA;
+    lsmash_entry_t *prev = head->assignment_entry->prev;
+    isom_group_assignment_entry_t *prev_assignment = prev ? (isom_group_assignment_entry_t *)prev->data : NULL;
     for( lsmash_entry_t *entry = pool->head; entry; )
     {
         isom_roll_group_t *group = (isom_roll_group_t *)entry->data;
@@ -3573,8 +5113,8 @@ static int isom_deduplicate_roll_group( isom_sbgp_t *sbgp, lsmash_entry_list_t *
             lsmash_entry_t *next_entry = entry->next;
             prev_assignment->sample_count += group->assignment->sample_count;
             int err;
-            if( (err = lsmash_remove_entry( sbgp->list, current_group_number, NULL )) < 0
-             || (err = lsmash_remove_entry_direct( pool, entry, NULL ))               < 0 )
+            if( (err = lsmash_remove_entry_direct( sbgp->list, group->assignment_entry, NULL )) < 0
+             || (err = lsmash_remove_entry_direct( pool, entry, NULL ))                         < 0 )
                 return err;
             entry = next_entry;
         }
@@ -3582,7 +5122,6 @@ static int isom_deduplicate_roll_group( isom_sbgp_t *sbgp, lsmash_entry_list_t *
         {
             entry = entry->next;
             prev_assignment = group->assignment;
-            ++current_group_number;
         }
     }
     return 0;
@@ -3605,62 +5144,75 @@ static int isom_clean_roll_pool( lsmash_entry_list_t *pool )
     return 0;
 }
 
-static int isom_flush_roll_pool( isom_sbgp_t *sbgp, lsmash_entry_list_t *pool )
+static int isom_flush_roll_pool( isom_sbgp_t *sbgp, isom_grouping_t *roll )
 {
-    int err;
-    for( lsmash_entry_t *entry = pool->head; entry; entry = entry->next )
+    /* Describe the groups which have got ready in order of the pool
+     * so that the order of the sample group descriptions is kept. */
+    isom_roll_group_t **ready = roll->ready;
+    for( uint32_t i = 1; i < roll->ready_count; i++ )
     {
-        isom_roll_group_t *group = (isom_roll_group_t *)entry->data;
-        if( !group )
-            return LSMASH_ERR_INVALID_DATA;
-        if( group->delimited
-         && group->described == ROLL_DISTANCE_DETERMINED
-         && group->roll_distance != 0
-         && (err = isom_roll_grouping_established( group )) < 0 )
-            return err;
+        isom_roll_group_t *group = ready[i];
+        uint32_t j = i;
+        for( ; j && ready[j - 1]->number > group->number; j-- )
+            ready[j] = ready[j - 1];
+        ready[j] = group;
     }
-    if( (err = isom_deduplicate_roll_group( sbgp, pool )) < 0 )
+    int err;
+    for( uint32_t i = 0; i < roll->ready_count; i++ )
+        if( ready[i]->roll_distance != 0
+         && !ready[i]->established
+         && (err = isom_roll_grouping_established( ready[i] )) < 0 )
+            return err;
+    roll->ready_count = 0;
+    if( (err = isom_deduplicate_roll_group( sbgp, roll->pool )) < 0 )
         return err;
-    return isom_clean_roll_pool( pool );
+    return isom_clean_roll_pool( roll->pool );
 }
 
-static int isom_all_recovery_described( isom_sbgp_t *sbgp, lsmash_entry_list_t *pool )
+static int isom_all_recovery_described( isom_sbgp_t *sbgp, isom_grouping_t *roll )
 {
-    for( lsmash_entry_t *entry = pool->head; entry; entry = entry->next )
+    for( lsmash_entry_t *entry = roll->pending->head; entry; entry = entry->next )
     {
         isom_roll_group_t *group = (isom_roll_group_t *)entry->data;
-        if( !group )
-            return LSMASH_ERR_INVALID_DATA;
         group->described = ROLL_DISTANCE_DETERMINED;
+        int err;
+        if( group->delimited
+         && (err = isom_roll_group_ready( roll, group )) < 0 )
+            return err;
     }
-    return isom_flush_roll_pool( sbgp, pool );
+    isom_clear_roll_pending( roll );
+    return isom_flush_roll_pool( sbgp, roll );
 }
 
-int isom_all_recovery_completed( isom_sbgp_t *sbgp, lsmash_entry_list_t *pool )
+int isom_all_recovery_completed( isom_sbgp_t *sbgp, isom_grouping_t *roll )
 {
-    for( lsmash_entry_t *entry = pool->head; entry; entry = entry->next )
+    for( lsmash_entry_t *entry = roll->pool->head; entry; entry = entry->next )
     {
         isom_roll_group_t *group = (isom_roll_group_t *)entry->data;
         if( !group )
             return LSMASH_ERR_INVALID_DATA;
+        int was_ready = group->delimited && group->described == ROLL_DISTANCE_DETERMINED;
         group->described = ROLL_DISTANCE_DETERMINED;
         group->delimited = 1;
+        int err;
+        if( !was_ready
+         && (err = isom_roll_group_ready( roll, group )) < 0 )
+            return err;
     }
-    return isom_flush_roll_pool( sbgp, pool );
+    isom_clear_roll_pending( roll );
+    return isom_flush_roll_pool( sbgp, roll );
 }
 
-static isom_roll_entry_t *isom_get_roll_description
-(
-    isom_roll_group_t *group
-)
+void isom_remove_roll_grouping( isom_grouping_t *roll )
 {
-    uint32_t group_description_index = group->assignment->group_description_index;
-    if( group_description_index && group->is_fragment )
+    if( roll->pending )
     {
-        assert( group_description_index > 0x10000 );
-        group_description_index -= 0x10000;
+        isom_clear_roll_pending( roll );
+        lsmash_freep( &roll->pending );
     }
-    return (isom_roll_entry_t *)lsmash_get_entry_data( group->sgpd->list, group_description_index );
+    lsmash_remove_list( roll->pool, NULL );
+    lsmash_freep( &roll->ready );
+    roll->pool = NULL;
 }
 
 int isom_group_roll_recovery( isom_box_t *parent, lsmash_sample_t *sample )
@@ -3711,16 +5263,20 @@ int isom_group_roll_recovery( isom_box_t *parent, lsmash_sample_t *sample )
         sbgp->grouping_type = ISOM_GROUP_TYPE_PROL;
         sgpd->grouping_type = ISOM_GROUP_TYPE_PROL;
     }
-    lsmash_entry_list_t *pool = cache->roll.pool;
-    if( !pool )
+    isom_grouping_t *roll = &cache->roll;
+    if( !roll->pool )
     {
-        pool = lsmash_create_entry_list();
-        if( !pool )
+        roll->pool    = lsmash_create_entry_list();
+        roll->pending = lsmash_create_entry_list();
+        if( !roll->pool || !roll->pending )
+        {
+            isom_remove_roll_grouping( roll );
             return LSMASH_ERR_MEMORY_ALLOC;
-        cache->roll.pool = pool;
+        }
     }
+    lsmash_entry_list_t      *pool  = roll->pool;
     lsmash_sample_property_t *prop  = &sample->prop;
-    isom_roll_group_t        *group = (isom_roll_group_t *)lsmash_get_entry_data( pool, pool->entry_count );
+    isom_roll_group_t        *group = pool->tail ? (isom_roll_group_t *)pool->tail->data : NULL;
     int is_recovery_start = LSMASH_IS_POST_ROLL_START( prop->ra_flags );
     int valid_pre_roll = !is_recovery_start
                       && (prop->ra_flags != ISOM_SAMPLE_RANDOM_ACCESS_FLAG_NONE)
@@ -3731,17 +5287,21 @@ int isom_group_roll_recovery( isom_box_t *parent, lsmash_sample_t *sample )
     {
         /* Check pre-roll distance. */
         assert( group->assignment && group->sgpd );
-        isom_roll_entry_t *prev_roll = isom_get_roll_description( group );
+        isom_roll_entry_t *prev_roll = group->description;
         if( !prev_roll )
             new_group = valid_pre_roll;
         else if( !valid_pre_roll || (prop->pre_roll.distance != -prev_roll->roll_distance) )
             /* Pre-roll distance is different from the previous. */
             new_group = 1;
     }
+    int err;
     if( new_group )
     {
         if( group )
-            group->delimited = 1;
+        {
+            if( (err = isom_roll_group_delimited( roll, group )) < 0 )
+                return err;
+        }
         else
             assert( sample_count == 1 );
         /* Create a new group. */
@@ -3757,11 +5317,16 @@ int isom_group_roll_recovery( isom_box_t *parent, lsmash_sample_t *sample )
             lsmash_free( group );
             return LSMASH_ERR_MEMORY_ALLOC;
         }
+        group->assignment_entry = sbgp->list->tail;
+        group->number           = roll->group_count++;
         if( is_recovery_start )
         {
             /* a member of non-roll or post-roll group */
             group->first_sample   = sample_count;
             group->recovery_point = prop->post_roll.complete;
+            if( lsmash_add_entry( roll->pending, group ) < 0 )
+                return LSMASH_ERR_MEMORY_ALLOC;
+            group->pending_entry = roll->pending->tail;
         }
         else
         {
@@ -3770,8 +5335,7 @@ int isom_group_roll_recovery( isom_box_t *parent, lsmash_sample_t *sample )
             {
                 /* a member of pre-roll group */
                 group->roll_distance = -(signed)prop->pre_roll.distance;
-                int err = isom_roll_grouping_established( group );
-                if( err < 0 )
+                if( (err = isom_roll_grouping_established( group )) < 0 )
                     return err;
             }
             else
@@ -3788,15 +5352,15 @@ int isom_group_roll_recovery( isom_box_t *parent, lsmash_sample_t *sample )
     if( prop->ra_flags & (ISOM_SAMPLE_RANDOM_ACCESS_FLAG_SYNC
                         | ISOM_SAMPLE_RANDOM_ACCESS_FLAG_RAP
                         |   QT_SAMPLE_RANDOM_ACCESS_FLAG_PARTIAL_SYNC) )
-        return isom_all_recovery_described( sbgp, pool );
-    /* Check whether this sample is a random access recovery point or not. */
-    for( lsmash_entry_t *entry = pool->head; entry; entry = entry->next )
+        return isom_all_recovery_described( sbgp, roll );
+    /* Check whether this sample is a random access recovery point or not.
+     * Only the groups whose roll_distance is not determined yet are checked. */
+    for( lsmash_entry_t *entry = roll->pending->head; entry; )
     {
+        lsmash_entry_t *next = entry->next;
         group = (isom_roll_group_t *)entry->data;
         if( !group )
             return LSMASH_ERR_INVALID_DATA;
-        if( group->described == ROLL_DISTANCE_DETERMINED )
-            continue;
         if( group->described == ROLL_DISTANCE_INITIALIZED )
         {
             /* Let's consider the following picture sequence.
@@ -3810,14 +5374,15 @@ int isom_group_roll_recovery( isom_box_t *parent, lsmash_sample_t *sample )
              *                  ---(incorrect?)--->|
              * there is no guarantee that P[5] is decoded and output correctly.
              * From this, it can be said that the roll_distance of this sequence is equal to 5. */
-            isom_roll_entry_t *post_roll = isom_get_roll_description( group );
+            isom_roll_entry_t *post_roll = group->description;
             if( post_roll && post_roll->roll_distance > 0 )
             {
                 if( group->rp_cts > sample->cts )
                     /* Updated roll_distance for composition reordering. */
                     post_roll->roll_distance = sample_count - group->first_sample;
-                if( ++ group->wait_and_see_count >= MAX_ROLL_WAIT_AND_SEE_COUNT )
-                    group->described = ROLL_DISTANCE_DETERMINED;
+                if( ++ group->wait_and_see_count >= MAX_ROLL_WAIT_AND_SEE_COUNT
+                 && (err = isom_roll_group_determined( roll, group )) < 0 )
+                    return err;
             }
         }
         else if( prop->post_roll.identifier == group->recovery_point )
@@ -3833,13 +5398,14 @@ int isom_group_roll_recovery( isom_box_t *parent, lsmash_sample_t *sample )
                 group->described          = ROLL_DISTANCE_INITIALIZED;
                 group->wait_and_see_count = 0;
                 /* All groups with uninitialized roll_distance before the current group are described. */
-                lsmash_entry_t *current = entry;
-                for( entry = pool->head; entry != current; entry = entry->next )
+                for( lsmash_entry_t *prev = roll->pending->head; prev != entry; )
                 {
-                    group = (isom_roll_group_t *)entry->data;
-                    if( !group || group->described != ROLL_DISTANCE_INITIALIZED )
-                        continue;
-                    group->described = ROLL_DISTANCE_DETERMINED;
+                    lsmash_entry_t *prev_next = prev->next;
+                    group = (isom_roll_group_t *)prev->data;
+                    if( group->described == ROLL_DISTANCE_INITIALIZED
+                     && (err = isom_roll_group_determined( roll, group )) < 0 )
+                        return err;
+                    prev = prev_next;
                 }
                 /* Cache the CTS of the first recovery point in a subsegment. */
                 if( cache->fragment
@@ -3853,10 +5419,11 @@ int isom_group_roll_recovery( isom_box_t *parent, lsmash_sample_t *sample )
             }
             else
                 /* Random Accessible Point */
-                return isom_all_recovery_described( sbgp, pool );
+                return isom_all_recovery_described( sbgp, roll );
         }
+        entry = next;
     }
-    return isom_flush_roll_pool( sbgp, pool );
+    return isom_flush_roll_pool( sbgp, roll );
 }
 
 /* returns 1 if pooled samples must be flushed. */
@@ -3933,8 +5500,10 @@ static int isom_write_pooled_samples( lsmash_file_t *file, isom_sample_pool_t *p
      || !(file->flags & LSMASH_FILE_MODE_MEDIA)
      || ((file->flags & LSMASH_FILE_MODE_BOX) && !file->mdat) )
         return LSMASH_ERR_INVALID_DATA;
+    isom_trace_begin( file->root, LSMASH_TRACE_PHASE_CHUNK_WRITE );
     lsmash_bs_put_bytes( file->bs, pool->size, pool->data );
     int err = lsmash_bs_flush_buffer( file->bs );
+    isom_trace_end( file->root, LSMASH_TRACE_PHASE_CHUNK_WRITE, pool->size, pool->sample_count );
     if( err < 0 )
         return err;
     if( file->mdat )
@@ -3945,7 +5514,8 @@ static int isom_write_pooled_samples( lsmash_file_t *file, isom_sample_pool_t *p
     return 0;
 }
 
-int isom_update_sample_tables
+/* Add a sample into the sample tables except for chunk relative ones. */
+static int isom_add_sample_into_tables
 (
     isom_trak_t         *trak,
     lsmash_sample_t     *sample,
@@ -4007,6 +5577,20 @@ int isom_update_sample_tables
             return err;
         *samples_per_packet = 1;
     }
+    return 0;
+}
+
+int isom_update_sample_tables
+(
+    isom_trak_t         *trak,
+    lsmash_sample_t     *sample,
+    uint32_t            *samples_per_packet,
+    isom_sample_entry_t *sample_entry
+)
+{
+    int err = isom_add_sample_into_tables( trak, sample, samples_per_packet, sample_entry );
+    if( err < 0 )
+        return err;
     /* Add a chunk if needed. */
     return isom_add_chunk( trak, sample );
 }
@@ -4113,8 +5697,16 @@ static int isom_append_sample_internal
             continue;
         double diff = ((double)sample->dts      /  trak->mdia->mdhd->timescale)
                     - ((double)chunk->first_dts / other->mdia->mdhd->timescale);
-        if( diff > tolerance && (ret = isom_output_cached_chunk( other )) < 0 )
-            return ret;
+        if( diff > tolerance )
+        {
+            uint64_t chunk_size   = chunk->pool->size;
+            uint32_t sample_count = chunk->pool->sample_count;
+            isom_trace_begin( file->root, LSMASH_TRACE_PHASE_INTERLEAVE );
+            ret = isom_output_cached_chunk( other );
+            isom_trace_end( file->root, LSMASH_TRACE_PHASE_INTERLEAVE, chunk_size, sample_count );
+            if( ret < 0 )
+                return ret;
+        }
         /* Note: we don't flush the cached chunk in the current track and the current sample here
          * even if the conditional expression of '-diff > tolerance' meets.
          * That's useless because appending a sample to another track would be a good equivalent.
@@ -4125,7 +5717,11 @@ static int isom_append_sample_internal
          * right next to the previous chunk of the same track or not. */
     }
     /* anyway the current sample must be pooled. */
-    return isom_pool_sample( current_pool, sample, samples_per_packet );
+    uint32_t sample_length = sample->length;
+    isom_trace_begin( file->root, LSMASH_TRACE_PHASE_SAMPLE_POOLING );
+    ret = isom_pool_sample( current_pool, sample, samples_per_packet );
+    isom_trace_end( file->root, LSMASH_TRACE_PHASE_SAMPLE_POOLING, sample_length, samples_per_packet );
+    return ret;
 }
 
 int isom_append_sample_by_type
@@ -4169,6 +5765,22 @@ int isom_append_sample_by_type
     return func_append_sample( track, sample, sample_entry );
 }
 
+/* If there is no available Media Data Box to write samples, add and write a new one before any chunk offset is decided. */
+static int isom_prepare_mdat( lsmash_file_t *file )
+{
+    if( file->mdat )
+        return 0;
+    if( !isom_add_mdat( file ) )
+        return LSMASH_ERR_NAMELESS;
+    file->mdat->manager |= LSMASH_PLACEHOLDER;
+    int err = isom_write_box( file->bs, (isom_box_t *)file->mdat );
+    if( err < 0 )
+        return err;
+    assert( file->free );
+    file->size += file->free->size + file->mdat->size;
+    return 0;
+}
+
 /* This function is for non-fragmented movie. */
 static int isom_append_sample
 (
@@ -4178,18 +5790,9 @@ static int isom_append_sample
     isom_sample_entry_t *sample_entry
 )
 {
-    /* If there is no available Media Data Box to write samples, add and write a new one before any chunk offset is decided. */
-    int err;
-    if( !file->mdat )
-    {
-        if( !isom_add_mdat( file ) )
-            return LSMASH_ERR_NAMELESS;
-        file->mdat->manager |= LSMASH_PLACEHOLDER;
-        if( (err = isom_write_box( file->bs, (isom_box_t *)file->mdat )) < 0 )
-            return err;
-        assert( file->free );
-        file->size += file->free->size + file->mdat->size;
-    }
+    int err = isom_prepare_mdat( file );
+    if( err < 0 )
+        return err;
     return isom_append_sample_by_type( trak, sample, sample_entry, (int (*)( void *, lsmash_sample_t *, isom_sample_entry_t * ))isom_append_sample_internal );
 }
 
@@ -4236,7 +5839,7 @@ static int isom_output_cache( isom_trak_t *trak )
                 isom_sbgp_t *sbgp = isom_get_roll_recovery_sample_to_group( &stbl->sbgp_list );
                 if( !sbgp )
                     return LSMASH_ERR_NAMELESS;
-                if( (err = isom_all_recovery_completed( sbgp, cache->roll.pool )) < 0 )
+                if( (err = isom_all_recovery_completed( sbgp, &cache->roll )) < 0 )
                     return err;
                 break;
             default :
@@ -4271,7 +5874,22 @@ int lsmash_flush_pooled_samples( lsmash_root_t *root, uint32_t track_ID, uint32_
     return lsmash_set_last_sample_delta( root, track_ID, last_sample_delta );
 }
 
-int lsmash_append_sample( lsmash_root_t *root, uint32_t track_ID, lsmash_sample_t *sample )
+/* Write File Type Box here if it was not written yet. */
+static int isom_write_ftyp_before_media( lsmash_file_t *file )
+{
+    if( (file->flags & LSMASH_FILE_MODE_INITIALIZATION)
+     && file->ftyp
+     && !(file->ftyp->manager & LSMASH_WRITTEN_BOX) )
+    {
+        int err = isom_write_box( file->bs, (isom_box_t *)file->ftyp );
+        if( err < 0 )
+            return err;
+        file->size += file->ftyp->size;
+    }
+    return 0;
+}
+
+static int isom_append_sample_to_root( lsmash_root_t *root, uint32_t track_ID, lsmash_sample_t *sample )
 {
     if( isom_check_initializer_present( root ) < 0
      || track_ID == 0
@@ -4287,17 +5905,9 @@ int lsmash_append_sample( lsmash_root_t *root, uint32_t track_ID, lsmash_sample_
      || file->max_chunk_duration  == 0
      || file->max_async_tolerance == 0 )
         return LSMASH_ERR_NAMELESS;
-    /* Write File Type Box here if it was not written yet. */
-    if( file->flags & LSMASH_FILE_MODE_INITIALIZATION )
-    {
-        if( file->ftyp && !(file->ftyp->manager & LSMASH_WRITTEN_BOX) )
-        {
-            int err = isom_write_box( file->bs, (isom_box_t *)file->ftyp );
-            if( err < 0 )
-                return err;
-            file->size += file->ftyp->size;
-        }
-    }
+    int err = isom_write_ftyp_before_media( file );
+    if( err < 0 )
+        return err;
     /* Get a sample initializer. */
     isom_trak_t *trak = isom_get_trak( file->initializer, track_ID );
     if( !trak
@@ -4325,6 +5935,116 @@ int lsmash_append_sample( lsmash_root_t *root, uint32_t track_ID, lsmash_sample_
     return isom_append_sample( file, trak, sample, sample_entry );
 }
 
+int lsmash_append_sample( lsmash_root_t *root, uint32_t track_ID, lsmash_sample_t *sample )
+{
+    uint32_t sample_length = sample ? sample->length : 0;
+    isom_trace_begin( root, LSMASH_TRACE_PHASE_SAMPLE_APPEND );
+    int err = isom_append_sample_to_root( root, track_ID, sample );
+    isom_trace_end( root, LSMASH_TRACE_PHASE_SAMPLE_APPEND, err < 0 ? 0 : sample_length, err < 0 ? 0 : 1 );
+    return err;
+}
+
+static int isom_append_chunk_to_root( lsmash_root_t *root, uint32_t track_ID, lsmash_sample_t *samples, uint32_t sample_count, uint8_t *data )
+{
+    if( isom_check_initializer_present( root ) < 0
+     || track_ID == 0
+     || !samples
+     || sample_count == 0
+     || !data )
+        return LSMASH_ERR_FUNCTION_PARAM;
+    lsmash_file_t *file = root->file;
+    if( !file
+     || !file->bs
+     || !(file->flags & LSMASH_FILE_MODE_BOX)
+     || file != file->initializer
+     || file->fragment )
+        return LSMASH_ERR_NAMELESS;
+    isom_trak_t *trak = isom_get_trak( file, track_ID );
+    if( !trak
+     || !trak->file
+     || !trak->cache
+     || !trak->tkhd
+     || !trak->mdia
+     || !trak->mdia->mdhd
+     ||  trak->mdia->mdhd->timescale == 0
+     || !trak->mdia->minf
+     || !trak->mdia->minf->dinf
+     || !trak->mdia->minf->dinf->dref
+     || !trak->mdia->minf->stbl
+     || !trak->mdia->minf->stbl->stsd
+     || !trak->mdia->minf->stbl->stsc || !trak->mdia->minf->stbl->stsc->list )
+        return LSMASH_ERR_NAMELESS;
+    /* All samples in a chunk share the same sample description. */
+    uint32_t sample_description_index = samples[0].index;
+    uint64_t chunk_size               = 0;
+    for( uint32_t i = 0; i < sample_count; i++ )
+    {
+        if( samples[i].index != sample_description_index )
+            return LSMASH_ERR_FUNCTION_PARAM;
+        chunk_size += samples[i].length;
+    }
+    if( chunk_size > INT_MAX )
+        return LSMASH_ERR_FUNCTION_PARAM;
+    isom_sample_entry_t *sample_entry = (isom_sample_entry_t *)lsmash_get_entry_data( &trak->mdia->minf->stbl->stsd->list, sample_description_index );
+    if( !sample_entry )
+        return LSMASH_ERR_NAMELESS;
+    if( isom_get_written_media_file( trak, sample_description_index ) != file )
+        return LSMASH_ERR_PATCH_WELCOME;    /* external data reference */
+    int err;
+    if( (err = isom_write_ftyp_before_media( file )) < 0
+     || (err = isom_prepare_mdat( file )) < 0 )
+        return err;
+    /* Samples already pooled by lsmash_append_sample() form the preceding chunk. */
+    isom_chunk_t *current = &trak->cache->chunk;
+    if( current->pool
+     && current->pool->sample_count
+     && (err = isom_output_cached_chunk( trak )) < 0 )
+        return err;
+    /* Add the samples into the sample tables. */
+    uint32_t chunk_sample_count = 0;
+    for( uint32_t i = 0; i < sample_count; i++ )
+    {
+        uint32_t samples_per_packet;
+        if( (err = isom_add_sample_into_tables( trak, &samples[i], &samples_per_packet, sample_entry )) < 0 )
+            return err;
+        chunk_sample_count += samples_per_packet;
+    }
+    /* Add the chunk and then write its data as it is. */
+    isom_stbl_t       *stbl           = trak->mdia->minf->stbl;
+    isom_stsc_entry_t *last_stsc_data = stbl->stsc->list->tail ? (isom_stsc_entry_t *)stbl->stsc->list->tail->data : NULL;
+    current->chunk_number            += 1;
+    current->sample_description_index = sample_description_index;
+    current->first_dts                = samples[0].dts;
+    if( (!last_stsc_data
+      || chunk_sample_count       != last_stsc_data->samples_per_chunk
+      || sample_description_index != last_stsc_data->sample_description_index)
+     && (err = isom_add_stsc_entry( stbl, current->chunk_number, chunk_sample_count, sample_description_index )) < 0 )
+        return err;
+    if( (err = isom_add_stco_entry( stbl, file->size )) < 0 )
+        return err;
+    /* Write the data directly without copying it into the buffer of the stream. */
+    isom_trace_begin( root, LSMASH_TRACE_PHASE_CHUNK_WRITE );
+    if( (err = lsmash_bs_flush_buffer( file->bs )) == 0 )
+        err = lsmash_bs_write_data( file->bs, data, chunk_size );
+    isom_trace_end( root, LSMASH_TRACE_PHASE_CHUNK_WRITE, chunk_size, chunk_sample_count );
+    if( err < 0 )
+        return err;
+    file->mdat->media_size += chunk_size;
+    file->size             += chunk_size;
+    return 0;
+}
+
+int lsmash_append_chunk( lsmash_root_t *root, uint32_t track_ID, lsmash_sample_t *samples, uint32_t sample_count, uint8_t *data )
+{
+    uint64_t chunk_size = 0;
+    for( uint32_t i = 0; samples && i < sample_count; i++ )
+        chunk_size += samples[i].length;
+    isom_trace_begin( root, LSMASH_TRACE_PHASE_SAMPLE_APPEND );
+    int err = isom_append_chunk_to_root( root, track_ID, samples, sample_count, data );
+    isom_trace_end( root, LSMASH_TRACE_PHASE_SAMPLE_APPEND, err < 0 ? 0 : chunk_size, err < 0 ? 0 : sample_count );
+    return err;
+}
+
 /*---- misc functions ----*/
 
 int lsmash_delete_explicit_timeline_map( lsmash_root_t *root, uint32_t track_ID )
@@ -4386,3 +6106,24 @@ int lsmash_set_copyright( lsmash_root_t *root, uint32_t track_ID, uint16_t ISO_l
     cprt->notice        = lsmash_memdup( notice, cprt->notice_length );
     return 0;
 }
+
+void lsmash_delete_copyright( lsmash_root_t *root, uint32_t track_ID )
+{
+    if( isom_check_initializer_present( root ) < 0
+     || !root->file->initializer->moov )
+        return;
+    isom_udta_t *udta;
+    if( track_ID )
+    {
+        isom_trak_t *trak = isom_get_trak( root->file->initializer, track_ID );
+        if( !trak )
+            return;
+        udta = trak->udta;
+    }
+    else
+        udta = root->file->initializer->moov->udta;
+    if( !udta )
+        return;
+    while( udta->cprt_list.head )
+        isom_remove_box_by_itself( udta->cprt_list.head->data );
+}
@@ -488,6 +488,15 @@ uint32_t lsmash_count_itunes_metadata( lsmash_root_t *root )
     return root->file->initializer->moov->udta->meta->ilst->metaitem_list.entry_count;
 }
 
+void lsmash_delete_itunes_metadata( lsmash_root_t *root )
+{
+    if( isom_check_initializer_present( root ) < 0
+     || !root->file->initializer->moov
+     || !root->file->initializer->moov->udta )
+        return;
+    isom_remove_box_by_itself( root->file->initializer->moov->udta->meta );
+}
+
 void lsmash_cleanup_itunes_metadata( lsmash_itunes_metadata_t *metadata )
 {
     if( !metadata )
@@ -28,6 +28,8 @@
 #include <stdarg.h> /* for isom_iprintf */
 
 #include "box.h"
+#include "file.h"
+#include "print.h"
 
 
 typedef int (*isom_print_box_t)( FILE *, lsmash_file_t *, isom_box_t *, int );
@@ -39,6 +41,39 @@ typedef struct
     isom_print_box_t func;
 } isom_print_entry_t;
 
+typedef struct print_stream_tag
+{
+    FILE                      *fp;
+    char                      *buffer;      /* the buffer for fully buffered output */
+    int                        max_depth;
+    uint32_t                   max_entries;
+    uint32_t                   type_count;
+    lsmash_compact_box_type_t *types;
+    uint64_t                   box_count;   /* the number of boxes read so far */
+    int                        size_known;
+    uint64_t                   file_size;
+    lsmash_print_format        format;
+    char                      *json;        /* the buffer of JSON text not yet written */
+    size_t                     json_pos;
+    int                        json_first;  /* whether no element has been put into the current object or array */
+    int                       *open_level;  /* the levels of the boxes whose children are not closed yet */
+    int                        open_count;
+    int                        open_alloc;
+} isom_print_stream_t;
+
+#define PRINT_STREAM_BUFFER_SIZE (1 << 20)
+#define PRINT_JSON_BUFFER_SIZE   (1 << 16)
+
+/* Return 1 and print how many entries remain if the rest of a table shall be omitted, otherwise return 0. */
+static int isom_print_omit_entries( FILE *fp, lsmash_file_t *file, int indent, uint32_t index, uint32_t entry_count )
+{
+    isom_print_stream_t *stream = file->print_stream;
+    if( !stream || !stream->max_entries || index < stream->max_entries )
+        return 0;
+    lsmash_ifprintf( fp, indent, "... %"PRIu32" more entries\n", entry_count - index );
+    return 1;
+}
+
 static void isom_ifprintf_duration( FILE *fp, int indent, char *field_name, uint64_t duration, uint32_t timescale )
 {
     if( !timescale )
@@ -51,12 +86,12 @@ static void isom_ifprintf_duration( FILE *fp, int indent, char *field_name, uint
     int min  = (dur /   60) % 60;
     int sec  =  dur         % 60;
     int ms   = ((double)duration / timescale - (hour * 3600 + min * 60 + sec)) * 1e3 + 0.5;
-    static char str[32];
+    char str[32];
     sprintf( str, "%02d:%02d:%02d.%03d", hour, min, sec, ms );
     lsmash_ifprintf( fp, indent, "%s = %"PRIu64" (%s)\n", field_name, duration, str );
 }
 
-static char *isom_mp4time2utc( uint64_t mp4time )
+static char *isom_mp4time2utc( char utc[64], uint64_t mp4time )
 {
     int year_offset = mp4time / 31536000;
     int leap_years = year_offset / 4 + ((mp4time / 86400) > 366);   /* 1904 itself is leap year */
@@ -81,7 +116,6 @@ static char *isom_mp4time2utc( uint64_t mp4time )
     int hour = (mp4time / 3600) % 24;
     int min  = (mp4time /   60) % 60;
     int sec  =  mp4time         % 60;
-    static char utc[64];
     sprintf( utc, "UTC %d/%02d/%02d, %02d:%02d:%02d\n", year, month, day, hour, min, sec );
     return utc;
 }
@@ -109,9 +143,8 @@ static void isom_ifprintf_rgba_color( FILE *fp, int indent, uint8_t *color )
     lsmash_ifprintf( fp, indent, "{ R, G, B, A } = { %"PRIu8", %"PRIu8", %"PRIu8", %"PRIu8" }\n", color[0], color[1], color[2], color[3] );
 }
 
-static char *isom_unpack_iso_language( uint16_t language )
+static char *isom_unpack_iso_language( char unpacked[4], uint16_t language )
 {
-    static char unpacked[4];
     unpacked[0] = ((language >> 10) & 0x1f) + 0x60;
     unpacked[1] = ((language >>  5) & 0x1f) + 0x60;
     unpacked[2] = ( language        & 0x1f) + 0x60;
@@ -385,6 +418,8 @@ static int isom_print_styp( FILE *fp, lsmash_file_t *file, isom_box_t *box, int
      && file->print->head
      && file->print->head->data )
         valid = (box == ((isom_print_entry_t *)file->print->head->data)->box);
+    else if( file->print_stream )
+        valid = (file->print_stream->box_count == 0);
     else
         valid = 0;
     char *name = valid ? "Segment Type Box (valid)" : "Segment Type Box";
@@ -411,6 +446,8 @@ static int isom_print_sidx( FILE *fp, lsmash_file_t *file, isom_box_t *box, int
     uint32_t i = 0;
     for( lsmash_entry_t *entry = sidx->list->head; entry; entry = entry->next )
     {
+        if( isom_print_omit_entries( fp, file, indent, i, sidx->list->entry_count ) )
+            break;
         isom_sidx_referenced_item_t *data = (isom_sidx_referenced_item_t *)entry->data;
         lsmash_ifprintf( fp, indent++, "entry[%"PRIu32"]\n", i++ );
         lsmash_ifprintf( fp, indent, "reference_type = %"PRIu8" (%s)\n", data->reference_type, data->reference_type ? "index" : "media" );
@@ -433,8 +470,8 @@ static int isom_print_mvhd( FILE *fp, lsmash_file_t *file, isom_box_t *box, int
     isom_mvhd_t *mvhd = (isom_mvhd_t *)box;
     int indent = level;
     isom_print_box_common( fp, indent++, box, "Movie Header Box" );
-    lsmash_ifprintf( fp, indent, "creation_time = %s", isom_mp4time2utc( mvhd->creation_time ) );
-    lsmash_ifprintf( fp, indent, "modification_time = %s", isom_mp4time2utc( mvhd->modification_time ) );
+    lsmash_ifprintf( fp, indent, "creation_time = %s", isom_mp4time2utc( (char [64]){ 0 }, mvhd->creation_time ) );
+    lsmash_ifprintf( fp, indent, "modification_time = %s", isom_mp4time2utc( (char [64]){ 0 }, mvhd->modification_time ) );
     lsmash_ifprintf( fp, indent, "timescale = %"PRIu32"\n", mvhd->timescale );
     isom_ifprintf_duration( fp, indent, "duration", mvhd->duration, mvhd->timescale );
     lsmash_ifprintf( fp, indent, "rate = %f\n", lsmash_fixed2double( mvhd->rate, 16 ) );
@@ -525,8 +562,8 @@ static int isom_print_tkhd( FILE *fp, lsmash_file_t *file, isom_box_t *box, int
         lsmash_ifprintf( fp, indent, "Track in preview\n" );
     if( file->qt_compatible && (tkhd->flags & QT_TRACK_IN_POSTER) )
         lsmash_ifprintf( fp, indent, "Track in poster\n" );
-    lsmash_ifprintf( fp, --indent, "creation_time = %s", isom_mp4time2utc( tkhd->creation_time ) );
-    lsmash_ifprintf( fp, indent, "modification_time = %s", isom_mp4time2utc( tkhd->modification_time ) );
+    lsmash_ifprintf( fp, --indent, "creation_time = %s", isom_mp4time2utc( (char [64]){ 0 }, tkhd->creation_time ) );
+    lsmash_ifprintf( fp, indent, "modification_time = %s", isom_mp4time2utc( (char [64]){ 0 }, tkhd->modification_time ) );
     lsmash_ifprintf( fp, indent, "track_ID = %"PRIu32"\n", tkhd->track_ID );
     lsmash_ifprintf( fp, indent, "reserved = 0x%08"PRIx32"\n", tkhd->reserved1 );
     if( file->moov && file->moov->mvhd )
@@ -595,6 +632,8 @@ static int isom_print_elst( FILE *fp, lsmash_file_t *file, isom_box_t *box, int
     lsmash_ifprintf( fp, indent, "entry_count = %"PRIu32"\n", elst->list->entry_count );
     for( lsmash_entry_t *entry = elst->list->head; entry; entry = entry->next )
     {
+        if( isom_print_omit_entries( fp, file, indent, i, elst->list->entry_count ) )
+            break;
         isom_elst_entry_t *data = (isom_elst_entry_t *)entry->data;
         lsmash_ifprintf( fp, indent++, "entry[%"PRIu32"]\n", i++ );
         lsmash_ifprintf( fp, indent, "segment_duration = %"PRIu64"\n", data->segment_duration );
@@ -629,12 +668,12 @@ static int isom_print_mdhd( FILE *fp, lsmash_file_t *file, isom_box_t *box, int
     isom_mdhd_t *mdhd = (isom_mdhd_t *)box;
     int indent = level;
     isom_print_box_common( fp, indent++, box, "Media Header Box" );
-    lsmash_ifprintf( fp, indent, "creation_time = %s", isom_mp4time2utc( mdhd->creation_time ) );
-    lsmash_ifprintf( fp, indent, "modification_time = %s", isom_mp4time2utc( mdhd->modification_time ) );
+    lsmash_ifprintf( fp, indent, "creation_time = %s", isom_mp4time2utc( (char [64]){ 0 }, mdhd->creation_time ) );
+    lsmash_ifprintf( fp, indent, "modification_time = %s", isom_mp4time2utc( (char [64]){ 0 }, mdhd->modification_time ) );
     lsmash_ifprintf( fp, indent, "timescale = %"PRIu32"\n", mdhd->timescale );
     isom_ifprintf_duration( fp, indent, "duration", mdhd->duration, mdhd->timescale );
     if( mdhd->language >= 0x800 )
-        lsmash_ifprintf( fp, indent, "language = %s\n", isom_unpack_iso_language( mdhd->language ) );
+        lsmash_ifprintf( fp, indent, "language = %s\n", isom_unpack_iso_language( (char [4]){ 0 }, mdhd->language ) );
     else
         lsmash_ifprintf( fp, indent, "language = %"PRIu16"\n", mdhd->language );
     if( file->qt_compatible )
@@ -1288,62 +1327,71 @@ static int isom_print_mp4s_description( FILE *fp, lsmash_file_t *file, isom_box_
     return 0;
 }
 
-static int isom_print_sample_description_extesion( FILE *fp, lsmash_file_t *file, isom_box_t *box, int level )
+extern int mp4sys_print_codec_specific( FILE *, lsmash_file_t *, isom_box_t *, int );
+extern int h264_print_codec_specific( FILE *, lsmash_file_t *, isom_box_t *, int );
+extern int hevc_print_codec_specific( FILE *, lsmash_file_t *, isom_box_t *, int );
+extern int h264_print_bitrate( FILE *, lsmash_file_t *, isom_box_t *, int );
+extern int vc1_print_codec_specific( FILE *, lsmash_file_t *, isom_box_t *, int );
+extern int ac3_print_codec_specific( FILE *, lsmash_file_t *, isom_box_t *, int );
+extern int eac3_print_codec_specific( FILE *, lsmash_file_t *, isom_box_t *, int );
+extern int dts_print_codec_specific( FILE *, lsmash_file_t *, isom_box_t *, int );
+extern int alac_print_codec_specific( FILE *, lsmash_file_t *, isom_box_t *, int );
+extern int wma_print_codec_specific( FILE *, lsmash_file_t *, isom_box_t *, int );
+
+static struct print_description_extension_table_tag
+{
+    lsmash_box_type_t type;
+    int (*print_func)( FILE *, lsmash_file_t *, isom_box_t *, int );
+} print_description_extension_table[32] = { { LSMASH_BOX_TYPE_INITIALIZER, NULL } };
+static lsmash_once_t print_description_extension_table_once = LSMASH_ONCE_INIT;
+
+static void isom_init_print_description_extension_table( void )
 {
-    extern int mp4sys_print_codec_specific( FILE *, lsmash_file_t *, isom_box_t *, int );
-    extern int h264_print_codec_specific( FILE *, lsmash_file_t *, isom_box_t *, int );
-    extern int hevc_print_codec_specific( FILE *, lsmash_file_t *, isom_box_t *, int );
-    extern int h264_print_bitrate( FILE *, lsmash_file_t *, isom_box_t *, int );
-    extern int vc1_print_codec_specific( FILE *, lsmash_file_t *, isom_box_t *, int );
-    extern int ac3_print_codec_specific( FILE *, lsmash_file_t *, isom_box_t *, int );
-    extern int eac3_print_codec_specific( FILE *, lsmash_file_t *, isom_box_t *, int );
-    extern int dts_print_codec_specific( FILE *, lsmash_file_t *, isom_box_t *, int );
-    extern int alac_print_codec_specific( FILE *, lsmash_file_t *, isom_box_t *, int );
-    extern int wma_print_codec_specific( FILE *, lsmash_file_t *, isom_box_t *, int );
-    static struct print_description_extension_table_tag
-    {
-        lsmash_box_type_t type;
-        int (*print_func)( FILE *, lsmash_file_t *, isom_box_t *, int );
-    } print_description_extension_table[32] = { { LSMASH_BOX_TYPE_INITIALIZER, NULL } };
-    if( !print_description_extension_table[0].print_func )
-    {
-        /* Initialize the table. */
-        int i = 0;
+    int i = 0;
 #define ADD_PRINT_DESCRIPTION_EXTENSION_TABLE_ELEMENT( type, func ) \
     print_description_extension_table[i++] = (struct print_description_extension_table_tag){ type, func }
-        ADD_PRINT_DESCRIPTION_EXTENSION_TABLE_ELEMENT( ISOM_BOX_TYPE_CLAP, isom_print_clap );
-        ADD_PRINT_DESCRIPTION_EXTENSION_TABLE_ELEMENT( ISOM_BOX_TYPE_PASP, isom_print_pasp );
-        ADD_PRINT_DESCRIPTION_EXTENSION_TABLE_ELEMENT( ISOM_BOX_TYPE_STSL, isom_print_stsl );
-        ADD_PRINT_DESCRIPTION_EXTENSION_TABLE_ELEMENT( ISOM_BOX_TYPE_COLR, isom_print_colr );
-        ADD_PRINT_DESCRIPTION_EXTENSION_TABLE_ELEMENT(   QT_BOX_TYPE_COLR, isom_print_colr );
-        ADD_PRINT_DESCRIPTION_EXTENSION_TABLE_ELEMENT(   QT_BOX_TYPE_GAMA, isom_print_gama );
-        ADD_PRINT_DESCRIPTION_EXTENSION_TABLE_ELEMENT(   QT_BOX_TYPE_FIEL, isom_print_fiel );
-        ADD_PRINT_DESCRIPTION_EXTENSION_TABLE_ELEMENT(   QT_BOX_TYPE_CSPC, isom_print_cspc );
-        ADD_PRINT_DESCRIPTION_EXTENSION_TABLE_ELEMENT(   QT_BOX_TYPE_SGBT, isom_print_sgbt );
-        ADD_PRINT_DESCRIPTION_EXTENSION_TABLE_ELEMENT(   QT_BOX_TYPE_CTAB, isom_print_ctab );
-        ADD_PRINT_DESCRIPTION_EXTENSION_TABLE_ELEMENT(   QT_BOX_TYPE_GLBL, isom_print_glbl );
-        ADD_PRINT_DESCRIPTION_EXTENSION_TABLE_ELEMENT(   QT_BOX_TYPE_WAVE, isom_print_wave );
-        ADD_PRINT_DESCRIPTION_EXTENSION_TABLE_ELEMENT(   QT_BOX_TYPE_CHAN, isom_print_chan );
-        ADD_PRINT_DESCRIPTION_EXTENSION_TABLE_ELEMENT( ISOM_BOX_TYPE_ESDS, mp4sys_print_codec_specific );
-        ADD_PRINT_DESCRIPTION_EXTENSION_TABLE_ELEMENT( ISOM_BOX_TYPE_AVCC, h264_print_codec_specific );
-        ADD_PRINT_DESCRIPTION_EXTENSION_TABLE_ELEMENT( ISOM_BOX_TYPE_BTRT, h264_print_bitrate );
-        ADD_PRINT_DESCRIPTION_EXTENSION_TABLE_ELEMENT( ISOM_BOX_TYPE_HVCC, hevc_print_codec_specific );
-        ADD_PRINT_DESCRIPTION_EXTENSION_TABLE_ELEMENT( ISOM_BOX_TYPE_DVC1, vc1_print_codec_specific );
-        ADD_PRINT_DESCRIPTION_EXTENSION_TABLE_ELEMENT( ISOM_BOX_TYPE_DAC3, ac3_print_codec_specific );
-        ADD_PRINT_DESCRIPTION_EXTENSION_TABLE_ELEMENT( ISOM_BOX_TYPE_DEC3, eac3_print_codec_specific );
-        ADD_PRINT_DESCRIPTION_EXTENSION_TABLE_ELEMENT( ISOM_BOX_TYPE_DDTS, dts_print_codec_specific );
-        ADD_PRINT_DESCRIPTION_EXTENSION_TABLE_ELEMENT( ISOM_BOX_TYPE_ALAC, alac_print_codec_specific );
-        ADD_PRINT_DESCRIPTION_EXTENSION_TABLE_ELEMENT( ISOM_BOX_TYPE_WFEX, wma_print_codec_specific );
-        ADD_PRINT_DESCRIPTION_EXTENSION_TABLE_ELEMENT( ISOM_BOX_TYPE_FTAB, isom_print_ftab );
-        ADD_PRINT_DESCRIPTION_EXTENSION_TABLE_ELEMENT(   QT_BOX_TYPE_ESDS, mp4sys_print_codec_specific );
-        ADD_PRINT_DESCRIPTION_EXTENSION_TABLE_ELEMENT(   QT_BOX_TYPE_ALAC, alac_print_codec_specific );
-        ADD_PRINT_DESCRIPTION_EXTENSION_TABLE_ELEMENT( LSMASH_BOX_TYPE_UNSPECIFIED, NULL );
+    ADD_PRINT_DESCRIPTION_EXTENSION_TABLE_ELEMENT( ISOM_BOX_TYPE_CLAP, isom_print_clap );
+    ADD_PRINT_DESCRIPTION_EXTENSION_TABLE_ELEMENT( ISOM_BOX_TYPE_PASP, isom_print_pasp );
+    ADD_PRINT_DESCRIPTION_EXTENSION_TABLE_ELEMENT( ISOM_BOX_TYPE_STSL, isom_print_stsl );
+    ADD_PRINT_DESCRIPTION_EXTENSION_TABLE_ELEMENT( ISOM_BOX_TYPE_COLR, isom_print_colr );
+    ADD_PRINT_DESCRIPTION_EXTENSION_TABLE_ELEMENT(   QT_BOX_TYPE_COLR, isom_print_colr );
+    ADD_PRINT_DESCRIPTION_EXTENSION_TABLE_ELEMENT(   QT_BOX_TYPE_GAMA, isom_print_gama );
+    ADD_PRINT_DESCRIPTION_EXTENSION_TABLE_ELEMENT(   QT_BOX_TYPE_FIEL, isom_print_fiel );
+    ADD_PRINT_DESCRIPTION_EXTENSION_TABLE_ELEMENT(   QT_BOX_TYPE_CSPC, isom_print_cspc );
+    ADD_PRINT_DESCRIPTION_EXTENSION_TABLE_ELEMENT(   QT_BOX_TYPE_SGBT, isom_print_sgbt );
+    ADD_PRINT_DESCRIPTION_EXTENSION_TABLE_ELEMENT(   QT_BOX_TYPE_CTAB, isom_print_ctab );
+    ADD_PRINT_DESCRIPTION_EXTENSION_TABLE_ELEMENT(   QT_BOX_TYPE_GLBL, isom_print_glbl );
+    ADD_PRINT_DESCRIPTION_EXTENSION_TABLE_ELEMENT(   QT_BOX_TYPE_WAVE, isom_print_wave );
+    ADD_PRINT_DESCRIPTION_EXTENSION_TABLE_ELEMENT(   QT_BOX_TYPE_CHAN, isom_print_chan );
+    ADD_PRINT_DESCRIPTION_EXTENSION_TABLE_ELEMENT( ISOM_BOX_TYPE_ESDS, mp4sys_print_codec_specific );
+    ADD_PRINT_DESCRIPTION_EXTENSION_TABLE_ELEMENT( ISOM_BOX_TYPE_AVCC, h264_print_codec_specific );
+    ADD_PRINT_DESCRIPTION_EXTENSION_TABLE_ELEMENT( ISOM_BOX_TYPE_BTRT, h264_print_bitrate );
+    ADD_PRINT_DESCRIPTION_EXTENSION_TABLE_ELEMENT( ISOM_BOX_TYPE_HVCC, hevc_print_codec_specific );
+    ADD_PRINT_DESCRIPTION_EXTENSION_TABLE_ELEMENT( ISOM_BOX_TYPE_DVC1, vc1_print_codec_specific );
+    ADD_PRINT_DESCRIPTION_EXTENSION_TABLE_ELEMENT( ISOM_BOX_TYPE_DAC3, ac3_print_codec_specific );
+    ADD_PRINT_DESCRIPTION_EXTENSION_TABLE_ELEMENT( ISOM_BOX_TYPE_DEC3, eac3_print_codec_specific );
+    ADD_PRINT_DESCRIPTION_EXTENSION_TABLE_ELEMENT( ISOM_BOX_TYPE_DDTS, dts_print_codec_specific );
+    ADD_PRINT_DESCRIPTION_EXTENSION_TABLE_ELEMENT( ISOM_BOX_TYPE_ALAC, alac_print_codec_specific );
+    ADD_PRINT_DESCRIPTION_EXTENSION_TABLE_ELEMENT( ISOM_BOX_TYPE_WFEX, wma_print_codec_specific );
+    ADD_PRINT_DESCRIPTION_EXTENSION_TABLE_ELEMENT( ISOM_BOX_TYPE_FTAB, isom_print_ftab );
+    ADD_PRINT_DESCRIPTION_EXTENSION_TABLE_ELEMENT(   QT_BOX_TYPE_ESDS, mp4sys_print_codec_specific );
+    ADD_PRINT_DESCRIPTION_EXTENSION_TABLE_ELEMENT(   QT_BOX_TYPE_ALAC, alac_print_codec_specific );
+    ADD_PRINT_DESCRIPTION_EXTENSION_TABLE_ELEMENT( LSMASH_BOX_TYPE_UNSPECIFIED, NULL );
 #undef ADD_PRINT_DESCRIPTION_EXTENSION_TABLE_ELEMENT
-    }
+}
+
+static isom_print_box_t isom_select_description_extension_print_func( isom_box_t *box )
+{
+    lsmash_call_once( &print_description_extension_table_once, isom_init_print_description_extension_table );
     for( int i = 0; print_description_extension_table[i].print_func; i++ )
         if( lsmash_check_box_type_identical( box->type, print_description_extension_table[i].type ) )
-            return print_description_extension_table[i].print_func( fp, file, box, level );
-    return isom_print_unknown( fp, file, box, level );
+            return print_description_extension_table[i].print_func;
+    return isom_print_unknown;
+}
+
+static int isom_print_sample_description_extesion( FILE *fp, lsmash_file_t *file, isom_box_t *box, int level )
+{
+    return isom_select_description_extension_print_func( box )( fp, file, box, level );
 }
 
 static int isom_print_stts( FILE *fp, lsmash_file_t *file, isom_box_t *box, int level )
@@ -1357,6 +1405,8 @@ static int isom_print_stts( FILE *fp, lsmash_file_t *file, isom_box_t *box, int
     lsmash_ifprintf( fp, indent, "entry_count = %"PRIu32"\n", stts->list->entry_count );
     for( lsmash_entry_t *entry = stts->list->head; entry; entry = entry->next )
     {
+        if( isom_print_omit_entries( fp, file, indent, i, stts->list->entry_count ) )
+            break;
         isom_stts_entry_t *data = (isom_stts_entry_t *)entry->data;
         lsmash_ifprintf( fp, indent++, "entry[%"PRIu32"]\n", i++ );
         lsmash_ifprintf( fp, indent, "sample_count = %"PRIu32"\n", data->sample_count );
@@ -1377,6 +1427,8 @@ static int isom_print_ctts( FILE *fp, lsmash_file_t *file, isom_box_t *box, int
     if( file->qt_compatible || ctts->version == 1 )
         for( lsmash_entry_t *entry = ctts->list->head; entry; entry = entry->next )
         {
+            if( isom_print_omit_entries( fp, file, indent, i, ctts->list->entry_count ) )
+                break;
             isom_ctts_entry_t *data = (isom_ctts_entry_t *)entry->data;
             lsmash_ifprintf( fp, indent++, "entry[%"PRIu32"]\n", i++ );
             lsmash_ifprintf( fp, indent, "sample_count = %"PRIu32"\n", data->sample_count );
@@ -1385,6 +1437,8 @@ static int isom_print_ctts( FILE *fp, lsmash_file_t *file, isom_box_t *box, int
     else
         for( lsmash_entry_t *entry = ctts->list->head; entry; entry = entry->next )
         {
+            if( isom_print_omit_entries( fp, file, indent, i, ctts->list->entry_count ) )
+                break;
             isom_ctts_entry_t *data = (isom_ctts_entry_t *)entry->data;
             lsmash_ifprintf( fp, indent++, "entry[%"PRIu32"]\n", i++ );
             lsmash_ifprintf( fp, indent, "sample_count = %"PRIu32"\n", data->sample_count );
@@ -1428,7 +1482,11 @@ static int isom_print_stss( FILE *fp, lsmash_file_t *file, isom_box_t *box, int
     isom_print_box_common( fp, indent++, box, "Sync Sample Box" );
     lsmash_ifprintf( fp, indent, "entry_count = %"PRIu32"\n", stss->list->entry_count );
     for( lsmash_entry_t *entry = stss->list->head; entry; entry = entry->next )
+    {
+        if( isom_print_omit_entries( fp, file, indent, i, stss->list->entry_count ) )
+            break;
         lsmash_ifprintf( fp, indent, "sample_number[%"PRIu32"] = %"PRIu32"\n", i++, ((isom_stss_entry_t *)entry->data)->sample_number );
+    }
     return 0;
 }
 
@@ -1442,7 +1500,11 @@ static int isom_print_stps( FILE *fp, lsmash_file_t *file, isom_box_t *box, int
     isom_print_box_common( fp, indent++, box, "Partial Sync Sample Box" );
     lsmash_ifprintf( fp, indent, "entry_count = %"PRIu32"\n", stps->list->entry_count );
     for( lsmash_entry_t *entry = stps->list->head; entry; entry = entry->next )
+    {
+        if( isom_print_omit_entries( fp, file, indent, i, stps->list->entry_count ) )
+            break;
         lsmash_ifprintf( fp, indent, "sample_number[%"PRIu32"] = %"PRIu32"\n", i++, ((isom_stps_entry_t *)entry->data)->sample_number );
+    }
     return 0;
 }
 
@@ -1456,6 +1518,8 @@ static int isom_print_sdtp( FILE *fp, lsmash_file_t *file, isom_box_t *box, int
     isom_print_box_common( fp, indent++, box, "Independent and Disposable Samples Box" );
     for( lsmash_entry_t *entry = sdtp->list->head; entry; entry = entry->next )
     {
+        if( isom_print_omit_entries( fp, file, indent, i, sdtp->list->entry_count ) )
+            break;
         isom_sdtp_entry_t *data = (isom_sdtp_entry_t *)entry->data;
         lsmash_ifprintf( fp, indent++, "entry[%"PRIu32"]\n", i++ );
         if( data->is_leading || data->sample_depends_on || data->sample_is_depended_on || data->sample_has_redundancy )
@@ -1502,6 +1566,8 @@ static int isom_print_stsc( FILE *fp, lsmash_file_t *file, isom_box_t *box, int
     lsmash_ifprintf( fp, indent, "entry_count = %"PRIu32"\n", stsc->list->entry_count );
     for( lsmash_entry_t *entry = stsc->list->head; entry; entry = entry->next )
     {
+        if( isom_print_omit_entries( fp, file, indent, i, stsc->list->entry_count ) )
+            break;
         isom_stsc_entry_t *data = (isom_stsc_entry_t *)entry->data;
         lsmash_ifprintf( fp, indent++, "entry[%"PRIu32"]\n", i++ );
         lsmash_ifprintf( fp, indent, "first_chunk = %"PRIu32"\n", data->first_chunk );
@@ -1525,6 +1591,8 @@ static int isom_print_stsz( FILE *fp, lsmash_file_t *file, isom_box_t *box, int
     if( !stsz->sample_size && stsz->list )
         for( lsmash_entry_t *entry = stsz->list->head; entry; entry = entry->next )
         {
+            if( isom_print_omit_entries( fp, file, indent, i, stsz->list->entry_count ) )
+                break;
             isom_stsz_entry_t *data = (isom_stsz_entry_t *)entry->data;
             lsmash_ifprintf( fp, indent, "entry_size[%"PRIu32"] = %"PRIu32"\n", i++, data->entry_size );
         }
@@ -1543,12 +1611,20 @@ static int isom_print_stco( FILE *fp, lsmash_file_t *file, isom_box_t *box, int
     if( lsmash_check_box_type_identical( stco->type, ISOM_BOX_TYPE_STCO ) )
     {
         for( lsmash_entry_t *entry = stco->list->head; entry; entry = entry->next )
+        {
+            if( isom_print_omit_entries( fp, file, indent, i, stco->list->entry_count ) )
+                break;
             lsmash_ifprintf( fp, indent, "chunk_offset[%"PRIu32"] = %"PRIu32"\n", i++, ((isom_stco_entry_t *)entry->data)->chunk_offset );
+        }
     }
     else
     {
         for( lsmash_entry_t *entry = stco->list->head; entry; entry = entry->next )
+        {
+            if( isom_print_omit_entries( fp, file, indent, i, stco->list->entry_count ) )
+                break;
             lsmash_ifprintf( fp, indent, "chunk_offset[%"PRIu32"] = %"PRIu64"\n", i++, ((isom_co64_entry_t *)entry->data)->chunk_offset );
+        }
     }
     return 0;
 }
@@ -1615,6 +1691,8 @@ static int isom_print_sbgp( FILE *fp, lsmash_file_t *file, isom_box_t *box, int
     lsmash_ifprintf( fp, indent, "entry_count = %"PRIu32"\n", sbgp->list->entry_count );
     for( lsmash_entry_t *entry = sbgp->list->head; entry; entry = entry->next )
     {
+        if( isom_print_omit_entries( fp, file, indent, i, sbgp->list->entry_count ) )
+            break;
         isom_group_assignment_entry_t *data = (isom_group_assignment_entry_t *)entry->data;
         lsmash_ifprintf( fp, indent++, "entry[%"PRIu32"]\n", i++ );
         lsmash_ifprintf( fp, indent, "sample_count = %"PRIu32"\n", data->sample_count );
@@ -2009,7 +2087,7 @@ static int isom_print_data( FILE *fp, lsmash_file_t *file, isom_box_t *box, int
             uint64_t mp4time = data->value_length == 8
                              ? LSMASH_GET_BE64( data->value )
                              : LSMASH_GET_BE32( data->value );
-            isom_mp4time2utc( mp4time );
+            isom_mp4time2utc( (char [64]){ 0 }, mp4time );
         }
         else if( data->type_code == 21 && data->value_length <= 8 )
             /* a big-endian signed integer in 1,2,3,4 or 8 bytes */
@@ -2127,7 +2205,7 @@ static int isom_print_cprt( FILE *fp, lsmash_file_t *file, isom_box_t *box, int
     memcpy( str, cprt->notice, cprt->notice_length );
     str[cprt->notice_length] = 0;
     isom_print_box_common( fp, indent++, box, "Copyright Box" );
-    lsmash_ifprintf( fp, indent, "language = %s\n", isom_unpack_iso_language( cprt->language ) );
+    lsmash_ifprintf( fp, indent, "language = %s\n", isom_unpack_iso_language( (char [4]){ 0 }, cprt->language ) );
     lsmash_ifprintf( fp, indent, "notice = %s\n", str );
     lsmash_free( str );
     return 0;
@@ -2239,6 +2317,8 @@ static int isom_print_trun( FILE *fp, lsmash_file_t *file, isom_box_t *box, int
         uint32_t i = 0;
         for( lsmash_entry_t *entry = trun->optional->head; entry; entry = entry->next )
         {
+            if( isom_print_omit_entries( fp, file, indent, i, trun->optional->entry_count ) )
+                break;
             isom_trun_optional_row_t *row = (isom_trun_optional_row_t *)entry->data;
             lsmash_ifprintf( fp, indent++, "sample[%"PRIu32"]\n", i++ );
             if( trun->flags & ISOM_TR_FLAGS_SAMPLE_DURATION_PRESENT )
@@ -2293,6 +2373,8 @@ static int isom_print_tfra( FILE *fp, lsmash_file_t *file, isom_box_t *box, int
         uint32_t i = 0;
         for( lsmash_entry_t *entry = tfra->list->head; entry; entry = entry->next )
         {
+            if( isom_print_omit_entries( fp, file, indent, i, tfra->list->entry_count ) )
+                break;
             isom_tfra_location_time_entry_t *data = (isom_tfra_location_time_entry_t *)entry->data;
             lsmash_ifprintf( fp, indent++, "entry[%"PRIu32"]\n", i++ );
             lsmash_ifprintf( fp, indent, "time = %"PRIu64"\n", data->time );
@@ -2315,356 +2397,1992 @@ static int isom_print_mfro( FILE *fp, lsmash_file_t *file, isom_box_t *box, int
     return 0;
 }
 
-int lsmash_print_movie( lsmash_root_t *root, const char *filename )
+/* JSON emitter
+ * Numbers and strings are formatted by hand and written into a large block buffer
+ * so that dumping does not pay for format parsing of stdio per field. */
+static void isom_json_flush( isom_print_stream_t *stream )
 {
-    if( !root )
-        return LSMASH_ERR_FUNCTION_PARAM;
-    lsmash_file_t *file = root->file;
-    if( !file
-     || !file->print
-     || !(file->flags & LSMASH_FILE_MODE_DUMP) )
-        return LSMASH_ERR_FUNCTION_PARAM;
-    FILE *destination;
-    if( !strcmp( filename, "-" ) )
-        destination = stdout;
-    else
-    {
-        destination = lsmash_fopen( filename, "wb" );
-        if( !destination )
-            return LSMASH_ERR_NAMELESS;
-    }
-    fprintf( destination, "[File]\n" );
-    fprintf( destination, "    size = %"PRIu64"\n", file->size );
-    for( lsmash_entry_t *entry = file->print->head; entry; entry = entry->next )
+    if( stream->json_pos )
+        fwrite( stream->json, 1, stream->json_pos, stream->fp );
+    stream->json_pos = 0;
+}
+
+static void isom_json_write( isom_print_stream_t *stream, const char *str, size_t length )
+{
+    if( stream->json_pos + length > PRINT_JSON_BUFFER_SIZE )
     {
-        isom_print_entry_t *data = (isom_print_entry_t *)entry->data;
-        if( !data || !data->box )
-        {
-            fclose( destination );
-            return LSMASH_ERR_NAMELESS;
-        }
-        int ret = data->func( destination, file, data->box, data->level );
-        if( ret < 0 )
+        isom_json_flush( stream );
+        if( length > PRINT_JSON_BUFFER_SIZE )
         {
-            fclose( destination );
-            return ret;
+            fwrite( str, 1, length, stream->fp );
+            return;
         }
     }
-    fclose( destination );
-    return 0;
+    memcpy( stream->json + stream->json_pos, str, length );
+    stream->json_pos += length;
 }
 
-static isom_print_box_t isom_select_print_func( isom_box_t *box )
+static inline void isom_json_putc( isom_print_stream_t *stream, char c )
 {
-    if( box->manager & LSMASH_UNKNOWN_BOX )
-        return isom_print_unknown;
-    if( box->parent )
+    if( stream->json_pos == PRINT_JSON_BUFFER_SIZE )
+        isom_json_flush( stream );
+    stream->json[ stream->json_pos++ ] = c;
+}
+
+static void isom_json_put_uint( isom_print_stream_t *stream, uint64_t value )
+{
+    char digits[20];
+    int  n = 20;
+    do
     {
-        isom_box_t *parent = box->parent;
-        if( lsmash_check_box_type_identical( parent->type, ISOM_BOX_TYPE_STSD ) )
-        {
-            lsmash_codec_type_t sample_type = box->type;
-            if( lsmash_check_codec_type_identical( sample_type, LSMASH_CODEC_TYPE_RAW ) )
-            {
-                if( box->manager & LSMASH_VIDEO_DESCRIPTION )
-                    return isom_print_visual_description;
-                else if( box->manager & LSMASH_AUDIO_DESCRIPTION )
-                    return isom_print_audio_description;
-            }
-            static struct print_description_table_tag
-            {
-                lsmash_codec_type_t type;
-                isom_print_box_t    func;
-            } print_description_table[160] = { { LSMASH_CODEC_TYPE_INITIALIZER, NULL } };
-            if( !print_description_table[0].func )
-            {
-                /* Initialize the table. */
-                int i = 0;
-#define ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( type, func ) print_description_table[i++] = (struct print_description_table_tag){ type, func }
-                ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( ISOM_CODEC_TYPE_AVC1_VIDEO, isom_print_visual_description );
-                ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( ISOM_CODEC_TYPE_AVC2_VIDEO, isom_print_visual_description );
-                ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( ISOM_CODEC_TYPE_AVC3_VIDEO, isom_print_visual_description );
-                ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( ISOM_CODEC_TYPE_AVC4_VIDEO, isom_print_visual_description );
-                ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( ISOM_CODEC_TYPE_AVCP_VIDEO, isom_print_visual_description );
-                ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( ISOM_CODEC_TYPE_DRAC_VIDEO, isom_print_visual_description );
-                ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( ISOM_CODEC_TYPE_ENCV_VIDEO, isom_print_visual_description );
-                ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( ISOM_CODEC_TYPE_HVC1_VIDEO, isom_print_visual_description );
-                ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( ISOM_CODEC_TYPE_HEV1_VIDEO, isom_print_visual_description );
-                ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( ISOM_CODEC_TYPE_MJP2_VIDEO, isom_print_visual_description );
-                ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( ISOM_CODEC_TYPE_MP4V_VIDEO, isom_print_visual_description );
-                ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( ISOM_CODEC_TYPE_MVC1_VIDEO, isom_print_visual_description );
-                ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( ISOM_CODEC_TYPE_MVC2_VIDEO, isom_print_visual_description );
-                ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( ISOM_CODEC_TYPE_S263_VIDEO, isom_print_visual_description );
-                ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( ISOM_CODEC_TYPE_SVC1_VIDEO, isom_print_visual_description );
-                ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( ISOM_CODEC_TYPE_VC_1_VIDEO, isom_print_visual_description );
-                ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( QT_CODEC_TYPE_2VUY_VIDEO,   isom_print_visual_description );
-                ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( QT_CODEC_TYPE_CFHD_VIDEO,   isom_print_visual_description );
-                ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( QT_CODEC_TYPE_DV10_VIDEO,   isom_print_visual_description );
-                ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( QT_CODEC_TYPE_DVOO_VIDEO,   isom_print_visual_description );
-                ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( QT_CODEC_TYPE_DVOR_VIDEO,   isom_print_visual_description );
-                ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( QT_CODEC_TYPE_DVTV_VIDEO,   isom_print_visual_description );
-                ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( QT_CODEC_TYPE_DVVT_VIDEO,   isom_print_visual_description );
-                ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( QT_CODEC_TYPE_HD10_VIDEO,   isom_print_visual_description );
-                ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( QT_CODEC_TYPE_M105_VIDEO,   isom_print_visual_description );
-                ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( QT_CODEC_TYPE_PNTG_VIDEO,   isom_print_visual_description );
-                ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( QT_CODEC_TYPE_SVQ1_VIDEO,   isom_print_visual_description );
-                ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( QT_CODEC_TYPE_SVQ3_VIDEO,   isom_print_visual_description );
-                ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( QT_CODEC_TYPE_SHR0_VIDEO,   isom_print_visual_description );
-                ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( QT_CODEC_TYPE_SHR1_VIDEO,   isom_print_visual_description );
-                ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( QT_CODEC_TYPE_SHR2_VIDEO,   isom_print_visual_description );
-                ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( QT_CODEC_TYPE_SHR3_VIDEO,   isom_print_visual_description );
-                ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( QT_CODEC_TYPE_SHR4_VIDEO,   isom_print_visual_description );
-                ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( QT_CODEC_TYPE_WRLE_VIDEO,   isom_print_visual_description );
-                ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( QT_CODEC_TYPE_APCH_VIDEO,   isom_print_visual_description );
-                ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( QT_CODEC_TYPE_APCN_VIDEO,   isom_print_visual_description );
-                ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( QT_CODEC_TYPE_APCS_VIDEO,   isom_print_visual_description );
-                ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( QT_CODEC_TYPE_APCO_VIDEO,   isom_print_visual_description );
-                ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( QT_CODEC_TYPE_AP4H_VIDEO,   isom_print_visual_description );
-                ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( QT_CODEC_TYPE_AP4X_VIDEO,   isom_print_visual_description );
-                ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( QT_CODEC_TYPE_CIVD_VIDEO,   isom_print_visual_description );
-                ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( QT_CODEC_TYPE_DRAC_VIDEO,   isom_print_visual_description );
-                ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( QT_CODEC_TYPE_DVC_VIDEO,    isom_print_visual_description );
-                ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( QT_CODEC_TYPE_DVCP_VIDEO,   isom_print_visual_description );
-                ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( QT_CODEC_TYPE_DVPP_VIDEO,   isom_print_visual_description );
-                ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( QT_CODEC_TYPE_DV5N_VIDEO,   isom_print_visual_description );
-                ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( QT_CODEC_TYPE_DV5P_VIDEO,   isom_print_visual_description );
-                ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( QT_CODEC_TYPE_DVH2_VIDEO,   isom_print_visual_description );
-                ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( QT_CODEC_TYPE_DVH3_VIDEO,   isom_print_visual_description );
-                ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( QT_CODEC_TYPE_DVH5_VIDEO,   isom_print_visual_description );
-                ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( QT_CODEC_TYPE_DVH6_VIDEO,   isom_print_visual_description );
-                ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( QT_CODEC_TYPE_DVHP_VIDEO,   isom_print_visual_description );
-                ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( QT_CODEC_TYPE_DVHQ_VIDEO,   isom_print_visual_description );
-                ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( QT_CODEC_TYPE_FLIC_VIDEO,   isom_print_visual_description );
-                ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( QT_CODEC_TYPE_GIF_VIDEO,    isom_print_visual_description );
-                ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( QT_CODEC_TYPE_H261_VIDEO,   isom_print_visual_description );
-                ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( QT_CODEC_TYPE_H263_VIDEO,   isom_print_visual_description );
-                ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( QT_CODEC_TYPE_JPEG_VIDEO,   isom_print_visual_description );
-                ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( QT_CODEC_TYPE_MJPA_VIDEO,   isom_print_visual_description );
-                ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( QT_CODEC_TYPE_MJPB_VIDEO,   isom_print_visual_description );
-                ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( QT_CODEC_TYPE_PNG_VIDEO,    isom_print_visual_description );
-                ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( QT_CODEC_TYPE_RLE_VIDEO,    isom_print_visual_description );
-                ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( QT_CODEC_TYPE_RPZA_VIDEO,   isom_print_visual_description );
-                ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( QT_CODEC_TYPE_TGA_VIDEO,    isom_print_visual_description );
-                ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( QT_CODEC_TYPE_TIFF_VIDEO,   isom_print_visual_description );
-                ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( QT_CODEC_TYPE_ULRA_VIDEO,   isom_print_visual_description );
-                ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( QT_CODEC_TYPE_ULRG_VIDEO,   isom_print_visual_description );
-                ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( QT_CODEC_TYPE_ULY2_VIDEO,   isom_print_visual_description );
-                ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( QT_CODEC_TYPE_ULY0_VIDEO,   isom_print_visual_description );
-                ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( QT_CODEC_TYPE_ULH2_VIDEO,   isom_print_visual_description );
-                ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( QT_CODEC_TYPE_ULH0_VIDEO,   isom_print_visual_description );
-                ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( QT_CODEC_TYPE_UQY2_VIDEO,   isom_print_visual_description );
-                ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( QT_CODEC_TYPE_V210_VIDEO,   isom_print_visual_description );
-                ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( QT_CODEC_TYPE_V216_VIDEO,   isom_print_visual_description );
-                ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( QT_CODEC_TYPE_V308_VIDEO,   isom_print_visual_description );
-                ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( QT_CODEC_TYPE_V408_VIDEO,   isom_print_visual_description );
-                ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( QT_CODEC_TYPE_V410_VIDEO,   isom_print_visual_description );
-                ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( QT_CODEC_TYPE_YUV2_VIDEO,   isom_print_visual_description );
-                ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( ISOM_CODEC_TYPE_AC_3_AUDIO,  isom_print_audio_description );
-                ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( ISOM_CODEC_TYPE_ALAC_AUDIO,  isom_print_audio_description );
-                ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( ISOM_CODEC_TYPE_DRA1_AUDIO,  isom_print_audio_description );
-                ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( ISOM_CODEC_TYPE_DTSC_AUDIO,  isom_print_audio_description );
-                ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( ISOM_CODEC_TYPE_DTSE_AUDIO,  isom_print_audio_description );
-                ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( ISOM_CODEC_TYPE_DTSH_AUDIO,  isom_print_audio_description );
-                ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( ISOM_CODEC_TYPE_DTSL_AUDIO,  isom_print_audio_description );
-                ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( ISOM_CODEC_TYPE_EC_3_AUDIO,  isom_print_audio_description );
-                ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( ISOM_CODEC_TYPE_ENCA_AUDIO,  isom_print_audio_description );
-                ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( ISOM_CODEC_TYPE_G719_AUDIO,  isom_print_audio_description );
-                ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( ISOM_CODEC_TYPE_G726_AUDIO,  isom_print_audio_description );
-                ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( ISOM_CODEC_TYPE_M4AE_AUDIO,  isom_print_audio_description );
-                ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( ISOM_CODEC_TYPE_MLPA_AUDIO,  isom_print_audio_description );
-                ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( ISOM_CODEC_TYPE_MP4A_AUDIO,  isom_print_audio_description );
-                ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( ISOM_CODEC_TYPE_SAMR_AUDIO,  isom_print_audio_description );
-                ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( ISOM_CODEC_TYPE_SAWB_AUDIO,  isom_print_audio_description );
-                ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( ISOM_CODEC_TYPE_SAWP_AUDIO,  isom_print_audio_description );
-                ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( ISOM_CODEC_TYPE_SEVC_AUDIO,  isom_print_audio_description );
-                ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( ISOM_CODEC_TYPE_SQCP_AUDIO,  isom_print_audio_description );
-                ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( ISOM_CODEC_TYPE_SSMV_AUDIO,  isom_print_audio_description );
-                ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( ISOM_CODEC_TYPE_TWOS_AUDIO,  isom_print_audio_description );
-                ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( ISOM_CODEC_TYPE_WMA_AUDIO,   isom_print_audio_description );
-                ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( QT_CODEC_TYPE_MP4A_AUDIO,    isom_print_audio_description );
-                ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( QT_CODEC_TYPE_23NI_AUDIO,    isom_print_audio_description );
-                ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( QT_CODEC_TYPE_MAC3_AUDIO,    isom_print_audio_description );
-                ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( QT_CODEC_TYPE_MAC6_AUDIO,    isom_print_audio_description );
-                ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( QT_CODEC_TYPE_NONE_AUDIO,    isom_print_audio_description );
-                ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( QT_CODEC_TYPE_QDM2_AUDIO,    isom_print_audio_description );
-                ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( QT_CODEC_TYPE_QDMC_AUDIO,    isom_print_audio_description );
-                ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( QT_CODEC_TYPE_QCLP_AUDIO,    isom_print_audio_description );
-                ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( QT_CODEC_TYPE_AGSM_AUDIO,    isom_print_audio_description );
-                ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( QT_CODEC_TYPE_ALAW_AUDIO,    isom_print_audio_description );
-                ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( QT_CODEC_TYPE_CDX2_AUDIO,    isom_print_audio_description );
-                ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( QT_CODEC_TYPE_CDX4_AUDIO,    isom_print_audio_description );
-                ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( QT_CODEC_TYPE_DVCA_AUDIO,    isom_print_audio_description );
-                ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( QT_CODEC_TYPE_DVI_AUDIO,     isom_print_audio_description );
-                ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( QT_CODEC_TYPE_FL32_AUDIO,    isom_print_audio_description );
-                ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( QT_CODEC_TYPE_FL64_AUDIO,    isom_print_audio_description );
-                ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( QT_CODEC_TYPE_IMA4_AUDIO,    isom_print_audio_description );
-                ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( QT_CODEC_TYPE_IN24_AUDIO,    isom_print_audio_description );
-                ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( QT_CODEC_TYPE_IN32_AUDIO,    isom_print_audio_description );
-                ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( QT_CODEC_TYPE_LPCM_AUDIO,    isom_print_audio_description );
-                ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( QT_CODEC_TYPE_SOWT_AUDIO,    isom_print_audio_description );
-                ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( QT_CODEC_TYPE_TWOS_AUDIO,    isom_print_audio_description );
-                ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( QT_CODEC_TYPE_ULAW_AUDIO,    isom_print_audio_description );
-                ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( QT_CODEC_TYPE_VDVA_AUDIO,    isom_print_audio_description );
-                ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( QT_CODEC_TYPE_FULLMP3_AUDIO, isom_print_audio_description );
-                ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( QT_CODEC_TYPE_MP3_AUDIO,     isom_print_audio_description );
-                ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( QT_CODEC_TYPE_ADPCM2_AUDIO,  isom_print_audio_description );
-                ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( QT_CODEC_TYPE_ADPCM17_AUDIO, isom_print_audio_description );
-                ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( QT_CODEC_TYPE_GSM49_AUDIO,   isom_print_audio_description );
-                ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( QT_CODEC_TYPE_NOT_SPECIFIED, isom_print_audio_description );
-                ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( QT_CODEC_TYPE_TEXT_TEXT,     isom_print_text_description );
-                ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( ISOM_CODEC_TYPE_TX3G_TEXT,   isom_print_tx3g_description );
-                ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( ISOM_CODEC_TYPE_MP4S_SYSTEM, isom_print_mp4s_description );
-                ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( LSMASH_CODEC_TYPE_UNSPECIFIED, NULL );
-#undef ADD_PRINT_DESCRIPTION_TABLE_ELEMENT
-            }
-            for( int i = 0; print_description_table[i].func; i++ )
-                if( lsmash_check_codec_type_identical( sample_type, print_description_table[i].type ) )
-                    return print_description_table[i].func;
-            return isom_print_unknown;
-        }
-        if( lsmash_check_box_type_identical( parent->type, QT_BOX_TYPE_WAVE ) )
+        digits[--n] = '0' + value % 10;
+        value /= 10;
+    } while( value );
+    isom_json_write( stream, &digits[n], 20 - n );
+}
+
+static void isom_json_put_int( isom_print_stream_t *stream, int64_t value )
+{
+    if( value < 0 )
+    {
+        isom_json_putc( stream, '-' );
+        isom_json_put_uint( stream, -(uint64_t)value );
+    }
+    else
+        isom_json_put_uint( stream, value );
+}
+
+static void isom_json_put_string( isom_print_stream_t *stream, const char *str, size_t length )
+{
+    static const char hex[16] = "0123456789abcdef";
+    isom_json_putc( stream, '"' );
+    size_t start = 0;
+    for( size_t i = 0; i < length; i++ )
+    {
+        uint8_t c = str[i];
+        /* Any byte out of ASCII is put as the code point of the same value since
+         * strings in boxes are not guaranteed to be valid UTF-8. */
+        if( c >= 0x20 && c < 0x80 && c != '"' && c != '\\' )
+            continue;
+        isom_json_write( stream, &str[start], i - start );
+        start = i + 1;
+        if( c == '"' || c == '\\' )
         {
-            if( lsmash_check_box_type_identical( box->type, QT_BOX_TYPE_FRMA ) )
-                return isom_print_frma;
-            else if( lsmash_check_box_type_identical( box->type, QT_BOX_TYPE_ENDA ) )
-                return isom_print_enda;
-            else if( lsmash_check_box_type_identical( box->type, QT_BOX_TYPE_TERMINATOR ) )
-                return isom_print_terminator;
-            else
-                return isom_print_sample_description_extesion;
+            char escaped[2] = { '\\', c };
+            isom_json_write( stream, escaped, 2 );
         }
-        if( lsmash_check_box_type_identical( parent->type, ISOM_BOX_TYPE_TREF ) )
-            return isom_print_track_reference_type;
-        if( parent->parent )
+        else
         {
-            if( lsmash_check_box_type_identical( parent->parent->type, ISOM_BOX_TYPE_STSD ) )
-                return isom_print_sample_description_extesion;
-            else if( lsmash_check_box_type_identical( parent->parent->type, ISOM_BOX_TYPE_ILST )
-                  || lsmash_check_box_type_identical( parent->parent->type,   QT_BOX_TYPE_ILST ) )
-            {
-                if( parent->type.fourcc == LSMASH_4CC( '-', '-', '-', '-' ) )
-                {
-                    if( lsmash_check_box_type_identical( box->type, ISOM_BOX_TYPE_MEAN ) )
-                        return isom_print_mean;
-                    if( lsmash_check_box_type_identical( box->type, ISOM_BOX_TYPE_NAME ) )
-                        return isom_print_name;
-                }
-                if( lsmash_check_box_type_identical( box->type, ISOM_BOX_TYPE_DATA ) )
-                    return isom_print_data;
-            }
+            char escaped[6] = { '\\', 'u', '0', '0', hex[c >> 4], hex[c & 0xf] };
+            isom_json_write( stream, escaped, 6 );
         }
-        if( lsmash_check_box_type_identical( parent->type, ISOM_BOX_TYPE_ILST )
-         || lsmash_check_box_type_identical( parent->type,   QT_BOX_TYPE_ILST ) )
-            return isom_print_metaitem;
     }
-    static struct print_box_table_tag
+    isom_json_write( stream, &str[start], length - start );
+    isom_json_putc( stream, '"' );
+}
+
+/* A four-character code is a sequence of bytes, e.g. 0xA9 of '\251nam' in iTunes metadata, not text. */
+static void isom_json_put_fourcc( isom_print_stream_t *stream, uint32_t fourcc )
+{
+    char str[4] = { fourcc >> 24, fourcc >> 16, fourcc >> 8, fourcc };
+    isom_json_put_string( stream, str, 4 );
+}
+
+/* Put a comma unless this is the first element in the current object or array. */
+void isom_json_separate( isom_print_stream_t *stream )
+{
+    if( !stream->json_first )
+        isom_json_putc( stream, ',' );
+    stream->json_first = 0;
+}
+
+void isom_json_begin( isom_print_stream_t *stream, char bracket )
+{
+    isom_json_putc( stream, bracket );
+    stream->json_first = 1;
+}
+
+void isom_json_end( isom_print_stream_t *stream, char bracket )
+{
+    isom_json_putc( stream, bracket );
+    stream->json_first = 0;
+}
+
+void isom_json_key( isom_print_stream_t *stream, const char *key )
+{
+    isom_json_separate( stream );
+    isom_json_putc( stream, '"' );
+    isom_json_write( stream, key, strlen( key ) );
+    isom_json_write( stream, "\":", 2 );
+}
+
+void isom_json_field_uint( isom_print_stream_t *stream, const char *key, uint64_t value )
+{
+    isom_json_key( stream, key );
+    isom_json_put_uint( stream, value );
+}
+
+void isom_json_field_int( isom_print_stream_t *stream, const char *key, int64_t value )
+{
+    isom_json_key( stream, key );
+    isom_json_put_int( stream, value );
+}
+
+void isom_json_field_fourcc( isom_print_stream_t *stream, const char *key, uint32_t fourcc )
+{
+    isom_json_key( stream, key );
+    isom_json_put_fourcc( stream, fourcc );
+}
+
+void isom_json_field_string( isom_print_stream_t *stream, const char *key, const char *str, size_t length )
+{
+    isom_json_key( stream, key );
+    isom_json_put_string( stream, str, length );
+}
+
+/* Binary data is put as a string of hexadecimal digits. */
+void isom_json_field_bytes( isom_print_stream_t *stream, const char *key, const uint8_t *data, uint32_t size )
+{
+    static const char hex[16] = "0123456789abcdef";
+    isom_json_key( stream, key );
+    isom_json_putc( stream, '"' );
+    for( uint32_t i = 0; i < size; i++ )
+    {
+        isom_json_putc( stream, hex[data[i] >> 4] );
+        isom_json_putc( stream, hex[data[i] & 0xf] );
+    }
+    isom_json_putc( stream, '"' );
+}
+
+void isom_json_element_uint( isom_print_stream_t *stream, uint64_t value )
+{
+    isom_json_separate( stream );
+    isom_json_put_uint( stream, value );
+}
+
+void isom_json_element_int( isom_print_stream_t *stream, int64_t value )
+{
+    isom_json_separate( stream );
+    isom_json_put_int( stream, value );
+}
+
+static inline void isom_json_element_string( isom_print_stream_t *stream, const char *str, size_t length )
+{
+    isom_json_separate( stream );
+    isom_json_put_string( stream, str, length );
+}
+
+/* Return the length of a string in a box up to the null terminator if any. */
+static size_t isom_json_strnlen( const char *str, size_t length )
+{
+    for( size_t i = 0; i < length; i++ )
+        if( !str[i] )
+            return i;
+    return length;
+}
+
+static void isom_json_matrix( isom_print_stream_t *stream, int32_t *matrix )
+{
+    isom_json_key( stream, "matrix" );
+    isom_json_begin( stream, '[' );
+    for( int i = 0; i < 9; i++ )
+        isom_json_element_int( stream, matrix[i] );
+    isom_json_end( stream, ']' );
+}
+
+static void isom_json_rgb_color( isom_print_stream_t *stream, const char *key, uint16_t *color )
+{
+    isom_json_key( stream, key );
+    isom_json_begin( stream, '[' );
+    for( int i = 0; i < 3; i++ )
+        isom_json_element_uint( stream, color[i] );
+    isom_json_end( stream, ']' );
+}
+
+static void isom_json_rgba_color( isom_print_stream_t *stream, const char *key, uint8_t *color )
+{
+    isom_json_key( stream, key );
+    isom_json_begin( stream, '[' );
+    for( int i = 0; i < 4; i++ )
+        isom_json_element_uint( stream, color[i] );
+    isom_json_end( stream, ']' );
+}
+
+/* Return 1 if the rest of entries in a table shall be omitted. */
+static inline int isom_json_omit_entries( isom_print_stream_t *stream, uint32_t index )
+{
+    return stream->max_entries && index >= stream->max_entries;
+}
+
+static uint32_t isom_json_sample_flags( isom_sample_flags_t *flags )
+{
+    return (flags->reserved                  << 28)
+         | (flags->is_leading                << 26)
+         | (flags->sample_depends_on         << 24)
+         | (flags->sample_is_depended_on     << 22)
+         | (flags->sample_has_redundancy     << 20)
+         | (flags->sample_padding_value      << 17)
+         | (flags->sample_is_non_sync_sample << 16)
+         |  flags->sample_degradation_priority;
+}
+
+typedef void (*isom_print_json_t)( isom_print_stream_t *, lsmash_file_t *, isom_box_t * );
+
+static void isom_json_brands( isom_print_stream_t *stream, uint32_t major_brand, uint32_t minor_version, uint32_t brand_count, uint32_t *brands )
+{
+    isom_json_field_fourcc( stream, "major_brand", major_brand );
+    isom_json_field_uint( stream, "minor_version", minor_version );
+    isom_json_key( stream, "compatible_brands" );
+    isom_json_begin( stream, '[' );
+    for( uint32_t i = 0; i < brand_count; i++ )
+    {
+        isom_json_separate( stream );
+        isom_json_put_fourcc( stream, brands[i] );
+    }
+    isom_json_end( stream, ']' );
+}
+
+static void isom_json_ftyp( isom_print_stream_t *stream, lsmash_file_t *file, isom_box_t *box )
+{
+    isom_ftyp_t *ftyp = (isom_ftyp_t *)box;
+    isom_json_brands( stream, ftyp->major_brand, ftyp->minor_version, ftyp->brand_count, ftyp->compatible_brands );
+}
+
+static void isom_json_styp( isom_print_stream_t *stream, lsmash_file_t *file, isom_box_t *box )
+{
+    isom_styp_t *styp = (isom_styp_t *)box;
+    isom_json_brands( stream, styp->major_brand, styp->minor_version, styp->brand_count, styp->compatible_brands );
+}
+
+static void isom_json_sidx( isom_print_stream_t *stream, lsmash_file_t *file, isom_box_t *box )
+{
+    isom_sidx_t *sidx = (isom_sidx_t *)box;
+    isom_json_field_uint( stream, "reference_ID", sidx->reference_ID );
+    isom_json_field_uint( stream, "timescale", sidx->timescale );
+    isom_json_field_uint( stream, "earliest_presentation_time", sidx->earliest_presentation_time );
+    isom_json_field_uint( stream, "first_offset", sidx->first_offset );
+    isom_json_field_uint( stream, "reference_count", sidx->reference_count );
+    if( !sidx->list )
+        return;
+    /* [ reference_type, reference_size, subsegment_duration, starts_with_SAP, SAP_type, SAP_delta_time ] */
+    isom_json_key( stream, "references" );
+    isom_json_begin( stream, '[' );
+    uint32_t i = 0;
+    for( lsmash_entry_t *entry = sidx->list->head; entry && !isom_json_omit_entries( stream, i ); entry = entry->next, i++ )
     {
-        lsmash_box_type_t type;
-        isom_print_box_t  func;
-    } print_box_table[128] = { { LSMASH_BOX_TYPE_INITIALIZER, NULL } };
-    if( !print_box_table[0].func )
+        isom_sidx_referenced_item_t *data = (isom_sidx_referenced_item_t *)entry->data;
+        isom_json_separate( stream );
+        isom_json_begin( stream, '[' );
+        isom_json_element_uint( stream, data->reference_type );
+        isom_json_element_uint( stream, data->reference_size );
+        isom_json_element_uint( stream, data->subsegment_duration );
+        isom_json_element_uint( stream, data->starts_with_SAP );
+        isom_json_element_uint( stream, data->SAP_type );
+        isom_json_element_uint( stream, data->SAP_delta_time );
+        isom_json_end( stream, ']' );
+    }
+    isom_json_end( stream, ']' );
+}
+
+static void isom_json_mvhd( isom_print_stream_t *stream, lsmash_file_t *file, isom_box_t *box )
+{
+    isom_mvhd_t *mvhd = (isom_mvhd_t *)box;
+    isom_json_field_uint( stream, "creation_time", mvhd->creation_time );
+    isom_json_field_uint( stream, "modification_time", mvhd->modification_time );
+    isom_json_field_uint( stream, "timescale", mvhd->timescale );
+    isom_json_field_uint( stream, "duration", mvhd->duration );
+    isom_json_field_int( stream, "rate", mvhd->rate );
+    isom_json_field_int( stream, "volume", mvhd->volume );
+    isom_json_matrix( stream, mvhd->matrix );
+    if( file->qt_compatible )
     {
-        /* Initialize the table. */
-        int i = 0;
-#define ADD_PRINT_BOX_TABLE_ELEMENT( type, func ) print_box_table[i++] = (struct print_box_table_tag){ type, func }
-        ADD_PRINT_BOX_TABLE_ELEMENT( ISOM_BOX_TYPE_FTYP, isom_print_ftyp );
-        ADD_PRINT_BOX_TABLE_ELEMENT( ISOM_BOX_TYPE_STYP, isom_print_styp );
-        ADD_PRINT_BOX_TABLE_ELEMENT( ISOM_BOX_TYPE_SIDX, isom_print_sidx );
-        ADD_PRINT_BOX_TABLE_ELEMENT( ISOM_BOX_TYPE_MOOV, isom_print_moov );
-        ADD_PRINT_BOX_TABLE_ELEMENT( ISOM_BOX_TYPE_MVHD, isom_print_mvhd );
-        ADD_PRINT_BOX_TABLE_ELEMENT( ISOM_BOX_TYPE_IODS, isom_print_iods );
-        ADD_PRINT_BOX_TABLE_ELEMENT(   QT_BOX_TYPE_CTAB, isom_print_ctab );
-        ADD_PRINT_BOX_TABLE_ELEMENT( ISOM_BOX_TYPE_TRAK, isom_print_trak );
-        ADD_PRINT_BOX_TABLE_ELEMENT( ISOM_BOX_TYPE_TKHD, isom_print_tkhd );
-        ADD_PRINT_BOX_TABLE_ELEMENT(   QT_BOX_TYPE_TAPT, isom_print_tapt );
-        ADD_PRINT_BOX_TABLE_ELEMENT(   QT_BOX_TYPE_CLEF, isom_print_clef );
-        ADD_PRINT_BOX_TABLE_ELEMENT(   QT_BOX_TYPE_PROF, isom_print_prof );
-        ADD_PRINT_BOX_TABLE_ELEMENT(   QT_BOX_TYPE_ENOF, isom_print_enof );
-        ADD_PRINT_BOX_TABLE_ELEMENT( ISOM_BOX_TYPE_EDTS, isom_print_edts );
-        ADD_PRINT_BOX_TABLE_ELEMENT( ISOM_BOX_TYPE_ELST, isom_print_elst );
-        ADD_PRINT_BOX_TABLE_ELEMENT( ISOM_BOX_TYPE_TREF, isom_print_tref );
-        ADD_PRINT_BOX_TABLE_ELEMENT( ISOM_BOX_TYPE_MDIA, isom_print_mdia );
-        ADD_PRINT_BOX_TABLE_ELEMENT( ISOM_BOX_TYPE_MDHD, isom_print_mdhd );
-        ADD_PRINT_BOX_TABLE_ELEMENT( ISOM_BOX_TYPE_HDLR, isom_print_hdlr );
-        ADD_PRINT_BOX_TABLE_ELEMENT( ISOM_BOX_TYPE_MINF, isom_print_minf );
-        ADD_PRINT_BOX_TABLE_ELEMENT( ISOM_BOX_TYPE_VMHD, isom_print_vmhd );
-        ADD_PRINT_BOX_TABLE_ELEMENT( ISOM_BOX_TYPE_SMHD, isom_print_smhd );
-        ADD_PRINT_BOX_TABLE_ELEMENT( ISOM_BOX_TYPE_HMHD, isom_print_hmhd );
-        ADD_PRINT_BOX_TABLE_ELEMENT( ISOM_BOX_TYPE_NMHD, isom_print_nmhd );
-        ADD_PRINT_BOX_TABLE_ELEMENT(   QT_BOX_TYPE_GMHD, isom_print_gmhd );
-        ADD_PRINT_BOX_TABLE_ELEMENT(   QT_BOX_TYPE_GMIN, isom_print_gmin );
-        ADD_PRINT_BOX_TABLE_ELEMENT(   QT_BOX_TYPE_TEXT, isom_print_text );
-        ADD_PRINT_BOX_TABLE_ELEMENT( ISOM_BOX_TYPE_DINF, isom_print_dinf );
-        ADD_PRINT_BOX_TABLE_ELEMENT( ISOM_BOX_TYPE_DREF, isom_print_dref );
-        ADD_PRINT_BOX_TABLE_ELEMENT( ISOM_BOX_TYPE_URL,  isom_print_url );
-        ADD_PRINT_BOX_TABLE_ELEMENT( ISOM_BOX_TYPE_STBL, isom_print_stbl );
-        ADD_PRINT_BOX_TABLE_ELEMENT( ISOM_BOX_TYPE_STSD, isom_print_stsd );
-        ADD_PRINT_BOX_TABLE_ELEMENT( ISOM_BOX_TYPE_CLAP, isom_print_clap );
-        ADD_PRINT_BOX_TABLE_ELEMENT( ISOM_BOX_TYPE_PASP, isom_print_pasp );
-        ADD_PRINT_BOX_TABLE_ELEMENT( ISOM_BOX_TYPE_COLR, isom_print_colr );
-        ADD_PRINT_BOX_TABLE_ELEMENT(   QT_BOX_TYPE_COLR, isom_print_colr );
-        ADD_PRINT_BOX_TABLE_ELEMENT(   QT_BOX_TYPE_GLBL, isom_print_glbl );
-        ADD_PRINT_BOX_TABLE_ELEMENT(   QT_BOX_TYPE_GAMA, isom_print_gama );
-        ADD_PRINT_BOX_TABLE_ELEMENT(   QT_BOX_TYPE_FIEL, isom_print_fiel );
-        ADD_PRINT_BOX_TABLE_ELEMENT(   QT_BOX_TYPE_CSPC, isom_print_cspc );
-        ADD_PRINT_BOX_TABLE_ELEMENT(   QT_BOX_TYPE_SGBT, isom_print_sgbt );
-        ADD_PRINT_BOX_TABLE_ELEMENT( ISOM_BOX_TYPE_STSL, isom_print_stsl );
-        ADD_PRINT_BOX_TABLE_ELEMENT(   QT_BOX_TYPE_WAVE, isom_print_wave );
-        ADD_PRINT_BOX_TABLE_ELEMENT(   QT_BOX_TYPE_CHAN, isom_print_chan );
-        ADD_PRINT_BOX_TABLE_ELEMENT( ISOM_BOX_TYPE_SRAT, isom_print_srat );
-        ADD_PRINT_BOX_TABLE_ELEMENT( ISOM_BOX_TYPE_FTAB, isom_print_ftab );
-        ADD_PRINT_BOX_TABLE_ELEMENT( ISOM_BOX_TYPE_STTS, isom_print_stts );
-        ADD_PRINT_BOX_TABLE_ELEMENT( ISOM_BOX_TYPE_CTTS, isom_print_ctts );
-        ADD_PRINT_BOX_TABLE_ELEMENT( ISOM_BOX_TYPE_CSLG, isom_print_cslg );
-        ADD_PRINT_BOX_TABLE_ELEMENT( ISOM_BOX_TYPE_STSS, isom_print_stss );
-        ADD_PRINT_BOX_TABLE_ELEMENT(   QT_BOX_TYPE_STPS, isom_print_stps );
-        ADD_PRINT_BOX_TABLE_ELEMENT( ISOM_BOX_TYPE_SDTP, isom_print_sdtp );
-        ADD_PRINT_BOX_TABLE_ELEMENT( ISOM_BOX_TYPE_STSC, isom_print_stsc );
-        ADD_PRINT_BOX_TABLE_ELEMENT( ISOM_BOX_TYPE_STSZ, isom_print_stsz );
-        ADD_PRINT_BOX_TABLE_ELEMENT( ISOM_BOX_TYPE_STCO, isom_print_stco );
-        ADD_PRINT_BOX_TABLE_ELEMENT( ISOM_BOX_TYPE_CO64, isom_print_stco );
-        ADD_PRINT_BOX_TABLE_ELEMENT( ISOM_BOX_TYPE_SGPD, isom_print_sgpd );
-        ADD_PRINT_BOX_TABLE_ELEMENT( ISOM_BOX_TYPE_SBGP, isom_print_sbgp );
-        ADD_PRINT_BOX_TABLE_ELEMENT( ISOM_BOX_TYPE_UDTA, isom_print_udta );
-        ADD_PRINT_BOX_TABLE_ELEMENT( ISOM_BOX_TYPE_CHPL, isom_print_chpl );
-        ADD_PRINT_BOX_TABLE_ELEMENT(   QT_BOX_TYPE_WLOC, isom_print_WLOC );
-        ADD_PRINT_BOX_TABLE_ELEMENT(   QT_BOX_TYPE_LOOP, isom_print_LOOP );
-        ADD_PRINT_BOX_TABLE_ELEMENT(   QT_BOX_TYPE_SELO, isom_print_SelO );
-        ADD_PRINT_BOX_TABLE_ELEMENT(   QT_BOX_TYPE_ALLF, isom_print_AllF );
-        ADD_PRINT_BOX_TABLE_ELEMENT( ISOM_BOX_TYPE_CPRT, isom_print_cprt );
-        ADD_PRINT_BOX_TABLE_ELEMENT( ISOM_BOX_TYPE_MVEX, isom_print_mvex );
-        ADD_PRINT_BOX_TABLE_ELEMENT( ISOM_BOX_TYPE_MEHD, isom_print_mehd );
-        ADD_PRINT_BOX_TABLE_ELEMENT( ISOM_BOX_TYPE_TREX, isom_print_trex );
-        ADD_PRINT_BOX_TABLE_ELEMENT( ISOM_BOX_TYPE_MOOF, isom_print_moof );
-        ADD_PRINT_BOX_TABLE_ELEMENT( ISOM_BOX_TYPE_MFHD, isom_print_mfhd );
-        ADD_PRINT_BOX_TABLE_ELEMENT( ISOM_BOX_TYPE_TRAF, isom_print_traf );
-        ADD_PRINT_BOX_TABLE_ELEMENT( ISOM_BOX_TYPE_TFHD, isom_print_tfhd );
-        ADD_PRINT_BOX_TABLE_ELEMENT( ISOM_BOX_TYPE_TFDT, isom_print_tfdt );
-        ADD_PRINT_BOX_TABLE_ELEMENT( ISOM_BOX_TYPE_TRUN, isom_print_trun );
-        ADD_PRINT_BOX_TABLE_ELEMENT( ISOM_BOX_TYPE_FREE, isom_print_free );
-        ADD_PRINT_BOX_TABLE_ELEMENT( ISOM_BOX_TYPE_SKIP, isom_print_free );
-        ADD_PRINT_BOX_TABLE_ELEMENT( ISOM_BOX_TYPE_MDAT, isom_print_mdat );
-        ADD_PRINT_BOX_TABLE_ELEMENT(   QT_BOX_TYPE_KEYS, isom_print_keys );
-        ADD_PRINT_BOX_TABLE_ELEMENT( ISOM_BOX_TYPE_META, isom_print_meta );
-        ADD_PRINT_BOX_TABLE_ELEMENT( ISOM_BOX_TYPE_ILST, isom_print_ilst );
-        ADD_PRINT_BOX_TABLE_ELEMENT(   QT_BOX_TYPE_ILST, isom_print_ilst );
-        ADD_PRINT_BOX_TABLE_ELEMENT( ISOM_BOX_TYPE_MFRA, isom_print_mfra );
-        ADD_PRINT_BOX_TABLE_ELEMENT( ISOM_BOX_TYPE_TFRA, isom_print_tfra );
-        ADD_PRINT_BOX_TABLE_ELEMENT( ISOM_BOX_TYPE_MFRO, isom_print_mfro );
-        ADD_PRINT_BOX_TABLE_ELEMENT( LSMASH_BOX_TYPE_UNSPECIFIED, NULL );
-#undef ADD_PRINT_BOX_TABLE_ELEMENT
+        isom_json_field_int( stream, "previewTime", mvhd->previewTime );
+        isom_json_field_int( stream, "previewDuration", mvhd->previewDuration );
+        isom_json_field_int( stream, "posterTime", mvhd->posterTime );
+        isom_json_field_int( stream, "selectionTime", mvhd->selectionTime );
+        isom_json_field_int( stream, "selectionDuration", mvhd->selectionDuration );
+        isom_json_field_int( stream, "currentTime", mvhd->currentTime );
     }
-    for( int i = 0; print_box_table[i].func; i++ )
-        if( lsmash_check_box_type_identical( box->type, print_box_table[i].type ) )
-            return print_box_table[i].func;
-    return isom_print_unknown;
+    isom_json_field_uint( stream, "next_track_ID", mvhd->next_track_ID );
 }
 
-static inline void isom_print_remove_plastic_box( isom_box_t *box )
+static void isom_json_color_table( isom_print_stream_t *stream, isom_qt_color_table_t *color_table )
 {
-    if( box->manager & LSMASH_ABSENT_IN_FILE )
-        /* free flagged box */
-        isom_remove_box_by_itself( box );
+    isom_qt_color_array_t *array = color_table->array;
+    if( !array )
+        return;
+    isom_json_field_uint( stream, "ctSeed", color_table->seed );
+    isom_json_field_uint( stream, "ctFlags", color_table->flags );
+    isom_json_field_uint( stream, "ctSize", color_table->size );
+    /* [ value, r, g, b ] */
+    isom_json_key( stream, "ctTable" );
+    isom_json_begin( stream, '[' );
+    for( uint32_t i = 0; i <= color_table->size; i++ )
+    {
+        isom_json_separate( stream );
+        isom_json_begin( stream, '[' );
+        isom_json_element_uint( stream, array[i].value );
+        isom_json_element_uint( stream, array[i].r );
+        isom_json_element_uint( stream, array[i].g );
+        isom_json_element_uint( stream, array[i].b );
+        isom_json_end( stream, ']' );
+    }
+    isom_json_end( stream, ']' );
+}
+
+static void isom_json_ctab( isom_print_stream_t *stream, lsmash_file_t *file, isom_box_t *box )
+{
+    isom_json_color_table( stream, &((isom_ctab_t *)box)->color_table );
+}
+
+static void isom_json_iods( isom_print_stream_t *stream, lsmash_file_t *file, isom_box_t *box )
+{
+    extern void mp4sys_json_descriptor( isom_print_stream_t *, void * );
+    isom_iods_t *iods = (isom_iods_t *)box;
+    if( !iods->OD )
+        return;
+    isom_json_key( stream, "descriptor" );
+    mp4sys_json_descriptor( stream, iods->OD );
+}
+
+static void isom_json_tkhd( isom_print_stream_t *stream, lsmash_file_t *file, isom_box_t *box )
+{
+    isom_tkhd_t *tkhd = (isom_tkhd_t *)box;
+    isom_json_field_uint( stream, "creation_time", tkhd->creation_time );
+    isom_json_field_uint( stream, "modification_time", tkhd->modification_time );
+    isom_json_field_uint( stream, "track_ID", tkhd->track_ID );
+    isom_json_field_uint( stream, "duration", tkhd->duration );
+    isom_json_field_int( stream, "layer", tkhd->layer );
+    isom_json_field_int( stream, "alternate_group", tkhd->alternate_group );
+    isom_json_field_int( stream, "volume", tkhd->volume );
+    isom_json_matrix( stream, tkhd->matrix );
+    isom_json_field_uint( stream, "width", tkhd->width );
+    isom_json_field_uint( stream, "height", tkhd->height );
+}
+
+/* Track Clean Aperture, Production Aperture and Encoded Pixels Dimensions Boxes have the same fields. */
+static void isom_json_clef( isom_print_stream_t *stream, lsmash_file_t *file, isom_box_t *box )
+{
+    isom_clef_t *clef = (isom_clef_t *)box;
+    isom_json_field_uint( stream, "width", clef->width );
+    isom_json_field_uint( stream, "height", clef->height );
+}
+
+static void isom_json_elst( isom_print_stream_t *stream, lsmash_file_t *file, isom_box_t *box )
+{
+    isom_elst_t *elst = (isom_elst_t *)box;
+    if( !elst->list )
+        return;
+    isom_json_field_uint( stream, "entry_count", elst->list->entry_count );
+    /* [ segment_duration, media_time, media_rate ] */
+    isom_json_key( stream, "entries" );
+    isom_json_begin( stream, '[' );
+    uint32_t i = 0;
+    for( lsmash_entry_t *entry = elst->list->head; entry && !isom_json_omit_entries( stream, i ); entry = entry->next, i++ )
+    {
+        isom_elst_entry_t *data = (isom_elst_entry_t *)entry->data;
+        isom_json_separate( stream );
+        isom_json_begin( stream, '[' );
+        isom_json_element_uint( stream, data->segment_duration );
+        isom_json_element_int( stream, data->media_time );
+        isom_json_element_int( stream, data->media_rate );
+        isom_json_end( stream, ']' );
+    }
+    isom_json_end( stream, ']' );
+}
+
+static void isom_json_track_reference_type( isom_print_stream_t *stream, lsmash_file_t *file, isom_box_t *box )
+{
+    isom_tref_type_t *ref = (isom_tref_type_t *)box;
+    isom_json_key( stream, "track_ID" );
+    isom_json_begin( stream, '[' );
+    for( uint32_t i = 0; i < ref->ref_count; i++ )
+        isom_json_element_uint( stream, ref->track_ID[i] );
+    isom_json_end( stream, ']' );
+}
+
+static void isom_json_mdhd( isom_print_stream_t *stream, lsmash_file_t *file, isom_box_t *box )
+{
+    isom_mdhd_t *mdhd = (isom_mdhd_t *)box;
+    isom_json_field_uint( stream, "creation_time", mdhd->creation_time );
+    isom_json_field_uint( stream, "modification_time", mdhd->modification_time );
+    isom_json_field_uint( stream, "timescale", mdhd->timescale );
+    isom_json_field_uint( stream, "duration", mdhd->duration );
+    if( mdhd->language >= 0x800 )
+    {
+        isom_json_key( stream, "language" );
+        isom_json_put_string( stream, isom_unpack_iso_language( (char [4]){ 0 }, mdhd->language ), 3 );
+    }
+    else
+        /* Macintosh language code */
+        isom_json_field_uint( stream, "language", mdhd->language );
+    if( file->qt_compatible )
+        isom_json_field_int( stream, "quality", mdhd->quality );
+}
+
+static void isom_json_hdlr( isom_print_stream_t *stream, lsmash_file_t *file, isom_box_t *box )
+{
+    isom_hdlr_t *hdlr = (isom_hdlr_t *)box;
+    if( file->qt_compatible )
+        isom_json_field_fourcc( stream, "componentType", hdlr->componentType );
+    isom_json_field_fourcc( stream, "handler_type", hdlr->componentSubtype );
+    if( file->qt_compatible )
+    {
+        isom_json_field_fourcc( stream, "componentManufacturer", hdlr->componentManufacturer );
+        isom_json_field_uint( stream, "componentFlags", hdlr->componentFlags );
+        isom_json_field_uint( stream, "componentFlagsMask", hdlr->componentFlagsMask );
+    }
+    const char *name   = (const char *)hdlr->componentName;
+    size_t      length = hdlr->componentName_length;
+    if( file->qt_compatible && length )
+    {
+        /* Pascal string */
+        ++name;
+        --length;
+    }
+    isom_json_key( stream, "name" );
+    isom_json_put_string( stream, name ? name : "", name ? isom_json_strnlen( name, length ) : 0 );
+}
+
+static void isom_json_vmhd( isom_print_stream_t *stream, lsmash_file_t *file, isom_box_t *box )
+{
+    isom_vmhd_t *vmhd = (isom_vmhd_t *)box;
+    isom_json_field_uint( stream, "graphicsmode", vmhd->graphicsmode );
+    isom_json_rgb_color( stream, "opcolor", vmhd->opcolor );
+}
+
+static void isom_json_smhd( isom_print_stream_t *stream, lsmash_file_t *file, isom_box_t *box )
+{
+    isom_json_field_int( stream, "balance", ((isom_smhd_t *)box)->balance );
+}
+
+static void isom_json_hmhd( isom_print_stream_t *stream, lsmash_file_t *file, isom_box_t *box )
+{
+    isom_hmhd_t *hmhd = (isom_hmhd_t *)box;
+    isom_json_field_uint( stream, "maxPDUsize", hmhd->maxPDUsize );
+    isom_json_field_uint( stream, "avgPDUsize", hmhd->avgPDUsize );
+    isom_json_field_uint( stream, "maxbitrate", hmhd->maxbitrate );
+    isom_json_field_uint( stream, "avgbitrate", hmhd->avgbitrate );
+}
+
+static void isom_json_gmin( isom_print_stream_t *stream, lsmash_file_t *file, isom_box_t *box )
+{
+    isom_gmin_t *gmin = (isom_gmin_t *)box;
+    isom_json_field_uint( stream, "graphicsmode", gmin->graphicsmode );
+    isom_json_rgb_color( stream, "opcolor", gmin->opcolor );
+    isom_json_field_int( stream, "balance", gmin->balance );
+}
+
+static void isom_json_text( isom_print_stream_t *stream, lsmash_file_t *file, isom_box_t *box )
+{
+    isom_json_matrix( stream, ((isom_text_t *)box)->matrix );
+}
+
+static void isom_json_dref( isom_print_stream_t *stream, lsmash_file_t *file, isom_box_t *box )
+{
+    isom_json_field_uint( stream, "entry_count", ((isom_dref_t *)box)->list.entry_count );
+}
+
+static void isom_json_url( isom_print_stream_t *stream, lsmash_file_t *file, isom_box_t *box )
+{
+    isom_dref_entry_t *url = (isom_dref_entry_t *)box;
+    /* The location is absent if the flags say the media data is in the same file. */
+    if( !(url->flags & 0x000001) && url->location )
+        isom_json_field_string( stream, "location", url->location, isom_json_strnlen( url->location, url->location_length ) );
+}
+
+static void isom_json_stsd( isom_print_stream_t *stream, lsmash_file_t *file, isom_box_t *box )
+{
+    isom_json_field_uint( stream, "entry_count", ((isom_stsd_t *)box)->entry_count );
+}
+
+static void isom_json_visual_description( isom_print_stream_t *stream, lsmash_file_t *file, isom_box_t *box )
+{
+    isom_visual_entry_t *visual = (isom_visual_entry_t *)box;
+    isom_json_field_uint( stream, "data_reference_index", visual->data_reference_index );
+    if( file->qt_compatible )
+    {
+        isom_json_field_int( stream, "version", visual->version );
+        isom_json_field_int( stream, "revision_level", visual->revision_level );
+        isom_json_field_fourcc( stream, "vendor", visual->vendor );
+        isom_json_field_uint( stream, "temporalQuality", visual->temporalQuality );
+        isom_json_field_uint( stream, "spatialQuality", visual->spatialQuality );
+    }
+    isom_json_field_uint( stream, "width", visual->width );
+    isom_json_field_uint( stream, "height", visual->height );
+    isom_json_field_uint( stream, "horizresolution", visual->horizresolution );
+    isom_json_field_uint( stream, "vertresolution", visual->vertresolution );
+    if( file->qt_compatible )
+        isom_json_field_uint( stream, "dataSize", visual->dataSize );
+    isom_json_field_uint( stream, "frame_count", visual->frame_count );
+    /* Pascal string in a fixed 32-byte field */
+    isom_json_field_string( stream, "compressorname", &visual->compressorname[1], LSMASH_MIN( (uint8_t)visual->compressorname[0], 31 ) );
+    isom_json_field_uint( stream, "depth", visual->depth );
+    if( file->qt_compatible )
+    {
+        isom_json_field_int( stream, "color_table_ID", visual->color_table_ID );
+        if( visual->color_table_ID == 0 )
+            isom_json_color_table( stream, &visual->color_table );
+    }
+}
+
+static void isom_json_glbl( isom_print_stream_t *stream, lsmash_file_t *file, isom_box_t *box )
+{
+    isom_glbl_t *glbl = (isom_glbl_t *)box;
+    if( glbl->header_data )
+        isom_json_field_bytes( stream, "global_header", glbl->header_data, glbl->header_size );
+}
+
+static void isom_json_clap( isom_print_stream_t *stream, lsmash_file_t *file, isom_box_t *box )
+{
+    isom_clap_t *clap = (isom_clap_t *)box;
+    isom_json_field_uint( stream, "cleanApertureWidthN", clap->cleanApertureWidthN );
+    isom_json_field_uint( stream, "cleanApertureWidthD", clap->cleanApertureWidthD );
+    isom_json_field_uint( stream, "cleanApertureHeightN", clap->cleanApertureHeightN );
+    isom_json_field_uint( stream, "cleanApertureHeightD", clap->cleanApertureHeightD );
+    isom_json_field_int( stream, "horizOffN", clap->horizOffN );
+    isom_json_field_uint( stream, "horizOffD", clap->horizOffD );
+    isom_json_field_int( stream, "vertOffN", clap->vertOffN );
+    isom_json_field_uint( stream, "vertOffD", clap->vertOffD );
+}
+
+static void isom_json_pasp( isom_print_stream_t *stream, lsmash_file_t *file, isom_box_t *box )
+{
+    isom_pasp_t *pasp = (isom_pasp_t *)box;
+    isom_json_field_uint( stream, "hSpacing", pasp->hSpacing );
+    isom_json_field_uint( stream, "vSpacing", pasp->vSpacing );
+}
+
+static void isom_json_colr( isom_print_stream_t *stream, lsmash_file_t *file, isom_box_t *box )
+{
+    isom_colr_t *colr = (isom_colr_t *)box;
+    isom_json_field_fourcc( stream, "color_parameter_type", colr->color_parameter_type );
+    if( colr->color_parameter_type != QT_COLOR_PARAMETER_TYPE_NCLC
+     && colr->color_parameter_type != ISOM_COLOR_PARAMETER_TYPE_NCLX )
+        return;
+    isom_json_field_uint( stream, "primaries_index", colr->primaries_index );
+    isom_json_field_uint( stream, "transfer_function_index", colr->transfer_function_index );
+    isom_json_field_uint( stream, "matrix_index", colr->matrix_index );
+    if( colr->color_parameter_type == ISOM_COLOR_PARAMETER_TYPE_NCLX
+     && !(colr->manager & LSMASH_INCOMPLETE_BOX) )
+        isom_json_field_uint( stream, "full_range_flag", colr->full_range_flag );
+}
+
+static void isom_json_gama( isom_print_stream_t *stream, lsmash_file_t *file, isom_box_t *box )
+{
+    isom_json_field_uint( stream, "level", ((isom_gama_t *)box)->level );
+}
+
+static void isom_json_fiel( isom_print_stream_t *stream, lsmash_file_t *file, isom_box_t *box )
+{
+    isom_fiel_t *fiel = (isom_fiel_t *)box;
+    isom_json_field_uint( stream, "fields", fiel->fields );
+    isom_json_field_uint( stream, "detail", fiel->detail );
+}
+
+static void isom_json_cspc( isom_print_stream_t *stream, lsmash_file_t *file, isom_box_t *box )
+{
+    /* Some pixel formats are not four-character codes but small numbers. */
+    isom_json_field_uint( stream, "pixel_format", ((isom_cspc_t *)box)->pixel_format );
+}
+
+static void isom_json_sgbt( isom_print_stream_t *stream, lsmash_file_t *file, isom_box_t *box )
+{
+    isom_json_field_uint( stream, "significantBits", ((isom_sgbt_t *)box)->significantBits );
+}
+
+static void isom_json_stsl( isom_print_stream_t *stream, lsmash_file_t *file, isom_box_t *box )
+{
+    isom_stsl_t *stsl = (isom_stsl_t *)box;
+    isom_json_field_uint( stream, "constraint_flag", stsl->constraint_flag & 0x01 );
+    isom_json_field_uint( stream, "scale_method", stsl->scale_method );
+    isom_json_field_int( stream, "display_center_x", stsl->display_center_x );
+    isom_json_field_int( stream, "display_center_y", stsl->display_center_y );
+}
+
+static void isom_json_audio_description( isom_print_stream_t *stream, lsmash_file_t *file, isom_box_t *box )
+{
+    isom_audio_entry_t *audio = (isom_audio_entry_t *)box;
+    isom_json_field_uint( stream, "data_reference_index", audio->data_reference_index );
+    if( file->qt_compatible )
+    {
+        isom_json_field_int( stream, "version", audio->version );
+        isom_json_field_int( stream, "revision_level", audio->revision_level );
+        isom_json_field_fourcc( stream, "vendor", audio->vendor );
+    }
+    isom_json_field_uint( stream, "channelcount", audio->channelcount );
+    isom_json_field_uint( stream, "samplesize", audio->samplesize );
+    if( file->qt_compatible )
+    {
+        isom_json_field_int( stream, "compression_ID", audio->compression_ID );
+        isom_json_field_uint( stream, "packet_size", audio->packet_size );
+    }
+    isom_json_field_uint( stream, "samplerate", audio->samplerate >> 16 );
+    if( audio->version == 1 && (audio->manager & LSMASH_QTFF_BASE) )
+    {
+        isom_json_field_uint( stream, "samplesPerPacket", audio->samplesPerPacket );
+        isom_json_field_uint( stream, "bytesPerPacket", audio->bytesPerPacket );
+        isom_json_field_uint( stream, "bytesPerFrame", audio->bytesPerFrame );
+        isom_json_field_uint( stream, "bytesPerSample", audio->bytesPerSample );
+    }
+    else if( audio->version == 2 )
+    {
+        isom_json_field_uint( stream, "sizeOfStructOnly", audio->sizeOfStructOnly );
+        /* the bit pattern of the 64-bit floating point number as stored */
+        isom_json_field_uint( stream, "audioSampleRate", audio->audioSampleRate );
+        isom_json_field_uint( stream, "numAudioChannels", audio->numAudioChannels );
+        isom_json_field_uint( stream, "constBitsPerChannel", audio->constBitsPerChannel );
+        isom_json_field_uint( stream, "formatSpecificFlags", audio->formatSpecificFlags );
+        isom_json_field_uint( stream, "constBytesPerAudioPacket", audio->constBytesPerAudioPacket );
+        isom_json_field_uint( stream, "constLPCMFramesPerAudioPacket", audio->constLPCMFramesPerAudioPacket );
+    }
+}
+
+static void isom_json_frma( isom_print_stream_t *stream, lsmash_file_t *file, isom_box_t *box )
+{
+    isom_json_field_fourcc( stream, "data_format", ((isom_frma_t *)box)->data_format );
+}
+
+static void isom_json_enda( isom_print_stream_t *stream, lsmash_file_t *file, isom_box_t *box )
+{
+    isom_json_field_uint( stream, "littleEndian", ((isom_enda_t *)box)->littleEndian );
+}
+
+static void isom_json_chan( isom_print_stream_t *stream, lsmash_file_t *file, isom_box_t *box )
+{
+    isom_chan_t *chan = (isom_chan_t *)box;
+    isom_json_field_uint( stream, "channelLayoutTag", chan->channelLayoutTag );
+    isom_json_field_uint( stream, "channelBitmap", chan->channelBitmap );
+    isom_json_field_uint( stream, "numberChannelDescriptions", chan->numberChannelDescriptions );
+    if( !chan->channelDescriptions )
+        return;
+    /* [ channelLabel, channelFlags, coordinates[0], coordinates[1], coordinates[2] ]
+     * The coordinates are the bit patterns of the 32-bit floating point numbers as stored. */
+    isom_json_key( stream, "channelDescriptions" );
+    isom_json_begin( stream, '[' );
+    for( uint32_t i = 0; i < chan->numberChannelDescriptions; i++ )
+    {
+        isom_channel_description_t *desc = &chan->channelDescriptions[i];
+        isom_json_separate( stream );
+        isom_json_begin( stream, '[' );
+        isom_json_element_uint( stream, desc->channelLabel );
+        isom_json_element_uint( stream, desc->channelFlags );
+        for( int j = 0; j < 3; j++ )
+            isom_json_element_uint( stream, desc->coordinates[j] );
+        isom_json_end( stream, ']' );
+    }
+    isom_json_end( stream, ']' );
+}
+
+static void isom_json_srat( isom_print_stream_t *stream, lsmash_file_t *file, isom_box_t *box )
+{
+    isom_json_field_uint( stream, "sampling_rate", ((isom_srat_t *)box)->sampling_rate );
+}
+
+static void isom_json_text_description( isom_print_stream_t *stream, lsmash_file_t *file, isom_box_t *box )
+{
+    isom_qt_text_entry_t *text = (isom_qt_text_entry_t *)box;
+    isom_json_field_uint( stream, "data_reference_index", text->data_reference_index );
+    isom_json_field_int( stream, "displayFlags", text->displayFlags );
+    isom_json_field_int( stream, "textJustification", text->textJustification );
+    isom_json_rgb_color( stream, "bgColor", text->bgColor );
+    isom_json_field_int( stream, "top", text->top );
+    isom_json_field_int( stream, "left", text->left );
+    isom_json_field_int( stream, "bottom", text->bottom );
+    isom_json_field_int( stream, "right", text->right );
+    isom_json_field_int( stream, "scrpStartChar", text->scrpStartChar );
+    isom_json_field_int( stream, "scrpHeight", text->scrpHeight );
+    isom_json_field_int( stream, "scrpAscent", text->scrpAscent );
+    isom_json_field_int( stream, "scrpFont", text->scrpFont );
+    isom_json_field_uint( stream, "scrpFace", text->scrpFace );
+    isom_json_field_int( stream, "scrpSize", text->scrpSize );
+    isom_json_rgb_color( stream, "scrpColor", text->scrpColor );
+    if( text->font_name_length && text->font_name )
+        isom_json_field_string( stream, "font_name", text->font_name, text->font_name_length );
+}
+
+static void isom_json_tx3g_description( isom_print_stream_t *stream, lsmash_file_t *file, isom_box_t *box )
+{
+    isom_tx3g_entry_t *tx3g = (isom_tx3g_entry_t *)box;
+    isom_json_field_uint( stream, "data_reference_index", tx3g->data_reference_index );
+    isom_json_field_int( stream, "displayFlags", tx3g->displayFlags );
+    isom_json_field_int( stream, "horizontal_justification", tx3g->horizontal_justification );
+    isom_json_field_int( stream, "vertical_justification", tx3g->vertical_justification );
+    isom_json_rgba_color( stream, "background_color_rgba", tx3g->background_color_rgba );
+    isom_json_field_int( stream, "top", tx3g->top );
+    isom_json_field_int( stream, "left", tx3g->left );
+    isom_json_field_int( stream, "bottom", tx3g->bottom );
+    isom_json_field_int( stream, "right", tx3g->right );
+    isom_json_field_uint( stream, "startChar", tx3g->startChar );
+    isom_json_field_uint( stream, "endChar", tx3g->endChar );
+    isom_json_field_uint( stream, "font_ID", tx3g->font_ID );
+    isom_json_field_uint( stream, "face_style_flags", tx3g->face_style_flags );
+    isom_json_field_uint( stream, "font_size", tx3g->font_size );
+    isom_json_rgba_color( stream, "text_color_rgba", tx3g->text_color_rgba );
+}
+
+static void isom_json_ftab( isom_print_stream_t *stream, lsmash_file_t *file, isom_box_t *box )
+{
+    isom_ftab_t *ftab = (isom_ftab_t *)box;
+    if( !ftab->list )
+        return;
+    isom_json_field_uint( stream, "entry_count", ftab->list->entry_count );
+    /* [ font_ID, font_name ] */
+    isom_json_key( stream, "entries" );
+    isom_json_begin( stream, '[' );
+    for( lsmash_entry_t *entry = ftab->list->head; entry; entry = entry->next )
+    {
+        isom_font_record_t *data = (isom_font_record_t *)entry->data;
+        isom_json_separate( stream );
+        isom_json_begin( stream, '[' );
+        isom_json_element_uint( stream, data->font_ID );
+        isom_json_element_string( stream, data->font_name ? data->font_name : "", data->font_name ? data->font_name_length : 0 );
+        isom_json_end( stream, ']' );
+    }
+    isom_json_end( stream, ']' );
+}
+
+static void isom_json_mp4s_description( isom_print_stream_t *stream, lsmash_file_t *file, isom_box_t *box )
+{
+    isom_json_field_uint( stream, "data_reference_index", ((isom_mp4s_entry_t *)box)->data_reference_index );
+}
+
+static void isom_json_stts( isom_print_stream_t *stream, lsmash_file_t *file, isom_box_t *box )
+{
+    isom_stts_t *stts = (isom_stts_t *)box;
+    if( !stts->list )
+        return;
+    isom_json_field_uint( stream, "entry_count", stts->list->entry_count );
+    /* [ sample_count, sample_delta ] */
+    isom_json_key( stream, "entries" );
+    isom_json_begin( stream, '[' );
+    uint32_t i = 0;
+    for( lsmash_entry_t *entry = stts->list->head; entry && !isom_json_omit_entries( stream, i ); entry = entry->next, i++ )
+    {
+        isom_stts_entry_t *data = (isom_stts_entry_t *)entry->data;
+        isom_json_separate( stream );
+        isom_json_begin( stream, '[' );
+        isom_json_element_uint( stream, data->sample_count );
+        isom_json_element_uint( stream, data->sample_delta );
+        isom_json_end( stream, ']' );
+    }
+    isom_json_end( stream, ']' );
+}
+
+static void isom_json_ctts( isom_print_stream_t *stream, lsmash_file_t *file, isom_box_t *box )
+{
+    isom_ctts_t *ctts = (isom_ctts_t *)box;
+    if( !ctts->list )
+        return;
+    int is_signed = file->qt_compatible || ctts->version == 1;
+    isom_json_field_uint( stream, "entry_count", ctts->list->entry_count );
+    /* [ sample_count, sample_offset ] */
+    isom_json_key( stream, "entries" );
+    isom_json_begin( stream, '[' );
+    uint32_t i = 0;
+    for( lsmash_entry_t *entry = ctts->list->head; entry && !isom_json_omit_entries( stream, i ); entry = entry->next, i++ )
+    {
+        isom_ctts_entry_t *data = (isom_ctts_entry_t *)entry->data;
+        isom_json_separate( stream );
+        isom_json_begin( stream, '[' );
+        isom_json_element_uint( stream, data->sample_count );
+        if( is_signed )
+            isom_json_element_int( stream, (union {uint32_t ui; int32_t si;}){ data->sample_offset }.si );
+        else
+            isom_json_element_uint( stream, data->sample_offset );
+        isom_json_end( stream, ']' );
+    }
+    isom_json_end( stream, ']' );
+}
+
+static void isom_json_cslg( isom_print_stream_t *stream, lsmash_file_t *file, isom_box_t *box )
+{
+    isom_cslg_t *cslg = (isom_cslg_t *)box;
+    isom_json_field_int( stream, "compositionToDTSShift", cslg->compositionToDTSShift );
+    isom_json_field_int( stream, "leastDecodeToDisplayDelta", cslg->leastDecodeToDisplayDelta );
+    isom_json_field_int( stream, "greatestDecodeToDisplayDelta", cslg->greatestDecodeToDisplayDelta );
+    isom_json_field_int( stream, "compositionStartTime", cslg->compositionStartTime );
+    isom_json_field_int( stream, "compositionEndTime", cslg->compositionEndTime );
+}
+
+static void isom_json_sample_numbers( isom_print_stream_t *stream, lsmash_entry_list_t *list )
+{
+    /* Both Sync Sample Box and Partial Sync Sample Box have an array of sample_number only. */
+    isom_json_field_uint( stream, "entry_count", list->entry_count );
+    isom_json_key( stream, "sample_number" );
+    isom_json_begin( stream, '[' );
+    uint32_t i = 0;
+    for( lsmash_entry_t *entry = list->head; entry && !isom_json_omit_entries( stream, i ); entry = entry->next, i++ )
+        isom_json_element_uint( stream, ((isom_stss_entry_t *)entry->data)->sample_number );
+    isom_json_end( stream, ']' );
+}
+
+static void isom_json_stss( isom_print_stream_t *stream, lsmash_file_t *file, isom_box_t *box )
+{
+    if( ((isom_stss_t *)box)->list )
+        isom_json_sample_numbers( stream, ((isom_stss_t *)box)->list );
+}
+
+static void isom_json_stps( isom_print_stream_t *stream, lsmash_file_t *file, isom_box_t *box )
+{
+    if( ((isom_stps_t *)box)->list )
+        isom_json_sample_numbers( stream, ((isom_stps_t *)box)->list );
+}
+
+static void isom_json_sdtp( isom_print_stream_t *stream, lsmash_file_t *file, isom_box_t *box )
+{
+    isom_sdtp_t *sdtp = (isom_sdtp_t *)box;
+    if( !sdtp->list )
+        return;
+    /* [ is_leading, sample_depends_on, sample_is_depended_on, sample_has_redundancy ] */
+    isom_json_key( stream, "entries" );
+    isom_json_begin( stream, '[' );
+    uint32_t i = 0;
+    for( lsmash_entry_t *entry = sdtp->list->head; entry && !isom_json_omit_entries( stream, i ); entry = entry->next, i++ )
+    {
+        isom_sdtp_entry_t *data = (isom_sdtp_entry_t *)entry->data;
+        isom_json_separate( stream );
+        isom_json_begin( stream, '[' );
+        isom_json_element_uint( stream, data->is_leading );
+        isom_json_element_uint( stream, data->sample_depends_on );
+        isom_json_element_uint( stream, data->sample_is_depended_on );
+        isom_json_element_uint( stream, data->sample_has_redundancy );
+        isom_json_end( stream, ']' );
+    }
+    isom_json_end( stream, ']' );
+}
+
+static void isom_json_stsc( isom_print_stream_t *stream, lsmash_file_t *file, isom_box_t *box )
+{
+    isom_stsc_t *stsc = (isom_stsc_t *)box;
+    if( !stsc->list )
+        return;
+    isom_json_field_uint( stream, "entry_count", stsc->list->entry_count );
+    /* [ first_chunk, samples_per_chunk, sample_description_index ] */
+    isom_json_key( stream, "entries" );
+    isom_json_begin( stream, '[' );
+    uint32_t i = 0;
+    for( lsmash_entry_t *entry = stsc->list->head; entry && !isom_json_omit_entries( stream, i ); entry = entry->next, i++ )
+    {
+        isom_stsc_entry_t *data = (isom_stsc_entry_t *)entry->data;
+        isom_json_separate( stream );
+        isom_json_begin( stream, '[' );
+        isom_json_element_uint( stream, data->first_chunk );
+        isom_json_element_uint( stream, data->samples_per_chunk );
+        isom_json_element_uint( stream, data->sample_description_index );
+        isom_json_end( stream, ']' );
+    }
+    isom_json_end( stream, ']' );
+}
+
+static void isom_json_stsz( isom_print_stream_t *stream, lsmash_file_t *file, isom_box_t *box )
+{
+    isom_stsz_t *stsz = (isom_stsz_t *)box;
+    isom_json_field_uint( stream, "sample_size", stsz->sample_size );
+    isom_json_field_uint( stream, "sample_count", stsz->sample_count );
+    if( stsz->sample_size || !stsz->list )
+        return;
+    isom_json_key( stream, "entry_size" );
+    isom_json_begin( stream, '[' );
+    uint32_t i = 0;
+    for( lsmash_entry_t *entry = stsz->list->head; entry && !isom_json_omit_entries( stream, i ); entry = entry->next, i++ )
+        isom_json_element_uint( stream, ((isom_stsz_entry_t *)entry->data)->entry_size );
+    isom_json_end( stream, ']' );
+}
+
+static void isom_json_stco( isom_print_stream_t *stream, lsmash_file_t *file, isom_box_t *box )
+{
+    isom_stco_t *stco = (isom_stco_t *)box;
+    if( !stco->list )
+        return;
+    int large = lsmash_check_box_type_identical( stco->type, ISOM_BOX_TYPE_CO64 );
+    isom_json_field_uint( stream, "entry_count", stco->list->entry_count );
+    isom_json_key( stream, "chunk_offset" );
+    isom_json_begin( stream, '[' );
+    uint32_t i = 0;
+    for( lsmash_entry_t *entry = stco->list->head; entry && !isom_json_omit_entries( stream, i ); entry = entry->next, i++ )
+        isom_json_element_uint( stream, large ? ((isom_co64_entry_t *)entry->data)->chunk_offset
+                                              : ((isom_stco_entry_t *)entry->data)->chunk_offset );
+    isom_json_end( stream, ']' );
+}
+
+static void isom_json_sgpd( isom_print_stream_t *stream, lsmash_file_t *file, isom_box_t *box )
+{
+    isom_sgpd_t *sgpd = (isom_sgpd_t *)box;
+    isom_json_field_fourcc( stream, "grouping_type", sgpd->grouping_type );
+    if( sgpd->version == 1 )
+        isom_json_field_uint( stream, "default_length", sgpd->default_length );
+    if( !sgpd->list )
+        return;
+    isom_json_field_uint( stream, "entry_count", sgpd->list->entry_count );
+    int variable_length = sgpd->version == 1 && !sgpd->default_length;
+    switch( sgpd->grouping_type )
+    {
+        case ISOM_GROUP_TYPE_RAP :
+            if( variable_length )
+            {
+                isom_json_key( stream, "description_length" );
+                isom_json_begin( stream, '[' );
+                for( lsmash_entry_t *entry = sgpd->list->head; entry; entry = entry->next )
+                    isom_json_element_uint( stream, ((isom_rap_entry_t *)entry->data)->description_length );
+                isom_json_end( stream, ']' );
+                break;
+            }
+            /* [ num_leading_samples_known, num_leading_samples ] */
+            isom_json_key( stream, "entries" );
+            isom_json_begin( stream, '[' );
+            for( lsmash_entry_t *entry = sgpd->list->head; entry; entry = entry->next )
+            {
+                isom_rap_entry_t *rap = (isom_rap_entry_t *)entry->data;
+                isom_json_separate( stream );
+                isom_json_begin( stream, '[' );
+                isom_json_element_uint( stream, rap->num_leading_samples_known );
+                isom_json_element_uint( stream, rap->num_leading_samples );
+                isom_json_end( stream, ']' );
+            }
+            isom_json_end( stream, ']' );
+            break;
+        case ISOM_GROUP_TYPE_ROLL :
+        case ISOM_GROUP_TYPE_PROL :
+            isom_json_key( stream, variable_length ? "description_length" : "roll_distance" );
+            isom_json_begin( stream, '[' );
+            for( lsmash_entry_t *entry = sgpd->list->head; entry; entry = entry->next )
+            {
+                isom_roll_entry_t *roll = (isom_roll_entry_t *)entry->data;
+                if( variable_length )
+                    isom_json_element_uint( stream, roll->description_length );
+                else
+                    isom_json_element_int( stream, roll->roll_distance );
+            }
+            isom_json_end( stream, ']' );
+            break;
+        default :
+            break;
+    }
+}
+
+static void isom_json_sbgp( isom_print_stream_t *stream, lsmash_file_t *file, isom_box_t *box )
+{
+    isom_sbgp_t *sbgp = (isom_sbgp_t *)box;
+    isom_json_field_fourcc( stream, "grouping_type", sbgp->grouping_type );
+    if( sbgp->version == 1 )
+        isom_json_field_fourcc( stream, "grouping_type_parameter", sbgp->grouping_type_parameter );
+    if( !sbgp->list )
+        return;
+    isom_json_field_uint( stream, "entry_count", sbgp->list->entry_count );
+    /* [ sample_count, group_description_index ] */
+    isom_json_key( stream, "entries" );
+    isom_json_begin( stream, '[' );
+    uint32_t i = 0;
+    for( lsmash_entry_t *entry = sbgp->list->head; entry && !isom_json_omit_entries( stream, i ); entry = entry->next, i++ )
+    {
+        isom_group_assignment_entry_t *data = (isom_group_assignment_entry_t *)entry->data;
+        isom_json_separate( stream );
+        isom_json_begin( stream, '[' );
+        isom_json_element_uint( stream, data->sample_count );
+        isom_json_element_uint( stream, data->group_description_index );
+        isom_json_end( stream, ']' );
+    }
+    isom_json_end( stream, ']' );
+}
+
+static void isom_json_chpl( isom_print_stream_t *stream, lsmash_file_t *file, isom_box_t *box )
+{
+    isom_chpl_t *chpl = (isom_chpl_t *)box;
+    if( chpl->version == 1 )
+        isom_json_field_uint( stream, "unknown", chpl->unknown );
+    if( !chpl->list )
+        return;
+    isom_json_field_uint( stream, "entry_count", chpl->list->entry_count );
+    /* [ start_time, chapter_name ] */
+    isom_json_key( stream, "entries" );
+    isom_json_begin( stream, '[' );
+    for( lsmash_entry_t *entry = chpl->list->head; entry; entry = entry->next )
+    {
+        isom_chpl_entry_t *data = (isom_chpl_entry_t *)entry->data;
+        isom_json_separate( stream );
+        isom_json_begin( stream, '[' );
+        isom_json_element_uint( stream, data->start_time );
+        isom_json_element_string( stream, data->chapter_name ? data->chapter_name : "", data->chapter_name ? data->chapter_name_length : 0 );
+        isom_json_end( stream, ']' );
+    }
+    isom_json_end( stream, ']' );
+}
+
+static void isom_json_keys( isom_print_stream_t *stream, lsmash_file_t *file, isom_box_t *box )
+{
+    isom_keys_t *keys = (isom_keys_t *)box;
+    if( !keys->list )
+        return;
+    isom_json_field_uint( stream, "entry_count", keys->list->entry_count );
+    /* [ key_size, key_namespace, key_value ] */
+    isom_json_key( stream, "entries" );
+    isom_json_begin( stream, '[' );
+    for( lsmash_entry_t *entry = keys->list->head; entry; entry = entry->next )
+    {
+        isom_keys_entry_t *data = (isom_keys_entry_t *)entry->data;
+        isom_json_separate( stream );
+        isom_json_begin( stream, '[' );
+        isom_json_element_uint( stream, data->key_size );
+        isom_json_separate( stream );
+        isom_json_put_fourcc( stream, data->key_namespace );
+        isom_json_element_string( stream, (const char *)data->key_value, data->key_size > 8 ? data->key_size - 8 : 0 );
+        isom_json_end( stream, ']' );
+    }
+    isom_json_end( stream, ']' );
+}
+
+static void isom_json_metaitem( isom_print_stream_t *stream, lsmash_file_t *file, isom_box_t *box )
+{
+    /* The box type of a metadata item in QuickTime file format is the index of its key. */
+    if( box->parent && box->parent->parent && (box->parent->parent->manager & LSMASH_QTFF_BASE) )
+        isom_json_field_uint( stream, "key_index", box->type.fourcc );
+}
+
+static void isom_json_name( isom_print_stream_t *stream, lsmash_file_t *file, isom_box_t *box )
+{
+    isom_name_t *name = (isom_name_t *)box;
+    isom_json_field_string( stream, "name", name->name ? (const char *)name->name : "", name->name ? name->name_length : 0 );
+}
+
+static void isom_json_mean( isom_print_stream_t *stream, lsmash_file_t *file, isom_box_t *box )
+{
+    isom_mean_t *mean = (isom_mean_t *)box;
+    isom_json_field_string( stream, "meaning_string", mean->meaning_string ? (const char *)mean->meaning_string : "",
+                            mean->meaning_string ? mean->meaning_string_length : 0 );
+}
+
+static void isom_json_data( isom_print_stream_t *stream, lsmash_file_t *file, isom_box_t *box )
+{
+    isom_data_t *data = (isom_data_t *)box;
+    int is_text;
+    if( box->parent && box->parent->parent && box->parent->parent->parent
+     && (box->parent->parent->parent->manager & LSMASH_QTFF_BASE) )
+    {
+        uint32_t well_known_type = ((data->reserved << 16) | (data->type_set_identifier << 8) | data->type_code) & 0xffffff;
+        isom_json_field_uint( stream, "type_set_indicator", data->reserved >> 8 );
+        isom_json_field_uint( stream, "well_known_type", well_known_type );
+        isom_json_field_uint( stream, "locale_indicator", data->the_locale );
+        is_text = (well_known_type == 1);
+    }
+    else
+    {
+        isom_json_field_uint( stream, "type_set_identifier", data->type_set_identifier );
+        isom_json_field_uint( stream, "type_code", data->type_code );
+        isom_json_field_uint( stream, "the_locale", data->the_locale );
+        is_text = (data->type_code == 1);
+    }
+    /* A UTF-8 value is put as a string, and any other value as binary data. */
+    if( !data->value )
+        return;
+    if( is_text )
+        isom_json_field_string( stream, "value", (const char *)data->value, data->value_length );
+    else
+        isom_json_field_bytes( stream, "value", data->value, data->value_length );
+}
+
+static void isom_json_WLOC( isom_print_stream_t *stream, lsmash_file_t *file, isom_box_t *box )
+{
+    isom_WLOC_t *WLOC = (isom_WLOC_t *)box;
+    isom_json_field_uint( stream, "x", WLOC->x );
+    isom_json_field_uint( stream, "y", WLOC->y );
+}
+
+static void isom_json_LOOP( isom_print_stream_t *stream, lsmash_file_t *file, isom_box_t *box )
+{
+    isom_json_field_uint( stream, "looping_mode", ((isom_LOOP_t *)box)->looping_mode );
+}
+
+static void isom_json_SelO( isom_print_stream_t *stream, lsmash_file_t *file, isom_box_t *box )
+{
+    isom_json_field_uint( stream, "selection_only", ((isom_SelO_t *)box)->selection_only );
+}
+
+static void isom_json_AllF( isom_print_stream_t *stream, lsmash_file_t *file, isom_box_t *box )
+{
+    isom_json_field_uint( stream, "play_all_frames", ((isom_AllF_t *)box)->play_all_frames );
+}
+
+static void isom_json_cprt( isom_print_stream_t *stream, lsmash_file_t *file, isom_box_t *box )
+{
+    isom_cprt_t *cprt = (isom_cprt_t *)box;
+    isom_json_field_string( stream, "language", isom_unpack_iso_language( (char [4]){ 0 }, cprt->language ), 3 );
+    /* The notice is either in UTF-8 or UTF-16, so only the null terminator at the end is dropped. */
+    uint32_t length = cprt->notice ? cprt->notice_length : 0;
+    if( length && !cprt->notice[length - 1] )
+        --length;
+    isom_json_field_string( stream, "notice", cprt->notice ? (const char *)cprt->notice : "", length );
+}
+
+static void isom_json_mehd( isom_print_stream_t *stream, lsmash_file_t *file, isom_box_t *box )
+{
+    isom_json_field_uint( stream, "fragment_duration", ((isom_mehd_t *)box)->fragment_duration );
+}
+
+static void isom_json_trex( isom_print_stream_t *stream, lsmash_file_t *file, isom_box_t *box )
+{
+    isom_trex_t *trex = (isom_trex_t *)box;
+    isom_json_field_uint( stream, "track_ID", trex->track_ID );
+    isom_json_field_uint( stream, "default_sample_description_index", trex->default_sample_description_index );
+    isom_json_field_uint( stream, "default_sample_duration", trex->default_sample_duration );
+    isom_json_field_uint( stream, "default_sample_size", trex->default_sample_size );
+    isom_json_field_uint( stream, "default_sample_flags", isom_json_sample_flags( &trex->default_sample_flags ) );
+}
+
+static void isom_json_mfhd( isom_print_stream_t *stream, lsmash_file_t *file, isom_box_t *box )
+{
+    isom_json_field_uint( stream, "sequence_number", ((isom_mfhd_t *)box)->sequence_number );
+}
+
+static void isom_json_tfhd( isom_print_stream_t *stream, lsmash_file_t *file, isom_box_t *box )
+{
+    isom_tfhd_t *tfhd = (isom_tfhd_t *)box;
+    isom_json_field_uint( stream, "track_ID", tfhd->track_ID );
+    if( tfhd->flags & ISOM_TF_FLAGS_BASE_DATA_OFFSET_PRESENT )
+        isom_json_field_uint( stream, "base_data_offset", tfhd->base_data_offset );
+    if( tfhd->flags & ISOM_TF_FLAGS_SAMPLE_DESCRIPTION_INDEX_PRESENT )
+        isom_json_field_uint( stream, "sample_description_index", tfhd->sample_description_index );
+    if( tfhd->flags & ISOM_TF_FLAGS_DEFAULT_SAMPLE_DURATION_PRESENT )
+        isom_json_field_uint( stream, "default_sample_duration", tfhd->default_sample_duration );
+    if( tfhd->flags & ISOM_TF_FLAGS_DEFAULT_SAMPLE_SIZE_PRESENT )
+        isom_json_field_uint( stream, "default_sample_size", tfhd->default_sample_size );
+    if( tfhd->flags & ISOM_TF_FLAGS_DEFAULT_SAMPLE_FLAGS_PRESENT )
+        isom_json_field_uint( stream, "default_sample_flags", isom_json_sample_flags( &tfhd->default_sample_flags ) );
+}
+
+static void isom_json_tfdt( isom_print_stream_t *stream, lsmash_file_t *file, isom_box_t *box )
+{
+    isom_json_field_uint( stream, "baseMediaDecodeTime", ((isom_tfdt_t *)box)->baseMediaDecodeTime );
+}
+
+static void isom_json_trun( isom_print_stream_t *stream, lsmash_file_t *file, isom_box_t *box )
+{
+    isom_trun_t *trun = (isom_trun_t *)box;
+    isom_json_field_uint( stream, "sample_count", trun->sample_count );
+    if( trun->flags & ISOM_TR_FLAGS_DATA_OFFSET_PRESENT )
+        isom_json_field_int( stream, "data_offset", trun->data_offset );
+    if( trun->flags & ISOM_TR_FLAGS_FIRST_SAMPLE_FLAGS_PRESENT )
+        isom_json_field_uint( stream, "first_sample_flags", isom_json_sample_flags( &trun->first_sample_flags ) );
+    if( !trun->optional )
+        return;
+    /* Each present field is put as an array column by column. */
+    static const struct
+    {
+        uint32_t    flag;
+        const char *name;
+    } columns[4] =
+        {
+            { ISOM_TR_FLAGS_SAMPLE_DURATION_PRESENT,                "sample_duration" },
+            { ISOM_TR_FLAGS_SAMPLE_SIZE_PRESENT,                    "sample_size" },
+            { ISOM_TR_FLAGS_SAMPLE_FLAGS_PRESENT,                   "sample_flags" },
+            { ISOM_TR_FLAGS_SAMPLE_COMPOSITION_TIME_OFFSET_PRESENT, "sample_composition_time_offset" }
+        };
+    for( int column = 0; column < 4; column++ )
+    {
+        if( !(trun->flags & columns[column].flag) )
+            continue;
+        isom_json_key( stream, columns[column].name );
+        isom_json_begin( stream, '[' );
+        uint32_t i = 0;
+        for( lsmash_entry_t *entry = trun->optional->head; entry && !isom_json_omit_entries( stream, i ); entry = entry->next, i++ )
+        {
+            isom_trun_optional_row_t *row = (isom_trun_optional_row_t *)entry->data;
+            switch( column )
+            {
+                case 0 :
+                    isom_json_element_uint( stream, row->sample_duration );
+                    break;
+                case 1 :
+                    isom_json_element_uint( stream, row->sample_size );
+                    break;
+                case 2 :
+                    isom_json_element_uint( stream, isom_json_sample_flags( &row->sample_flags ) );
+                    break;
+                default :
+                    if( trun->version == 0 )
+                        isom_json_element_uint( stream, row->sample_composition_time_offset );
+                    else
+                        isom_json_element_int( stream, (union {uint32_t ui; int32_t si;}){ row->sample_composition_time_offset }.si );
+                    break;
+            }
+        }
+        isom_json_end( stream, ']' );
+    }
+}
+
+static void isom_json_tfra( isom_print_stream_t *stream, lsmash_file_t *file, isom_box_t *box )
+{
+    isom_tfra_t *tfra = (isom_tfra_t *)box;
+    isom_json_field_uint( stream, "track_ID", tfra->track_ID );
+    isom_json_field_uint( stream, "length_size_of_traf_num", tfra->length_size_of_traf_num );
+    isom_json_field_uint( stream, "length_size_of_trun_num", tfra->length_size_of_trun_num );
+    isom_json_field_uint( stream, "length_size_of_sample_num", tfra->length_size_of_sample_num );
+    isom_json_field_uint( stream, "number_of_entry", tfra->number_of_entry );
+    if( !tfra->list )
+        return;
+    /* [ time, moof_offset, traf_number, trun_number, sample_number ] */
+    isom_json_key( stream, "entries" );
+    isom_json_begin( stream, '[' );
+    uint32_t i = 0;
+    for( lsmash_entry_t *entry = tfra->list->head; entry && !isom_json_omit_entries( stream, i ); entry = entry->next, i++ )
+    {
+        isom_tfra_location_time_entry_t *data = (isom_tfra_location_time_entry_t *)entry->data;
+        isom_json_separate( stream );
+        isom_json_begin( stream, '[' );
+        isom_json_element_uint( stream, data->time );
+        isom_json_element_uint( stream, data->moof_offset );
+        isom_json_element_uint( stream, data->traf_number );
+        isom_json_element_uint( stream, data->trun_number );
+        isom_json_element_uint( stream, data->sample_number );
+        isom_json_end( stream, ']' );
+    }
+    isom_json_end( stream, ']' );
+}
+
+static void isom_json_mfro( isom_print_stream_t *stream, lsmash_file_t *file, isom_box_t *box )
+{
+    isom_json_field_uint( stream, "length", ((isom_mfro_t *)box)->length );
+}
+
+extern void mp4sys_json_codec_specific( isom_print_stream_t *, lsmash_file_t *, isom_box_t * );
+extern void h264_json_codec_specific( isom_print_stream_t *, lsmash_file_t *, isom_box_t * );
+extern void hevc_json_codec_specific( isom_print_stream_t *, lsmash_file_t *, isom_box_t * );
+extern void h264_json_bitrate( isom_print_stream_t *, lsmash_file_t *, isom_box_t * );
+extern void vc1_json_codec_specific( isom_print_stream_t *, lsmash_file_t *, isom_box_t * );
+extern void ac3_json_codec_specific( isom_print_stream_t *, lsmash_file_t *, isom_box_t * );
+extern void eac3_json_codec_specific( isom_print_stream_t *, lsmash_file_t *, isom_box_t * );
+extern void dts_json_codec_specific( isom_print_stream_t *, lsmash_file_t *, isom_box_t * );
+extern void alac_json_codec_specific( isom_print_stream_t *, lsmash_file_t *, isom_box_t * );
+extern void wma_json_codec_specific( isom_print_stream_t *, lsmash_file_t *, isom_box_t * );
+
+/* Containers and boxes without any field of their own are put with the common fields only. */
+static isom_print_json_t isom_select_json_func( isom_print_box_t func )
+{
+    static const struct
+    {
+        isom_print_box_t  print_func;
+        isom_print_json_t json_func;
+    } json_table[] =
+        {
+            { isom_print_ftyp,                 isom_json_ftyp },
+            { isom_print_styp,                 isom_json_styp },
+            { isom_print_sidx,                 isom_json_sidx },
+            { isom_print_mvhd,                 isom_json_mvhd },
+            { isom_print_ctab,                 isom_json_ctab },
+            { isom_print_iods,                 isom_json_iods },
+            { isom_print_tkhd,                 isom_json_tkhd },
+            { isom_print_clef,                 isom_json_clef },
+            { isom_print_prof,                 isom_json_clef },
+            { isom_print_enof,                 isom_json_clef },
+            { isom_print_elst,                 isom_json_elst },
+            { isom_print_track_reference_type, isom_json_track_reference_type },
+            { isom_print_mdhd,                 isom_json_mdhd },
+            { isom_print_hdlr,                 isom_json_hdlr },
+            { isom_print_vmhd,                 isom_json_vmhd },
+            { isom_print_smhd,                 isom_json_smhd },
+            { isom_print_hmhd,                 isom_json_hmhd },
+            { isom_print_gmin,                 isom_json_gmin },
+            { isom_print_text,                 isom_json_text },
+            { isom_print_dref,                 isom_json_dref },
+            { isom_print_url,                  isom_json_url },
+            { isom_print_stsd,                 isom_json_stsd },
+            { isom_print_visual_description,   isom_json_visual_description },
+            { isom_print_glbl,                 isom_json_glbl },
+            { isom_print_clap,                 isom_json_clap },
+            { isom_print_pasp,                 isom_json_pasp },
+            { isom_print_colr,                 isom_json_colr },
+            { isom_print_gama,                 isom_json_gama },
+            { isom_print_fiel,                 isom_json_fiel },
+            { isom_print_cspc,                 isom_json_cspc },
+            { isom_print_sgbt,                 isom_json_sgbt },
+            { isom_print_stsl,                 isom_json_stsl },
+            { isom_print_audio_description,    isom_json_audio_description },
+            { isom_print_frma,                 isom_json_frma },
+            { isom_print_enda,                 isom_json_enda },
+            { isom_print_chan,                 isom_json_chan },
+            { isom_print_srat,                 isom_json_srat },
+            { isom_print_text_description,     isom_json_text_description },
+            { isom_print_tx3g_description,     isom_json_tx3g_description },
+            { isom_print_ftab,                 isom_json_ftab },
+            { isom_print_mp4s_description,     isom_json_mp4s_description },
+            { mp4sys_print_codec_specific,     mp4sys_json_codec_specific },
+            { h264_print_codec_specific,       h264_json_codec_specific },
+            { h264_print_bitrate,              h264_json_bitrate },
+            { hevc_print_codec_specific,       hevc_json_codec_specific },
+            { vc1_print_codec_specific,        vc1_json_codec_specific },
+            { ac3_print_codec_specific,        ac3_json_codec_specific },
+            { eac3_print_codec_specific,       eac3_json_codec_specific },
+            { dts_print_codec_specific,        dts_json_codec_specific },
+            { alac_print_codec_specific,       alac_json_codec_specific },
+            { wma_print_codec_specific,        wma_json_codec_specific },
+            { isom_print_stts,                 isom_json_stts },
+            { isom_print_ctts,                 isom_json_ctts },
+            { isom_print_cslg,                 isom_json_cslg },
+            { isom_print_stss,                 isom_json_stss },
+            { isom_print_stps,                 isom_json_stps },
+            { isom_print_sdtp,                 isom_json_sdtp },
+            { isom_print_stsc,                 isom_json_stsc },
+            { isom_print_stsz,                 isom_json_stsz },
+            { isom_print_stco,                 isom_json_stco },
+            { isom_print_sgpd,                 isom_json_sgpd },
+            { isom_print_sbgp,                 isom_json_sbgp },
+            { isom_print_chpl,                 isom_json_chpl },
+            { isom_print_keys,                 isom_json_keys },
+            { isom_print_metaitem,             isom_json_metaitem },
+            { isom_print_name,                 isom_json_name },
+            { isom_print_mean,                 isom_json_mean },
+            { isom_print_data,                 isom_json_data },
+            { isom_print_WLOC,                 isom_json_WLOC },
+            { isom_print_LOOP,                 isom_json_LOOP },
+            { isom_print_SelO,                 isom_json_SelO },
+            { isom_print_AllF,                 isom_json_AllF },
+            { isom_print_cprt,                 isom_json_cprt },
+            { isom_print_mehd,                 isom_json_mehd },
+            { isom_print_trex,                 isom_json_trex },
+            { isom_print_mfhd,                 isom_json_mfhd },
+            { isom_print_tfhd,                 isom_json_tfhd },
+            { isom_print_tfdt,                 isom_json_tfdt },
+            { isom_print_trun,                 isom_json_trun },
+            { isom_print_tfra,                 isom_json_tfra },
+            { isom_print_mfro,                 isom_json_mfro },
+            { NULL, NULL }
+        };
+    for( int i = 0; json_table[i].print_func; i++ )
+        if( func == json_table[i].print_func )
+            return json_table[i].json_func;
+    return NULL;
+}
+
+static void isom_json_box_common( isom_print_stream_t *stream, isom_box_t *box, int level, isom_print_box_t func )
+{
+    if( stream->format == LSMASH_PRINT_FORMAT_JSON )
+        isom_json_separate( stream );
+    isom_json_begin( stream, '{' );
+    isom_json_field_fourcc( stream, "type", box->type.fourcc );
+    if( box->type.fourcc == ISOM_BOX_TYPE_UUID.fourcc )
+    {
+        static const char hex[16] = "0123456789abcdef";
+        char usertype[32];
+        uint32_t fourcc = box->type.user.fourcc;
+        for( int i = 0; i < 8; i++ )
+            usertype[i] = hex[(fourcc >> (28 - 4 * i)) & 0xf];
+        for( int i = 0; i < 12; i++ )
+        {
+            usertype[8 + 2 * i    ] = hex[box->type.user.id[i] >> 4];
+            usertype[8 + 2 * i + 1] = hex[box->type.user.id[i] & 0xf];
+        }
+        isom_json_key( stream, "usertype" );
+        isom_json_put_string( stream, usertype, 32 );
+    }
+    if( stream->format == LSMASH_PRINT_FORMAT_NDJSON )
+        isom_json_field_int( stream, "level", level );
+    isom_json_field_uint( stream, "position", box->pos );
+    isom_json_field_uint( stream, "size", box->size );
+    if( func != isom_print_unknown
+     && !(box->parent && lsmash_check_box_type_identical( box->parent->type, ISOM_BOX_TYPE_STSD ))
+     && isom_is_fullbox( box ) )
+    {
+        isom_json_field_uint( stream, "version", box->version );
+        isom_json_field_uint( stream, "flags", box->flags & 0x00ffffff );
+    }
+}
+
+/* Close the boxes whose children do not include a box at the given level. */
+static void isom_json_close_boxes( isom_print_stream_t *stream, int level )
+{
+    while( stream->open_count && stream->open_level[ stream->open_count - 1 ] >= level )
+    {
+        isom_json_end( stream, ']' );
+        isom_json_end( stream, '}' );
+        --stream->open_count;
+    }
+}
+
+static int isom_print_json( isom_print_stream_t *stream, lsmash_file_t *file, isom_box_t *box, int level, isom_print_box_t func )
+{
+    if( stream->format == LSMASH_PRINT_FORMAT_JSON )
+        isom_json_close_boxes( stream, level );
+    if( func == isom_print_sample_description_extesion )
+        func = isom_select_description_extension_print_func( box );
+    isom_json_box_common( stream, box, level, func );
+    isom_print_json_t json_func = isom_select_json_func( func );
+    if( json_func )
+        json_func( stream, file, box );
+    if( stream->format == LSMASH_PRINT_FORMAT_NDJSON )
+    {
+        isom_json_end( stream, '}' );
+        isom_json_putc( stream, '\n' );
+        return 0;
+    }
+    /* Leave this box open until a box at the same or lower level appears. */
+    if( stream->open_count == stream->open_alloc )
+    {
+        int  alloc      = stream->open_alloc ? 2 * stream->open_alloc : 16;
+        int *open_level = lsmash_realloc( stream->open_level, alloc * sizeof(int) );
+        if( !open_level )
+            return LSMASH_ERR_MEMORY_ALLOC;
+        stream->open_level = open_level;
+        stream->open_alloc = alloc;
+    }
+    stream->open_level[ stream->open_count++ ] = level;
+    isom_json_key( stream, "children" );
+    isom_json_begin( stream, '[' );
+    return 0;
+}
+
+static void isom_remove_print_stream( isom_print_stream_t *stream )
+{
+    if( !stream )
+        return;
+    if( stream->fp == stdout )
+        fflush( stdout );
+    else if( stream->fp )
+        fclose( stream->fp );
+    lsmash_free( stream->buffer );
+    lsmash_free( stream->json );
+    lsmash_free( stream->open_level );
+    lsmash_free( stream->types );
+    lsmash_free( stream );
+}
+
+static int isom_check_print_parameters( lsmash_print_parameters_t *param )
+{
+    if( param
+     && (param->max_depth < 0
+      || (param->type_count && !param->types)
+      || (param->format != LSMASH_PRINT_FORMAT_TEXT
+       && param->format != LSMASH_PRINT_FORMAT_JSON
+       && param->format != LSMASH_PRINT_FORMAT_NDJSON)) )
+        return LSMASH_ERR_FUNCTION_PARAM;
+    return 0;
+}
+
+static int isom_create_print_stream( isom_print_stream_t **stream_p, const char *filename, lsmash_print_parameters_t *param )
+{
+    isom_print_stream_t *stream = lsmash_malloc_zero( sizeof(isom_print_stream_t) );
+    if( !stream )
+        return LSMASH_ERR_MEMORY_ALLOC;
+    int err;
+    if( param )
+    {
+        stream->format      = param->format;
+        stream->max_depth   = param->max_depth;
+        stream->max_entries = param->max_entries;
+        if( param->type_count )
+        {
+            stream->types = lsmash_memdup( param->types, param->type_count * sizeof(lsmash_compact_box_type_t) );
+            if( !stream->types )
+            {
+                err = LSMASH_ERR_MEMORY_ALLOC;
+                goto fail;
+            }
+            stream->type_count = param->type_count;
+        }
+    }
+    if( stream->format != LSMASH_PRINT_FORMAT_TEXT )
+    {
+        stream->json = lsmash_malloc( PRINT_JSON_BUFFER_SIZE );
+        if( !stream->json )
+        {
+            err = LSMASH_ERR_MEMORY_ALLOC;
+            goto fail;
+        }
+    }
+    if( !strcmp( filename, "-" ) )
+        /* The buffer for stdout is left to the C library since stdout outlives this file. */
+        stream->fp = stdout;
+    else
+    {
+        stream->fp = lsmash_fopen( filename, "wb" );
+        if( !stream->fp )
+        {
+            err = LSMASH_ERR_NAMELESS;
+            goto fail;
+        }
+        stream->buffer = lsmash_malloc( PRINT_STREAM_BUFFER_SIZE );
+    }
+    setvbuf( stream->fp, stream->buffer, _IOFBF, PRINT_STREAM_BUFFER_SIZE );
+    *stream_p = stream;
+    return 0;
+fail:
+    isom_remove_print_stream( stream );
+    return err;
+}
+
+static void isom_print_stream_header( isom_print_stream_t *stream, int size_known, uint64_t size )
+{
+    if( stream->format == LSMASH_PRINT_FORMAT_TEXT )
+    {
+        fprintf( stream->fp, "[File]\n" );
+        if( size_known )
+            fprintf( stream->fp, "    size = %"PRIu64"\n", size );
+        return;
+    }
+    isom_json_begin( stream, '{' );
+    isom_json_key( stream, "type" );
+    isom_json_put_string( stream, "file", 4 );
+    if( stream->format == LSMASH_PRINT_FORMAT_NDJSON )
+        isom_json_field_int( stream, "level", 0 );
+    if( size_known )
+        isom_json_field_uint( stream, "size", size );
+    if( stream->format == LSMASH_PRINT_FORMAT_NDJSON )
+    {
+        isom_json_end( stream, '}' );
+        isom_json_putc( stream, '\n' );
+    }
+    else
+    {
+        isom_json_key( stream, "children" );
+        isom_json_begin( stream, '[' );
+    }
+}
+
+static int isom_print_stream_footer( isom_print_stream_t *stream )
+{
+    if( stream->format != LSMASH_PRINT_FORMAT_TEXT )
+    {
+        if( stream->format == LSMASH_PRINT_FORMAT_JSON )
+        {
+            isom_json_close_boxes( stream, 0 );
+            isom_json_write( stream, "]}\n", 3 );
+        }
+        isom_json_flush( stream );
+    }
+    return fflush( stream->fp ) ? LSMASH_ERR_NAMELESS : 0;
+}
+
+static int isom_print_stream_select_box( isom_print_stream_t *stream, isom_box_t *box, int level )
+{
+    if( stream->max_depth && level > stream->max_depth )
+        return 0;
+    if( !stream->types )
+        return 1;
+    for( uint32_t i = 0; i < stream->type_count; i++ )
+        if( box->type.fourcc == stream->types[i] )
+            return 1;
+    return 0;
+}
+
+static int isom_print_stream_box( lsmash_file_t *file, isom_print_stream_t *stream, isom_box_t *box, int level, isom_print_box_t func )
+{
+    int ret = 0;
+    if( isom_print_stream_select_box( stream, box, level ) )
+    {
+        if( stream->format == LSMASH_PRINT_FORMAT_TEXT )
+            ret = func( stream->fp, file, box, level );
+        else
+            ret = isom_print_json( stream, file, box, level, func );
+    }
+    ++stream->box_count;
+    return ret;
+}
+
+int lsmash_print_movie_with_parameters( lsmash_root_t *root, const char *filename, lsmash_print_parameters_t *param )
+{
+    if( !root || !filename )
+        return LSMASH_ERR_FUNCTION_PARAM;
+    lsmash_file_t *file = root->file;
+    if( !file
+     || !file->print
+     || file->print_stream
+     || !(file->flags & LSMASH_FILE_MODE_DUMP)
+     || isom_check_print_parameters( param ) < 0 )
+        return LSMASH_ERR_FUNCTION_PARAM;
+    isom_print_stream_t *stream;
+    int err = isom_create_print_stream( &stream, filename, param );
+    if( err < 0 )
+        return err;
+    /* Attach the stream to the file while printing so that the limits are applied to tables. */
+    file->print_stream = stream;
+    isom_print_stream_header( stream, 1, file->size );
+    for( lsmash_entry_t *entry = file->print->head; entry; entry = entry->next )
+    {
+        isom_print_entry_t *data = (isom_print_entry_t *)entry->data;
+        if( !data || !data->box )
+        {
+            err = LSMASH_ERR_NAMELESS;
+            goto fail;
+        }
+        err = isom_print_stream_box( file, stream, data->box, data->level, data->func );
+        if( err < 0 )
+            goto fail;
+    }
+    err = isom_print_stream_footer( stream );
+fail:
+    file->print_stream = NULL;
+    isom_remove_print_stream( stream );
+    return err;
+}
+
+int lsmash_print_movie( lsmash_root_t *root, const char *filename )
+{
+    return lsmash_print_movie_with_parameters( root, filename, NULL );
+}
+
+int lsmash_print_movie_while_reading( lsmash_file_t *file, const char *filename, lsmash_print_parameters_t *param )
+{
+    if( !file
+     || !filename
+     || file->print
+     || file->print_stream
+     || !(file->flags & LSMASH_FILE_MODE_DUMP)
+     || isom_check_print_parameters( param ) < 0 )
+        return LSMASH_ERR_FUNCTION_PARAM;
+    return isom_create_print_stream( &file->print_stream, filename, param );
+}
+
+static struct print_box_table_tag
+{
+    lsmash_box_type_t type;
+    isom_print_box_t  func;
+} print_box_table[128] = { { LSMASH_BOX_TYPE_INITIALIZER, NULL } };
+static lsmash_once_t print_box_table_once = LSMASH_ONCE_INIT;
+
+static void isom_init_print_box_table( void )
+{
+    int i = 0;
+#define ADD_PRINT_BOX_TABLE_ELEMENT( type, func ) print_box_table[i++] = (struct print_box_table_tag){ type, func }
+    ADD_PRINT_BOX_TABLE_ELEMENT( ISOM_BOX_TYPE_FTYP, isom_print_ftyp );
+    ADD_PRINT_BOX_TABLE_ELEMENT( ISOM_BOX_TYPE_STYP, isom_print_styp );
+    ADD_PRINT_BOX_TABLE_ELEMENT( ISOM_BOX_TYPE_SIDX, isom_print_sidx );
+    ADD_PRINT_BOX_TABLE_ELEMENT( ISOM_BOX_TYPE_MOOV, isom_print_moov );
+    ADD_PRINT_BOX_TABLE_ELEMENT( ISOM_BOX_TYPE_MVHD, isom_print_mvhd );
+    ADD_PRINT_BOX_TABLE_ELEMENT( ISOM_BOX_TYPE_IODS, isom_print_iods );
+    ADD_PRINT_BOX_TABLE_ELEMENT(   QT_BOX_TYPE_CTAB, isom_print_ctab );
+    ADD_PRINT_BOX_TABLE_ELEMENT( ISOM_BOX_TYPE_TRAK, isom_print_trak );
+    ADD_PRINT_BOX_TABLE_ELEMENT( ISOM_BOX_TYPE_TKHD, isom_print_tkhd );
+    ADD_PRINT_BOX_TABLE_ELEMENT(   QT_BOX_TYPE_TAPT, isom_print_tapt );
+    ADD_PRINT_BOX_TABLE_ELEMENT(   QT_BOX_TYPE_CLEF, isom_print_clef );
+    ADD_PRINT_BOX_TABLE_ELEMENT(   QT_BOX_TYPE_PROF, isom_print_prof );
+    ADD_PRINT_BOX_TABLE_ELEMENT(   QT_BOX_TYPE_ENOF, isom_print_enof );
+    ADD_PRINT_BOX_TABLE_ELEMENT( ISOM_BOX_TYPE_EDTS, isom_print_edts );
+    ADD_PRINT_BOX_TABLE_ELEMENT( ISOM_BOX_TYPE_ELST, isom_print_elst );
+    ADD_PRINT_BOX_TABLE_ELEMENT( ISOM_BOX_TYPE_TREF, isom_print_tref );
+    ADD_PRINT_BOX_TABLE_ELEMENT( ISOM_BOX_TYPE_MDIA, isom_print_mdia );
+    ADD_PRINT_BOX_TABLE_ELEMENT( ISOM_BOX_TYPE_MDHD, isom_print_mdhd );
+    ADD_PRINT_BOX_TABLE_ELEMENT( ISOM_BOX_TYPE_HDLR, isom_print_hdlr );
+    ADD_PRINT_BOX_TABLE_ELEMENT( ISOM_BOX_TYPE_MINF, isom_print_minf );
+    ADD_PRINT_BOX_TABLE_ELEMENT( ISOM_BOX_TYPE_VMHD, isom_print_vmhd );
+    ADD_PRINT_BOX_TABLE_ELEMENT( ISOM_BOX_TYPE_SMHD, isom_print_smhd );
+    ADD_PRINT_BOX_TABLE_ELEMENT( ISOM_BOX_TYPE_HMHD, isom_print_hmhd );
+    ADD_PRINT_BOX_TABLE_ELEMENT( ISOM_BOX_TYPE_NMHD, isom_print_nmhd );
+    ADD_PRINT_BOX_TABLE_ELEMENT(   QT_BOX_TYPE_GMHD, isom_print_gmhd );
+    ADD_PRINT_BOX_TABLE_ELEMENT(   QT_BOX_TYPE_GMIN, isom_print_gmin );
+    ADD_PRINT_BOX_TABLE_ELEMENT(   QT_BOX_TYPE_TEXT, isom_print_text );
+    ADD_PRINT_BOX_TABLE_ELEMENT( ISOM_BOX_TYPE_DINF, isom_print_dinf );
+    ADD_PRINT_BOX_TABLE_ELEMENT( ISOM_BOX_TYPE_DREF, isom_print_dref );
+    ADD_PRINT_BOX_TABLE_ELEMENT( ISOM_BOX_TYPE_URL,  isom_print_url );
+    ADD_PRINT_BOX_TABLE_ELEMENT( ISOM_BOX_TYPE_STBL, isom_print_stbl );
+    ADD_PRINT_BOX_TABLE_ELEMENT( ISOM_BOX_TYPE_STSD, isom_print_stsd );
+    ADD_PRINT_BOX_TABLE_ELEMENT( ISOM_BOX_TYPE_CLAP, isom_print_clap );
+    ADD_PRINT_BOX_TABLE_ELEMENT( ISOM_BOX_TYPE_PASP, isom_print_pasp );
+    ADD_PRINT_BOX_TABLE_ELEMENT( ISOM_BOX_TYPE_COLR, isom_print_colr );
+    ADD_PRINT_BOX_TABLE_ELEMENT(   QT_BOX_TYPE_COLR, isom_print_colr );
+    ADD_PRINT_BOX_TABLE_ELEMENT(   QT_BOX_TYPE_GLBL, isom_print_glbl );
+    ADD_PRINT_BOX_TABLE_ELEMENT(   QT_BOX_TYPE_GAMA, isom_print_gama );
+    ADD_PRINT_BOX_TABLE_ELEMENT(   QT_BOX_TYPE_FIEL, isom_print_fiel );
+    ADD_PRINT_BOX_TABLE_ELEMENT(   QT_BOX_TYPE_CSPC, isom_print_cspc );
+    ADD_PRINT_BOX_TABLE_ELEMENT(   QT_BOX_TYPE_SGBT, isom_print_sgbt );
+    ADD_PRINT_BOX_TABLE_ELEMENT( ISOM_BOX_TYPE_STSL, isom_print_stsl );
+    ADD_PRINT_BOX_TABLE_ELEMENT(   QT_BOX_TYPE_WAVE, isom_print_wave );
+    ADD_PRINT_BOX_TABLE_ELEMENT(   QT_BOX_TYPE_CHAN, isom_print_chan );
+    ADD_PRINT_BOX_TABLE_ELEMENT( ISOM_BOX_TYPE_SRAT, isom_print_srat );
+    ADD_PRINT_BOX_TABLE_ELEMENT( ISOM_BOX_TYPE_FTAB, isom_print_ftab );
+    ADD_PRINT_BOX_TABLE_ELEMENT( ISOM_BOX_TYPE_STTS, isom_print_stts );
+    ADD_PRINT_BOX_TABLE_ELEMENT( ISOM_BOX_TYPE_CTTS, isom_print_ctts );
+    ADD_PRINT_BOX_TABLE_ELEMENT( ISOM_BOX_TYPE_CSLG, isom_print_cslg );
+    ADD_PRINT_BOX_TABLE_ELEMENT( ISOM_BOX_TYPE_STSS, isom_print_stss );
+    ADD_PRINT_BOX_TABLE_ELEMENT(   QT_BOX_TYPE_STPS, isom_print_stps );
+    ADD_PRINT_BOX_TABLE_ELEMENT( ISOM_BOX_TYPE_SDTP, isom_print_sdtp );
+    ADD_PRINT_BOX_TABLE_ELEMENT( ISOM_BOX_TYPE_STSC, isom_print_stsc );
+    ADD_PRINT_BOX_TABLE_ELEMENT( ISOM_BOX_TYPE_STSZ, isom_print_stsz );
+    ADD_PRINT_BOX_TABLE_ELEMENT( ISOM_BOX_TYPE_STCO, isom_print_stco );
+    ADD_PRINT_BOX_TABLE_ELEMENT( ISOM_BOX_TYPE_CO64, isom_print_stco );
+    ADD_PRINT_BOX_TABLE_ELEMENT( ISOM_BOX_TYPE_SGPD, isom_print_sgpd );
+    ADD_PRINT_BOX_TABLE_ELEMENT( ISOM_BOX_TYPE_SBGP, isom_print_sbgp );
+    ADD_PRINT_BOX_TABLE_ELEMENT( ISOM_BOX_TYPE_UDTA, isom_print_udta );
+    ADD_PRINT_BOX_TABLE_ELEMENT( ISOM_BOX_TYPE_CHPL, isom_print_chpl );
+    ADD_PRINT_BOX_TABLE_ELEMENT(   QT_BOX_TYPE_WLOC, isom_print_WLOC );
+    ADD_PRINT_BOX_TABLE_ELEMENT(   QT_BOX_TYPE_LOOP, isom_print_LOOP );
+    ADD_PRINT_BOX_TABLE_ELEMENT(   QT_BOX_TYPE_SELO, isom_print_SelO );
+    ADD_PRINT_BOX_TABLE_ELEMENT(   QT_BOX_TYPE_ALLF, isom_print_AllF );
+    ADD_PRINT_BOX_TABLE_ELEMENT( ISOM_BOX_TYPE_CPRT, isom_print_cprt );
+    ADD_PRINT_BOX_TABLE_ELEMENT( ISOM_BOX_TYPE_MVEX, isom_print_mvex );
+    ADD_PRINT_BOX_TABLE_ELEMENT( ISOM_BOX_TYPE_MEHD, isom_print_mehd );
+    ADD_PRINT_BOX_TABLE_ELEMENT( ISOM_BOX_TYPE_TREX, isom_print_trex );
+    ADD_PRINT_BOX_TABLE_ELEMENT( ISOM_BOX_TYPE_MOOF, isom_print_moof );
+    ADD_PRINT_BOX_TABLE_ELEMENT( ISOM_BOX_TYPE_MFHD, isom_print_mfhd );
+    ADD_PRINT_BOX_TABLE_ELEMENT( ISOM_BOX_TYPE_TRAF, isom_print_traf );
+    ADD_PRINT_BOX_TABLE_ELEMENT( ISOM_BOX_TYPE_TFHD, isom_print_tfhd );
+    ADD_PRINT_BOX_TABLE_ELEMENT( ISOM_BOX_TYPE_TFDT, isom_print_tfdt );
+    ADD_PRINT_BOX_TABLE_ELEMENT( ISOM_BOX_TYPE_TRUN, isom_print_trun );
+    ADD_PRINT_BOX_TABLE_ELEMENT( ISOM_BOX_TYPE_FREE, isom_print_free );
+    ADD_PRINT_BOX_TABLE_ELEMENT( ISOM_BOX_TYPE_SKIP, isom_print_free );
+    ADD_PRINT_BOX_TABLE_ELEMENT( ISOM_BOX_TYPE_MDAT, isom_print_mdat );
+    ADD_PRINT_BOX_TABLE_ELEMENT(   QT_BOX_TYPE_KEYS, isom_print_keys );
+    ADD_PRINT_BOX_TABLE_ELEMENT( ISOM_BOX_TYPE_META, isom_print_meta );
+    ADD_PRINT_BOX_TABLE_ELEMENT( ISOM_BOX_TYPE_ILST, isom_print_ilst );
+    ADD_PRINT_BOX_TABLE_ELEMENT(   QT_BOX_TYPE_ILST, isom_print_ilst );
+    ADD_PRINT_BOX_TABLE_ELEMENT( ISOM_BOX_TYPE_MFRA, isom_print_mfra );
+    ADD_PRINT_BOX_TABLE_ELEMENT( ISOM_BOX_TYPE_TFRA, isom_print_tfra );
+    ADD_PRINT_BOX_TABLE_ELEMENT( ISOM_BOX_TYPE_MFRO, isom_print_mfro );
+    ADD_PRINT_BOX_TABLE_ELEMENT( LSMASH_BOX_TYPE_UNSPECIFIED, NULL );
+#undef ADD_PRINT_BOX_TABLE_ELEMENT
+}
+
+static struct print_description_table_tag
+{
+    lsmash_codec_type_t type;
+    isom_print_box_t    func;
+} print_description_table[160] = { { LSMASH_CODEC_TYPE_INITIALIZER, NULL } };
+static lsmash_once_t print_description_table_once = LSMASH_ONCE_INIT;
+
+static void isom_init_print_description_table( void )
+{
+    int i = 0;
+#define ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( type, func ) print_description_table[i++] = (struct print_description_table_tag){ type, func }
+    ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( ISOM_CODEC_TYPE_AVC1_VIDEO, isom_print_visual_description );
+    ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( ISOM_CODEC_TYPE_AVC2_VIDEO, isom_print_visual_description );
+    ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( ISOM_CODEC_TYPE_AVC3_VIDEO, isom_print_visual_description );
+    ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( ISOM_CODEC_TYPE_AVC4_VIDEO, isom_print_visual_description );
+    ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( ISOM_CODEC_TYPE_AVCP_VIDEO, isom_print_visual_description );
+    ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( ISOM_CODEC_TYPE_DRAC_VIDEO, isom_print_visual_description );
+    ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( ISOM_CODEC_TYPE_ENCV_VIDEO, isom_print_visual_description );
+    ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( ISOM_CODEC_TYPE_HVC1_VIDEO, isom_print_visual_description );
+    ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( ISOM_CODEC_TYPE_HEV1_VIDEO, isom_print_visual_description );
+    ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( ISOM_CODEC_TYPE_MJP2_VIDEO, isom_print_visual_description );
+    ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( ISOM_CODEC_TYPE_MP4V_VIDEO, isom_print_visual_description );
+    ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( ISOM_CODEC_TYPE_MVC1_VIDEO, isom_print_visual_description );
+    ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( ISOM_CODEC_TYPE_MVC2_VIDEO, isom_print_visual_description );
+    ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( ISOM_CODEC_TYPE_S263_VIDEO, isom_print_visual_description );
+    ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( ISOM_CODEC_TYPE_SVC1_VIDEO, isom_print_visual_description );
+    ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( ISOM_CODEC_TYPE_VC_1_VIDEO, isom_print_visual_description );
+    ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( QT_CODEC_TYPE_2VUY_VIDEO,   isom_print_visual_description );
+    ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( QT_CODEC_TYPE_CFHD_VIDEO,   isom_print_visual_description );
+    ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( QT_CODEC_TYPE_DV10_VIDEO,   isom_print_visual_description );
+    ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( QT_CODEC_TYPE_DVOO_VIDEO,   isom_print_visual_description );
+    ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( QT_CODEC_TYPE_DVOR_VIDEO,   isom_print_visual_description );
+    ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( QT_CODEC_TYPE_DVTV_VIDEO,   isom_print_visual_description );
+    ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( QT_CODEC_TYPE_DVVT_VIDEO,   isom_print_visual_description );
+    ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( QT_CODEC_TYPE_HD10_VIDEO,   isom_print_visual_description );
+    ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( QT_CODEC_TYPE_M105_VIDEO,   isom_print_visual_description );
+    ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( QT_CODEC_TYPE_PNTG_VIDEO,   isom_print_visual_description );
+    ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( QT_CODEC_TYPE_SVQ1_VIDEO,   isom_print_visual_description );
+    ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( QT_CODEC_TYPE_SVQ3_VIDEO,   isom_print_visual_description );
+    ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( QT_CODEC_TYPE_SHR0_VIDEO,   isom_print_visual_description );
+    ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( QT_CODEC_TYPE_SHR1_VIDEO,   isom_print_visual_description );
+    ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( QT_CODEC_TYPE_SHR2_VIDEO,   isom_print_visual_description );
+    ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( QT_CODEC_TYPE_SHR3_VIDEO,   isom_print_visual_description );
+    ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( QT_CODEC_TYPE_SHR4_VIDEO,   isom_print_visual_description );
+    ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( QT_CODEC_TYPE_WRLE_VIDEO,   isom_print_visual_description );
+    ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( QT_CODEC_TYPE_APCH_VIDEO,   isom_print_visual_description );
+    ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( QT_CODEC_TYPE_APCN_VIDEO,   isom_print_visual_description );
+    ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( QT_CODEC_TYPE_APCS_VIDEO,   isom_print_visual_description );
+    ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( QT_CODEC_TYPE_APCO_VIDEO,   isom_print_visual_description );
+    ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( QT_CODEC_TYPE_AP4H_VIDEO,   isom_print_visual_description );
+    ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( QT_CODEC_TYPE_AP4X_VIDEO,   isom_print_visual_description );
+    ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( QT_CODEC_TYPE_CIVD_VIDEO,   isom_print_visual_description );
+    ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( QT_CODEC_TYPE_DRAC_VIDEO,   isom_print_visual_description );
+    ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( QT_CODEC_TYPE_DVC_VIDEO,    isom_print_visual_description );
+    ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( QT_CODEC_TYPE_DVCP_VIDEO,   isom_print_visual_description );
+    ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( QT_CODEC_TYPE_DVPP_VIDEO,   isom_print_visual_description );
+    ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( QT_CODEC_TYPE_DV5N_VIDEO,   isom_print_visual_description );
+    ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( QT_CODEC_TYPE_DV5P_VIDEO,   isom_print_visual_description );
+    ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( QT_CODEC_TYPE_DVH2_VIDEO,   isom_print_visual_description );
+    ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( QT_CODEC_TYPE_DVH3_VIDEO,   isom_print_visual_description );
+    ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( QT_CODEC_TYPE_DVH5_VIDEO,   isom_print_visual_description );
+    ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( QT_CODEC_TYPE_DVH6_VIDEO,   isom_print_visual_description );
+    ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( QT_CODEC_TYPE_DVHP_VIDEO,   isom_print_visual_description );
+    ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( QT_CODEC_TYPE_DVHQ_VIDEO,   isom_print_visual_description );
+    ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( QT_CODEC_TYPE_FLIC_VIDEO,   isom_print_visual_description );
+    ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( QT_CODEC_TYPE_GIF_VIDEO,    isom_print_visual_description );
+    ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( QT_CODEC_TYPE_H261_VIDEO,   isom_print_visual_description );
+    ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( QT_CODEC_TYPE_H263_VIDEO,   isom_print_visual_description );
+    ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( QT_CODEC_TYPE_JPEG_VIDEO,   isom_print_visual_description );
+    ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( QT_CODEC_TYPE_MJPA_VIDEO,   isom_print_visual_description );
+    ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( QT_CODEC_TYPE_MJPB_VIDEO,   isom_print_visual_description );
+    ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( QT_CODEC_TYPE_PNG_VIDEO,    isom_print_visual_description );
+    ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( QT_CODEC_TYPE_RLE_VIDEO,    isom_print_visual_description );
+    ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( QT_CODEC_TYPE_RPZA_VIDEO,   isom_print_visual_description );
+    ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( QT_CODEC_TYPE_TGA_VIDEO,    isom_print_visual_description );
+    ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( QT_CODEC_TYPE_TIFF_VIDEO,   isom_print_visual_description );
+    ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( QT_CODEC_TYPE_ULRA_VIDEO,   isom_print_visual_description );
+    ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( QT_CODEC_TYPE_ULRG_VIDEO,   isom_print_visual_description );
+    ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( QT_CODEC_TYPE_ULY2_VIDEO,   isom_print_visual_description );
+    ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( QT_CODEC_TYPE_ULY0_VIDEO,   isom_print_visual_description );
+    ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( QT_CODEC_TYPE_ULH2_VIDEO,   isom_print_visual_description );
+    ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( QT_CODEC_TYPE_ULH0_VIDEO,   isom_print_visual_description );
+    ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( QT_CODEC_TYPE_UQY2_VIDEO,   isom_print_visual_description );
+    ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( QT_CODEC_TYPE_V210_VIDEO,   isom_print_visual_description );
+    ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( QT_CODEC_TYPE_V216_VIDEO,   isom_print_visual_description );
+    ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( QT_CODEC_TYPE_V308_VIDEO,   isom_print_visual_description );
+    ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( QT_CODEC_TYPE_V408_VIDEO,   isom_print_visual_description );
+    ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( QT_CODEC_TYPE_V410_VIDEO,   isom_print_visual_description );
+    ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( QT_CODEC_TYPE_YUV2_VIDEO,   isom_print_visual_description );
+    ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( ISOM_CODEC_TYPE_AC_3_AUDIO,  isom_print_audio_description );
+    ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( ISOM_CODEC_TYPE_ALAC_AUDIO,  isom_print_audio_description );
+    ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( ISOM_CODEC_TYPE_DRA1_AUDIO,  isom_print_audio_description );
+    ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( ISOM_CODEC_TYPE_DTSC_AUDIO,  isom_print_audio_description );
+    ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( ISOM_CODEC_TYPE_DTSE_AUDIO,  isom_print_audio_description );
+    ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( ISOM_CODEC_TYPE_DTSH_AUDIO,  isom_print_audio_description );
+    ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( ISOM_CODEC_TYPE_DTSL_AUDIO,  isom_print_audio_description );
+    ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( ISOM_CODEC_TYPE_EC_3_AUDIO,  isom_print_audio_description );
+    ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( ISOM_CODEC_TYPE_ENCA_AUDIO,  isom_print_audio_description );
+    ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( ISOM_CODEC_TYPE_G719_AUDIO,  isom_print_audio_description );
+    ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( ISOM_CODEC_TYPE_G726_AUDIO,  isom_print_audio_description );
+    ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( ISOM_CODEC_TYPE_M4AE_AUDIO,  isom_print_audio_description );
+    ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( ISOM_CODEC_TYPE_MLPA_AUDIO,  isom_print_audio_description );
+    ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( ISOM_CODEC_TYPE_MP4A_AUDIO,  isom_print_audio_description );
+    ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( ISOM_CODEC_TYPE_SAMR_AUDIO,  isom_print_audio_description );
+    ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( ISOM_CODEC_TYPE_SAWB_AUDIO,  isom_print_audio_description );
+    ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( ISOM_CODEC_TYPE_SAWP_AUDIO,  isom_print_audio_description );
+    ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( ISOM_CODEC_TYPE_SEVC_AUDIO,  isom_print_audio_description );
+    ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( ISOM_CODEC_TYPE_SQCP_AUDIO,  isom_print_audio_description );
+    ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( ISOM_CODEC_TYPE_SSMV_AUDIO,  isom_print_audio_description );
+    ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( ISOM_CODEC_TYPE_TWOS_AUDIO,  isom_print_audio_description );
+    ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( ISOM_CODEC_TYPE_WMA_AUDIO,   isom_print_audio_description );
+    ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( QT_CODEC_TYPE_MP4A_AUDIO,    isom_print_audio_description );
+    ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( QT_CODEC_TYPE_23NI_AUDIO,    isom_print_audio_description );
+    ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( QT_CODEC_TYPE_MAC3_AUDIO,    isom_print_audio_description );
+    ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( QT_CODEC_TYPE_MAC6_AUDIO,    isom_print_audio_description );
+    ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( QT_CODEC_TYPE_NONE_AUDIO,    isom_print_audio_description );
+    ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( QT_CODEC_TYPE_QDM2_AUDIO,    isom_print_audio_description );
+    ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( QT_CODEC_TYPE_QDMC_AUDIO,    isom_print_audio_description );
+    ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( QT_CODEC_TYPE_QCLP_AUDIO,    isom_print_audio_description );
+    ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( QT_CODEC_TYPE_AGSM_AUDIO,    isom_print_audio_description );
+    ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( QT_CODEC_TYPE_ALAW_AUDIO,    isom_print_audio_description );
+    ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( QT_CODEC_TYPE_CDX2_AUDIO,    isom_print_audio_description );
+    ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( QT_CODEC_TYPE_CDX4_AUDIO,    isom_print_audio_description );
+    ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( QT_CODEC_TYPE_DVCA_AUDIO,    isom_print_audio_description );
+    ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( QT_CODEC_TYPE_DVI_AUDIO,     isom_print_audio_description );
+    ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( QT_CODEC_TYPE_FL32_AUDIO,    isom_print_audio_description );
+    ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( QT_CODEC_TYPE_FL64_AUDIO,    isom_print_audio_description );
+    ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( QT_CODEC_TYPE_IMA4_AUDIO,    isom_print_audio_description );
+    ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( QT_CODEC_TYPE_IN24_AUDIO,    isom_print_audio_description );
+    ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( QT_CODEC_TYPE_IN32_AUDIO,    isom_print_audio_description );
+    ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( QT_CODEC_TYPE_LPCM_AUDIO,    isom_print_audio_description );
+    ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( QT_CODEC_TYPE_SOWT_AUDIO,    isom_print_audio_description );
+    ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( QT_CODEC_TYPE_TWOS_AUDIO,    isom_print_audio_description );
+    ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( QT_CODEC_TYPE_ULAW_AUDIO,    isom_print_audio_description );
+    ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( QT_CODEC_TYPE_VDVA_AUDIO,    isom_print_audio_description );
+    ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( QT_CODEC_TYPE_FULLMP3_AUDIO, isom_print_audio_description );
+    ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( QT_CODEC_TYPE_MP3_AUDIO,     isom_print_audio_description );
+    ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( QT_CODEC_TYPE_ADPCM2_AUDIO,  isom_print_audio_description );
+    ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( QT_CODEC_TYPE_ADPCM17_AUDIO, isom_print_audio_description );
+    ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( QT_CODEC_TYPE_GSM49_AUDIO,   isom_print_audio_description );
+    ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( QT_CODEC_TYPE_NOT_SPECIFIED, isom_print_audio_description );
+    ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( QT_CODEC_TYPE_TEXT_TEXT,     isom_print_text_description );
+    ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( ISOM_CODEC_TYPE_TX3G_TEXT,   isom_print_tx3g_description );
+    ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( ISOM_CODEC_TYPE_MP4S_SYSTEM, isom_print_mp4s_description );
+    ADD_PRINT_DESCRIPTION_TABLE_ELEMENT( LSMASH_CODEC_TYPE_UNSPECIFIED, NULL );
+#undef ADD_PRINT_DESCRIPTION_TABLE_ELEMENT
+}
+
+static isom_print_box_t isom_select_print_func( isom_box_t *box )
+{
+    if( box->manager & LSMASH_UNKNOWN_BOX )
+        return isom_print_unknown;
+    if( box->parent )
+    {
+        isom_box_t *parent = box->parent;
+        if( lsmash_check_box_type_identical( parent->type, ISOM_BOX_TYPE_STSD ) )
+        {
+            lsmash_codec_type_t sample_type = box->type;
+            if( lsmash_check_codec_type_identical( sample_type, LSMASH_CODEC_TYPE_RAW ) )
+            {
+                if( box->manager & LSMASH_VIDEO_DESCRIPTION )
+                    return isom_print_visual_description;
+                else if( box->manager & LSMASH_AUDIO_DESCRIPTION )
+                    return isom_print_audio_description;
+            }
+            lsmash_call_once( &print_description_table_once, isom_init_print_description_table );
+            for( int i = 0; print_description_table[i].func; i++ )
+                if( lsmash_check_codec_type_identical( sample_type, print_description_table[i].type ) )
+                    return print_description_table[i].func;
+            return isom_print_unknown;
+        }
+        if( lsmash_check_box_type_identical( parent->type, QT_BOX_TYPE_WAVE ) )
+        {
+            if( lsmash_check_box_type_identical( box->type, QT_BOX_TYPE_FRMA ) )
+                return isom_print_frma;
+            else if( lsmash_check_box_type_identical( box->type, QT_BOX_TYPE_ENDA ) )
+                return isom_print_enda;
+            else if( lsmash_check_box_type_identical( box->type, QT_BOX_TYPE_TERMINATOR ) )
+                return isom_print_terminator;
+            else
+                return isom_print_sample_description_extesion;
+        }
+        if( lsmash_check_box_type_identical( parent->type, ISOM_BOX_TYPE_TREF ) )
+            return isom_print_track_reference_type;
+        if( parent->parent )
+        {
+            if( lsmash_check_box_type_identical( parent->parent->type, ISOM_BOX_TYPE_STSD ) )
+                return isom_print_sample_description_extesion;
+            else if( lsmash_check_box_type_identical( parent->parent->type, ISOM_BOX_TYPE_ILST )
+                  || lsmash_check_box_type_identical( parent->parent->type,   QT_BOX_TYPE_ILST ) )
+            {
+                if( parent->type.fourcc == LSMASH_4CC( '-', '-', '-', '-' ) )
+                {
+                    if( lsmash_check_box_type_identical( box->type, ISOM_BOX_TYPE_MEAN ) )
+                        return isom_print_mean;
+                    if( lsmash_check_box_type_identical( box->type, ISOM_BOX_TYPE_NAME ) )
+                        return isom_print_name;
+                }
+                if( lsmash_check_box_type_identical( box->type, ISOM_BOX_TYPE_DATA ) )
+                    return isom_print_data;
+            }
+        }
+        if( lsmash_check_box_type_identical( parent->type, ISOM_BOX_TYPE_ILST )
+         || lsmash_check_box_type_identical( parent->type,   QT_BOX_TYPE_ILST ) )
+            return isom_print_metaitem;
+    }
+    lsmash_call_once( &print_box_table_once, isom_init_print_box_table );
+    for( int i = 0; print_box_table[i].func; i++ )
+        if( lsmash_check_box_type_identical( box->type, print_box_table[i].type ) )
+            return print_box_table[i].func;
+    return isom_print_unknown;
+}
+
+static inline void isom_print_remove_plastic_box( isom_box_t *box )
+{
+    if( box->manager & LSMASH_ABSENT_IN_FILE )
+        /* free flagged box */
+        isom_remove_box_by_itself( box );
+}
+
+void isom_begin_print_stream( lsmash_file_t *file )
+{
+    /* The file size has been got when probing the file. */
+    isom_print_stream_t *stream = file->print_stream;
+    stream->size_known = !file->bs->unseekable;
+    stream->file_size  = file->bs->written;
+}
+
+int isom_end_print_stream( lsmash_file_t *file )
+{
+    /* Nothing has been printed if no box has been read. */
+    if( file->print_stream->box_count == 0 )
+        return LSMASH_ERR_INVALID_DATA;
+    return isom_print_stream_footer( file->print_stream );
+}
+
+static int isom_print_box_while_reading( lsmash_file_t *file, isom_box_t *box, int level )
+{
+    isom_print_stream_t *stream = file->print_stream;
+    /* Don't print a box the file cannot contain, e.g. a box header read from garbage. */
+    if( stream->size_known
+     && (box->pos > stream->file_size || box->size > stream->file_size - box->pos) )
+        return LSMASH_ERR_INVALID_DATA;
+    /* Print the header of the file together with the first box so that nothing is printed for a file without boxes. */
+    if( stream->box_count == 0 )
+        isom_print_stream_header( stream, stream->size_known, stream->file_size );
+    if( level == 1 || box->type.fourcc == ISOM_BOX_TYPE_IODS.fourcc )
+        /* Brands and the presence of Object Descriptor Box decide how to interpret some fields.
+         * Decide compatibilities from boxes read so far since we cannot wait for the end of the file. */
+        isom_check_compatibility( file );
+    int ret = isom_print_stream_box( file, stream, box, level, isom_select_print_func( box ) );
+    isom_print_remove_plastic_box( box );
+    return ret;
 }
 
 int isom_add_print_func( lsmash_file_t *file, void *box, int level )
@@ -2674,6 +4392,8 @@ int isom_add_print_func( lsmash_file_t *file, void *box, int level )
         isom_print_remove_plastic_box( box );
         return 0;
     }
+    if( file->print_stream )
+        return isom_print_box_while_reading( file, (isom_box_t *)box, level );
     isom_print_entry_t *data = lsmash_malloc( sizeof(isom_print_entry_t) );
     if( !data )
     {
@@ -2705,4 +4425,6 @@ void isom_remove_print_funcs( lsmash_file_t *file )
 {
     lsmash_remove_list( file->print, isom_remove_print_func );
     file->print = NULL;
+    isom_remove_print_stream( file->print_stream );
+    file->print_stream = NULL;
 }
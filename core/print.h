@@ -25,5 +25,21 @@
 
 int isom_add_print_func( lsmash_file_t *file, void *box, int level );
 void isom_remove_print_funcs( lsmash_file_t *file );
+void isom_begin_print_stream( lsmash_file_t *file );
+int isom_end_print_stream( lsmash_file_t *file );
+
+/* Writers of JSON values for the box printers in codecs/ */
+struct print_stream_tag;
+void isom_json_separate( struct print_stream_tag *stream );
+void isom_json_begin( struct print_stream_tag *stream, char bracket );
+void isom_json_end( struct print_stream_tag *stream, char bracket );
+void isom_json_key( struct print_stream_tag *stream, const char *key );
+void isom_json_field_uint( struct print_stream_tag *stream, const char *key, uint64_t value );
+void isom_json_field_int( struct print_stream_tag *stream, const char *key, int64_t value );
+void isom_json_field_fourcc( struct print_stream_tag *stream, const char *key, uint32_t fourcc );
+void isom_json_field_string( struct print_stream_tag *stream, const char *key, const char *str, size_t length );
+void isom_json_field_bytes( struct print_stream_tag *stream, const char *key, const uint8_t *data, uint32_t size );
+void isom_json_element_uint( struct print_stream_tag *stream, uint64_t value );
+void isom_json_element_int( struct print_stream_tag *stream, int64_t value );
 
 #endif /* LSMASH_PRINT_H */
@@ -53,6 +53,17 @@ static const lsmash_class_t lsmash_timeline_class =
     "timeline"
 };
 
+/* A decoding time is indexed every ISOM_DTS_INDEX_INTERVAL entries of info_list or bunch_list. */
+#define ISOM_DTS_INDEX_INTERVAL 1024
+
+typedef struct
+{
+    lsmash_entry_t *entry;          /* entry in info_list or bunch_list */
+    uint32_t        entry_number;
+    uint32_t        sample_number;  /* number of the first sample in the entry */
+    uint64_t        dts;            /* decoding time of the first sample in the entry */
+} isom_dts_index_t;
+
 struct isom_timeline_tag
 {
     const lsmash_class_t *class;
@@ -75,6 +86,12 @@ struct isom_timeline_tag
     lsmash_entry_list_t chunk_list[1];  /* list of chunks */
     lsmash_entry_list_t info_list [1];  /* list of sample info */
     lsmash_entry_list_t bunch_list[1];  /* list of LPCM bunch */
+    lsmash_entry_t *last_exported_entry;    /* entry in info_list or bunch_list where the last export ended */
+    uint32_t last_exported_entry_sample_number;
+    uint64_t last_exported_entry_dts;
+    isom_dts_index_t *dts_index;        /* sparse index of decoding times, built on demand */
+    uint32_t          dts_index_count;
+    uint32_t          dts_index_entry_count;    /* number of the entries indexed */
     int (*get_dts)( isom_timeline_t *timeline, uint32_t sample_number, uint64_t *dts );
     int (*get_cts)( isom_timeline_t *timeline, uint32_t sample_number, uint64_t *cts );
     int (*get_sample_duration)( isom_timeline_t *timeline, uint32_t sample_number, uint32_t *sample_duration );
@@ -122,6 +139,7 @@ void isom_timeline_destroy( isom_timeline_t *timeline )
     lsmash_remove_entries( timeline->chunk_list, NULL );    /* chunk data must be already freed. */
     lsmash_remove_entries( timeline->info_list,  NULL );
     lsmash_remove_entries( timeline->bunch_list, NULL );
+    lsmash_free( timeline->dts_index );
     lsmash_free( timeline );
 }
 
@@ -1487,6 +1505,87 @@ int lsmash_get_sample_info_from_media_timeline( lsmash_root_t *root, uint32_t tr
     return timeline ? timeline->get_sample_info( timeline, sample_number, sample ) : -1;
 }
 
+/* Get where the data of a sample is stored without calculating its timestamps. */
+static int isom_get_sample_location
+(
+    isom_timeline_t *timeline,
+    uint32_t         sample_number,
+    lsmash_file_t  **file,
+    uint64_t        *pos,
+    uint32_t        *length
+)
+{
+    isom_portable_chunk_t *chunk;
+    if( timeline->info_list->entry_count )
+    {
+        isom_sample_info_t *info = (isom_sample_info_t *)lsmash_get_entry_data( timeline->info_list, sample_number );
+        if( !info )
+            return LSMASH_ERR_NAMELESS;
+        chunk   = info->chunk;
+        *pos    = info->pos;
+        *length = info->length;
+    }
+    else
+    {
+        isom_lpcm_bunch_t *bunch = isom_get_bunch( timeline, sample_number );
+        if( !bunch )
+            return LSMASH_ERR_NAMELESS;
+        chunk   = bunch->chunk;
+        *pos    = bunch->pos + (uint64_t)(sample_number - timeline->last_accessed_lpcm_bunch_first_sample_number) * bunch->length;
+        *length = bunch->length;
+    }
+    if( !chunk || !chunk->file )
+        return LSMASH_ERR_NAMELESS;
+    *file = chunk->file;
+    return 0;
+}
+
+int lsmash_read_sample_data_from_media_timeline
+(
+    lsmash_root_t *root,
+    uint32_t       track_ID,
+    uint32_t       first_sample_number,
+    uint32_t       sample_count,
+    uint8_t       *data,
+    uint32_t       size
+)
+{
+    if( first_sample_number == 0
+     || sample_count == 0
+     || !data )
+        return LSMASH_ERR_FUNCTION_PARAM;
+    isom_timeline_t *timeline = isom_get_timeline( root, track_ID );
+    if( !timeline )
+        return LSMASH_ERR_NAMELESS;
+    /* Check that the samples are stored contiguously in the same file. */
+    lsmash_file_t *file;
+    uint64_t       start;
+    uint64_t       end;
+    uint32_t       length;
+    int err = isom_get_sample_location( timeline, first_sample_number, &file, &start, &length );
+    if( err < 0 )
+        return err;
+    end = start + length;
+    for( uint32_t i = 1; i < sample_count; i++ )
+    {
+        lsmash_file_t *sample_file;
+        uint64_t       pos;
+        if( (err = isom_get_sample_location( timeline, first_sample_number + i, &sample_file, &pos, &length )) < 0 )
+            return err;
+        if( sample_file != file || pos != end )
+            return LSMASH_ERR_FUNCTION_PARAM;
+        end += length;
+    }
+    if( end - start > size )
+        return LSMASH_ERR_FUNCTION_PARAM;
+    /* Read the data at a time. */
+    lsmash_bs_t *bs = file->bs;
+    if( lsmash_bs_read_seek( bs, start, SEEK_SET ) < 0
+     || lsmash_bs_get_bytes_ex( bs, end - start, data ) != end - start )
+        return LSMASH_ERR_NAMELESS;
+    return 0;
+}
+
 int lsmash_get_sample_property_from_media_timeline( lsmash_root_t *root, uint32_t track_ID, uint32_t sample_number, lsmash_sample_property_t *prop )
 {
     if( !prop )
@@ -1723,6 +1822,92 @@ int lsmash_get_closest_random_accessible_point_detail_from_media_timeline( lsmas
     } while( 1 );
 }
 
+int lsmash_get_sample_range_from_media_timeline
+(
+    lsmash_root_t *root,
+    uint32_t       track_ID,
+    uint64_t       start_time,
+    uint64_t       end_time,
+    uint32_t      *first_sample_number,
+    uint32_t      *last_sample_number
+)
+{
+    if( start_time >= end_time
+     || !first_sample_number
+     || !last_sample_number )
+        return LSMASH_ERR_FUNCTION_PARAM;
+    isom_timeline_t *timeline = isom_get_timeline( root, track_ID );
+    if( !timeline )
+        return LSMASH_ERR_NAMELESS;
+    /* A sample whose decoding time is 'end_time' plus the composition to decode timeline shift or later
+     * is never presented before 'end_time', and neither are the following ones. */
+    uint64_t end_dts      = end_time + timeline->ctd_shift;
+    uint64_t dts          = 0;
+    uint64_t start_cts    = 0;
+    uint32_t number       = 1;
+    uint32_t start_number = 0;  /* the sample presented at 'start_time' */
+    uint32_t last_number  = 0;
+    int      presented    = 0;  /* whether any sample is presented in the range */
+    if( timeline->info_list->entry_count )
+        for( lsmash_entry_t *entry = timeline->info_list->head; entry && dts < end_dts; entry = entry->next )
+        {
+            isom_sample_info_t *info = (isom_sample_info_t *)entry->data;
+            if( !info )
+                return LSMASH_ERR_NAMELESS;
+            uint64_t cts = timeline->ctd_shift ? (dts + (int32_t)info->offset) : (dts + info->offset);
+            if( cts <= start_time && (start_number == 0 || cts >= start_cts) )
+            {
+                start_number = number;
+                start_cts    = cts;
+            }
+            if( cts < end_time )
+            {
+                last_number = number;
+                presented  |= (cts + info->duration > start_time);
+            }
+            dts += info->duration;
+            ++number;
+        }
+    else
+        /* Samples in a bunch are presented in decoding order. */
+        for( lsmash_entry_t *entry = timeline->bunch_list->head; entry && dts < end_dts; entry = entry->next )
+        {
+            isom_lpcm_bunch_t *bunch = (isom_lpcm_bunch_t *)entry->data;
+            if( !bunch || bunch->duration == 0 )
+                return LSMASH_ERR_NAMELESS;
+            uint64_t cts = timeline->ctd_shift ? (dts + (int32_t)bunch->offset) : (dts + bunch->offset);
+            uint64_t end = cts + (uint64_t)bunch->sample_count * bunch->duration;
+            if( cts <= start_time && start_time < end )
+                start_number = number + (start_time - cts) / bunch->duration;
+            if( cts < end_time )
+            {
+                last_number = number + (LSMASH_MIN( end, end_time ) - cts - 1) / bunch->duration;
+                presented  |= (end > start_time);
+            }
+            dts    += (uint64_t)bunch->sample_count * bunch->duration;
+            number += bunch->sample_count;
+        }
+    if( !presented )
+        return LSMASH_ERR_NAMELESS;
+    if( start_number == 0 )
+        /* 'start_time' is before the first presented sample. */
+        start_number = 1;
+    uint32_t rap_number;
+    if( timeline->info_list->entry_count == 0 )
+        rap_number = start_number;  /* All LPCM is sync sample. */
+    else
+    {
+        int err = isom_get_closest_random_accessible_point_from_media_timeline_internal( timeline, start_number, &rap_number );
+        if( err < 0 )
+            return err;
+    }
+    if( rap_number > last_number )
+        return LSMASH_ERR_NAMELESS;
+    *first_sample_number = rap_number;
+    *last_sample_number  = last_number;
+    return 0;
+}
+
 int lsmash_check_sample_existence_in_media_timeline( lsmash_root_t *root, uint32_t track_ID, uint32_t sample_number )
 {
     isom_timeline_t *timeline = isom_get_timeline( root, track_ID );
@@ -1976,6 +2161,105 @@ int lsmash_set_media_timestamps( lsmash_root_t *root, uint32_t track_ID, lsmash_
     }
     if( timeline->ctd_shift && (!root->file->qt_compatible || root->file->max_isom_version < 4) )
         return LSMASH_ERR_INVALID_DATA; /* Don't allow composition to decode timeline shift. */
+    /* Durations have changed. */
+    timeline->last_exported_entry         = NULL;
+    timeline->last_accessed_sample_number = 0;
+    timeline->last_accessed_sample_dts    = 0;
+    lsmash_freep( &timeline->dts_index );
+    timeline->dts_index_count       = 0;
+    timeline->dts_index_entry_count = 0;
+    return 0;
+}
+
+int isom_timeline_rebuild_timing_boxes
+(
+    isom_timeline_t *timeline,
+    isom_trak_t     *trak,
+    uint32_t        *last_sample_delta
+)
+{
+    if( !timeline || !trak || !last_sample_delta )
+        return LSMASH_ERR_FUNCTION_PARAM;
+    if( !trak->cache
+     || !trak->mdia
+     || !trak->mdia->minf
+     || !trak->mdia->minf->stbl
+     || !trak->mdia->minf->stbl->stts
+     || !trak->mdia->minf->stbl->stts->list )
+        return LSMASH_ERR_INVALID_DATA;
+    *last_sample_delta = 0;
+    if( timeline->info_list->entry_count == 0 )
+        /* The timestamps of LPCM tracks are never changed. So, the existing boxes are still valid. */
+        return 0;
+    isom_stbl_t *stbl = trak->mdia->minf->stbl;
+    int has_offset = 0;
+    for( lsmash_entry_t *entry = timeline->info_list->head; entry; entry = entry->next )
+    {
+        isom_sample_info_t *info = (isom_sample_info_t *)entry->data;
+        if( !info )
+            return LSMASH_ERR_INVALID_DATA;
+        if( info->offset )
+        {
+            has_offset = 1;
+            break;
+        }
+    }
+    lsmash_remove_entries( stbl->stts->list, NULL );
+    if( has_offset )
+    {
+        if( !stbl->ctts && !isom_add_ctts( stbl ) )
+            return LSMASH_ERR_NAMELESS;
+        lsmash_remove_entries( stbl->ctts->list, NULL );
+        stbl->ctts->version = timeline->ctd_shift ? 1 : 0;
+        /* isom_update_mdhd_duration() recomputes the Composition to Decode Box except for a single sample. */
+        if( timeline->info_list->entry_count == 1 )
+            isom_remove_box_by_itself( stbl->cslg );
+    }
+    else
+    {
+        isom_remove_box_by_itself( stbl->ctts );
+        isom_remove_box_by_itself( stbl->cslg );
+    }
+    isom_stts_entry_t *stts_data = NULL;
+    isom_ctts_entry_t *ctts_data = NULL;
+    for( lsmash_entry_t *entry = timeline->info_list->head; entry; entry = entry->next )
+    {
+        isom_sample_info_t *info = (isom_sample_info_t *)entry->data;
+        if( stts_data && stts_data->sample_delta == info->duration )
+            ++ stts_data->sample_count;
+        else
+        {
+            stts_data = lsmash_malloc( sizeof(isom_stts_entry_t) );
+            if( !stts_data )
+                return LSMASH_ERR_MEMORY_ALLOC;
+            stts_data->sample_count = 1;
+            stts_data->sample_delta = info->duration;
+            if( lsmash_add_entry( stbl->stts->list, stts_data ) < 0 )
+            {
+                lsmash_free( stts_data );
+                return LSMASH_ERR_MEMORY_ALLOC;
+            }
+        }
+        if( !has_offset )
+            continue;
+        if( ctts_data && ctts_data->sample_offset == info->offset )
+            ++ ctts_data->sample_count;
+        else
+        {
+            ctts_data = lsmash_malloc( sizeof(isom_ctts_entry_t) );
+            if( !ctts_data )
+                return LSMASH_ERR_MEMORY_ALLOC;
+            ctts_data->sample_count  = 1;
+            ctts_data->sample_offset = info->offset;
+            if( lsmash_add_entry( stbl->ctts->list, ctts_data ) < 0 )
+            {
+                lsmash_free( ctts_data );
+                return LSMASH_ERR_MEMORY_ALLOC;
+            }
+        }
+    }
+    trak->cache->timestamp.ctd_shift = timeline->ctd_shift;
+    *last_sample_delta = ((isom_sample_info_t *)timeline->info_list->tail->data)->duration;
     return 0;
 }
 
@@ -2034,6 +2318,263 @@ int lsmash_get_media_timestamps( lsmash_root_t *root, uint32_t track_ID, lsmash_
     return 0;
 }
 
+/* Get a run of samples sharing the same duration and offset from an entry in info_list or bunch_list. */
+static int isom_get_timestamp_run
+(
+    isom_timeline_t *timeline,
+    lsmash_entry_t  *entry,
+    uint32_t        *sample_count,
+    uint32_t        *duration,
+    uint32_t        *offset
+)
+{
+    if( !entry || !entry->data )
+        return LSMASH_ERR_NAMELESS;
+    if( timeline->info_list->entry_count )
+    {
+        isom_sample_info_t *info = (isom_sample_info_t *)entry->data;
+        *sample_count = 1;
+        *duration     = info->duration;
+        *offset       = info->offset;
+    }
+    else
+    {
+        isom_lpcm_bunch_t *bunch = (isom_lpcm_bunch_t *)entry->data;
+        *sample_count = bunch->sample_count;
+        *duration     = bunch->duration;
+        *offset       = bunch->offset;
+    }
+    return 0;
+}
+
+static int isom_build_dts_index( isom_timeline_t *timeline, lsmash_entry_list_t *list )
+{
+    uint32_t          count = (list->entry_count + ISOM_DTS_INDEX_INTERVAL - 1) / ISOM_DTS_INDEX_INTERVAL;
+    isom_dts_index_t *index = lsmash_malloc( count * sizeof(isom_dts_index_t) );
+    if( !index )
+        return LSMASH_ERR_MEMORY_ALLOC;
+    uint32_t entry_number  = 1;
+    uint32_t sample_number = 1;
+    uint64_t dts           = 0;
+    count = 0;
+    for( lsmash_entry_t *entry = list->head; entry; entry = entry->next )
+    {
+        uint32_t run_count;
+        uint32_t duration;
+        uint32_t offset;
+        int err = isom_get_timestamp_run( timeline, entry, &run_count, &duration, &offset );
+        if( err < 0 )
+        {
+            lsmash_free( index );
+            return err;
+        }
+        if( (entry_number - 1) % ISOM_DTS_INDEX_INTERVAL == 0 )
+        {
+            index[count].entry         = entry;
+            index[count].entry_number  = entry_number;
+            index[count].sample_number = sample_number;
+            index[count].dts           = dts;
+            ++count;
+        }
+        ++entry_number;
+        sample_number += run_count;
+        dts           += (uint64_t)duration * run_count;
+    }
+    lsmash_free( timeline->dts_index );
+    timeline->dts_index             = index;
+    timeline->dts_index_count       = count;
+    timeline->dts_index_entry_count = list->entry_count;
+    return 0;
+}
+
+int isom_timeline_seek_dts
+(
+    isom_timeline_t *timeline,
+    uint64_t         dts,
+    int              random_accessible,
+    uint32_t        *sample_number,
+    uint64_t        *sample_dts
+)
+{
+    *sample_number = 0;
+    *sample_dts    = 0;
+    lsmash_entry_list_t *list = timeline->info_list->entry_count ? timeline->info_list : timeline->bunch_list;
+    if( list->entry_count == 0 )
+        return 0;
+    int err;
+    if( !timeline->dts_index
+     || timeline->dts_index_entry_count != list->entry_count )
+    {
+        if( (err = isom_build_dts_index( timeline, list )) < 0 )
+            return err;
+    }
+    /* Find the last indexed entry decoded at 'dts' or earlier by a binary search. */
+    uint32_t lo = 0;
+    uint32_t hi = timeline->dts_index_count - 1;
+    while( lo < hi )
+    {
+        uint32_t mid = lo + (hi - lo + 1) / 2;
+        if( timeline->dts_index[mid].dts <= dts )
+            lo = mid;
+        else
+            hi = mid - 1;
+    }
+    isom_dts_index_t *index        = &timeline->dts_index[lo];
+    lsmash_entry_t   *entry        = index->entry;
+    uint32_t          entry_number = index->entry_number;
+    uint32_t          number       = index->sample_number;
+    uint64_t          entry_dts    = index->dts;
+    /* Resume from the last accessed entry if it is between the indexed one and 'dts'. */
+    if( list->last_accessed_entry
+     && list->last_accessed_number > entry_number )
+    {
+        if( list == timeline->info_list
+         && list->last_accessed_number == timeline->last_accessed_sample_number
+         && timeline->last_accessed_sample_dts <= dts )
+        {
+            entry        = list->last_accessed_entry;
+            entry_number = list->last_accessed_number;
+            number       = timeline->last_accessed_sample_number;
+            entry_dts    = timeline->last_accessed_sample_dts;
+        }
+        else if( list == timeline->bunch_list
+              && list->last_accessed_number == timeline->last_accessed_lpcm_bunch_number
+              && timeline->last_accessed_lpcm_bunch_first_sample_number
+              && timeline->last_accessed_lpcm_bunch_dts <= dts )
+        {
+            entry        = list->last_accessed_entry;
+            entry_number = list->last_accessed_number;
+            number       = timeline->last_accessed_lpcm_bunch_first_sample_number;
+            entry_dts    = timeline->last_accessed_lpcm_bunch_dts;
+        }
+    }
+    for( ; entry; entry = entry->next )
+    {
+        uint32_t run_count;
+        uint32_t duration;
+        uint32_t offset;
+        if( (err = isom_get_timestamp_run( timeline, entry, &run_count, &duration, &offset )) < 0 )
+            return err;
+        lsmash_sample_property_t *prop = list == timeline->info_list
+                                       ? &((isom_sample_info_t *)entry->data)->prop
+                                       : &((isom_lpcm_bunch_t  *)entry->data)->prop;
+        uint64_t run_duration = (uint64_t)duration * run_count;
+        if( (!random_accessible || (prop->ra_flags & (ISOM_SAMPLE_RANDOM_ACCESS_FLAG_SYNC | ISOM_SAMPLE_RANDOM_ACCESS_FLAG_RAP)))
+         && (entry_dts >= dts || (duration && entry_dts + run_duration - duration >= dts)) )
+        {
+            uint32_t skip = entry_dts >= dts ? 0 : (uint32_t)((dts - entry_dts + duration - 1) / duration);
+            *sample_number = number + skip;
+            *sample_dts    = entry_dts + (uint64_t)duration * skip;
+            /* Make the access to the found sample and the following ones cheap. */
+            list->last_accessed_entry  = entry;
+            list->last_accessed_number = entry_number;
+            if( list == timeline->info_list )
+            {
+                timeline->last_accessed_sample_number = *sample_number;
+                timeline->last_accessed_sample_dts    = *sample_dts;
+            }
+            else
+            {
+                timeline->last_accessed_lpcm_bunch_number              = entry_number;
+                timeline->last_accessed_lpcm_bunch_duration            = duration;
+                timeline->last_accessed_lpcm_bunch_sample_count        = run_count;
+                timeline->last_accessed_lpcm_bunch_first_sample_number = number;
+                timeline->last_accessed_lpcm_bunch_dts                 = entry_dts;
+            }
+            return 0;
+        }
+        ++entry_number;
+        number    += run_count;
+        entry_dts += run_duration;
+    }
+    return 0;
+}
+
+int lsmash_export_media_timestamps
+(
+    lsmash_root_t *root,
+    uint32_t       track_ID,
+    uint32_t       first_sample_number,
+    uint32_t       sample_count,
+    uint64_t      *dts,
+    uint64_t      *cts
+)
+{
+    if( first_sample_number == 0 )
+        return LSMASH_ERR_FUNCTION_PARAM;
+    isom_timeline_t *timeline = isom_get_timeline( root, track_ID );
+    if( !timeline )
+        return LSMASH_ERR_NAMELESS;
+    if( sample_count == 0 )
+        return 0;
+    if( sample_count > timeline->sample_count
+     || first_sample_number > timeline->sample_count - sample_count + 1 )
+        return LSMASH_ERR_FUNCTION_PARAM;
+    /* Seek the entry containing the first sample.
+     * Resume from where the last export ended if possible so that exporting a timeline piece by piece costs linear time. */
+    lsmash_entry_t *entry;
+    uint32_t        entry_sample_number;
+    uint64_t        entry_dts;
+    if( timeline->last_exported_entry
+     && timeline->last_exported_entry_sample_number <= first_sample_number )
+    {
+        entry               = timeline->last_exported_entry;
+        entry_sample_number = timeline->last_exported_entry_sample_number;
+        entry_dts           = timeline->last_exported_entry_dts;
+    }
+    else
+    {
+        entry               = timeline->info_list->entry_count ? timeline->info_list->head : timeline->bunch_list->head;
+        entry_sample_number = 1;
+        entry_dts           = 0;
+    }
+    uint32_t run_count;
+    uint32_t duration;
+    uint32_t offset;
+    int err;
+    while( 1 )
+    {
+        if( (err = isom_get_timestamp_run( timeline, entry, &run_count, &duration, &offset )) < 0 )
+            return err;
+        if( first_sample_number - entry_sample_number < run_count )
+            break;
+        entry_sample_number += run_count;
+        entry_dts           += (uint64_t)duration * run_count;
+        entry                = entry->next;
+    }
+    /* Write timestamps run by run. */
+    uint32_t skip = first_sample_number - entry_sample_number;
+    uint64_t time = entry_dts + (uint64_t)duration * skip;
+    uint32_t i    = 0;
+    while( 1 )
+    {
+        uint32_t n = LSMASH_MIN( run_count - skip, sample_count - i );
+        if( dts )
+            for( uint32_t j = 0; j < n; j++ )
+                dts[i + j] = time + (uint64_t)duration * j;
+        if( cts )
+        {
+            uint64_t cts_base = timeline->ctd_shift ? (time + (int32_t)offset) : (time + offset);
+            for( uint32_t j = 0; j < n; j++ )
+                cts[i + j] = cts_base + (uint64_t)duration * j;
+        }
+        time += (uint64_t)duration * n;
+        i    += n;
+        if( i == sample_count )
+            break;
+        entry_sample_number += run_count;
+        entry_dts           += (uint64_t)duration * run_count;
+        entry                = entry->next;
+        skip                 = 0;
+        if( (err = isom_get_timestamp_run( timeline, entry, &run_count, &duration, &offset )) < 0 )
+            return err;
+    }
+    timeline->last_exported_entry               = entry;
+    timeline->last_exported_entry_sample_number = entry_sample_number;
+    timeline->last_exported_entry_dts           = entry_dts;
+    return 0;
+}
+
 void lsmash_delete_media_timestamps( lsmash_media_ts_list_t *ts_list )
 {
     if( !ts_list )
@@ -2042,36 +2583,125 @@ void lsmash_delete_media_timestamps( lsmash_media_ts_list_t *ts_list )
     ts_list->sample_count = 0;
 }
 
+/* Timestamps are ordered as signed integers as lsmash_compare_dts() and lsmash_compare_cts() do
+ * since negative values such as POCs may be stored in them. */
+#define ISOM_TS_KEY( ts, key_offset ) (*(uint64_t *)((uint8_t *)(ts) + (key_offset)))
+#define ISOM_TS_LESS( a, b ) ((int64_t)(a) < (int64_t)(b))
+
+/* Timestamps in a list are usually in order or out of order only within a short distance.
+ * Insertion sort handles such lists in linear time, so try it at first and give it up
+ * when the list turns out to be shuffled a lot. */
+#define ISOM_TS_INSERTION_SORT_MAX_SHIFTS( count ) (8 * (uint64_t)(count) + 1024)
+
+static int isom_insertion_sort_timestamps( lsmash_media_ts_t *ts, uint32_t count, size_t key_offset )
+{
+    uint64_t max_shifts = ISOM_TS_INSERTION_SORT_MAX_SHIFTS( count );
+    uint64_t shifts     = 0;
+    for( uint32_t i = 1; i < count; i++ )
+    {
+        uint64_t key = ISOM_TS_KEY( &ts[i], key_offset );
+        if( !ISOM_TS_LESS( key, ISOM_TS_KEY( &ts[i - 1], key_offset ) ) )
+            continue;
+        lsmash_media_ts_t temp = ts[i];
+        uint32_t j = i;
+        do
+            ts[j] = ts[j - 1];
+        while( --j && ISOM_TS_LESS( key, ISOM_TS_KEY( &ts[j - 1], key_offset ) ) );
+        ts[j] = temp;
+        shifts += i - j;
+        if( shifts > max_shifts )
+            return 0;
+    }
+    return 1;
+}
+
+/* LSD radix sort by 8 bits, which skips the digits shared by all the keys. */
+static int isom_radix_sort_timestamps( lsmash_media_ts_t *ts, uint32_t count, size_t key_offset )
+{
+    lsmash_media_ts_t *temp = lsmash_malloc( count * sizeof(lsmash_media_ts_t) );
+    if( !temp )
+        return LSMASH_ERR_MEMORY_ALLOC;
+    uint32_t (*histogram)[256] = lsmash_malloc_zero( 8 * sizeof(*histogram) );
+    if( !histogram )
+    {
+        lsmash_free( temp );
+        return LSMASH_ERR_MEMORY_ALLOC;
+    }
+    for( uint32_t i = 0; i < count; i++ )
+    {
+        uint64_t key = ISOM_TS_KEY( &ts[i], key_offset ) ^ 0x8000000000000000ULL;
+        for( int digit = 0; digit < 8; digit++ )
+            ++histogram[digit][(key >> (8 * digit)) & 0xff];
+    }
+    lsmash_media_ts_t *src = ts;
+    lsmash_media_ts_t *dst = temp;
+    for( int digit = 0; digit < 8; digit++ )
+    {
+        uint32_t *bucket = histogram[digit];
+        int shift = 8 * digit;
+        if( bucket[(ISOM_TS_KEY( &src[0], key_offset ) ^ 0x8000000000000000ULL) >> shift & 0xff] == count )
+            continue;   /* All the keys have the same value at this digit. */
+        uint32_t offset = 0;
+        for( int i = 0; i < 256; i++ )
+        {
+            uint32_t n = bucket[i];
+            bucket[i] = offset;
+            offset += n;
+        }
+        for( uint32_t i = 0; i < count; i++ )
+        {
+            uint64_t key = ISOM_TS_KEY( &src[i], key_offset ) ^ 0x8000000000000000ULL;
+            dst[ bucket[(key >> shift) & 0xff]++ ] = src[i];
+        }
+        lsmash_media_ts_t *swap = src;
+        src = dst;
+        dst = swap;
+    }
+    if( src != ts )
+        memcpy( ts, src, count * sizeof(lsmash_media_ts_t) );
+    lsmash_free( histogram );
+    lsmash_free( temp );
+    return 0;
+}
+
 static int isom_compare_dts( const lsmash_media_ts_t *a, const lsmash_media_ts_t *b )
 {
     int64_t diff = (int64_t)(a->dts - b->dts);
     return diff > 0 ? 1 : (diff == 0 ? 0 : -1);
 }
 
-void lsmash_sort_timestamps_decoding_order( lsmash_media_ts_list_t *ts_list )
+static int isom_compare_cts( const lsmash_media_ts_t *a, const lsmash_media_ts_t *b )
 {
-    if( !ts_list )
+    int64_t diff = (int64_t)(a->cts - b->cts);
+    return diff > 0 ? 1 : (diff == 0 ? 0 : -1);
+}
+
+static void isom_sort_timestamps( lsmash_media_ts_list_t *ts_list, size_t key_offset )
+{
+    if( !ts_list || !ts_list->timestamp || ts_list->sample_count < 2 )
+        return;
+    lsmash_media_ts_t *ts    = ts_list->timestamp;
+    uint32_t           count = ts_list->sample_count;
+    if( isom_insertion_sort_timestamps( ts, count, key_offset )
+     || isom_radix_sort_timestamps( ts, count, key_offset ) == 0 )
         return;
-    qsort( ts_list->timestamp, ts_list->sample_count, sizeof(lsmash_media_ts_t), (int(*)( const void *, const void * ))isom_compare_dts );
+    /* Fall back to the sort without extra memory. */
+    qsort( ts, count, sizeof(lsmash_media_ts_t), (int(*)( const void *, const void * ))
+           (key_offset == offsetof( lsmash_media_ts_t, dts ) ? isom_compare_dts : isom_compare_cts) );
 }
 
-static int isom_compare_cts( const lsmash_media_ts_t *a, const lsmash_media_ts_t *b )
+void lsmash_sort_timestamps_decoding_order( lsmash_media_ts_list_t *ts_list )
 {
-    int64_t diff = (int64_t)(a->cts - b->cts);
-    return diff > 0 ? 1 : (diff == 0 ? 0 : -1);
+    isom_sort_timestamps( ts_list, offsetof( lsmash_media_ts_t, dts ) );
 }
 
 void lsmash_sort_timestamps_composition_order( lsmash_media_ts_list_t *ts_list )
 {
-    if( !ts_list )
-        return;
-    qsort( ts_list->timestamp, ts_list->sample_count, sizeof(lsmash_media_ts_t), (int(*)( const void *, const void * ))isom_compare_cts );
+    isom_sort_timestamps( ts_list, offsetof( lsmash_media_ts_t, cts ) );
 }
 
-int lsmash_get_max_sample_delay( lsmash_media_ts_list_t *ts_list, uint32_t *max_sample_delay )
+static int isom_get_max_sample_delay_by_sort( lsmash_media_ts_list_t *ts_list, uint32_t *max_sample_delay )
 {
-    if( !ts_list || !max_sample_delay )
-        return LSMASH_ERR_FUNCTION_PARAM;
     lsmash_media_ts_t *orig_ts = ts_list->timestamp;
     lsmash_media_ts_t *ts = lsmash_malloc( ts_list->sample_count * sizeof(lsmash_media_ts_t) );
     if( !ts )
@@ -2094,3 +2724,70 @@ int lsmash_get_max_sample_delay( lsmash_media_ts_list_t *ts_list, uint32_t *max_
     ts_list->timestamp = orig_ts;
     return 0;
 }
+
+/* The number of the greatest CTSs kept to get the maximum sample delay in a single pass.
+ * This has to be larger than the reordering depth of the stream. */
+#define ISOM_SAMPLE_DELAY_WINDOW 256
+
+int lsmash_get_max_sample_delay( lsmash_media_ts_list_t *ts_list, uint32_t *max_sample_delay )
+{
+    if( !ts_list || !max_sample_delay )
+        return LSMASH_ERR_FUNCTION_PARAM;
+    /* The maximum sample delay is equal to the maximum number of the preceding samples in decoding order
+     * whose CTSs are greater than the CTS of a sample.
+     * Count them with the sorted window of the greatest CTSs seen so far.
+     * Any CTS evicted from the window is less than the CTSs in the window, so it never gets counted
+     * as long as the following CTSs are greater than the evicted ones. */
+    uint64_t window[2 * ISOM_SAMPLE_DELAY_WINDOW];
+    uint32_t start         = 0;
+    uint32_t window_count  = 0;
+    int      evicted       = 0;
+    uint64_t evicted_max   = 0;
+    uint32_t max_delay     = 0;
+    for( uint32_t i = 0; i < ts_list->sample_count; i++ )
+    {
+        uint64_t cts = ts_list->timestamp[i].cts;
+        if( evicted && !ISOM_TS_LESS( evicted_max, cts ) )
+            /* The reordering is deeper than the window. */
+            return isom_get_max_sample_delay_by_sort( ts_list, max_sample_delay );
+        /* Find the first CTS greater than this CTS. */
+        uint64_t *sorted = &window[start];
+        uint32_t  lo     = 0;
+        uint32_t  hi     = window_count;
+        while( lo < hi )
+        {
+            uint32_t mid = (lo + hi) / 2;
+            if( ISOM_TS_LESS( cts, sorted[mid] ) )
+                hi = mid;
+            else
+                lo = mid + 1;
+        }
+        max_delay = LSMASH_MAX( max_delay, window_count - lo );
+        if( window_count == ISOM_SAMPLE_DELAY_WINDOW )
+        {
+            evicted = 1;
+            if( lo == 0 )
+            {
+                /* This CTS is the least. */
+                evicted_max = cts;
+                continue;
+            }
+            evicted_max = sorted[0];
+            ++start;
+            --window_count;
+            --lo;
+            sorted = &window[start];
+        }
+        if( start + window_count == 2 * ISOM_SAMPLE_DELAY_WINDOW )
+        {
+            memmove( window, sorted, window_count * sizeof(uint64_t) );
+            start  = 0;
+            sorted = window;
+        }
+        memmove( &sorted[lo + 1], &sorted[lo], (window_count - lo) * sizeof(uint64_t) );
+        sorted[lo] = cts;
+        ++window_count;
+    }
+    *max_sample_delay = max_delay;
+    return 0;
+}
@@ -116,6 +116,27 @@ int isom_timeline_construct
     uint32_t       track_ID
 );
 
+/* Rebuild the Decoding Time to Sample Box and the Composition Time to Sample Box of a track
+ * from its media timeline. The duration of the last sample is set to 'last_sample_delta'. */
+int isom_timeline_rebuild_timing_boxes
+(
+    isom_timeline_t *timeline,
+    isom_trak_t     *trak,
+    uint32_t        *last_sample_delta
+);
+
+/* Get the first sample decoded at 'dts' or later, which is also random accessible if 'random_accessible' is set.
+ * The sample is found by a binary search on a sparse index of the decoding times, and the following access to it
+ * and the samples after it costs no walk from the first sample. '*sample_number' is set to 0 if there is no such sample. */
+int isom_timeline_seek_dts
+(
+    isom_timeline_t *timeline,
+    uint64_t         dts,
+    int              random_accessible,
+    uint32_t        *sample_number,
+    uint64_t        *sample_dts
+);
+
 int isom_add_lpcm_bunch_entry
 (
     isom_timeline_t   *timeline,
@@ -25,5 +25,6 @@
 
 int isom_write_box( lsmash_bs_t *bs, isom_box_t *box );
 void isom_set_box_writer( isom_box_t *box );
+void isom_complement_box_writers( isom_box_t *box );
 
 #endif
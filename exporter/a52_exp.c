@@ -0,0 +1,74 @@
+/*****************************************************************************
+ * a52_exp.c
+ *****************************************************************************
+ * Copyright (C) 2015 L-SMASH project
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ * ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ *****************************************************************************/
+
+/* This file is available under an ISC license. */
+
+#include "common/internal.h" /* must be placed first */
+
+#define LSMASH_EXPORTER_INTERNAL
+#include "exporter.h"
+
+/***************************************************************************
+    AC-3 / Enhanced AC-3 exporter
+    ETSI TS 102 366 V1.2.1 (2008-08)
+    Every sample consists of syncframes as they are in the bitstream,
+    so the samples are just concatenated.
+***************************************************************************/
+static int a52_exporter_write_sample( exporter_t *exporter, lsmash_sample_t *sample )
+{
+    lsmash_bs_put_bytes( exporter->bs, sample->length, sample->data );
+    return lsmash_bs_is_error( exporter->bs ) ? LSMASH_ERR_MEMORY_ALLOC : 0;
+}
+
+static void a52_exporter_cleanup( exporter_t *exporter )
+{
+    /* Nothing to do. */
+}
+
+static int ac3_exporter_probe( exporter_t *exporter, lsmash_summary_t *summary )
+{
+    if( !lsmash_check_codec_type_identical( summary->sample_type, ISOM_CODEC_TYPE_AC_3_AUDIO )
+     && !lsmash_check_codec_type_identical( summary->sample_type,   QT_CODEC_TYPE_AC_3_AUDIO ) )
+        return LSMASH_ERR_INVALID_DATA;
+    return 0;
+}
+
+const exporter_functions ac3_exporter =
+{
+    { "AC-3", offsetof( exporter_t, log_level ) },
+    ac3_exporter_probe,
+    a52_exporter_write_sample,
+    NULL,
+    a52_exporter_cleanup
+};
+
+static int eac3_exporter_probe( exporter_t *exporter, lsmash_summary_t *summary )
+{
+    if( !lsmash_check_codec_type_identical( summary->sample_type, ISOM_CODEC_TYPE_EC_3_AUDIO ) )
+        return LSMASH_ERR_INVALID_DATA;
+    return 0;
+}
+
+const exporter_functions eac3_exporter =
+{
+    { "Enhanced AC-3", offsetof( exporter_t, log_level ) },
+    eac3_exporter_probe,
+    a52_exporter_write_sample,
+    NULL,
+    a52_exporter_cleanup
+};
@@ -0,0 +1,137 @@
+/*****************************************************************************
+ * adts_exp.c
+ *****************************************************************************
+ * Copyright (C) 2015 L-SMASH project
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ * ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ *****************************************************************************/
+
+/* This file is available under an ISC license. */
+
+#include "common/internal.h" /* must be placed first */
+
+#define LSMASH_EXPORTER_INTERNAL
+#include "exporter.h"
+
+/***************************************************************************
+    ADTS exporter
+    ISO/IEC 14496-3 1.A.2.2 Audio_Data_Transport_Stream frame, ADTS
+    Every sample is put as a single raw_data_block() without CRC.
+***************************************************************************/
+#include "codecs/mp4a.h"
+
+#define ADTS_HEADER_LENGTH     7
+#define ADTS_MAX_FRAME_LENGTH  8191     /* the maximum value of 13-bit frame_length */
+
+typedef struct
+{
+    uint8_t profile_ObjectType;
+    uint8_t sampling_frequency_index;
+    uint8_t channel_configuration;
+} mp4sys_adts_exporter_t;
+
+static void mp4sys_adts_exporter_cleanup( exporter_t *exporter )
+{
+    lsmash_freep( &exporter->info );
+}
+
+static int mp4sys_adts_exporter_probe( exporter_t *exporter, lsmash_summary_t *summary )
+{
+    if( !lsmash_check_codec_type_identical( summary->sample_type, ISOM_CODEC_TYPE_MP4A_AUDIO )
+     && !lsmash_check_codec_type_identical( summary->sample_type,   QT_CODEC_TYPE_MP4A_AUDIO ) )
+        return LSMASH_ERR_INVALID_DATA;
+    lsmash_codec_specific_t *specific = isom_get_codec_specific( summary->opaque, LSMASH_CODEC_SPECIFIC_DATA_TYPE_MP4SYS_DECODER_CONFIG );
+    if( !specific )
+    {
+        lsmash_log( exporter, LSMASH_LOG_ERROR, "the decoder configuration is not found.\n" );
+        return LSMASH_ERR_INVALID_DATA;
+    }
+    lsmash_codec_specific_t *cs = lsmash_convert_codec_specific_format( specific, LSMASH_CODEC_SPECIFIC_FORMAT_STRUCTURED );
+    if( !cs )
+        return LSMASH_ERR_NAMELESS;
+    uint8_t *dsi_payload;
+    uint32_t dsi_payload_length;
+    mp4sys_adts_exporter_t param;
+    int err = lsmash_get_mp4sys_decoder_specific_info( (lsmash_mp4sys_decoder_parameters_t *)cs->data.structured,
+                                                       &dsi_payload, &dsi_payload_length );
+    lsmash_destroy_codec_specific_data( cs );
+    if( err < 0 )
+        return err;
+    if( !dsi_payload )
+    {
+        lsmash_log( exporter, LSMASH_LOG_ERROR, "AudioSpecificConfig is not found.\n" );
+        return LSMASH_ERR_INVALID_DATA;
+    }
+    err = mp4a_get_adts_fixed_header_parameters( dsi_payload, dsi_payload_length,
+                                                 &param.profile_ObjectType,
+                                                 &param.sampling_frequency_index,
+                                                 &param.channel_configuration );
+    lsmash_free( dsi_payload );
+    if( err < 0 )
+    {
+        lsmash_log( exporter, LSMASH_LOG_ERROR, "the audio object type or the channel configuration cannot be signaled by ADTS.\n" );
+        return err;
+    }
+    mp4sys_adts_exporter_t *adts_exp = (mp4sys_adts_exporter_t *)exporter->info;
+    if( !adts_exp )
+    {
+        adts_exp = (mp4sys_adts_exporter_t *)lsmash_malloc( sizeof(mp4sys_adts_exporter_t) );
+        if( !adts_exp )
+            return LSMASH_ERR_MEMORY_ALLOC;
+        exporter->info = adts_exp;
+    }
+    *adts_exp = param;
+    return 0;
+}
+
+static int mp4sys_adts_exporter_write_sample( exporter_t *exporter, lsmash_sample_t *sample )
+{
+    mp4sys_adts_exporter_t *adts_exp = (mp4sys_adts_exporter_t *)exporter->info;
+    if( !adts_exp )
+        return LSMASH_ERR_NAMELESS;
+    uint32_t frame_length = ADTS_HEADER_LENGTH + sample->length;
+    if( frame_length > ADTS_MAX_FRAME_LENGTH )
+    {
+        lsmash_log( exporter, LSMASH_LOG_ERROR, "a sample is too large to be put into an ADTS frame.\n" );
+        return LSMASH_ERR_INVALID_DATA;
+    }
+    uint8_t header[ADTS_HEADER_LENGTH];
+    /* adts_fixed_header()
+     *   syncword = 0xFFF, ID = 0 (MPEG-4), layer = 0, protection_absent = 1, private_bit = 0,
+     *   original_copy = 0, home = 0
+     * adts_variable_header()
+     *   copyright_identification_bit = 0, copyright_identification_start = 0,
+     *   adts_buffer_fullness = 0x7FF (variable rate), number_of_raw_data_blocks_in_frame = 0 */
+    header[0] = 0xFF;
+    header[1] = 0xF1;
+    header[2] = (adts_exp->profile_ObjectType << 6)
+              | (adts_exp->sampling_frequency_index << 2)
+              | (adts_exp->channel_configuration >> 2);
+    header[3] = ((adts_exp->channel_configuration & 0x3) << 6)
+              | (frame_length >> 11);
+    header[4] = (frame_length >> 3) & 0xFF;
+    header[5] = ((frame_length & 0x7) << 5) | 0x1F;
+    header[6] = 0xFC;
+    lsmash_bs_put_bytes( exporter->bs, ADTS_HEADER_LENGTH, header );
+    lsmash_bs_put_bytes( exporter->bs, sample->length, sample->data );
+    return lsmash_bs_is_error( exporter->bs ) ? LSMASH_ERR_MEMORY_ALLOC : 0;
+}
+
+const exporter_functions mp4sys_adts_exporter =
+{
+    { "adts", offsetof( exporter_t, log_level ) },
+    mp4sys_adts_exporter_probe,
+    mp4sys_adts_exporter_write_sample,
+    NULL,
+    mp4sys_adts_exporter_cleanup
+};
@@ -0,0 +1,61 @@
+/*****************************************************************************
+ * dts_exp.c
+ *****************************************************************************
+ * Copyright (C) 2015 L-SMASH project
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ * ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ *****************************************************************************/
+
+/* This file is available under an ISC license. */
+
+#include "common/internal.h" /* must be placed first */
+
+#define LSMASH_EXPORTER_INTERNAL
+#include "exporter.h"
+
+/***************************************************************************
+    DTS exporter
+    ETSI TS 102 114 V1.4.1 (2012-09)
+    Every sample consists of a core substream and/or extension substreams
+    as they are in the bitstream, so the samples are just concatenated.
+***************************************************************************/
+static int dts_exporter_probe( exporter_t *exporter, lsmash_summary_t *summary )
+{
+    lsmash_codec_type_t sample_type = summary->sample_type;
+    if( !lsmash_check_codec_type_identical( sample_type, ISOM_CODEC_TYPE_DTSC_AUDIO )
+     && !lsmash_check_codec_type_identical( sample_type, ISOM_CODEC_TYPE_DTSH_AUDIO )
+     && !lsmash_check_codec_type_identical( sample_type, ISOM_CODEC_TYPE_DTSL_AUDIO )
+     && !lsmash_check_codec_type_identical( sample_type, ISOM_CODEC_TYPE_DTSE_AUDIO ) )
+        return LSMASH_ERR_INVALID_DATA;
+    return 0;
+}
+
+static int dts_exporter_write_sample( exporter_t *exporter, lsmash_sample_t *sample )
+{
+    lsmash_bs_put_bytes( exporter->bs, sample->length, sample->data );
+    return lsmash_bs_is_error( exporter->bs ) ? LSMASH_ERR_MEMORY_ALLOC : 0;
+}
+
+static void dts_exporter_cleanup( exporter_t *exporter )
+{
+    /* Nothing to do. */
+}
+
+const exporter_functions dts_exporter =
+{
+    { "DTS Coherent Acoustics", offsetof( exporter_t, log_level ) },
+    dts_exporter_probe,
+    dts_exporter_write_sample,
+    NULL,
+    dts_exporter_cleanup
+};
@@ -0,0 +1,209 @@
+/*****************************************************************************
+ * exporter.c
+ *****************************************************************************
+ * Copyright (C) 2015 L-SMASH project
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ * ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ *****************************************************************************/
+
+/* This file is available under an ISC license. */
+
+#include "common/internal.h" /* must be placed first */
+
+#include <string.h>
+
+#define LSMASH_EXPORTER_INTERNAL
+#include "exporter.h"
+
+/***************************************************************************
+    exporter classes
+***************************************************************************/
+static const lsmash_class_t lsmash_exporter_class =
+{
+    "exporter",
+    offsetof( exporter_t, log_level )
+};
+
+extern const exporter_functions h264_exporter;
+extern const exporter_functions hevc_exporter;
+extern const exporter_functions mp4sys_adts_exporter;
+extern const exporter_functions ac3_exporter;
+extern const exporter_functions eac3_exporter;
+extern const exporter_functions dts_exporter;
+extern const exporter_functions wave_exporter;
+
+/******** exporter listing table ********/
+static const exporter_functions *exporter_func_table[] =
+{
+    &h264_exporter,
+    &hevc_exporter,
+    &mp4sys_adts_exporter,
+    &ac3_exporter,
+    &eac3_exporter,
+    &dts_exporter,
+    &wave_exporter,
+    NULL,
+};
+
+/***************************************************************************
+    exporter public interfaces
+***************************************************************************/
+
+/******** exporter public functions ********/
+static void exporter_destroy( exporter_t *exporter )
+{
+    if( !exporter )
+        return;
+    if( exporter->funcs.cleanup )
+        exporter->funcs.cleanup( exporter );
+    lsmash_bs_cleanup( exporter->bs );
+    lsmash_free( exporter->format );
+    lsmash_free( exporter );
+}
+
+void lsmash_exporter_close( exporter_t *exporter )
+{
+    if( !exporter )
+        return;
+    if( !exporter->is_stdout )
+        lsmash_close_file( &exporter->file_param );
+    else
+        fflush( stdout );
+    exporter_destroy( exporter );
+}
+
+exporter_t *lsmash_exporter_open( const char *identifier, const char *format )
+{
+    if( identifier == NULL )
+        return NULL;
+    exporter_t *exporter = (exporter_t *)lsmash_malloc_zero( sizeof(exporter_t) );
+    if( !exporter )
+        return NULL;
+    exporter->class     = &lsmash_exporter_class;
+    exporter->log_level = LSMASH_LOG_INFO;
+    if( format && strcmp( format, "auto" ) )
+    {
+        exporter->format = lsmash_malloc( strlen( format ) + 1 );
+        if( !exporter->format )
+            goto fail;
+        strcpy( exporter->format, format );
+    }
+    /* Open an output 'stream'. */
+    exporter->is_stdout = !strcmp( identifier, "-" );
+    if( lsmash_open_file( identifier, 0, &exporter->file_param ) < 0 )
+    {
+        lsmash_log( exporter, LSMASH_LOG_ERROR, "failed to open %s.\n", identifier );
+        goto fail;
+    }
+    exporter->bs = lsmash_bs_create();
+    if( !exporter->bs )
+        goto fail;
+    exporter->bs->stream     = exporter->file_param.opaque;
+    exporter->bs->write      = exporter->file_param.write;
+    exporter->bs->seek       = exporter->file_param.seek;
+    exporter->bs->unseekable = (exporter->file_param.seek == NULL);
+    exporter->bs->buffer.max_size = EXPORTER_WRITE_BUFFER_SIZE;
+    return exporter;
+fail:
+    lsmash_exporter_close( exporter );
+    return NULL;
+}
+
+static int exporter_find( exporter_t *exporter, lsmash_summary_t *summary )
+{
+    /* Any error log is confusing for the probe step. */
+    exporter->log_level = exporter->format ? LSMASH_LOG_INFO : LSMASH_LOG_QUIET;
+    const exporter_functions *funcs;
+    int err = LSMASH_ERR_NAMELESS;
+    for( int i = 0; (funcs = exporter_func_table[i]) != NULL; i++ )
+    {
+        if( exporter->format && strcmp( funcs->class.name, exporter->format ) )
+            continue;
+        exporter->class = &funcs->class;
+        if( (err = funcs->probe( exporter, summary )) == 0 )
+            break;
+        if( exporter->format )
+        {
+            funcs = NULL;
+            break;
+        }
+    }
+    exporter->log_level = LSMASH_LOG_INFO;
+    if( !funcs )
+    {
+        exporter->class = &lsmash_exporter_class;
+        lsmash_log( exporter, LSMASH_LOG_ERROR, "failed to find the matched exporter.\n" );
+        return err < 0 ? err : LSMASH_ERR_NAMELESS;
+    }
+    exporter->funcs = *funcs;
+    return 0;
+}
+
+int lsmash_exporter_set_summary( exporter_t *exporter, lsmash_summary_t *summary )
+{
+    if( !exporter || !summary || exporter->finished )
+        return LSMASH_ERR_FUNCTION_PARAM;
+    if( !exporter->funcs.probe )
+        return exporter_find( exporter, summary );
+    /* The sample description changed, so set up the same exporter by the new one. */
+    return exporter->funcs.probe( exporter, summary );
+}
+
+/* Write out the buffered data in large units. */
+static int exporter_write_buffer( exporter_t *exporter )
+{
+    lsmash_bs_t *bs = exporter->bs;
+    if( lsmash_bs_is_error( bs ) )
+        return LSMASH_ERR_NAMELESS;
+    if( lsmash_bs_get_valid_data_size( bs ) < EXPORTER_WRITE_BUFFER_SIZE )
+        return 0;
+    return lsmash_bs_flush_buffer( bs );
+}
+
+int lsmash_exporter_write_sample( exporter_t *exporter, lsmash_sample_t *sample )
+{
+    if( !exporter || !sample || (sample->length && !sample->data) )
+        return LSMASH_ERR_FUNCTION_PARAM;
+    if( !exporter->funcs.write_sample || exporter->finished )
+        return LSMASH_ERR_NAMELESS;
+    int err = exporter->funcs.write_sample( exporter, sample );
+    if( err < 0 )
+        return err;
+    return exporter_write_buffer( exporter );
+}
+
+int lsmash_exporter_finish( exporter_t *exporter )
+{
+    if( !exporter )
+        return LSMASH_ERR_FUNCTION_PARAM;
+    if( exporter->finished )
+        return 0;
+    exporter->finished = 1;
+    int err;
+    if( (err = lsmash_bs_flush_buffer( exporter->bs )) < 0 )
+        return err;
+    if( exporter->funcs.finish
+     && (err = exporter->funcs.finish( exporter )) < 0 )
+        return err;
+    if( (err = lsmash_bs_flush_buffer( exporter->bs )) < 0 )
+        return err;
+    /* Detect the failure of writing here rather than at closing the stream. */
+    return fflush( (FILE *)exporter->file_param.opaque ) == 0 ? 0 : LSMASH_ERR_UNKNOWN;
+}
+
+const char *lsmash_exporter_get_name( exporter_t *exporter )
+{
+    if( !exporter || !exporter->class )
+        return NULL;
+    return exporter->class->name;
+}
@@ -0,0 +1,114 @@
+/*****************************************************************************
+ * exporter.h:
+ *****************************************************************************
+ * Copyright (C) 2015 L-SMASH project
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ * ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ *****************************************************************************/
+
+/* This file is available under an ISC license. */
+
+#ifndef LSMASH_EXPORTER_H
+#define LSMASH_EXPORTER_H
+
+/***************************************************************************
+    exporter
+    The inverse of the importer: samples of a track are written out as an
+    elementary stream which a decoder can take directly.
+***************************************************************************/
+typedef struct exporter_tag exporter_t;
+
+#ifdef LSMASH_EXPORTER_INTERNAL
+
+#include "core/box.h"
+#include "codecs/description.h"
+
+/* Output is accumulated on the buffer and written into the stream in units of this size at least. */
+#define EXPORTER_WRITE_BUFFER_SIZE (4 * 1024 * 1024)
+
+typedef void ( *exporter_cleanup )     ( exporter_t * );
+typedef int  ( *exporter_probe )       ( exporter_t *, lsmash_summary_t * );
+typedef int  ( *exporter_write_sample )( exporter_t *, lsmash_sample_t * );
+typedef int  ( *exporter_finish )      ( exporter_t * );
+
+typedef struct
+{
+    lsmash_class_t        class;
+    exporter_probe        probe;        /* Check if the summary can be exported, and set up the exporter by it.
+                                         * This is called again with another summary when the sample description changes. */
+    exporter_write_sample write_sample;
+    exporter_finish       finish;       /* optional, called once after the last sample */
+    exporter_cleanup      cleanup;
+} exporter_functions;
+
+struct exporter_tag
+{
+    const lsmash_class_t    *class;
+    lsmash_log_level         log_level;
+    lsmash_bs_t             *bs;
+    lsmash_file_parameters_t file_param;
+    int                      is_stdout;
+    void                    *info;      /* exporter internal status information. */
+    exporter_functions       funcs;
+    char                    *format;    /* the name of the exporter to be used, or NULL for auto detection */
+    int                      finished;
+};
+
+#else
+
+/* exporting functions */
+exporter_t *lsmash_exporter_open
+(
+    const char *identifier,     /* the output file name, or "-" for stdout */
+    const char *format          /* the name of the exporter, or NULL or "auto" to pick one by the summary */
+);
+
+void lsmash_exporter_close
+(
+    exporter_t *exporter
+);
+
+/* Set the description of the samples to be exported.
+ * Call this before the first sample and every time the sample description changes.
+ *
+ * Return 0 if successful.
+ * Return a negative value otherwise, e.g. the summary cannot be exported in the format. */
+int lsmash_exporter_set_summary
+(
+    exporter_t       *exporter,
+    lsmash_summary_t *summary
+);
+
+/* Write a sample in decoding order.
+ * The sample is not deallocated by this function. */
+int lsmash_exporter_write_sample
+(
+    exporter_t      *exporter,
+    lsmash_sample_t *sample
+);
+
+/* Flush the rest of the output and complete the headers if any.
+ * The stream shall be flushed by this function before closing, otherwise the output may be truncated. */
+int lsmash_exporter_finish
+(
+    exporter_t *exporter
+);
+
+const char *lsmash_exporter_get_name
+(
+    exporter_t *exporter
+);
+
+#endif /* #ifdef LSMASH_EXPORTER_INTERNAL */
+
+#endif /* #ifndef LSMASH_EXPORTER_H */
@@ -0,0 +1,265 @@
+/*****************************************************************************
+ * nalu_exp.c
+ *****************************************************************************
+ * Copyright (C) 2015 L-SMASH project
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ * ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ *****************************************************************************/
+
+/* This file is available under an ISC license. */
+
+#include "common/internal.h" /* must be placed first */
+
+#include <string.h>
+
+#define LSMASH_EXPORTER_INTERNAL
+#include "exporter.h"
+
+/***************************************************************************
+    NAL unit stream exporter
+    Convert length-prefixed NAL units into the byte stream format specified
+    in ITU-T Rec. H.264 / H.265 Annex B. The parameter sets in the decoder
+    configuration record are put in-band before every random access point
+    so that decoding can start there.
+***************************************************************************/
+#include "codecs/h264.h"
+#include "codecs/hevc.h"
+#include "codecs/nalu.h"
+
+#define NALU_START_CODE 0x00000001
+
+typedef struct
+{
+    uint32_t length_size;       /* the size of NALUnitLength field */
+    uint8_t *ps;                /* the parameter sets in the byte stream format */
+    uint32_t ps_length;
+    int      ps_pending;        /* If set to 1, the parameter sets are put before the next sample. */
+    uint8_t  aud_type;          /* nal_unit_type of Access Unit Delimiter */
+    uint8_t  nalu_type_shift;   /* the number of bits following nal_unit_type in the first byte of NAL unit header */
+    uint8_t  nalu_type_mask;
+} nalu_exporter_t;
+
+static void remove_nalu_exporter( nalu_exporter_t *nalu_exp )
+{
+    if( !nalu_exp )
+        return;
+    lsmash_free( nalu_exp->ps );
+    lsmash_free( nalu_exp );
+}
+
+static void nalu_exporter_cleanup( exporter_t *exporter )
+{
+    remove_nalu_exporter( exporter->info );
+    exporter->info = NULL;
+}
+
+static int nalu_exporter_append_ps_list( lsmash_bs_t *bs, lsmash_entry_list_t *ps_list )
+{
+    for( lsmash_entry_t *entry = ps_list ? ps_list->head : NULL; entry; entry = entry->next )
+    {
+        isom_dcr_ps_entry_t *ps = (isom_dcr_ps_entry_t *)entry->data;
+        if( !ps )
+            return LSMASH_ERR_NAMELESS;
+        if( ps->unused )
+            continue;
+        lsmash_bs_put_be32( bs, NALU_START_CODE );
+        lsmash_bs_put_bytes( bs, ps->nalUnitLength, ps->nalUnit );
+    }
+    return 0;
+}
+
+/* Set up the exporter by the parameter sets in the given lists in order.
+ * Even if the exporter is already set up by another summary, it is just updated. */
+static int nalu_exporter_setup
+(
+    exporter_t           *exporter,
+    uint32_t              length_size,
+    lsmash_entry_list_t **ps_lists,
+    int                   ps_list_count,
+    uint8_t               aud_type,
+    uint8_t               nalu_type_shift,
+    uint8_t               nalu_type_mask
+)
+{
+    if( length_size == 0 || length_size > 4 )
+        return LSMASH_ERR_INVALID_DATA;
+    lsmash_bs_t *bs = lsmash_bs_create();
+    if( !bs )
+        return LSMASH_ERR_MEMORY_ALLOC;
+    int err = 0;
+    for( int i = 0; i < ps_list_count; i++ )
+        if( (err = nalu_exporter_append_ps_list( bs, ps_lists[i] )) < 0 )
+            goto fail;
+    nalu_exporter_t *nalu_exp = (nalu_exporter_t *)exporter->info;
+    if( !nalu_exp )
+    {
+        nalu_exp = (nalu_exporter_t *)lsmash_malloc_zero( sizeof(nalu_exporter_t) );
+        if( !nalu_exp )
+        {
+            err = LSMASH_ERR_MEMORY_ALLOC;
+            goto fail;
+        }
+        exporter->info = nalu_exp;
+    }
+    lsmash_freep( &nalu_exp->ps );
+    nalu_exp->ps_length = 0;
+    if( lsmash_bs_get_valid_data_size( bs ) )
+    {
+        nalu_exp->ps = lsmash_bs_export_data( bs, &nalu_exp->ps_length );
+        if( !nalu_exp->ps )
+        {
+            err = LSMASH_ERR_MEMORY_ALLOC;
+            goto fail;
+        }
+    }
+    nalu_exp->length_size     = length_size;
+    nalu_exp->ps_pending      = 1;
+    nalu_exp->aud_type        = aud_type;
+    nalu_exp->nalu_type_shift = nalu_type_shift;
+    nalu_exp->nalu_type_mask  = nalu_type_mask;
+fail:
+    lsmash_bs_cleanup( bs );
+    return err;
+}
+
+static lsmash_codec_specific_t *nalu_exporter_get_structured_specific
+(
+    exporter_t                     *exporter,
+    lsmash_summary_t               *summary,
+    lsmash_codec_specific_data_type type
+)
+{
+    lsmash_codec_specific_t *specific = isom_get_codec_specific( summary->opaque, type );
+    if( !specific )
+    {
+        lsmash_log( exporter, LSMASH_LOG_ERROR, "the decoder configuration record is not found.\n" );
+        return NULL;
+    }
+    /* Always return an allocated copy so that the caller can deallocate it without any check. */
+    return lsmash_convert_codec_specific_format( specific, LSMASH_CODEC_SPECIFIC_FORMAT_STRUCTURED );
+}
+
+static int nalu_exporter_write_sample( exporter_t *exporter, lsmash_sample_t *sample )
+{
+    nalu_exporter_t *nalu_exp = (nalu_exporter_t *)exporter->info;
+    if( !nalu_exp )
+        return LSMASH_ERR_NAMELESS;
+    lsmash_bs_t *bs  = exporter->bs;
+    uint8_t     *pos = sample->data;
+    uint8_t     *end = sample->data + sample->length;
+    if( sample->prop.ra_flags & (ISOM_SAMPLE_RANDOM_ACCESS_FLAG_SYNC | ISOM_SAMPLE_RANDOM_ACCESS_FLAG_RAP) )
+        nalu_exp->ps_pending = 1;
+    while( pos < end )
+    {
+        if( (uint32_t)(end - pos) < nalu_exp->length_size )
+            goto invalid;
+        uint32_t nalu_length = 0;
+        for( uint32_t i = 0; i < nalu_exp->length_size; i++ )
+            nalu_length = (nalu_length << 8) | *pos++;
+        if( nalu_length > (uint32_t)(end - pos) )
+            goto invalid;
+        if( nalu_length == 0 )
+            continue;
+        /* An Access Unit Delimiter shall be the first NAL unit in an access unit if present. */
+        uint8_t nalu_type = (pos[0] >> nalu_exp->nalu_type_shift) & nalu_exp->nalu_type_mask;
+        if( nalu_exp->ps_pending && nalu_type != nalu_exp->aud_type )
+        {
+            lsmash_bs_put_bytes( bs, nalu_exp->ps_length, nalu_exp->ps );
+            nalu_exp->ps_pending = 0;
+        }
+        lsmash_bs_put_be32( bs, NALU_START_CODE );
+        lsmash_bs_put_bytes( bs, nalu_length, pos );
+        pos += nalu_length;
+    }
+    return lsmash_bs_is_error( bs ) ? LSMASH_ERR_MEMORY_ALLOC : 0;
+invalid:
+    lsmash_log( exporter, LSMASH_LOG_ERROR, "detected a broken NAL unit length in a sample.\n" );
+    return LSMASH_ERR_INVALID_DATA;
+}
+
+/***************************************************************************
+    H.264 exporter
+    ITU-T Recommendation H.264 (04/13)
+    ISO/IEC 14496-15:2010
+***************************************************************************/
+static int h264_exporter_probe( exporter_t *exporter, lsmash_summary_t *summary )
+{
+    lsmash_codec_type_t sample_type = summary->sample_type;
+    if( !lsmash_check_codec_type_identical( sample_type, ISOM_CODEC_TYPE_AVC1_VIDEO )
+     && !lsmash_check_codec_type_identical( sample_type, ISOM_CODEC_TYPE_AVC2_VIDEO )
+     && !lsmash_check_codec_type_identical( sample_type, ISOM_CODEC_TYPE_AVC3_VIDEO )
+     && !lsmash_check_codec_type_identical( sample_type, ISOM_CODEC_TYPE_AVC4_VIDEO ) )
+        return LSMASH_ERR_INVALID_DATA;
+    lsmash_codec_specific_t *cs = nalu_exporter_get_structured_specific( exporter, summary, LSMASH_CODEC_SPECIFIC_DATA_TYPE_ISOM_VIDEO_H264 );
+    if( !cs )
+        return LSMASH_ERR_INVALID_DATA;
+    lsmash_h264_specific_parameters_t *param = (lsmash_h264_specific_parameters_t *)cs->data.structured;
+    lsmash_h264_parameter_sets_t      *ps    = param->parameter_sets;
+    /* SPS Ext shall follow the SPS which it extends. */
+    lsmash_entry_list_t *ps_lists[] =
+        {
+            ps ? ps->sps_list    : NULL,
+            ps ? ps->spsext_list : NULL,
+            ps ? ps->pps_list    : NULL
+        };
+    int err = nalu_exporter_setup( exporter, param->lengthSizeMinusOne + 1, ps_lists, 3, H264_NALU_TYPE_AUD, 0, 0x1f );
+    lsmash_destroy_codec_specific_data( cs );
+    return err;
+}
+
+const exporter_functions h264_exporter =
+{
+    { "H.264", offsetof( exporter_t, log_level ) },
+    h264_exporter_probe,
+    nalu_exporter_write_sample,
+    NULL,
+    nalu_exporter_cleanup
+};
+
+/***************************************************************************
+    HEVC exporter
+    ITU-T Recommendation H.265 (04/13)
+    ISO/IEC 14496-15:2014
+***************************************************************************/
+static int hevc_exporter_probe( exporter_t *exporter, lsmash_summary_t *summary )
+{
+    lsmash_codec_type_t sample_type = summary->sample_type;
+    if( !lsmash_check_codec_type_identical( sample_type, ISOM_CODEC_TYPE_HVC1_VIDEO )
+     && !lsmash_check_codec_type_identical( sample_type, ISOM_CODEC_TYPE_HEV1_VIDEO ) )
+        return LSMASH_ERR_INVALID_DATA;
+    lsmash_codec_specific_t *cs = nalu_exporter_get_structured_specific( exporter, summary, LSMASH_CODEC_SPECIFIC_DATA_TYPE_ISOM_VIDEO_HEVC );
+    if( !cs )
+        return LSMASH_ERR_INVALID_DATA;
+    lsmash_hevc_specific_parameters_t *param = (lsmash_hevc_specific_parameters_t *)cs->data.structured;
+    lsmash_hevc_parameter_arrays_t    *pa    = param->parameter_arrays;
+    /* Suffix SEIs are not put since they shall follow the VCL NAL units. */
+    lsmash_entry_list_t *ps_lists[] =
+        {
+            pa ? pa->ps_array[HEVC_DCR_NALU_TYPE_VPS       ].list : NULL,
+            pa ? pa->ps_array[HEVC_DCR_NALU_TYPE_SPS       ].list : NULL,
+            pa ? pa->ps_array[HEVC_DCR_NALU_TYPE_PPS       ].list : NULL,
+            pa ? pa->ps_array[HEVC_DCR_NALU_TYPE_PREFIX_SEI].list : NULL
+        };
+    int err = nalu_exporter_setup( exporter, param->lengthSizeMinusOne + 1, ps_lists, 4, HEVC_NALU_TYPE_AUD, 1, 0x3f );
+    lsmash_destroy_codec_specific_data( cs );
+    return err;
+}
+
+const exporter_functions hevc_exporter =
+{
+    { "HEVC", offsetof( exporter_t, log_level ) },
+    hevc_exporter_probe,
+    nalu_exporter_write_sample,
+    NULL,
+    nalu_exporter_cleanup
+};
@@ -0,0 +1,268 @@
+/*****************************************************************************
+ * wave_exp.c
+ *****************************************************************************
+ * Copyright (C) 2015 L-SMASH project
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ * ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ *****************************************************************************/
+
+/* This file is available under an ISC license. */
+
+#include "common/internal.h" /* must be placed first */
+
+#include <string.h>
+
+#define LSMASH_EXPORTER_INTERNAL
+#include "exporter.h"
+
+/***************************************************************************
+    WAVE exporter
+    LPCM samples are converted into the interleaved little endian format
+    with the signedness which WAVE requires, i.e. unsigned for 8-bit and
+    signed for the others.
+***************************************************************************/
+#define WAVE_FORMAT_TYPE_ID_PCM        0x0001   /* WAVE_FORMAT_PCM */
+#define WAVE_FORMAT_TYPE_ID_IEEE_FLOAT 0x0003   /* WAVE_FORMAT_IEEE_FLOAT */
+#define WAVE_FORMAT_TYPE_ID_EXTENSIBLE 0xFFFE   /* WAVE_FORMAT_EXTENSIBLE */
+
+#define WAVE_SIZE_UNKNOWN 0xFFFFFFFF            /* the placeholder of the chunk sizes on unseekable streams */
+
+typedef struct
+{
+    uint16_t format_tag;            /* WAVE_FORMAT_TYPE_ID_PCM or WAVE_FORMAT_TYPE_ID_IEEE_FLOAT */
+    uint16_t channels;
+    uint32_t frequency;
+    uint16_t container_bits;        /* the number of bits per sample in the container */
+    uint16_t valid_bits;            /* the number of significant bits */
+    uint32_t channel_mask;
+    uint32_t format_flags;
+    /* status */
+    uint64_t riff_size_offset;
+    uint64_t data_size_offset;
+    uint64_t header_length;
+    uint64_t data_size;
+    uint8_t *buffer;                /* the buffer for the conversion */
+    uint32_t buffer_size;
+} wave_exporter_t;
+
+static void wave_exporter_cleanup( exporter_t *exporter )
+{
+    wave_exporter_t *wave_exp = (wave_exporter_t *)exporter->info;
+    if( !wave_exp )
+        return;
+    lsmash_free( wave_exp->buffer );
+    lsmash_freep( &exporter->info );
+}
+
+static int wave_exporter_check_format( wave_exporter_t *wave_exp, lsmash_audio_summary_t *summary, uint32_t format_flags )
+{
+    if( summary->channels == 0 || summary->channels > UINT16_MAX
+     || summary->sample_size == 0 || summary->frequency == 0 )
+        return LSMASH_ERR_INVALID_DATA;
+    if( format_flags & QT_AUDIO_FORMAT_FLAG_NON_INTERLEAVED )
+        return LSMASH_ERR_PATCH_WELCOME;
+    if( summary->sample_size & 7 )
+    {
+        /* The significant bits shall be placed into the high bits of each byte aligned sample. */
+        if( (format_flags & QT_AUDIO_FORMAT_FLAG_PACKED) || !(format_flags & QT_AUDIO_FORMAT_FLAG_ALIGNED_HIGH) )
+            return LSMASH_ERR_PATCH_WELCOME;
+    }
+    if( (format_flags & QT_AUDIO_FORMAT_FLAG_FLOAT)
+     && summary->sample_size != 32 && summary->sample_size != 64 )
+        return LSMASH_ERR_INVALID_DATA;
+    wave_exp->format_tag     = (format_flags & QT_AUDIO_FORMAT_FLAG_FLOAT) ? WAVE_FORMAT_TYPE_ID_IEEE_FLOAT : WAVE_FORMAT_TYPE_ID_PCM;
+    wave_exp->channels       = summary->channels;
+    wave_exp->frequency      = summary->frequency;
+    wave_exp->container_bits = (summary->sample_size + 7) & ~7;
+    wave_exp->valid_bits     = summary->sample_size;
+    wave_exp->format_flags   = format_flags;
+    return 0;
+}
+
+static void wave_exporter_put_header( lsmash_bs_t *bs, wave_exporter_t *wave_exp )
+{
+    /* WAVEFORMATEXTENSIBLE is required for more than 2 channels or padded samples. */
+    int      extensible  = wave_exp->channels > 2
+                        || wave_exp->valid_bits != wave_exp->container_bits
+                        || wave_exp->channel_mask;
+    uint16_t block_align = wave_exp->channels * (wave_exp->container_bits / 8);
+    uint32_t fmt_size    = extensible ? 40 : wave_exp->format_tag == WAVE_FORMAT_TYPE_ID_PCM ? 16 : 18;
+    wave_exp->header_length = 12 + 8 + fmt_size + 8;
+    /* RIFF chunk */
+    lsmash_bs_put_be32( bs, LSMASH_4CC( 'R', 'I', 'F', 'F' ) );
+    wave_exp->riff_size_offset = lsmash_bs_get_valid_data_size( bs );
+    lsmash_bs_put_le32( bs, WAVE_SIZE_UNKNOWN );
+    lsmash_bs_put_be32( bs, LSMASH_4CC( 'W', 'A', 'V', 'E' ) );
+    /* Format chunk */
+    lsmash_bs_put_be32( bs, LSMASH_4CC( 'f', 'm', 't', ' ' ) );
+    lsmash_bs_put_le32( bs, fmt_size );
+    lsmash_bs_put_le16( bs, extensible ? WAVE_FORMAT_TYPE_ID_EXTENSIBLE : wave_exp->format_tag );
+    lsmash_bs_put_le16( bs, wave_exp->channels );
+    lsmash_bs_put_le32( bs, wave_exp->frequency );
+    lsmash_bs_put_le32( bs, wave_exp->frequency * block_align );
+    lsmash_bs_put_le16( bs, block_align );
+    lsmash_bs_put_le16( bs, wave_exp->container_bits );
+    if( fmt_size > 16 )
+        lsmash_bs_put_le16( bs, fmt_size - 18 );    /* cbSize */
+    if( extensible )
+    {
+        /* KSDATAFORMAT_SUBTYPE_PCM        := 00000001-0000-0010-8000-00aa00389b71
+         * KSDATAFORMAT_SUBTYPE_IEEE_FLOAT := 00000003-0000-0010-8000-00aa00389b71 */
+        static const uint8_t guid_tail[14] = { 0x00, 0x00, 0x00, 0x00, 0x10, 0x00,
+                                               0x80, 0x00, 0x00, 0xaa, 0x00, 0x38, 0x9b, 0x71 };
+        lsmash_bs_put_le16( bs, wave_exp->valid_bits );
+        lsmash_bs_put_le32( bs, wave_exp->channel_mask );
+        lsmash_bs_put_le16( bs, wave_exp->format_tag );
+        lsmash_bs_put_bytes( bs, 14, (void *)guid_tail );
+    }
+    /* Data chunk */
+    lsmash_bs_put_be32( bs, LSMASH_4CC( 'd', 'a', 't', 'a' ) );
+    wave_exp->data_size_offset = lsmash_bs_get_valid_data_size( bs );
+    lsmash_bs_put_le32( bs, WAVE_SIZE_UNKNOWN );
+}
+
+static int wave_exporter_probe( exporter_t *exporter, lsmash_summary_t *summary )
+{
+    if( summary->summary_type != LSMASH_SUMMARY_TYPE_AUDIO )
+        return LSMASH_ERR_INVALID_DATA;
+    lsmash_codec_specific_t *cs = isom_get_codec_specific( summary->opaque, LSMASH_CODEC_SPECIFIC_DATA_TYPE_QT_AUDIO_FORMAT_SPECIFIC_FLAGS );
+    if( !cs )
+        /* not LPCM audio */
+        return LSMASH_ERR_INVALID_DATA;
+    cs = lsmash_convert_codec_specific_format( cs, LSMASH_CODEC_SPECIFIC_FORMAT_STRUCTURED );
+    if( !cs )
+        return LSMASH_ERR_NAMELESS;
+    uint32_t format_flags = ((lsmash_qt_audio_format_specific_flags_t *)cs->data.structured)->format_flags;
+    lsmash_destroy_codec_specific_data( cs );
+    wave_exporter_t param = { 0 };
+    int err = wave_exporter_check_format( &param, (lsmash_audio_summary_t *)summary, format_flags );
+    if( err < 0 )
+    {
+        lsmash_log( exporter, LSMASH_LOG_ERROR, "the LPCM format cannot be stored in WAVE.\n" );
+        return err;
+    }
+    cs = isom_get_codec_specific( summary->opaque, LSMASH_CODEC_SPECIFIC_DATA_TYPE_QT_AUDIO_CHANNEL_LAYOUT );
+    if( cs && (cs = lsmash_convert_codec_specific_format( cs, LSMASH_CODEC_SPECIFIC_FORMAT_STRUCTURED )) != NULL )
+    {
+        lsmash_qt_audio_channel_layout_t *layout = (lsmash_qt_audio_channel_layout_t *)cs->data.structured;
+        if( layout->channelLayoutTag == QT_CHANNEL_LAYOUT_USE_CHANNEL_BITMAP )
+            param.channel_mask = layout->channelBitmap;
+        lsmash_destroy_codec_specific_data( cs );
+    }
+    wave_exporter_t *wave_exp = (wave_exporter_t *)exporter->info;
+    if( wave_exp )
+    {
+        /* The header has been already written, so the format cannot change. */
+        if( param.format_tag     != wave_exp->format_tag
+         || param.channels       != wave_exp->channels
+         || param.frequency      != wave_exp->frequency
+         || param.container_bits != wave_exp->container_bits
+         || param.valid_bits     != wave_exp->valid_bits
+         || param.channel_mask   != wave_exp->channel_mask )
+        {
+            lsmash_log( exporter, LSMASH_LOG_ERROR, "the LPCM format changed within the track.\n" );
+            return LSMASH_ERR_PATCH_WELCOME;
+        }
+        wave_exp->format_flags = format_flags;
+        return 0;
+    }
+    wave_exp = (wave_exporter_t *)lsmash_memdup( &param, sizeof(wave_exporter_t) );
+    if( !wave_exp )
+        return LSMASH_ERR_MEMORY_ALLOC;
+    exporter->info = wave_exp;
+    wave_exporter_put_header( exporter->bs, wave_exp );
+    return lsmash_bs_is_error( exporter->bs ) ? LSMASH_ERR_MEMORY_ALLOC : 0;
+}
+
+static int wave_exporter_write_sample( exporter_t *exporter, lsmash_sample_t *sample )
+{
+    wave_exporter_t *wave_exp = (wave_exporter_t *)exporter->info;
+    if( !wave_exp )
+        return LSMASH_ERR_NAMELESS;
+    uint32_t bytes_per_sample = wave_exp->container_bits / 8;
+    if( sample->length % (bytes_per_sample * wave_exp->channels) )
+    {
+        lsmash_log( exporter, LSMASH_LOG_ERROR, "a sample has a fragment of an audio frame.\n" );
+        return LSMASH_ERR_INVALID_DATA;
+    }
+    int swap = bytes_per_sample > 1 && (wave_exp->format_flags & QT_AUDIO_FORMAT_FLAG_BIG_ENDIAN);
+    int sign = !(wave_exp->format_flags & QT_AUDIO_FORMAT_FLAG_FLOAT)
+            && (bytes_per_sample == 1) == !!(wave_exp->format_flags & QT_AUDIO_FORMAT_FLAG_SIGNED_INTEGER);
+    uint8_t *data = sample->data;
+    if( swap || sign )
+    {
+        if( wave_exp->buffer_size < sample->length )
+        {
+            uint8_t *buffer = lsmash_realloc( wave_exp->buffer, sample->length );
+            if( !buffer )
+                return LSMASH_ERR_MEMORY_ALLOC;
+            wave_exp->buffer      = buffer;
+            wave_exp->buffer_size = sample->length;
+        }
+        data = wave_exp->buffer;
+        for( uint32_t pos = 0; pos < sample->length; pos += bytes_per_sample )
+        {
+            uint8_t *src = sample->data + pos;
+            uint8_t *dst = data         + pos;
+            if( swap )
+                for( uint32_t i = 0; i < bytes_per_sample; i++ )
+                    dst[i] = src[bytes_per_sample - 1 - i];
+            else
+                memcpy( dst, src, bytes_per_sample );
+            /* Flip the most significant bit to convert between signed and unsigned. */
+            if( sign )
+                dst[bytes_per_sample - 1] ^= 0x80;
+        }
+    }
+    lsmash_bs_put_bytes( exporter->bs, sample->length, data );
+    wave_exp->data_size += sample->length;
+    return lsmash_bs_is_error( exporter->bs ) ? LSMASH_ERR_MEMORY_ALLOC : 0;
+}
+
+static int wave_exporter_patch_size( lsmash_bs_t *bs, uint64_t offset, uint64_t size )
+{
+    int64_t ret = lsmash_bs_write_seek( bs, offset, SEEK_SET );
+    if( ret < 0 )
+        return ret;
+    lsmash_bs_put_le32( bs, LSMASH_MIN( size, UINT32_MAX ) );
+    return lsmash_bs_flush_buffer( bs );
+}
+
+static int wave_exporter_finish( exporter_t *exporter )
+{
+    wave_exporter_t *wave_exp = (wave_exporter_t *)exporter->info;
+    if( !wave_exp )
+        return 0;
+    lsmash_bs_t *bs = exporter->bs;
+    /* The data chunk shall be padded to even size. */
+    if( wave_exp->data_size & 1 )
+        lsmash_bs_put_byte( bs, 0 );
+    int err = lsmash_bs_flush_buffer( bs );
+    if( err < 0 || bs->unseekable )
+        return err;
+    uint64_t riff_size = wave_exp->header_length - 8 + wave_exp->data_size + (wave_exp->data_size & 1);
+    if( (err = wave_exporter_patch_size( bs, wave_exp->riff_size_offset, riff_size           )) < 0
+     || (err = wave_exporter_patch_size( bs, wave_exp->data_size_offset, wave_exp->data_size )) < 0 )
+        return err;
+    int64_t ret = lsmash_bs_write_seek( bs, 0, SEEK_END );
+    return ret < 0 ? ret : 0;
+}
+
+const exporter_functions wave_exporter =
+{
+    { "WAVE", offsetof( exporter_t, log_level ) },
+    wave_exporter_probe,
+    wave_exporter_write_sample,
+    wave_exporter_finish,
+    wave_exporter_cleanup
+};
@@ -49,6 +49,7 @@ extern const importer_functions h264_importer;
 extern const importer_functions hevc_importer;
 extern const importer_functions vc1_importer;
 extern const importer_functions isobm_importer;
+extern const importer_functions synthetic_importer;
 
 /******** importer listing table ********/
 static const importer_functions *importer_func_table[] =
@@ -56,6 +57,7 @@ static const importer_functions *importer_func_table[] =
     &mp4sys_adts_importer,
     &mp4sys_mp3_importer,
     &amr_importer,
+    &synthetic_importer,
     &ac3_importer,
     &eac3_importer,
     &mp4a_als_importer,
@@ -102,7 +104,7 @@ void lsmash_importer_destroy( importer_t *importer )
     if( importer->funcs.cleanup )
         importer->funcs.cleanup( importer );
     lsmash_remove_list( importer->summaries, lsmash_cleanup_summary );
-    if( importer->root && importer->root != importer->file->root )
+    if( importer->root && importer->file && importer->root != importer->file->root )
         importer->root->file = NULL;    /* not internally opened file */
     lsmash_destroy_root( importer->root );
     lsmash_free( importer );
@@ -154,7 +154,7 @@ static int isobm_importer_probe( importer_t *importer )
     }
     importer->file->flags |= LSMASH_FILE_MODE_BOX;
     lsmash_root_t *root = importer->root;
-    if( root && root == importer->file->root )
+    if( root && importer->file->importer != importer )
     {
         if( (isobm_imp->track_ID = lsmash_get_track_ID( root, 1 )) == 0 )
         {
@@ -197,7 +197,7 @@ static int isobm_importer_construct_timeline( importer_t *importer, uint32_t tra
     int err = isom_timeline_construct( root, track_ID );
     if( err < 0 )
         return err;
-    if( root && root == importer->file->root )
+    if( root && importer->file->importer != importer )
     {
         lsmash_summary_t *summary = lsmash_get_entry_data( importer->summaries, track_number );
         if( !summary )
@@ -573,6 +573,7 @@ static void nalu_generate_timestamps_from_poc
     uint32_t           num_access_units
 )
 {
+    lsmash_media_ts_list_t ts_list = { num_access_units, timestamp };
     /* Check if composition delay derived from reordering is present. */
     if( max_composition_delay == 0 )
     {
@@ -595,7 +596,7 @@ static void nalu_generate_timestamps_from_poc
             timestamp[i].cts = (uint64_t)npt[i].poc;
             timestamp[i].dts = (uint64_t)i;
         }
-        qsort( timestamp, num_access_units, sizeof(lsmash_media_ts_t), (int(*)( const void *, const void * ))lsmash_compare_cts );
+        lsmash_sort_timestamps_composition_order( &ts_list );
         /* Check POC gap in output order. */
         lsmash_class_t *logger = &(lsmash_class_t){ .name = importer->class->name };
         for( uint32_t i = 1; i < num_access_units; i++ )
@@ -620,7 +621,7 @@ static void nalu_generate_timestamps_from_poc
              * Anyway, generate CTSs and DTSs. */
             for( uint32_t i = 0; i < num_access_units; i++ )
                 timestamp[i].cts = i + max_composition_delay;
-            qsort( timestamp, num_access_units, sizeof(lsmash_media_ts_t), (int(*)( const void *, const void * ))lsmash_compare_dts );
+            lsmash_sort_timestamps_decoding_order( &ts_list );
             *last_delta = 1;
             return;
         }
@@ -638,7 +639,7 @@ static void nalu_generate_timestamps_from_poc
             reorder_cts[i] = timestamp[i].cts;
         }
         /* Generate DTSs. */
-        qsort( timestamp, num_access_units, sizeof(lsmash_media_ts_t), (int(*)( const void *, const void * ))lsmash_compare_dts );
+        lsmash_sort_timestamps_decoding_order( &ts_list );
         for( uint32_t i = 0; i < num_access_units; i++ )
         {
             timestamp[i].dts = i <= max_composition_delay
@@ -852,7 +853,11 @@ static int h264_importer_probe( importer_t *importer )
     h264_info_t *info = &h264_imp->info;
     lsmash_bs_read_seek( bs, first_sc_head_pos, SEEK_SET );
     h264_imp->sc_head_pos = first_sc_head_pos;
-    if( (err = h264_analyze_whole_stream( importer )) < 0 )
+    isom_trace_begin( importer->file->root, LSMASH_TRACE_PHASE_IMPORTER_ANALYSIS );
+    err = h264_analyze_whole_stream( importer );
+    isom_trace_end( importer->file->root, LSMASH_TRACE_PHASE_IMPORTER_ANALYSIS,
+                    lsmash_bs_get_stream_pos( bs ), h264_imp->ts_list.sample_count );
+    if( err < 0 )
         goto fail;
     /* Go back to the start code of the first NALU. */
     importer->status = IMPORTER_OK;
@@ -867,6 +872,7 @@ static int h264_importer_probe( importer_t *importer )
     memset( &info->slice, 0, sizeof(h264_slice_info_t) );
     memset( &info->sps, 0, sizeof(h264_sps_t) );
     memset( &info->pps, 0, sizeof(h264_pps_t) );
+    h264_discard_cached_specific_info( info->avcC_param.parameter_sets );
     lsmash_remove_entries( info->avcC_param.parameter_sets->sps_list,    isom_remove_dcr_ps );
     lsmash_remove_entries( info->avcC_param.parameter_sets->pps_list,    isom_remove_dcr_ps );
     lsmash_remove_entries( info->avcC_param.parameter_sets->spsext_list, isom_remove_dcr_ps );
@@ -1510,7 +1516,11 @@ static int hevc_importer_probe( importer_t *importer )
     hevc_info_t *info = &hevc_imp->info;
     lsmash_bs_read_seek( bs, first_sc_head_pos, SEEK_SET );
     hevc_imp->sc_head_pos = first_sc_head_pos;
-    if( (err = hevc_analyze_whole_stream( importer )) < 0 )
+    isom_trace_begin( importer->file->root, LSMASH_TRACE_PHASE_IMPORTER_ANALYSIS );
+    err = hevc_analyze_whole_stream( importer );
+    isom_trace_end( importer->file->root, LSMASH_TRACE_PHASE_IMPORTER_ANALYSIS,
+                    lsmash_bs_get_stream_pos( bs ), hevc_imp->ts_list.sample_count );
+    if( err < 0 )
         goto fail;
     /* Go back to the start code of the first NALU. */
     importer->status = IMPORTER_OK;
@@ -1526,6 +1536,7 @@ static int hevc_importer_probe( importer_t *importer )
     memset( &info->vps,   0, sizeof(hevc_vps_t) );
     memset( &info->sps,   0, sizeof(hevc_sps_t) );
     memset( &info->pps,   0, SIZEOF_PPS_EXCLUDING_HEAP );
+    hevc_discard_cached_specific_info( info->hvcC_param.parameter_arrays );
     for( int i = 0; i < HEVC_DCR_NALU_TYPE_NUM; i++ )
         lsmash_remove_entries( info->hvcC_param.parameter_arrays->ps_array[i].list, isom_remove_dcr_ps );
     lsmash_destroy_hevc_parameter_arrays( &info->hvcC_param_next );
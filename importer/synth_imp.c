@@ -0,0 +1,1325 @@
+/*****************************************************************************
+ * synth_imp.c
+ *****************************************************************************
+ * Copyright (C) 2015 L-SMASH project
+ *
+ * Permission to use, copy, modify, and/or distribute this software for any
+ * purpose with or without fee is hereby granted, provided that the above
+ * copyright notice and this permission notice appear in all copies.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+ * WITH REGARD TO THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+ * ANY SPECIAL, DIRECT, INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+ * WHATSOEVER RESULTING FROM LOSS OF USE, DATA OR PROFITS, WHETHER IN AN
+ * ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+ * OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+ *****************************************************************************/
+
+/* This file is available under an ISC license. */
+
+#include "common/internal.h" /* must be placed first */
+
+#include <string.h>
+#include <stdlib.h>
+#include <ctype.h>
+
+#define LSMASH_IMPORTER_INTERNAL
+#include "importer.h"
+
+#include "codecs/mp4a.h"
+#include "codecs/a52.h"
+#include "codecs/nalu.h"
+
+/***************************************************************************
+    synthetic elementary stream importer
+    The input is a small text file which describes the stream to generate.
+    It starts with the magic word "#!L-SMASH-SYNTHETIC" and is followed by
+    whitespace separated key=value pairs. '#' begins a comment.
+      codec     : h264, hevc, aac, ac3 or lpcm (mandatory)
+      frames    : the number of access units
+      duration  : the duration in seconds, used if frames is not specified
+      bitrate   : the average bitrate in kbit/s
+      seed      : the seed of the pseudo random payload and size jitter
+    video only
+      width, height : the picture size in luma samples
+      fps           : the frame rate as num[/den]
+      gop           : the distance between IDR pictures, 0 means about 2 seconds
+      bframes       : the number of consecutive B-pictures
+      pyramid       : use B-pictures as references (0 or 1)
+    audio only
+      frequency : the sampling frequency in Hz
+      channels  : the number of channels
+      bits      : the bit depth of LPCM
+    Access units are generated on demand from a pre-filled random pool, so
+    the importer runs at memory speed regardless of the stream length.
+    Parameter sets and syncframe headers are well-formed; the rest of each
+    access unit is not decodable.
+***************************************************************************/
+#define SYNTH_MAGIC_WORD        "#!L-SMASH-SYNTHETIC"
+#define SYNTH_MAX_SPEC_LENGTH   4096
+#define SYNTH_MAX_BFRAMES       16
+#define SYNTH_LPCM_FRAME_LENGTH 1024
+#define SYNTH_AAC_FRAME_LENGTH  1024
+#define SYNTH_AC3_FRAME_LENGTH  1536
+#define SYNTH_DEFAULT_DURATION  60
+
+typedef enum
+{
+    SYNTH_CODEC_NONE = 0,
+    SYNTH_CODEC_H264,
+    SYNTH_CODEC_HEVC,
+    SYNTH_CODEC_AAC,
+    SYNTH_CODEC_AC3,
+    SYNTH_CODEC_LPCM,
+} synth_codec_type;
+
+typedef enum
+{
+    SYNTH_PICTURE_IDR = 0,
+    SYNTH_PICTURE_P,
+    SYNTH_PICTURE_B_REF,
+    SYNTH_PICTURE_B,
+} synth_picture_type;
+
+typedef struct
+{
+    synth_codec_type codec;
+    uint64_t         frames;
+    double           duration;
+    uint32_t         bitrate;
+    uint32_t         seed;
+    uint32_t         width;
+    uint32_t         height;
+    uint32_t         fps_num;
+    uint32_t         fps_den;
+    uint32_t         gop;
+    uint32_t         bframes;
+    int              pyramid;
+    uint32_t         frequency;
+    uint32_t         channels;
+    uint32_t         bits;
+} synth_param_t;
+
+typedef struct
+{
+    synth_param_t param;
+    uint64_t      num_aus;
+    uint64_t      au_number;
+    uint32_t      samples_in_frame;
+    uint32_t      random_state;
+    uint8_t      *pool;
+    uint32_t      pool_size;
+    uint32_t      max_au_length;
+    /* video */
+    double        unit_size;
+    uint32_t      composition_delay;
+    uint32_t      b_order_length;
+    uint8_t       b_offset[SYNTH_MAX_BFRAMES];
+    uint8_t       b_is_ref[SYNTH_MAX_BFRAMES];
+    /* audio */
+    uint32_t      frame_size;
+    uint32_t      header_length;
+    uint8_t       header[16];
+} synth_importer_t;
+
+/* Relative sizes of the picture types, rough proportions of a typical encode. */
+static const uint32_t synth_picture_weight[4] = { 12, 4, 3, 2 };
+
+static inline uint32_t synth_random
+(
+    uint32_t *state
+)
+{
+    /* xorshift32 */
+    uint32_t x = *state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    return *state = x;
+}
+
+static void remove_synth_importer
+(
+    synth_importer_t *synth_imp
+)
+{
+    if( !synth_imp )
+        return;
+    lsmash_free( synth_imp->pool );
+    lsmash_free( synth_imp );
+}
+
+static synth_importer_t *create_synth_importer
+(
+    importer_t *importer
+)
+{
+    synth_importer_t *synth_imp = (synth_importer_t *)lsmash_malloc_zero( sizeof(synth_importer_t) );
+    if( !synth_imp )
+        return NULL;
+    synth_param_t *param = &synth_imp->param;
+    param->seed      = 1;
+    param->width     = 1920;
+    param->height    = 1080;
+    param->fps_num   = 24000;
+    param->fps_den   = 1001;
+    param->bframes   = 3;
+    param->pyramid   = 1;
+    param->frequency = 48000;
+    param->channels  = 2;
+    param->bits      = 16;
+    return synth_imp;
+}
+
+static void synth_cleanup
+(
+    importer_t *importer
+)
+{
+    debug_if( importer && importer->info )
+        remove_synth_importer( importer->info );
+}
+
+/***************************************************************************
+    spec parser
+***************************************************************************/
+static int synth_get_uint
+(
+    const char *value,
+    uint64_t   *result
+)
+{
+    char *end;
+    if( !isdigit( (unsigned char)value[0] ) )
+        return LSMASH_ERR_INVALID_DATA;
+    unsigned long long v = strtoull( value, &end, 10 );
+    if( *end != '\0' )
+        return LSMASH_ERR_INVALID_DATA;
+    *result = v;
+    return 0;
+}
+
+static int synth_get_uint32
+(
+    const char *value,
+    uint32_t   *result
+)
+{
+    uint64_t v;
+    if( synth_get_uint( value, &v ) < 0 || v > UINT32_MAX )
+        return LSMASH_ERR_INVALID_DATA;
+    *result = (uint32_t)v;
+    return 0;
+}
+
+static int synth_parse_option
+(
+    synth_param_t *param,
+    const char    *token,
+    char          *value
+)
+{
+    if( !strcmp( token, "codec" ) )
+    {
+        static const struct
+        {
+            const char      *name;
+            synth_codec_type codec;
+        } codec_table[] =
+            {
+                { "h264", SYNTH_CODEC_H264 },
+                { "hevc", SYNTH_CODEC_HEVC },
+                { "aac",  SYNTH_CODEC_AAC  },
+                { "ac3",  SYNTH_CODEC_AC3  },
+                { "lpcm", SYNTH_CODEC_LPCM },
+                { NULL,   SYNTH_CODEC_NONE }
+            };
+        for( int i = 0; codec_table[i].name; i++ )
+            if( !strcmp( value, codec_table[i].name ) )
+            {
+                param->codec = codec_table[i].codec;
+                return 0;
+            }
+        return LSMASH_ERR_INVALID_DATA;
+    }
+    else if( !strcmp( token, "frames" ) )
+        return synth_get_uint( value, &param->frames );
+    else if( !strcmp( token, "duration" ) )
+    {
+        char *end;
+        param->duration = strtod( value, &end );
+        return (end == value || *end != '\0' || param->duration <= 0) ? LSMASH_ERR_INVALID_DATA : 0;
+    }
+    else if( !strcmp( token, "fps" ) )
+    {
+        char *den = strchr( value, '/' );
+        if( den )
+            *den++ = '\0';
+        else
+            param->fps_den = 1;
+        if( synth_get_uint32( value, &param->fps_num ) < 0
+         || (den && synth_get_uint32( den, &param->fps_den ) < 0) )
+            return LSMASH_ERR_INVALID_DATA;
+        return 0;
+    }
+    static const struct
+    {
+        const char *name;
+        size_t      offset;
+    } uint32_option_table[] =
+        {
+            { "bitrate",   offsetof( synth_param_t, bitrate   ) },
+            { "seed",      offsetof( synth_param_t, seed      ) },
+            { "width",     offsetof( synth_param_t, width     ) },
+            { "height",    offsetof( synth_param_t, height    ) },
+            { "gop",       offsetof( synth_param_t, gop       ) },
+            { "bframes",   offsetof( synth_param_t, bframes   ) },
+            { "frequency", offsetof( synth_param_t, frequency ) },
+            { "channels",  offsetof( synth_param_t, channels  ) },
+            { "bits",      offsetof( synth_param_t, bits      ) },
+            { NULL, 0 }
+        };
+    for( int i = 0; uint32_option_table[i].name; i++ )
+        if( !strcmp( token, uint32_option_table[i].name ) )
+            return synth_get_uint32( value, (uint32_t *)((uint8_t *)param + uint32_option_table[i].offset) );
+    if( !strcmp( token, "pyramid" ) )
+    {
+        uint32_t pyramid;
+        if( synth_get_uint32( value, &pyramid ) < 0 || pyramid > 1 )
+            return LSMASH_ERR_INVALID_DATA;
+        param->pyramid = pyramid;
+        return 0;
+    }
+    return LSMASH_ERR_INVALID_DATA;
+}
+
+static int synth_parse_spec
+(
+    importer_t    *importer,
+    synth_param_t *param
+)
+{
+    lsmash_bs_t *bs = importer->bs;
+    uint8_t magic[sizeof(SYNTH_MAGIC_WORD) - 1];
+    if( lsmash_bs_get_bytes_ex( bs, sizeof(magic), magic ) != sizeof(magic)
+     || memcmp( magic, SYNTH_MAGIC_WORD, sizeof(magic) )
+     || !isspace( lsmash_bs_show_byte( bs, 0 ) ) )
+        return LSMASH_ERR_INVALID_DATA;
+    char spec[SYNTH_MAX_SPEC_LENGTH + 1];
+    uint32_t length = 0;
+    while( !lsmash_bs_is_end( bs, 0 ) )
+    {
+        if( length == SYNTH_MAX_SPEC_LENGTH )
+        {
+            lsmash_log( importer, LSMASH_LOG_ERROR, "the stream description is too long.\n" );
+            return LSMASH_ERR_INVALID_DATA;
+        }
+        spec[length++] = lsmash_bs_get_byte( bs );
+    }
+    spec[length] = '\0';
+    for( char *p = spec; *p; )
+    {
+        if( isspace( (unsigned char)*p ) )
+        {
+            ++p;
+            continue;
+        }
+        if( *p == '#' )
+        {
+            while( *p && *p != '\n' )
+                ++p;
+            continue;
+        }
+        char *token = p;
+        while( *p && *p != '#' && !isspace( (unsigned char)*p ) )
+            ++p;
+        char end = *p;
+        *p = '\0';
+        char *value = strchr( token, '=' );
+        if( value )
+            *value++ = '\0';
+        if( !value || synth_parse_option( param, token, value ) < 0 )
+        {
+            lsmash_log( importer, LSMASH_LOG_ERROR, "invalid option: %s.\n", token );
+            return LSMASH_ERR_INVALID_DATA;
+        }
+        *p = end;
+    }
+    if( param->codec == SYNTH_CODEC_NONE )
+    {
+        lsmash_log( importer, LSMASH_LOG_ERROR, "codec is not specified.\n" );
+        return LSMASH_ERR_INVALID_DATA;
+    }
+    return 0;
+}
+
+/***************************************************************************
+    video
+***************************************************************************/
+/* Append the display offsets of B-pictures in [lo, hi) in decoding order.
+ * With pyramid, the middle picture of each span is decoded first and referenced by the others. */
+static void synth_order_b_pictures
+(
+    synth_importer_t *synth_imp,
+    uint32_t          lo,
+    uint32_t          hi
+)
+{
+    if( lo >= hi )
+        return;
+    if( !synth_imp->param.pyramid || hi - lo < 3 )
+    {
+        for( uint32_t i = lo; i < hi; i++ )
+        {
+            synth_imp->b_offset[ synth_imp->b_order_length ] = i;
+            synth_imp->b_is_ref[ synth_imp->b_order_length ] = 0;
+            ++ synth_imp->b_order_length;
+        }
+        return;
+    }
+    uint32_t mid = (lo + hi) / 2;
+    synth_imp->b_offset[ synth_imp->b_order_length ] = mid;
+    synth_imp->b_is_ref[ synth_imp->b_order_length ] = 1;
+    ++ synth_imp->b_order_length;
+    synth_order_b_pictures( synth_imp, lo, mid );
+    synth_order_b_pictures( synth_imp, mid + 1, hi );
+}
+
+static void synth_setup_mini_gop
+(
+    synth_importer_t *synth_imp,
+    uint32_t          num_b_pictures
+)
+{
+    if( synth_imp->b_order_length == num_b_pictures )
+        return;
+    synth_imp->b_order_length = 0;
+    synth_order_b_pictures( synth_imp, 0, num_b_pictures );
+}
+
+/* Closed GOPs: an IDR picture followed by mini-GOPs, each of which consists of
+ * an anchor P-picture and the B-pictures displayed before it. */
+static synth_picture_type synth_get_picture
+(
+    synth_importer_t *synth_imp,
+    uint64_t          decode,
+    uint64_t         *display
+)
+{
+    uint64_t gop_start  = decode - decode % synth_imp->param.gop;
+    uint64_t gop_length = LSMASH_MIN( synth_imp->param.gop, synth_imp->num_aus - gop_start );
+    uint64_t position   = decode - gop_start;
+    if( position == 0 )
+    {
+        *display = decode;
+        return SYNTH_PICTURE_IDR;
+    }
+    uint32_t mini_gop_size  = synth_imp->param.bframes + 1;
+    uint64_t mini_gop_start = 1 + (position - 1) / mini_gop_size * mini_gop_size;
+    uint32_t length         = LSMASH_MIN( mini_gop_size, gop_length - mini_gop_start );
+    uint32_t index          = position - mini_gop_start;
+    if( index == 0 )
+    {
+        *display = gop_start + mini_gop_start + length - 1;
+        return SYNTH_PICTURE_P;
+    }
+    synth_setup_mini_gop( synth_imp, length - 1 );
+    *display = gop_start + mini_gop_start + synth_imp->b_offset[index - 1];
+    return synth_imp->b_is_ref[index - 1] ? SYNTH_PICTURE_B_REF : SYNTH_PICTURE_B;
+}
+
+static uint32_t synth_get_composition_delay
+(
+    synth_importer_t *synth_imp
+)
+{
+    uint32_t delay = 0;
+    for( uint32_t num_b_pictures = 1; num_b_pictures <= synth_imp->param.bframes; num_b_pictures++ )
+    {
+        synth_setup_mini_gop( synth_imp, num_b_pictures );
+        for( uint32_t i = 0; i < num_b_pictures; i++ )
+            /* The anchor is decoded first, so the i-th B-picture is decoded at i + 1. */
+            if( i + 1 > synth_imp->b_offset[i] )
+                delay = LSMASH_MAX( delay, i + 1 - synth_imp->b_offset[i] );
+    }
+    return delay;
+}
+
+static void synth_put_ue
+(
+    lsmash_bits_t *bits,
+    uint32_t       value
+)
+{
+    uint64_t code   = (uint64_t)value + 1;
+    uint32_t length = 0;
+    while( (code >> length) > 1 )
+        ++length;
+    lsmash_bits_put( bits, length, 0 );
+    lsmash_bits_put( bits, length + 1, code );
+}
+
+/* Write a NAL unit in the byte stream format, inserting emulation prevention bytes. */
+static int synth_put_nalu
+(
+    lsmash_bs_t   *bs,
+    lsmash_bits_t *bits
+)
+{
+    lsmash_bits_put( bits, 1, 1 );  /* rbsp_stop_one_bit */
+    uint32_t length;
+    uint8_t *rbsp = lsmash_bits_export_data( bits, &length );
+    lsmash_bits_empty( bits );
+    if( !rbsp )
+        return LSMASH_ERR_MEMORY_ALLOC;
+    lsmash_bs_put_be32( bs, 0x00000001 );
+    int zero_count = 0;
+    for( uint32_t i = 0; i < length; i++ )
+    {
+        if( zero_count == 2 && rbsp[i] <= 0x03 )
+        {
+            lsmash_bs_put_byte( bs, 0x03 );
+            zero_count = 0;
+        }
+        lsmash_bs_put_byte( bs, rbsp[i] );
+        zero_count = rbsp[i] ? 0 : zero_count + 1;
+    }
+    lsmash_free( rbsp );
+    return 0;
+}
+
+static uint8_t synth_get_h264_level
+(
+    synth_param_t *param
+)
+{
+    static const struct
+    {
+        uint8_t  level_idc;
+        uint32_t max_fs;
+        uint32_t max_mbps;
+    } level_table[] =
+        {
+            { 30,  1620,   40500 }, { 31,  3600,  108000 }, { 32,  5120,  216000 },
+            { 40,  8192,  245760 }, { 42,  8704,  522240 }, { 50, 22080,  589824 },
+            { 51, 36864,  983040 }, { 52, 36864, 2073600 }, {  0,     0,       0 }
+        };
+    uint64_t frame_size = (uint64_t)((param->width + 15) / 16) * ((param->height + 15) / 16);
+    uint64_t mb_rate    = frame_size * param->fps_num / param->fps_den;
+    for( int i = 0; level_table[i].level_idc; i++ )
+        if( frame_size <= level_table[i].max_fs && mb_rate <= level_table[i].max_mbps )
+            return level_table[i].level_idc;
+    return 52;
+}
+
+static uint8_t synth_get_hevc_level
+(
+    synth_param_t *param
+)
+{
+    static const struct
+    {
+        uint8_t  level_idc;
+        uint32_t max_luma_ps;
+        uint32_t max_luma_sr;
+    } level_table[] =
+        {
+            {  90,   552960,   16588800 }, {  93,   983040,   33177600 }, { 120,  2228224,   66846720 },
+            { 123,  2228224,  133693440 }, { 150,  8912896,  267386880 }, { 153,  8912896,  534773760 },
+            { 156,  8912896, 1069547520 }, { 180, 35651584, 1069547520 }, { 183, 35651584, 2139095040 },
+            {   0,        0,          0 }
+        };
+    uint64_t picture_size = (uint64_t)param->width * param->height;
+    uint64_t sample_rate  = picture_size * param->fps_num / param->fps_den;
+    for( int i = 0; level_table[i].level_idc; i++ )
+        if( picture_size <= level_table[i].max_luma_ps && sample_rate <= level_table[i].max_luma_sr )
+            return level_table[i].level_idc;
+    return 186;
+}
+
+static int synth_put_h264_parameter_sets
+(
+    lsmash_bs_t      *bs,
+    synth_importer_t *synth_imp
+)
+{
+    synth_param_t *param = &synth_imp->param;
+    lsmash_bits_t *bits  = lsmash_bits_adhoc_create();
+    if( !bits )
+        return LSMASH_ERR_MEMORY_ALLOC;
+    uint32_t width_in_mbs  = (param->width  + 15) / 16;
+    uint32_t height_in_mbs = (param->height + 15) / 16;
+    uint32_t crop_right    = (width_in_mbs  * 16 - param->width)  / 2;
+    uint32_t crop_bottom   = (height_in_mbs * 16 - param->height) / 2;
+    /* Sequence parameter set: High profile, 4:2:0, 8-bit, progressive */
+    lsmash_bits_put( bits, 8, 0x67 );                       /* nal_ref_idc = 3, nal_unit_type = 7 */
+    lsmash_bits_put( bits, 8, 100 );                        /* profile_idc */
+    lsmash_bits_put( bits, 8, 0 );                          /* constraint_set_flags and reserved_zero_2bits */
+    lsmash_bits_put( bits, 8, synth_get_h264_level( param ) );
+    synth_put_ue( bits, 0 );                                /* seq_parameter_set_id */
+    synth_put_ue( bits, 1 );                                /* chroma_format_idc */
+    synth_put_ue( bits, 0 );                                /* bit_depth_luma_minus8 */
+    synth_put_ue( bits, 0 );                                /* bit_depth_chroma_minus8 */
+    lsmash_bits_put( bits, 1, 0 );                          /* qpprime_y_zero_transform_bypass_flag */
+    lsmash_bits_put( bits, 1, 0 );                          /* seq_scaling_matrix_present_flag */
+    synth_put_ue( bits, 4 );                                /* log2_max_frame_num_minus4 */
+    synth_put_ue( bits, 0 );                                /* pic_order_cnt_type */
+    synth_put_ue( bits, 4 );                                /* log2_max_pic_order_cnt_lsb_minus4 */
+    synth_put_ue( bits, synth_imp->composition_delay + 1 ); /* max_num_ref_frames */
+    lsmash_bits_put( bits, 1, 0 );                          /* gaps_in_frame_num_value_allowed_flag */
+    synth_put_ue( bits, width_in_mbs  - 1 );                /* pic_width_in_mbs_minus1 */
+    synth_put_ue( bits, height_in_mbs - 1 );                /* pic_height_in_map_units_minus1 */
+    lsmash_bits_put( bits, 1, 1 );                          /* frame_mbs_only_flag */
+    lsmash_bits_put( bits, 1, 1 );                          /* direct_8x8_inference_flag */
+    lsmash_bits_put( bits, 1, crop_right || crop_bottom );  /* frame_cropping_flag */
+    if( crop_right || crop_bottom )
+    {
+        synth_put_ue( bits, 0 );                            /* frame_crop_left_offset */
+        synth_put_ue( bits, crop_right );                   /* frame_crop_right_offset */
+        synth_put_ue( bits, 0 );                            /* frame_crop_top_offset */
+        synth_put_ue( bits, crop_bottom );                  /* frame_crop_bottom_offset */
+    }
+    lsmash_bits_put( bits, 1, 1 );                          /* vui_parameters_present_flag */
+    lsmash_bits_put( bits, 4, 0 );                          /* aspect_ratio_info_present_flag ... chroma_loc_info_present_flag */
+    lsmash_bits_put( bits, 1, 1 );                          /* timing_info_present_flag */
+    lsmash_bits_put( bits, 32, param->fps_den );            /* num_units_in_tick */
+    lsmash_bits_put( bits, 32, 2 * (uint64_t)param->fps_num ); /* time_scale */
+    lsmash_bits_put( bits, 1, 1 );                          /* fixed_frame_rate_flag */
+    lsmash_bits_put( bits, 3, 0 );                          /* nal_hrd, vcl_hrd and pic_struct_present_flag */
+    lsmash_bits_put( bits, 1, 1 );                          /* bitstream_restriction_flag */
+    lsmash_bits_put( bits, 1, 1 );                          /* motion_vectors_over_pic_boundaries_flag */
+    synth_put_ue( bits, 2 );                                /* max_bytes_per_pic_denom */
+    synth_put_ue( bits, 1 );                                /* max_bits_per_mb_denom */
+    synth_put_ue( bits, 16 );                               /* log2_max_mv_length_horizontal */
+    synth_put_ue( bits, 16 );                               /* log2_max_mv_length_vertical */
+    synth_put_ue( bits, synth_imp->composition_delay );     /* max_num_reorder_frames */
+    synth_put_ue( bits, synth_imp->composition_delay + 1 ); /* max_dec_frame_buffering */
+    int err = synth_put_nalu( bs, bits );
+    if( err < 0 )
+        goto done;
+    /* Picture parameter set: CABAC, 8x8 transform */
+    lsmash_bits_put( bits, 8, 0x68 );                       /* nal_ref_idc = 3, nal_unit_type = 8 */
+    synth_put_ue( bits, 0 );                                /* pic_parameter_set_id */
+    synth_put_ue( bits, 0 );                                /* seq_parameter_set_id */
+    lsmash_bits_put( bits, 1, 1 );                          /* entropy_coding_mode_flag */
+    lsmash_bits_put( bits, 1, 0 );                          /* bottom_field_pic_order_in_frame_present_flag */
+    synth_put_ue( bits, 0 );                                /* num_slice_groups_minus1 */
+    synth_put_ue( bits, 0 );                                /* num_ref_idx_l0_default_active_minus1 */
+    synth_put_ue( bits, 0 );                                /* num_ref_idx_l1_default_active_minus1 */
+    lsmash_bits_put( bits, 3, 0 );                          /* weighted_pred_flag and weighted_bipred_idc */
+    synth_put_ue( bits, 0 );                                /* pic_init_qp_minus26 (se) */
+    synth_put_ue( bits, 0 );                                /* pic_init_qs_minus26 (se) */
+    synth_put_ue( bits, 0 );                                /* chroma_qp_index_offset (se) */
+    lsmash_bits_put( bits, 1, 1 );                          /* deblocking_filter_control_present_flag */
+    lsmash_bits_put( bits, 1, 0 );                          /* constrained_intra_pred_flag */
+    lsmash_bits_put( bits, 1, 0 );                          /* redundant_pic_cnt_present_flag */
+    lsmash_bits_put( bits, 1, 1 );                          /* transform_8x8_mode_flag */
+    lsmash_bits_put( bits, 1, 0 );                          /* pic_scaling_matrix_present_flag */
+    synth_put_ue( bits, 0 );                                /* second_chroma_qp_index_offset (se) */
+    err = synth_put_nalu( bs, bits );
+done:
+    lsmash_bits_adhoc_cleanup( bits );
+    return err;
+}
+
+static void synth_put_hevc_profile_tier_level
+(
+    lsmash_bits_t *bits,
+    synth_param_t *param
+)
+{
+    lsmash_bits_put( bits, 2, 0 );                          /* general_profile_space */
+    lsmash_bits_put( bits, 1, 0 );                          /* general_tier_flag */
+    lsmash_bits_put( bits, 5, 1 );                          /* general_profile_idc: Main */
+    lsmash_bits_put( bits, 32, 0x60000000 );                /* general_profile_compatibility_flag[1] and [2] */
+    lsmash_bits_put( bits, 4, 0x9 );                        /* progressive_source, interlaced_source, non_packed_constraint
+                                                             * and frame_only_constraint */
+    lsmash_bits_put( bits, 44, 0 );                         /* reserved */
+    lsmash_bits_put( bits, 8, synth_get_hevc_level( param ) );
+}
+
+static int synth_put_hevc_parameter_sets
+(
+    lsmash_bs_t      *bs,
+    synth_importer_t *synth_imp
+)
+{
+    synth_param_t *param = &synth_imp->param;
+    lsmash_bits_t *bits  = lsmash_bits_adhoc_create();
+    if( !bits )
+        return LSMASH_ERR_MEMORY_ALLOC;
+    uint32_t coded_width  = (param->width  + 7) & ~7;
+    uint32_t coded_height = (param->height + 7) & ~7;
+    uint32_t crop_right   = (coded_width  - param->width)  / 2;
+    uint32_t crop_bottom  = (coded_height - param->height) / 2;
+    /* Video parameter set */
+    lsmash_bits_put( bits, 16, 0x4001 );                    /* nal_unit_type = 32, nuh_temporal_id_plus1 = 1 */
+    lsmash_bits_put( bits, 4, 0 );                          /* vps_video_parameter_set_id */
+    lsmash_bits_put( bits, 2, 3 );                          /* vps_reserved_three_2bits */
+    lsmash_bits_put( bits, 6, 0 );                          /* vps_max_layers_minus1 */
+    lsmash_bits_put( bits, 3, 0 );                          /* vps_max_sub_layers_minus1 */
+    lsmash_bits_put( bits, 1, 1 );                          /* vps_temporal_id_nesting_flag */
+    lsmash_bits_put( bits, 16, 0xFFFF );                    /* vps_reserved_0xffff_16bits */
+    synth_put_hevc_profile_tier_level( bits, param );
+    lsmash_bits_put( bits, 1, 1 );                          /* vps_sub_layer_ordering_info_present_flag */
+    synth_put_ue( bits, synth_imp->composition_delay + 1 ); /* vps_max_dec_pic_buffering_minus1 */
+    synth_put_ue( bits, synth_imp->composition_delay );     /* vps_max_num_reorder_pics */
+    synth_put_ue( bits, 0 );                                /* vps_max_latency_increase_plus1 */
+    lsmash_bits_put( bits, 6, 0 );                          /* vps_max_layer_id */
+    synth_put_ue( bits, 0 );                                /* vps_num_layer_sets_minus1 */
+    lsmash_bits_put( bits, 1, 0 );                          /* vps_timing_info_present_flag */
+    lsmash_bits_put( bits, 1, 0 );                          /* vps_extension_flag */
+    int err = synth_put_nalu( bs, bits );
+    if( err < 0 )
+        goto done;
+    /* Sequence parameter set: Main profile, 4:2:0, 8-bit, progressive */
+    lsmash_bits_put( bits, 16, 0x4201 );                    /* nal_unit_type = 33, nuh_temporal_id_plus1 = 1 */
+    lsmash_bits_put( bits, 4, 0 );                          /* sps_video_parameter_set_id */
+    lsmash_bits_put( bits, 3, 0 );                          /* sps_max_sub_layers_minus1 */
+    lsmash_bits_put( bits, 1, 1 );                          /* sps_temporal_id_nesting_flag */
+    synth_put_hevc_profile_tier_level( bits, param );
+    synth_put_ue( bits, 0 );                                /* sps_seq_parameter_set_id */
+    synth_put_ue( bits, 1 );                                /* chroma_format_idc */
+    synth_put_ue( bits, coded_width );                      /* pic_width_in_luma_samples */
+    synth_put_ue( bits, coded_height );                     /* pic_height_in_luma_samples */
+    lsmash_bits_put( bits, 1, crop_right || crop_bottom );  /* conformance_window_flag */
+    if( crop_right || crop_bottom )
+    {
+        synth_put_ue( bits, 0 );                            /* conf_win_left_offset */
+        synth_put_ue( bits, crop_right );                   /* conf_win_right_offset */
+        synth_put_ue( bits, 0 );                            /* conf_win_top_offset */
+        synth_put_ue( bits, crop_bottom );                  /* conf_win_bottom_offset */
+    }
+    synth_put_ue( bits, 0 );                                /* bit_depth_luma_minus8 */
+    synth_put_ue( bits, 0 );                                /* bit_depth_chroma_minus8 */
+    synth_put_ue( bits, 4 );                                /* log2_max_pic_order_cnt_lsb_minus4 */
+    lsmash_bits_put( bits, 1, 1 );                          /* sps_sub_layer_ordering_info_present_flag */
+    synth_put_ue( bits, synth_imp->composition_delay + 1 ); /* sps_max_dec_pic_buffering_minus1 */
+    synth_put_ue( bits, synth_imp->composition_delay );     /* sps_max_num_reorder_pics */
+    synth_put_ue( bits, 0 );                                /* sps_max_latency_increase_plus1 */
+    synth_put_ue( bits, 0 );                                /* log2_min_luma_coding_block_size_minus3 */
+    synth_put_ue( bits, 3 );                                /* log2_diff_max_min_luma_coding_block_size */
+    synth_put_ue( bits, 0 );                                /* log2_min_luma_transform_block_size_minus2 */
+    synth_put_ue( bits, 3 );                                /* log2_diff_max_min_luma_transform_block_size */
+    synth_put_ue( bits, 1 );                                /* max_transform_hierarchy_depth_inter */
+    synth_put_ue( bits, 1 );                                /* max_transform_hierarchy_depth_intra */
+    lsmash_bits_put( bits, 1, 0 );                          /* scaling_list_enabled_flag */
+    lsmash_bits_put( bits, 1, 1 );                          /* amp_enabled_flag */
+    lsmash_bits_put( bits, 1, 1 );                          /* sample_adaptive_offset_enabled_flag */
+    lsmash_bits_put( bits, 1, 0 );                          /* pcm_enabled_flag */
+    synth_put_ue( bits, 0 );                                /* num_short_term_ref_pic_sets */
+    lsmash_bits_put( bits, 1, 0 );                          /* long_term_ref_pics_present_flag */
+    lsmash_bits_put( bits, 1, 1 );                          /* sps_temporal_mvp_enabled_flag */
+    lsmash_bits_put( bits, 1, 1 );                          /* strong_intra_smoothing_enabled_flag */
+    lsmash_bits_put( bits, 1, 1 );                          /* vui_parameters_present_flag */
+    lsmash_bits_put( bits, 8, 0 );                          /* aspect_ratio_info_present_flag ... default_display_window_flag */
+    lsmash_bits_put( bits, 1, 1 );                          /* vui_timing_info_present_flag */
+    lsmash_bits_put( bits, 32, param->fps_den );            /* vui_num_units_in_tick */
+    lsmash_bits_put( bits, 32, param->fps_num );            /* vui_time_scale */
+    lsmash_bits_put( bits, 1, 0 );                          /* vui_poc_proportional_to_timing_flag */
+    lsmash_bits_put( bits, 1, 0 );                          /* vui_hrd_parameters_present_flag */
+    lsmash_bits_put( bits, 1, 0 );                          /* bitstream_restriction_flag */
+    lsmash_bits_put( bits, 1, 0 );                          /* sps_extension_present_flag */
+    if( (err = synth_put_nalu( bs, bits )) < 0 )
+        goto done;
+    /* Picture parameter set */
+    lsmash_bits_put( bits, 16, 0x4401 );                    /* nal_unit_type = 34, nuh_temporal_id_plus1 = 1 */
+    synth_put_ue( bits, 0 );                                /* pps_pic_parameter_set_id */
+    synth_put_ue( bits, 0 );                                /* pps_seq_parameter_set_id */
+    lsmash_bits_put( bits, 7, 0 );                          /* dependent_slice_segments_enabled_flag ... cabac_init_present_flag */
+    synth_put_ue( bits, 0 );                                /* num_ref_idx_l0_default_active_minus1 */
+    synth_put_ue( bits, 0 );                                /* num_ref_idx_l1_default_active_minus1 */
+    synth_put_ue( bits, 0 );                                /* init_qp_minus26 (se) */
+    lsmash_bits_put( bits, 3, 0 );                          /* constrained_intra_pred_flag ... cu_qp_delta_enabled_flag */
+    synth_put_ue( bits, 0 );                                /* pps_cb_qp_offset (se) */
+    synth_put_ue( bits, 0 );                                /* pps_cr_qp_offset (se) */
+    lsmash_bits_put( bits, 6, 0 );                          /* pps_slice_chroma_qp_offsets_present_flag ... entropy_coding_sync_enabled_flag */
+    lsmash_bits_put( bits, 1, 1 );                          /* pps_loop_filter_across_slices_enabled_flag */
+    lsmash_bits_put( bits, 1, 0 );                          /* deblocking_filter_control_present_flag */
+    lsmash_bits_put( bits, 1, 0 );                          /* pps_scaling_list_data_present_flag */
+    lsmash_bits_put( bits, 1, 0 );                          /* lists_modification_present_flag */
+    synth_put_ue( bits, 0 );                                /* log2_parallel_merge_level_minus2 */
+    lsmash_bits_put( bits, 1, 0 );                          /* slice_segment_header_extension_present_flag */
+    lsmash_bits_put( bits, 1, 0 );                          /* pps_extension_present_flag */
+    err = synth_put_nalu( bs, bits );
+done:
+    lsmash_bits_adhoc_cleanup( bits );
+    return err;
+}
+
+/* Build the decoder configuration record by parsing the generated parameter sets,
+ * so that it is exactly what the NAL unit importers would produce. */
+static lsmash_codec_specific_t *synth_create_nalu_specific_info
+(
+    synth_importer_t *synth_imp
+)
+{
+    int           hevc = (synth_imp->param.codec == SYNTH_CODEC_HEVC);
+    lsmash_bs_t  *bs   = lsmash_bs_create();
+    if( !bs )
+        return NULL;
+    int err = hevc ? synth_put_hevc_parameter_sets( bs, synth_imp )
+                   : synth_put_h264_parameter_sets( bs, synth_imp );
+    uint32_t length;
+    uint8_t *data = err == 0 ? lsmash_bs_export_data( bs, &length ) : NULL;
+    lsmash_bs_cleanup( bs );
+    if( !data )
+        return NULL;
+    lsmash_codec_specific_t *cs = lsmash_create_codec_specific_data( hevc ? LSMASH_CODEC_SPECIFIC_DATA_TYPE_ISOM_VIDEO_HEVC
+                                                                          : LSMASH_CODEC_SPECIFIC_DATA_TYPE_ISOM_VIDEO_H264,
+                                                                     LSMASH_CODEC_SPECIFIC_FORMAT_UNSTRUCTURED );
+    if( !cs )
+    {
+        lsmash_free( data );
+        return NULL;
+    }
+    if( hevc )
+    {
+        lsmash_hevc_specific_parameters_t param = { 0 };
+        if( lsmash_setup_hevc_specific_parameters_from_access_unit( &param, data, length ) == 0 )
+        {
+            param.avgFrameRate       = (uint16_t)LSMASH_MIN( 256 * (uint64_t)synth_imp->param.fps_num / synth_imp->param.fps_den, UINT16_MAX );
+            param.constantFrameRate  = 1;
+            param.lengthSizeMinusOne = NALU_DEFAULT_NALU_LENGTH_SIZE - 1;
+            cs->data.unstructured = lsmash_create_hevc_specific_info( &param, &cs->size );
+        }
+        lsmash_destroy_hevc_parameter_arrays( &param );
+    }
+    else
+    {
+        lsmash_h264_specific_parameters_t param = { 0 };
+        if( lsmash_setup_h264_specific_parameters_from_access_unit( &param, data, length ) == 0 )
+        {
+            param.lengthSizeMinusOne = NALU_DEFAULT_NALU_LENGTH_SIZE - 1;
+            cs->data.unstructured = lsmash_create_h264_specific_info( &param, &cs->size );
+        }
+        lsmash_destroy_h264_parameter_sets( &param );
+    }
+    lsmash_free( data );
+    if( !cs->data.unstructured )
+    {
+        lsmash_destroy_codec_specific_data( cs );
+        return NULL;
+    }
+    return cs;
+}
+
+static int synth_setup_video
+(
+    importer_t       *importer,
+    synth_importer_t *synth_imp
+)
+{
+    synth_param_t *param = &synth_imp->param;
+    if( param->width < 16 || param->width > 16384 || (param->width & 1)
+     || param->height < 16 || param->height > 16384 || (param->height & 1) )
+    {
+        lsmash_log( importer, LSMASH_LOG_ERROR, "the picture size must be even and between 16 and 16384.\n" );
+        return LSMASH_ERR_INVALID_DATA;
+    }
+    if( param->fps_num == 0 || param->fps_den == 0 )
+    {
+        lsmash_log( importer, LSMASH_LOG_ERROR, "invalid frame rate.\n" );
+        return LSMASH_ERR_INVALID_DATA;
+    }
+    if( param->bframes > SYNTH_MAX_BFRAMES )
+    {
+        lsmash_log( importer, LSMASH_LOG_ERROR, "bframes must not exceed %d.\n", SYNTH_MAX_BFRAMES );
+        return LSMASH_ERR_INVALID_DATA;
+    }
+    if( param->gop == 0 )
+        param->gop = LSMASH_MAX( (uint64_t)2 * param->fps_num / param->fps_den, 1 );
+    if( param->bitrate == 0 )
+        param->bitrate = param->codec == SYNTH_CODEC_HEVC ? 5000 : 8000;
+    if( param->frames == 0 )
+        param->frames = (uint64_t)(param->duration * param->fps_num / param->fps_den + 0.5);
+    synth_imp->num_aus           = param->frames;
+    synth_imp->samples_in_frame  = 1;
+    synth_imp->composition_delay = synth_get_composition_delay( synth_imp );
+    /* Distribute the bitrate over the picture types of a GOP. */
+    uint64_t total_weight = 0;
+    uint64_t gop_length   = LSMASH_MIN( param->gop, synth_imp->num_aus );
+    for( uint64_t i = 0; i < gop_length; i++ )
+    {
+        uint64_t display;
+        total_weight += synth_picture_weight[ synth_get_picture( synth_imp, i, &display ) ];
+    }
+    double average_size = (double)param->bitrate * 125 * param->fps_den / param->fps_num;
+    synth_imp->unit_size     = gop_length ? average_size * gop_length / total_weight : average_size;
+    synth_imp->max_au_length = (uint32_t)LSMASH_MIN( synth_imp->unit_size * synth_picture_weight[SYNTH_PICTURE_IDR] * 1.125 + 64, UINT32_MAX / 4 );
+    lsmash_codec_specific_t *cs = synth_create_nalu_specific_info( synth_imp );
+    if( !cs )
+    {
+        lsmash_log( importer, LSMASH_LOG_ERROR, "failed to create the decoder configuration.\n" );
+        return LSMASH_ERR_NAMELESS;
+    }
+    lsmash_video_summary_t *summary = (lsmash_video_summary_t *)lsmash_create_summary( LSMASH_SUMMARY_TYPE_VIDEO );
+    if( !summary )
+    {
+        lsmash_destroy_codec_specific_data( cs );
+        return LSMASH_ERR_MEMORY_ALLOC;
+    }
+    if( lsmash_add_entry( &summary->opaque->list, cs ) < 0 )
+    {
+        lsmash_destroy_codec_specific_data( cs );
+        lsmash_cleanup_summary( (lsmash_summary_t *)summary );
+        return LSMASH_ERR_MEMORY_ALLOC;
+    }
+    summary->sample_type   = param->codec == SYNTH_CODEC_HEVC ? ISOM_CODEC_TYPE_HVC1_VIDEO : ISOM_CODEC_TYPE_AVC1_VIDEO;
+    summary->max_au_length = synth_imp->max_au_length;
+    summary->timescale     = param->fps_num;
+    summary->timebase      = param->fps_den;
+    summary->vfr           = 0;
+    summary->width         = param->width;
+    summary->height        = param->height;
+    if( lsmash_add_entry( importer->summaries, summary ) < 0 )
+    {
+        lsmash_cleanup_summary( (lsmash_summary_t *)summary );
+        return LSMASH_ERR_MEMORY_ALLOC;
+    }
+    return 0;
+}
+
+static void synth_fill_video_sample
+(
+    synth_importer_t *synth_imp,
+    lsmash_sample_t  *sample,
+    uint8_t          *payload
+)
+{
+    uint64_t           display;
+    synth_picture_type type = synth_get_picture( synth_imp, synth_imp->au_number, &display );
+    uint8_t *data = sample->data;
+    LSMASH_SET_BE32( data, sample->length - NALU_DEFAULT_NALU_LENGTH_SIZE );
+    data += NALU_DEFAULT_NALU_LENGTH_SIZE;
+    if( synth_imp->param.codec == SYNTH_CODEC_HEVC )
+    {
+        /* IDR_W_RADL, TRAIL_R or TRAIL_N */
+        static const uint8_t nal_unit_type[4] = { 19, 1, 1, 0 };
+        *data++ = nal_unit_type[type] << 1;
+        *data++ = 1;
+    }
+    else
+    {
+        /* IDR or non-IDR slice with nal_ref_idc */
+        static const uint8_t nal_unit_header[4] = { 0x65, 0x41, 0x21, 0x01 };
+        *data++ = nal_unit_header[type];
+    }
+    uint32_t header_length = data - sample->data;
+    memcpy( data, payload, sample->length - header_length );
+    *data |= 0x80;  /* first_mb_in_slice = 0 or first_slice_segment_in_pic_flag = 1 */
+    sample->dts = synth_imp->au_number;
+    sample->cts = display + synth_imp->composition_delay;
+    sample->prop.leading     = ISOM_SAMPLE_IS_NOT_LEADING;
+    sample->prop.independent = type == SYNTH_PICTURE_IDR ? ISOM_SAMPLE_IS_INDEPENDENT : ISOM_SAMPLE_IS_NOT_INDEPENDENT;
+    sample->prop.disposable  = type == SYNTH_PICTURE_B   ? ISOM_SAMPLE_IS_DISPOSABLE  : ISOM_SAMPLE_IS_NOT_DISPOSABLE;
+    sample->prop.redundant   = ISOM_SAMPLE_HAS_NO_REDUNDANCY;
+    if( type == SYNTH_PICTURE_IDR )
+        sample->prop.ra_flags = ISOM_SAMPLE_RANDOM_ACCESS_FLAG_SYNC;
+    else if( synth_imp->composition_delay && type != SYNTH_PICTURE_B )
+        sample->prop.allow_earlier = QT_SAMPLE_EARLIER_PTS_ALLOWED;
+}
+
+static uint32_t synth_get_video_au_length
+(
+    synth_importer_t *synth_imp
+)
+{
+    uint64_t display;
+    double   size   = synth_imp->unit_size * synth_picture_weight[ synth_get_picture( synth_imp, synth_imp->au_number, &display ) ];
+    /* +/-12.5% jitter */
+    double   jitter = (double)((int)(synth_random( &synth_imp->random_state ) % 257) - 128) / 1024;
+    uint32_t length = (uint32_t)(size * (1 + jitter));
+    return LSMASH_MIN( LSMASH_MAX( length, 16 ), synth_imp->max_au_length );
+}
+
+/***************************************************************************
+    audio
+***************************************************************************/
+static lsmash_audio_summary_t *synth_create_audio_summary
+(
+    synth_importer_t *synth_imp
+)
+{
+    lsmash_audio_summary_t *summary = (lsmash_audio_summary_t *)lsmash_create_summary( LSMASH_SUMMARY_TYPE_AUDIO );
+    if( !summary )
+        return NULL;
+    summary->max_au_length    = synth_imp->max_au_length;
+    summary->aot              = MP4A_AUDIO_OBJECT_TYPE_NULL;
+    summary->frequency        = synth_imp->param.frequency;
+    summary->channels         = synth_imp->param.channels;
+    summary->sample_size      = 16;
+    summary->samples_in_frame = synth_imp->samples_in_frame;
+    summary->sbr_mode         = MP4A_AAC_SBR_NOT_SPECIFIED;
+    return summary;
+}
+
+static int synth_add_codec_specific
+(
+    lsmash_audio_summary_t  *summary,
+    lsmash_codec_specific_t *cs
+)
+{
+    if( !cs )
+        return LSMASH_ERR_MEMORY_ALLOC;
+    if( lsmash_add_entry( &summary->opaque->list, cs ) < 0 )
+    {
+        lsmash_destroy_codec_specific_data( cs );
+        return LSMASH_ERR_MEMORY_ALLOC;
+    }
+    return 0;
+}
+
+static int synth_setup_aac
+(
+    importer_t             *importer,
+    synth_importer_t       *synth_imp,
+    lsmash_audio_summary_t *summary
+)
+{
+    synth_param_t *param = &synth_imp->param;
+    if( param->channels == 0 || param->channels == 7 || param->channels > 8 )
+    {
+        lsmash_log( importer, LSMASH_LOG_ERROR, "AAC supports 1 to 6 or 8 channels.\n" );
+        return LSMASH_ERR_INVALID_DATA;
+    }
+    summary->sample_type = ISOM_CODEC_TYPE_MP4A_AUDIO;
+    summary->aot         = MP4A_AUDIO_OBJECT_TYPE_AAC_LC;
+    uint32_t data_length;
+    uint8_t *data = mp4a_export_AudioSpecificConfig( MP4A_AUDIO_OBJECT_TYPE_AAC_LC, summary->frequency, summary->channels,
+                                                     summary->sbr_mode, NULL, 0, &data_length );
+    if( !data )
+        return LSMASH_ERR_NAMELESS;
+    lsmash_codec_specific_t *cs = lsmash_create_codec_specific_data( LSMASH_CODEC_SPECIFIC_DATA_TYPE_MP4SYS_DECODER_CONFIG,
+                                                                     LSMASH_CODEC_SPECIFIC_FORMAT_STRUCTURED );
+    if( !cs )
+    {
+        lsmash_free( data );
+        return LSMASH_ERR_MEMORY_ALLOC;
+    }
+    lsmash_mp4sys_decoder_parameters_t *mp4sys_param = (lsmash_mp4sys_decoder_parameters_t *)cs->data.structured;
+    mp4sys_param->objectTypeIndication = MP4SYS_OBJECT_TYPE_Audio_ISO_14496_3;
+    mp4sys_param->streamType           = MP4SYS_STREAM_TYPE_AudioStream;
+    int err = lsmash_set_mp4sys_decoder_specific_info( mp4sys_param, data, data_length );
+    lsmash_free( data );
+    if( err < 0 )
+    {
+        lsmash_destroy_codec_specific_data( cs );
+        return err;
+    }
+    return synth_add_codec_specific( summary, cs );
+}
+
+static int synth_setup_ac3
+(
+    importer_t             *importer,
+    synth_importer_t       *synth_imp,
+    lsmash_audio_summary_t *summary
+)
+{
+    synth_param_t *param = &synth_imp->param;
+    static const uint32_t ac3_bitrate_table[19] =
+        { 32, 40, 48, 56, 64, 80, 96, 112, 128, 160, 192, 224, 256, 320, 384, 448, 512, 576, 640 };
+    static const uint8_t acmod_table[7] = { 0, 1, 2, 3, 6, 7, 7 };
+    uint8_t fscod;
+    switch( param->frequency )
+    {
+        case 48000 : fscod = 0; break;
+        case 44100 : fscod = 1; break;
+        case 32000 : fscod = 2; break;
+        default :
+            lsmash_log( importer, LSMASH_LOG_ERROR, "AC-3 supports 32000, 44100 or 48000 Hz only.\n" );
+            return LSMASH_ERR_INVALID_DATA;
+    }
+    if( param->channels == 0 || param->channels > 6 )
+    {
+        lsmash_log( importer, LSMASH_LOG_ERROR, "AC-3 supports 1 to 6 channels.\n" );
+        return LSMASH_ERR_INVALID_DATA;
+    }
+    int rate_index = 0;
+    while( rate_index < 18 && ac3_bitrate_table[rate_index] < param->bitrate )
+        ++rate_index;
+    uint8_t acmod = acmod_table[ param->channels ];
+    uint8_t lfeon = param->channels == 6;
+    /* Every syncframe has the same header; the 44.1kHz padding word is never used. */
+    synth_imp->frame_size = 2 * (uint32_t)((uint64_t)ac3_bitrate_table[rate_index] * 1000 * SYNTH_AC3_FRAME_LENGTH
+                                         / ((uint64_t)param->frequency * 16));
+    lsmash_bits_t *bits = lsmash_bits_adhoc_create();
+    if( !bits )
+        return LSMASH_ERR_MEMORY_ALLOC;
+    lsmash_bits_put( bits, 16, 0x0B77 );            /* syncword */
+    lsmash_bits_put( bits, 16, 0 );                 /* crc1 */
+    lsmash_bits_put( bits, 2, fscod );
+    lsmash_bits_put( bits, 6, rate_index << 1 );    /* frmsizecod */
+    lsmash_bits_put( bits, 5, 8 );                  /* bsid */
+    lsmash_bits_put( bits, 3, 0 );                  /* bsmod */
+    lsmash_bits_put( bits, 3, acmod );
+    if( (acmod & 0x01) && acmod != 0x01 )
+        lsmash_bits_put( bits, 2, 0 );              /* cmixlev */
+    if( acmod & 0x04 )
+        lsmash_bits_put( bits, 2, 0 );              /* surmixlev */
+    if( acmod == 0x02 )
+        lsmash_bits_put( bits, 2, 0 );              /* dsurmod */
+    lsmash_bits_put( bits, 1, lfeon );
+    lsmash_bits_put( bits, 5, 27 );                 /* dialnorm */
+    lsmash_bits_put( bits, 3, 0 );                  /* compre, langcode and audprodie */
+    lsmash_bits_put( bits, 2, 1 );                  /* copyrightb and origbs */
+    lsmash_bits_put( bits, 3, 0 );                  /* timecod1e, timecod2e and addbsie */
+    uint32_t header_length;
+    uint8_t *header = lsmash_bits_export_data( bits, &header_length );
+    lsmash_bits_adhoc_cleanup( bits );
+    if( !header )
+        return LSMASH_ERR_MEMORY_ALLOC;
+    memcpy( synth_imp->header, header, header_length );
+    synth_imp->header_length = header_length;
+    lsmash_free( header );
+    uint8_t frame[AC3_MIN_SYNCFRAME_LENGTH] = { 0 };
+    memcpy( frame, synth_imp->header, synth_imp->header_length );
+    lsmash_ac3_specific_parameters_t dac3_param;
+    int err = lsmash_setup_ac3_specific_parameters_from_syncframe( &dac3_param, frame, AC3_MIN_SYNCFRAME_LENGTH );
+    if( err < 0 )
+        return err;
+    lsmash_codec_specific_t *cs = lsmash_create_codec_specific_data( LSMASH_CODEC_SPECIFIC_DATA_TYPE_ISOM_AUDIO_AC_3,
+                                                                     LSMASH_CODEC_SPECIFIC_FORMAT_UNSTRUCTURED );
+    if( !cs )
+        return LSMASH_ERR_MEMORY_ALLOC;
+    cs->data.unstructured = lsmash_create_ac3_specific_info( &dac3_param, &cs->size );
+    if( !cs->data.unstructured )
+    {
+        lsmash_destroy_codec_specific_data( cs );
+        return LSMASH_ERR_NAMELESS;
+    }
+    summary->sample_type   = ISOM_CODEC_TYPE_AC_3_AUDIO;
+    summary->max_au_length = synth_imp->frame_size;
+    return synth_add_codec_specific( summary, cs );
+}
+
+static int synth_setup_lpcm
+(
+    importer_t             *importer,
+    synth_importer_t       *synth_imp,
+    lsmash_audio_summary_t *summary
+)
+{
+    synth_param_t *param = &synth_imp->param;
+    if( (param->bits & 7) || param->bits == 0 || param->bits > 32 )
+    {
+        lsmash_log( importer, LSMASH_LOG_ERROR, "LPCM supports 8, 16, 24 or 32 bits.\n" );
+        return LSMASH_ERR_INVALID_DATA;
+    }
+    if( param->channels == 0 || param->channels > 1024 )
+    {
+        lsmash_log( importer, LSMASH_LOG_ERROR, "LPCM supports 1 to 1024 channels.\n" );
+        return LSMASH_ERR_INVALID_DATA;
+    }
+    synth_imp->frame_size     = param->channels * (param->bits / 8) * synth_imp->samples_in_frame;
+    summary->sample_type      = QT_CODEC_TYPE_LPCM_AUDIO;
+    summary->sample_size      = param->bits;
+    summary->bytes_per_frame  = synth_imp->frame_size;
+    summary->max_au_length    = synth_imp->frame_size;
+    lsmash_codec_specific_t *cs = lsmash_create_codec_specific_data( LSMASH_CODEC_SPECIFIC_DATA_TYPE_QT_AUDIO_FORMAT_SPECIFIC_FLAGS,
+                                                                     LSMASH_CODEC_SPECIFIC_FORMAT_STRUCTURED );
+    if( !cs )
+        return LSMASH_ERR_MEMORY_ALLOC;
+    lsmash_qt_audio_format_specific_flags_t *lpcm = (lsmash_qt_audio_format_specific_flags_t *)cs->data.structured;
+    lpcm->format_flags = QT_AUDIO_FORMAT_FLAG_PACKED;
+    if( param->bits > 8 )
+        lpcm->format_flags |= QT_AUDIO_FORMAT_FLAG_SIGNED_INTEGER;
+    int err = synth_add_codec_specific( summary, cs );
+    if( err < 0 || param->channels <= 2 )
+        return err;
+    cs = lsmash_create_codec_specific_data( LSMASH_CODEC_SPECIFIC_DATA_TYPE_QT_AUDIO_CHANNEL_LAYOUT,
+                                            LSMASH_CODEC_SPECIFIC_FORMAT_STRUCTURED );
+    if( !cs )
+        return LSMASH_ERR_MEMORY_ALLOC;
+    lsmash_qt_audio_channel_layout_t *layout = (lsmash_qt_audio_channel_layout_t *)cs->data.structured;
+    layout->channelLayoutTag = QT_CHANNEL_LAYOUT_UNKNOWN | param->channels;
+    layout->channelBitmap    = 0;
+    return synth_add_codec_specific( summary, cs );
+}
+
+static int synth_setup_audio
+(
+    importer_t       *importer,
+    synth_importer_t *synth_imp
+)
+{
+    synth_param_t *param = &synth_imp->param;
+    if( param->frequency == 0 )
+    {
+        lsmash_log( importer, LSMASH_LOG_ERROR, "invalid sampling frequency.\n" );
+        return LSMASH_ERR_INVALID_DATA;
+    }
+    switch( param->codec )
+    {
+        case SYNTH_CODEC_AAC :
+            synth_imp->samples_in_frame = SYNTH_AAC_FRAME_LENGTH;
+            if( param->bitrate == 0 )
+                param->bitrate = 128;
+            synth_imp->frame_size    = (uint32_t)((uint64_t)param->bitrate * 125 * SYNTH_AAC_FRAME_LENGTH / param->frequency);
+            synth_imp->frame_size    = LSMASH_MAX( synth_imp->frame_size, 16 );
+            synth_imp->max_au_length = synth_imp->frame_size + synth_imp->frame_size / 8 + 1;
+            break;
+        case SYNTH_CODEC_AC3 :
+            synth_imp->samples_in_frame = SYNTH_AC3_FRAME_LENGTH;
+            if( param->bitrate == 0 )
+                param->bitrate = 448;
+            break;
+        default :
+            synth_imp->samples_in_frame = SYNTH_LPCM_FRAME_LENGTH;
+            break;
+    }
+    if( param->frames == 0 )
+        param->frames = (uint64_t)(param->duration * param->frequency / synth_imp->samples_in_frame + 0.5);
+    synth_imp->num_aus = param->frames;
+    lsmash_audio_summary_t *summary = synth_create_audio_summary( synth_imp );
+    if( !summary )
+        return LSMASH_ERR_MEMORY_ALLOC;
+    int err = param->codec == SYNTH_CODEC_AAC ? synth_setup_aac ( importer, synth_imp, summary )
+            : param->codec == SYNTH_CODEC_AC3 ? synth_setup_ac3 ( importer, synth_imp, summary )
+            :                                   synth_setup_lpcm( importer, synth_imp, summary );
+    if( err < 0 )
+    {
+        lsmash_cleanup_summary( (lsmash_summary_t *)summary );
+        return err;
+    }
+    synth_imp->max_au_length = summary->max_au_length;
+    if( lsmash_add_entry( importer->summaries, summary ) < 0 )
+    {
+        lsmash_cleanup_summary( (lsmash_summary_t *)summary );
+        return LSMASH_ERR_MEMORY_ALLOC;
+    }
+    return 0;
+}
+
+static uint32_t synth_get_audio_au_length
+(
+    synth_importer_t *synth_imp
+)
+{
+    if( synth_imp->param.codec != SYNTH_CODEC_AAC )
+        return synth_imp->frame_size;
+    /* +/-12.5% jitter */
+    uint32_t range = synth_imp->frame_size / 4 + 1;
+    return synth_imp->frame_size - synth_imp->frame_size / 8 + synth_random( &synth_imp->random_state ) % range;
+}
+
+/***************************************************************************
+    importer interfaces
+***************************************************************************/
+static int synth_get_accessunit
+(
+    importer_t       *importer,
+    uint32_t          track_number,
+    lsmash_sample_t **p_sample
+)
+{
+    if( !importer->info )
+        return LSMASH_ERR_NAMELESS;
+    if( track_number != 1 )
+        return LSMASH_ERR_FUNCTION_PARAM;
+    synth_importer_t *synth_imp = (synth_importer_t *)importer->info;
+    if( importer->status == IMPORTER_EOF || synth_imp->au_number >= synth_imp->num_aus )
+    {
+        importer->status = IMPORTER_EOF;
+        return IMPORTER_EOF;
+    }
+    int      video  = synth_imp->param.codec == SYNTH_CODEC_H264 || synth_imp->param.codec == SYNTH_CODEC_HEVC;
+    uint32_t length = video ? synth_get_video_au_length( synth_imp ) : synth_get_audio_au_length( synth_imp );
+    lsmash_sample_t *sample = lsmash_create_sample( length );
+    if( !sample )
+        return LSMASH_ERR_MEMORY_ALLOC;
+    *p_sample = sample;
+    /* Take the payload from a random position in the pool. */
+    uint8_t *payload = synth_imp->pool + synth_random( &synth_imp->random_state ) % (synth_imp->pool_size - length + 1);
+    sample->length = length;
+    if( video )
+        synth_fill_video_sample( synth_imp, sample, payload );
+    else
+    {
+        memcpy( sample->data, payload, length );
+        memcpy( sample->data, synth_imp->header, synth_imp->header_length );
+        sample->dts           = synth_imp->au_number * synth_imp->samples_in_frame;
+        sample->cts           = sample->dts;
+        sample->prop.ra_flags = ISOM_SAMPLE_RANDOM_ACCESS_FLAG_SYNC;
+        if( synth_imp->param.codec == SYNTH_CODEC_AAC )
+            sample->prop.pre_roll.distance = 1; /* MDCT */
+    }
+    ++ synth_imp->au_number;
+    return 0;
+}
+
+static int synth_probe
+(
+    importer_t *importer
+)
+{
+    synth_importer_t *synth_imp = create_synth_importer( importer );
+    if( !synth_imp )
+        return LSMASH_ERR_MEMORY_ALLOC;
+    synth_param_t *param = &synth_imp->param;
+    int err = synth_parse_spec( importer, param );
+    if( err < 0 )
+        goto fail;
+    if( param->frames == 0 && param->duration == 0 )
+        param->duration = SYNTH_DEFAULT_DURATION;
+    err = (param->codec == SYNTH_CODEC_H264 || param->codec == SYNTH_CODEC_HEVC)
+        ? synth_setup_video( importer, synth_imp )
+        : synth_setup_audio( importer, synth_imp );
+    if( err < 0 )
+        goto fail;
+    if( synth_imp->num_aus == 0 )
+    {
+        lsmash_log( importer, LSMASH_LOG_ERROR, "no access units to generate.\n" );
+        err = LSMASH_ERR_INVALID_DATA;
+        goto fail;
+    }
+    /* Access units are cut out of this pool. Zero bytes are avoided so that
+     * the payload never emulates a start code. */
+    synth_imp->random_state = param->seed ? param->seed : 0x9E3779B9;
+    synth_imp->pool_size    = 2 * synth_imp->max_au_length;
+    synth_imp->pool         = lsmash_malloc( synth_imp->pool_size );
+    if( !synth_imp->pool )
+    {
+        err = LSMASH_ERR_MEMORY_ALLOC;
+        goto fail;
+    }
+    for( uint32_t i = 0; i < synth_imp->pool_size; i++ )
+    {
+        uint8_t byte = synth_random( &synth_imp->random_state ) >> 24;
+        synth_imp->pool[i] = byte ? byte : 0x80;
+    }
+    synth_imp->au_number = 0;
+    importer->info   = synth_imp;
+    importer->status = IMPORTER_OK;
+    return 0;
+fail:
+    lsmash_remove_entries( importer->summaries, lsmash_cleanup_summary );
+    remove_synth_importer( synth_imp );
+    return err;
+}
+
+static uint32_t synth_get_last_delta
+(
+    importer_t *importer,
+    uint32_t    track_number
+)
+{
+    debug_if( !importer || !importer->info )
+        return 0;
+    synth_importer_t *synth_imp = (synth_importer_t *)importer->info;
+    if( !synth_imp || track_number != 1 )
+        return 0;
+    return synth_imp->samples_in_frame;
+}
+
+const importer_functions synthetic_importer =
+{
+    { "synthetic", offsetof( importer_t, log_level ) },
+    1,
+    synth_probe,
+    synth_get_accessunit,
+    synth_get_last_delta,
+    synth_cleanup
+};
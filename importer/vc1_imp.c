@@ -35,11 +35,26 @@
 ***************************************************************************/
 #include "codecs/vc1.h"
 
+/* Properties of each access unit retrieved in the analysis of the whole stream.
+ * The access units flagged with VC1_AU_FLAG_ENTRY_POINT make the index of random access points.
+ * Whether they are actually random accessible or not is decided after the analysis
+ * since it depends on the presence of multiple sequence headers. */
+typedef enum
+{
+    VC1_AU_FLAG_ENTRY_POINT       = 0x01,   /* The frame follows an entry-point header. */
+    VC1_AU_FLAG_START_OF_SEQUENCE = 0x02,   /* The frame follows a sequence header. */
+    VC1_AU_FLAG_CLOSED_GOP        = 0x04,
+    VC1_AU_FLAG_INDEPENDENT       = 0x08,
+    VC1_AU_FLAG_NON_BIPREDICTIVE  = 0x10,
+    VC1_AU_FLAG_DISPOSABLE        = 0x20,
+} vc1_au_flag;
+
 typedef struct
 {
     vc1_info_t             info;
     vc1_sequence_header_t  first_sequence;
     lsmash_media_ts_list_t ts_list;
+    uint8_t               *au_flags;
     uint8_t  composition_reordering_present;
     uint32_t max_au_length;
     uint32_t num_undecodable;
@@ -52,6 +67,7 @@ static void remove_vc1_importer( vc1_importer_t *vc1_imp )
         return;
     vc1_cleanup_parser( &vc1_imp->info );
     lsmash_free( vc1_imp->ts_list.timestamp );
+    lsmash_free( vc1_imp->au_flags );
     lsmash_free( vc1_imp );
 }
 
@@ -78,14 +94,42 @@ static inline int vc1_complete_au( vc1_access_unit_t *access_unit, vc1_picture_i
 {
     if( !picture->present )
         return 0;
-    if( !probe )
-        memcpy( access_unit->data, access_unit->incomplete_data, access_unit->incomplete_data_length );
     access_unit->data_length = access_unit->incomplete_data_length;
     access_unit->incomplete_data_length = 0;
-    vc1_update_au_property( access_unit, picture );
+    if( probe )
+        vc1_update_au_property( access_unit, picture );
+    else
+    {
+        /* The properties are got from the index constructed in the analysis. */
+        memcpy( access_unit->data, access_unit->incomplete_data, access_unit->data_length );
+        picture->present = 0;
+    }
     return 1;
 }
 
+static inline uint8_t vc1_get_au_flags( vc1_access_unit_t *access_unit )
+{
+    return (access_unit->random_accessible ? VC1_AU_FLAG_ENTRY_POINT       : 0)
+         | (access_unit->start_of_sequence ? VC1_AU_FLAG_START_OF_SEQUENCE : 0)
+         | (access_unit->closed_gop        ? VC1_AU_FLAG_CLOSED_GOP        : 0)
+         | (access_unit->independent       ? VC1_AU_FLAG_INDEPENDENT       : 0)
+         | (access_unit->non_bipredictive  ? VC1_AU_FLAG_NON_BIPREDICTIVE  : 0)
+         | (access_unit->disposable        ? VC1_AU_FLAG_DISPOSABLE        : 0);
+}
+
+static inline void vc1_set_au_flags( vc1_access_unit_t *access_unit, uint8_t flags, int multiple_sequence )
+{
+    /* Entry-point doesn't indicate the frame is a random access point when multiple sequence headers are present,
+     * since it is necessary to decode sequence header which subsequent frames belong to for decoding them. */
+    access_unit->random_accessible = (flags & VC1_AU_FLAG_ENTRY_POINT)
+                                  && (!multiple_sequence || (flags & VC1_AU_FLAG_START_OF_SEQUENCE));
+    access_unit->start_of_sequence = !!(flags & VC1_AU_FLAG_START_OF_SEQUENCE);
+    access_unit->closed_gop        = !!(flags & VC1_AU_FLAG_CLOSED_GOP);
+    access_unit->independent       = !!(flags & VC1_AU_FLAG_INDEPENDENT);
+    access_unit->non_bipredictive  = !!(flags & VC1_AU_FLAG_NON_BIPREDICTIVE);
+    access_unit->disposable        = !!(flags & VC1_AU_FLAG_DISPOSABLE);
+}
+
 static inline void vc1_append_ebdu_to_au( vc1_access_unit_t *access_unit, uint8_t *ebdu, uint32_t ebdu_length, int probe )
 {
     if( !probe )
@@ -111,6 +155,81 @@ static int vc1_get_au_internal_failed( vc1_importer_t *vc1_imp, int complete_au,
     return ret;
 }
 
+/* Parse an EBDU in the analysis of the whole stream. */
+static int vc1_importer_parse_ebdu( importer_t *importer, uint8_t bdu_type, uint8_t *ebdu, uint64_t ebdu_length )
+{
+    vc1_importer_t *vc1_imp = (vc1_importer_t *)importer->info;
+    vc1_info_t     *info    = &vc1_imp->info;
+    int err;
+    switch( bdu_type )
+    {
+        /* FRM_SC: Frame start code
+         * FLD_SC: Field start code
+         * SLC_SC: Slice start code
+         * SEQ_SC: Sequence header start code
+         * EP_SC:  Entry-point start code
+         * PIC_L:  Picture layer
+         * SLC_L:  Slice layer
+         * SEQ_L:  Sequence layer
+         * EP_L:   Entry-point layer */
+        case 0x0D : /* Frame
+                     * For the Progressive or Frame Interlace mode, shall signal the beginning of a new video frame.
+                     * For the Field Interlace mode, shall signal the beginning of a sequence of two independently coded video fields.
+                     * [FRM_SC][PIC_L][[FLD_SC][PIC_L] (optional)][[SLC_SC][SLC_L] (optional)] ...  */
+            if( (err = vc1_parse_advanced_picture( info->bits, &info->sequence, &info->picture, info->buffer.rbdu, ebdu, ebdu_length )) < 0 )
+            {
+                lsmash_log( importer, LSMASH_LOG_ERROR, "failed to parse a frame.\n" );
+                return err;
+            }
+        case 0x0C : /* Field
+                     * Shall only be used for Field Interlaced frames
+                     * and shall only be used to signal the beginning of the second field of the frame.
+                     * [FRM_SC][PIC_L][FLD_SC][PIC_L][[SLC_SC][SLC_L] (optional)] ...
+                     * Field start code is followed by INTERLACE_FIELD_PICTURE_FIELD2() which doesn't have info of its field picture type.*/
+            break;
+        case 0x0B : /* Slice
+                     * Shall not be used for start code of the first slice of a frame.
+                     * Shall not be used for start code of the first slice of an interlace field coded picture.
+                     * [FRM_SC][PIC_L][[FLD_SC][PIC_L] (optional)][SLC_SC][SLC_L][[SLC_SC][SLC_L] (optional)] ...
+                     * Slice layer may repeat frame header. We just ignore it. */
+            info->dvc1_param.slice_present = 1;
+            break;
+        case 0x0E : /* Entry-point header
+                     * Entry-point indicates the direct followed frame is a start of group of frames.
+                     * Entry-point doesn't indicates the frame is a random access point when multiple sequence headers are present,
+                     * since it is necessary to decode sequence header which subsequent frames belong to for decoding them.
+                     * Entry point shall be followed by
+                     *   1. I-picture - progressive or frame interlace
+                     *   2. I/I-picture, I/P-picture, or P/I-picture - field interlace
+                     * [[SEQ_SC][SEQ_L] (optional)][EP_SC][EP_L][FRM_SC][PIC_L] ... */
+            if( (err = vc1_parse_entry_point_header( info, ebdu, ebdu_length, 1 )) < 0 )
+            {
+                lsmash_log( importer, LSMASH_LOG_ERROR, "failed to parse an entry point.\n" );
+                return err;
+            }
+            /* Signal random access type of the frame that follows this entry-point header.
+             * Here, the frame is just marked since the presence of multiple sequence headers is unknown until the end of the analysis. */
+            info->picture.closed_gop        = info->entry_point.closed_entry_point;
+            info->picture.random_accessible = 1;
+            break;
+        case 0x0F : /* Sequence header
+                     * [SEQ_SC][SEQ_L][EP_SC][EP_L][FRM_SC][PIC_L] ... */
+            if( (err = vc1_parse_sequence_header( info, ebdu, ebdu_length, 1 )) < 0 )
+            {
+                lsmash_log( importer, LSMASH_LOG_ERROR, "failed to parse a sequence header.\n" );
+                return err;
+            }
+            /* The frame that is the first frame after this sequence header shall be a random accessible point. */
+            info->picture.start_of_sequence = 1;
+            if( !vc1_imp->first_sequence.present )
+                vc1_imp->first_sequence = info->sequence;
+            break;
+        default :   /* End-of-sequence (0x0A) */
+            break;
+    }
+    return 0;
+}
+
 static int vc1_importer_get_access_unit_internal( importer_t *importer, int probe )
 {
     vc1_importer_t      *vc1_imp     = (vc1_importer_t *)importer->info;
@@ -167,71 +286,15 @@ static int vc1_importer_get_access_unit_internal( importer_t *importer, int prob
             }
             /* Process EBDU by its BDU type and append it to access unit. */
             uint8_t *ebdu = lsmash_bs_get_buffer_data( bs );
-            switch( bdu_type )
+            if( probe )
             {
-                /* FRM_SC: Frame start code
-                 * FLD_SC: Field start code
-                 * SLC_SC: Slice start code
-                 * SEQ_SC: Sequence header start code
-                 * EP_SC:  Entry-point start code
-                 * PIC_L:  Picture layer
-                 * SLC_L:  Slice layer
-                 * SEQ_L:  Sequence layer
-                 * EP_L:   Entry-point layer */
-                case 0x0D : /* Frame
-                             * For the Progressive or Frame Interlace mode, shall signal the beginning of a new video frame.
-                             * For the Field Interlace mode, shall signal the beginning of a sequence of two independently coded video fields.
-                             * [FRM_SC][PIC_L][[FLD_SC][PIC_L] (optional)][[SLC_SC][SLC_L] (optional)] ...  */
-                    if( (err = vc1_parse_advanced_picture( info->bits, &info->sequence, &info->picture, sb->rbdu, ebdu, ebdu_length )) < 0 )
-                    {
-                        lsmash_log( importer, LSMASH_LOG_ERROR, "failed to parse a frame.\n" );
-                        return vc1_get_au_internal_failed( vc1_imp, complete_au, err );
-                    }
-                case 0x0C : /* Field
-                             * Shall only be used for Field Interlaced frames
-                             * and shall only be used to signal the beginning of the second field of the frame.
-                             * [FRM_SC][PIC_L][FLD_SC][PIC_L][[SLC_SC][SLC_L] (optional)] ...
-                             * Field start code is followed by INTERLACE_FIELD_PICTURE_FIELD2() which doesn't have info of its field picture type.*/
-                    break;
-                case 0x0B : /* Slice
-                             * Shall not be used for start code of the first slice of a frame.
-                             * Shall not be used for start code of the first slice of an interlace field coded picture.
-                             * [FRM_SC][PIC_L][[FLD_SC][PIC_L] (optional)][SLC_SC][SLC_L][[SLC_SC][SLC_L] (optional)] ...
-                             * Slice layer may repeat frame header. We just ignore it. */
-                    info->dvc1_param.slice_present = 1;
-                    break;
-                case 0x0E : /* Entry-point header
-                             * Entry-point indicates the direct followed frame is a start of group of frames.
-                             * Entry-point doesn't indicates the frame is a random access point when multiple sequence headers are present,
-                             * since it is necessary to decode sequence header which subsequent frames belong to for decoding them.
-                             * Entry point shall be followed by
-                             *   1. I-picture - progressive or frame interlace
-                             *   2. I/I-picture, I/P-picture, or P/I-picture - field interlace
-                             * [[SEQ_SC][SEQ_L] (optional)][EP_SC][EP_L][FRM_SC][PIC_L] ... */
-                    if( (err = vc1_parse_entry_point_header( info, ebdu, ebdu_length, probe )) < 0 )
-                    {
-                        lsmash_log( importer, LSMASH_LOG_ERROR, "failed to parse an entry point.\n" );
-                        return vc1_get_au_internal_failed( vc1_imp, complete_au, err );
-                    }
-                    /* Signal random access type of the frame that follows this entry-point header. */
-                    info->picture.closed_gop        = info->entry_point.closed_entry_point;
-                    info->picture.random_accessible = info->dvc1_param.multiple_sequence ? info->picture.start_of_sequence : 1;
-                    break;
-                case 0x0F : /* Sequence header
-                             * [SEQ_SC][SEQ_L][EP_SC][EP_L][FRM_SC][PIC_L] ... */
-                    if( (err = vc1_parse_sequence_header( info, ebdu, ebdu_length, probe )) < 0 )
-                    {
-                        lsmash_log( importer, LSMASH_LOG_ERROR, "failed to parse a sequence header.\n" );
-                        return vc1_get_au_internal_failed( vc1_imp, complete_au, err );
-                    }
-                    /* The frame that is the first frame after this sequence header shall be a random accessible point. */
-                    info->picture.start_of_sequence = 1;
-                    if( probe && !vc1_imp->first_sequence.present )
-                        vc1_imp->first_sequence = info->sequence;
-                    break;
-                default :   /* End-of-sequence (0x0A) */
-                    break;
+                if( (err = vc1_importer_parse_ebdu( importer, bdu_type, ebdu, ebdu_length )) < 0 )
+                    return vc1_get_au_internal_failed( vc1_imp, complete_au, err );
             }
+            else
+                /* All headers have already been parsed in the analysis of the whole stream.
+                 * Here, just delimit access units. Their properties are got from the index. */
+                info->picture.present |= (bdu_type == 0x0D);
             /* Append the current EBDU into the end of an incomplete access unit. */
             vc1_append_ebdu_to_au( access_unit, ebdu, ebdu_length, probe );
         }
@@ -285,12 +348,19 @@ static int vc1_importer_get_accessunit( importer_t *importer, uint32_t track_num
         importer->status = IMPORTER_ERROR;
         return err;
     }
+    vc1_access_unit_t *access_unit = &info->access_unit;
+    if( access_unit->number > vc1_imp->ts_list.sample_count )
+    {
+        /* The stream is not the same as the analyzed one. */
+        importer->status = IMPORTER_ERROR;
+        return LSMASH_ERR_INVALID_DATA;
+    }
     lsmash_sample_t *sample = lsmash_create_sample( vc1_imp->max_au_length );
     if( !sample )
         return LSMASH_ERR_MEMORY_ALLOC;
     *p_sample = sample;
-    vc1_access_unit_t *access_unit = &info->access_unit;
     vc1_importer_check_eof( importer, access_unit );
+    vc1_set_au_flags( access_unit, vc1_imp->au_flags[ access_unit->number - 1 ], info->dvc1_param.multiple_sequence );
     sample->dts = vc1_imp->ts_list.timestamp[ access_unit->number - 1 ].dts;
     sample->cts = vc1_imp->ts_list.timestamp[ access_unit->number - 1 ].cts;
     sample->prop.leading = access_unit->independent
@@ -350,6 +420,13 @@ static lsmash_video_summary_t *vc1_create_summary( vc1_info_t *info, vc1_sequenc
     return summary;
 }
 
+/* The import stays in two passes even for Advanced Profile, though the access units could be delimited
+ * and timestamped in a single pass with a lookahead of consecutive B-pictures.
+ * The VC-1 specific info (dvc1) in the summary, which is made before the first sample is given,
+ * carries the properties of the whole stream: no_multiple_seq, no_multiple_entry, no_slice_code and no_bframe.
+ * Besides, whether an entry-point is a sync sample depends on the presence of multiple sequence headers.
+ * Clearing these flags without the analysis would keep the output valid but lose the sync samples
+ * at the entry-points without sequence headers, so the stream is analyzed in advance. */
 static int vc1_analyze_whole_stream
 (
     importer_t *importer
@@ -360,6 +437,12 @@ static int vc1_analyze_whole_stream
     uint64_t *cts = lsmash_malloc( cts_alloc );
     if( !cts )
         return LSMASH_ERR_MEMORY_ALLOC; /* Failed to allocate CTS list */
+    uint8_t *au_flags = lsmash_malloc( cts_alloc / sizeof(uint64_t) );
+    if( !au_flags )
+    {
+        lsmash_free( cts );
+        return LSMASH_ERR_MEMORY_ALLOC; /* Failed to allocate the index of access units */
+    }
     uint32_t num_access_units  = 0;
     uint32_t num_consecutive_b = 0;
     lsmash_class_t *logger = &(lsmash_class_t){ "VC-1" };
@@ -376,6 +459,26 @@ static int vc1_analyze_whole_stream
         if( (err = vc1_importer_get_access_unit_internal( importer, 1 )) < 0 )
             goto fail;
         vc1_importer_check_eof( importer, &info->access_unit );
+        if( cts_alloc <= num_access_units * sizeof(uint64_t) )
+        {
+            uint32_t alloc = 2 * num_access_units * sizeof(uint64_t);
+            uint64_t *temp = lsmash_realloc( cts, alloc );
+            if( !temp )
+            {
+                err = LSMASH_ERR_MEMORY_ALLOC;
+                goto fail;  /* Failed to re-allocate CTS list */
+            }
+            cts = temp;
+            uint8_t *temp_flags = lsmash_realloc( au_flags, alloc / sizeof(uint64_t) );
+            if( !temp_flags )
+            {
+                err = LSMASH_ERR_MEMORY_ALLOC;
+                goto fail;  /* Failed to re-allocate the index of access units */
+            }
+            au_flags  = temp_flags;
+            cts_alloc = alloc;
+        }
+        au_flags[ num_access_units ] = vc1_get_au_flags( &info->access_unit );
         /* In the case where B-pictures exist
          * Decode order
          *      I[0]P[1]P[2]B[3]B[4]P[5]...
@@ -400,18 +503,6 @@ static int vc1_analyze_whole_stream
             ++num_consecutive_b;
             info->dvc1_param.bframe_present = 1;
         }
-        if( cts_alloc <= num_access_units * sizeof(uint64_t) )
-        {
-            uint32_t alloc = 2 * num_access_units * sizeof(uint64_t);
-            uint64_t *temp = lsmash_realloc( cts, alloc );
-            if( !temp )
-            {
-                err = LSMASH_ERR_MEMORY_ALLOC;
-                goto fail;  /* Failed to re-allocate CTS list */
-            }
-            cts = temp;
-            cts_alloc = alloc;
-        }
         vc1_imp->max_au_length = LSMASH_MAX( info->access_unit.data_length, vc1_imp->max_au_length );
         ++num_access_units;
     }
@@ -452,10 +543,12 @@ static int vc1_analyze_whole_stream
 #endif
     vc1_imp->ts_list.sample_count = num_access_units;
     vc1_imp->ts_list.timestamp    = timestamp;
+    vc1_imp->au_flags             = au_flags;
     return 0;
 fail:
     lsmash_log_refresh_line( &logger );
     lsmash_free( cts );
+    lsmash_free( au_flags );
     return err;
 }
 
@@ -491,7 +584,11 @@ static int vc1_importer_probe( importer_t *importer )
     vc1_info_t *info = &vc1_imp->info;
     lsmash_bs_read_seek( bs, first_ebdu_head_pos, SEEK_SET );
     info->ebdu_head_pos = first_ebdu_head_pos;
-    if( (err = vc1_analyze_whole_stream( importer )) < 0 )
+    isom_trace_begin( importer->file->root, LSMASH_TRACE_PHASE_IMPORTER_ANALYSIS );
+    err = vc1_analyze_whole_stream( importer );
+    isom_trace_end( importer->file->root, LSMASH_TRACE_PHASE_IMPORTER_ANALYSIS,
+                    lsmash_bs_get_stream_pos( bs ), vc1_imp->ts_list.sample_count );
+    if( err < 0 )
         goto fail;
     lsmash_video_summary_t *summary = vc1_create_summary( info, &vc1_imp->first_sequence, vc1_imp->max_au_length );
     if( !summary )
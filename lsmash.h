@@ -73,6 +73,12 @@ enum
 /****************************************************************************
  * ROOT
  *   The top-level opaque handler for whole file handling.
+ *
+ *   Thread safety
+ *     Distinct ROOTs may be used from different threads concurrently.
+ *     A ROOT and everything derived from it, such as files, tracks, importers and
+ *     sample pools, must not be used from two or more threads at the same time
+ *     without synchronization by the caller.
  ****************************************************************************/
 typedef struct lsmash_root_tag lsmash_root_t;
 
@@ -92,6 +98,49 @@ void lsmash_destroy_root
     lsmash_root_t *root     /* the address of a ROOT you want to deallocate */
 );
 
+/* Tracing
+ *   The phases of the processing on a ROOT can be observed through the tracing callbacks.
+ *   'begin' is called when a phase starts, and 'end' is called when the phase ends.
+ *   Phases may nest, e.g. LSMASH_TRACE_PHASE_CHUNK_WRITE inside LSMASH_TRACE_PHASE_SAMPLE_APPEND.
+ *   Importers report their analyses to the ROOT which the input file belongs to.
+ *   If L-SMASH is compiled with LSMASH_DISABLE_TRACE defined, no callback is ever called. */
+typedef enum
+{
+    LSMASH_TRACE_PHASE_IMPORTER_ANALYSIS = 0,   /* analysis of a whole elementary stream by an importer */
+    LSMASH_TRACE_PHASE_READ_FILE,               /* lsmash_read_file() */
+    LSMASH_TRACE_PHASE_SAMPLE_APPEND,           /* lsmash_append_sample() and lsmash_append_chunk() */
+    LSMASH_TRACE_PHASE_SAMPLE_POOLING,          /* copying a sample into the pool of the current chunk */
+    LSMASH_TRACE_PHASE_INTERLEAVE,              /* flushing a chunk of another track to keep the interleaving */
+    LSMASH_TRACE_PHASE_CHUNK_WRITE,             /* writing a chunk into the output */
+    LSMASH_TRACE_PHASE_FRAGMENT_FLUSH,          /* writing a movie fragment into the output */
+    LSMASH_TRACE_PHASE_FINISH_MOVIE,            /* lsmash_finish_movie() */
+    LSMASH_TRACE_PHASE_REARRANGE,               /* moving the media data to place the Movie Box in front of it */
+    LSMASH_TRACE_PHASE_NUM                      /* the number of the phases, not a phase */
+} lsmash_trace_phase;
+
+typedef void (*lsmash_trace_begin_callback)( void *opaque, lsmash_trace_phase phase );
+typedef void (*lsmash_trace_end_callback)( void *opaque, lsmash_trace_phase phase, uint64_t bytes, uint64_t samples );
+
+typedef struct
+{
+    lsmash_trace_begin_callback begin;      /* called when a phase starts */
+    lsmash_trace_end_callback   end;        /* called when a phase ends with the amount of bytes and samples processed in it
+                                             * Either of them is set to 0 if not applicable to the phase. */
+    void                       *opaque;     /* the user data passed to the callbacks */
+} lsmash_trace_callbacks_t;
+
+/* Attach the tracing callbacks to a given ROOT.
+ * If 'callbacks' is set to NULL, the callbacks attached to the ROOT are detached.
+ *
+ * Return 0 if successful.
+ * Return LSMASH_ERR_PATCH_WELCOME if L-SMASH is compiled without the tracing hooks.
+ * Return a negative value otherwise. */
+int lsmash_set_trace_callbacks
+(
+    lsmash_root_t            *root,
+    lsmash_trace_callbacks_t *callbacks
+);
+
 /****************************************************************************
  * File Layer
  ****************************************************************************/
@@ -267,13 +316,16 @@ typedef struct
 
 /* Open a file where the path is given.
  * And if successful, set up the parameters by 'open_mode'.
- * Here, the 'open_mode' parameter is either 0 or 1 as follows:
+ * Here, the 'open_mode' parameter is one of the following:
  *   0: Create a file for output/muxing operations.
  *      If a file with the same name already exists, its contents are discarded and the file is treated as a new file.
  *      If user specifies "-" for 'filename', operations are done on stdout.
  *      The file types or segment types are set up as specified in 'param'.
  *   1: Open a file for input/demuxing operations. The file must exist.
  *      If user specifies "-" for 'filename', operations are done on stdin.
+ *   2: Open a file for input/demuxing operations and in-place editing. The file must exist.
+ *      The movie can be written back into the file by lsmash_write_movie_in_place().
+ *      Neither stdin nor stdout can be specified.
  *
  * This function sets up file modes minimally.
  * User can add additional modes and/or remove modes already set later.
@@ -1603,6 +1655,25 @@ int lsmash_append_sample
     lsmash_sample_t *sample
 );
 
+/* Append samples to a track as a chunk and write their data as it is.
+ * 'samples' is an array of 'sample_count' samples whose data are stored contiguously in 'data' in the same order.
+ * 'data' of each sample is ignored, and all the samples must have the same 'index'.
+ * Samples appended by lsmash_append_sample() before are written as the preceding chunk.
+ * This function is available only for non-fragmented movie.
+ * Note:
+ *   Unlike lsmash_append_sample(), neither the samples nor 'data' are deallocated internally.
+ *
+ * Return 0 if successful.
+ * Return a negative value otherwise. */
+int lsmash_append_chunk
+(
+    lsmash_root_t   *root,
+    uint32_t         track_ID,
+    lsmash_sample_t *samples,
+    uint32_t         sample_count,
+    uint8_t         *data
+);
+
 /****************************************************************************
  * Media Layer
  ****************************************************************************/
@@ -2230,6 +2301,124 @@ int lsmash_set_movie_parameters
     lsmash_movie_parameters_t *param
 );
 
+/* Write the movie of a file opened with 'open_mode' equal to 2 back into the file without touching the media data.
+ * The sample tables and the durations of each track are rebuilt from its media timeline constructed
+ * and possibly edited by lsmash_set_media_timestamps(). The other boxes such as the user data and the metadata
+ * are written as they are, so they can be updated by the same functions as for muxing before calling this function.
+ * The new Movie Box overwrites the old one if it fits in the space taken by the old one and the Free Space Boxes
+ * just after it. Otherwise, it is appended to the end of the file and the old one is turned into a Free Space Box.
+ * Fragmented movies are not supported.
+ *
+ * Return 0 if successful.
+ * Return a negative value otherwise. */
+int lsmash_write_movie_in_place
+(
+    lsmash_root_t *root
+);
+
+/* Reserve 'size' bytes of padding as a Free Space Box at the end of the Movie Box of a movie for output.
+ * The padding lets the movie be grown later by lsmash_write_movie_in_place() without relocating the Movie Box.
+ * 'size' must be 8 or more since it includes the box header.
+ *
+ * Return 0 if successful.
+ * Return a negative value otherwise. */
+int lsmash_reserve_movie_padding
+(
+    lsmash_root_t *root,
+    uint32_t       size
+);
+
+typedef struct
+{
+    uint64_t offset;    /* the position of the data in the source file */
+    uint64_t length;    /* the size of the data in bytes */
+} lsmash_data_range_t;
+
+typedef struct
+{
+    uint8_t             *header;        /* the boxes preceding the media data
+                                         *   a clip: the File Type Box, the Movie Box and the header of the Media Data Box
+                                         *   an initialization segment: the File Type Box and the Movie Box
+                                         *   a media segment: the Movie Fragment Box and the header of the Media Data Box */
+    uint64_t             header_size;
+    lsmash_data_range_t *range;         /* the ranges of the source file which follow the header in this order */
+    uint32_t             num_ranges;
+    uint64_t             size;          /* the total size of the clip file */
+} lsmash_virtual_clip_t;
+
+/* Create a virtual clip of the presentation in the range ['start_time', 'end_time') in the movie timescale
+ * from a movie opened with 'open_mode' equal to 1 or 2. 'end_time' equal to 0 means the end of the presentation.
+ * The clip file consists of the header followed by the data in the ranges of the source file,
+ * so it can be served without copying the media data, e.g. by sendfile().
+ * The sample tables of each track are trimmed to the samples from the closest random accessible point before
+ * 'start_time' to the last one presented before 'end_time', and a single edit trims the presentation precisely.
+ * The chunk offsets are rebased on the clip. A track with no sample in the range is left empty.
+ * The timelines of all tracks have to be constructed by lsmash_construct_timeline() in advance.
+ * The movie is modified temporarily during the call, so calls on the same root must not run concurrently.
+ * Fragmented movies and the samples in other files are not supported.
+ * The allocated header and ranges can be deallocated by lsmash_cleanup_virtual_clip().
+ *
+ * Return 0 if successful.
+ * Return a negative value otherwise. */
+int lsmash_create_virtual_clip
+(
+    lsmash_root_t         *root,
+    uint64_t               start_time,
+    uint64_t               end_time,
+    lsmash_virtual_clip_t *clip
+);
+
+void lsmash_cleanup_virtual_clip
+(
+    lsmash_virtual_clip_t *clip
+);
+
+/* Create a virtual initialization segment of the fragmented presentation made from a movie opened with 'open_mode'
+ * equal to 1 or 2, so the movie can be served as segments without being remuxed by lsmash_create_virtual_media_segment().
+ * The segment consists of the Movie Box where each track has no sample and the Movie Extends Box is added.
+ * The edits of each track are left as they are since they apply to the samples in the movie fragments as well.
+ * The same conditions as lsmash_create_virtual_clip() apply, and the segment has no range of the source file.
+ * The allocated header can be deallocated by lsmash_cleanup_virtual_clip().
+ *
+ * Return 0 if successful.
+ * Return a negative value otherwise. */
+int lsmash_create_virtual_initialization_segment
+(
+    lsmash_root_t         *root,
+    lsmash_virtual_clip_t *segment
+);
+
+/* Count the media segments of the fragmented presentation made from a movie by lsmash_create_virtual_media_segment().
+ *
+ * Return the number of the media segments if successful.
+ * Return 0 otherwise. */
+uint32_t lsmash_count_virtual_media_segments
+(
+    lsmash_root_t *root,
+    uint64_t       segment_duration     /* the nominal duration of a media segment in the movie timescale */
+);
+
+/* Create the virtual media segment specified by 'segment_number' of the fragmented presentation made from a movie
+ * opened with 'open_mode' equal to 1 or 2. Media segments are numbered from 1, and follow the segment made by
+ * lsmash_create_virtual_initialization_segment().
+ * Each media segment starts with a random accessible sample of the reference track, which is the first video track
+ * if any and the first track otherwise, at least 'segment_duration' after the start of the previous one.
+ * The other tracks contribute the samples decoded in the same span of time.
+ * The segment consists of a single movie fragment followed by the data in the ranges of the source file,
+ * so it can be served without copying the media data.
+ * The same conditions as lsmash_create_virtual_clip() apply.
+ * The allocated header and ranges can be deallocated by lsmash_cleanup_virtual_clip().
+ *
+ * Return 0 if successful.
+ * Return a negative value otherwise. */
+int lsmash_create_virtual_media_segment
+(
+    lsmash_root_t         *root,
+    uint64_t               segment_duration,    /* the nominal duration of a media segment in the movie timescale */
+    uint32_t               segment_number,
+    lsmash_virtual_clip_t *segment
+);
+
 /* Finalize a movie.
  * If the movie is not fragmented and 'remux' is set to non-NULL,
  * move overall necessary data to access and decode samples into the very front of the file at the end.
@@ -2363,6 +2552,52 @@ int lsmash_print_movie
     const char    *filename     /* the path of a file as the destination */
 );
 
+typedef enum
+{
+    LSMASH_PRINT_FORMAT_TEXT   = 0,     /* human readable text */
+    LSMASH_PRINT_FORMAT_JSON   = 1,     /* a JSON object of the file with nested boxes in 'children' */
+    LSMASH_PRINT_FORMAT_NDJSON = 2,     /* newline delimited JSON: a JSON object per box with its nesting 'level' */
+} lsmash_print_format;
+
+typedef struct
+{
+    lsmash_print_format        format;          /* the output format */
+    int                        max_depth;       /* the maximum nesting depth of boxes to print
+                                                 * 1 means top-level boxes only, and 0 means unlimited. */
+    uint32_t                   max_entries;     /* the maximum number of entries to print per table, e.g. Sample Size Box
+                                                 * 0 means unlimited. */
+    uint32_t                   type_count;      /* the number of box types in 'types' */
+    lsmash_compact_box_type_t *types;           /* four character codes of boxes to print
+                                                 * If set to NULL, any type of box is printed. */
+} lsmash_print_parameters_t;
+
+/* Dump and print box structure of ROOT into the destination in the way specified by 'param'.
+ * If 'param' is set to NULL, this function is equivalent to lsmash_print_movie().
+ *
+ * Return 0 if successful.
+ * Return a negative value otherwise. */
+int lsmash_print_movie_with_parameters
+(
+    lsmash_root_t             *root,        /* the address of ROOT you want to dump and print */
+    const char                *filename,    /* the path of a file as the destination */
+    lsmash_print_parameters_t *param
+);
+
+/* Print box structure of the file into the destination while reading the file.
+ * Call this function before lsmash_read_file() for a file opened with LSMASH_FILE_MODE_DUMP.
+ * Each box is printed as soon as it is read, and boxes no longer needed to read the rest of the file,
+ * e.g. Movie Fragment Boxes, are released immediately. So, lsmash_print_movie() is unavailable for the file.
+ * If 'param' is set to NULL, all boxes are printed without any limit.
+ *
+ * Return 0 if successful.
+ * Return a negative value otherwise. */
+int lsmash_print_movie_while_reading
+(
+    lsmash_file_t             *file,        /* the address of a file you want to dump and print */
+    const char                *filename,    /* the path of a file as the destination */
+    lsmash_print_parameters_t *param
+);
+
 /* Print a chapter list written as a user data on stdout.
  * This function might output BOM on Windows.
  *
@@ -2502,6 +2737,25 @@ int lsmash_get_closest_random_accessible_point_detail_from_media_timeline
                                                  * that the sample corresponding to a given number can be decodable correctly by decoding from there will be set */
 );
 
+/* Get the range of samples which have to be decoded to present the composition time range
+ * ['start_time', 'end_time') in media timescale from the media timeline for a track.
+ * The first sample is the closest random accessible point to the sample presented at 'start_time',
+ * and the last sample is the last one in decoding order among the samples presented before 'end_time'.
+ * The samples after the range in decoding order are not scanned.
+ * It is an error that no sample is presented in the range.
+ *
+ * Return 0 if successful.
+ * Return a negative value otherwise. */
+int lsmash_get_sample_range_from_media_timeline
+(
+    lsmash_root_t *root,
+    uint32_t       track_ID,
+    uint64_t       start_time,
+    uint64_t       end_time,
+    uint32_t      *first_sample_number, /* the address of a variable to which the sample number of the first sample will be set */
+    uint32_t      *last_sample_number   /* the address of a variable to which the sample number of the last sample will be set */
+);
+
 /* Get the number of samples in the media timeline for a track.
  *
  * Return the number of samples in a track if successful.
@@ -2544,6 +2798,23 @@ lsmash_sample_t *lsmash_get_sample_from_media_timeline
     uint32_t       sample_number
 );
 
+/* Read the data of 'sample_count' consecutive samples from 'first_sample_number' in the media timeline for a track
+ * into a buffer 'data' of 'size' bytes at a time.
+ * The samples must be stored contiguously in the same file, e.g. samples in the same chunk.
+ * Total size of the samples can be got by lsmash_get_sample_info_from_media_timeline().
+ *
+ * Return 0 if successful.
+ * Return a negative value otherwise. */
+int lsmash_read_sample_data_from_media_timeline
+(
+    lsmash_root_t *root,
+    uint32_t       track_ID,
+    uint32_t       first_sample_number,
+    uint32_t       sample_count,
+    uint8_t       *data,
+    uint32_t       size
+);
+
 /* Get the information of the sample correspondint to a given sample number from the media timeline for a track.
  * The information includes the size, timestamps and properties of the sample.
  *
@@ -2604,6 +2875,26 @@ int lsmash_get_media_timestamps
     lsmash_media_ts_list_t *ts_list
 );
 
+/* Get the decoding and/or composition timestamps of 'sample_count' consecutive samples
+ * from 'first_sample_number' in the media timeline for a track into arrays allocated by the caller.
+ * 'dts' or 'cts' can be set to NULL if unnecessary. Each array must have at least 'sample_count' elements.
+ * The composition timestamps are not shifted by the composition to decode timeline shift
+ * as well as lsmash_get_media_timestamps().
+ * Exporting the timeline from the start to the end piece by piece, e.g. to fit a fixed size buffer,
+ * costs linear time in total.
+ *
+ * Return 0 if successful.
+ * Return a negative value othewise. */
+int lsmash_export_media_timestamps
+(
+    lsmash_root_t *root,
+    uint32_t       track_ID,
+    uint32_t       first_sample_number,
+    uint32_t       sample_count,
+    uint64_t      *dts,
+    uint64_t      *cts
+);
+
 /* Deallocate the decoding and composition timestamps in a given media timestamp list. */
 void lsmash_delete_media_timestamps
 (
@@ -4059,6 +4350,12 @@ void lsmash_cleanup_itunes_metadata
     lsmash_itunes_metadata_t *metadata
 );
 
+/* Destroy all of the iTunes metadata in a movie. */
+void lsmash_delete_itunes_metadata
+(
+    lsmash_root_t *root
+);
+
 /****************************************************************************
  * Others
  ****************************************************************************/
@@ -4075,6 +4372,14 @@ int lsmash_set_copyright
     char          *notice
 );
 
+/* Destroy all of the copyright declarations in a track.
+ * track_ID == 0 means the copyright declarations for the entire presentation. */
+void lsmash_delete_copyright
+(
+    lsmash_root_t *root,
+    uint32_t       track_ID
+);
+
 int lsmash_create_object_descriptor
 (
     lsmash_root_t *root